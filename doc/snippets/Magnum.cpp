@@ -29,8 +29,8 @@
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
-#ifdef MAGNUM_TARGET_GL
 #include "Magnum/ResourceManager.h"
+#ifdef MAGNUM_TARGET_GL
 #include "Magnum/GL/AbstractShaderProgram.h"
 #include "Magnum/GL/Mesh.h"
 #include "Magnum/GL/PixelFormat.h"
@@ -62,8 +62,69 @@ class MeshResourceLoader: public AbstractResourceLoader<GL::Mesh> {
 /* [AbstractResourceLoader-implementation] */
 #endif
 
+struct Tile {};
+bool tileFound = false;
+
+/* [AbstractResourceLoader-async-implementation] */
+class TileLoader: public AbstractResourceLoader<Tile> {
+    public:
+        ~TileLoader() {
+            // Worker threads can't call doLoad() once this is destroyed
+            stopAsync();
+        }
+
+    private:
+        // Called from worker threads, possibly several at once
+        void doLoad(ResourceKey key) override {
+            // Decode the tile...
+
+            if(!tileFound) {
+                setNotFound(key);
+                return;
+            }
+
+            set(key, Tile{});
+        }
+};
+/* [AbstractResourceLoader-async-implementation] */
+
 int main() {
 
+{
+/* [AbstractResourceLoader-async] */
+ResourceManager<Tile> manager;
+Containers::Pointer<TileLoader> loader{Containers::InPlaceInit};
+TileLoader& tileLoader = *loader;
+manager.setLoader<Tile>(std::move(loader));
+tileLoader.startAsync(2);
+
+// The tile the camera is in gets loaded first
+tileLoader.load("tile-12-7", 10);
+Resource<Tile> tile = manager.get<Tile>("tile-12-7");
+
+// Once per frame, make everything that got loaded visible to all resources
+manager.publish();
+/* [AbstractResourceLoader-async] */
+}
+
+{
+ResourceManager<Tile> manager;
+/* [ResourceManager-budget] */
+// Keep at most 256 MB of tiles around, unloading the least recently used first
+manager.setMemoryBudget<Tile>(256*1024*1024);
+
+// Report the size when setting the resource
+manager.set("tile-3-4", Tile{}, ResourceDataState::Final,
+    ResourcePolicy::Manual, 4*1024*1024);
+
+// Monitor the usage
+Debug{} << manager.memoryUsage<Tile>() << "bytes used,"
+    << manager.hitCount<Tile>() << "hits,"
+    << manager.missCount<Tile>() << "misses,"
+    << manager.evictedCount<Tile>() << "evicted";
+/* [ResourceManager-budget] */
+}
+
 {
 std::nullptr_t data{};
 /* [Image-pixels] */
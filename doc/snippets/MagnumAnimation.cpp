@@ -24,6 +24,7 @@
 */
 
 #include <vector>
+#include <Corrade/Containers/Reference.h>
 
 #include "Magnum/Timeline.h"
 #include "Magnum/Math/Bezier.h"
@@ -218,6 +219,18 @@ player.advance(std::chrono::system_clock::now().time_since_epoch());
 /* [Player-usage-chrono] */
 }
 
+{
+Timeline timeline;
+/* [Player-advance-batch] */
+Containers::Array<Animation::Player<Float>> characters;
+Containers::Array<Containers::Reference<Animation::Player<Float>>> players;
+// add tracks to all characters and fill the players array…
+
+// every frame, split among all available threads
+Animation::Player<Float>::advance(timeline.previousFrameTime(), players, 0);
+/* [Player-advance-batch] */
+}
+
 {
 /* [Player-higher-order] */
 struct Data {
@@ -23,13 +23,89 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/PluginManager/Manager.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Audio/BufferRing.h"
 #include "Magnum/Audio/Context.h"
 #include "Magnum/Audio/Extensions.h"
+#include "Magnum/Audio/Resampler.h"
+#include "Magnum/Audio/SampleBatch.h"
+#include "Magnum/Audio/Source.h"
 
 using namespace Magnum;
 
 int main() {
 
+{
+PluginManager::Manager<Audio::AbstractImporter> manager;
+Containers::Pointer<Audio::AbstractImporter> importer =
+    manager.loadAndInstantiate("WavAudioImporter");
+/* [AbstractImporter-streaming] */
+importer->openFile("music.wav");
+
+/* Decode 4096 samples at a time */
+Containers::Array<char> data{4096*Audio::sampleSize(importer->format())};
+while(std::size_t count = importer->read(data)) {
+    Containers::ArrayView<const char> chunk =
+        data.prefix(count*Audio::sampleSize(importer->format()));
+    // process the chunk ...
+}
+/* [AbstractImporter-streaming] */
+}
+
+{
+PluginManager::Manager<Audio::AbstractImporter> manager;
+Containers::Pointer<Audio::AbstractImporter> importer =
+    manager.loadAndInstantiate("WavAudioImporter");
+/* [BufferRing] */
+importer->openFile("music.wav");
+
+Audio::Source source;
+Audio::BufferRing ring{4, 8192};
+ring.setLooping(true);
+ring.update(source, *importer);
+source.play();
+
+// every frame, restarting the source in case it ran out of data
+ring.update(source, *importer);
+if(source.state() == Audio::Source::State::Stopped)
+    source.play();
+/* [BufferRing] */
+}
+
+{
+PluginManager::Manager<Audio::AbstractImporter> manager;
+Containers::Pointer<Audio::AbstractImporter> importer =
+    manager.loadAndInstantiate("WavAudioImporter");
+/* [Resampler] */
+importer->openFile("music.wav"); /* 16-bit stereo, 44.1 kHz */
+
+Audio::Resampler resampler{2, importer->frequency(), 48000};
+Containers::Array<Short> pcm{4096*2};
+Containers::Array<Float> samples{4096*2};
+Containers::Array<Float> resampled{4096*2};
+while(std::size_t count = importer->read(Containers::arrayCast<char>(Containers::arrayView(pcm)))) {
+    Containers::StridedArrayView2D<Float> src{samples, {count, 2}};
+    Audio::pcmToFloatInto(
+        Containers::StridedArrayView2D<const Short>{pcm, {count, 2}}, src);
+
+    /* The output may not be large enough to hold everything, process until
+       all input is consumed */
+    while(src.size()[0]) {
+        std::pair<std::size_t, std::size_t> out = resampler.process(src,
+            Containers::StridedArrayView2D<Float>{resampled, {4096, 2}});
+        src = src.suffix(out.first);
+        // do something with the first out.second samples in resampled ...
+    }
+}
+/* [Resampler] */
+}
+
 {
 /* [Context-isExtensionSupported] */
 if(Audio::Context::current().isExtensionSupported<Audio::Extensions::ALC::SOFTX::HRTF>()) {
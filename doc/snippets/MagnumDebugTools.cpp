@@ -24,6 +24,7 @@
 */
 
 #include <chrono>
+#include <fstream>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/PluginManager/Manager.h>
@@ -161,4 +162,24 @@ DebugTools::FrameProfiler profiler{{
 /* [FrameProfiler-setup-immediate] */
 }
 
+{
+DebugTools::FrameProfiler profiler;
+/* [FrameProfiler-percentiles] */
+/* Measurement 0 is CPU time in nanoseconds */
+if(profiler.isMeasurementAvailable(0)) {
+    Debug{} << "p50:" << profiler.measurementPercentile(0, 50.0)/1.0e6 << "ms,"
+        << "p99:" << profiler.measurementPercentile(0, 99.0)/1.0e6 << "ms,"
+        << "max:" << profiler.measurementMax(0)/1.0e6 << "ms";
+}
+/* [FrameProfiler-percentiles] */
+}
+
+{
+DebugTools::FrameProfiler profiler;
+/* [FrameProfiler-sink] */
+std::ofstream out{"frames.jsonl"};
+profiler.setSink(out, DebugTools::FrameProfiler::SinkFormat::JsonLines);
+/* [FrameProfiler-sink] */
+}
+
 }
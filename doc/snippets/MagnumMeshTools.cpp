@@ -34,6 +34,7 @@
 #include "Magnum/MeshTools/FlipNormals.h"
 #include "Magnum/MeshTools/GenerateNormals.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Optimize.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Transform.h"
 #include "Magnum/Primitives/Cube.h"
@@ -161,6 +162,16 @@ data = data.prefix(size);
 /* [removeDuplicates] */
 }
 
+{
+Trade::MeshData mesh{MeshPrimitive::Triangles, 0};
+/* [optimize] */
+MeshTools::VertexCacheStatistics before = MeshTools::analyzeVertexCache(mesh);
+mesh = MeshTools::optimize(std::move(mesh));
+MeshTools::VertexCacheStatistics after = MeshTools::analyzeVertexCache(mesh);
+Debug{} << "ACMR" << before.acmr << "->" << after.acmr;
+/* [optimize] */
+}
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 {
 CORRADE_IGNORE_DEPRECATED_PUSH
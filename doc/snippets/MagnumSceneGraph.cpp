@@ -35,6 +35,7 @@
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/FlatScene.h"
 #include "Magnum/SceneGraph/Object.h"
 #include "Magnum/SceneGraph/Scene.h"
 
@@ -387,4 +388,40 @@ camera.draw(drawableTransformations);
 /* [Drawable-culling] */
 }
 
+{
+/* [FlatScene-usage] */
+SceneGraph::FlatScene3D scene;
+UnsignedInt car = scene.addNode(-1, Matrix4::translation({5.0f, 0.0f, 0.0f}));
+UnsignedInt wheel = scene.addNode(car, Matrix4::translation({1.0f, -0.5f, 0.0f}));
+
+/* Each frame */
+scene.setNodeTransformation(wheel, Matrix4::translation({1.0f, -0.5f, 0.0f})*
+                                   Matrix4::rotationZ(15.0_degf));
+scene.update();
+Matrix4 wheelTransformation = scene.nodeAbsoluteTransformation(wheel);
+/* [FlatScene-usage] */
+static_cast<void>(wheelTransformation);
+}
+
+{
+struct MyDrawable: SceneGraph::Drawable3D {
+    explicit MyDrawable(SceneGraph::AbstractObject3D& object, SceneGraph::DrawableGroup3D* group): SceneGraph::Drawable3D{object, group} {}
+
+    void draw(const Matrix4&, SceneGraph::Camera3D&) override {}
+};
+/* [FlatScene-features] */
+SceneGraph::FlatScene3D scene;
+SceneGraph::DrawableGroup3D drawables;
+
+UnsignedInt cameraNode = scene.addNode(-1, Matrix4::translation(Vector3::zAxis(5.0f)));
+SceneGraph::FlatObject3D cameraObject{scene, cameraNode};
+SceneGraph::Camera3D camera{cameraObject};
+
+SceneGraph::FlatObject3D object{scene, scene.addNode()};
+new MyDrawable{object, &drawables};
+
+camera.draw(drawables);
+/* [FlatScene-features] */
+}
+
 }
@@ -35,6 +35,7 @@
 #include "Magnum/GL/DefaultFramebuffer.h"
 #include "Magnum/GL/Framebuffer.h"
 #include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
 #include "Magnum/GL/Shader.h"
 #include "Magnum/GL/Renderbuffer.h"
 #include "Magnum/GL/RenderbufferFormat.h"
@@ -274,6 +275,42 @@ mesh.setInstanceCount(Containers::arraySize(instanceData))
 /* [Flat-usage-instancing] */
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+{
+GL::Mesh circle, square;
+Matrix3 circleTransformation, squareTransformation;
+/* [Flat-usage-ubo] */
+GL::Buffer transformationProjectionUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::TransformationProjectionUniform2D{}
+        .setTransformationProjectionMatrix(circleTransformation),
+    Shaders::TransformationProjectionUniform2D{}
+        .setTransformationProjectionMatrix(squareTransformation)
+}};
+GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::FlatMaterialUniform{}
+        .setColor(0x2f83cc_rgbf)
+}};
+GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::FlatDrawUniform{}
+        .setMaterialId(0),
+    Shaders::FlatDrawUniform{}
+        .setMaterialId(0)
+}};
+
+Shaders::Flat2D shader{Shaders::Flat2D::Flag::UniformBuffers, 1, 2};
+shader
+    .bindTransformationProjectionBuffer(transformationProjectionUniform)
+    .bindMaterialBuffer(materialUniform)
+    .bindDrawBuffer(drawUniform);
+
+shader.setDrawOffset(0)
+    .draw(circle);
+shader.setDrawOffset(1)
+    .draw(square);
+/* [Flat-usage-ubo] */
+}
+#endif
+
 {
 struct: GL::AbstractShaderProgram {
 void foo() {
@@ -580,6 +617,82 @@ shader.bindTextures(&diffuseAlphaTexture, &diffuseAlphaTexture, nullptr, nullptr
 /* [Phong-usage-alpha] */
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+{
+GL::Mesh redCone, yellowCube, redSphere;
+Matrix4 projectionMatrix, redConeTransformation, yellowCubeTransformation,
+    redSphereTransformation;
+/* [Phong-usage-ubo] */
+GL::Buffer projectionUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::ProjectionUniform3D{}
+        .setProjectionMatrix(projectionMatrix)
+}};
+GL::Buffer lightUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::PhongLightUniform{}
+}};
+GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::PhongMaterialUniform{}
+        .setDiffuseColor(0xcd3431_rgbf)
+        .setShininess(200.0f),
+    Shaders::PhongMaterialUniform{}
+        .setDiffuseColor(0xc7cf2f_rgbf)
+        .setShininess(20.0f),
+}};
+GL::Buffer transformationUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::TransformationUniform3D{}
+        .setTransformationMatrix(redConeTransformation),
+    Shaders::TransformationUniform3D{}
+        .setTransformationMatrix(yellowCubeTransformation),
+    Shaders::TransformationUniform3D{}
+        .setTransformationMatrix(redSphereTransformation),
+}};
+GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::PhongDrawUniform{}
+        .setNormalMatrix(redConeTransformation.normalMatrix())
+        .setMaterialId(0),
+    Shaders::PhongDrawUniform{}
+        .setNormalMatrix(yellowCubeTransformation.normalMatrix())
+        .setMaterialId(1),
+    Shaders::PhongDrawUniform{}
+        .setNormalMatrix(redSphereTransformation.normalMatrix())
+        .setMaterialId(0),
+}};
+
+Shaders::Phong shader{Shaders::Phong::Flag::UniformBuffers, 1, 2, 3};
+shader
+    .bindProjectionBuffer(projectionUniform)
+    .bindLightBuffer(lightUniform)
+    .bindMaterialBuffer(materialUniform)
+    .bindTransformationBuffer(transformationUniform)
+    .bindDrawBuffer(drawUniform);
+
+shader.setDrawOffset(0)
+    .draw(redCone);
+shader.setDrawOffset(1)
+    .draw(yellowCube);
+shader.setDrawOffset(2)
+    .draw(redSphere);
+/* [Phong-usage-ubo] */
+
+#ifndef MAGNUM_TARGET_GLES
+GL::Mesh mesh;
+/* [Phong-usage-multidraw] */
+GL::MeshView redConeView{mesh}, yellowCubeView{mesh}, redSphereView{mesh};
+// Set index offsets and counts ...
+
+Shaders::Phong multidrawShader{Shaders::Phong::Flag::MultiDraw, 1, 2, 3};
+multidrawShader
+    .bindProjectionBuffer(projectionUniform)
+    .bindLightBuffer(lightUniform)
+    .bindMaterialBuffer(materialUniform)
+    .bindTransformationBuffer(transformationUniform)
+    .bindDrawBuffer(drawUniform)
+    .draw({redConeView, yellowCubeView, redSphereView});
+/* [Phong-usage-multidraw] */
+#endif
+}
+#endif
+
 #if !defined(__GNUC__) || defined(__clang__) || __GNUC__*100 + __GNUC_MINOR__ >= 500
 {
 /* [Vector-usage1] */
@@ -25,15 +25,20 @@
 
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Resource.h>
 
 #include "Magnum/FileCallback.h"
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Shaders/Vector.h"
 #include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/BatchLayouter.h"
 #include "Magnum/Text/DistanceFieldGlyphCache.h"
 #include "Magnum/Text/Renderer.h"
 
@@ -57,6 +62,53 @@ font->fillGlyphCache(cache, "abcdefghijklmnopqrstuvwxyz"
 /* [AbstractFont-usage] */
 }
 
+{
+UnsignedInt glyphId{};
+Vector2i glyphPosition, glyphSize;
+/* [AbstractGlyphCache-incremental] */
+Text::GlyphCache cache{Vector2i{512}};
+Image2D image{PixelFormat::R8Unorm, Vector2i{512},
+    Containers::Array<char>{Containers::ValueInit, 512*512}};
+
+/* Place a glyph into the free space and render it into the CPU-side copy */
+Containers::Optional<Range2Di> rectangle =
+    cache.add(glyphId, glyphPosition, glyphSize);
+if(!rectangle) {
+    // the cache is full
+}
+// rasterize the glyph into *rectangle of image.pixels<UnsignedByte>() ...
+
+/* Upload just the changed part */
+cache.flushImage(image);
+/* [AbstractGlyphCache-incremental] */
+}
+
+{
+Containers::Pointer<Text::AbstractFont> font;
+Text::GlyphCache cache{Vector2i{512}};
+Containers::ArrayView<const Containers::StringView> labels;
+Containers::ArrayView<const Vector2> labelPositions;
+/* [BatchLayouter-usage] */
+Text::BatchLayouter layouter{*font, cache, 0.15f, Text::Alignment::MiddleCenter};
+
+struct Vertex {
+    Vector2 position;
+    Vector2 textureCoordinates;
+};
+Containers::Array<Vertex> vertices;
+
+/* Every frame, reallocating only if there's more glyphs than before */
+std::size_t glyphCount = layouter.glyphCount(labels);
+if(vertices.size() < glyphCount*4)
+    vertices = Containers::Array<Vertex>{Containers::NoInit, glyphCount*4};
+layouter.render(labels, labelPositions,
+    Containers::StridedArrayView1D<Vector2>{vertices, &vertices[0].position,
+        vertices.size(), sizeof(Vertex)},
+    Containers::StridedArrayView1D<Vector2>{vertices,
+        &vertices[0].textureCoordinates, vertices.size(), sizeof(Vertex)});
+/* [BatchLayouter-usage] */
+}
+
 #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
 {
 Containers::Pointer<Text::AbstractFont> font;
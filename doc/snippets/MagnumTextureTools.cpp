@@ -0,0 +1,52 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/TextureTools/Atlas.h"
+
+using namespace Magnum;
+
+int main() {
+
+{
+/* [AtlasPacker] */
+Containers::ArrayView<const Vector2i> sizes;
+Containers::Array<Range2Di> ranges{Containers::NoInit, sizes.size()};
+
+TextureTools::AtlasPacker packer{{1024, 1024}, {1, 1},
+    TextureTools::AtlasPacker::Flag::AllowRotation};
+if(!packer.add(sizes, ranges)) {
+    // doesn't fit, try a larger atlas …
+}
+
+/* Add another item later, keeping the previous placements */
+Containers::Optional<Range2Di> range = packer.add({32, 17});
+/* [AtlasPacker] */
+static_cast<void>(range);
+}
+
+}
@@ -59,6 +59,8 @@ cmake .. \
     -DWITH_ANYSHADERCONVERTER=ON \
     -DWITH_MAGNUMFONT=ON \
     -DWITH_MAGNUMFONTCONVERTER=ON \
+    -DWITH_MESHBLOBIMPORTER=ON \
+    -DWITH_MESHBLOBSCENECONVERTER=ON \
     -DWITH_OBJIMPORTER=ON \
     -DWITH_TGAIMAGECONVERTER=ON \
     -DWITH_TGAIMPORTER=ON \
@@ -53,6 +53,8 @@ cmake .. \
     -DWITH_ANYSHADERCONVERTER=OFF \
     -DWITH_MAGNUMFONT=OFF \
     -DWITH_MAGNUMFONTCONVERTER=OFF \
+    -DWITH_MESHBLOBIMPORTER=OFF \
+    -DWITH_MESHBLOBSCENECONVERTER=OFF \
     -DWITH_OBJIMPORTER=OFF \
     -DWITH_TGAIMAGECONVERTER=OFF \
     -DWITH_TGAIMPORTER=OFF \
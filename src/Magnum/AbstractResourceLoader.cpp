@@ -0,0 +1,308 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AbstractResourceLoader.h"
+
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <Corrade/Containers/GrowableArray.h>
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace Magnum { namespace Implementation {
+
+struct ResourceLoaderQueue::State {
+    struct Job {
+        Int priority;
+        std::size_t sequence;
+        ResourceKey key;
+    };
+
+    /* Higher priority first, requests with the same priority in the order
+       they were made */
+    struct JobOrder {
+        bool operator()(const Job& a, const Job& b) const {
+            return a.priority > b.priority || (a.priority == b.priority && a.sequence < b.sequence);
+        }
+    };
+
+    struct Result {
+        ResourceKey key;
+        void* data;
+        ResourceDataState state;
+        ResourcePolicy policy;
+        std::size_t size;
+    };
+
+    ResourceKey takeJob();
+    void finishJob(ResourceKey key);
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void work();
+    #else
+    void loadQueued();
+    #endif
+
+    void* loader;
+    Load load;
+    Set set;
+    Delete deleter;
+
+    std::set<Job, JobOrder> queue;
+    std::unordered_map<ResourceKey, std::set<Job, JobOrder>::iterator> queued;
+    /* A key can be requested again while it's being loaded, so this is a
+       count and not a set */
+    std::unordered_map<ResourceKey, UnsignedInt> running;
+    /* Keys of running requests that were canceled, data set for these get
+       discarded */
+    std::unordered_set<ResourceKey> canceled;
+    std::vector<Result> finished;
+    std::size_t sequence{};
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    mutable std::mutex mutex;
+    std::condition_variable jobQueued, jobFinished;
+    std::vector<std::thread> threads;
+    bool stopping{};
+    #endif
+};
+
+ResourceKey ResourceLoaderQueue::State::takeJob() {
+    const Job job = *queue.begin();
+    queue.erase(queue.begin());
+    queued.erase(job.key);
+    ++running[job.key];
+    return job.key;
+}
+
+void ResourceLoaderQueue::State::finishJob(const ResourceKey key) {
+    auto found = running.find(key);
+    CORRADE_INTERNAL_ASSERT(found != running.end());
+    if(--found->second) return;
+
+    running.erase(found);
+    canceled.erase(key);
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void ResourceLoaderQueue::State::work() {
+    std::unique_lock<std::mutex> lock{mutex};
+    for(;;) {
+        jobQueued.wait(lock, [this]{ return stopping || !queue.empty(); });
+
+        /* The queue is cleared when stopping, so this means we're done */
+        if(queue.empty()) return;
+
+        const ResourceKey key = takeJob();
+        lock.unlock();
+        load(loader, key);
+        lock.lock();
+        finishJob(key);
+        jobFinished.notify_all();
+    }
+}
+#else
+void ResourceLoaderQueue::State::loadQueued() {
+    while(!queue.empty()) {
+        const ResourceKey key = takeJob();
+        load(loader, key);
+        finishJob(key);
+    }
+}
+#endif
+
+ResourceLoaderQueue::ResourceLoaderQueue(void* const loader, const Load load, const Set set, const Delete deleter, std::size_t threadCount): _state{Containers::InPlaceInit} {
+    _state->loader = loader;
+    _state->load = load;
+    _state->set = set;
+    _state->deleter = deleter;
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(!threadCount) threadCount = std::thread::hardware_concurrency();
+    if(!threadCount) threadCount = 1;
+    _state->threads.reserve(threadCount);
+    for(std::size_t i = 0; i != threadCount; ++i)
+        _state->threads.emplace_back(&State::work, _state.get());
+    #else
+    static_cast<void>(threadCount);
+    #endif
+}
+
+ResourceLoaderQueue::~ResourceLoaderQueue() {
+    stop();
+
+    for(const State::Result& result: _state->finished)
+        if(result.data) _state->deleter(result.data);
+}
+
+std::size_t ResourceLoaderQueue::pendingCount() const {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    #endif
+
+    std::size_t count = _state->queue.size();
+    for(const std::pair<const ResourceKey, UnsignedInt>& i: _state->running)
+        count += i.second;
+    return count;
+}
+
+void ResourceLoaderQueue::load(const ResourceKey key, const Int priority) {
+    {
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        #endif
+
+        /* If the key is currently being loaded and was canceled, the new
+           request makes its data wanted again */
+        _state->canceled.erase(key);
+
+        /* If the key is already queued, only update its priority, keeping the
+           original order among requests of the same priority */
+        std::size_t sequence = _state->sequence++;
+        auto found = _state->queued.find(key);
+        if(found != _state->queued.end()) {
+            sequence = found->second->sequence;
+            _state->queue.erase(found->second);
+            _state->queued.erase(found);
+        }
+
+        _state->queued.emplace(key, _state->queue.insert(State::Job{priority, sequence, key}).first);
+    }
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    _state->jobQueued.notify_one();
+    #endif
+}
+
+bool ResourceLoaderQueue::cancel(const ResourceKey key) {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    #endif
+
+    bool found = false;
+
+    /* Remove from the queue */
+    auto queued = _state->queued.find(key);
+    if(queued != _state->queued.end()) {
+        _state->queue.erase(queued->second);
+        _state->queued.erase(queued);
+        found = true;
+    }
+
+    /* Discard data set once the running request finishes */
+    if(_state->running.find(key) != _state->running.end()) {
+        _state->canceled.insert(key);
+        found = true;
+    }
+
+    /* Discard data that are waiting to be published */
+    auto end = std::remove_if(_state->finished.begin(), _state->finished.end(), [&](const State::Result& result) {
+        if(result.key != key) return false;
+        if(result.data) _state->deleter(result.data);
+        return true;
+    });
+    if(end != _state->finished.end()) {
+        _state->finished.erase(end, _state->finished.end());
+        found = true;
+    }
+
+    return found;
+}
+
+void ResourceLoaderQueue::set(const ResourceKey key, void* const data, const ResourceDataState state, const ResourcePolicy policy, const std::size_t size) {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    #endif
+
+    if(_state->canceled.find(key) != _state->canceled.end()) {
+        if(data) _state->deleter(data);
+        return;
+    }
+
+    _state->finished.push_back(State::Result{key, data, state, policy, size});
+}
+
+void ResourceLoaderQueue::wait() {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    std::unique_lock<std::mutex> lock{_state->mutex};
+    _state->jobFinished.wait(lock, [this]{
+        return _state->queue.empty() && _state->running.empty();
+    });
+    #else
+    _state->loadQueued();
+    #endif
+}
+
+std::size_t ResourceLoaderQueue::publish() {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    _state->loadQueued();
+    #endif
+
+    /* Take all finished data at once so the workers are blocked only for the
+       swap and not for the whole time the manager gets updated */
+    std::vector<State::Result> finished;
+    {
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        #endif
+        std::swap(finished, _state->finished);
+    }
+
+    for(const State::Result& result: finished)
+        _state->set(_state->loader, result.key, result.data, result.state, result.policy, result.size);
+    return finished.size();
+}
+
+Containers::Array<ResourceKey> ResourceLoaderQueue::stop() {
+    Containers::Array<ResourceKey> canceled;
+    {
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        _state->stopping = true;
+        #endif
+
+        arrayReserve(canceled, _state->queue.size());
+        for(const State::Job& job: _state->queue)
+            arrayAppend(canceled, job.key);
+        _state->queue.clear();
+        _state->queued.clear();
+    }
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    _state->jobQueued.notify_all();
+    for(std::thread& thread: _state->threads) thread.join();
+    _state->threads.clear();
+    #endif
+
+    return canceled;
+}
+
+}}
@@ -30,11 +30,52 @@
  */
 
 #include <string>
+#include <Corrade/Containers/Array.h>
 
 #include "Magnum/ResourceManager.h"
 
 namespace Magnum {
 
+namespace Implementation {
+
+/* Type-erased request queue and worker threads for the asynchronous mode of
+   AbstractResourceLoader. Implemented in a source file to avoid dragging
+   <thread>, <mutex> and the rest into everything that includes the
+   ResourceManager. */
+class MAGNUM_EXPORT ResourceLoaderQueue {
+    public:
+        typedef void(*Load)(void*, ResourceKey);
+        typedef void(*Set)(void*, ResourceKey, void*, ResourceDataState, ResourcePolicy, std::size_t);
+        typedef void(*Delete)(void*);
+
+        explicit ResourceLoaderQueue(void* loader, Load load, Set set, Delete deleter, std::size_t threadCount);
+
+        /* Calls stop() and deletes unpublished data */
+        ~ResourceLoaderQueue();
+
+        std::size_t pendingCount() const;
+
+        void load(ResourceKey key, Int priority);
+
+        bool cancel(ResourceKey key);
+
+        /* Called from doLoad() in the worker threads */
+        void set(ResourceKey key, void* data, ResourceDataState state, ResourcePolicy policy, std::size_t size);
+
+        void wait();
+
+        std::size_t publish();
+
+        /* Returns keys of requests that were still queued */
+        Containers::Array<ResourceKey> stop();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}
+
 /**
 @brief Base for resource loaders
 
@@ -75,6 +116,38 @@ the following code, however, the loader destroys itself (and removes itself
 from the manager) before the manager is destroyed.
 
 @snippet Magnum.cpp AbstractResourceLoader-use
+
+@section AbstractResourceLoader-async Asynchronous loading
+
+Calling @ref startAsync() makes the loader call @ref doLoad() from a set of
+worker threads instead of directly from @ref load(). Requests are processed in
+order of the priority passed to @ref load(ResourceKey, Int), with requests of
+the same priority processed in the order they were made. Requests coming from
+@ref ResourceManager::get() have a priority of @cpp 0 @ce.
+
+Data passed to @ref set() in the worker threads are not visible to the manager
+until @ref publish() or @ref ResourceManager::publish() is called, so the
+resources stay in @ref ResourceState::Loading until then, and all updates
+happen on the thread calling @ref publish(), at a point of your choosing. The
+counts returned by @ref loadedCount() and @ref notFoundCount() get updated
+during the publish as well. A request can be canceled with @ref cancel(),
+@ref wait() blocks until all requests are processed.
+
+The @ref doLoad() implementation is called from multiple threads at once if
+more than one thread was requested, so it has to be thread-safe. It shouldn't
+access the @ref ResourceManager and shouldn't create objects that depend on
+thread-local state, such as OpenGL objects --- decode the data on the worker
+and create the GPU objects after publishing instead. Because the worker
+threads call into the subclass, it needs to call @ref stopAsync() in its
+destructor, unless it's deleted by the manager, which does that on its own:
+
+@snippet Magnum.cpp AbstractResourceLoader-async-implementation
+
+@snippet Magnum.cpp AbstractResourceLoader-async
+
+On @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" no threads are spawned and the
+queued requests are loaded on the calling thread in @ref publish() or
+@ref wait() instead, preserving the priority order.
 */
 template<class T> class AbstractResourceLoader {
     public:
@@ -93,7 +166,8 @@ template<class T> class AbstractResourceLoader {
          * @brief Count of not found resources
          *
          * Count of resources requested by calling @ref load(), but not found
-         * by the loader.
+         * by the loader. In the asynchronous mode updated only in
+         * @ref publish().
          */
         std::size_t notFoundCount() const { return _notFoundCount; }
 
@@ -101,7 +175,8 @@ template<class T> class AbstractResourceLoader {
          * @brief Count of loaded resources
          *
          * Count of resources requested by calling @ref load(), but not found
-         * by the loader.
+         * by the loader. In the asynchronous mode updated only in
+         * @ref publish().
          */
         std::size_t loadedCount() const { return _loadedCount; }
 
@@ -119,12 +194,115 @@ template<class T> class AbstractResourceLoader {
          * If the resource isn't yet loaded or loading, state of the resource
          * is set to @ref ResourceState::Loading and count of requested
          * features is incremented. Depending on implementation the resource
-         * might be loaded synchronously or asynchronously.
+         * might be loaded synchronously or asynchronously. Equivalent to
+         * calling @ref load(ResourceKey, Int) with priority set to
+         * @cpp 0 @ce.
          *
          * @see @ref ResourceManager::state(), @ref requestedCount(),
          *      @ref notFoundCount(), @ref loadedCount()
          */
-        void load(ResourceKey key);
+        void load(ResourceKey key) { load(key, 0); }
+
+        /**
+         * @brief Request resource to be loaded with given priority
+         * @m_since_latest
+         *
+         * Same as @ref load(ResourceKey), but in the asynchronous mode the
+         * request is processed before all queued requests with lower
+         * @p priority. If a request for @p key is already queued, only its
+         * priority is updated. In the synchronous mode the priority is
+         * ignored. See @ref AbstractResourceLoader-async for more
+         * information.
+         */
+        void load(ResourceKey key, Int priority);
+
+        /**
+         * @brief Whether asynchronous loading is enabled
+         * @m_since_latest
+         *
+         * @see @ref startAsync(), @ref stopAsync()
+         */
+        bool isAsync() const { return bool(_queue); }
+
+        /**
+         * @brief Start asynchronous loading
+         * @param threadCount   Count of worker threads. If set to @cpp 0 @ce,
+         *      @ref std::thread::hardware_concurrency() is used.
+         * @m_since_latest
+         *
+         * Expects that asynchronous loading isn't already started. See
+         * @ref AbstractResourceLoader-async for more information.
+         */
+        void startAsync(std::size_t threadCount = 1);
+
+        /**
+         * @brief Stop asynchronous loading
+         * @m_since_latest
+         *
+         * Cancels all queued requests, waits until the requests currently
+         * being loaded finish, publishes everything that was loaded and
+         * joins the worker threads. If asynchronous loading isn't enabled,
+         * does nothing. Called automatically by the @ref ResourceManager
+         * when the loader is replaced or the manager is destroyed.
+         */
+        void stopAsync();
+
+        /**
+         * @brief Count of requests waiting to be loaded
+         * @m_since_latest
+         *
+         * Count of requests that are queued or are currently being loaded.
+         * Requests that finished loading but weren't published yet are not
+         * counted. Always @cpp 0 @ce if asynchronous loading isn't enabled.
+         */
+        std::size_t pendingCount() const {
+            return _queue ? _queue->pendingCount() : 0;
+        }
+
+        /**
+         * @brief Cancel a request
+         * @return @cpp true @ce if there was a request for @p key that
+         *      wasn't published yet, @cpp false @ce otherwise
+         * @m_since_latest
+         *
+         * If the request is still queued, it's removed from the queue. If
+         * it's currently being loaded, the data it sets for @p key are
+         * discarded once it finishes. Data for @p key that weren't published
+         * yet are discarded as well. The resource then goes back to
+         * @ref ResourceState::NotLoaded, the request is still counted in
+         * @ref requestedCount(). Always returns @cpp false @ce if
+         * asynchronous loading isn't enabled.
+         */
+        bool cancel(ResourceKey key);
+
+        /**
+         * @brief Wait until all requests are loaded
+         * @m_since_latest
+         *
+         * Blocks until there are no queued requests and no requests being
+         * loaded. The loaded data still need to be published with
+         * @ref publish(). Does nothing if asynchronous loading isn't
+         * enabled.
+         */
+        void wait() {
+            if(_queue) _queue->wait();
+        }
+
+        /**
+         * @brief Publish loaded resources to the manager
+         * @return Count of published resources
+         * @m_since_latest
+         *
+         * Passes all data set by finished requests to the
+         * @ref ResourceManager in a single batch and updates
+         * @ref loadedCount() and @ref notFoundCount(). Should be called from
+         * the thread that owns the manager, usually once per frame. Always
+         * returns @cpp 0 @ce if asynchronous loading isn't enabled.
+         * @see @ref ResourceManager::publish()
+         */
+        std::size_t publish() {
+            return _queue ? _queue->publish() : 0;
+        }
 
     protected:
         /**
@@ -133,26 +311,31 @@ template<class T> class AbstractResourceLoader {
          * If @p data is @cpp nullptr @ce and @p state is
          * @ref ResourceDataState::NotFound, increments count of not found
          * resources. Otherwise, if @p data is not @cpp nullptr @ce, increments
-         * count of loaded resources. See @ref ResourceManager::set() for
-         * more information.
+         * count of loaded resources. The @p size is the amount of memory
+         * used by the resource in bytes, used for
+         * @ref ResourceManager::setMemoryBudget(). See
+         * @ref ResourceManager::set() for more information.
          *
          * Note that resource's state is automatically set to
          * @ref ResourceDataState::Loading when it is requested from
          * @ref ResourceManager and it's not loaded yet, so it's not needed to
          * call this function. For marking a resource as not found you can also
          * use the convenience @ref setNotFound() variant.
+         *
+         * In the asynchronous mode this function is thread-safe and the data
+         * are passed to the manager only in @ref publish().
          * @see @ref loadedCount()
          */
-        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy);
+        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0);
 
         /** @overload */
-        void set(ResourceKey key, Containers::Pointer<T> data, ResourceDataState state, ResourcePolicy policy) {
-            return set(key, data.release(), state, policy);
+        void set(ResourceKey key, Containers::Pointer<T> data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            return set(key, data.release(), state, policy, size);
         }
 
         /** @overload */
-        template<class U, class = typename std::enable_if<!std::is_same<typename std::decay<U>::type, std::nullptr_t>::value>::type> void set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy) {
-            set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy);
+        template<class U, class = typename std::enable_if<!std::is_same<typename std::decay<U>::type, std::nullptr_t>::value>::type> void set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy, size);
         }
 
         /**
@@ -202,7 +385,8 @@ template<class T> class AbstractResourceLoader {
         /**
          * @brief Implementation for @ref load()
          *
-         * See class documentation for reimplementation guide.
+         * See class documentation for reimplementation guide. In the
+         * asynchronous mode called from the worker threads.
          */
         virtual void doLoad(ResourceKey key) = 0;
 
@@ -211,30 +395,86 @@ template<class T> class AbstractResourceLoader {
         friend Implementation::ResourceManagerData<T>;
         #endif
 
+        static void loadInternal(void* loader, ResourceKey key);
+        static void publishInternal(void* loader, ResourceKey key, void* data, ResourceDataState state, ResourcePolicy policy, std::size_t size);
+        static void deleteInternal(void* data);
+
+        void setInternal(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size);
+
         Implementation::ResourceManagerData<T>* manager;
         std::size_t _requestedCount,
             _loadedCount,
             _notFoundCount;
+        Containers::Pointer<Implementation::ResourceLoaderQueue> _queue;
 };
 
 template<class T> AbstractResourceLoader<T>::~AbstractResourceLoader() {
+    /* Subclasses are expected to stop the asynchronous loading in their
+       destructor, here it's only possible to join threads that aren't
+       calling doLoad() anymore */
+    stopAsync();
     if(manager) manager->_loader = nullptr;
 }
 
 template<class T> std::string AbstractResourceLoader<T>::doName(ResourceKey) const { return {}; }
 
-template<class T> void AbstractResourceLoader<T>::load(ResourceKey key) {
+template<class T> void AbstractResourceLoader<T>::load(ResourceKey key, const Int priority) {
     ++_requestedCount;
     /** @todo What policy for loading resources? */
-    manager->set(key, nullptr, ResourceDataState::Loading, ResourcePolicy::Resident);
+    manager->set(key, nullptr, ResourceDataState::Loading, ResourcePolicy::Resident, 0);
+
+    if(_queue) _queue->load(key, priority);
+    else doLoad(key);
+}
+
+template<class T> void AbstractResourceLoader<T>::startAsync(const std::size_t threadCount) {
+    CORRADE_ASSERT(!_queue,
+        "AbstractResourceLoader::startAsync(): asynchronous loading already started", );
+    _queue.reset(new Implementation::ResourceLoaderQueue{this, loadInternal, publishInternal, deleteInternal, threadCount});
+}
+
+template<class T> void AbstractResourceLoader<T>::stopAsync() {
+    if(!_queue) return;
+
+    /* Resources that were only queued go back to not being loaded, what
+       finished gets published */
+    const Containers::Array<ResourceKey> canceled = _queue->stop();
+    if(manager) {
+        for(const ResourceKey& key: canceled) manager->unsetLoading(key);
+        _queue->publish();
+    }
+
+    _queue = nullptr;
+}
+
+template<class T> bool AbstractResourceLoader<T>::cancel(const ResourceKey key) {
+    if(!_queue || !_queue->cancel(key)) return false;
+
+    manager->unsetLoading(key);
+    return true;
+}
+
+template<class T> void AbstractResourceLoader<T>::loadInternal(void* const loader, const ResourceKey key) {
+    static_cast<AbstractResourceLoader<T>*>(loader)->doLoad(key);
+}
+
+template<class T> void AbstractResourceLoader<T>::publishInternal(void* const loader, const ResourceKey key, void* const data, const ResourceDataState state, const ResourcePolicy policy, const std::size_t size) {
+    static_cast<AbstractResourceLoader<T>*>(loader)->setInternal(key, static_cast<T*>(data), state, policy, size);
+}
+
+template<class T> void AbstractResourceLoader<T>::deleteInternal(void* const data) {
+    Implementation::safeDelete(static_cast<T*>(data));
+}
 
-    doLoad(key);
+template<class T> void AbstractResourceLoader<T>::set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size) {
+    if(_queue) _queue->set(key, data, state, policy, size);
+    else setInternal(key, data, state, policy, size);
 }
 
-template<class T> void AbstractResourceLoader<T>::set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy) {
+template<class T> void AbstractResourceLoader<T>::setInternal(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size) {
     if(data) ++_loadedCount;
     if(!data && state == ResourceDataState::NotFound) ++_notFoundCount;
-    manager->set(key, data, state, policy);
+    manager->set(key, data, state, policy, size);
 }
 
 }
@@ -25,6 +25,9 @@
 
 #include "Player.hpp"
 
+#include "Magnum/Implementation/parallelFor.h"
+#include "Magnum/Math/Functions.h"
+
 namespace Magnum { namespace Animation {
 
 Debug& operator<<(Debug& debug, const State value) {
@@ -43,6 +46,27 @@ Debug& operator<<(Debug& debug, const State value) {
     return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
 }
 
+namespace Implementation {
+
+namespace {
+
+/* Each thread advances at least this many tracks */
+constexpr std::size_t MinTracksPerThread = 4096;
+
+}
+
+std::size_t playerWorkerCount(const std::size_t threadCount, const std::size_t playerCount, const std::size_t trackCount) {
+    return Math::max(Math::min(Magnum::Implementation::parallelThreadCount(threadCount, trackCount, MinTracksPerThread), playerCount), std::size_t{1});
+}
+
+void playerParallelFor(const std::size_t count, void(*const function)(void*, std::size_t), void* const state) {
+    Magnum::Implementation::parallelFor(count, [function, state](const std::size_t i) {
+        function(state, i);
+    });
+}
+
+}
+
 /* On non-MinGW Windows the instantiations are already marked with extern
    template. However Clang-CL doesn't propagate the export from the extern
    template, it seems. */
@@ -224,6 +224,37 @@ a particular animation:
 
 @snippet MagnumAnimation.cpp Player-higher-order-animated-time
 
+@section Animation-Player-batch Advancing many players at once
+
+For large amounts of players, such as crowds of animated characters, use the
+@ref advance(T, Containers::ArrayView<const Containers::Reference<Player<T, K>>>, UnsignedInt)
+overload instead of calling @ref advance(T) on each player separately. Tracks
+added with @ref add() that use one of the builtin interpolators listed below
+are then grouped by value type and interpolator across all players and
+evaluated in a tight loop for each group, with the interpolator inlined
+instead of called through a function pointer:
+
+-   @ref Math::select() and @ref Math::lerp() for @ref Magnum::Float "Float",
+    @ref Magnum::Vector2 "Vector2", @ref Magnum::Vector3 "Vector3" and
+    @ref Magnum::Vector4 "Vector4"
+-   @ref Math::select(), @ref Math::lerp(const Quaternion<T>&, const Quaternion<T>&, T) "Math::lerp()",
+    @ref Math::lerpShortestPath(const Quaternion<T>&, const Quaternion<T>&, T) "Math::lerpShortestPath()",
+    @ref Math::slerp(const Quaternion<T>&, const Quaternion<T>&, T) "Math::slerp()" and
+    @ref Math::slerpShortestPath(const Quaternion<T>&, const Quaternion<T>&, T) "Math::slerpShortestPath()"
+    for @ref Magnum::Quaternion "Quaternion"
+-   @ref Math::splerp() for @ref Magnum::CubicHermite1D "CubicHermite1D",
+    @ref Magnum::CubicHermite2D "CubicHermite2D",
+    @ref Magnum::CubicHermite3D "CubicHermite3D" and
+    @ref Magnum::CubicHermiteQuaternion "CubicHermiteQuaternion"
+
+That covers all interpolators returned by @ref interpolatorFor() for these
+types. Other tracks, including all tracks added with @ref addWithCallback(),
+@ref addWithCallbackOnChange() and @ref addRawCallback(), are advanced the
+same way as in @ref advance(T). The players can be additionally split among
+multiple threads:
+
+@snippet MagnumAnimation.cpp Player-advance-batch
+
 @section Animation-Player-explicit-specializations Explicit template specializations
 
 The following specializations are explicitly compiled into the @ref Animation
@@ -265,6 +296,28 @@ template<class T, class K
          */
         static void advance(T time, std::initializer_list<Containers::Reference<Player<T, K>>> players);
 
+        /**
+         * @brief Advance multiple players in a batch
+         * @param time          Time
+         * @param players       Players to advance
+         * @param threadCount   Count of threads to split the players among.
+         *      A value of @cpp 0 @ce uses all available hardware threads.
+         * @m_since_latest
+         *
+         * Has the same effect as calling @ref advance(T) for each item in
+         * @p players, except that all callbacks of all players get called
+         * before any destinations of tracks added with @ref add() are
+         * updated. See @ref Animation-Player-batch for more information.
+         *
+         * With @p threadCount set to a value other than @cpp 1 @ce, the
+         * players are split among multiple threads, which means callbacks may
+         * get called from a different thread than the calling one, and no two
+         * players are allowed to share a destination location or callback
+         * user data. On Emscripten the players are always advanced on the
+         * calling thread.
+         */
+        static void advance(T time, Containers::ArrayView<const Containers::Reference<Player<T, K>>> players, std::size_t threadCount = 1);
+
         /** @brief Constructor */
         explicit Player();
 
@@ -804,7 +857,11 @@ template<class T, class K
     private:
         struct Track;
 
-        Player<T, K>& addInternal(const TrackViewStorage<const K>& track, void (*advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* destination, void(*userCallback)(), void* userCallbackData);
+        /* If interpolator is set, it's used to find a kernel for the batched
+           advance() */
+        Player<T, K>& addInternal(const TrackViewStorage<const K>& track, void (*advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* destination, void(*userCallback)(), void* userCallbackData, void(*interpolator)() = nullptr);
+
+        static void advanceBatch(T time, Containers::ArrayView<const Containers::Reference<Player<T, K>>> players);
 
         Containers::Optional<std::pair<UnsignedInt, K>> elapsedInternal(T time, T& updatedStartTime, T& updatedPauseTime, State& updatedState) const;
 
@@ -820,7 +877,7 @@ template<class T, class K> template<class V, class R> Player<T, K>& Player<T, K>
     return addInternal(track,
         [](const TrackViewStorage<const K>& track, K key, std::size_t& hint, void* destination, void(*)(), void*) {
             *static_cast<R*>(destination) = static_cast<const TrackView<const K, const V, R>&>(track).at(key, hint);
-        }, &destination, nullptr, nullptr);
+        }, &destination, nullptr, nullptr, reinterpret_cast<void(*)()>(track.interpolator()));
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
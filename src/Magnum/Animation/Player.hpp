@@ -35,6 +35,10 @@
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Reference.h>
 
+#include "Magnum/Math/CubicHermite.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/Vector4.h"
+
 namespace Magnum { namespace Animation {
 
 namespace Implementation {
@@ -55,13 +59,67 @@ namespace Implementation {
             return {playCount, factor};
         }
     };
+
+    /* Batched advance() */
+    template<class K> struct PlayerBatchItem {
+        const TrackViewStorage<const K>* track;
+        std::size_t* hint;
+        void* destination;
+        K key;
+    };
+
+    template<class K> struct PlayerBatchKernel {
+        void(*interpolator)();
+        void(*advance)(Containers::ArrayView<const PlayerBatchItem<K>>);
+    };
+
+    /* The interpolator is a template parameter so it gets inlined into the
+       interpolate() loop instead of being called through a pointer */
+    template<class K, class V, class R, R(*interpolator)(const V&, const V&, Float)> void playerBatchAdvance(const Containers::ArrayView<const PlayerBatchItem<K>> items) {
+        for(const PlayerBatchItem<K>& item: items) {
+            const TrackView<const K, const V, R>& track = static_cast<const TrackView<const K, const V, R>&>(*item.track);
+            *static_cast<R*>(item.destination) = interpolate<K, V, R>(track.keys(), track.values(), track.before(), track.after(), interpolator, item.key, *item.hint);
+        }
+    }
+
+    enum: std::size_t { PlayerBatchKernelCount = 17 };
+
+    template<class K> const PlayerBatchKernel<K>* playerBatchKernels() {
+        #define _c(V, R, interpolator) {reinterpret_cast<void(*)()>(static_cast<R(*)(const V&, const V&, Float)>(interpolator)), playerBatchAdvance<K, V, R, interpolator>}
+        static const PlayerBatchKernel<K> kernels[]{
+            _c(Float, Float, Math::select),
+            _c(Float, Float, Math::lerp),
+            _c(Vector2, Vector2, Math::select),
+            _c(Vector2, Vector2, Math::lerp),
+            _c(Vector3, Vector3, Math::select),
+            _c(Vector3, Vector3, Math::lerp),
+            _c(Vector4, Vector4, Math::select),
+            _c(Vector4, Vector4, Math::lerp),
+            _c(Quaternion, Quaternion, Math::select),
+            _c(Quaternion, Quaternion, Math::lerp),
+            _c(Quaternion, Quaternion, Math::lerpShortestPath),
+            _c(Quaternion, Quaternion, Math::slerp),
+            _c(Quaternion, Quaternion, Math::slerpShortestPath),
+            _c(CubicHermite1D, Float, Math::splerp),
+            _c(CubicHermite2D, Vector2, Math::splerp),
+            _c(CubicHermite3D, Vector3, Math::splerp),
+            _c(CubicHermiteQuaternion, Quaternion, Math::splerp)
+        };
+        #undef _c
+        static_assert(sizeof(kernels)/sizeof(kernels[0]) == PlayerBatchKernelCount, "");
+        return kernels;
+    }
+
+    /* Non-templated so the threading is contained in the library */
+    MAGNUM_EXPORT std::size_t playerWorkerCount(std::size_t threadCount, std::size_t playerCount, std::size_t trackCount);
+    MAGNUM_EXPORT void playerParallelFor(std::size_t count, void(*function)(void*, std::size_t), void* state);
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template<class T, class K> struct Player<T, K>::Track  {
     /* Not sure why is this still needed for emplace_back(). It's 2018,
        COME ON  ¯\_(ツ)_/¯ */
-    /*implicit*/ Track(const TrackViewStorage<const K>& track, void (*advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* destination, void(*userCallback)(), void* userCallbackData, std::size_t hint) noexcept: track{track}, advancer{advancer}, destination{destination}, userCallback{userCallback}, userCallbackData{userCallbackData}, hint{hint} {}
+    /*implicit*/ Track(const TrackViewStorage<const K>& track, void (*advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* destination, void(*userCallback)(), void* userCallbackData, std::size_t hint, UnsignedByte batchKernel) noexcept: track{track}, advancer{advancer}, destination{destination}, userCallback{userCallback}, userCallbackData{userCallbackData}, hint{hint}, batchKernel{batchKernel} {}
 
     TrackViewStorage<const K> track;
     void (*advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*);
@@ -69,6 +127,9 @@ template<class T, class K> struct Player<T, K>::Track  {
     void(*userCallback)();
     void* userCallbackData;
     std::size_t hint;
+    /* Index into Implementation::playerBatchKernels() plus one, 0 if the
+       track can't be advanced in a batch */
+    UnsignedByte batchKernel;
 };
 #endif
 
@@ -101,12 +162,24 @@ template<class T, class K> const TrackViewStorage<const K>& Player<T, K>::track(
     return _tracks[i].track;
 }
 
-template<class T, class K> Player<T, K>& Player<T, K>::addInternal(const TrackViewStorage<const K>& track, void(*const advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* const destination, void(*const userCallback)(), void* const userCallbackData) {
+template<class T, class K> Player<T, K>& Player<T, K>::addInternal(const TrackViewStorage<const K>& track, void(*const advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* const destination, void(*const userCallback)(), void* const userCallbackData, void(*const interpolator)()) {
     if(_tracks.empty() && _duration == Math::Range1D<K>{})
         _duration = track.duration();
     else
         _duration = Math::join(track.duration(), _duration);
-    arrayAppend(_tracks, Containers::InPlaceInit, track, advancer, destination, userCallback, userCallbackData, 0u);
+
+    /* Find a kernel for the batched advance() */
+    UnsignedByte batchKernel = 0;
+    if(interpolator) {
+        const Implementation::PlayerBatchKernel<K>* const kernels = Implementation::playerBatchKernels<K>();
+        for(std::size_t i = 0; i != Implementation::PlayerBatchKernelCount; ++i) {
+            if(kernels[i].interpolator != interpolator) continue;
+            batchKernel = UnsignedByte(i + 1);
+            break;
+        }
+    }
+
+    arrayAppend(_tracks, Containers::InPlaceInit, track, advancer, destination, userCallback, userCallbackData, 0u, batchKernel);
     return *this;
 }
 
@@ -308,6 +381,51 @@ template<class T, class K> Player<T, K>& Player<T, K>::advance(const T time) {
     return *this;
 }
 
+template<class T, class K> void Player<T, K>::advance(const T time, const Containers::ArrayView<const Containers::Reference<Player<T, K>>> players, const std::size_t threadCount) {
+    std::size_t trackCount = 0;
+    for(const Player<T, K>& player: players) trackCount += player._tracks.size();
+
+    const std::size_t workerCount = Implementation::playerWorkerCount(threadCount, players.size(), trackCount);
+    if(workerCount == 1) {
+        advanceBatch(time, players);
+        return;
+    }
+
+    struct State {
+        T time;
+        Containers::ArrayView<const Containers::Reference<Player<T, K>>> players;
+        std::size_t workerCount;
+    } state{time, players, workerCount};
+    Implementation::playerParallelFor(workerCount, [](void* data, const std::size_t worker) {
+        const State& state = *static_cast<const State*>(data);
+        const std::size_t size = state.players.size();
+        advanceBatch(state.time, state.players.slice(size*worker/state.workerCount, size*(worker + 1)/state.workerCount));
+    }, &state);
+}
+
+template<class T, class K> void Player<T, K>::advanceBatch(const T time, const Containers::ArrayView<const Containers::Reference<Player<T, K>>> players) {
+    /* Advance tracks that can't be batched right away, collect the rest */
+    Containers::Array<Implementation::PlayerBatchItem<K>> batches[Implementation::PlayerBatchKernelCount];
+    for(Player<T, K>& player: players) {
+        Containers::Optional<std::pair<UnsignedInt, K>> elapsed = Implementation::playerElapsed(player._duration.size(), player._playCount, player._scaler, time, player._startTime, player._stopPauseTime, player._state);
+        if(!elapsed) continue;
+
+        const K key = player._duration.min() + elapsed->second;
+        for(Track& t: player._tracks) {
+            if(t.batchKernel)
+                arrayAppend(batches[t.batchKernel - 1], Implementation::PlayerBatchItem<K>{&t.track, &t.hint, t.destination, key});
+            else
+                t.advancer(t.track, key, t.hint, t.destination, t.userCallback, t.userCallbackData);
+        }
+    }
+
+    /* Advance each group of tracks with the same value type and
+       interpolator in one go */
+    const Implementation::PlayerBatchKernel<K>* const kernels = Implementation::playerBatchKernels<K>();
+    for(std::size_t i = 0; i != Implementation::PlayerBatchKernelCount; ++i)
+        if(!batches[i].empty()) kernels[i].advance(batches[i]);
+}
+
 }}
 
 #endif
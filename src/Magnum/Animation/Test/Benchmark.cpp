@@ -23,9 +23,12 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Reference.h>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Animation/Player.h"
+#include "Magnum/Math/Quaternion.h"
 
 namespace Magnum { namespace Animation { namespace Test { namespace {
 
@@ -50,6 +53,10 @@ struct Benchmark: TestSuite::Tester {
     void playerAdvanceRawCallback();
     void playerAdvanceRawCallbackDirectInterpolator();
 
+    void playerAdvanceCrowd();
+    void playerAdvanceCrowdBatch();
+    void playerAdvanceCrowdBatchThreaded();
+
     Containers::Array<Float> _keys;
     Containers::Array<Int> _values;
     Containers::Array<std::pair<Float, Int>> _interleaved;
@@ -57,10 +64,24 @@ struct Benchmark: TestSuite::Tester {
     Containers::StridedArrayView1D<const Int> _valuesInterleaved;
     TrackView<const Float, const Int> _track;
     TrackView<const Float, const Int> _trackInterleaved;
+
+    Track<Float, Vector3> _crowdTranslation;
+    Track<Float, Quaternion> _crowdRotation;
+    Containers::Array<Player<Float>> _crowd;
+    Containers::Array<Containers::Reference<Player<Float>>> _crowdReferences;
+    Containers::Array<Vector3> _crowdTranslations;
+    Containers::Array<Quaternion> _crowdRotations;
 };
 
 namespace {
-    enum: std::size_t { DataSize = 2000 };
+    enum: std::size_t {
+        DataSize = 2000,
+        /* A thousand characters with 16 bones each, every bone animated with
+           a translation and rotation track */
+        CrowdSize = 1000,
+        CrowdBoneCount = 16,
+        CrowdKeyframeCount = 30
+    };
 }
 
 Benchmark::Benchmark() {
@@ -80,7 +101,11 @@ Benchmark::Benchmark() {
                    &Benchmark::playerAdvance,
                    &Benchmark::playerAdvanceCallback,
                    &Benchmark::playerAdvanceRawCallback,
-                   &Benchmark::playerAdvanceRawCallbackDirectInterpolator}, 10);
+                   &Benchmark::playerAdvanceRawCallbackDirectInterpolator,
+
+                   &Benchmark::playerAdvanceCrowd,
+                   &Benchmark::playerAdvanceCrowdBatch,
+                   &Benchmark::playerAdvanceCrowdBatchThreaded}, 10);
 
     _keys = Containers::Array<Float>{DataSize};
     _values = Containers::Array<Int>{Containers::DirectInit, DataSize, 1};
@@ -94,6 +119,29 @@ Benchmark::Benchmark() {
     _track = TrackView<const Float, const Int>{
         Containers::arrayView(_keys), Containers::arrayView(_values), Math::select};
     _trackInterleaved = {_keysInterleaved, _valuesInterleaved, Math::select};
+
+    Containers::Array<std::pair<Float, Vector3>> translations{CrowdKeyframeCount};
+    Containers::Array<std::pair<Float, Quaternion>> rotations{CrowdKeyframeCount};
+    for(std::size_t i = 0; i != CrowdKeyframeCount; ++i) {
+        translations[i] = {i/30.0f, Vector3{Float(i % 3), Float(i % 5), Float(i % 7)}};
+        rotations[i] = {i/30.0f, Quaternion::rotation(Deg(i*13.0f), Vector3{1.0f, Float(i % 2), 0.0f}.normalized())};
+    }
+    _crowdTranslation = Track<Float, Vector3>{std::move(translations), Interpolation::Linear, Extrapolation::Constant};
+    _crowdRotation = Track<Float, Quaternion>{std::move(rotations), Interpolation::Linear, Extrapolation::Constant};
+
+    _crowd = Containers::Array<Player<Float>>{CrowdSize};
+    _crowdTranslations = Containers::Array<Vector3>{CrowdSize*CrowdBoneCount};
+    _crowdRotations = Containers::Array<Quaternion>{CrowdSize*CrowdBoneCount};
+    for(std::size_t i = 0; i != CrowdSize; ++i) {
+        for(std::size_t j = 0; j != CrowdBoneCount; ++j) {
+            _crowd[i].add(_crowdTranslation, _crowdTranslations[i*CrowdBoneCount + j])
+                .add(_crowdRotation, _crowdRotations[i*CrowdBoneCount + j]);
+        }
+        /* Each character starts at a different time */
+        _crowd[i].setPlayCount(0)
+            .play(-0.0137f*i);
+        arrayAppend(_crowdReferences, _crowd[i]);
+    }
 }
 
 void Benchmark::interpolateEmpty() {
@@ -260,6 +308,39 @@ void Benchmark::playerAdvanceRawCallbackDirectInterpolator() {
     CORRADE_COMPARE(result, 125000);
 }
 
+void Benchmark::playerAdvanceCrowd() {
+    Float time = 0.0f;
+    CORRADE_BENCHMARK(5) {
+        time += 1.0f/60.0f;
+        for(Player<Float>& player: _crowd) player.advance(time);
+    }
+
+    CORRADE_COMPARE(_crowdTranslations[CrowdBoneCount*5 + 3], _crowdTranslation.at(_crowd[5].elapsed(time).second));
+    CORRADE_COMPARE(_crowdRotations[CrowdBoneCount*7 + 2], _crowdRotation.at(_crowd[7].elapsed(time).second));
+}
+
+void Benchmark::playerAdvanceCrowdBatch() {
+    Float time = 0.0f;
+    CORRADE_BENCHMARK(5) {
+        time += 1.0f/60.0f;
+        Player<Float>::advance(time, _crowdReferences);
+    }
+
+    CORRADE_COMPARE(_crowdTranslations[CrowdBoneCount*5 + 3], _crowdTranslation.at(_crowd[5].elapsed(time).second));
+    CORRADE_COMPARE(_crowdRotations[CrowdBoneCount*7 + 2], _crowdRotation.at(_crowd[7].elapsed(time).second));
+}
+
+void Benchmark::playerAdvanceCrowdBatchThreaded() {
+    Float time = 0.0f;
+    CORRADE_BENCHMARK(5) {
+        time += 1.0f/60.0f;
+        Player<Float>::advance(time, _crowdReferences, 0);
+    }
+
+    CORRADE_COMPARE(_crowdTranslations[CrowdBoneCount*5 + 3], _crowdTranslation.at(_crowd[5].elapsed(time).second));
+    CORRADE_COMPARE(_crowdRotations[CrowdBoneCount*7 + 2], _crowdRotation.at(_crowd[7].elapsed(time).second));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Animation::Test::Benchmark)
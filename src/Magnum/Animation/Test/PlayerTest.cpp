@@ -32,6 +32,8 @@
 #include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Animation/Player.h"
+#include "Magnum/Math/CubicHermite.h"
+#include "Magnum/Math/Quaternion.h"
 
 namespace Magnum { namespace Animation { namespace Test { namespace {
 
@@ -62,6 +64,8 @@ struct PlayerTest: TestSuite::Tester {
     void advancePlayCountInfinite();
     void advanceChrono();
     void advanceList();
+    void advanceBatch();
+    void advanceBatchMultithreaded();
     void advanceZeroDurationStop();
     void advanceZeroDurationPause();
     void advanceZeroDurationInfinitePlayCount();
@@ -153,6 +157,8 @@ PlayerTest::PlayerTest() {
               &PlayerTest::advancePlayCountInfinite,
               &PlayerTest::advanceChrono,
               &PlayerTest::advanceList,
+              &PlayerTest::advanceBatch,
+              &PlayerTest::advanceBatchMultithreaded,
               &PlayerTest::advanceZeroDurationStop,
               &PlayerTest::advanceZeroDurationPause,
               &PlayerTest::advanceZeroDurationInfinitePlayCount,
@@ -804,6 +810,111 @@ void PlayerTest::advanceList() {
     CORRADE_COMPARE(valueB, 2.75f);
 }
 
+void PlayerTest::advanceBatch() {
+    using namespace Math::Literals;
+
+    const Animation::Track<Float, Vector3> translation{{
+        {0.0f, {1.0f, 2.0f, 3.0f}},
+        {1.0f, {2.0f, 0.0f, -1.0f}},
+        {2.5f, {-4.0f, 1.0f, 0.5f}}
+    }, Math::lerp, Extrapolation::Extrapolated};
+    const Animation::Track<Float, Quaternion> rotation{{
+        {0.5f, Quaternion::rotation(15.0_degf, Vector3::xAxis())},
+        {2.0f, Quaternion::rotation(-75.0_degf, Vector3::yAxis())},
+    }, Interpolation::Linear, Extrapolation::DefaultConstructed, Extrapolation::Constant};
+    const Animation::Track<Float, CubicHermite1D> spline{{
+        {0.0f, {0.0f, 1.0f, 2.0f}},
+        {1.5f, {1.0f, 3.0f, -1.0f}},
+        {3.0f, {0.5f, -2.0f, 0.0f}}
+    }, Interpolation::Spline};
+    /* No batch kernel for Int */
+    const Animation::Track<Float, Int> step{{
+        {0.0f, 3},
+        {2.0f, -7}
+    }, Math::select};
+
+    struct Result {
+        Vector3 translation;
+        Quaternion rotation;
+        Float spline;
+        Int step;
+        Float callback;
+    };
+
+    /* Set up the players the same way, but with a different start time */
+    Result expected[5]{};
+    Result actual[5]{};
+    Player<Float> expectedPlayers[5];
+    Player<Float> actualPlayers[5];
+    Containers::Array<Containers::Reference<Player<Float>>> players;
+    for(std::size_t i = 0; i != 5; ++i) {
+        for(auto player: {std::make_pair(&expectedPlayers[i], &expected[i]), std::make_pair(&actualPlayers[i], &actual[i])}) {
+            player.first->add(translation, player.second->translation)
+                .add(rotation, player.second->rotation)
+                .add(spline, player.second->spline)
+                .add(step, player.second->step)
+                .addWithCallback(translation, [](Float, const Vector3& value, Float& result) {
+                    result = value.x();
+                }, player.second->callback);
+            /* The last player isn't started */
+            if(i != 4) player.first->play(-0.7f*i);
+        }
+        arrayAppend(players, actualPlayers[i]);
+    }
+
+    for(Float time: {0.0f, 0.25f, 1.1f, 0.9f, 2.2f, 5.0f}) {
+        CORRADE_ITERATION(time);
+
+        for(Player<Float>& player: expectedPlayers) player.advance(time);
+        Player<Float>::advance(time, players);
+
+        for(std::size_t i = 0; i != 5; ++i) {
+            CORRADE_ITERATION(i);
+            CORRADE_COMPARE(actualPlayers[i].state(), expectedPlayers[i].state());
+            CORRADE_COMPARE(actual[i].translation, expected[i].translation);
+            CORRADE_COMPARE(actual[i].rotation, expected[i].rotation);
+            CORRADE_COMPARE(actual[i].spline, expected[i].spline);
+            CORRADE_COMPARE(actual[i].step, expected[i].step);
+            CORRADE_COMPARE(actual[i].callback, expected[i].callback);
+        }
+    }
+
+    /* The last player wasn't started so nothing should be written there */
+    CORRADE_COMPARE(actual[4].translation, Vector3{});
+    CORRADE_COMPARE(actual[4].callback, 0.0f);
+}
+
+void PlayerTest::advanceBatchMultithreaded() {
+    const Animation::Track<Float, Vector3> track{{
+        {0.0f, {1.0f, 2.0f, 3.0f}},
+        {1.0f, {2.0f, 0.0f, -1.0f}},
+        {2.5f, {-4.0f, 1.0f, 0.5f}}
+    }, Math::lerp};
+
+    /* Enough tracks for the players to get split among more threads */
+    constexpr std::size_t PlayerCount = 64;
+    constexpr std::size_t TrackCount = 256;
+    Containers::Array<Vector3> actual{PlayerCount*TrackCount};
+    Containers::Array<Player<Float>> players{PlayerCount};
+    Containers::Array<Containers::Reference<Player<Float>>> playerReferences;
+    for(std::size_t i = 0; i != PlayerCount; ++i) {
+        for(std::size_t j = 0; j != TrackCount; ++j)
+            players[i].add(track, actual[i*TrackCount + j]);
+        players[i].setPlayCount(0)
+            .play(-0.01f*i);
+        arrayAppend(playerReferences, players[i]);
+    }
+
+    Player<Float>::advance(1.7f, playerReferences, 4);
+    for(std::size_t i = 0; i != PlayerCount; ++i) {
+        const Vector3 value = track.at(players[i].elapsed(1.7f).second);
+        for(std::size_t j = 0; j != TrackCount; ++j) {
+            CORRADE_ITERATION(i*TrackCount + j);
+            CORRADE_COMPARE(actual[i*TrackCount + j], value);
+        }
+    }
+}
+
 void PlayerTest::advanceZeroDurationStop() {
     Float value = -1.0f;
     Player<Float> player;
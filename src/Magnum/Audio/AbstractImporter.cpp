@@ -27,6 +27,7 @@
 
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
@@ -40,7 +41,7 @@ namespace Magnum { namespace Audio {
 std::string AbstractImporter::pluginInterface() {
     return
 /* [interface] */
-"cz.mosra.magnum.Audio.AbstractImporter/0.1"
+"cz.mosra.magnum.Audio.AbstractImporter/0.2"
 /* [interface] */
     ;
 }
@@ -73,6 +74,17 @@ AbstractImporter::AbstractImporter(PluginManager::Manager<AbstractImporter>& man
 
 AbstractImporter::AbstractImporter(PluginManager::AbstractManager& manager, const std::string& plugin): PluginManager::AbstractManagingPlugin<AbstractImporter>{manager, plugin} {}
 
+void AbstractImporter::setFileCallback(Containers::Optional<Containers::ArrayView<const char>>(*callback)(const std::string&, InputFileCallbackPolicy, void*), void* const userData) {
+    CORRADE_ASSERT(!isOpened(), "Audio::AbstractImporter::setFileCallback(): can't be set while a file is opened", );
+    CORRADE_ASSERT(features() & (ImporterFeature::FileCallback|ImporterFeature::OpenData), "Audio::AbstractImporter::setFileCallback(): importer supports neither loading from data nor via callbacks, callbacks can't be used", );
+
+    _fileCallback = callback;
+    _fileCallbackUserData = userData;
+    doSetFileCallback(callback, userData);
+}
+
+void AbstractImporter::doSetFileCallback(Containers::Optional<Containers::ArrayView<const char>>(*)(const std::string&, InputFileCallbackPolicy, void*), void*) {}
+
 bool AbstractImporter::openData(Containers::ArrayView<const char> data) {
     CORRADE_ASSERT(features() & ImporterFeature::OpenData,
         "Audio::AbstractImporter::openData(): feature not supported", {});
@@ -88,13 +100,48 @@ void AbstractImporter::doOpenData(Containers::ArrayView<const char>) {
 
 bool AbstractImporter::openFile(const std::string& filename) {
     close();
-    doOpenFile(filename);
+
+    /* If file loading callbacks are not set or the importer supports handling
+       them directly, call into the implementation */
+    if(!_fileCallback || (doFeatures() & ImporterFeature::FileCallback)) {
+        doOpenFile(filename);
+
+    /* Otherwise, if loading from data is supported, use the callback and pass
+       the data through to openData(). Mark the file as ready to be closed once
+       opening is finished. */
+    } else if(doFeatures() & ImporterFeature::OpenData) {
+        /* This needs to be duplicated here and in the doOpenFile()
+           implementation for the same reasons as in Trade::AbstractImporter */
+        const Containers::Optional<Containers::ArrayView<const char>> data = _fileCallback(filename, InputFileCallbackPolicy::LoadTemporary, _fileCallbackUserData);
+        if(!data) {
+            Error() << "Audio::AbstractImporter::openFile(): cannot open file" << filename;
+            return isOpened();
+        }
+        doOpenData(*data);
+        _fileCallback(filename, InputFileCallbackPolicy::Close, _fileCallbackUserData);
+
+    /* Shouldn't get here, the assert is fired already in setFileCallback() */
+    } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
     return isOpened();
 }
 
 void AbstractImporter::doOpenFile(const std::string& filename) {
     CORRADE_ASSERT(features() & ImporterFeature::OpenData, "Audio::AbstractImporter::openFile(): not implemented", );
 
+    /* If callbacks are set, use them. This is the same implementation as in
+       openFile(), see the comment there for details. */
+    if(_fileCallback) {
+        const Containers::Optional<Containers::ArrayView<const char>> data = _fileCallback(filename, InputFileCallbackPolicy::LoadTemporary, _fileCallbackUserData);
+        if(!data) {
+            Error() << "Audio::AbstractImporter::openFile(): cannot open file" << filename;
+            return;
+        }
+        doOpenData(*data);
+        _fileCallback(filename, InputFileCallbackPolicy::Close, _fileCallbackUserData);
+        return;
+    }
+
     /* Open file */
     if(!Utility::Directory::exists(filename)) {
         Error() << "Audio::AbstractImporter::openFile(): cannot open file" << filename;
@@ -129,6 +176,60 @@ Containers::Array<char> AbstractImporter::data() {
     return out;
 }
 
+std::size_t AbstractImporter::sampleCount() const {
+    CORRADE_ASSERT(features() & ImporterFeature::Streaming,
+        "Audio::AbstractImporter::sampleCount(): feature not supported", {});
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::sampleCount(): no file opened", {});
+    return doSampleCount();
+}
+
+std::size_t AbstractImporter::doSampleCount() const {
+    CORRADE_ASSERT_UNREACHABLE("Audio::AbstractImporter::sampleCount(): feature advertised but not implemented", {});
+}
+
+std::size_t AbstractImporter::sampleOffset() const {
+    CORRADE_ASSERT(features() & ImporterFeature::Streaming,
+        "Audio::AbstractImporter::sampleOffset(): feature not supported", {});
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::sampleOffset(): no file opened", {});
+    return doSampleOffset();
+}
+
+std::size_t AbstractImporter::doSampleOffset() const {
+    CORRADE_ASSERT_UNREACHABLE("Audio::AbstractImporter::sampleOffset(): feature advertised but not implemented", {});
+}
+
+void AbstractImporter::seek(const std::size_t offset) {
+    CORRADE_ASSERT(features() & ImporterFeature::Streaming,
+        "Audio::AbstractImporter::seek(): feature not supported", );
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::seek(): no file opened", );
+    #ifndef CORRADE_NO_ASSERT
+    const std::size_t sampleCount = doSampleCount();
+    #endif
+    CORRADE_ASSERT(offset <= sampleCount,
+        "Audio::AbstractImporter::seek(): offset" << offset << "out of bounds for" << sampleCount << "samples", );
+    doSeek(offset);
+}
+
+void AbstractImporter::doSeek(std::size_t) {
+    CORRADE_ASSERT_UNREACHABLE("Audio::AbstractImporter::seek(): feature advertised but not implemented", );
+}
+
+std::size_t AbstractImporter::read(const Containers::ArrayView<char> data) {
+    CORRADE_ASSERT(features() & ImporterFeature::Streaming,
+        "Audio::AbstractImporter::read(): feature not supported", {});
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::read(): no file opened", {});
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt size = sampleSize(doFormat());
+    #endif
+    CORRADE_ASSERT(data.size() >= size,
+        "Audio::AbstractImporter::read(): expected space for at least one sample of" << size << "bytes but got" << data.size(), {});
+    return doRead(data);
+}
+
+std::size_t AbstractImporter::doRead(Containers::ArrayView<char>) {
+    CORRADE_ASSERT_UNREACHABLE("Audio::AbstractImporter::read(): feature advertised but not implemented", {});
+}
+
 Debug& operator<<(Debug& debug, const ImporterFeature value) {
     debug << "Audio::ImporterFeature" << Debug::nospace;
 
@@ -136,6 +237,8 @@ Debug& operator<<(Debug& debug, const ImporterFeature value) {
         /* LCOV_EXCL_START */
         #define _c(v) case ImporterFeature::v: return debug << "::" #v;
         _c(OpenData)
+        _c(FileCallback)
+        _c(Streaming)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -145,7 +248,9 @@ Debug& operator<<(Debug& debug, const ImporterFeature value) {
 
 Debug& operator<<(Debug& debug, const ImporterFeatures value) {
     return Containers::enumSetDebugOutput(debug, value, "Audio::ImporterFeatures{}", {
-        ImporterFeature::OpenData});
+        ImporterFeature::OpenData,
+        ImporterFeature::FileCallback,
+        ImporterFeature::Streaming});
 }
 
 }}
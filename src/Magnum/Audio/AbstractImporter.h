@@ -31,6 +31,7 @@
 
 #include <Corrade/PluginManager/AbstractManagingPlugin.h>
 
+#include "Magnum/FileCallback.h"
 #include "Magnum/Magnum.h"
 #include "Magnum/Audio/BufferFormat.h"
 
@@ -44,7 +45,24 @@ namespace Magnum { namespace Audio {
 */
 enum class ImporterFeature: UnsignedByte {
     /** Opening files from raw data using @ref AbstractImporter::openData() */
-    OpenData = 1 << 0
+    OpenData = 1 << 0,
+
+    /**
+     * Specifying callbacks for loading the file using
+     * @ref AbstractImporter::setFileCallback(). If the importer doesn't
+     * expose this feature, the callbacks can still be used if it supports
+     * @ref ImporterFeature::OpenData, see the function documentation for
+     * details.
+     * @m_since_latest
+     */
+    FileCallback = 1 << 1,
+
+    /**
+     * Decoding the sample data in chunks using @ref AbstractImporter::read()
+     * and seeking using @ref AbstractImporter::seek()
+     * @m_since_latest
+     */
+    Streaming = 1 << 2
 };
 
 /**
@@ -79,11 +97,50 @@ around in order to have the returned data valid. Moreover, all returned
 deleters --- this is to avoid potential dangling function pointer calls when
 destructing such instances after the plugin module has been unloaded.
 
+@section Audio-AbstractImporter-streaming Streaming
+
+Importers that advertise @ref ImporterFeature::Streaming can decode the sample
+data in chunks into a caller-provided buffer with @ref read() instead of
+returning all of it at once with @ref data(). The @ref sampleCount() and
+@ref sampleOffset() functions give the total length and the current position,
+@ref seek() moves to an arbitrary sample. A sample here means a value for all
+channels, the same as in @ref Buffer::sampleCount(), and its size in bytes is
+given by @ref sampleSize(BufferFormat).
+
+@snippet MagnumAudio.cpp AbstractImporter-streaming
+
+Together with a memory-mapped file or a file loading callback (see below), the
+sample data don't need to be fully resident in memory. Use @ref BufferRing to
+queue the decoded chunks onto a @ref Source for playback.
+
+@section Audio-AbstractImporter-callbacks Loading data from memory or using file callbacks
+
+For importers that advertise support for @ref ImporterFeature::FileCallback,
+files opened with @ref openFile() are loaded through a callback set using
+@ref setFileCallback(). The callback gets a filename,
+@ref InputFileCallbackPolicy and an user pointer as parameters; returns a
+non-owning view on the loaded data or a
+@ref Corrade::Containers::NullOpt "Containers::NullOpt" to indicate the file
+loading failed. The semantics are the same as for
+@ref Trade::AbstractImporter::setFileCallback().
+
+For importers that don't support @ref ImporterFeature::FileCallback directly,
+the base @ref openFile() implementation will use the file callback to pass the
+loaded data through to @ref openData(), in case the importer supports at least
+@ref ImporterFeature::OpenData.
+
 @section Audio-AbstractImporter-subclassing Subclassing
 
 Plugin implements function @ref doFeatures(), @ref doIsOpened(), one of or both
 @ref doOpenData() and @ref doOpenFile() functions, function @ref doClose() and
 data access functions @ref doFormat(), @ref doFrequency() and @ref doData().
+Importers supporting @ref ImporterFeature::Streaming additionally implement
+@ref doSampleCount(), @ref doSampleOffset(), @ref doSeek() and @ref doRead().
+
+In order to support @ref ImporterFeature::FileCallback, the importer needs to
+use the callbacks to load the file in @ref doOpenFile(). The callback and its
+user data are available through @ref fileCallback() and
+@ref fileCallbackUserData().
 
 You don't need to do most of the redundant sanity checks, these things are
 checked by the implementation:
@@ -95,6 +152,14 @@ checked by the implementation:
     is supported.
 -   All `do*()` implementations working on opened file are called only if
     there is any file opened.
+-   The @ref doSetFileCallback() function is called only if
+    @ref ImporterFeature::FileCallback is supported and there is no file
+    opened.
+-   Functions @ref doSampleCount(), @ref doSampleOffset(), @ref doSeek() and
+    @ref doRead() are called only if @ref ImporterFeature::Streaming is
+    supported, @ref doSeek() is called only if the offset is not larger than
+    @ref sampleCount() and @ref doRead() only if the output has space for
+    at least one sample.
 
 @m_class{m-block m-warning}
 
@@ -159,6 +224,52 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Whether any file is opened */
         bool isOpened() const { return doIsOpened(); }
 
+        /**
+         * @brief File opening callback function
+         * @m_since_latest
+         *
+         * @see @ref Audio-AbstractImporter-callbacks
+         */
+        auto fileCallback() const -> Containers::Optional<Containers::ArrayView<const char>>(*)(const std::string&, InputFileCallbackPolicy, void*) { return _fileCallback; }
+
+        /**
+         * @brief File opening callback user data
+         * @m_since_latest
+         *
+         * @see @ref Audio-AbstractImporter-callbacks
+         */
+        void* fileCallbackUserData() const { return _fileCallbackUserData; }
+
+        /**
+         * @brief Set file opening callback
+         * @m_since_latest
+         *
+         * In case the importer supports @ref ImporterFeature::FileCallback,
+         * files opened through @ref openFile() will be loaded through the
+         * provided callback. The callback function gets a filename,
+         * @ref InputFileCallbackPolicy and the @p userData pointer as input
+         * and returns a non-owning view on the loaded data as output or a
+         * @ref Corrade::Containers::NullOpt if loading failed.
+         *
+         * In case the importer doesn't support
+         * @ref ImporterFeature::FileCallback but supports at least
+         * @ref ImporterFeature::OpenData, a file opened through
+         * @ref openFile() will be internally loaded through the provided
+         * callback with @ref InputFileCallbackPolicy::LoadTemporary, passed
+         * to @ref openData() and then the callback is called again with
+         * @ref InputFileCallbackPolicy::Close.
+         *
+         * In case @p callback is @cpp nullptr @ce, the current callback (if
+         * any) is reset. This function expects that the importer supports
+         * either @ref ImporterFeature::FileCallback or
+         * @ref ImporterFeature::OpenData and that it's called *before* a file
+         * is opened. It's also expected that the loaded data are kept in scope
+         * for as long as the importer needs them, based on the value of
+         * @ref InputFileCallbackPolicy.
+         * @see @ref Audio-AbstractImporter-callbacks
+         */
+        void setFileCallback(Containers::Optional<Containers::ArrayView<const char>>(*callback)(const std::string&, InputFileCallbackPolicy, void*), void* userData = nullptr);
+
         /**
          * @brief Open raw data
          *
@@ -192,6 +303,56 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Sample data */
         Containers::Array<char> data();
 
+        /**
+         * @brief Sample count
+         * @m_since_latest
+         *
+         * Count of samples in the file, each sample containing a value for
+         * all channels. Available only if @ref ImporterFeature::Streaming is
+         * supported.
+         * @see @ref Audio-AbstractImporter-streaming
+         */
+        std::size_t sampleCount() const;
+
+        /**
+         * @brief Sample offset
+         * @m_since_latest
+         *
+         * Offset of the sample that will be decoded by the next @ref read()
+         * call. Initially @cpp 0 @ce, equal to @ref sampleCount() once all
+         * data are read. Available only if @ref ImporterFeature::Streaming is
+         * supported.
+         * @see @ref Audio-AbstractImporter-streaming
+         */
+        std::size_t sampleOffset() const;
+
+        /**
+         * @brief Seek to given sample
+         * @m_since_latest
+         *
+         * Sets the offset from which the next @ref read() call decodes. The
+         * @p offset is expected to not be larger than @ref sampleCount().
+         * Available only if @ref ImporterFeature::Streaming is supported.
+         * @see @ref Audio-AbstractImporter-streaming
+         */
+        void seek(std::size_t offset);
+
+        /**
+         * @brief Decode sample data into given buffer
+         * @m_since_latest
+         *
+         * Decodes at most @cpp data.size()/sampleSize(format()) @ce samples
+         * starting at @ref sampleOffset() into @p data and advances the
+         * offset. Returns the number of samples decoded, which is less than
+         * the buffer capacity only when the end of the data is reached, and
+         * @cpp 0 @ce if there's nothing left. The data have the same layout
+         * as the output of @ref data(). Expects that @p data has space for at
+         * least one sample. Available only if @ref ImporterFeature::Streaming
+         * is supported.
+         * @see @ref Audio-AbstractImporter-streaming
+         */
+        std::size_t read(Containers::ArrayView<char> data);
+
         /* Since 1.8.17, the original short-hand group closing doesn't work
            anymore. FFS. */
         /**
@@ -217,6 +378,18 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          */
         virtual void doOpenFile(const std::string& filename);
 
+        /**
+         * @brief Implementation for @ref setFileCallback()
+         * @m_since_latest
+         *
+         * Useful when the importer needs to modify some internal state on
+         * callback setup. Default implementation does nothing and this
+         * function doesn't need to be implemented --- the callback function
+         * and user data pointer are available through @ref fileCallback() and
+         * @ref fileCallbackUserData().
+         */
+        virtual void doSetFileCallback(Containers::Optional<Containers::ArrayView<const char>>(*callback)(const std::string&, InputFileCallbackPolicy, void*), void* userData);
+
         /** @brief Implementation for @ref close() */
         virtual void doClose() = 0;
 
@@ -228,6 +401,33 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
 
         /** @brief Implementation for @ref data() */
         virtual Containers::Array<char> doData() = 0;
+
+        /**
+         * @brief Implementation for @ref sampleCount()
+         * @m_since_latest
+         */
+        virtual std::size_t doSampleCount() const;
+
+        /**
+         * @brief Implementation for @ref sampleOffset()
+         * @m_since_latest
+         */
+        virtual std::size_t doSampleOffset() const;
+
+        /**
+         * @brief Implementation for @ref seek()
+         * @m_since_latest
+         */
+        virtual void doSeek(std::size_t offset);
+
+        /**
+         * @brief Implementation for @ref read()
+         * @m_since_latest
+         */
+        virtual std::size_t doRead(Containers::ArrayView<char> data);
+
+        Containers::Optional<Containers::ArrayView<const char>>(*_fileCallback)(const std::string&, InputFileCallbackPolicy, void*){};
+        void* _fileCallbackUserData{};
 };
 
 }}
@@ -43,7 +43,9 @@ class AbstractImporter;
 enum class BufferFormat: ALenum;
 
 class Buffer;
+class BufferRing;
 class Context;
+class Resampler;
 class Source;
 /* Renderer used only statically */
 
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Enum @ref Magnum::Audio::BufferFormat
+ * @brief Enum @ref Magnum::Audio::BufferFormat, function @ref Magnum::Audio::sampleSize()
  */
 
 #include <al.h>
@@ -190,6 +190,16 @@ enum class BufferFormat: ALenum {
     Surround71Channel32 = AL_FORMAT_71CHN32
 };
 
+/**
+@brief Size of a sample in given format
+@m_since_latest
+
+Size of a single sample in bytes, including all channels. For example,
+@ref BufferFormat::Stereo16 is @cpp 4 @ce bytes.
+@see @ref Buffer::sampleCount(), @ref AbstractImporter::read()
+*/
+MAGNUM_AUDIO_EXPORT UnsignedInt sampleSize(BufferFormat format);
+
 /** @debugoperatorenum{BufferFormat} */
 MAGNUM_AUDIO_EXPORT Debug& operator<<(Debug& debug, BufferFormat value);
 
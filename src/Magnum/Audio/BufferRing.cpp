@@ -0,0 +1,107 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BufferRing.h"
+
+#include <new>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Audio/Source.h"
+
+namespace Magnum { namespace Audio {
+
+BufferRing::BufferRing(const std::size_t bufferCount, const std::size_t samplesPerBuffer): _buffers{Containers::DirectInit, bufferCount}, _references{Containers::NoInit, bufferCount}, _samplesPerBuffer{samplesPerBuffer} {
+    CORRADE_ASSERT(bufferCount && samplesPerBuffer,
+        "Audio::BufferRing: expected non-zero buffer count and sample count, got" << bufferCount << "and" << samplesPerBuffer, );
+
+    /* References aren't default-constructible, point them somewhere */
+    for(std::size_t i = 0; i != bufferCount; ++i)
+        new(&_references[i]) Containers::Reference<Buffer>{_buffers[i]};
+}
+
+BufferRing::BufferRing(BufferRing&&) noexcept = default;
+
+BufferRing::~BufferRing() = default;
+
+BufferRing& BufferRing::operator=(BufferRing&&) noexcept = default;
+
+std::size_t BufferRing::update(Source& source, AbstractImporter& importer) {
+    const std::size_t bufferCount = _buffers.size();
+
+    /* OpenAL unqueues processed buffers in the order they were queued, so
+       the unqueued ones are always the oldest in the ring */
+    if(_queuedCount) {
+        for(std::size_t i = 0; i != _queuedCount; ++i)
+            _references[i] = _buffers[(_first + i) % bufferCount];
+        const std::size_t unqueuedCount = source.unqueueBuffers(_references.prefix(_queuedCount));
+        _first = (_first + unqueuedCount) % bufferCount;
+        _queuedCount -= unqueuedCount;
+    }
+
+    /* Not doing anything with the importer if there's nothing to fill */
+    if(_queuedCount == bufferCount) return 0;
+
+    const BufferFormat format = importer.format();
+    const std::size_t sampleSize = Audio::sampleSize(format);
+    const std::size_t bufferSize = _samplesPerBuffer*sampleSize;
+    if(_data.size() != bufferSize)
+        _data = Containers::Array<char>{Containers::NoInit, bufferSize};
+
+    std::size_t queuedCount = 0;
+    while(_queuedCount + queuedCount != bufferCount) {
+        std::size_t sampleCount = 0;
+        while(sampleCount != _samplesPerBuffer) {
+            const std::size_t readCount = importer.read(_data.slice(sampleCount*sampleSize, bufferSize));
+            if(readCount) {
+                sampleCount += readCount;
+                continue;
+            }
+
+            /* Checking the sample count to avoid looping forever on empty
+               files */
+            if(!_looping || !importer.sampleCount()) break;
+            importer.seek(0);
+        }
+
+        /* Reached the end */
+        if(!sampleCount) break;
+
+        Buffer& buffer = _buffers[(_first + _queuedCount + queuedCount) % bufferCount];
+        buffer.setData(format, _data.prefix(sampleCount*sampleSize), importer.frequency());
+        _references[queuedCount++] = buffer;
+    }
+
+    if(queuedCount) {
+        source.queueBuffers(_references.prefix(queuedCount));
+        _queuedCount += queuedCount;
+    }
+
+    return queuedCount;
+}
+
+}}
@@ -0,0 +1,158 @@
+#ifndef Magnum_Audio_BufferRing_h
+#define Magnum_Audio_BufferRing_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Audio::BufferRing
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Reference.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Audio/Audio.h"
+#include "Magnum/Audio/visibility.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Ring of buffers for streamed playback
+@m_since_latest
+
+Owns a fixed set of @ref Buffer instances that get refilled from an importer
+supporting @ref ImporterFeature::Streaming and queued onto a @ref Source as
+they finish playing, so arbitrarily long files can be played back gaplessly
+with a constant memory footprint. Call @ref update() periodically, for
+example once per frame:
+
+@snippet MagnumAudio.cpp BufferRing
+
+Each call unqueues buffers that the source finished playing, fills them with
+the next @ref samplesPerBuffer() samples via @ref AbstractImporter::read()
+and queues them again in the same order. With @ref setLooping() enabled,
+the importer is rewound back to the start once it reaches the end, otherwise
+the ring stops queuing new buffers and the source stops once it plays what's
+left.
+
+If the source runs out of queued buffers because @ref update() wasn't called
+often enough, OpenAL puts it into the @ref Source::State::Stopped state.
+The ring refills it on the next @ref update() but it's up to the user to
+call @ref Source::play() again. The total latency is roughly
+@ref bufferCount() times @ref samplesPerBuffer() divided by the importer
+frequency.
+*/
+class MAGNUM_AUDIO_EXPORT BufferRing {
+    public:
+        /**
+         * @brief Constructor
+         * @param bufferCount       Count of buffers in the ring
+         * @param samplesPerBuffer  Max count of samples in each buffer
+         *
+         * Creates @p bufferCount OpenAL buffer objects. Both values are
+         * expected to be non-zero.
+         */
+        explicit BufferRing(std::size_t bufferCount, std::size_t samplesPerBuffer);
+
+        /** @brief Copying is not allowed */
+        BufferRing(const BufferRing&) = delete;
+
+        /** @brief Move constructor */
+        BufferRing(BufferRing&&) noexcept;
+
+        ~BufferRing();
+
+        /** @brief Copying is not allowed */
+        BufferRing& operator=(const BufferRing&) = delete;
+
+        /** @brief Move assignment */
+        BufferRing& operator=(BufferRing&&) noexcept;
+
+        /** @brief Count of buffers in the ring */
+        std::size_t bufferCount() const { return _buffers.size(); }
+
+        /** @brief Max count of samples in each buffer */
+        std::size_t samplesPerBuffer() const { return _samplesPerBuffer; }
+
+        /** @brief Buffers in the ring */
+        Containers::ArrayView<Buffer> buffers() { return _buffers; }
+
+        /**
+         * @brief Count of buffers currently queued on the source
+         *
+         * Includes buffers that were already played but not unqueued by
+         * @ref update() yet.
+         */
+        std::size_t queuedBufferCount() const { return _queuedCount; }
+
+        /** @brief Whether the playback loops */
+        bool isLooping() const { return _looping; }
+
+        /**
+         * @brief Set whether the playback loops
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, the importer is rewound to the start with
+         * @ref AbstractImporter::seek() once it reaches the end. Default is
+         * @cpp false @ce. Note that @ref Source::setLooping() can't be used
+         * for streamed playback.
+         */
+        BufferRing& setLooping(bool looping) {
+            _looping = looping;
+            return *this;
+        }
+
+        /**
+         * @brief Refill and queue processed buffers
+         * @return Count of newly queued buffers
+         *
+         * Unqueues buffers that @p source finished playing, fills them with
+         * data from @p importer continuing from its current
+         * @ref AbstractImporter::sampleOffset() and queues them back on
+         * @p source. The @p source and @p importer are expected to stay the
+         * same across calls for the ring to be consistent. The @p importer is
+         * expected to be opened and support @ref ImporterFeature::Streaming.
+         * @see @ref Source::unqueueBuffers(), @ref Source::queueBuffers()
+         */
+        std::size_t update(Source& source, AbstractImporter& importer);
+
+    private:
+        Containers::Array<Buffer> _buffers;
+        /* Used for passing buffer sequences to queueBuffers() and
+           unqueueBuffers() */
+        Containers::Array<Containers::Reference<Buffer>> _references;
+        /* Staging memory for AbstractImporter::read() */
+        Containers::Array<char> _data;
+        std::size_t _samplesPerBuffer;
+        /* Queued buffers are the _queuedCount ones starting at _first,
+           wrapping around */
+        std::size_t _first{}, _queuedCount{};
+        bool _looping{};
+};
+
+}}
+
+#endif
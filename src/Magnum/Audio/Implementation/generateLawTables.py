@@ -0,0 +1,101 @@
+#!/usr/bin/python3
+
+#
+#   This file is part of Magnum.
+#
+#   Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+#               2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+#
+#   Permission is hereby granted, free of charge, to any person obtaining a
+#   copy of this software and associated documentation files (the "Software"),
+#   to deal in the Software without restriction, including without limitation
+#   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+#   and/or sell copies of the Software, and to permit persons to whom the
+#   Software is furnished to do so, subject to the following conditions:
+#
+#   The above copyright notice and this permission notice shall be included
+#   in all copies or substantial portions of the Software.
+#
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+#   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+#   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+#   DEALINGS IN THE SOFTWARE.
+
+# Decoding tables for the G.711 A-law and μ-law companding, based on the
+# reference implementation in ITU-T G.191
+
+def decodealaw(i):
+    a = i ^ 0x55
+    exponent = (a >> 4) & 0x07
+    mantissa = a & 0x0f
+    if exponent == 0:
+        magnitude = (mantissa << 4) + 8
+    else:
+        magnitude = ((mantissa << 4) + 0x108) << (exponent - 1)
+    return magnitude if a & 0x80 else -magnitude
+
+def decodemulaw(i):
+    u = ~i & 0xff
+    exponent = (u >> 4) & 0x07
+    mantissa = u & 0x0f
+    magnitude = (((mantissa << 3) + 0x84) << exponent) - 0x84
+    return -magnitude if u & 0x80 else magnitude
+
+alaw_table = [decodealaw(i) for i in range(256)]
+mulaw_table = [decodemulaw(i) for i in range(256)]
+
+# Print the stuff
+print("""#ifndef Magnum_Audio_lawTables_hpp
+#define Magnum_Audio_lawTables_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Types.h"
+
+/* Generated by ./generateLawTables.py */
+
+namespace Magnum { namespace Audio { namespace {
+""")
+
+def print16bit(table):
+    for i, v in enumerate(table):
+        print("{:6}".format(v), end=",\n    " if not (i + 1) % 8 else ", " if not i == len(table) - 1 else "")
+
+print("constexpr Short ALawTable[256] = {\n    ", end="")
+print16bit(alaw_table)
+print("\n};\n")
+
+print("constexpr Short MuLawTable[256] = {\n    ", end="")
+print16bit(mulaw_table)
+print("""
+};
+
+}}}
+
+#endif
+""")
@@ -0,0 +1,226 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Resampler.h"
+
+#include <cmath>
+#include <cstring>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(CORRADE_TARGET_SSE2)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace Audio {
+
+namespace {
+
+/* Count of input samples the history can hold in addition to the filter
+   taps, i.e. how many samples get copied in at once */
+enum: std::size_t { BlockSize = 1024 };
+
+/* Same instruction set selection as in Math/PackingBatch.cpp. The sums are
+   reassociated compared to the scalar loop, so the results may differ in
+   the last bits. */
+Float dot(const Float* a, const Float* b, const std::size_t count) {
+    std::size_t i = 0;
+    Float sum = 0.0f;
+    #if defined(__AVX2__)
+    __m256 sumN = _mm256_setzero_ps();
+    for(; i + 8 <= count; i += 8)
+        sumN = _mm256_add_ps(sumN, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    __m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(sumN), _mm256_extractf128_ps(sumN, 1));
+    sum4 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+    sum4 = _mm_add_ss(sum4, _mm_shuffle_ps(sum4, sum4, _MM_SHUFFLE(1, 1, 1, 1)));
+    sum = _mm_cvtss_f32(sum4);
+    #elif defined(CORRADE_TARGET_SSE2)
+    __m128 sumN = _mm_setzero_ps();
+    for(; i + 4 <= count; i += 4)
+        sumN = _mm_add_ps(sumN, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    sumN = _mm_add_ps(sumN, _mm_movehl_ps(sumN, sumN));
+    sumN = _mm_add_ss(sumN, _mm_shuffle_ps(sumN, sumN, _MM_SHUFFLE(1, 1, 1, 1)));
+    sum = _mm_cvtss_f32(sumN);
+    #elif defined(__ARM_NEON) && defined(__aarch64__)
+    float32x4_t sumN = vdupq_n_f32(0.0f);
+    for(; i + 4 <= count; i += 4)
+        sumN = vmlaq_f32(sumN, vld1q_f32(a + i), vld1q_f32(b + i));
+    sum = vaddvq_f32(sumN);
+    #endif
+    for(; i != count; ++i)
+        sum += a[i]*b[i];
+    return sum;
+}
+
+UnsignedInt gcd(UnsignedInt a, UnsignedInt b) {
+    while(b) {
+        const UnsignedInt t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+}
+
+Resampler::Resampler(const UnsignedInt channelCount, const UnsignedInt inputFrequency, const UnsignedInt outputFrequency, const UnsignedInt tapCount): _channelCount{channelCount}, _inputFrequency{inputFrequency}, _outputFrequency{outputFrequency}, _tapCount{tapCount}, _capacity{tapCount + std::size_t(BlockSize)} {
+    CORRADE_ASSERT(channelCount && inputFrequency && outputFrequency,
+        "Audio::Resampler: expected non-zero channel count and frequencies, got" << channelCount << Debug::nospace << "," << inputFrequency << "and" << outputFrequency, );
+    CORRADE_ASSERT(tapCount && tapCount % 2 == 0,
+        "Audio::Resampler: expected a non-zero even tap count, got" << tapCount, );
+
+    const UnsignedInt divisor = gcd(inputFrequency, outputFrequency);
+    _phaseCount = outputFrequency/divisor;
+    _step = inputFrequency/divisor;
+
+    /* Phase p is used for output samples that are p/L input samples after
+       the center sample, which is at tap T/2 - 1. When downsampling, the
+       cutoff is lowered to the output Nyquist frequency. Each phase is
+       normalized to have an unit gain for DC. */
+    _coefficients = Containers::Array<Float>{Containers::NoInit, std::size_t(_phaseCount)*tapCount};
+    const Double scale = Math::min(1.0, Double(_phaseCount)/_step);
+    const Double pi = Math::Constants<Double>::pi();
+    for(std::size_t phase = 0; phase != _phaseCount; ++phase) {
+        Float* const coefficients = _coefficients + phase*tapCount;
+        Double sum = 0.0;
+        for(std::size_t tap = 0; tap != tapCount; ++tap) {
+            const Double x = Double(tap) - (tapCount/2 - 1) - Double(phase)/_phaseCount;
+            const Double sinc = x == 0.0 ? 1.0 : std::sin(pi*scale*x)/(pi*scale*x);
+            const Double window = 0.42 + 0.5*std::cos(2.0*pi*x/tapCount) + 0.08*std::cos(4.0*pi*x/tapCount);
+            coefficients[tap] = Float(sinc*window);
+            sum += sinc*window;
+        }
+        for(std::size_t tap = 0; tap != tapCount; ++tap)
+            coefficients[tap] = Float(coefficients[tap]/sum);
+    }
+
+    _buffer = Containers::Array<Float>{Containers::NoInit, _capacity*channelCount};
+    reset();
+}
+
+Resampler::Resampler(Resampler&&) noexcept = default;
+
+Resampler::~Resampler() = default;
+
+Resampler& Resampler::operator=(Resampler&&) noexcept = default;
+
+void Resampler::reset() {
+    /* The first output sample is centered at the first input sample, with
+       silence before */
+    std::memset(_buffer, 0, _buffer.size()*sizeof(Float));
+    _filled = _center = _tapCount/2 - 1;
+    _phase = 0;
+    _skip = 0;
+    _flushRemaining = _tapCount/2;
+}
+
+std::pair<std::size_t, std::size_t> Resampler::process(const Containers::StridedArrayView2D<const Float>& src, const Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(src.size()[1] == _channelCount && dst.size()[1] == _channelCount,
+        "Audio::Resampler::process(): expected source and destination with" << _channelCount << "channels but got" << src.size()[1] << "and" << dst.size()[1], {});
+
+    return processInternal(src, src.size()[0], dst);
+}
+
+std::size_t Resampler::flush(const Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(dst.size()[1] == _channelCount,
+        "Audio::Resampler::flush(): expected destination with" << _channelCount << "channels but got" << dst.size()[1], {});
+
+    const std::pair<std::size_t, std::size_t> out = processInternal(nullptr, _flushRemaining, dst);
+    _flushRemaining -= out.first;
+    return out.second;
+}
+
+/* If src is empty, srcCount samples of silence are processed instead */
+std::pair<std::size_t, std::size_t> Resampler::processInternal(const Containers::StridedArrayView2D<const Float>& src, const std::size_t srcCount, const Containers::StridedArrayView2D<Float>& dst) {
+    /* Caching values to avoid inline function calls in debug builds */
+    const std::size_t halfTapCount = _tapCount/2;
+    const std::size_t dstCount = dst.size()[0];
+    std::size_t consumed = 0;
+    std::size_t produced = 0;
+    for(;;) {
+        /* Produce as many output samples as the history allows */
+        while(produced != dstCount && _center + halfTapCount + 1 <= _filled) {
+            const std::size_t start = _center - (halfTapCount - 1);
+            const Float* const coefficients = _coefficients + _phase*_tapCount;
+            for(std::size_t channel = 0; channel != _channelCount; ++channel)
+                dst[produced][channel] = dot(_buffer + channel*_capacity + start, coefficients, _tapCount);
+
+            ++produced;
+            _phase += _step;
+            _center += _phase/_phaseCount;
+            _phase %= _phaseCount;
+        }
+
+        if(produced == dstCount || consumed == srcCount) break;
+
+        /* Discard history that's not needed anymore. When downsampling by a
+           factor larger than the tap count, the next center may be past
+           the end of the history, remember how many input samples to skip
+           in that case. */
+        const std::size_t discard = _center - (halfTapCount - 1);
+        if(discard >= _filled) {
+            _skip += discard - _filled;
+            _filled = 0;
+        } else if(discard) {
+            for(std::size_t channel = 0; channel != _channelCount; ++channel) {
+                Float* const history = _buffer + channel*_capacity;
+                std::memmove(history, history + discard, (_filled - discard)*sizeof(Float));
+            }
+            _filled -= discard;
+        }
+        _center = halfTapCount - 1;
+
+        const std::size_t skipped = Math::min(_skip, srcCount - consumed);
+        _skip -= skipped;
+        consumed += skipped;
+
+        /* Append new input to the planar history */
+        const std::size_t count = Math::min(_capacity - _filled, srcCount - consumed);
+        for(std::size_t channel = 0; channel != _channelCount; ++channel) {
+            Float* const history = _buffer + channel*_capacity + _filled;
+            if(!src.data()) {
+                std::memset(history, 0, count*sizeof(Float));
+                continue;
+            }
+
+            const Containers::StridedArrayView1D<const Float> input = src.transposed<0, 1>()[channel];
+            for(std::size_t i = 0; i != count; ++i)
+                history[i] = input[consumed + i];
+        }
+        _filled += count;
+        consumed += count;
+    }
+
+    return {consumed, produced};
+}
+
+}}
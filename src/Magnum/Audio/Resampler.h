@@ -0,0 +1,170 @@
+#ifndef Magnum_Audio_Resampler_h
+#define Magnum_Audio_Resampler_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Audio::Resampler
+ * @m_since_latest
+ */
+
+#include <utility>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Audio/visibility.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Polyphase sample rate converter
+@m_since_latest
+
+Converts floating-point samples between two arbitrary frequencies. The ratio
+of the two frequencies is reduced to a fraction @f$ \frac{L}{M} @f$ and
+every output sample is calculated as a dot product of @ref tapCount() input
+samples with one of @f$ L @f$ precomputed phases of a Blackman-windowed sinc
+filter, with the cutoff at the lower of the two Nyquist frequencies. The
+phases are stored in a single allocation of @f$ L @f$ times @ref tapCount()
+floats, which for common frequency pairs such as 44.1 kHz and 48 kHz is just
+a few kB. The dot products are done using SIMD instructions where available.
+
+The converter is stateful, so a long stream can be fed to it in arbitrarily
+sized chunks with @ref process(), for example as they're decoded with
+@ref AbstractImporter::read() and converted with @ref pcmToFloatInto():
+
+@snippet MagnumAudio.cpp Resampler
+
+Views passed to it are expected to have samples in the first dimension and
+channels in the second, the second dimension doesn't need to be contiguous.
+Output sample @f$ m @f$ corresponds to input time @f$ \frac{mM}{L} @f$, so
+converting @f$ n @f$ samples produces @f$ \lceil \frac{nL}{M} \rceil @f$
+samples in total, the last few of which are produced only by @ref flush().
+*/
+class MAGNUM_AUDIO_EXPORT Resampler {
+    public:
+        /**
+         * @brief Constructor
+         * @param channelCount      Channel count
+         * @param inputFrequency    Input frequency
+         * @param outputFrequency   Output frequency
+         * @param tapCount          Filter tap count
+         *
+         * Expects that all values are non-zero and @p tapCount is even.
+         * Larger tap counts give a sharper cutoff at the expense of
+         * processing time.
+         */
+        explicit Resampler(UnsignedInt channelCount, UnsignedInt inputFrequency, UnsignedInt outputFrequency, UnsignedInt tapCount = 32);
+
+        /** @brief Copying is not allowed */
+        Resampler(const Resampler&) = delete;
+
+        /** @brief Move constructor */
+        Resampler(Resampler&&) noexcept;
+
+        ~Resampler();
+
+        /** @brief Copying is not allowed */
+        Resampler& operator=(const Resampler&) = delete;
+
+        /** @brief Move assignment */
+        Resampler& operator=(Resampler&&) noexcept;
+
+        /** @brief Channel count */
+        UnsignedInt channelCount() const { return _channelCount; }
+
+        /** @brief Input frequency */
+        UnsignedInt inputFrequency() const { return _inputFrequency; }
+
+        /** @brief Output frequency */
+        UnsignedInt outputFrequency() const { return _outputFrequency; }
+
+        /** @brief Filter tap count */
+        UnsignedInt tapCount() const { return _tapCount; }
+
+        /**
+         * @brief Filter phase count
+         *
+         * The output frequency divided by the greatest common divisor of
+         * the input and output frequency.
+         */
+        UnsignedInt phaseCount() const { return _phaseCount; }
+
+        /**
+         * @brief Process a chunk of samples
+         * @param[in]  src      Input samples
+         * @param[out] dst      Output samples
+         * @return Count of consumed input samples and count of output
+         *      samples written to the beginning of @p dst
+         *
+         * Consumes as much of @p src as possible without overflowing
+         * @p dst. If not all input samples were consumed, call the function
+         * again with the rest and a new output. Expects that both @p src and
+         * @p dst have @ref channelCount() channels.
+         */
+        std::pair<std::size_t, std::size_t> process(const Containers::StridedArrayView2D<const Float>& src, const Containers::StridedArrayView2D<Float>& dst);
+
+        /**
+         * @brief Flush remaining samples
+         * @return Count of output samples written to the beginning of
+         *      @p dst
+         *
+         * Produces the output samples that depend on input samples past the
+         * end of the stream, treating them as silence. Call repeatedly until
+         * it returns less than the size of @p dst. Expects that @p dst has
+         * @ref channelCount() channels. Calling @ref process() after is
+         * allowed but will continue after the silence, call @ref reset()
+         * to start a new stream.
+         */
+        std::size_t flush(const Containers::StridedArrayView2D<Float>& dst);
+
+        /**
+         * @brief Reset the state
+         *
+         * Discards all buffered input, so the next @ref process() call
+         * starts a new stream. Useful for example after
+         * @ref AbstractImporter::seek().
+         */
+        void reset();
+
+    private:
+        MAGNUM_AUDIO_LOCAL std::pair<std::size_t, std::size_t> processInternal(const Containers::StridedArrayView2D<const Float>& src, std::size_t srcCount, const Containers::StridedArrayView2D<Float>& dst);
+
+        UnsignedInt _channelCount, _inputFrequency, _outputFrequency, _tapCount, _phaseCount, _step;
+        /* Phase count times tap count coefficients */
+        Containers::Array<Float> _coefficients;
+        /* Planar input history, each channel has _capacity samples */
+        Containers::Array<Float> _buffer;
+        std::size_t _capacity;
+        /* Count of samples in the history, index of the sample the next
+           output is centered at and its phase, count of input samples that
+           the next output doesn't need anymore and that aren't in the
+           history yet, and count of silence samples for flush() */
+        std::size_t _filled, _center, _phase, _skip, _flushRemaining;
+};
+
+}}
+
+#endif
@@ -0,0 +1,378 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SampleBatch.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/PackingBatch.h"
+#include "Magnum/Audio/Implementation/lawTables.hpp"
+
+#if defined(CORRADE_TARGET_SSE2)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace Audio {
+
+namespace {
+
+/* Conversions that need an extra step before or after the Math batch
+   functions go through a temporary of this size on stack, so they can reuse
+   the SIMD paths there without allocating */
+enum: std::size_t { BlockSize = 1024 };
+
+template<class T> inline Containers::StridedArrayView2D<T> spanView(T* data, const std::size_t count) {
+    return Containers::StridedArrayView2D<T>{Containers::arrayView(data, count), {count, 1}};
+}
+
+void pcm8ToFloatSpan(const UnsignedByte* src, Float* dst, const std::size_t count) {
+    Byte signed8[BlockSize];
+    for(std::size_t i = 0; i < count; i += BlockSize) {
+        const std::size_t blockSize = Math::min(std::size_t(BlockSize), count - i);
+        for(std::size_t j = 0; j != blockSize; ++j)
+            signed8[j] = Byte(src[i + j] ^ 0x80);
+        Math::unpackInto(spanView<const Byte>(signed8, blockSize), spanView(dst + i, blockSize));
+    }
+}
+
+/* The clamping loop is written so the compiler can turn it into min/max
+   instructions */
+inline void clampBlock(const Float* src, Float* dst, const std::size_t count) {
+    for(std::size_t j = 0; j != count; ++j) {
+        const Float value = src[j] < -1.0f ? -1.0f : src[j];
+        dst[j] = value > 1.0f ? 1.0f : value;
+    }
+}
+
+void floatToPcm8Span(const Float* src, UnsignedByte* dst, const std::size_t count) {
+    Float clamped[BlockSize];
+    Byte signed8[BlockSize];
+    for(std::size_t i = 0; i < count; i += BlockSize) {
+        const std::size_t blockSize = Math::min(std::size_t(BlockSize), count - i);
+        clampBlock(src + i, clamped, blockSize);
+        Math::packInto(spanView<const Float>(clamped, blockSize), spanView(signed8, blockSize));
+        for(std::size_t j = 0; j != blockSize; ++j)
+            dst[i + j] = UnsignedByte(signed8[j]) ^ 0x80;
+    }
+}
+
+void floatToPcm16Span(const Float* src, Short* dst, const std::size_t count) {
+    Float clamped[BlockSize];
+    for(std::size_t i = 0; i < count; i += BlockSize) {
+        const std::size_t blockSize = Math::min(std::size_t(BlockSize), count - i);
+        clampBlock(src + i, clamped, blockSize);
+        Math::packInto(spanView<const Float>(clamped, blockSize), spanView(dst + i, blockSize));
+    }
+}
+
+template<const Short(&table)[256]> void decodeLawSpan(const UnsignedByte* src, Short* dst, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i)
+        dst[i] = table[src[i]];
+}
+
+template<const Short(&table)[256]> void decodeLawFloatSpan(const UnsignedByte* src, Float* dst, const std::size_t count) {
+    Short decoded[BlockSize];
+    for(std::size_t i = 0; i < count; i += BlockSize) {
+        const std::size_t blockSize = Math::min(std::size_t(BlockSize), count - i);
+        decodeLawSpan<table>(src + i, decoded, blockSize);
+        Math::unpackInto(spanView<const Short>(decoded, blockSize), spanView(dst + i, blockSize));
+    }
+}
+
+/* Same as in Math/PackingBatch.cpp, views contiguous in both dimensions are
+   processed in a single kernel call, otherwise the kernel is called for each
+   row separately */
+template<class T, class U> void processRows(const Containers::StridedArrayView2D<const T>& src, const Containers::StridedArrayView2D<U>& dst, void(*kernel)(const T*, U*, std::size_t)) {
+    if(src.isContiguous() && dst.isContiguous()) {
+        kernel(static_cast<const T*>(src.data()), static_cast<U*>(dst.data()), src.size()[0]*src.size()[1]);
+        return;
+    }
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const char* srcPtr = reinterpret_cast<const char*>(src.data());
+    char* dstPtr = reinterpret_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride()[0];
+    const std::ptrdiff_t dstStride = dst.stride()[0];
+    const std::size_t maxJ = src.size()[1];
+    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
+        kernel(reinterpret_cast<const T*>(srcPtr), reinterpret_cast<U*>(dstPtr), maxJ);
+
+        srcPtr += srcStride;
+        dstPtr += dstStride;
+    }
+}
+
+}
+
+void pcmToFloatInto(const Containers::StridedArrayView2D<const UnsignedByte>& src, const Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Audio::pcmToFloatInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
+        "Audio::pcmToFloatInto(): second view dimension is not contiguous", );
+
+    processRows(src, dst, pcm8ToFloatSpan);
+}
+
+void pcmToFloatInto(const Containers::StridedArrayView2D<const Short>& src, const Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Audio::pcmToFloatInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
+        "Audio::pcmToFloatInto(): second view dimension is not contiguous", );
+
+    Math::unpackInto(src, dst);
+}
+
+void floatToPcmInto(const Containers::StridedArrayView2D<const Float>& src, const Containers::StridedArrayView2D<UnsignedByte>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Audio::floatToPcmInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
+        "Audio::floatToPcmInto(): second view dimension is not contiguous", );
+
+    processRows(src, dst, floatToPcm8Span);
+}
+
+void floatToPcmInto(const Containers::StridedArrayView2D<const Float>& src, const Containers::StridedArrayView2D<Short>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Audio::floatToPcmInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
+        "Audio::floatToPcmInto(): second view dimension is not contiguous", );
+
+    processRows(src, dst, floatToPcm16Span);
+}
+
+void decodeALawInto(const Containers::StridedArrayView2D<const UnsignedByte>& src, const Containers::StridedArrayView2D<Short>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Audio::decodeALawInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
+        "Audio::decodeALawInto(): second view dimension is not contiguous", );
+
+    processRows(src, dst, decodeLawSpan<ALawTable>);
+}
+
+void decodeALawInto(const Containers::StridedArrayView2D<const UnsignedByte>& src, const Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Audio::decodeALawInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
+        "Audio::decodeALawInto(): second view dimension is not contiguous", );
+
+    processRows(src, dst, decodeLawFloatSpan<ALawTable>);
+}
+
+void decodeMuLawInto(const Containers::StridedArrayView2D<const UnsignedByte>& src, const Containers::StridedArrayView2D<Short>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Audio::decodeMuLawInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
+        "Audio::decodeMuLawInto(): second view dimension is not contiguous", );
+
+    processRows(src, dst, decodeLawSpan<MuLawTable>);
+}
+
+void decodeMuLawInto(const Containers::StridedArrayView2D<const UnsignedByte>& src, const Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Audio::decodeMuLawInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
+        "Audio::decodeMuLawInto(): second view dimension is not contiguous", );
+
+    processRows(src, dst, decodeLawFloatSpan<MuLawTable>);
+}
+
+namespace {
+
+/* Two-channel (de)interleaving kernels, each advancing i by as many samples
+   as they can process with SIMD and leaving the rest for the scalar code.
+   All of them are just shuffles, so bit-exact. */
+#if defined(CORRADE_TARGET_SSE2)
+inline void interleave2Simd(const Float* a, const Float* b, Float* dst, std::size_t& i, const std::size_t count) {
+    for(; i + 4 <= count; i += 4) {
+        const __m128 va = _mm_loadu_ps(a + i);
+        const __m128 vb = _mm_loadu_ps(b + i);
+        _mm_storeu_ps(dst + 2*i, _mm_unpacklo_ps(va, vb));
+        _mm_storeu_ps(dst + 2*i + 4, _mm_unpackhi_ps(va, vb));
+    }
+}
+inline void interleave2Simd(const Short* a, const Short* b, Short* dst, std::size_t& i, const std::size_t count) {
+    for(; i + 8 <= count; i += 8) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2*i), _mm_unpacklo_epi16(va, vb));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2*i + 8), _mm_unpackhi_epi16(va, vb));
+    }
+}
+inline void interleave2Simd(const UnsignedByte* a, const UnsignedByte* b, UnsignedByte* dst, std::size_t& i, const std::size_t count) {
+    for(; i + 16 <= count; i += 16) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2*i), _mm_unpacklo_epi8(va, vb));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2*i + 16), _mm_unpackhi_epi8(va, vb));
+    }
+}
+
+inline void deinterleave2Simd(const Float* src, Float* a, Float* b, std::size_t& i, const std::size_t count) {
+    for(; i + 4 <= count; i += 4) {
+        const __m128 lo = _mm_loadu_ps(src + 2*i);
+        const __m128 hi = _mm_loadu_ps(src + 2*i + 4);
+        _mm_storeu_ps(a + i, _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(b + i, _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+}
+inline void deinterleave2Simd(const Short* src, Short* a, Short* b, std::size_t& i, const std::size_t count) {
+    for(; i + 8 <= count; i += 8) {
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2*i));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2*i + 8));
+        /* Sign-extending each half of the 32-bit lanes so the saturating
+           pack doesn't saturate */
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(a + i), _mm_packs_epi32(
+            _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16),
+            _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(b + i), _mm_packs_epi32(
+            _mm_srai_epi32(lo, 16),
+            _mm_srai_epi32(hi, 16)));
+    }
+}
+inline void deinterleave2Simd(const UnsignedByte* src, UnsignedByte* a, UnsignedByte* b, std::size_t& i, const std::size_t count) {
+    const __m128i mask = _mm_set1_epi16(0x00ff);
+    for(; i + 16 <= count; i += 16) {
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2*i));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2*i + 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(a + i), _mm_packus_epi16(
+            _mm_and_si128(lo, mask), _mm_and_si128(hi, mask)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(b + i), _mm_packus_epi16(
+            _mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)));
+    }
+}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+inline void interleave2Simd(const Float* a, const Float* b, Float* dst, std::size_t& i, const std::size_t count) {
+    for(; i + 4 <= count; i += 4)
+        vst2q_f32(dst + 2*i, float32x4x2_t{{vld1q_f32(a + i), vld1q_f32(b + i)}});
+}
+inline void interleave2Simd(const Short* a, const Short* b, Short* dst, std::size_t& i, const std::size_t count) {
+    for(; i + 8 <= count; i += 8)
+        vst2q_s16(dst + 2*i, int16x8x2_t{{vld1q_s16(a + i), vld1q_s16(b + i)}});
+}
+inline void interleave2Simd(const UnsignedByte* a, const UnsignedByte* b, UnsignedByte* dst, std::size_t& i, const std::size_t count) {
+    for(; i + 16 <= count; i += 16)
+        vst2q_u8(dst + 2*i, uint8x16x2_t{{vld1q_u8(a + i), vld1q_u8(b + i)}});
+}
+
+inline void deinterleave2Simd(const Float* src, Float* a, Float* b, std::size_t& i, const std::size_t count) {
+    for(; i + 4 <= count; i += 4) {
+        const float32x4x2_t value = vld2q_f32(src + 2*i);
+        vst1q_f32(a + i, value.val[0]);
+        vst1q_f32(b + i, value.val[1]);
+    }
+}
+inline void deinterleave2Simd(const Short* src, Short* a, Short* b, std::size_t& i, const std::size_t count) {
+    for(; i + 8 <= count; i += 8) {
+        const int16x8x2_t value = vld2q_s16(src + 2*i);
+        vst1q_s16(a + i, value.val[0]);
+        vst1q_s16(b + i, value.val[1]);
+    }
+}
+inline void deinterleave2Simd(const UnsignedByte* src, UnsignedByte* a, UnsignedByte* b, std::size_t& i, const std::size_t count) {
+    for(; i + 16 <= count; i += 16) {
+        const uint8x16x2_t value = vld2q_u8(src + 2*i);
+        vst1q_u8(a + i, value.val[0]);
+        vst1q_u8(b + i, value.val[1]);
+    }
+}
+#else
+template<class T> inline void interleave2Simd(const T*, const T*, T*, std::size_t&, std::size_t) {}
+template<class T> inline void deinterleave2Simd(const T*, T*, T*, std::size_t&, std::size_t) {}
+#endif
+
+template<class T> void interleaveIntoImplementation(const Containers::StridedArrayView2D<const T>& src, const Containers::StridedArrayView2D<T>& dst) {
+    CORRADE_ASSERT(src.size()[0] == dst.size()[1] && src.size()[1] == dst.size()[0],
+        "Audio::interleaveInto(): wrong destination size, got" << dst.size() << "but expected" << src.template transposed<0, 1>().size(), );
+
+    if(src.size()[0] == 2 && src.template isContiguous<1>() && dst.isContiguous()) {
+        const T* a = static_cast<const T*>(src[0].data());
+        const T* b = static_cast<const T*>(src[1].data());
+        T* out = static_cast<T*>(dst.data());
+        const std::size_t count = src.size()[1];
+        std::size_t i = 0;
+        interleave2Simd(a, b, out, i, count);
+        for(; i != count; ++i) {
+            out[2*i + 0] = a[i];
+            out[2*i + 1] = b[i];
+        }
+        return;
+    }
+
+    Utility::copy(src.template transposed<0, 1>(), dst);
+}
+
+template<class T> void deinterleaveIntoImplementation(const Containers::StridedArrayView2D<const T>& src, const Containers::StridedArrayView2D<T>& dst) {
+    CORRADE_ASSERT(src.size()[0] == dst.size()[1] && src.size()[1] == dst.size()[0],
+        "Audio::deinterleaveInto(): wrong destination size, got" << dst.size() << "but expected" << src.template transposed<0, 1>().size(), );
+
+    if(src.size()[1] == 2 && src.isContiguous() && dst.template isContiguous<1>()) {
+        const T* in = static_cast<const T*>(src.data());
+        T* a = static_cast<T*>(dst[0].data());
+        T* b = static_cast<T*>(dst[1].data());
+        const std::size_t count = src.size()[0];
+        std::size_t i = 0;
+        deinterleave2Simd(in, a, b, i, count);
+        for(; i != count; ++i) {
+            a[i] = in[2*i + 0];
+            b[i] = in[2*i + 1];
+        }
+        return;
+    }
+
+    Utility::copy(src.template transposed<0, 1>(), dst);
+}
+
+}
+
+void interleaveInto(const Containers::StridedArrayView2D<const UnsignedByte>& src, const Containers::StridedArrayView2D<UnsignedByte>& dst) {
+    interleaveIntoImplementation(src, dst);
+}
+
+void interleaveInto(const Containers::StridedArrayView2D<const Short>& src, const Containers::StridedArrayView2D<Short>& dst) {
+    interleaveIntoImplementation(src, dst);
+}
+
+void interleaveInto(const Containers::StridedArrayView2D<const Float>& src, const Containers::StridedArrayView2D<Float>& dst) {
+    interleaveIntoImplementation(src, dst);
+}
+
+void deinterleaveInto(const Containers::StridedArrayView2D<const UnsignedByte>& src, const Containers::StridedArrayView2D<UnsignedByte>& dst) {
+    deinterleaveIntoImplementation(src, dst);
+}
+
+void deinterleaveInto(const Containers::StridedArrayView2D<const Short>& src, const Containers::StridedArrayView2D<Short>& dst) {
+    deinterleaveIntoImplementation(src, dst);
+}
+
+void deinterleaveInto(const Containers::StridedArrayView2D<const Float>& src, const Containers::StridedArrayView2D<Float>& dst) {
+    deinterleaveIntoImplementation(src, dst);
+}
+
+}}
@@ -0,0 +1,228 @@
+#ifndef Magnum_Audio_SampleBatch_h
+#define Magnum_Audio_SampleBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Functions @ref Magnum::Audio::pcmToFloatInto(), @ref Magnum::Audio::floatToPcmInto(), @ref Magnum::Audio::decodeALawInto(), @ref Magnum::Audio::decodeMuLawInto(), @ref Magnum::Audio::interleaveInto(), @ref Magnum::Audio::deinterleaveInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Audio/visibility.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@{ @name Batch sample conversion functions
+
+These functions process an unbounded range of samples. The views are expected
+to have samples in the first dimension and channels in the second, i.e. the
+interleaved layout used by @ref Buffer::setData(), unless said otherwise. The
+conversions between integers and floats go through @ref Math::unpackInto()
+and @ref Math::packInto() and use the same SIMD code paths.
+*/
+
+/**
+@brief Convert 8-bit unsigned PCM to floating-point samples
+@param[in]  src     Source samples
+@param[out] dst     Destination samples
+@m_since_latest
+
+Converts samples in the format used by @ref BufferFormat::Mono8 and
+@ref BufferFormat::Stereo8, with silence at @cpp 128 @ce, to floating-point
+values in range @f$ [-1, 1] @f$. Equivalent to calling @ref Math::unpack() on
+the value with its highest bit flipped and interpreted as signed. Expects that
+@p src and @p dst have the same size and that the second dimension in both is
+contiguous.
+@see @ref floatToPcmInto(),
+    @ref Corrade::Containers::StridedArrayView::isContiguous()
+*/
+MAGNUM_AUDIO_EXPORT void pcmToFloatInto(const Containers::StridedArrayView2D<const UnsignedByte>& src, const Containers::StridedArrayView2D<Float>& dst);
+
+/**
+@brief Convert 16-bit signed PCM to floating-point samples
+@param[in]  src     Source samples
+@param[out] dst     Destination samples
+@m_since_latest
+
+Converts samples in the format used by @ref BufferFormat::Mono16 and
+@ref BufferFormat::Stereo16 to floating-point values in range @f$ [-1, 1] @f$,
+equivalent to @ref Math::unpackInto(). Expects that @p src and @p dst have
+the same size and that the second dimension in both is contiguous.
+@see @ref floatToPcmInto(),
+    @ref Corrade::Containers::StridedArrayView::isContiguous()
+*/
+MAGNUM_AUDIO_EXPORT void pcmToFloatInto(const Containers::StridedArrayView2D<const Short>& src, const Containers::StridedArrayView2D<Float>& dst);
+
+/**
+@brief Convert floating-point samples to 8-bit unsigned PCM
+@param[in]  src     Source samples
+@param[out] dst     Destination samples
+@m_since_latest
+
+Inverse of @ref pcmToFloatInto(const Containers::StridedArrayView2D<const UnsignedByte>&, const Containers::StridedArrayView2D<Float>&).
+Unlike @ref Math::packInto(), values outside of the @f$ [-1, 1] @f$ range are
+clipped. Expects that @p src and @p dst have the same size and that the second
+dimension in both is contiguous.
+@see @ref Corrade::Containers::StridedArrayView::isContiguous()
+*/
+MAGNUM_AUDIO_EXPORT void floatToPcmInto(const Containers::StridedArrayView2D<const Float>& src, const Containers::StridedArrayView2D<UnsignedByte>& dst);
+
+/**
+@brief Convert floating-point samples to 16-bit signed PCM
+@param[in]  src     Source samples
+@param[out] dst     Destination samples
+@m_since_latest
+
+Inverse of @ref pcmToFloatInto(const Containers::StridedArrayView2D<const Short>&, const Containers::StridedArrayView2D<Float>&).
+Unlike @ref Math::packInto(), values outside of the @f$ [-1, 1] @f$ range are
+clipped. Expects that @p src and @p dst have the same size and that the second
+dimension in both is contiguous.
+@see @ref Corrade::Containers::StridedArrayView::isContiguous()
+*/
+MAGNUM_AUDIO_EXPORT void floatToPcmInto(const Containers::StridedArrayView2D<const Float>& src, const Containers::StridedArrayView2D<Short>& dst);
+
+/**
+@brief Decode A-law samples to 16-bit signed PCM
+@param[in]  src     Source samples
+@param[out] dst     Destination samples
+@m_since_latest
+
+Decodes samples in the format used by @ref BufferFormat::MonoALaw and
+@ref BufferFormat::StereoALaw according to ITU-T G.711 using a lookup table.
+Expects that @p src and @p dst have the same size and that the second
+dimension in both is contiguous.
+@see @ref decodeMuLawInto(),
+    @ref Corrade::Containers::StridedArrayView::isContiguous()
+*/
+MAGNUM_AUDIO_EXPORT void decodeALawInto(const Containers::StridedArrayView2D<const UnsignedByte>& src, const Containers::StridedArrayView2D<Short>& dst);
+
+/**
+@brief Decode A-law samples to floating-point samples
+@param[in]  src     Source samples
+@param[out] dst     Destination samples
+@m_since_latest
+
+Same as @ref decodeALawInto(const Containers::StridedArrayView2D<const UnsignedByte>&, const Containers::StridedArrayView2D<Short>&)
+followed by @ref pcmToFloatInto(const Containers::StridedArrayView2D<const Short>&, const Containers::StridedArrayView2D<Float>&),
+but without a temporary allocation.
+*/
+MAGNUM_AUDIO_EXPORT void decodeALawInto(const Containers::StridedArrayView2D<const UnsignedByte>& src, const Containers::StridedArrayView2D<Float>& dst);
+
+/**
+@brief Decode μ-law samples to 16-bit signed PCM
+@param[in]  src     Source samples
+@param[out] dst     Destination samples
+@m_since_latest
+
+Decodes samples in the format used by @ref BufferFormat::MonoMuLaw and
+@ref BufferFormat::StereoMuLaw according to ITU-T G.711 using a lookup table.
+Expects that @p src and @p dst have the same size and that the second
+dimension in both is contiguous.
+@see @ref decodeALawInto(),
+    @ref Corrade::Containers::StridedArrayView::isContiguous()
+*/
+MAGNUM_AUDIO_EXPORT void decodeMuLawInto(const Containers::StridedArrayView2D<const UnsignedByte>& src, const Containers::StridedArrayView2D<Short>& dst);
+
+/**
+@brief Decode μ-law samples to floating-point samples
+@param[in]  src     Source samples
+@param[out] dst     Destination samples
+@m_since_latest
+
+Same as @ref decodeMuLawInto(const Containers::StridedArrayView2D<const UnsignedByte>&, const Containers::StridedArrayView2D<Short>&)
+followed by @ref pcmToFloatInto(const Containers::StridedArrayView2D<const Short>&, const Containers::StridedArrayView2D<Float>&),
+but without a temporary allocation.
+*/
+MAGNUM_AUDIO_EXPORT void decodeMuLawInto(const Containers::StridedArrayView2D<const UnsignedByte>& src, const Containers::StridedArrayView2D<Float>& dst);
+
+/**
+@brief Interleave channels
+@param[in]  src     Source samples, channels in the first dimension and
+    samples in the second
+@param[out] dst     Destination samples, samples in the first dimension and
+    channels in the second
+@m_since_latest
+
+Expects that @p src and @p dst have the dimensions swapped. Two-channel views
+with contiguous channels in @p src and a contiguous @p dst are processed
+using SIMD instructions, everything else goes through a generic path.
+@see @ref deinterleaveInto(),
+    @ref Corrade::Containers::StridedArrayView::isContiguous()
+*/
+MAGNUM_AUDIO_EXPORT void interleaveInto(const Containers::StridedArrayView2D<const UnsignedByte>& src, const Containers::StridedArrayView2D<UnsignedByte>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_AUDIO_EXPORT void interleaveInto(const Containers::StridedArrayView2D<const Short>& src, const Containers::StridedArrayView2D<Short>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_AUDIO_EXPORT void interleaveInto(const Containers::StridedArrayView2D<const Float>& src, const Containers::StridedArrayView2D<Float>& dst);
+
+/**
+@brief Deinterleave channels
+@param[in]  src     Source samples, samples in the first dimension and
+    channels in the second
+@param[out] dst     Destination samples, channels in the first dimension and
+    samples in the second
+@m_since_latest
+
+Inverse of @ref interleaveInto(). Expects that @p src and @p dst have the
+dimensions swapped. Two-channel views with a contiguous @p src and contiguous
+channels in @p dst are processed using SIMD instructions, everything else goes
+through a generic path.
+@see @ref Corrade::Containers::StridedArrayView::isContiguous()
+*/
+MAGNUM_AUDIO_EXPORT void deinterleaveInto(const Containers::StridedArrayView2D<const UnsignedByte>& src, const Containers::StridedArrayView2D<UnsignedByte>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_AUDIO_EXPORT void deinterleaveInto(const Containers::StridedArrayView2D<const Short>& src, const Containers::StridedArrayView2D<Short>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_AUDIO_EXPORT void deinterleaveInto(const Containers::StridedArrayView2D<const Float>& src, const Containers::StridedArrayView2D<Float>& dst);
+
+/* Since 1.8.17, the original short-hand group closing doesn't work anymore.
+   FFS. */
+/**
+ * @}
+ */
+
+}}
+
+#endif
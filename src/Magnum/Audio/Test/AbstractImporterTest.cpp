@@ -25,6 +25,7 @@
 
 #include <sstream>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -32,6 +33,7 @@
 
 #include "Magnum/Audio/AbstractImporter.h"
 #include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Math/Functions.h"
 
 #include "configure.h"
 
@@ -50,8 +52,12 @@ struct AbstractImporterTest: TestSuite::Tester {
     void openDataNotSupported();
     void openDataNotImplemented();
 
-    /* file callbacks not supported -- those will be once this gets merged with
-       Trade::AbstractImporter */
+    void setFileCallback();
+    void setFileCallbackFileOpened();
+    void setFileCallbackNotSupported();
+    void openFileDirectlyWithCallback();
+    void openFileAsDataFromCallback();
+    void openFileAsDataFromCallbackNotFound();
 
     void format();
     void formatNoFile();
@@ -63,6 +69,13 @@ struct AbstractImporterTest: TestSuite::Tester {
     void dataNoFile();
     void dataCustomDeleter();
 
+    void streaming();
+    void streamingNotSupported();
+    void streamingNotImplemented();
+    void streamingNoFile();
+    void seekOutOfBounds();
+    void readTooSmall();
+
     void debugFeature();
     void debugFeatures();
 };
@@ -78,6 +91,13 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::openDataNotSupported,
               &AbstractImporterTest::openDataNotImplemented,
 
+              &AbstractImporterTest::setFileCallback,
+              &AbstractImporterTest::setFileCallbackFileOpened,
+              &AbstractImporterTest::setFileCallbackNotSupported,
+              &AbstractImporterTest::openFileDirectlyWithCallback,
+              &AbstractImporterTest::openFileAsDataFromCallback,
+              &AbstractImporterTest::openFileAsDataFromCallbackNotFound,
+
               &AbstractImporterTest::format,
               &AbstractImporterTest::formatNoFile,
 
@@ -88,6 +108,13 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::dataNoFile,
               &AbstractImporterTest::dataCustomDeleter,
 
+              &AbstractImporterTest::streaming,
+              &AbstractImporterTest::streamingNotSupported,
+              &AbstractImporterTest::streamingNotImplemented,
+              &AbstractImporterTest::streamingNoFile,
+              &AbstractImporterTest::seekOutOfBounds,
+              &AbstractImporterTest::readTooSmall,
+
               &AbstractImporterTest::debugFeature,
               &AbstractImporterTest::debugFeatures});
 }
@@ -253,6 +280,186 @@ void AbstractImporterTest::openDataNotImplemented() {
     CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::openData(): feature advertised but not implemented\n");
 }
 
+void AbstractImporterTest::setFileCallback() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        void doSetFileCallback(Containers::Optional<Containers::ArrayView<const char>>(*)(const std::string&, InputFileCallbackPolicy, void*), void* userData) override {
+            *static_cast<int*>(userData) = 1337;
+        }
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    int a = 0;
+    auto lambda = [](const std::string&, InputFileCallbackPolicy, void*) {
+        return Containers::Optional<Containers::ArrayView<const char>>{};
+    };
+    importer.setFileCallback(lambda, &a);
+    CORRADE_COMPARE(importer.fileCallback(), lambda);
+    CORRADE_COMPARE(importer.fileCallbackUserData(), &a);
+    CORRADE_COMPARE(a, 1337);
+}
+
+void AbstractImporterTest::setFileCallbackFileOpened() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.setFileCallback([](const std::string&, InputFileCallbackPolicy, void*) {
+        return Containers::Optional<Containers::ArrayView<const char>>{};
+    });
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::setFileCallback(): can't be set while a file is opened\n");
+}
+
+void AbstractImporterTest::setFileCallbackNotSupported() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.setFileCallback([](const std::string&, InputFileCallbackPolicy, void*) {
+        return Containers::Optional<Containers::ArrayView<const char>>{};
+    });
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::setFileCallback(): importer supports neither loading from data nor via callbacks, callbacks can't be used\n");
+}
+
+void AbstractImporterTest::openFileDirectlyWithCallback() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData|ImporterFeature::FileCallback; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        /* The importer handles the callback itself, so doOpenData()
+           shouldn't get called */
+        void doOpenFile(const std::string& filename) override {
+            Containers::Optional<Containers::ArrayView<const char>> data = fileCallback()(filename, InputFileCallbackPolicy::LoadPermanent, fileCallbackUserData());
+            _opened = data && data->size() == 1 && (*data)[0] == '\xa5';
+        }
+
+        void doOpenData(Containers::ArrayView<const char>) override {
+            _opened = false;
+        }
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        bool _opened = false;
+    } importer;
+
+    struct State {
+        const char data = '\xa5';
+        InputFileCallbackPolicy policy{};
+    } state;
+
+    importer.setFileCallback([](const std::string& filename, InputFileCallbackPolicy policy, void* userData) {
+        State& state = *static_cast<State*>(userData);
+        state.policy = policy;
+        if(filename == "file.dat")
+            return Containers::Optional<Containers::ArrayView<const char>>{Containers::arrayView(&state.data, 1)};
+        return Containers::Optional<Containers::ArrayView<const char>>{};
+    }, &state);
+    CORRADE_VERIFY(importer.openFile("file.dat"));
+    CORRADE_COMPARE(state.policy, InputFileCallbackPolicy::LoadPermanent);
+}
+
+void AbstractImporterTest::openFileAsDataFromCallback() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        void doOpenData(Containers::ArrayView<const char> data) override {
+            _opened = (data.size() == 1 && data[0] == '\xa5');
+        }
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        bool _opened = false;
+    } importer;
+
+    struct State {
+        const char data = '\xa5';
+        InputFileCallbackPolicy policy{};
+        std::size_t calls{};
+    } state;
+
+    importer.setFileCallback([](const std::string& filename, InputFileCallbackPolicy policy, void* userData) {
+        State& state = *static_cast<State*>(userData);
+        state.policy = policy;
+        ++state.calls;
+        if(filename == "file.dat" && policy == InputFileCallbackPolicy::LoadTemporary)
+            return Containers::Optional<Containers::ArrayView<const char>>{Containers::arrayView(&state.data, 1)};
+        return Containers::Optional<Containers::ArrayView<const char>>{};
+    }, &state);
+
+    /* The data are loaded temporarily and the callback is called again to
+       close the file once openData() is done */
+    CORRADE_VERIFY(importer.openFile("file.dat"));
+    CORRADE_COMPARE(state.calls, 2);
+    CORRADE_COMPARE(state.policy, InputFileCallbackPolicy::Close);
+}
+
+void AbstractImporterTest::openFileAsDataFromCallbackNotFound() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        void doOpenData(Containers::ArrayView<const char>) override {
+            _opened = true;
+        }
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        bool _opened = false;
+    } importer;
+
+    importer.setFileCallback([](const std::string&, InputFileCallbackPolicy, void*) {
+        return Containers::Optional<Containers::ArrayView<const char>>{};
+    });
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    CORRADE_VERIFY(!importer.openFile("file.dat"));
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::openFile(): cannot open file file.dat\n");
+}
+
 void AbstractImporterTest::format() {
     struct: AbstractImporter {
         ImporterFeatures doFeatures() const override { return {}; }
@@ -389,6 +596,176 @@ void AbstractImporterTest::dataCustomDeleter() {
     CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::data(): implementation is not allowed to use a custom Array deleter\n");
 }
 
+struct StreamingImporter: AbstractImporter {
+    ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    BufferFormat doFormat() const override { return BufferFormat::Stereo8; }
+    UnsignedInt doFrequency() const override { return {}; }
+    Containers::Array<char> doData() override { return nullptr; }
+
+    std::size_t doSampleCount() const override { return 3; }
+    std::size_t doSampleOffset() const override { return offset; }
+    void doSeek(std::size_t offset) override { this->offset = offset; }
+    std::size_t doRead(Containers::ArrayView<char> data) override {
+        const std::size_t count = Math::min(data.size()/2, 3 - offset);
+        for(std::size_t i = 0; i != count*2; ++i)
+            data[i] = char(offset*2 + i);
+        offset += count;
+        return count;
+    }
+
+    std::size_t offset = 0;
+};
+
+void AbstractImporterTest::streaming() {
+    StreamingImporter importer;
+    CORRADE_COMPARE(importer.sampleCount(), 3);
+    CORRADE_COMPARE(importer.sampleOffset(), 0);
+
+    char data[5]{};
+    CORRADE_COMPARE(importer.read(data), 2);
+    CORRADE_COMPARE(importer.sampleOffset(), 2);
+    CORRADE_COMPARE_AS(Containers::arrayView(data).prefix(4),
+        Containers::arrayView<char>({0, 1, 2, 3}),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(importer.read(data), 1);
+    CORRADE_COMPARE(importer.sampleOffset(), 3);
+    CORRADE_COMPARE(importer.read(data), 0);
+
+    importer.seek(1);
+    CORRADE_COMPARE(importer.sampleOffset(), 1);
+    CORRADE_COMPARE(importer.read(data), 2);
+    CORRADE_COMPARE_AS(Containers::arrayView(data).prefix(4),
+        Containers::arrayView<char>({2, 3, 4, 5}),
+        TestSuite::Compare::Container);
+
+    /* Seeking to the end is allowed */
+    importer.seek(3);
+    CORRADE_COMPARE(importer.read(data), 0);
+}
+
+void AbstractImporterTest::streamingNotSupported() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[1];
+    importer.sampleCount();
+    importer.sampleOffset();
+    importer.seek(0);
+    importer.read(data);
+    CORRADE_COMPARE(out.str(),
+        "Audio::AbstractImporter::sampleCount(): feature not supported\n"
+        "Audio::AbstractImporter::sampleOffset(): feature not supported\n"
+        "Audio::AbstractImporter::seek(): feature not supported\n"
+        "Audio::AbstractImporter::read(): feature not supported\n");
+}
+
+void AbstractImporterTest::streamingNotImplemented() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Mono8; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[1];
+    importer.sampleCount();
+    importer.sampleOffset();
+    importer.read(data);
+    CORRADE_COMPARE(out.str(),
+        "Audio::AbstractImporter::sampleCount(): feature advertised but not implemented\n"
+        "Audio::AbstractImporter::sampleOffset(): feature advertised but not implemented\n"
+        "Audio::AbstractImporter::read(): feature advertised but not implemented\n");
+}
+
+void AbstractImporterTest::streamingNoFile() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[1];
+    importer.sampleCount();
+    importer.sampleOffset();
+    importer.seek(0);
+    importer.read(data);
+    CORRADE_COMPARE(out.str(),
+        "Audio::AbstractImporter::sampleCount(): no file opened\n"
+        "Audio::AbstractImporter::sampleOffset(): no file opened\n"
+        "Audio::AbstractImporter::seek(): no file opened\n"
+        "Audio::AbstractImporter::read(): no file opened\n");
+}
+
+void AbstractImporterTest::seekOutOfBounds() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    StreamingImporter importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.seek(4);
+    CORRADE_COMPARE(importer.sampleOffset(), 0);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::seek(): offset 4 out of bounds for 3 samples\n");
+}
+
+void AbstractImporterTest::readTooSmall() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    StreamingImporter importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[1];
+    importer.read(data);
+    CORRADE_COMPARE(importer.sampleOffset(), 0);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::read(): expected space for at least one sample of 2 bytes but got 1\n");
+}
+
 void AbstractImporterTest::debugFeature() {
     std::ostringstream out;
 
@@ -34,11 +34,25 @@ namespace Magnum { namespace Audio { namespace Test { namespace {
 struct BufferFormatTest: TestSuite::Tester {
     explicit BufferFormatTest();
 
+    void sampleSize();
+
     void debugFormat();
 };
 
 BufferFormatTest::BufferFormatTest() {
-    addTests({&BufferFormatTest::debugFormat});
+    addTests({&BufferFormatTest::sampleSize,
+
+              &BufferFormatTest::debugFormat});
+}
+
+void BufferFormatTest::sampleSize() {
+    CORRADE_COMPARE(Audio::sampleSize(BufferFormat::Mono8), 1);
+    CORRADE_COMPARE(Audio::sampleSize(BufferFormat::Stereo16), 4);
+    CORRADE_COMPARE(Audio::sampleSize(BufferFormat::StereoMuLaw), 2);
+    CORRADE_COMPARE(Audio::sampleSize(BufferFormat::MonoDouble), 8);
+    CORRADE_COMPARE(Audio::sampleSize(BufferFormat::Rear16), 4);
+    CORRADE_COMPARE(Audio::sampleSize(BufferFormat::Surround61Channel8), 7);
+    CORRADE_COMPARE(Audio::sampleSize(BufferFormat::Surround71Channel32), 32);
 }
 
 void BufferFormatTest::debugFormat() {
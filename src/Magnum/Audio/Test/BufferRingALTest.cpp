@@ -0,0 +1,145 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Audio/BufferRing.h"
+#include "Magnum/Audio/Context.h"
+#include "Magnum/Audio/Source.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct BufferRingALTest: TestSuite::Tester {
+    explicit BufferRingALTest();
+
+    void construct();
+
+    void update();
+    void updateLooping();
+    void updateLoopingEmpty();
+
+    Context _context;
+};
+
+BufferRingALTest::BufferRingALTest():
+    TestSuite::Tester{TestSuite::Tester::TesterConfiguration{}.setSkippedArgumentPrefixes({"magnum"})},
+    _context{arguments().first, arguments().second}
+{
+    addTests({&BufferRingALTest::construct,
+
+              &BufferRingALTest::update,
+              &BufferRingALTest::updateLooping,
+              &BufferRingALTest::updateLoopingEmpty});
+}
+
+struct StreamingImporter: AbstractImporter {
+    explicit StreamingImporter(std::size_t sampleCount): sampleCount{sampleCount} {}
+
+    ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    BufferFormat doFormat() const override { return BufferFormat::Mono8; }
+    UnsignedInt doFrequency() const override { return 22050; }
+    Containers::Array<char> doData() override { return nullptr; }
+
+    std::size_t doSampleCount() const override { return sampleCount; }
+    std::size_t doSampleOffset() const override { return offset; }
+    void doSeek(std::size_t offset) override { this->offset = offset; }
+    std::size_t doRead(Containers::ArrayView<char> data) override {
+        const std::size_t count = Math::min(data.size(), sampleCount - offset);
+        for(std::size_t i = 0; i != count; ++i)
+            data[i] = char(offset + i);
+        offset += count;
+        return count;
+    }
+
+    std::size_t sampleCount;
+    std::size_t offset = 0;
+};
+
+void BufferRingALTest::construct() {
+    BufferRing ring{3, 4};
+    CORRADE_COMPARE(ring.bufferCount(), 3);
+    CORRADE_COMPARE(ring.samplesPerBuffer(), 4);
+    CORRADE_COMPARE(ring.queuedBufferCount(), 0);
+    CORRADE_VERIFY(!ring.isLooping());
+    for(Buffer& buffer: ring.buffers())
+        CORRADE_VERIFY(buffer.id() != 0);
+}
+
+void BufferRingALTest::update() {
+    StreamingImporter importer{10};
+    Source source;
+    BufferRing ring{3, 4};
+
+    /* The last buffer gets only what's left */
+    CORRADE_COMPARE(ring.update(source, importer), 3);
+    CORRADE_COMPARE(ring.queuedBufferCount(), 3);
+    CORRADE_COMPARE(importer.sampleOffset(), 10);
+    CORRADE_COMPARE(ring.buffers()[0].sampleCount(), 4);
+    CORRADE_COMPARE(ring.buffers()[1].sampleCount(), 4);
+    CORRADE_COMPARE(ring.buffers()[2].sampleCount(), 2);
+    CORRADE_COMPARE(ring.buffers()[2].frequency(), 22050);
+
+    /* Nothing was played yet, so nothing gets queued */
+    CORRADE_COMPARE(ring.update(source, importer), 0);
+    CORRADE_COMPARE(ring.queuedBufferCount(), 3);
+}
+
+void BufferRingALTest::updateLooping() {
+    StreamingImporter importer{10};
+    Source source;
+    BufferRing ring{3, 4};
+    ring.setLooping(true);
+    CORRADE_VERIFY(ring.isLooping());
+
+    /* The last buffer continues from the start */
+    CORRADE_COMPARE(ring.update(source, importer), 3);
+    CORRADE_COMPARE(importer.sampleOffset(), 2);
+    CORRADE_COMPARE(ring.buffers()[0].sampleCount(), 4);
+    CORRADE_COMPARE(ring.buffers()[1].sampleCount(), 4);
+    CORRADE_COMPARE(ring.buffers()[2].sampleCount(), 4);
+}
+
+void BufferRingALTest::updateLoopingEmpty() {
+    StreamingImporter importer{0};
+    Source source;
+    BufferRing ring{3, 4};
+    ring.setLooping(true);
+
+    /* Shouldn't loop forever */
+    CORRADE_COMPARE(ring.update(source, importer), 0);
+    CORRADE_COMPARE(ring.queuedBufferCount(), 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::BufferRingALTest)
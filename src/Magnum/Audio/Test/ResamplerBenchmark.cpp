@@ -0,0 +1,85 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Audio/Resampler.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct ResamplerBenchmark: TestSuite::Tester {
+    explicit ResamplerBenchmark();
+
+    void process();
+};
+
+constexpr struct {
+    const char* name;
+    UnsignedInt inputFrequency, outputFrequency, tapCount;
+} ProcessData[]{
+    {"44.1 to 48 kHz, 16 taps", 44100, 48000, 16},
+    {"44.1 to 48 kHz, 32 taps", 44100, 48000, 32},
+    {"44.1 to 48 kHz, 64 taps", 44100, 48000, 64},
+    {"48 to 44.1 kHz, 32 taps", 48000, 44100, 32},
+    {"22.05 to 48 kHz, 32 taps", 22050, 48000, 32},
+};
+
+ResamplerBenchmark::ResamplerBenchmark() {
+    addInstancedBenchmarks({&ResamplerBenchmark::process}, 25,
+        Containers::arraySize(ProcessData));
+}
+
+/* A second of stereo audio */
+enum: std::size_t { Channels = 2 };
+
+void ResamplerBenchmark::process() {
+    auto&& data = ProcessData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<Float> src{Containers::NoInit, data.inputFrequency*Channels};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = Float(Int(i%97) - 48)/48.0f;
+    /* One more sample to fit the rounded-up output */
+    Containers::Array<Float> dst{Containers::NoInit, (data.outputFrequency + 1)*Channels};
+
+    Resampler resampler{Channels, data.inputFrequency, data.outputFrequency, data.tapCount};
+    std::size_t produced = 0;
+    CORRADE_BENCHMARK(1) {
+        resampler.reset();
+        const Containers::StridedArrayView2D<Float> dstView{dst, {dst.size()/Channels, Channels}};
+        produced = resampler.process(
+            Containers::StridedArrayView2D<const Float>{src, {src.size()/Channels, Channels}},
+            dstView).second;
+        produced += resampler.flush(dstView.suffix(produced));
+    }
+
+    CORRADE_COMPARE(produced, data.outputFrequency);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::ResamplerBenchmark)
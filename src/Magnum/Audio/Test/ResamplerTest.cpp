@@ -0,0 +1,238 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Audio/Resampler.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Angle.h"
+#include "Magnum/Math/Vector2.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct ResamplerTest: TestSuite::Tester {
+    explicit ResamplerTest();
+
+    void construct();
+    void constructInvalid();
+    void constructMove();
+
+    void sameFrequency();
+    void sine();
+    void flushSmallOutput();
+    void reset();
+
+    void processInvalidChannelCount();
+};
+
+constexpr struct {
+    const char* name;
+    UnsignedInt inputFrequency, outputFrequency, tapCount;
+    std::size_t inputChunk, outputChunk;
+    Float delta;
+} SineData[]{
+    {"44.1 to 48 kHz", 44100, 48000, 32, 100000, 100000, 1.0e-4f},
+    {"44.1 to 48 kHz, small chunks", 44100, 48000, 32, 7, 3, 1.0e-4f},
+    {"48 to 44.1 kHz", 48000, 44100, 32, 1000, 333, 1.0e-4f},
+    {"22.05 to 44.1 kHz", 22050, 44100, 16, 13, 5000, 1.0e-3f},
+    /* Downsampling by a factor larger than the tap count, skipping input */
+    {"48 to 6 kHz, 4 taps", 48000, 6000, 4, 13, 5, 1.0e-2f},
+};
+
+ResamplerTest::ResamplerTest() {
+    addTests({&ResamplerTest::construct,
+              &ResamplerTest::constructInvalid,
+              &ResamplerTest::constructMove,
+
+              &ResamplerTest::sameFrequency});
+
+    addInstancedTests({&ResamplerTest::sine},
+        Containers::arraySize(SineData));
+
+    addTests({&ResamplerTest::flushSmallOutput,
+              &ResamplerTest::reset,
+
+              &ResamplerTest::processInvalidChannelCount});
+}
+
+void ResamplerTest::construct() {
+    Resampler resampler{2, 44100, 48000};
+    CORRADE_COMPARE(resampler.channelCount(), 2);
+    CORRADE_COMPARE(resampler.inputFrequency(), 44100);
+    CORRADE_COMPARE(resampler.outputFrequency(), 48000);
+    CORRADE_COMPARE(resampler.tapCount(), 32);
+    /* 48000/gcd(44100, 48000) */
+    CORRADE_COMPARE(resampler.phaseCount(), 160);
+}
+
+void ResamplerTest::constructInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Resampler{0, 44100, 48000};
+    Resampler{1, 44100, 48000, 7};
+    CORRADE_COMPARE(out.str(),
+        "Audio::Resampler: expected non-zero channel count and frequencies, got 0, 44100 and 48000\n"
+        "Audio::Resampler: expected a non-zero even tap count, got 7\n");
+}
+
+void ResamplerTest::constructMove() {
+    Resampler a{2, 22050, 44100, 16};
+
+    Resampler b{std::move(a)};
+    CORRADE_COMPARE(b.channelCount(), 2);
+    CORRADE_COMPARE(b.phaseCount(), 2);
+
+    Resampler c{1, 8000, 8000, 2};
+    c = std::move(b);
+    CORRADE_COMPARE(c.channelCount(), 2);
+    CORRADE_COMPARE(c.tapCount(), 16);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<Resampler>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<Resampler>::value);
+}
+
+void ResamplerTest::sameFrequency() {
+    Resampler resampler{1, 44100, 44100, 8};
+    CORRADE_COMPARE(resampler.phaseCount(), 1);
+
+    /* With the same frequency it should be a (delayed) identity */
+    const Float src[]{0.5f, -0.25f, 1.0f, 0.0f, 0.75f};
+    Float dst[8];
+    Containers::StridedArrayView2D<Float> dstView{dst, {8, 1}};
+
+    const std::pair<std::size_t, std::size_t> out = resampler.process(Containers::StridedArrayView2D<const Float>{src, {5, 1}}, dstView);
+    CORRADE_COMPARE(out.first, 5);
+    CORRADE_COMPARE(out.second, 1);
+
+    /* The rest gets produced on flush */
+    const std::size_t flushed = resampler.flush(dstView.suffix(1));
+    CORRADE_COMPARE(flushed, 4);
+    CORRADE_COMPARE(resampler.flush(dstView), 0);
+
+    for(std::size_t i = 0; i != 5; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_WITH(dst[i], src[i], TestSuite::Compare::around(1.0e-6f));
+    }
+}
+
+void ResamplerTest::sine() {
+    auto&& data = SineData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* A 440 Hz sine in the first channel and DC in the second */
+    enum: std::size_t { Count = 5000 };
+    Containers::Array<Vector2> src{Containers::NoInit, Count};
+    for(std::size_t i = 0; i != Count; ++i)
+        src[i] = {Math::sin(Rad(2.0f*Constants::pi()*440.0f*i/data.inputFrequency)), 0.5f};
+
+    Resampler resampler{2, data.inputFrequency, data.outputFrequency, data.tapCount};
+    Containers::Array<Vector2> chunk{Containers::NoInit, data.outputChunk};
+    Containers::Array<Vector2> dst;
+    for(std::size_t offset = 0; offset != Count; ) {
+        const std::pair<std::size_t, std::size_t> out = resampler.process(
+            Containers::arrayCast<2, const Float>(Containers::stridedArrayView(src).slice(offset, Math::min(offset + data.inputChunk, std::size_t(Count)))),
+            Containers::arrayCast<2, Float>(Containers::stridedArrayView(chunk)));
+        offset += out.first;
+        arrayAppend(dst, chunk.prefix(out.second));
+    }
+    for(;;) {
+        const std::size_t flushed = resampler.flush(Containers::arrayCast<2, Float>(Containers::stridedArrayView(chunk)));
+        arrayAppend(dst, chunk.prefix(flushed));
+        if(flushed < chunk.size()) break;
+    }
+
+    /* ceil(Count*outputFrequency/inputFrequency) */
+    CORRADE_COMPARE(dst.size(), (Count*std::size_t(data.outputFrequency) + data.inputFrequency - 1)/data.inputFrequency);
+
+    /* Ignoring the edges that are affected by the implicit silence around */
+    for(std::size_t i = data.tapCount; i < dst.size() - data.tapCount; ++i) {
+        CORRADE_ITERATION(i);
+        const Float expected = Math::sin(Rad(2.0f*Constants::pi()*440.0f*i/data.outputFrequency));
+        CORRADE_COMPARE_WITH(dst[i].x(), expected, TestSuite::Compare::around(data.delta));
+        CORRADE_COMPARE_WITH(dst[i].y(), 0.5f, TestSuite::Compare::around(data.delta));
+    }
+}
+
+void ResamplerTest::flushSmallOutput() {
+    Resampler resampler{1, 8000, 8000, 8};
+    const Float src[]{1.0f, 2.0f, 3.0f};
+    Float dst[3];
+    Containers::StridedArrayView2D<Float> dstView{dst, {3, 1}};
+    CORRADE_COMPARE(resampler.process(Containers::StridedArrayView2D<const Float>{src, {3, 1}}, dstView).second, 0);
+
+    /* Flushing into a too small output can be resumed */
+    CORRADE_COMPARE(resampler.flush(dstView.prefix(2)), 2);
+    CORRADE_COMPARE_WITH(dst[0], 1.0f, TestSuite::Compare::around(1.0e-6f));
+    CORRADE_COMPARE_WITH(dst[1], 2.0f, TestSuite::Compare::around(1.0e-6f));
+    CORRADE_COMPARE(resampler.flush(dstView), 1);
+    CORRADE_COMPARE_WITH(dst[0], 3.0f, TestSuite::Compare::around(1.0e-6f));
+    CORRADE_COMPARE(resampler.flush(dstView), 0);
+}
+
+void ResamplerTest::reset() {
+    Resampler resampler{1, 8000, 8000, 8};
+    Float src[]{1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f};
+    Float dst[8];
+    Containers::StridedArrayView2D<Float> dstView{dst, {8, 1}};
+    CORRADE_COMPARE(resampler.process(Containers::StridedArrayView2D<const Float>{src, {8, 1}}, dstView).second, 4);
+
+    /* After a reset the previous input doesn't affect the output anymore
+       and the flush works again */
+    resampler.reset();
+    CORRADE_COMPARE(resampler.process(Containers::StridedArrayView2D<const Float>{src, {1, 1}}, dstView).second, 0);
+    CORRADE_COMPARE(resampler.flush(dstView), 1);
+    CORRADE_COMPARE_WITH(dst[0], 1.0f, TestSuite::Compare::around(1.0e-6f));
+}
+
+void ResamplerTest::processInvalidChannelCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Resampler resampler{2, 8000, 8000};
+    Float data[4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    resampler.process(Containers::StridedArrayView2D<const Float>{data, {4, 1}}, Containers::StridedArrayView2D<Float>{data, {2, 2}});
+    resampler.flush(Containers::StridedArrayView2D<Float>{data, {1, 4}});
+    CORRADE_COMPARE(out.str(),
+        "Audio::Resampler::process(): expected source and destination with 2 channels but got 1 and 2\n"
+        "Audio::Resampler::flush(): expected destination with 2 channels but got 4\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::ResamplerTest)
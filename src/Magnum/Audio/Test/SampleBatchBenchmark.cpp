@@ -0,0 +1,218 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Audio/SampleBatch.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Packing.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct SampleBatchBenchmark: TestSuite::Tester {
+    explicit SampleBatchBenchmark();
+
+    void pcm16ToFloatScalar();
+    void pcm16ToFloat();
+    void floatToPcm16Scalar();
+    void floatToPcm16();
+    void decodeMuLawScalar();
+    void decodeMuLaw();
+    void interleaveScalar();
+    void interleave();
+    void deinterleaveScalar();
+    void deinterleave();
+};
+
+SampleBatchBenchmark::SampleBatchBenchmark() {
+    addBenchmarks({&SampleBatchBenchmark::pcm16ToFloatScalar,
+                   &SampleBatchBenchmark::pcm16ToFloat,
+                   &SampleBatchBenchmark::floatToPcm16Scalar,
+                   &SampleBatchBenchmark::floatToPcm16,
+                   &SampleBatchBenchmark::decodeMuLawScalar,
+                   &SampleBatchBenchmark::decodeMuLaw,
+                   &SampleBatchBenchmark::interleaveScalar,
+                   &SampleBatchBenchmark::interleave,
+                   &SampleBatchBenchmark::deinterleaveScalar,
+                   &SampleBatchBenchmark::deinterleave}, 100);
+}
+
+/* A second of stereo audio at 48 kHz */
+enum: std::size_t { Count = 48000, Channels = 2 };
+
+Containers::Array<Short> shortData() {
+    Containers::Array<Short> data{Containers::NoInit, Count*Channels};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = Short(i*37);
+    return data;
+}
+
+Containers::Array<Float> floatData() {
+    Containers::Array<Float> data{Containers::NoInit, Count*Channels};
+    /* Going slightly outside of the [-1, 1] range to exercise clipping */
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = Float(Int(i%97) - 48)/46.0f;
+    return data;
+}
+
+void SampleBatchBenchmark::pcm16ToFloatScalar() {
+    Containers::Array<Short> src = shortData();
+    Containers::Array<Float> dst{Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != src.size(); ++i)
+            dst[i] = Math::unpack<Float>(src[i]);
+    }
+
+    CORRADE_COMPARE(dst[1], Math::unpack<Float>(Short(37)));
+}
+
+void SampleBatchBenchmark::pcm16ToFloat() {
+    Containers::Array<Short> src = shortData();
+    Containers::Array<Float> dst{Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        pcmToFloatInto(Containers::StridedArrayView2D<const Short>{src, {Count, Channels}},
+            Containers::StridedArrayView2D<Float>{dst, {Count, Channels}});
+    }
+
+    CORRADE_COMPARE(dst[1], Math::unpack<Float>(Short(37)));
+}
+
+void SampleBatchBenchmark::floatToPcm16Scalar() {
+    Containers::Array<Float> src = floatData();
+    Containers::Array<Short> dst{Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != src.size(); ++i)
+            dst[i] = Math::pack<Short>(Math::clamp(src[i], -1.0f, 1.0f));
+    }
+
+    CORRADE_COMPARE(dst[0], -32767);
+}
+
+void SampleBatchBenchmark::floatToPcm16() {
+    Containers::Array<Float> src = floatData();
+    Containers::Array<Short> dst{Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        floatToPcmInto(Containers::StridedArrayView2D<const Float>{src, {Count, Channels}},
+            Containers::StridedArrayView2D<Short>{dst, {Count, Channels}});
+    }
+
+    CORRADE_COMPARE(dst[0], -32767);
+}
+
+/* The usual branchy μ-law decoder, for comparison with the table lookup */
+Short decodeMuLawScalar(UnsignedByte value) {
+    value = ~value;
+    const Int exponent = (value >> 4) & 0x07;
+    const Int magnitude = ((((value & 0x0f) << 3) + 0x84) << exponent) - 0x84;
+    return Short(value & 0x80 ? -magnitude : magnitude);
+}
+
+void SampleBatchBenchmark::decodeMuLawScalar() {
+    Containers::Array<UnsignedByte> src{Containers::NoInit, Count*Channels};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = UnsignedByte(i*37);
+    Containers::Array<Short> dst{Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != src.size(); ++i)
+            dst[i] = decodeMuLawScalar(src[i]);
+    }
+
+    CORRADE_COMPARE(dst[0], -32124);
+}
+
+void SampleBatchBenchmark::decodeMuLaw() {
+    Containers::Array<UnsignedByte> src{Containers::NoInit, Count*Channels};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = UnsignedByte(i*37);
+    Containers::Array<Short> dst{Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        decodeMuLawInto(Containers::StridedArrayView2D<const UnsignedByte>{src, {Count, Channels}},
+            Containers::StridedArrayView2D<Short>{dst, {Count, Channels}});
+    }
+
+    CORRADE_COMPARE(dst[0], -32124);
+}
+
+void SampleBatchBenchmark::interleaveScalar() {
+    Containers::Array<Float> src = floatData();
+    Containers::Array<Float> dst{Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Count; ++i)
+            for(std::size_t channel = 0; channel != Channels; ++channel)
+                dst[i*Channels + channel] = src[channel*Count + i];
+    }
+
+    CORRADE_COMPARE(dst[1], src[Count]);
+}
+
+void SampleBatchBenchmark::interleave() {
+    Containers::Array<Float> src = floatData();
+    Containers::Array<Float> dst{Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        interleaveInto(Containers::StridedArrayView2D<const Float>{src, {Channels, Count}},
+            Containers::StridedArrayView2D<Float>{dst, {Count, Channels}});
+    }
+
+    CORRADE_COMPARE(dst[1], src[Count]);
+}
+
+void SampleBatchBenchmark::deinterleaveScalar() {
+    Containers::Array<Float> src = floatData();
+    Containers::Array<Float> dst{Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t channel = 0; channel != Channels; ++channel)
+            for(std::size_t i = 0; i != Count; ++i)
+                dst[channel*Count + i] = src[i*Channels + channel];
+    }
+
+    CORRADE_COMPARE(dst[Count], src[1]);
+}
+
+void SampleBatchBenchmark::deinterleave() {
+    Containers::Array<Float> src = floatData();
+    Containers::Array<Float> dst{Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        deinterleaveInto(Containers::StridedArrayView2D<const Float>{src, {Count, Channels}},
+            Containers::StridedArrayView2D<Float>{dst, {Channels, Count}});
+    }
+
+    CORRADE_COMPARE(dst[Count], src[1]);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::SampleBatchBenchmark)
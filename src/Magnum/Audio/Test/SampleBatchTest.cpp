@@ -0,0 +1,413 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Audio/SampleBatch.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/TypeTraits.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct SampleBatchTest: TestSuite::Tester {
+    explicit SampleBatchTest();
+
+    void pcm8ToFloat();
+    void pcm16ToFloat();
+    void floatToPcm8();
+    void floatToPcm16();
+    void pcm8RoundTrip();
+    void pcmStrided();
+    void pcmLarge();
+    void pcmAssertions();
+
+    void decodeALaw();
+    void decodeMuLaw();
+    void decodeLawFloat();
+    void decodeLawAssertions();
+
+    template<class T> void interleave();
+    template<class T> void interleaveGeneric();
+    template<class T> void deinterleave();
+    template<class T> void deinterleaveGeneric();
+    void interleaveAssertions();
+};
+
+SampleBatchTest::SampleBatchTest() {
+    addTests({&SampleBatchTest::pcm8ToFloat,
+              &SampleBatchTest::pcm16ToFloat,
+              &SampleBatchTest::floatToPcm8,
+              &SampleBatchTest::floatToPcm16,
+              &SampleBatchTest::pcm8RoundTrip,
+              &SampleBatchTest::pcmStrided,
+              &SampleBatchTest::pcmLarge,
+              &SampleBatchTest::pcmAssertions,
+
+              &SampleBatchTest::decodeALaw,
+              &SampleBatchTest::decodeMuLaw,
+              &SampleBatchTest::decodeLawFloat,
+              &SampleBatchTest::decodeLawAssertions,
+
+              &SampleBatchTest::interleave<UnsignedByte>,
+              &SampleBatchTest::interleave<Short>,
+              &SampleBatchTest::interleave<Float>,
+              &SampleBatchTest::interleaveGeneric<UnsignedByte>,
+              &SampleBatchTest::interleaveGeneric<Short>,
+              &SampleBatchTest::interleaveGeneric<Float>,
+              &SampleBatchTest::deinterleave<UnsignedByte>,
+              &SampleBatchTest::deinterleave<Short>,
+              &SampleBatchTest::deinterleave<Float>,
+              &SampleBatchTest::deinterleaveGeneric<UnsignedByte>,
+              &SampleBatchTest::deinterleaveGeneric<Short>,
+              &SampleBatchTest::deinterleaveGeneric<Float>,
+              &SampleBatchTest::interleaveAssertions});
+}
+
+template<class T> Containers::StridedArrayView2D<T> mono(Containers::ArrayView<T> data) {
+    return Containers::StridedArrayView2D<T>{data, {data.size(), 1}};
+}
+
+void SampleBatchTest::pcm8ToFloat() {
+    const UnsignedByte src[]{0, 1, 128, 255, 64};
+    Float dst[5];
+    pcmToFloatInto(mono(Containers::arrayView(src)), mono(Containers::arrayView(dst)));
+    CORRADE_COMPARE_AS(Containers::arrayView(dst),
+        Containers::arrayView<Float>({-1.0f, -1.0f, 0.0f, 1.0f, -64.0f/127.0f}),
+        TestSuite::Compare::Container);
+}
+
+void SampleBatchTest::pcm16ToFloat() {
+    const Short src[]{-32768, -32767, 0, 16384, 32767};
+    Float dst[5];
+    pcmToFloatInto(mono(Containers::arrayView(src)), mono(Containers::arrayView(dst)));
+    CORRADE_COMPARE_AS(Containers::arrayView(dst),
+        Containers::arrayView<Float>({-1.0f, -1.0f, 0.0f, 16384.0f/32767.0f, 1.0f}),
+        TestSuite::Compare::Container);
+}
+
+void SampleBatchTest::floatToPcm8() {
+    /* Values outside of the range are clipped */
+    const Float src[]{-2.0f, -1.0f, 0.0f, 0.5f, 1.0f, 3.0f};
+    UnsignedByte dst[6];
+    floatToPcmInto(mono(Containers::arrayView(src)), mono(Containers::arrayView(dst)));
+    CORRADE_COMPARE_AS(Containers::arrayView(dst),
+        Containers::arrayView<UnsignedByte>({1, 1, 128, 192, 255, 255}),
+        TestSuite::Compare::Container);
+}
+
+void SampleBatchTest::floatToPcm16() {
+    /* Values outside of the range are clipped */
+    const Float src[]{-2.0f, -1.0f, 0.0f, 0.5f, 1.0f, 3.0f};
+    Short dst[6];
+    floatToPcmInto(mono(Containers::arrayView(src)), mono(Containers::arrayView(dst)));
+    CORRADE_COMPARE_AS(Containers::arrayView(dst),
+        Containers::arrayView<Short>({-32767, -32767, 0, 16384, 32767, 32767}),
+        TestSuite::Compare::Container);
+}
+
+void SampleBatchTest::pcm8RoundTrip() {
+    UnsignedByte src[256];
+    for(std::size_t i = 0; i != 256; ++i)
+        src[i] = UnsignedByte(i);
+
+    Float floats[256];
+    UnsignedByte dst[256];
+    pcmToFloatInto(mono(Containers::arrayView(src)), mono(Containers::arrayView(floats)));
+    floatToPcmInto(mono(Containers::arrayView<const Float>(floats)), mono(Containers::arrayView(dst)));
+
+    /* Zero is the only value that doesn't survive, as -128 is treated the
+       same as -127 */
+    src[0] = 1;
+    CORRADE_COMPARE_AS(Containers::arrayView(dst),
+        Containers::arrayView(src),
+        TestSuite::Compare::Container);
+}
+
+void SampleBatchTest::pcmStrided() {
+    /* Every other stereo sample, making the rows non-contiguous */
+    const Short src[]{
+        -32767, 32767,
+        1, 2,
+        0, 16384,
+        3, 4,
+    };
+    Float dst[4][2]{};
+    pcmToFloatInto(
+        Containers::StridedArrayView2D<const Short>{src, {4, 2}}.every({2, 1}),
+        Containers::StridedArrayView2D<Float>{Containers::arrayCast<Float>(Containers::arrayView(dst)), {4, 2}}.every({2, 1}));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(Containers::arrayView(dst)),
+        Containers::arrayView<Float>({
+            -1.0f, 1.0f,
+            0.0f, 0.0f,
+            0.0f, 16384.0f/32767.0f,
+            0.0f, 0.0f,
+        }), TestSuite::Compare::Container);
+}
+
+void SampleBatchTest::pcmLarge() {
+    /* Larger than the internal temporary to verify it's processed in
+       blocks */
+    Containers::Array<UnsignedByte> src{Containers::NoInit, 3001*2};
+    Containers::Array<Float> expected{Containers::NoInit, src.size()};
+    for(std::size_t i = 0; i != src.size(); ++i) {
+        src[i] = UnsignedByte(i*37);
+        expected[i] = Math::unpack<Float>(Byte(src[i] ^ 0x80));
+    }
+
+    Containers::Array<Float> dst{Containers::NoInit, src.size()};
+    pcmToFloatInto(
+        Containers::StridedArrayView2D<const UnsignedByte>{src, {3001, 2}},
+        Containers::StridedArrayView2D<Float>{dst, {3001, 2}});
+    CORRADE_COMPARE_AS(dst, expected, TestSuite::Compare::Container);
+
+    Containers::Array<UnsignedByte> back{Containers::NoInit, src.size()};
+    floatToPcmInto(
+        Containers::StridedArrayView2D<const Float>{dst, {3001, 2}},
+        Containers::StridedArrayView2D<UnsignedByte>{back, {3001, 2}});
+    for(std::size_t i = 0; i != src.size(); ++i) if(src[i] == 0) src[i] = 1;
+    CORRADE_COMPARE_AS(back, src, TestSuite::Compare::Container);
+}
+
+void SampleBatchTest::pcmAssertions() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedByte pcm8[4]{};
+    Short pcm16[4]{};
+    Float floats[4]{};
+    Float floatsWrongSize[3]{};
+
+    auto floatsNotContiguous = Containers::StridedArrayView2D<Float>{floats, {2, 2}}.every({1, 2});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pcmToFloatInto(mono(Containers::arrayView<const UnsignedByte>(pcm8)), mono(Containers::arrayView(floatsWrongSize)));
+    pcmToFloatInto(Containers::StridedArrayView2D<const UnsignedByte>{pcm8, {2, 2}}.every({1, 2}), floatsNotContiguous);
+    pcmToFloatInto(mono(Containers::arrayView<const Short>(pcm16)), mono(Containers::arrayView(floatsWrongSize)));
+    pcmToFloatInto(Containers::StridedArrayView2D<const Short>{pcm16, {2, 2}}.every({1, 2}), floatsNotContiguous);
+    floatToPcmInto(mono(Containers::arrayView<const Float>(floatsWrongSize)), mono(Containers::arrayView(pcm8)));
+    floatToPcmInto(floatsNotContiguous, Containers::StridedArrayView2D<UnsignedByte>{pcm8, {2, 2}}.every({1, 2}));
+    floatToPcmInto(mono(Containers::arrayView<const Float>(floatsWrongSize)), mono(Containers::arrayView(pcm16)));
+    floatToPcmInto(floatsNotContiguous, Containers::StridedArrayView2D<Short>{pcm16, {2, 2}}.every({1, 2}));
+    CORRADE_COMPARE(out.str(),
+        "Audio::pcmToFloatInto(): wrong destination size, got {3, 1} but expected {4, 1}\n"
+        "Audio::pcmToFloatInto(): second view dimension is not contiguous\n"
+        "Audio::pcmToFloatInto(): wrong destination size, got {3, 1} but expected {4, 1}\n"
+        "Audio::pcmToFloatInto(): second view dimension is not contiguous\n"
+        "Audio::floatToPcmInto(): wrong destination size, got {4, 1} but expected {3, 1}\n"
+        "Audio::floatToPcmInto(): second view dimension is not contiguous\n"
+        "Audio::floatToPcmInto(): wrong destination size, got {4, 1} but expected {3, 1}\n"
+        "Audio::floatToPcmInto(): second view dimension is not contiguous\n");
+}
+
+void SampleBatchTest::decodeALaw() {
+    const UnsignedByte src[]{0xd5, 0x55, 0x2a, 0xaa};
+    Short dst[4];
+    decodeALawInto(mono(Containers::arrayView(src)), mono(Containers::arrayView(dst)));
+    CORRADE_COMPARE_AS(Containers::arrayView(dst),
+        Containers::arrayView<Short>({8, -8, -32256, 32256}),
+        TestSuite::Compare::Container);
+}
+
+void SampleBatchTest::decodeMuLaw() {
+    const UnsignedByte src[]{0xff, 0x7f, 0x00, 0x80};
+    Short dst[4];
+    decodeMuLawInto(mono(Containers::arrayView(src)), mono(Containers::arrayView(dst)));
+    CORRADE_COMPARE_AS(Containers::arrayView(dst),
+        Containers::arrayView<Short>({0, 0, -32124, 32124}),
+        TestSuite::Compare::Container);
+}
+
+void SampleBatchTest::decodeLawFloat() {
+    UnsignedByte src[256];
+    for(std::size_t i = 0; i != 256; ++i)
+        src[i] = UnsignedByte(i);
+
+    /* The float variants should be the same as decoding to 16-bit and then
+       converting to floats */
+    Short decoded[256];
+    Float expected[256];
+    Float dst[256];
+
+    decodeALawInto(mono(Containers::arrayView<const UnsignedByte>(src)), mono(Containers::arrayView(decoded)));
+    pcmToFloatInto(mono(Containers::arrayView<const Short>(decoded)), mono(Containers::arrayView(expected)));
+    decodeALawInto(mono(Containers::arrayView<const UnsignedByte>(src)), mono(Containers::arrayView(dst)));
+    CORRADE_COMPARE_AS(Containers::arrayView(dst),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+
+    decodeMuLawInto(mono(Containers::arrayView<const UnsignedByte>(src)), mono(Containers::arrayView(decoded)));
+    pcmToFloatInto(mono(Containers::arrayView<const Short>(decoded)), mono(Containers::arrayView(expected)));
+    decodeMuLawInto(mono(Containers::arrayView<const UnsignedByte>(src)), mono(Containers::arrayView(dst)));
+    CORRADE_COMPARE_AS(Containers::arrayView(dst),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void SampleBatchTest::decodeLawAssertions() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedByte src[4]{};
+    Short pcm16[3]{};
+    Float floats[3]{};
+    Float floatsNotContiguous[8]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    decodeALawInto(mono(Containers::arrayView<const UnsignedByte>(src)), mono(Containers::arrayView(pcm16)));
+    decodeALawInto(mono(Containers::arrayView<const UnsignedByte>(src)), mono(Containers::arrayView(floats)));
+    decodeALawInto(Containers::StridedArrayView2D<const UnsignedByte>{src, {2, 2}}, Containers::StridedArrayView2D<Float>{floatsNotContiguous, {2, 4}}.every({1, 2}));
+    decodeMuLawInto(mono(Containers::arrayView<const UnsignedByte>(src)), mono(Containers::arrayView(pcm16)));
+    decodeMuLawInto(mono(Containers::arrayView<const UnsignedByte>(src)), mono(Containers::arrayView(floats)));
+    CORRADE_COMPARE(out.str(),
+        "Audio::decodeALawInto(): wrong destination size, got {3, 1} but expected {4, 1}\n"
+        "Audio::decodeALawInto(): wrong destination size, got {3, 1} but expected {4, 1}\n"
+        "Audio::decodeALawInto(): second view dimension is not contiguous\n"
+        "Audio::decodeMuLawInto(): wrong destination size, got {3, 1} but expected {4, 1}\n"
+        "Audio::decodeMuLawInto(): wrong destination size, got {3, 1} but expected {4, 1}\n");
+}
+
+template<class T> void SampleBatchTest::interleave() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    /* Enough samples for both the SIMD and the scalar remainder path */
+    enum: std::size_t { Count = 37 };
+    T planar[2][Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        planar[0][i] = T(i*3);
+        planar[1][i] = T(i*7 + 1);
+    }
+
+    T dst[Count][2];
+    interleaveInto(
+        Containers::StridedArrayView2D<const T>{Containers::arrayCast<const T>(Containers::arrayView(planar)), {2, Count}},
+        Containers::StridedArrayView2D<T>{Containers::arrayCast<T>(Containers::arrayView(dst)), {Count, 2}});
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(dst[i][0], T(i*3));
+        CORRADE_COMPARE(dst[i][1], T(i*7 + 1));
+    }
+}
+
+template<class T> void SampleBatchTest::interleaveGeneric() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    /* Three channels go through the generic path */
+    enum: std::size_t { Count = 5 };
+    T planar[3][Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        planar[0][i] = T(i);
+        planar[1][i] = T(i + 10);
+        planar[2][i] = T(i + 20);
+    }
+
+    T dst[Count][3];
+    interleaveInto(
+        Containers::StridedArrayView2D<const T>{Containers::arrayCast<const T>(Containers::arrayView(planar)), {3, Count}},
+        Containers::StridedArrayView2D<T>{Containers::arrayCast<T>(Containers::arrayView(dst)), {Count, 3}});
+    CORRADE_COMPARE_AS(Containers::arrayCast<const T>(Containers::arrayView(dst)),
+        Containers::arrayView<T>({
+            T(0), T(10), T(20),
+            T(1), T(11), T(21),
+            T(2), T(12), T(22),
+            T(3), T(13), T(23),
+            T(4), T(14), T(24)
+        }), TestSuite::Compare::Container);
+}
+
+template<class T> void SampleBatchTest::deinterleave() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    /* Enough samples for both the SIMD and the scalar remainder path */
+    enum: std::size_t { Count = 37 };
+    T src[Count][2];
+    for(std::size_t i = 0; i != Count; ++i) {
+        src[i][0] = T(i*3);
+        src[i][1] = T(i*7 + 1);
+    }
+
+    T planar[2][Count];
+    deinterleaveInto(
+        Containers::StridedArrayView2D<const T>{Containers::arrayCast<const T>(Containers::arrayView(src)), {Count, 2}},
+        Containers::StridedArrayView2D<T>{Containers::arrayCast<T>(Containers::arrayView(planar)), {2, Count}});
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(planar[0][i], T(i*3));
+        CORRADE_COMPARE(planar[1][i], T(i*7 + 1));
+    }
+}
+
+template<class T> void SampleBatchTest::deinterleaveGeneric() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    /* Every other sample makes the source non-contiguous, so it goes through
+       the generic path */
+    const T src[]{
+        T(0), T(10),
+        T(99), T(99),
+        T(1), T(11),
+        T(99), T(99),
+        T(2), T(12)
+    };
+
+    T planar[2][3];
+    deinterleaveInto(
+        Containers::StridedArrayView2D<const T>{src, {5, 2}}.every({2, 1}),
+        Containers::StridedArrayView2D<T>{Containers::arrayCast<T>(Containers::arrayView(planar)), {2, 3}});
+    CORRADE_COMPARE_AS(Containers::arrayCast<const T>(Containers::arrayView(planar)),
+        Containers::arrayView<T>({
+            T(0), T(1), T(2),
+            T(10), T(11), T(12)
+        }), TestSuite::Compare::Container);
+}
+
+void SampleBatchTest::interleaveAssertions() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Float src[6]{};
+    Float dst[6]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    interleaveInto(Containers::StridedArrayView2D<const Float>{src, {2, 3}}, Containers::StridedArrayView2D<Float>{dst, {2, 3}});
+    deinterleaveInto(Containers::StridedArrayView2D<const Float>{src, {3, 2}}, Containers::StridedArrayView2D<Float>{dst, {3, 2}});
+    CORRADE_COMPARE(out.str(),
+        "Audio::interleaveInto(): wrong destination size, got {2, 3} but expected {3, 2}\n"
+        "Audio::deinterleaveInto(): wrong destination size, got {3, 2} but expected {2, 3}\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::SampleBatchTest)
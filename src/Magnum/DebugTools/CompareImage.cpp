@@ -25,6 +25,7 @@
 
 #include "CompareImage.h"
 
+#include <atomic>
 #include <map>
 #include <sstream>
 #include <Corrade/Containers/Array.h>
@@ -35,10 +36,16 @@
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#endif
+
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
-#include "Magnum/Math/Functions.h"
+#include "Magnum/Implementation/parallelFor.h"
+#include "Magnum/Math/FunctionsBatch.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/Half.h"
 #include "Magnum/Math/Algorithms/KahanSum.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/AbstractImporter.h"
@@ -48,90 +55,190 @@ namespace Magnum { namespace DebugTools { namespace Implementation {
 
 namespace {
 
-template<std::size_t size, class T> Float calculateImageDelta(const Containers::StridedArrayView2D<const Math::Vector<size, T>>& actual, const Containers::StridedArrayView2D<const Math::Vector<size, T>>& expected, const Containers::StridedArrayView2D<Float>& output) {
-    CORRADE_INTERNAL_ASSERT(actual.size() == output.size());
-    CORRADE_INTERNAL_ASSERT(output.size() == expected.size());
+/* Each thread compares at least this many pixels */
+constexpr std::size_t MinPixelsPerThread = 65536;
 
-    /* Calculate deltas and maximal value of them */
+/* Calculates deltas of a single row, returns maximal value of them */
+template<std::size_t size, class T> Float calculateRowDelta(const Containers::StridedArrayView1D<const Math::Vector<size, T>>& actual, const Containers::StridedArrayView1D<const Math::Vector<size, T>>& expected, Float* const output) {
     Float max{};
-    for(std::size_t i = 0, iMax = expected.size()[0]; i != iMax; ++i) {
-        Containers::StridedArrayView1D<const Math::Vector<size, T>> actualRow = actual[i];
-        Containers::StridedArrayView1D<const Math::Vector<size, T>> expectedRow = expected[i];
-        Containers::StridedArrayView1D<Float> outputRow = output[i];
-
-        for(std::size_t j = 0, jMax = expectedRow.size(); j != jMax; ++j) {
-            /* Explicitly convert from T to Float */
-            auto actualPixel = Math::Vector<size, Float>(actualRow[j]);
-            auto expectedPixel = Math::Vector<size, Float>(expectedRow[j]);
-
-            /* First calculate a classic difference */
-            Math::Vector<size, Float> diff = Math::abs(actualPixel - expectedPixel);
-
-            /* Mark pixels that are NaN in both actual and expected pixels as
-               having no difference */
-            diff = Math::lerp(diff, {}, Math::isNan(actualPixel) & Math::isNan(expectedPixel));
-
-            /* Then also mark pixels that are the same sign of infnity in both
-               actual and expected pixel as having no difference */
-            diff = Math::lerp(diff, {}, Math::isInf(actualPixel) & Math::isInf(expectedPixel) & Math::equal(actualPixel, expectedPixel));
-
-            /* Calculate the difference and save it to the output image even
-               with NaN and ±Inf (as the user should know) */
-            outputRow[j] = diff.sum()/size;
-
-            /* On the other hand, infs and NaNs should not contribute to the
-               max delta -- because all other differences would be zero
-               compared to them */
-            max = Math::max(max, Math::lerp(diff, {}, Math::isNan(diff)|Math::isInf(diff)).sum()/size);
-        }
+    for(std::size_t i = 0, iMax = expected.size(); i != iMax; ++i) {
+        /* Explicitly convert from T to Float */
+        auto actualPixel = Math::Vector<size, Float>(actual[i]);
+        auto expectedPixel = Math::Vector<size, Float>(expected[i]);
+
+        /* First calculate a classic difference */
+        Math::Vector<size, Float> diff = Math::abs(actualPixel - expectedPixel);
+
+        /* Mark pixels that are NaN in both actual and expected pixels as
+           having no difference */
+        diff = Math::lerp(diff, {}, Math::isNan(actualPixel) & Math::isNan(expectedPixel));
+
+        /* Then also mark pixels that are the same sign of infnity in both
+           actual and expected pixel as having no difference */
+        diff = Math::lerp(diff, {}, Math::isInf(actualPixel) & Math::isInf(expectedPixel) & Math::equal(actualPixel, expectedPixel));
+
+        /* Calculate the difference and save it to the output image even with
+           NaN and ±Inf (as the user should know) */
+        output[i] = diff.sum()/size;
+
+        /* On the other hand, infs and NaNs should not contribute to the max
+           delta -- because all other differences would be zero compared to
+           them */
+        max = Math::max(max, Math::lerp(diff, {}, Math::isNan(diff)|Math::isInf(diff)).sum()/size);
     }
 
     return max;
 }
 
+/* 8-bit formats can't contain any specials and the channel differences can
+   be summed up exactly in integers, which gives the same result as the
+   floating-point calculation above */
+template<std::size_t size> Float calculateRowDeltaBytes(const Containers::StridedArrayView1D<const Math::Vector<size, UnsignedByte>>& actual, const Containers::StridedArrayView1D<const Math::Vector<size, UnsignedByte>>& expected, Float* const output) {
+    UnsignedInt max{};
+    for(std::size_t i = 0, iMax = expected.size(); i != iMax; ++i) {
+        const Math::Vector<size, UnsignedByte>& a = actual[i];
+        const Math::Vector<size, UnsignedByte>& b = expected[i];
+        UnsignedInt sum{};
+        for(std::size_t j = 0; j != size; ++j)
+            sum += a[j] > b[j] ? a[j] - b[j] : b[j] - a[j];
+        output[i] = Float(sum)/size;
+        max = Math::max(max, sum);
+    }
+
+    return Float(max)/size;
 }
 
-std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected) {
-    /* Calculate a delta image */
-    Containers::Array<Float> deltaData{Containers::NoInit,
-        std::size_t(expected.size().product())};
-    Containers::StridedArrayView2D<Float> delta{deltaData,
-        {std::size_t(expected.size().y()), std::size_t(expected.size().x())}};
+template<std::size_t size> Float calculateRowDelta(const Containers::StridedArrayView1D<const Math::Vector<size, UnsignedByte>>& actual, const Containers::StridedArrayView1D<const Math::Vector<size, UnsignedByte>>& expected, Float* const output) {
+    return calculateRowDeltaBytes<size>(actual, expected, output);
+}
 
-    CORRADE_INTERNAL_ASSERT(actualFormat == expected.format());
-    #ifdef CORRADE_NO_ASSERT
-    static_cast<void>(actualFormat);
-    #endif
-    CORRADE_ASSERT(!isPixelFormatImplementationSpecific(expected.format()),
-        "DebugTools::CompareImage: can't compare implementation-specific pixel formats", {});
+#ifdef CORRADE_TARGET_SSE2
+/* Contiguous RGBA8 rows are processed four pixels at a time. The absolute
+   channel difference is a saturated subtraction in both directions, the four
+   channels of each pixel are then summed together with masks and shifts. */
+Float calculateRowDelta(const Containers::StridedArrayView1D<const Math::Vector<4, UnsignedByte>>& actual, const Containers::StridedArrayView1D<const Math::Vector<4, UnsignedByte>>& expected, Float* const output) {
+    if(actual.stride() != 4 || expected.stride() != 4)
+        return calculateRowDeltaBytes<4>(actual, expected, output);
+
+    const std::size_t count = expected.size();
+    const char* const a = static_cast<const char*>(actual.data());
+    const char* const b = static_cast<const char*>(expected.data());
+    const __m128i mask8 = _mm_set1_epi32(0x00ff00ff);
+    const __m128i mask16 = _mm_set1_epi32(0x0000ffff);
+    const __m128 quarter = _mm_set1_ps(0.25f);
+    __m128 maxN = _mm_setzero_ps();
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const __m128i actualN = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i*4));
+        const __m128i expectedN = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i*4));
+        const __m128i diff = _mm_or_si128(_mm_subs_epu8(actualN, expectedN), _mm_subs_epu8(expectedN, actualN));
+        const __m128i pairs = _mm_add_epi32(_mm_and_si128(diff, mask8), _mm_and_si128(_mm_srli_epi32(diff, 8), mask8));
+        const __m128i sums = _mm_add_epi32(_mm_and_si128(pairs, mask16), _mm_srli_epi32(pairs, 16));
+        /* Multiplying by a power-of-two reciprocal is exact */
+        const __m128 delta = _mm_mul_ps(_mm_cvtepi32_ps(sums), quarter);
+        _mm_storeu_ps(output + i, delta);
+        maxN = _mm_max_ps(maxN, delta);
+    }
 
+    Float max[4];
+    _mm_storeu_ps(max, maxN);
+    return Math::max({max[0], max[1], max[2], max[3], calculateRowDeltaBytes<4>(actual.suffix(i), expected.suffix(i), output + i)});
+}
+
+/* Contiguous single-channel float rows, four pixels at a time. Pixels that
+   compare equal (including same-signed infinities) or that are NaN in both
+   images have a zero delta, specials are excluded from the max. */
+Float calculateRowDelta(const Containers::StridedArrayView1D<const Math::Vector<1, Float>>& actual, const Containers::StridedArrayView1D<const Math::Vector<1, Float>>& expected, Float* const output) {
+    if(actual.stride() != 4 || expected.stride() != 4)
+        return calculateRowDelta<1, Float>(actual, expected, output);
+
+    const std::size_t count = expected.size();
+    const Float* const a = static_cast<const Float*>(actual.data());
+    const Float* const b = static_cast<const Float*>(expected.data());
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 inf = _mm_set1_ps(Constants::inf());
+    __m128 maxN = _mm_setzero_ps();
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const __m128 actualN = _mm_loadu_ps(a + i);
+        const __m128 expectedN = _mm_loadu_ps(b + i);
+        const __m128 same = _mm_or_ps(_mm_cmpeq_ps(actualN, expectedN),
+            _mm_and_ps(_mm_cmpunord_ps(actualN, actualN), _mm_cmpunord_ps(expectedN, expectedN)));
+        const __m128 delta = _mm_andnot_ps(same, _mm_andnot_ps(signMask, _mm_sub_ps(actualN, expectedN)));
+        _mm_storeu_ps(output + i, delta);
+        /* NaN compares false, so both NaN and infinity get masked out */
+        maxN = _mm_max_ps(maxN, _mm_and_ps(delta, _mm_cmplt_ps(delta, inf)));
+    }
+
+    Float max[4];
+    _mm_storeu_ps(max, maxN);
+    return Math::max({max[0], max[1], max[2], max[3], calculateRowDelta<1, Float>(actual.suffix(i), expected.suffix(i), output + i)});
+}
+#endif
+
+/* Calculates deltas of all rows, saving a sum of each row to rowSums and
+   returning the max over all rows. If aboveThreshold is not null, the deltas
+   are not saved anywhere and the calculation stops as soon as a row has the
+   max above maxThreshold. */
+template<std::size_t size, class T> Float calculateImageDelta(const Containers::StridedArrayView3D<const char>& actualPixels, const Containers::StridedArrayView3D<const char>& expectedPixels, const Containers::ArrayView<Float> delta, const Containers::ArrayView<Float> rowSums, const std::size_t threadCount, std::atomic<bool>* const aboveThreshold, const Float maxThreshold) {
+    const Containers::StridedArrayView2D<const Math::Vector<size, T>> actual = Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels);
+    const Containers::StridedArrayView2D<const Math::Vector<size, T>> expected = Containers::arrayCast<2, const Math::Vector<size, T>>(expectedPixels);
+    CORRADE_INTERNAL_ASSERT(actual.size() == expected.size());
+
+    const std::size_t height = expected.size()[0];
+    const std::size_t width = expected.size()[1];
+    Containers::Array<Float> rowMaxes{Containers::ValueInit, height};
+    Magnum::Implementation::parallelForRanges(Magnum::Implementation::parallelThreadCount(threadCount, height*width, MinPixelsPerThread), height, [&](const std::size_t begin, const std::size_t end) {
+        /* If the deltas aren't saved, calculate them into a scratch row */
+        Containers::Array<Float> scratch;
+        if(aboveThreshold) scratch = Containers::Array<Float>{Containers::NoInit, width};
+
+        for(std::size_t i = begin; i != end; ++i) {
+            if(aboveThreshold && aboveThreshold->load(std::memory_order_relaxed))
+                return;
+
+            Float* const output = aboveThreshold ? scratch.data() : delta.data() + i*width;
+            rowMaxes[i] = calculateRowDelta(actual[i], expected[i], output);
+
+            /* Sum each row separately so the mean doesn't depend on the
+               thread count. Do it the special way so we don't lose precision
+               -- that would result in having false negatives! This
+               *deliberately* leaves specials in. The max has them already
+               filtered out so if this would filter them out as well, there
+               would be nothing left that could cause the comparison to
+               fail. */
+            rowSums[i] = Math::Algorithms::kahanSum(output, output + width);
+
+            if(aboveThreshold && rowMaxes[i] > maxThreshold) {
+                aboveThreshold->store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+    });
+
+    return Math::max(rowMaxes);
+}
+
+/* Dispatches to calculateImageDelta() above based on the format, returns
+   NaN if the format is unknown */
+Float calculateImageDelta(const PixelFormat format, const Containers::StridedArrayView3D<const char>& actualPixels, const Containers::StridedArrayView3D<const char>& expectedPixels, const Containers::ArrayView<Float> delta, const Containers::ArrayView<Float> rowSums, const std::size_t threadCount, std::atomic<bool>* const aboveThreshold, const Float maxThreshold) {
     #ifdef __GNUC__
     #pragma GCC diagnostic push
     #pragma GCC diagnostic error "-Wswitch"
     #endif
-    Float max{Constants::nan()};
-    switch(expected.format()) {
+    switch(format) {
         #define _c(format, size, T)                                         \
             case PixelFormat::format:                                       \
-                max = calculateImageDelta<size, T>(                         \
-                    Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels), \
-                    expected.pixels<Math::Vector<size, T>>(), delta);       \
-                break;
+                return calculateImageDelta<size, T>(actualPixels,           \
+                    expectedPixels, delta, rowSums, threadCount,            \
+                    aboveThreshold, maxThreshold);
         #define _d(first, second, size, T)                                  \
             case PixelFormat::first:                                        \
-            case PixelFormat::second:                                       \
-                max = calculateImageDelta<size, T>(                         \
-                    Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels), \
-                    expected.pixels<Math::Vector<size, T>>(), delta);       \
-                break;
+            _c(second, size, T)
         #define _e(first, second, third, size, T)                           \
             case PixelFormat::first:                                        \
             case PixelFormat::second:                                       \
-            case PixelFormat::third:                                        \
-                max = calculateImageDelta<size, T>(                         \
-                    Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels), \
-                    expected.pixels<Math::Vector<size, T>>(), delta);       \
-                break;
+            _c(third, size, T)
         /* LCOV_EXCL_START */
         _e(R8Unorm, R8Srgb, R8UI, 1, UnsignedByte)
         _e(RG8Unorm, RG8Srgb, RG8UI, 2, UnsignedByte)
@@ -157,6 +264,10 @@ std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const Pix
         _c(RG32I, 2, Int)
         _c(RGB32I, 3, Int)
         _c(RGBA32I, 4, Int)
+        _c(R16F, 1, Half)
+        _c(RG16F, 2, Half)
+        _c(RGB16F, 3, Half)
+        _c(RGBA16F, 4, Half)
         _c(R32F, 1, Float)
         _c(RG32F, 2, Float)
         _c(RGB32F, 3, Float)
@@ -165,30 +276,70 @@ std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const Pix
         #undef _e
         #undef _d
         #undef _c
-
-        case PixelFormat::R16F:
-        case PixelFormat::RG16F:
-        case PixelFormat::RGB16F:
-        case PixelFormat::RGBA16F:
-            CORRADE_ASSERT_UNREACHABLE("DebugTools::CompareImage: half-float formats are not supported yet", {});
     }
     #ifdef __GNUC__
     #pragma GCC diagnostic pop
     #endif
 
+    return Constants::nan();
+}
+
+}
+
+std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected, const std::size_t threadCount) {
+    /* Calculate a delta image */
+    Containers::Array<Float> deltaData{Containers::NoInit,
+        std::size_t(expected.size().product())};
+    Containers::Array<Float> rowSums{Containers::NoInit,
+        std::size_t(expected.size().y())};
+
+    CORRADE_INTERNAL_ASSERT(actualFormat == expected.format());
+    #ifdef CORRADE_NO_ASSERT
+    static_cast<void>(actualFormat);
+    #endif
+    CORRADE_ASSERT(!isPixelFormatImplementationSpecific(expected.format()),
+        "DebugTools::CompareImage: can't compare implementation-specific pixel formats", {});
+
+    const Float max = calculateImageDelta(expected.format(), actualPixels, expected.pixels(), deltaData, rowSums, threadCount, nullptr, 0.0f);
     CORRADE_ASSERT(max == max,
         "DebugTools::CompareImage: unknown format" << expected.format(), {});
 
-    /* Calculate mean delta. Do it the special way so we don't lose
-       precision -- that would result in having false negatives! This
-       *deliberately* leaves specials in. The `max` has them already filtered
-       out so if this would filter them out as well, there would be nothing
-       left that could cause the comparison to fail. */
-    const Float mean = Math::Algorithms::kahanSum(deltaData.begin(), deltaData.end())/deltaData.size();
+    /* Calculate mean delta from the per-row sums, again the special way */
+    const Float mean = Math::Algorithms::kahanSum(rowSums.begin(), rowSums.end())/deltaData.size();
 
     return std::make_tuple(std::move(deltaData), max, mean);
 }
 
+}
+
+bool isImageWithinThresholds(const ImageView2D& actual, const ImageView2D& expected, const Float maxThreshold, const Float meanThreshold, const std::size_t threadCount) {
+    CORRADE_ASSERT(!Math::isNan(maxThreshold) && !Math::isInf(maxThreshold) &&
+                   !Math::isNan(meanThreshold) && !Math::isInf(meanThreshold),
+        "DebugTools::isImageWithinThresholds(): thresholds can't be NaN or infinity", {});
+    CORRADE_ASSERT(meanThreshold <= maxThreshold,
+        "DebugTools::isImageWithinThresholds(): maxThreshold can't be smaller than meanThreshold", {});
+
+    CORRADE_ASSERT(!isPixelFormatImplementationSpecific(expected.format()),
+        "DebugTools::isImageWithinThresholds(): can't compare implementation-specific pixel formats", {});
+
+    if(actual.size() != expected.size() || actual.format() != expected.format())
+        return false;
+
+    Containers::Array<Float> rowSums{Containers::NoInit,
+        std::size_t(expected.size().y())};
+    std::atomic<bool> aboveThreshold{false};
+    const Float max = Implementation::calculateImageDelta(expected.format(), actual.pixels(), expected.pixels(), nullptr, rowSums, threadCount, &aboveThreshold, maxThreshold);
+    CORRADE_ASSERT(max == max,
+        "DebugTools::isImageWithinThresholds(): unknown format" << expected.format(), {});
+    if(aboveThreshold) return false;
+
+    /* Same comparison as in ImageComparatorBase::compare() */
+    const Float mean = Math::Algorithms::kahanSum(rowSums.begin(), rowSums.end())/std::size_t(expected.size().product());
+    return !(max > maxThreshold) && mean <= meanThreshold;
+}
+
+namespace Implementation {
+
 namespace {
     /* Done by printing an white to black gradient using one of the online
        ASCII converters. Yes, I'm lazy. Another one could be " .,:;ox%#@". */
@@ -290,6 +441,10 @@ void printPixelAt(Debug& out, const Containers::StridedArrayView3D<const char>&
         _c(RG32I, 2, Int)
         _c(RGB32I, 3, Int)
         _c(RGBA32I, 4, Int)
+        _c(R16F, 1, Half)
+        _c(RG16F, 2, Half)
+        _c(RGB16F, 3, Half)
+        _c(RGBA16F, 4, Half)
         _c(R32F, 1, Float)
         _c(RG32F, 2, Float)
         _c(RGB32F, 3, Float)
@@ -308,13 +463,6 @@ void printPixelAt(Debug& out, const Containers::StridedArrayView3D<const char>&
         case PixelFormat::RGBA8Srgb:
             out << *reinterpret_cast<const Color4ub*>(pixel);
             break;
-
-        case PixelFormat::R16F:
-        case PixelFormat::RG16F:
-        case PixelFormat::RGB16F:
-        case PixelFormat::RGBA16F:
-            /* Already handled by a printing assert before */
-            CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
     }
     #ifdef __GNUC__
     #pragma GCC diagnostic pop
@@ -451,7 +599,7 @@ TestSuite::ComparisonStatusFlags ImageComparatorBase::compare(const PixelFormat
     }
 
     Containers::Array<Float> delta;
-    std::tie(delta, _state->max, _state->mean) = DebugTools::Implementation::calculateImageDelta(actualFormat, actualPixels, expected);
+    std::tie(delta, _state->max, _state->mean) = DebugTools::Implementation::calculateImageDelta(actualFormat, actualPixels, expected, 0);
 
     /* Verify the max/mean is never below zero so we didn't mess up when
        calculating specials. Note the inverted condition to catch NaNs in
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::DebugTools::CompareImage
+ * @brief Class @ref Magnum::DebugTools::CompareImage, function @ref Magnum::DebugTools::isImageWithinThresholds()
  */
 
 #include <Corrade/Containers/Pointer.h>
@@ -44,7 +44,7 @@
 namespace Magnum { namespace DebugTools {
 
 namespace Implementation {
-    MAGNUM_DEBUGTOOLS_EXPORT std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected);
+    MAGNUM_DEBUGTOOLS_EXPORT std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected, std::size_t threadCount = 1);
 
     MAGNUM_DEBUGTOOLS_EXPORT void printDeltaImage(Debug& out, Containers::ArrayView<const Float> delta, const Vector2i& size, Float max, Float maxThreshold, Float meanThreshold);
 
@@ -224,10 +224,10 @@ Supports the following formats:
     @ref PixelFormat::RGBA32UI and their one-/two-/three-component versions
 -   @ref PixelFormat::RGBA8I, @ref PixelFormat::RGBA16I,
     @ref PixelFormat::RGBA32I and their one-/two-/three-component versions
--   @ref PixelFormat::RGBA32F and its one-/two-/three-component versions
+-   @ref PixelFormat::RGBA16F, @ref PixelFormat::RGBA32F and their
+    one-/two-/three-component versions
 
-@ref PixelFormat::RGBA16F and other half-float formats are not supported at the
-moment. Implementation-specific pixel formats can't be supported.
+Implementation-specific pixel formats can't be supported.
 
 Supports all @ref PixelStorage parameters. The images don't need to have the
 same pixel storage parameters, meaning you are able to compare different
@@ -262,6 +262,14 @@ is specified, every image comparison with a non-zero delta will print an
 @cb{.ansi} [1;39mINFO @ce message in the same form as the error diagnostic
 shown above.
 
+Large images are split into bands of rows that are processed on all available
+hardware threads. The mean is calculated from per-row sums, so the result
+doesn't depend on the thread count. Contiguous @ref PixelFormat::RGBA8Unorm and
+@ref PixelFormat::R32F rows are processed using SSE2 if enabled at compile
+time, all 8-bit formats are calculated using integer arithmetic. If you need
+just a pass/fail result without any diagnostic, use
+@ref isImageWithinThresholds() instead.
+
 @section DebugTools-CompareImage-specials Special floating-point values
 
 For floating-point input, the comparator treats the values similarly to how
@@ -564,6 +572,31 @@ class CompareFileToImage {
         TestSuite::Comparator<CompareFileToImage> _c;
 };
 
+/**
+@brief Whether an image is within given thresholds of an expected image
+@param actual           Actual image
+@param expected         Expected image
+@param maxThreshold     Max threshold
+@param meanThreshold    Mean threshold
+@param threadCount      Count of threads to use. @cpp 0 @ce means all
+    hardware threads.
+@m_since_latest
+
+A pass/fail-only variant of @ref CompareImage, useful for example when
+comparing a large amount of images outside of @ref Corrade::TestSuite. The
+deltas are calculated the same way as described in the
+@ref CompareImage documentation, returns @cpp true @ce if the max delta is
+not above @p maxThreshold and the mean delta is not above @p meanThreshold,
+@cpp false @ce otherwise or if the images have a different size or format.
+
+Unlike @ref CompareImage, the delta image isn't saved anywhere and the
+calculation stops as soon as any row has a pixel with delta above
+@p maxThreshold. If @p threadCount is larger than @cpp 1 @ce and the image is
+large enough, the rows are split across the threads. On Emscripten the threads
+are not used.
+*/
+MAGNUM_DEBUGTOOLS_EXPORT bool isImageWithinThresholds(const ImageView2D& actual, const ImageView2D& expected, Float maxThreshold, Float meanThreshold, std::size_t threadCount = 1);
+
 namespace Implementation {
 
 /* LCOV_EXCL_START */
@@ -580,6 +613,8 @@ template<> constexpr PixelFormat pixelFormatFor<UnsignedInt>() { return PixelFor
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector<1, UnsignedInt>>() { return PixelFormat::R32UI; }
 template<> constexpr PixelFormat pixelFormatFor<Int>() { return PixelFormat::R32I; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector<1, Int>>() { return PixelFormat::R32I; }
+template<> constexpr PixelFormat pixelFormatFor<Half>() { return PixelFormat::R16F; }
+template<> constexpr PixelFormat pixelFormatFor<Math::Vector<1, Half>>() { return PixelFormat::R16F; }
 template<> constexpr PixelFormat pixelFormatFor<Float>() { return PixelFormat::R32F; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector<1, Float>>() { return PixelFormat::R32F; }
 
@@ -596,6 +631,8 @@ template<> constexpr PixelFormat pixelFormatFor<Math::Vector<2, UnsignedInt>>()
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector2<UnsignedInt>>() { return PixelFormat::RG32UI; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector<2, Int>>() { return PixelFormat::RG32I; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector2<Int>>() { return PixelFormat::RG32I; }
+template<> constexpr PixelFormat pixelFormatFor<Math::Vector<2, Half>>() { return PixelFormat::RG16F; }
+template<> constexpr PixelFormat pixelFormatFor<Math::Vector2<Half>>() { return PixelFormat::RG16F; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector<2, Float>>() { return PixelFormat::RG32F; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector2<Float>>() { return PixelFormat::RG32F; }
 
@@ -618,6 +655,9 @@ template<> constexpr PixelFormat pixelFormatFor<Math::Vector3<UnsignedInt>>() {
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector<3, Int>>() { return PixelFormat::RGB32I; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector3<Int>>() { return PixelFormat::RGB32I; }
 /* Skipping Math::Color3<Int>, as that isn't much used */
+template<> constexpr PixelFormat pixelFormatFor<Math::Vector<3, Half>>() { return PixelFormat::RGB16F; }
+template<> constexpr PixelFormat pixelFormatFor<Math::Vector3<Half>>() { return PixelFormat::RGB16F; }
+template<> constexpr PixelFormat pixelFormatFor<Math::Color3<Half>>() { return PixelFormat::RGB16F; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector<3, Float>>() { return PixelFormat::RGB32F; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector3<Float>>() { return PixelFormat::RGB32F; }
 
@@ -640,6 +680,9 @@ template<> constexpr PixelFormat pixelFormatFor<Math::Vector4<UnsignedInt>>() {
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector<4, Int>>() { return PixelFormat::RGBA32I; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector4<Int>>() { return PixelFormat::RGBA32I; }
 /* Skipping Math::Color4<Int>, as that isn't much used */
+template<> constexpr PixelFormat pixelFormatFor<Math::Vector<4, Half>>() { return PixelFormat::RGBA16F; }
+template<> constexpr PixelFormat pixelFormatFor<Math::Vector4<Half>>() { return PixelFormat::RGBA16F; }
+template<> constexpr PixelFormat pixelFormatFor<Math::Color4<Half>>() { return PixelFormat::RGBA16F; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector<4, Float>>() { return PixelFormat::RGBA32F; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector4<Float>>() { return PixelFormat::RGBA32F; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Color4<Float>>() { return PixelFormat::RGBA32F; }
@@ -25,7 +25,9 @@
 
 #include "FrameProfiler.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <sstream>
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/GrowableArray.h>
@@ -43,6 +45,38 @@
 
 namespace Magnum { namespace DebugTools {
 
+namespace {
+
+/* Log2 of HistogramSubBucketCount */
+constexpr UnsignedInt HistogramSubBucketBits = 4;
+static_assert(1u << HistogramSubBucketBits == FrameProfiler::HistogramSubBucketCount, "histogram sub-bucket bits and count don't match");
+static_assert(FrameProfiler::HistogramBucketCount == (64 - HistogramSubBucketBits + 1)*FrameProfiler::HistogramSubBucketCount, "histogram bucket count doesn't cover the whole 64-bit range");
+
+/* Math::log2() works only on 32-bit values */
+UnsignedInt log2(const UnsignedLong number) {
+    return number >> 32 ? 32 + Math::log2(UnsignedInt(number >> 32)) : Math::log2(UnsignedInt(number));
+}
+
+/* Values less than HistogramSubBucketCount have a bucket each, larger values
+   are split into HistogramSubBucketCount buckets for each power of two */
+UnsignedInt histogramBucket(const UnsignedLong value) {
+    if(value < FrameProfiler::HistogramSubBucketCount) return UnsignedInt(value);
+    const UnsignedInt shift = log2(value) - HistogramSubBucketBits;
+    return (shift + 1)*FrameProfiler::HistogramSubBucketCount + UnsignedInt((value >> shift) & (FrameProfiler::HistogramSubBucketCount - 1));
+}
+
+}
+
+std::pair<UnsignedLong, UnsignedLong> FrameProfiler::histogramBucketRange(const UnsignedInt bucket) {
+    CORRADE_ASSERT(bucket < HistogramBucketCount,
+        "DebugTools::FrameProfiler::histogramBucketRange(): index" << bucket << "out of range for" << UnsignedInt(HistogramBucketCount) << "buckets", {});
+
+    if(bucket < HistogramSubBucketCount) return {bucket, bucket};
+    const UnsignedInt shift = bucket/HistogramSubBucketCount - 1;
+    const UnsignedLong min = UnsignedLong(HistogramSubBucketCount + bucket % HistogramSubBucketCount) << shift;
+    return {min, min + ((UnsignedLong{1} << shift) - 1)};
+}
+
 FrameProfiler::Measurement::Measurement(const std::string& name, const Units units, void(*const begin)(void*), UnsignedLong(*const end)(void*), void* const state): _name{name}, _end{nullptr}, _state{state}, _units{units}, _delay{0} {
     _begin.immediate = begin;
     _query.immediate = end;
@@ -71,12 +105,16 @@ FrameProfiler::FrameProfiler(FrameProfiler&& other) noexcept:
     _maxFrameCount{other._maxFrameCount},
     _measuredFrameCount{other._measuredFrameCount},
     _measurements{std::move(other._measurements)},
-    _data{std::move(other._data)}
+    _data{std::move(other._data)},
+    _histograms{std::move(other._histograms)},
+    _sink{other._sink},
+    _sinkState{other._sinkState}
 {
     /* For all state pointers that point to &other patch them to point to this
        instead, to account for 90% of use cases of derived classes */
     for(Measurement& measurement: _measurements)
         if(measurement._state == &other) measurement._state = this;
+    if(_sinkState == &other) _sinkState = this;
 }
 
 FrameProfiler& FrameProfiler::operator=(FrameProfiler&& other) noexcept {
@@ -89,16 +127,21 @@ FrameProfiler& FrameProfiler::operator=(FrameProfiler&& other) noexcept {
     swap(_measuredFrameCount, other._measuredFrameCount);
     swap(_measurements, other._measurements);
     swap(_data, other._data);
+    swap(_histograms, other._histograms);
+    swap(_sink, other._sink);
+    swap(_sinkState, other._sinkState);
 
     /* For all state pointers that point to &other patch them to point to this
        instead, to account for 90% of use cases of derived classes */
     for(Measurement& measurement: _measurements)
         if(measurement._state == &other) measurement._state = this;
+    if(_sinkState == &other) _sinkState = this;
 
     /* And the same the other way to avoid the other instance accidentally
        affecting out measurements */
     for(Measurement& measurement: other._measurements)
         if(measurement._state == this) measurement._state = &other;
+    if(other._sinkState == this) other._sinkState = &other;
 
     return *this;
 }
@@ -109,6 +152,8 @@ void FrameProfiler::setup(Containers::Array<Measurement>&& measurements, const U
     _maxFrameCount = maxFrameCount;
     _measurements = std::move(measurements);
     arrayReserve(_data, maxFrameCount*_measurements.size());
+    /* Zero-filled in enable() below */
+    _histograms = Containers::Array<UnsignedInt>{Containers::NoInit, _measurements.size()*HistogramBucketCount};
 
     #ifndef CORRADE_NO_ASSERT
     for(const Measurement& measurement: _measurements) {
@@ -135,12 +180,15 @@ void FrameProfiler::enable() {
     #endif
     _measuredFrameCount = 0;
     arrayResize(_data, 0);
+    std::fill(_histograms.begin(), _histograms.end(), 0u);
 
-    /* Wipe out no longer relevant moving sums from all measurements, and
-       delayed measurement indices as well (tho for these it's not so
-       important) */
+    /* Wipe out no longer relevant moving sums and extremes from all
+       measurements, and delayed measurement indices as well (tho for these
+       it's not so important) */
     for(Measurement& measurement: _measurements) {
         measurement._movingSum = 0;
+        measurement._min = ~UnsignedLong{};
+        measurement._max = 0;
         measurement._current = 0;
     }
 }
@@ -226,11 +274,31 @@ void FrameProfiler::endFrame() {
         Measurement& measurement = _measurements[i];
         const UnsignedInt measurementDelay = Math::max(1u, measurement._delay);
 
-        /* If we have enough frames, add the new measurement to the moving sum.
-           For _delay of 0 or 1, delayedCurrentData(Math::max(1u, measurement._delay))
-           is equal to _currentData. */
-        if(_measuredFrameCount >= measurementDelay)
-            _measurements[i]._movingSum += _data[delayedCurrentData(measurementDelay)*_measurements.size() + i];
+        /* If we have enough frames, add the new measurement to the moving sum
+           and the histogram. For _delay of 0 or 1,
+           delayedCurrentData(Math::max(1u, measurement._delay)) is equal to
+           _currentData. */
+        if(_measuredFrameCount >= measurementDelay) {
+            const UnsignedLong value = _data[delayedCurrentData(measurementDelay)*_measurements.size() + i];
+            measurement._movingSum += value;
+            measurement._min = Math::min(measurement._min, value);
+            measurement._max = Math::max(measurement._max, value);
+            ++_histograms[i*HistogramBucketCount + histogramBucket(value)];
+        }
+    }
+
+    /* Pass the newest frame that has data for all measurements to the sink.
+       The largest delay is at most _maxFrameCount, so the slot isn't
+       overwritten by any measurement yet. */
+    if(_sink) {
+        UnsignedInt maxDelay = 1;
+        for(const Measurement& measurement: _measurements)
+            maxDelay = Math::max(maxDelay, measurement._delay);
+        if(_measuredFrameCount >= maxDelay) {
+            const UnsignedInt frame = _measuredFrameCount - maxDelay;
+            const std::size_t offset = (frame % _maxFrameCount)*_measurements.size();
+            _sink(_sinkState, *this, frame, _data.slice(offset, offset + _measurements.size()));
+        }
     }
 }
 
@@ -285,6 +353,115 @@ Double FrameProfiler::measurementMean(const UnsignedInt id) const {
     return measurementMeanInternal(_measurements[id]);
 }
 
+UnsignedLong FrameProfiler::measurementMin(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _measurements.size(),
+        "DebugTools::FrameProfiler::measurementMin(): index" << id << "out of range for" << _measurements.size() << "measurements", {});
+    CORRADE_ASSERT(_measuredFrameCount >= Math::max(_measurements[id]._delay, 1u), "DebugTools::FrameProfiler::measurementMin(): measurement data available after" << Math::max(_measurements[id]._delay, 1u) - _measuredFrameCount << "more frames", {});
+
+    return _measurements[id]._min;
+}
+
+UnsignedLong FrameProfiler::measurementMax(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _measurements.size(),
+        "DebugTools::FrameProfiler::measurementMax(): index" << id << "out of range for" << _measurements.size() << "measurements", {});
+    CORRADE_ASSERT(_measuredFrameCount >= Math::max(_measurements[id]._delay, 1u), "DebugTools::FrameProfiler::measurementMax(): measurement data available after" << Math::max(_measurements[id]._delay, 1u) - _measuredFrameCount << "more frames", {});
+
+    return _measurements[id]._max;
+}
+
+UnsignedLong FrameProfiler::measurementPercentile(const UnsignedInt id, const Double percentile) const {
+    CORRADE_ASSERT(id < _measurements.size(),
+        "DebugTools::FrameProfiler::measurementPercentile(): index" << id << "out of range for" << _measurements.size() << "measurements", {});
+    CORRADE_ASSERT(_measuredFrameCount >= Math::max(_measurements[id]._delay, 1u), "DebugTools::FrameProfiler::measurementPercentile(): measurement data available after" << Math::max(_measurements[id]._delay, 1u) - _measuredFrameCount << "more frames", {});
+    CORRADE_ASSERT(percentile >= 0.0 && percentile <= 100.0,
+        "DebugTools::FrameProfiler::measurementPercentile(): expected percentile to be in range [0, 100] but got" << percentile, {});
+
+    /* Find the first bucket where the cumulative count reaches given
+       percentile of all values. There's one value recorded for every frame
+       since the data became available. */
+    const Measurement& measurement = _measurements[id];
+    const UnsignedInt count = _measuredFrameCount - Math::max(measurement._delay, 1u) + 1;
+    const UnsignedInt target = Math::max(UnsignedInt(std::ceil(percentile*count/100.0)), 1u);
+    const UnsignedInt* const histogram = _histograms.data() + id*HistogramBucketCount;
+    UnsignedInt cumulative = 0;
+    for(UnsignedInt i = 0; i != HistogramBucketCount; ++i) {
+        cumulative += histogram[i];
+        /* The bucket upper bound can be larger than any value actually
+           measured, clamp it to make the 100th percentile exact */
+        if(cumulative >= target)
+            return Math::min(histogramBucketRange(i).second, measurement._max);
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+Containers::ArrayView<const UnsignedInt> FrameProfiler::measurementHistogram(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _measurements.size(),
+        "DebugTools::FrameProfiler::measurementHistogram(): index" << id << "out of range for" << _measurements.size() << "measurements", {});
+    return _histograms.slice(id*HistogramBucketCount, (id + 1)*HistogramBucketCount);
+}
+
+void FrameProfiler::setSink(void(*const sink)(void*, const FrameProfiler&, UnsignedInt, Containers::ArrayView<const UnsignedLong>), void* const state) {
+    _sink = sink;
+    _sinkState = state;
+}
+
+namespace {
+
+void writeCsvString(std::ostream& out, const std::string& string) {
+    out << '"';
+    for(const char c: string) {
+        if(c == '"') out << '"';
+        out << c;
+    }
+    out << '"';
+}
+
+void writeJsonString(std::ostream& out, const std::string& string) {
+    out << '"';
+    for(const char c: string) {
+        if(c == '"' || c == '\\') out << '\\' << c;
+        else if(UnsignedByte(c) < 0x20) out << Utility::formatString("\\u{:.4x}", UnsignedInt(c));
+        else out << c;
+    }
+    out << '"';
+}
+
+void csvSink(void* const state, const FrameProfiler&, const UnsignedInt frame, const Containers::ArrayView<const UnsignedLong> values) {
+    std::ostream& out = *static_cast<std::ostream*>(state);
+    out << frame;
+    for(const UnsignedLong value: values) out << ',' << value;
+    out << '\n';
+}
+
+void jsonLinesSink(void* const state, const FrameProfiler& profiler, const UnsignedInt frame, const Containers::ArrayView<const UnsignedLong> values) {
+    std::ostream& out = *static_cast<std::ostream*>(state);
+    out << "{\"frame\":" << frame;
+    for(std::size_t i = 0; i != values.size(); ++i) {
+        out << ',';
+        writeJsonString(out, profiler.measurementName(i));
+        out << ':' << values[i];
+    }
+    out << "}\n";
+}
+
+}
+
+void FrameProfiler::setSink(std::ostream& out, const SinkFormat format) {
+    if(format == SinkFormat::Csv) {
+        out << "frame";
+        for(const Measurement& measurement: _measurements) {
+            out << ',';
+            writeCsvString(out, measurement._name);
+        }
+        out << '\n';
+
+        setSink(csvSink, &out);
+    } else if(format == SinkFormat::JsonLines) {
+        setSink(jsonLinesSink, &out);
+    } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
 namespace {
 
 /* Based on Corrade/TestSuite/Implementation/BenchmarkStats.h */
@@ -428,6 +605,21 @@ Debug& operator<<(Debug& debug, const FrameProfiler::Units value) {
     return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
 }
 
+Debug& operator<<(Debug& debug, const FrameProfiler::SinkFormat value) {
+    debug << "DebugTools::FrameProfiler::SinkFormat" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case FrameProfiler::SinkFormat::v: return debug << "::" #v;
+        _c(Csv)
+        _c(JsonLines)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
 #ifdef MAGNUM_TARGET_GL
 struct GLFrameProfiler::State {
     UnsignedShort cpuDurationIndex = 0xffff,
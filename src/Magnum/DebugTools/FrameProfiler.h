@@ -30,7 +30,9 @@
  * @m_since{2020,06}
  */
 
+#include <iosfwd>
 #include <string>
+#include <utility>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Pointer.h>
 
@@ -82,6 +84,36 @@ And here's a sample output on the terminal --- using a fully configured
 
 @include debugtools-frameprofiler.ansi
 
+@section DebugTools-FrameProfiler-histograms Percentiles and histograms
+
+The moving average hides occasional hitches. For these, each measurement
+additionally records all its values since the last @ref enable() or
+@ref setup() into a histogram of a fixed size, which is then queried using
+@ref measurementPercentile(), @ref measurementMin() and
+@ref measurementMax():
+
+@snippet MagnumDebugTools.cpp FrameProfiler-percentiles
+
+The histogram has a logarithmic bucket distribution with
+@ref HistogramSubBucketCount linear sub-buckets per power of two. Values less
+than @ref HistogramSubBucketCount are recorded exactly, larger values with a
+relative error of at most @cpp 1.0/HistogramSubBucketCount @ce. The memory
+used is @ref HistogramBucketCount 32-bit counters per measurement,
+independently of how many frames got measured. The raw histogram data is
+available through @ref measurementHistogram() and
+@ref histogramBucketRange().
+
+@section DebugTools-FrameProfiler-sink Exporting per-frame data
+
+To process the data in external tools, a sink function can be set with
+@ref setSink(). It gets called with values of all measurements once given
+frame is available for all of them, i.e. with a delay equal to the largest
+@ref measurementDelay(). For the common cases there's a builtin sink writing
+CSV or [JSON Lines](https://jsonlines.org/) to a @ref std::ostream, see
+@ref SinkFormat for details:
+
+@snippet MagnumDebugTools.cpp FrameProfiler-sink
+
 @section DebugTools-FrameProfiler-setup Setting up measurements
 
 Unless you're using this class through @ref GLFrameProfiler, measurements
@@ -163,8 +195,59 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
             PercentageThousandths
         };
 
+        /**
+         * @brief Builtin sink format
+         * @m_since_latest
+         *
+         * @see @ref setSink(std::ostream&, SinkFormat)
+         */
+        enum class SinkFormat: UnsignedByte {
+            /**
+             * Comma-separated values. A header line with a `frame` column and
+             * then measurement names in double quotes is written in
+             * @ref setSink(), each frame is then a line with a frame index
+             * followed by raw measurement values.
+             */
+            Csv,
+
+            /**
+             * [JSON Lines](https://jsonlines.org/). Each frame is written as
+             * a single-line JSON object with a `frame` key containing the
+             * frame index and then measurement names as keys and raw
+             * measurement values as values.
+             */
+            JsonLines
+        };
+
+        enum: UnsignedInt {
+            /**
+             * Count of linear sub-buckets per power of two in the histogram.
+             * Defines the precision of @ref measurementPercentile().
+             * @m_since_latest
+             */
+            HistogramSubBucketCount = 16,
+
+            /**
+             * Count of buckets in the histogram of each measurement.
+             * @m_since_latest
+             * @see @ref measurementHistogram()
+             */
+            HistogramBucketCount = HistogramSubBucketCount*61
+        };
+
         class Measurement;
 
+        /**
+         * @brief Value range of a histogram bucket
+         * @m_since_latest
+         *
+         * Returns the smallest and largest value that is recorded into
+         * @p bucket, inclusive. Expects that @p bucket is less than
+         * @ref HistogramBucketCount.
+         * @see @ref measurementHistogram()
+         */
+        static std::pair<UnsignedLong, UnsignedLong> histogramBucketRange(UnsignedInt bucket);
+
         /**
          * @brief Default constructor
          *
@@ -203,7 +286,8 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
          *
          * Calling @ref setup() on an already set up profiler will replace
          * existing measurements with @p measurements and reset
-         * @ref measuredFrameCount() back to @cpp 0 @ce.
+         * @ref measuredFrameCount() back to @cpp 0 @ce. A sink set with
+         * @ref setSink() is kept.
          */
         void setup(Containers::Array<Measurement>&& measurements, UnsignedInt maxFrameCount);
 
@@ -217,9 +301,10 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
          * @brief Enable the profiler
          *
          * The profiler is enabled implicitly after construction. When this
-         * function is called, it discards all measured data, effectively
-         * making @ref measuredFrameCount() zero. If you want to reset the
-         * profiler to measure different values as well, call @ref setup().
+         * function is called, it discards all measured data including the
+         * histograms, effectively making @ref measuredFrameCount() zero. If
+         * you want to reset the profiler to measure different values as
+         * well, call @ref setup().
          */
         void enable();
 
@@ -351,6 +436,101 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
          */
         Double measurementMean(UnsignedInt id) const;
 
+        /**
+         * @brief Measurement minimum
+         * @m_since_latest
+         *
+         * Smallest value of all measured since the last @ref enable() or
+         * @ref setup(), not just the last @ref maxFrameCount() frames. The
+         * @p id corresponds to the index of the measurement in the list
+         * passed to @ref setup(). Expects that @p id is less than
+         * @ref measurementCount() and that the measurement is available.
+         * @see @ref isMeasurementAvailable(), @ref measurementMax(),
+         *      @ref measurementPercentile()
+         */
+        UnsignedLong measurementMin(UnsignedInt id) const;
+
+        /**
+         * @brief Measurement maximum
+         * @m_since_latest
+         *
+         * Largest value of all measured since the last @ref enable() or
+         * @ref setup(), not just the last @ref maxFrameCount() frames. The
+         * @p id corresponds to the index of the measurement in the list
+         * passed to @ref setup(). Expects that @p id is less than
+         * @ref measurementCount() and that the measurement is available.
+         * @see @ref isMeasurementAvailable(), @ref measurementMin(),
+         *      @ref measurementPercentile()
+         */
+        UnsignedLong measurementMax(UnsignedInt id) const;
+
+        /**
+         * @brief Measurement percentile
+         * @m_since_latest
+         *
+         * Returns a value that at least @p percentile percent of all values
+         * measured since the last @ref enable() or @ref setup() is less than
+         * or equal to, calculated from the measurement histogram. Values less
+         * than @ref HistogramSubBucketCount are exact, larger values have a
+         * relative error of at most @cpp 1.0/HistogramSubBucketCount @ce.
+         * A @p percentile of @cpp 100.0 @ce returns the same value as
+         * @ref measurementMax().
+         *
+         * The @p id corresponds to the index of the measurement in the list
+         * passed to @ref setup(). Expects that @p id is less than
+         * @ref measurementCount(), that the measurement is available and
+         * that @p percentile is in the @f$ [0, 100] @f$ range.
+         * @see @ref isMeasurementAvailable(), @ref measurementHistogram()
+         */
+        UnsignedLong measurementPercentile(UnsignedInt id, Double percentile) const;
+
+        /**
+         * @brief Measurement histogram
+         * @m_since_latest
+         *
+         * Count of values measured since the last @ref enable() or
+         * @ref setup() that fall into each bucket, the view has
+         * @ref HistogramBucketCount items. Use @ref histogramBucketRange()
+         * to get the value range of a particular bucket. The @p id
+         * corresponds to the index of the measurement in the list passed to
+         * @ref setup(). Expects that @p id is less than
+         * @ref measurementCount().
+         */
+        Containers::ArrayView<const UnsignedInt> measurementHistogram(UnsignedInt id) const;
+
+        /**
+         * @brief Set a sink for per-frame data
+         * @param sink      Function to call for each frame with data
+         *      available for all measurements, or @cpp nullptr @ce to reset
+         *      the sink
+         * @param state     State pointer passed to @p sink as a first
+         *      argument
+         * @m_since_latest
+         *
+         * Second argument of @p sink is the profiler itself, third is the
+         * frame index counted from the last @ref enable() or @ref setup()
+         * and the fourth is a view of values of all measurements for that
+         * frame, in the order they were passed to @ref setup(). The function
+         * is called from @ref endFrame() once the frame data are available
+         * for all measurements, i.e. with a delay equal to the largest
+         * @ref measurementDelay(). Same as with @ref Measurement, if
+         * @p state is the profiler instance, it's patched on a move.
+         * @see @ref DebugTools-FrameProfiler-sink
+         */
+        void setSink(void(*sink)(void*, const FrameProfiler&, UnsignedInt, Containers::ArrayView<const UnsignedLong>), void* state);
+
+        /**
+         * @brief Set a builtin sink writing to a stream
+         * @m_since_latest
+         *
+         * Writes per-frame data to @p out in given @p format. In case of
+         * @ref SinkFormat::Csv, the header line is written directly in this
+         * function, so the profiler is expected to be set up already. The
+         * @p out is expected to stay in scope for as long as the sink is
+         * used.
+         */
+        void setSink(std::ostream& out, SinkFormat format);
+
         /**
          * @brief Overview of all measurements
          *
@@ -404,6 +584,9 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
         UnsignedInt _maxFrameCount{1}, _measuredFrameCount{};
         Containers::Array<Measurement> _measurements;
         Containers::Array<UnsignedLong> _data;
+        Containers::Array<UnsignedInt> _histograms;
+        void(*_sink)(void*, const FrameProfiler&, UnsignedInt, Containers::ArrayView<const UnsignedLong>){};
+        void* _sinkState{};
 };
 
 /**
@@ -482,6 +665,7 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler::Measurement {
 
         UnsignedInt _current{};
         UnsignedLong _movingSum{};
+        UnsignedLong _min{~UnsignedLong{}}, _max{};
 };
 
 /**
@@ -490,6 +674,12 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler::Measurement {
 */
 MAGNUM_DEBUGTOOLS_EXPORT Debug& operator<<(Debug& debug, FrameProfiler::Units value);
 
+/**
+@debugoperatorclassenum{FrameProfiler,FrameProfiler::SinkFormat}
+@m_since_latest
+*/
+MAGNUM_DEBUGTOOLS_EXPORT Debug& operator<<(Debug& debug, FrameProfiler::SinkFormat value);
+
 #ifdef MAGNUM_TARGET_GL
 /**
 @brief OpenGL frame profiler
@@ -42,6 +42,7 @@
 #include "Magnum/DebugTools/CompareImage.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/Half.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/AbstractImporter.h"
 
@@ -53,13 +54,15 @@ struct CompareImageTest: TestSuite::Tester {
     explicit CompareImageTest();
 
     void formatUnknown();
-    void formatHalf();
     void formatImplementationSpecific();
 
     void calculateDelta();
     void calculateDeltaStorage();
+    void calculateDeltaRgba8();
+    void calculateDeltaHalf();
     void calculateDeltaSpecials();
     void calculateDeltaSpecials3();
+    void calculateDeltaThreads();
 
     void deltaImage();
     void deltaImageScaling();
@@ -117,6 +120,16 @@ struct CompareImageTest: TestSuite::Tester {
     void pixelsToFileNonZeroDelta();
     void pixelsToFileError();
 
+    void withinThresholds();
+    void withinThresholdsDifferentSize();
+    void withinThresholdsDifferentFormat();
+    void withinThresholdsThreads();
+    void withinThresholdsDisallowedThreshold();
+
+    void benchmarkDelta();
+    void benchmarkDeltaThreads();
+    void benchmarkWithinThresholds();
+
     private:
         Containers::Optional<PluginManager::Manager<Trade::AbstractImporter>> _importerManager;
         Containers::Optional<PluginManager::Manager<Trade::AbstractImageConverter>> _converterManager;
@@ -124,13 +137,15 @@ struct CompareImageTest: TestSuite::Tester {
 
 CompareImageTest::CompareImageTest() {
     addTests({&CompareImageTest::formatUnknown,
-              &CompareImageTest::formatHalf,
               &CompareImageTest::formatImplementationSpecific,
 
               &CompareImageTest::calculateDelta,
               &CompareImageTest::calculateDeltaStorage,
+              &CompareImageTest::calculateDeltaRgba8,
+              &CompareImageTest::calculateDeltaHalf,
               &CompareImageTest::calculateDeltaSpecials,
               &CompareImageTest::calculateDeltaSpecials3,
+              &CompareImageTest::calculateDeltaThreads,
 
               &CompareImageTest::deltaImage,
               &CompareImageTest::deltaImageScaling,
@@ -212,6 +227,16 @@ CompareImageTest::CompareImageTest() {
         &CompareImageTest::setupExternalPluginManager,
         &CompareImageTest::teardownExternalPluginManager);
 
+    addTests({&CompareImageTest::withinThresholds,
+              &CompareImageTest::withinThresholdsDifferentSize,
+              &CompareImageTest::withinThresholdsDifferentFormat,
+              &CompareImageTest::withinThresholdsThreads,
+              &CompareImageTest::withinThresholdsDisallowedThreshold});
+
+    addBenchmarks({&CompareImageTest::benchmarkDelta,
+                   &CompareImageTest::benchmarkDeltaThreads,
+                   &CompareImageTest::benchmarkWithinThresholds}, 10);
+
     /* Plugin manager setup is not done here, but in the
        setupExternalPluginManager() function */
 }
@@ -251,20 +276,6 @@ void CompareImageTest::formatUnknown() {
     CORRADE_COMPARE(out.str(), "DebugTools::CompareImage: unknown format PixelFormat(0xdead)\n");
 }
 
-void CompareImageTest::formatHalf() {
-    #ifdef CORRADE_NO_ASSERT
-    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
-    #endif
-
-    std::ostringstream out;
-    Error redirectError{&out};
-
-    ImageView2D image{PixelFormat::RG16F, {}};
-    Implementation::calculateImageDelta(image.format(), image.pixels(), image);
-
-    CORRADE_COMPARE(out.str(), "DebugTools::CompareImage: half-float formats are not supported yet\n");
-}
-
 void CompareImageTest::formatImplementationSpecific() {
     #ifdef CORRADE_NO_ASSERT
     CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
@@ -320,6 +331,62 @@ void CompareImageTest::calculateDeltaStorage() {
     CORRADE_COMPARE(mean, 18.5f);
 }
 
+void CompareImageTest::calculateDeltaRgba8() {
+    using namespace Math::Literals;
+
+    /* Five pixels in order to test both the four-at-a-time and the remaining
+       pixel path, expected rows are padded */
+    const Color4ub actualData[]{
+        0x000000ff_rgba, 0x10203040_rgba, 0xffffffff_rgba, 0x80808080_rgba, 0x01020304_rgba,
+        0xff000000_rgba, 0x00ff0000_rgba, 0x0000ff00_rgba, 0x000000ff_rgba, 0x00000000_rgba
+    };
+    const Color4ub expectedData[]{
+        0x000000ff_rgba, 0x20103040_rgba, 0x00000000_rgba, 0x7f817f81_rgba, 0x04030201_rgba, {},
+        0xff000000_rgba, 0x00000000_rgba, 0x0000ff00_rgba, 0x000000ff_rgba, 0xff00ff00_rgba, {}
+    };
+    const ImageView2D actual{PixelFormat::RGBA8Unorm, {5, 2}, actualData};
+    const ImageView2D expected{PixelStorage{}.setRowLength(6),
+        PixelFormat::RGBA8Unorm, {5, 2}, expectedData};
+
+    Containers::Array<Float> delta;
+    Float max, mean;
+    std::tie(delta, max, mean) = Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected);
+    CORRADE_COMPARE_AS(delta, (Containers::Array<Float>{Containers::InPlaceInit, {
+        0.0f, 32.0f/4.0f, 255.0f, 1.0f, 8.0f/4.0f,
+        0.0f, 255.0f/4.0f, 0.0f, 0.0f, 510.0f/4.0f
+    }}), TestSuite::Compare::Container);
+    CORRADE_COMPARE(max, 255.0f);
+    CORRADE_COMPARE(mean, 45.725f);
+}
+
+void CompareImageTest::calculateDeltaHalf() {
+    using namespace Math::Literals;
+
+    const Half nan{Constants::nan()};
+    const Half inf{Constants::inf()};
+    const Half minusInf{-Constants::inf()};
+    const Vector2h actualData[]{
+        {0.5_h, 1.0_h}, {0.25_h, -1.0_h},
+        {nan, nan}, {inf, inf}
+    };
+    const Vector2h expectedData[]{
+        {0.5_h, 0.0_h}, {0.75_h, -1.5_h},
+        {nan, nan}, {inf, minusInf}
+    };
+    const ImageView2D actual{PixelFormat::RG16F, {2, 2}, actualData};
+    const ImageView2D expected{PixelFormat::RG16F, {2, 2}, expectedData};
+
+    Containers::Array<Float> delta;
+    Float max, mean;
+    std::tie(delta, max, mean) = Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected);
+    CORRADE_COMPARE_AS(delta, (Containers::Array<Float>{Containers::InPlaceInit, {
+        0.5f, 0.5f,
+        0.0f, Constants::inf()
+    }}), TestSuite::Compare::Container);
+    CORRADE_COMPARE(max, 0.5f);
+    CORRADE_COMPARE(mean, Constants::inf());
+}
+
 /* Variants:
     -   expected number, got inf (and inverse)
     -   expected number, got nan (and inverse)
@@ -386,6 +453,30 @@ void CompareImageTest::calculateDeltaSpecials3() {
     CORRADE_COMPARE(mean, -Constants::nan());
 }
 
+void CompareImageTest::calculateDeltaThreads() {
+    /* Large enough to be split across several threads */
+    Containers::Array<Color4ub> actualData{Containers::NoInit, 640*480};
+    Containers::Array<Color4ub> expectedData{Containers::NoInit, 640*480};
+    for(std::size_t i = 0; i != actualData.size(); ++i) {
+        actualData[i] = Color4ub{UnsignedByte(i*7), UnsignedByte(i*13), UnsignedByte(i), 0xff};
+        expectedData[i] = Color4ub{UnsignedByte((i*7)^(i & 1)), UnsignedByte((i*13)^(i & 2)), UnsignedByte(i), 0xff};
+    }
+    const ImageView2D actual{PixelFormat::RGBA8Unorm, {640, 480}, actualData};
+    const ImageView2D expected{PixelFormat::RGBA8Unorm, {640, 480}, expectedData};
+
+    Containers::Array<Float> delta, deltaThreaded;
+    Float max, maxThreaded, mean, meanThreaded;
+    std::tie(delta, max, mean) = Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected, 1);
+    std::tie(deltaThreaded, maxThreaded, meanThreaded) = Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected, 4);
+
+    /* The result should be exactly the same regardless of the thread count */
+    CORRADE_COMPARE_AS(deltaThreaded, delta, TestSuite::Compare::Container);
+    CORRADE_COMPARE(maxThreaded, max);
+    CORRADE_COMPARE(meanThreaded, mean);
+    CORRADE_COMPARE(max, 3.0f/4.0f);
+    CORRADE_COMPARE(mean, 1.5f/4.0f);
+}
+
 void CompareImageTest::deltaImage() {
     std::ostringstream out;
     Debug d{&out, Debug::Flag::DisableColors};
@@ -1648,6 +1739,114 @@ void CompareImageTest::pixelsToFileError() {
         Utility::Directory::join(DEBUGTOOLS_TEST_DIR, "CompareImageActual.tga"), TestSuite::Compare::File);
 }
 
+void CompareImageTest::withinThresholds() {
+    /* Max delta is 39, mean 18.5, same as in compareAboveThresholds() etc. */
+    CORRADE_VERIFY(isImageWithinThresholds(ActualRgb, ExpectedRgb, 40.0f, 20.0f));
+    CORRADE_VERIFY(!isImageWithinThresholds(ActualRgb, ExpectedRgb, 30.0f, 20.0f));
+    CORRADE_VERIFY(!isImageWithinThresholds(ActualRgb, ExpectedRgb, 50.0f, 18.0f));
+    CORRADE_VERIFY(isImageWithinThresholds(ActualRgb, ActualRgb, 0.0f, 0.0f));
+
+    /* Specials "poison" the mean, failing the comparison */
+    CORRADE_VERIFY(!isImageWithinThresholds(ActualSpecials, ExpectedSpecials, 10.0f, 5.0f));
+}
+
+void CompareImageTest::withinThresholdsDifferentSize() {
+    const ImageView2D actual{PixelFormat::RGB8Unorm, {2, 1}, ActualRgbData};
+    CORRADE_VERIFY(!isImageWithinThresholds(actual, ExpectedRgb, 255.0f, 255.0f));
+}
+
+void CompareImageTest::withinThresholdsDifferentFormat() {
+    const ImageView2D actual{PixelFormat::R32UI, {3, 3}, ActualRedData};
+    CORRADE_VERIFY(!isImageWithinThresholds(actual, ExpectedRed, 1.0e9f, 1.0e9f));
+}
+
+void CompareImageTest::withinThresholdsThreads() {
+    /* Large enough to be split across several threads, with a single outlier
+       in the last row */
+    Containers::Array<Float> actualData{Containers::ValueInit, 640*480};
+    Containers::Array<Float> expectedData{Containers::ValueInit, 640*480};
+    for(std::size_t i = 0; i != actualData.size(); ++i) {
+        actualData[i] = Float(i%17)*0.125f;
+        expectedData[i] = Float(i%17)*0.125f;
+    }
+    expectedData[640*479 + 3] += 2.0f;
+    const ImageView2D actual{PixelFormat::R32F, {640, 480}, actualData};
+    const ImageView2D expected{PixelFormat::R32F, {640, 480}, expectedData};
+
+    for(std::size_t threadCount: {1, 4}) {
+        CORRADE_ITERATION(threadCount);
+        CORRADE_VERIFY(isImageWithinThresholds(actual, expected, 2.0f, 0.001f, threadCount));
+        CORRADE_VERIFY(!isImageWithinThresholds(actual, expected, 1.5f, 0.001f, threadCount));
+        CORRADE_VERIFY(!isImageWithinThresholds(actual, expected, 2.0f, 0.0f, threadCount));
+    }
+}
+
+void CompareImageTest::withinThresholdsDisallowedThreshold() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    isImageWithinThresholds(ActualRed, ExpectedRed, Constants::inf(), 0.3f);
+    isImageWithinThresholds(ActualRed, ExpectedRed, 0.3f, Constants::nan());
+    isImageWithinThresholds(ActualRed, ExpectedRed, 0.3f, 0.5f);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::isImageWithinThresholds(): thresholds can't be NaN or infinity\n"
+        "DebugTools::isImageWithinThresholds(): thresholds can't be NaN or infinity\n"
+        "DebugTools::isImageWithinThresholds(): maxThreshold can't be smaller than meanThreshold\n");
+}
+
+namespace {
+
+Containers::Array<Color4ub> benchmarkData(const UnsignedByte offset) {
+    Containers::Array<Color4ub> data{Containers::NoInit, 1920*1080};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = Color4ub{UnsignedByte(i), UnsignedByte(i*3), UnsignedByte(UnsignedByte(i*7)^offset), 0xff};
+    return data;
+}
+
+}
+
+void CompareImageTest::benchmarkDelta() {
+    Containers::Array<Color4ub> actualData = benchmarkData(0);
+    Containers::Array<Color4ub> expectedData = benchmarkData(1);
+    const ImageView2D actual{PixelFormat::RGBA8Unorm, {1920, 1080}, actualData};
+    const ImageView2D expected{PixelFormat::RGBA8Unorm, {1920, 1080}, expectedData};
+
+    Float max{};
+    CORRADE_BENCHMARK(1)
+        max += std::get<1>(Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected, 1));
+
+    CORRADE_COMPARE(max, 1.0f/4.0f);
+}
+
+void CompareImageTest::benchmarkDeltaThreads() {
+    Containers::Array<Color4ub> actualData = benchmarkData(0);
+    Containers::Array<Color4ub> expectedData = benchmarkData(1);
+    const ImageView2D actual{PixelFormat::RGBA8Unorm, {1920, 1080}, actualData};
+    const ImageView2D expected{PixelFormat::RGBA8Unorm, {1920, 1080}, expectedData};
+
+    Float max{};
+    CORRADE_BENCHMARK(1)
+        max += std::get<1>(Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected, 0));
+
+    CORRADE_COMPARE(max, 1.0f/4.0f);
+}
+
+void CompareImageTest::benchmarkWithinThresholds() {
+    Containers::Array<Color4ub> actualData = benchmarkData(0);
+    Containers::Array<Color4ub> expectedData = benchmarkData(0);
+    const ImageView2D actual{PixelFormat::RGBA8Unorm, {1920, 1080}, actualData};
+    const ImageView2D expected{PixelFormat::RGBA8Unorm, {1920, 1080}, expectedData};
+
+    bool within = true;
+    CORRADE_BENCHMARK(1)
+        within = within && isImageWithinThresholds(actual, expected, 0.0f, 0.0f, 0);
+
+    CORRADE_VERIFY(within);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::DebugTools::Test::CompareImageTest)
@@ -24,8 +24,10 @@
 */
 
 #include <sstream>
+#include <vector>
 #include <Corrade/Containers/Pointer.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
@@ -47,6 +49,16 @@ struct FrameProfilerTest: TestSuite::Tester {
     void enableDisable();
     void reSetup();
 
+    void histogramBucketRange();
+    void percentiles();
+    void percentilesDelayed();
+    void percentilesEnable();
+
+    void sink();
+    void sinkMove();
+    void sinkCsv();
+    void sinkJsonLines();
+
     void copy();
     void move();
 
@@ -58,6 +70,9 @@ struct FrameProfilerTest: TestSuite::Tester {
     void frameOutOfBounds();
     void dataNotAvailableYet();
     void meanNotAvailableYet();
+    void percentileNotAvailableYet();
+    void percentileOutOfRange();
+    void histogramBucketOutOfRange();
 
     void statistics();
 
@@ -67,6 +82,7 @@ struct FrameProfilerTest: TestSuite::Tester {
     #endif
 
     void debugUnits();
+    void debugSinkFormat();
     #ifdef MAGNUM_TARGET_GL
     void debugGLValue();
     void debugGLValues();
@@ -121,6 +137,16 @@ FrameProfilerTest::FrameProfilerTest() {
     addTests({&FrameProfilerTest::enableDisable,
               &FrameProfilerTest::reSetup,
 
+              &FrameProfilerTest::histogramBucketRange,
+              &FrameProfilerTest::percentiles,
+              &FrameProfilerTest::percentilesDelayed,
+              &FrameProfilerTest::percentilesEnable,
+
+              &FrameProfilerTest::sink,
+              &FrameProfilerTest::sinkMove,
+              &FrameProfilerTest::sinkCsv,
+              &FrameProfilerTest::sinkJsonLines,
+
               &FrameProfilerTest::copy,
               &FrameProfilerTest::move,
 
@@ -132,6 +158,9 @@ FrameProfilerTest::FrameProfilerTest() {
               &FrameProfilerTest::frameOutOfBounds,
               &FrameProfilerTest::dataNotAvailableYet,
               &FrameProfilerTest::meanNotAvailableYet,
+              &FrameProfilerTest::percentileNotAvailableYet,
+              &FrameProfilerTest::percentileOutOfRange,
+              &FrameProfilerTest::histogramBucketOutOfRange,
 
               &FrameProfilerTest::statistics});
 
@@ -146,6 +175,7 @@ FrameProfilerTest::FrameProfilerTest() {
               #endif
 
               &FrameProfilerTest::debugUnits,
+              &FrameProfilerTest::debugSinkFormat,
               #ifdef MAGNUM_TARGET_GL
               &FrameProfilerTest::debugGLValue,
               &FrameProfilerTest::debugGLValues,
@@ -670,6 +700,294 @@ void FrameProfilerTest::reSetup() {
     profiler.endFrame();
 }
 
+void FrameProfilerTest::histogramBucketRange() {
+    /* Values below sub-bucket count are exact */
+    CORRADE_COMPARE(FrameProfiler::histogramBucketRange(0).first, 0ull);
+    CORRADE_COMPARE(FrameProfiler::histogramBucketRange(0).second, 0ull);
+    CORRADE_COMPARE(FrameProfiler::histogramBucketRange(15).first, 15ull);
+    CORRADE_COMPARE(FrameProfiler::histogramBucketRange(15).second, 15ull);
+
+    /* The first power of two above still has a bucket for each value */
+    CORRADE_COMPARE(FrameProfiler::histogramBucketRange(16).first, 16ull);
+    CORRADE_COMPARE(FrameProfiler::histogramBucketRange(16).second, 16ull);
+    CORRADE_COMPARE(FrameProfiler::histogramBucketRange(31).first, 31ull);
+    CORRADE_COMPARE(FrameProfiler::histogramBucketRange(31).second, 31ull);
+
+    /* Then each bucket is twice as large for each next power of two */
+    CORRADE_COMPARE(FrameProfiler::histogramBucketRange(32).first, 32ull);
+    CORRADE_COMPARE(FrameProfiler::histogramBucketRange(32).second, 33ull);
+    CORRADE_COMPARE(FrameProfiler::histogramBucketRange(47).first, 62ull);
+    CORRADE_COMPARE(FrameProfiler::histogramBucketRange(47).second, 63ull);
+    CORRADE_COMPARE(FrameProfiler::histogramBucketRange(48).first, 64ull);
+    CORRADE_COMPARE(FrameProfiler::histogramBucketRange(48).second, 67ull);
+
+    /* The last bucket ends at the largest representable value */
+    CORRADE_COMPARE(FrameProfiler::histogramBucketRange(FrameProfiler::HistogramBucketCount - 1).first, 0xf800000000000000ull);
+    CORRADE_COMPARE(FrameProfiler::histogramBucketRange(FrameProfiler::HistogramBucketCount - 1).second, 0xffffffffffffffffull);
+}
+
+void FrameProfilerTest::percentiles() {
+    /* Returns 1, 2, 3, ... 100 */
+    UnsignedLong value = 0;
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"", FrameProfiler::Units::Count,
+            [](void*) {},
+            [](void* state) {
+                return ++*static_cast<UnsignedLong*>(state);
+            }, &value}
+    }, 5};
+
+    for(std::size_t i = 0; i != 100; ++i) {
+        profiler.beginFrame();
+        profiler.endFrame();
+    }
+
+    /* The mean is still over the last five frames only, but the histogram
+       covers all of them */
+    CORRADE_COMPARE(profiler.measurementMean(0), 98.0);
+    CORRADE_COMPARE(profiler.measurementMin(0), 1);
+    CORRADE_COMPARE(profiler.measurementMax(0), 100);
+
+    Containers::ArrayView<const UnsignedInt> histogram = profiler.measurementHistogram(0);
+    CORRADE_COMPARE(histogram.size(), std::size_t(FrameProfiler::HistogramBucketCount));
+    CORRADE_COMPARE(histogram[0], 0);
+    CORRADE_COMPARE(histogram[1], 1);
+    CORRADE_COMPARE(histogram[31], 1);
+    /* 32 and 33 */
+    CORRADE_COMPARE(histogram[32], 2);
+    UnsignedInt sum = 0;
+    for(UnsignedInt i: histogram) sum += i;
+    CORRADE_COMPARE(sum, 100);
+
+    /* Small values are exact */
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 0.0), 1);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 10.0), 10);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 31.0), 31);
+    /* 50 is in a [50, 51] bucket, 95 in [92, 95], 99 in [96, 99] */
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 50.0), 51);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 95.0), 95);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 99.0), 99);
+    /* 100 is in a [100, 103] bucket, but is clamped to the max */
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 100.0), 100);
+}
+
+void FrameProfilerTest::percentilesDelayed() {
+    UnsignedLong value = 0;
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"", FrameProfiler::Units::Count, 3,
+            [](void*, UnsignedInt) {},
+            [](void*, UnsignedInt) {},
+            [](void* state, UnsignedInt, UnsignedInt) {
+                return (*static_cast<UnsignedLong*>(state) += 1000);
+            }, &value}
+    }, 3};
+
+    profiler.beginFrame();
+    profiler.endFrame();
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_VERIFY(!profiler.isMeasurementAvailable(0));
+
+    UnsignedInt sum = 0;
+    for(UnsignedInt i: profiler.measurementHistogram(0)) sum += i;
+    CORRADE_COMPARE(sum, 0);
+
+    profiler.beginFrame();
+    profiler.endFrame();
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_VERIFY(profiler.isMeasurementAvailable(0));
+
+    /* Only two values were retrieved so far */
+    for(UnsignedInt i: profiler.measurementHistogram(0)) sum += i;
+    CORRADE_COMPARE(sum, 2);
+    CORRADE_COMPARE(profiler.measurementMin(0), 1000);
+    CORRADE_COMPARE(profiler.measurementMax(0), 2000);
+    /* 1000 is in a [992, 1023] bucket */
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 50.0), 1023);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 100.0), 2000);
+}
+
+void FrameProfilerTest::percentilesEnable() {
+    UnsignedLong value = 0;
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"", FrameProfiler::Units::Count,
+            [](void*) {},
+            [](void* state) {
+                return ++*static_cast<UnsignedLong*>(state);
+            }, &value}
+    }, 5};
+
+    profiler.beginFrame();
+    profiler.endFrame();
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_COMPARE(profiler.measurementMin(0), 1);
+    CORRADE_COMPARE(profiler.measurementMax(0), 2);
+
+    /* Re-enabling discards the histogram and extremes as well */
+    profiler.enable();
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_COMPARE(profiler.measurementMin(0), 3);
+    CORRADE_COMPARE(profiler.measurementMax(0), 3);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 0.0), 3);
+
+    UnsignedInt sum = 0;
+    for(UnsignedInt i: profiler.measurementHistogram(0)) sum += i;
+    CORRADE_COMPARE(sum, 1);
+}
+
+struct SinkState {
+    std::vector<UnsignedInt> frames;
+    std::vector<UnsignedLong> values;
+};
+
+void FrameProfilerTest::sink() {
+    UnsignedLong immediate = 0, delayed = 100;
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"", FrameProfiler::Units::Count,
+            [](void*) {},
+            [](void* state) {
+                return ++*static_cast<UnsignedLong*>(state);
+            }, &immediate},
+        FrameProfiler::Measurement{"", FrameProfiler::Units::Count, 2,
+            [](void*, UnsignedInt) {},
+            [](void*, UnsignedInt) {},
+            [](void* state, UnsignedInt, UnsignedInt) {
+                return ++*static_cast<UnsignedLong*>(state);
+            }, &delayed}
+    }, 3};
+
+    SinkState state;
+    profiler.setSink([](void* state, const FrameProfiler& profiler, UnsignedInt frame, Containers::ArrayView<const UnsignedLong> values) {
+        auto& s = *static_cast<SinkState*>(state);
+        CORRADE_COMPARE(values.size(), profiler.measurementCount());
+        s.frames.push_back(frame);
+        s.values.insert(s.values.end(), values.begin(), values.end());
+    }, &state);
+
+    /* The first frame is available for all measurements only after the
+       second endFrame() */
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_VERIFY(state.frames.empty());
+
+    for(std::size_t i = 0; i != 4; ++i) {
+        profiler.beginFrame();
+        profiler.endFrame();
+    }
+
+    CORRADE_COMPARE_AS(state.frames,
+        (std::vector<UnsignedInt>{0, 1, 2, 3}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(state.values,
+        (std::vector<UnsignedLong>{1, 101, 2, 102, 3, 103, 4, 104}),
+        TestSuite::Compare::Container);
+
+    /* Resetting the sink stops the output */
+    profiler.setSink(nullptr, nullptr);
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_COMPARE(state.frames.size(), 4);
+
+    /* Frame numbering starts from 0 again after enabling */
+    profiler.setSink([](void* state, const FrameProfiler&, UnsignedInt frame, Containers::ArrayView<const UnsignedLong>) {
+        static_cast<SinkState*>(state)->frames.push_back(frame);
+    }, &state);
+    profiler.enable();
+    profiler.beginFrame();
+    profiler.endFrame();
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_COMPARE_AS(state.frames,
+        (std::vector<UnsignedInt>{0, 1, 2, 3, 0}),
+        TestSuite::Compare::Container);
+}
+
+void FrameProfilerTest::sinkMove() {
+    /* A state pointer pointing to the profiler itself should get patched on
+       move */
+    struct MyProfiler: FrameProfiler {
+        UnsignedInt calls = 0;
+    } a;
+    a.setup({
+        FrameProfiler::Measurement{"", FrameProfiler::Units::Count,
+            [](void*) {},
+            [](void*) { return UnsignedLong{}; }, nullptr}
+    }, 2);
+    a.setSink([](void* state, const FrameProfiler& profiler, UnsignedInt, Containers::ArrayView<const UnsignedLong>) {
+        CORRADE_VERIFY(state == &profiler);
+        ++static_cast<MyProfiler*>(state)->calls;
+    }, &a);
+
+    MyProfiler b{std::move(a)};
+    b.beginFrame();
+    b.endFrame();
+    CORRADE_COMPARE(a.calls, 0);
+    CORRADE_COMPARE(b.calls, 1);
+
+    MyProfiler c;
+    c = std::move(b);
+    c.beginFrame();
+    c.endFrame();
+    CORRADE_COMPARE(b.calls, 1);
+    CORRADE_COMPARE(c.calls, 2);
+}
+
+void FrameProfilerTest::sinkCsv() {
+    UnsignedLong value = 0;
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"CPU time", FrameProfiler::Units::Nanoseconds,
+            [](void*) {},
+            [](void* state) {
+                return *static_cast<UnsignedLong*>(state) += 1500;
+            }, &value},
+        FrameProfiler::Measurement{"Weird \"name\", really", FrameProfiler::Units::Count,
+            [](void*) {},
+            [](void*) { return UnsignedLong{3}; }, nullptr}
+    }, 3};
+
+    std::ostringstream out;
+    profiler.setSink(out, FrameProfiler::SinkFormat::Csv);
+    CORRADE_COMPARE(out.str(), "frame,\"CPU time\",\"Weird \"\"name\"\", really\"\n");
+
+    profiler.beginFrame();
+    profiler.endFrame();
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_COMPARE(out.str(),
+        "frame,\"CPU time\",\"Weird \"\"name\"\", really\"\n"
+        "0,1500,3\n"
+        "1,3000,3\n");
+}
+
+void FrameProfilerTest::sinkJsonLines() {
+    UnsignedLong value = 0;
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"CPU time", FrameProfiler::Units::Nanoseconds,
+            [](void*) {},
+            [](void* state) {
+                return *static_cast<UnsignedLong*>(state) += 1500;
+            }, &value},
+        FrameProfiler::Measurement{"Weird \"name\"\\\t", FrameProfiler::Units::Count,
+            [](void*) {},
+            [](void*) { return UnsignedLong{3}; }, nullptr}
+    }, 3};
+
+    std::ostringstream out;
+    profiler.setSink(out, FrameProfiler::SinkFormat::JsonLines);
+    CORRADE_COMPARE(out.str(), "");
+
+    profiler.beginFrame();
+    profiler.endFrame();
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_COMPARE(out.str(),
+        "{\"frame\":0,\"CPU time\":1500,\"Weird \\\"name\\\"\\\\\\u0009\":3}\n"
+        "{\"frame\":1,\"CPU time\":3000,\"Weird \\\"name\\\"\\\\\\u0009\":3}\n");
+}
+
 void FrameProfilerTest::copy() {
     CORRADE_VERIFY(!std::is_copy_constructible<FrameProfiler>{});
     CORRADE_VERIFY(!std::is_copy_assignable<FrameProfiler>{});
@@ -855,12 +1173,20 @@ void FrameProfilerTest::measurementOutOfBounds() {
     profiler.measurementDelay(2);
     profiler.measurementData(2, 0);
     profiler.measurementMean(2);
+    profiler.measurementMin(2);
+    profiler.measurementMax(2);
+    profiler.measurementPercentile(2, 50.0);
+    profiler.measurementHistogram(2);
     CORRADE_COMPARE(out.str(),
         "DebugTools::FrameProfiler::measurementName(): index 2 out of range for 2 measurements\n"
         "DebugTools::FrameProfiler::measurementUnits(): index 2 out of range for 2 measurements\n"
         "DebugTools::FrameProfiler::measurementDelay(): index 2 out of range for 2 measurements\n"
         "DebugTools::FrameProfiler::measurementData(): index 2 out of range for 2 measurements\n"
-        "DebugTools::FrameProfiler::measurementMean(): index 2 out of range for 2 measurements\n");
+        "DebugTools::FrameProfiler::measurementMean(): index 2 out of range for 2 measurements\n"
+        "DebugTools::FrameProfiler::measurementMin(): index 2 out of range for 2 measurements\n"
+        "DebugTools::FrameProfiler::measurementMax(): index 2 out of range for 2 measurements\n"
+        "DebugTools::FrameProfiler::measurementPercentile(): index 2 out of range for 2 measurements\n"
+        "DebugTools::FrameProfiler::measurementHistogram(): index 2 out of range for 2 measurements\n");
 }
 
 void FrameProfilerTest::frameOutOfBounds() {
@@ -979,6 +1305,68 @@ void FrameProfilerTest::meanNotAvailableYet() {
         "DebugTools::FrameProfiler::measurementMean(): measurement data available after 2 more frames\n");
 }
 
+void FrameProfilerTest::percentileNotAvailableYet() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"", FrameProfiler::Units::Count, 3,
+            [](void*, UnsignedInt) {},
+            [](void*, UnsignedInt) {},
+            [](void*, UnsignedInt, UnsignedInt) { return UnsignedLong{}; }, nullptr},
+    }, 5};
+
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_VERIFY(!profiler.isMeasurementAvailable(0));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    profiler.measurementMin(0);
+    profiler.measurementMax(0);
+    profiler.measurementPercentile(0, 50.0);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::FrameProfiler::measurementMin(): measurement data available after 2 more frames\n"
+        "DebugTools::FrameProfiler::measurementMax(): measurement data available after 2 more frames\n"
+        "DebugTools::FrameProfiler::measurementPercentile(): measurement data available after 2 more frames\n");
+}
+
+void FrameProfilerTest::percentileOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"", FrameProfiler::Units::Count,
+            [](void*) {},
+            [](void*) { return UnsignedLong{}; }, nullptr},
+    }, 5};
+
+    profiler.beginFrame();
+    profiler.endFrame();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    profiler.measurementPercentile(0, -0.5);
+    profiler.measurementPercentile(0, 100.5);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::FrameProfiler::measurementPercentile(): expected percentile to be in range [0, 100] but got -0.5\n"
+        "DebugTools::FrameProfiler::measurementPercentile(): expected percentile to be in range [0, 100] but got 100.5\n");
+}
+
+void FrameProfilerTest::histogramBucketOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    FrameProfiler::histogramBucketRange(FrameProfiler::HistogramBucketCount);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::FrameProfiler::histogramBucketRange(): index 976 out of range for 976 buckets\n");
+}
+
 void FrameProfilerTest::statistics() {
     UnsignedLong time = 0;
     FrameProfiler profiler{{
@@ -1199,6 +1587,13 @@ void FrameProfilerTest::debugUnits() {
     CORRADE_COMPARE(out.str(), "DebugTools::FrameProfiler::Units::Nanoseconds DebugTools::FrameProfiler::Units(0xf0)\n");
 }
 
+void FrameProfilerTest::debugSinkFormat() {
+    std::ostringstream out;
+
+    Debug{&out} << FrameProfiler::SinkFormat::JsonLines << FrameProfiler::SinkFormat(0xf0);
+    CORRADE_COMPARE(out.str(), "DebugTools::FrameProfiler::SinkFormat::JsonLines DebugTools::FrameProfiler::SinkFormat(0xf0)\n");
+}
+
 #ifdef MAGNUM_TARGET_GL
 void FrameProfilerTest::debugGLValue() {
     std::ostringstream out;
@@ -0,0 +1,189 @@
+#ifndef Magnum_Implementation_converterBatch_h
+#define Magnum_Implementation_converterBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StaticArray.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/String.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Implementation/parallelFor.h"
+
+namespace Magnum { namespace Implementation {
+
+/* Used only in executables where we don't want it to be exported */
+namespace {
+
+struct BatchJob {
+    std::string input, output;
+
+    /* Filled by runBatch() */
+    bool succeeded;
+    std::chrono::high_resolution_clock::duration duration;
+    std::size_t inputSize, outputSize;
+};
+
+/* Parses a manifest with one job per line, input and output filename
+   separated by a tab. Empty lines and lines starting with # are ignored. If
+   the output isn't required, a line can contain just the input. */
+Containers::Optional<Containers::Array<BatchJob>> parseBatchManifest(const std::string& filename, const bool outputRequired) {
+    /** @todo simplify once readString() reliably returns an Optional */
+    if(!Utility::Directory::exists(filename)) {
+        Error{} << "Cannot open batch manifest" << filename;
+        return {};
+    }
+
+    const std::vector<std::string> lines = Utility::String::split(Utility::Directory::readString(filename), '\n');
+    Containers::Array<BatchJob> jobs;
+    for(std::size_t i = 0; i != lines.size(); ++i) {
+        const std::string line = Utility::String::trim(lines[i]);
+        if(line.empty() || line[0] == '#') continue;
+
+        const Containers::StaticArray<3, std::string> inputOutput = Utility::String::partition(line, '\t');
+        if(inputOutput[1].empty() && outputRequired) {
+            Error{} << "Invalid batch manifest" << filename << Debug::nospace << ":" << Debug::nospace << i + 1 << Debug::nospace << ": expected an input and an output filename separated by a tab";
+            return {};
+        }
+
+        arrayAppend(jobs, Containers::InPlaceInit,
+            Utility::String::trim(inputOutput[0]),
+            Utility::String::trim(inputOutput[2]),
+            false, std::chrono::high_resolution_clock::duration{},
+            std::size_t{}, std::size_t{});
+    }
+
+    return Containers::optional(std::move(jobs));
+}
+
+std::size_t fileSize(const std::string& filename) {
+    /** @todo use Directory::fileSize() once it's in a released Corrade */
+    std::ifstream in{filename, std::ifstream::binary|std::ifstream::ate};
+    return in ? std::size_t(in.tellg()) : 0;
+}
+
+/* Calculates the worker count, zero means all available cores. Emscripten
+   doesn't have threads, so there it's always just one. The same is done if
+   Corrade isn't built with CORRADE_BUILD_MULTITHREADED, as runBatch() relies
+   on the Debug, Warning and Error output redirection being thread-local. */
+std::size_t batchWorkerCount(std::size_t workerCount, const std::size_t jobCount) {
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) && !defined(CORRADE_BUILD_MULTITHREADED)
+    if(workerCount > 1)
+        Warning{} << "Corrade isn't built with CORRADE_BUILD_MULTITHREADED, converting on a single thread";
+    workerCount = 1;
+    #endif
+    return parallelThreadCount(workerCount, jobCount, 1);
+}
+
+/* Calls convert(worker, job) for all jobs, with each worker running on a
+   separate thread except for the first one, which is executed on the calling
+   thread. Jobs are picked in order as workers become free. All Debug, Warning
+   and Error output of a job is captured and printed together with a report
+   line once the job finishes, so output from parallel jobs doesn't get
+   interleaved. That relies on the output redirection being thread-local,
+   which is the case with CORRADE_BUILD_MULTITHREADED --- without it,
+   batchWorkerCount() always returns 1. Returns count of failed jobs. */
+template<class F> std::size_t runBatch(const Containers::ArrayView<BatchJob> jobs, const std::size_t workerCount, F&& convert) {
+    std::atomic<std::size_t> next{0};
+    std::size_t finished = 0, failed = 0;
+    std::mutex outputMutex;
+
+    auto work = [&](const std::size_t worker) {
+        for(std::size_t i; (i = next++) < jobs.size(); ) {
+            BatchJob& job = jobs[i];
+
+            std::ostringstream out;
+            {
+                Debug redirectOutput{&out};
+                Warning redirectWarning{&out};
+                Error redirectError{&out};
+                const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+                job.succeeded = convert(worker, job);
+                job.duration = std::chrono::high_resolution_clock::now() - start;
+            }
+            job.inputSize = fileSize(job.input);
+            job.outputSize = job.succeeded ? fileSize(job.output) : 0;
+
+            std::lock_guard<std::mutex> lock{outputMutex};
+            ++finished;
+            const std::string messages = Utility::String::rtrim(out.str());
+            if(job.succeeded) {
+                Debug d;
+                d << Utility::formatString("[{}/{}] {} -> {}: {:.3f} seconds, {} -> {} bytes", finished, jobs.size(), job.input, job.output, std::chrono::duration<double>(job.duration).count(), job.inputSize, job.outputSize);
+                if(!messages.empty()) d << Debug::newline << messages;
+            } else {
+                ++failed;
+                Error e;
+                e << Utility::formatString("[{}/{}] {} -> {}: failed after {:.3f} seconds", finished, jobs.size(), job.input, job.output, std::chrono::duration<double>(job.duration).count());
+                if(!messages.empty()) e << Debug::newline << messages;
+            }
+        }
+    };
+
+    parallelFor(workerCount, work);
+
+    return failed;
+}
+
+/* Prints a summary and optionally writes a tab-separated report of all jobs
+   into a file */
+bool finishBatch(const Containers::ArrayView<const BatchJob> jobs, const std::size_t failed, const std::chrono::high_resolution_clock::duration duration, const std::string& report) {
+    std::size_t inputSize = 0, outputSize = 0;
+    for(const BatchJob& job: jobs) {
+        inputSize += job.inputSize;
+        outputSize += job.outputSize;
+    }
+
+    Debug{} << Utility::formatString("Converted {} out of {} files in {:.3f} seconds, {} -> {} bytes", jobs.size() - failed, jobs.size(), std::chrono::duration<double>(duration).count(), inputSize, outputSize);
+
+    if(report.empty()) return true;
+
+    std::string out = "input\toutput\tstatus\tseconds\tinputBytes\toutputBytes\n";
+    for(const BatchJob& job: jobs)
+        Utility::formatInto(out, out.size(), "{}\t{}\t{}\t{:.6f}\t{}\t{}\n", job.input, job.output, job.succeeded ? "ok" : "failed", std::chrono::duration<double>(job.duration).count(), job.inputSize, job.outputSize);
+
+    if(!Utility::Directory::writeString(report, out)) {
+        Error{} << "Cannot write the batch report to" << report;
+        return false;
+    }
+
+    return true;
+}
+
+}
+
+}}
+
+#endif
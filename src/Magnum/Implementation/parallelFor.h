@@ -0,0 +1,80 @@
+#ifndef Magnum_Implementation_parallelFor_h
+#define Magnum_Implementation_parallelFor_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Functions.h"
+
+/* Magnum.h has to be included first so CORRADE_TARGET_EMSCRIPTEN is
+   defined */
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#include <vector>
+#endif
+
+namespace Magnum { namespace Implementation {
+
+/* Calculates how many threads to use for processing itemCount items. Zero
+   threadCount means std::thread::hardware_concurrency(), and there's no
+   point in spawning a thread for less than minItemsPerThread items. Always
+   at least one, and always one on Emscripten, which doesn't have threads. */
+inline std::size_t parallelThreadCount(std::size_t threadCount, const std::size_t itemCount, const std::size_t minItemsPerThread) {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(!threadCount) threadCount = std::thread::hardware_concurrency();
+    #else
+    threadCount = 1;
+    #endif
+    return Math::max(Math::min(threadCount, itemCount/minItemsPerThread), std::size_t{1});
+}
+
+/* Calls f(i) for all i in [0, count), each on a separate thread except for
+   the first one, which is executed on the calling thread. On Emscripten all
+   are executed sequentially on the calling thread. */
+template<class F> void parallelFor(const std::size_t count, const F& f) {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    std::vector<std::thread> threads;
+    threads.reserve(count ? count - 1 : 0);
+    for(std::size_t i = 1; i < count; ++i)
+        threads.emplace_back([&f, i]() { f(i); });
+    if(count) f(0);
+    for(std::thread& thread: threads) thread.join();
+    #else
+    for(std::size_t i = 0; i != count; ++i) f(i);
+    #endif
+}
+
+/* Calls f(begin, end) for itemCount items split into threadCount contiguous
+   ranges using parallelFor() */
+template<class F> void parallelForRanges(const std::size_t threadCount, const std::size_t itemCount, const F& f) {
+    parallelFor(threadCount, [&f, threadCount, itemCount](const std::size_t i) {
+        f(itemCount*i/threadCount, itemCount*(i + 1)/threadCount);
+    });
+}
+
+}}
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef Magnum_Math_batchSimd_h
+#define Magnum_Math_batchSimd_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+
+/* AVX and AVX2 code paths of the batch functions are compiled only on x86
+   with GCC, Clang or MSVC, which can enable an instruction set for just a
+   part of the file. They're then used only if the CPU supports them, so the
+   library still runs everywhere. */
+#if defined(CORRADE_TARGET_X86) && !defined(CORRADE_TARGET_EMSCRIPTEN) && (defined(CORRADE_TARGET_GCC) || defined(CORRADE_TARGET_MSVC))
+#define MAGNUM_MATH_BATCH_SIMD_AVX
+
+#ifdef CORRADE_TARGET_MSVC
+#include <intrin.h>
+#endif
+#include <immintrin.h>
+
+/* Functions defined between the BEGIN and END macros are compiled with given
+   instruction set enabled. MSVC and clang-cl don't need anything for
+   intrinsics, but clang-cl rejects them without the attribute same as Clang
+   does. */
+#if defined(CORRADE_TARGET_CLANG)
+#define MAGNUM_MATH_BATCH_SIMD_AVX_BEGIN _Pragma("clang attribute push(__attribute__((target(\"avx\"))), apply_to = function)")
+#define MAGNUM_MATH_BATCH_SIMD_AVX2_BEGIN _Pragma("clang attribute push(__attribute__((target(\"avx2\"))), apply_to = function)")
+#define MAGNUM_MATH_BATCH_SIMD_END _Pragma("clang attribute pop")
+#elif defined(CORRADE_TARGET_GCC)
+#define MAGNUM_MATH_BATCH_SIMD_AVX_BEGIN _Pragma("GCC push_options") _Pragma("GCC target(\"avx\")")
+#define MAGNUM_MATH_BATCH_SIMD_AVX2_BEGIN _Pragma("GCC push_options") _Pragma("GCC target(\"avx2\")")
+#define MAGNUM_MATH_BATCH_SIMD_END _Pragma("GCC pop_options")
+#else
+#define MAGNUM_MATH_BATCH_SIMD_AVX_BEGIN
+#define MAGNUM_MATH_BATCH_SIMD_AVX2_BEGIN
+#define MAGNUM_MATH_BATCH_SIMD_END
+#endif
+#endif
+
+namespace Magnum { namespace Math { namespace Implementation {
+
+/* Code paths of the batch functions in PackingBatch.cpp and
+   IntersectionBatch.cpp, each of which implements only some of them. The
+   widest one available is picked on first use, the others are exposed for
+   testing. */
+enum class SimdPath: UnsignedByte {
+    Scalar,
+    Sse2,
+    Avx,
+    Avx2,
+    Neon
+};
+
+#ifdef MAGNUM_MATH_BATCH_SIMD_AVX
+/* Whether the CPU and the OS support AVX and AVX2. The OS has to save the
+   upper halves of the YMM registers on context switch, which is what the
+   XGETBV check is for; __builtin_cpu_supports() does it internally. */
+#ifdef CORRADE_TARGET_GCC
+inline bool cpuHasAvx() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx");
+}
+
+inline bool cpuHasAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+#else
+#ifdef CORRADE_TARGET_CLANG_CL
+__attribute__((__target__("xsave")))
+#endif
+inline bool cpuHasAvx() {
+    Int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 0x6) == 0x6;
+}
+
+inline bool cpuHasAvx2() {
+    Int info[4];
+    __cpuidex(info, 7, 0);
+    return cpuHasAvx() && (info[1] & (1 << 5));
+}
+#endif
+#endif
+
+/* Whether given code path is compiled in and supported by the CPU, which
+   one is used and overriding it. Meant only for testing, the override is not
+   thread-safe. */
+MAGNUM_EXPORT bool packingBatchHasSimdPath(SimdPath path);
+MAGNUM_EXPORT SimdPath packingBatchSimdPath();
+MAGNUM_EXPORT void setPackingBatchSimdPath(SimdPath path);
+MAGNUM_EXPORT bool intersectionBatchHasSimdPath(SimdPath path);
+MAGNUM_EXPORT SimdPath intersectionBatchSimdPath();
+MAGNUM_EXPORT void setIntersectionBatchSimdPath(SimdPath path);
+
+}}}
+
+#endif
@@ -0,0 +1,212 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* SIMD kernels of the batch intersection functions in IntersectionBatch.cpp,
+   included once for each code path into a namespace that defines the Simd
+   backend. The kernels test Width consecutive primitives at a time and
+   return a lane bit mask, the drivers below process as many primitives as
+   fit into whole blocks and return their count, the rest is done by the
+   scalar code. */
+
+/* Transposes Width consecutive vectors from a strided view into one register
+   per component */
+void load(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const std::size_t i, Simd::FloatN& x, Simd::FloatN& y, Simd::FloatN& z) {
+    Float data[3][Simd::Width];
+    for(std::size_t j = 0; j != Simd::Width; ++j) {
+        const Vector3<Float>& v = src[i + j];
+        data[0][j] = v.x();
+        data[1][j] = v.y();
+        data[2][j] = v.z();
+    }
+    x = Simd::load(data[0]);
+    y = Simd::load(data[1]);
+    z = Simd::load(data[2]);
+}
+
+Simd::FloatN load(const Corrade::Containers::StridedArrayView1D<const Float>& src, const std::size_t i) {
+    Float data[Simd::Width];
+    for(std::size_t j = 0; j != Simd::Width; ++j)
+        data[j] = src[i + j];
+    return Simd::load(data);
+}
+
+struct SphereFrustumSimd {
+    explicit SphereFrustumSimd(const SphereFrustum& primitives): primitives{primitives} {
+        for(std::size_t i = 0; i != 6; ++i)
+            for(std::size_t j = 0; j != 4; ++j)
+                planes[i][j] = Simd::splat(primitives.frustum[i][j]);
+    }
+
+    UnsignedInt operator()(const std::size_t i) const {
+        Simd::FloatN x, y, z;
+        load(primitives.centers, i, x, y, z);
+        const Simd::FloatN r = load(primitives.radii, i);
+        const Simd::FloatN minusRadiusSq = Simd::subtract(Simd::splat(0.0f), Simd::multiply(r, r));
+
+        /* Equivalent to Distance::pointPlaneScaled() < -radiusSq for any
+           plane */
+        Simd::MaskN outside = Simd::none();
+        for(const Simd::FloatN* plane: planes) {
+            const Simd::FloatN d = Simd::add(Simd::add(Simd::add(
+                Simd::multiply(plane[0], x),
+                Simd::multiply(plane[1], y)),
+                Simd::multiply(plane[2], z)),
+                plane[3]);
+            outside = Simd::bitOr(outside, Simd::less(d, minusRadiusSq));
+        }
+
+        return ~Simd::bits(outside);
+    }
+
+    const SphereFrustum& primitives;
+    Simd::FloatN planes[6][4];
+};
+
+struct AabbFrustumSimd {
+    explicit AabbFrustumSimd(const AabbFrustum& primitives): primitives{primitives} {
+        for(std::size_t i = 0; i != 6; ++i) {
+            for(std::size_t j = 0; j != 3; ++j) {
+                planes[i][j] = Simd::splat(primitives.frustum[i][j]);
+                planes[i][3 + j] = Simd::splat(Math::abs(primitives.frustum[i][j]));
+            }
+            planes[i][6] = Simd::splat(-primitives.frustum[i].w());
+        }
+    }
+
+    UnsignedInt operator()(const std::size_t i) const {
+        Simd::FloatN cx, cy, cz, ex, ey, ez;
+        load(primitives.centers, i, cx, cy, cz);
+        load(primitives.extents, i, ex, ey, ez);
+
+        Simd::MaskN outside = Simd::none();
+        for(const Simd::FloatN* plane: planes) {
+            const Simd::FloatN d = Simd::add(Simd::add(
+                Simd::multiply(cx, plane[0]),
+                Simd::multiply(cy, plane[1])),
+                Simd::multiply(cz, plane[2]));
+            const Simd::FloatN r = Simd::add(Simd::add(
+                Simd::multiply(ex, plane[3]),
+                Simd::multiply(ey, plane[4])),
+                Simd::multiply(ez, plane[5]));
+            outside = Simd::bitOr(outside, Simd::less(Simd::add(d, r), plane[6]));
+        }
+
+        return ~Simd::bits(outside);
+    }
+
+    const AabbFrustum& primitives;
+    /* Plane normal, its absolute value and negated plane distance */
+    Simd::FloatN planes[6][7];
+};
+
+struct SphereConeSimd {
+    explicit SphereConeSimd(const SphereCone& primitives): primitives{primitives} {}
+
+    UnsignedInt operator()(const std::size_t i) const {
+        Simd::FloatN x, y, z;
+        load(primitives.centers, i, x, y, z);
+        const Simd::FloatN r = load(primitives.radii, i);
+
+        const Simd::FloatN ox = Simd::splat(primitives.coneOrigin.x());
+        const Simd::FloatN oy = Simd::splat(primitives.coneOrigin.y());
+        const Simd::FloatN oz = Simd::splat(primitives.coneOrigin.z());
+        const Simd::FloatN nx = Simd::splat(primitives.coneNormal.x());
+        const Simd::FloatN ny = Simd::splat(primitives.coneNormal.y());
+        const Simd::FloatN nz = Simd::splat(primitives.coneNormal.z());
+        const Simd::FloatN sinAngleN = Simd::splat(primitives.sinAngle);
+
+        const Simd::FloatN dx = Simd::subtract(x, ox);
+        const Simd::FloatN dy = Simd::subtract(y, oy);
+        const Simd::FloatN dz = Simd::subtract(z, oz);
+
+        /* Whether to test against the shifted cone or the cone origin, both
+           variants are calculated and the result selected */
+        const Simd::FloatN rSin = Simd::multiply(r, sinAngleN);
+        const Simd::FloatN side = Simd::add(Simd::add(
+            Simd::multiply(Simd::subtract(dx, Simd::multiply(rSin, nx)), nx),
+            Simd::multiply(Simd::subtract(dy, Simd::multiply(rSin, ny)), ny)),
+            Simd::multiply(Simd::subtract(dz, Simd::multiply(rSin, nz)), nz));
+        const Simd::MaskN front = Simd::greater(side, Simd::splat(0.0f));
+
+        /* Point - cone test */
+        const Simd::FloatN cx = Simd::add(Simd::multiply(sinAngleN, dx), Simd::multiply(nx, r));
+        const Simd::FloatN cy = Simd::add(Simd::multiply(sinAngleN, dy), Simd::multiply(ny, r));
+        const Simd::FloatN cz = Simd::add(Simd::multiply(sinAngleN, dz), Simd::multiply(nz, r));
+        const Simd::FloatN lenA = Simd::add(Simd::add(
+            Simd::multiply(cx, nx),
+            Simd::multiply(cy, ny)),
+            Simd::multiply(cz, nz));
+        const Simd::FloatN cDot = Simd::add(Simd::add(
+            Simd::multiply(cx, cx),
+            Simd::multiply(cy, cy)),
+            Simd::multiply(cz, cz));
+        const Simd::MaskN inCone = Simd::lessOrEqual(cDot, Simd::multiply(Simd::multiply(lenA, lenA), Simd::splat(primitives.tanAngleSqPlusOne)));
+
+        /* Simple sphere point check */
+        const Simd::FloatN diffDot = Simd::add(Simd::add(
+            Simd::multiply(dx, dx),
+            Simd::multiply(dy, dy)),
+            Simd::multiply(dz, dz));
+        const Simd::MaskN inSphere = Simd::lessOrEqual(diffDot, Simd::multiply(r, r));
+
+        return Simd::bits(Simd::bitOr(Simd::bitAnd(front, inCone), Simd::bitAndNot(inSphere, front)));
+    }
+
+    const SphereCone& primitives;
+};
+
+template<class Kernel, class Primitives> std::size_t maskIntoSimd(const Primitives& primitives, const std::size_t size, const Corrade::Containers::ArrayView<UnsignedByte>& mask) {
+    const Kernel kernel{primitives};
+
+    /* Width is either 4 or 8 and i is a multiple of it, so the lane bits
+       never span two bytes */
+    std::size_t i = 0;
+    for(; i + Simd::Width <= size; i += Simd::Width)
+        mask[i >> 3] |= (kernel(i) & ((1 << Simd::Width) - 1)) << (i & 7);
+    return i;
+}
+
+template<class Kernel, class Primitives> std::size_t indicesIntoSimd(const Primitives& primitives, const std::size_t size, const Corrade::Containers::ArrayView<UnsignedInt>& indices, std::size_t& count) {
+    const Kernel kernel{primitives};
+
+    std::size_t i = 0;
+    for(; i + Simd::Width <= size; i += Simd::Width) {
+        const UnsignedInt bits = kernel(i);
+        for(std::size_t j = 0; j != Simd::Width; ++j) {
+            indices[count] = UnsignedInt(i + j);
+            count += (bits >> j) & 1;
+        }
+    }
+    return i;
+}
+
+constexpr Kernels kernels{
+    maskIntoSimd<SphereFrustumSimd, SphereFrustum>,
+    indicesIntoSimd<SphereFrustumSimd, SphereFrustum>,
+    maskIntoSimd<AabbFrustumSimd, AabbFrustum>,
+    indicesIntoSimd<AabbFrustumSimd, AabbFrustum>,
+    maskIntoSimd<SphereConeSimd, SphereCone>,
+    indicesIntoSimd<SphereConeSimd, SphereCone>
+};
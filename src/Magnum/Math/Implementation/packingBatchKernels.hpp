@@ -0,0 +1,103 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* SIMD kernels of the batch packing functions in PackingBatch.cpp, included
+   once for each code path into a namespace that defines the Simd backend.
+   The kernels process as many elements as fit into whole vectors and return
+   their count, the rest is done by the scalar code. */
+
+/* Integer lanes get to and from all supported types through these, floats
+   are truncated when converting to integers */
+template<class T> inline Simd::IntN loadInteger(const T* src) { return Simd::load(src); }
+inline Simd::IntN loadInteger(const Float* src) { return Simd::truncate(Simd::load(src)); }
+template<class T> inline void storeInteger(T* dst, Simd::IntN value) { Simd::store(dst, value); }
+inline void storeInteger(Float* dst, Simd::IntN value) { Simd::store(dst, Simd::toFloat(value)); }
+
+template<class T> std::size_t unpackUnsignedSimd(const T* src, Float* dst, const std::size_t count) {
+    /* Caching values to avoid inline function calls in debug builds */
+    constexpr Float bitMax = Implementation::bitMax<T>();
+    const Simd::FloatN bitMaxN = Simd::splat(bitMax);
+    std::size_t i = 0;
+    for(; i + Simd::Width <= count; i += Simd::Width)
+        Simd::store(dst + i, Simd::divide(Simd::toFloat(Simd::load(src + i)), bitMaxN));
+    return i;
+}
+
+template<class T> std::size_t unpackSignedSimd(const T* src, Float* dst, const std::size_t count) {
+    /* Caching values to avoid inline function calls in debug builds */
+    constexpr Float bitMax = Implementation::bitMax<T>();
+    const Simd::FloatN bitMaxN = Simd::splat(bitMax);
+    const Simd::FloatN minusOneN = Simd::splat(-1.0f);
+    std::size_t i = 0;
+    for(; i + Simd::Width <= count; i += Simd::Width)
+        Simd::store(dst + i, Simd::max(Simd::divide(Simd::toFloat(Simd::load(src + i)), bitMaxN), minusOneN));
+    return i;
+}
+
+template<class T> std::size_t packSimd(const Float* src, T* dst, const std::size_t count) {
+    /* Caching values to avoid inline function calls in debug builds */
+    constexpr Float bitMax = Implementation::bitMax<T>();
+    const Simd::FloatN bitMaxN = Simd::splat(bitMax);
+    std::size_t i = 0;
+    for(; i + Simd::Width <= count; i += Simd::Width)
+        Simd::store(dst + i, Simd::round(Simd::multiply(Simd::load(src + i), bitMaxN)));
+    return i;
+}
+
+template<class T, class U> std::size_t castSimd(const T* src, U* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + Simd::Width <= count; i += Simd::Width)
+        storeInteger(dst + i, loadInteger(src + i));
+    return i;
+}
+
+constexpr Kernels kernels{
+    unpackUnsignedSimd<UnsignedByte>,
+    unpackUnsignedSimd<UnsignedShort>,
+    unpackSignedSimd<Byte>,
+    unpackSignedSimd<Short>,
+    packSimd<UnsignedByte>,
+    packSimd<UnsignedShort>,
+    packSimd<Byte>,
+    packSimd<Short>,
+    castSimd<UnsignedByte, Float>,
+    castSimd<Byte, Float>,
+    castSimd<UnsignedShort, Float>,
+    castSimd<Short, Float>,
+    castSimd<Int, Float>,
+    castSimd<Float, UnsignedByte>,
+    castSimd<Float, Byte>,
+    castSimd<Float, UnsignedShort>,
+    castSimd<Float, Short>,
+    castSimd<Float, Int>,
+    castSimd<UnsignedByte, UnsignedInt>,
+    castSimd<Byte, Int>,
+    castSimd<UnsignedShort, UnsignedInt>,
+    castSimd<Short, Int>,
+    castSimd<UnsignedInt, UnsignedByte>,
+    castSimd<Int, Byte>,
+    castSimd<UnsignedInt, UnsignedShort>,
+    castSimd<Int, Short>
+};
@@ -199,6 +199,7 @@ template<class T> bool rayRange(const Vector3<T>& rayOrigin, const Vector3<T>& i
 
 Uses the same method as @ref rangeFrustum(), but does not need to convert to
 center/extents representation.
+@see @ref aabbFrustumInto(), @ref aabbFrustumIndicesInto()
 */
 template<class T> bool aabbFrustum(const Vector3<T>& aabbCenter, const Vector3<T>& aabbExtents, const Frustum<T>& frustum);
 
@@ -213,6 +214,7 @@ template<class T> bool aabbFrustum(const Vector3<T>& aabbCenter, const Vector3<T
 Checks for each plane of the frustum whether the sphere is behind the plane
 (the points distance larger than the sphere's radius) using
 @ref Distance::pointPlaneScaled().
+@see @ref sphereFrustumInto(), @ref sphereFrustumIndicesInto()
 */
 template<class T> bool sphereFrustum(const Vector3<T>& sphereCenter, T sphereRadius, const Frustum<T>& frustum);
 
@@ -341,6 +343,8 @@ testing whether the origin of the original cone intersects the sphere. The
 @p sinAngle and @p tanAngleSqPlusOne parameters can be precomputed like this:
 
 @snippet MagnumMath.cpp Intersection-sinAngle-tanAngleSqPlusOne
+
+@see @ref sphereConeInto(), @ref sphereConeIndicesInto()
 */
 template<class T> bool sphereCone(const Vector3<T>& sphereCenter, T sphereRadius, const Vector3<T>& coneOrigin, const Vector3<T>& coneNormal, T sinAngle, T tanAngleSqPlusOne);
 
@@ -0,0 +1,350 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "IntersectionBatch.h"
+
+#include <cstring>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/Implementation/batchSimd.h"
+
+/* The AVX intrinsics are included by batchSimd.h if enabled */
+#if defined(CORRADE_TARGET_SSE2) && !defined(MAGNUM_MATH_BATCH_SIMD_AVX)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace Math { namespace Intersection {
+
+namespace {
+
+/* Each of these tests a single primitive with the scalar code and holds the
+   input for the SIMD kernels */
+struct SphereFrustum {
+    explicit SphereFrustum(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& centers, const Corrade::Containers::StridedArrayView1D<const Float>& radii, const Frustum<Float>& frustum): centers{centers}, radii{radii}, frustum{frustum} {}
+
+    bool operator()(const std::size_t i) const {
+        return sphereFrustum(centers[i], radii[i], frustum);
+    }
+
+    const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& centers;
+    const Corrade::Containers::StridedArrayView1D<const Float>& radii;
+    const Frustum<Float>& frustum;
+};
+
+struct AabbFrustum {
+    explicit AabbFrustum(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& centers, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& extents, const Frustum<Float>& frustum): centers{centers}, extents{extents}, frustum{frustum} {}
+
+    bool operator()(const std::size_t i) const {
+        return aabbFrustum(centers[i], extents[i], frustum);
+    }
+
+    const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& centers;
+    const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& extents;
+    const Frustum<Float>& frustum;
+};
+
+struct SphereCone {
+    explicit SphereCone(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& centers, const Corrade::Containers::StridedArrayView1D<const Float>& radii, const Vector3<Float>& coneOrigin, const Vector3<Float>& coneNormal, const Float sinAngle, const Float tanAngleSqPlusOne): centers{centers}, radii{radii}, coneOrigin{coneOrigin}, coneNormal{coneNormal}, sinAngle{sinAngle}, tanAngleSqPlusOne{tanAngleSqPlusOne} {}
+
+    bool operator()(const std::size_t i) const {
+        return sphereCone(centers[i], radii[i], coneOrigin, coneNormal, sinAngle, tanAngleSqPlusOne);
+    }
+
+    const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& centers;
+    const Corrade::Containers::StridedArrayView1D<const Float>& radii;
+    const Vector3<Float>& coneOrigin;
+    const Vector3<Float>& coneNormal;
+    Float sinAngle, tanAngleSqPlusOne;
+};
+
+/* Signatures of the SIMD kernels, returning how many primitives they
+   processed */
+template<class Primitives> using SimdMaskKernel = std::size_t(*)(const Primitives&, std::size_t, const Corrade::Containers::ArrayView<UnsignedByte>&);
+template<class Primitives> using SimdIndicesKernel = std::size_t(*)(const Primitives&, std::size_t, const Corrade::Containers::ArrayView<UnsignedInt>&, std::size_t&);
+
+/* SIMD kernels of one code path */
+struct Kernels {
+    SimdMaskKernel<SphereFrustum> sphereFrustumMask;
+    SimdIndicesKernel<SphereFrustum> sphereFrustumIndices;
+    SimdMaskKernel<AabbFrustum> aabbFrustumMask;
+    SimdIndicesKernel<AabbFrustum> aabbFrustumIndices;
+    SimdMaskKernel<SphereCone> sphereConeMask;
+    SimdIndicesKernel<SphereCone> sphereConeIndices;
+};
+
+/* The scalar code path has no SIMD kernels */
+constexpr Kernels ScalarKernels{};
+
+/* SIMD backends, each testing Width primitives at a time. The operations are
+   done in the same order as in the scalar code and there's no fused
+   multiply-add, so the results are the same. Same as in PackingBatch.cpp,
+   the AVX backend is compiled with AVX enabled just for it and picked at
+   runtime, SSE2 and NEON only if enabled at compile time. NEON is used only
+   on AArch64 as ARMv7 lacks a horizontal add needed to extract the lane
+   mask. */
+#ifdef MAGNUM_MATH_BATCH_SIMD_AVX
+MAGNUM_MATH_BATCH_SIMD_AVX_BEGIN
+namespace Avx {
+
+struct Simd {
+    enum: std::size_t { Width = 8 };
+    typedef __m256 FloatN;
+    typedef __m256 MaskN;
+
+    static FloatN splat(Float value) { return _mm256_set1_ps(value); }
+    static FloatN load(const Float* src) { return _mm256_loadu_ps(src); }
+    static FloatN add(FloatN a, FloatN b) { return _mm256_add_ps(a, b); }
+    static FloatN subtract(FloatN a, FloatN b) { return _mm256_sub_ps(a, b); }
+    static FloatN multiply(FloatN a, FloatN b) { return _mm256_mul_ps(a, b); }
+    static MaskN less(FloatN a, FloatN b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static MaskN lessOrEqual(FloatN a, FloatN b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static MaskN greater(FloatN a, FloatN b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static MaskN none() { return _mm256_setzero_ps(); }
+    static MaskN bitOr(MaskN a, MaskN b) { return _mm256_or_ps(a, b); }
+    static MaskN bitAnd(MaskN a, MaskN b) { return _mm256_and_ps(a, b); }
+    /* a & ~b */
+    static MaskN bitAndNot(MaskN a, MaskN b) { return _mm256_andnot_ps(b, a); }
+    static UnsignedInt bits(MaskN a) { return _mm256_movemask_ps(a); }
+};
+
+#include "Magnum/Math/Implementation/intersectionBatchKernels.hpp"
+
+}
+MAGNUM_MATH_BATCH_SIMD_END
+#endif
+
+#ifdef CORRADE_TARGET_SSE2
+namespace Sse2 {
+
+struct Simd {
+    enum: std::size_t { Width = 4 };
+    typedef __m128 FloatN;
+    typedef __m128 MaskN;
+
+    static FloatN splat(Float value) { return _mm_set1_ps(value); }
+    static FloatN load(const Float* src) { return _mm_loadu_ps(src); }
+    static FloatN add(FloatN a, FloatN b) { return _mm_add_ps(a, b); }
+    static FloatN subtract(FloatN a, FloatN b) { return _mm_sub_ps(a, b); }
+    static FloatN multiply(FloatN a, FloatN b) { return _mm_mul_ps(a, b); }
+    static MaskN less(FloatN a, FloatN b) { return _mm_cmplt_ps(a, b); }
+    static MaskN lessOrEqual(FloatN a, FloatN b) { return _mm_cmple_ps(a, b); }
+    static MaskN greater(FloatN a, FloatN b) { return _mm_cmpgt_ps(a, b); }
+    static MaskN none() { return _mm_setzero_ps(); }
+    static MaskN bitOr(MaskN a, MaskN b) { return _mm_or_ps(a, b); }
+    static MaskN bitAnd(MaskN a, MaskN b) { return _mm_and_ps(a, b); }
+    /* a & ~b */
+    static MaskN bitAndNot(MaskN a, MaskN b) { return _mm_andnot_ps(b, a); }
+    static UnsignedInt bits(MaskN a) { return _mm_movemask_ps(a); }
+};
+
+#include "Magnum/Math/Implementation/intersectionBatchKernels.hpp"
+
+}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+namespace Neon {
+
+struct Simd {
+    enum: std::size_t { Width = 4 };
+    typedef float32x4_t FloatN;
+    typedef uint32x4_t MaskN;
+
+    static FloatN splat(Float value) { return vdupq_n_f32(value); }
+    static FloatN load(const Float* src) { return vld1q_f32(src); }
+    static FloatN add(FloatN a, FloatN b) { return vaddq_f32(a, b); }
+    static FloatN subtract(FloatN a, FloatN b) { return vsubq_f32(a, b); }
+    static FloatN multiply(FloatN a, FloatN b) { return vmulq_f32(a, b); }
+    static MaskN less(FloatN a, FloatN b) { return vcltq_f32(a, b); }
+    static MaskN lessOrEqual(FloatN a, FloatN b) { return vcleq_f32(a, b); }
+    static MaskN greater(FloatN a, FloatN b) { return vcgtq_f32(a, b); }
+    static MaskN none() { return vdupq_n_u32(0); }
+    static MaskN bitOr(MaskN a, MaskN b) { return vorrq_u32(a, b); }
+    static MaskN bitAnd(MaskN a, MaskN b) { return vandq_u32(a, b); }
+    /* a & ~b */
+    static MaskN bitAndNot(MaskN a, MaskN b) { return vbicq_u32(a, b); }
+    static UnsignedInt bits(MaskN a) {
+        const UnsignedInt lanes[]{1, 2, 4, 8};
+        return vaddvq_u32(vandq_u32(a, vld1q_u32(lanes)));
+    }
+};
+
+#include "Magnum/Math/Implementation/intersectionBatchKernels.hpp"
+
+}
+#endif
+
+const Kernels* kernelsFor(const Implementation::SimdPath path) {
+    switch(path) {
+        case Implementation::SimdPath::Scalar:
+            return &ScalarKernels;
+        #ifdef CORRADE_TARGET_SSE2
+        case Implementation::SimdPath::Sse2:
+            return &Sse2::kernels;
+        #endif
+        #ifdef MAGNUM_MATH_BATCH_SIMD_AVX
+        case Implementation::SimdPath::Avx:
+            return Implementation::cpuHasAvx() ? &Avx::kernels : nullptr;
+        #endif
+        #if defined(__ARM_NEON) && defined(__aarch64__)
+        case Implementation::SimdPath::Neon:
+            return &Neon::kernels;
+        #endif
+        default:
+            return nullptr;
+    }
+}
+
+struct State {
+    Implementation::SimdPath path;
+    const Kernels* kernels;
+};
+
+State& state() {
+    /* The widest code path supported by both the compiler and the CPU is
+       picked on first use. The paths are ordered from the narrowest, so the
+       last available one wins. */
+    static State state = []{
+        const Implementation::SimdPath paths[]{
+            Implementation::SimdPath::Sse2,
+            Implementation::SimdPath::Neon,
+            Implementation::SimdPath::Avx
+        };
+        State best{Implementation::SimdPath::Scalar, &ScalarKernels};
+        for(const Implementation::SimdPath path: paths)
+            if(const Kernels* const pathKernels = kernelsFor(path))
+                best = State{path, pathKernels};
+        return best;
+    }();
+    return state;
+}
+
+const Kernels& kernels() {
+    return *state().kernels;
+}
+
+/* The SIMD kernel, if any, processes as much as it can, the scalar code does
+   the rest */
+template<class Primitives> void maskInto(const Primitives& primitives, const std::size_t size, const Corrade::Containers::ArrayView<UnsignedByte>& mask, const SimdMaskKernel<Primitives> simdKernel) {
+    std::memset(mask.data(), 0, mask.size());
+
+    for(std::size_t i = simdKernel ? simdKernel(primitives, size, mask) : 0; i != size; ++i)
+        mask[i >> 3] |= UnsignedByte(primitives(i)) << (i & 7);
+}
+
+template<class Primitives> std::size_t indicesInto(const Primitives& primitives, const std::size_t size, const Corrade::Containers::ArrayView<UnsignedInt>& indices, const SimdIndicesKernel<Primitives> simdKernel) {
+    /* The index is written unconditionally and the count advanced only if the
+       primitive passed. Because count <= i, the writes never go past the
+       input size. */
+    std::size_t count = 0;
+    for(std::size_t i = simdKernel ? simdKernel(primitives, size, indices, count) : 0; i != size; ++i) {
+        indices[count] = UnsignedInt(i);
+        count += primitives(i);
+    }
+
+    return count;
+}
+
+}
+
+}
+
+namespace Implementation {
+
+bool intersectionBatchHasSimdPath(const SimdPath path) {
+    return Intersection::kernelsFor(path);
+}
+
+SimdPath intersectionBatchSimdPath() {
+    return Intersection::state().path;
+}
+
+void setIntersectionBatchSimdPath(const SimdPath path) {
+    const Intersection::Kernels* const pathKernels = Intersection::kernelsFor(path);
+    CORRADE_INTERNAL_ASSERT(pathKernels);
+    Intersection::state() = Intersection::State{path, pathKernels};
+}
+
+}
+
+namespace Intersection {
+
+void sphereFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedByte>& mask) {
+    CORRADE_ASSERT(sphereRadii.size() == sphereCenters.size(),
+        "Math::Intersection::sphereFrustumInto(): expected" << sphereCenters.size() << "radii but got" << sphereRadii.size(), );
+    CORRADE_ASSERT(mask.size() == (sphereCenters.size() + 7)/8,
+        "Math::Intersection::sphereFrustumInto(): wrong mask size, got" << mask.size() << "but expected" << (sphereCenters.size() + 7)/8, );
+
+    maskInto(SphereFrustum{sphereCenters, sphereRadii, frustum}, sphereCenters.size(), mask, kernels().sphereFrustumMask);
+}
+
+std::size_t sphereFrustumIndicesInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedInt>& indices) {
+    CORRADE_ASSERT(sphereRadii.size() == sphereCenters.size(),
+        "Math::Intersection::sphereFrustumIndicesInto(): expected" << sphereCenters.size() << "radii but got" << sphereRadii.size(), {});
+    CORRADE_ASSERT(indices.size() >= sphereCenters.size(),
+        "Math::Intersection::sphereFrustumIndicesInto(): expected at least" << sphereCenters.size() << "indices but got" << indices.size(), {});
+
+    return indicesInto(SphereFrustum{sphereCenters, sphereRadii, frustum}, sphereCenters.size(), indices, kernels().sphereFrustumIndices);
+}
+
+void aabbFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbCenters, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbExtents, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedByte>& mask) {
+    CORRADE_ASSERT(aabbExtents.size() == aabbCenters.size(),
+        "Math::Intersection::aabbFrustumInto(): expected" << aabbCenters.size() << "extents but got" << aabbExtents.size(), );
+    CORRADE_ASSERT(mask.size() == (aabbCenters.size() + 7)/8,
+        "Math::Intersection::aabbFrustumInto(): wrong mask size, got" << mask.size() << "but expected" << (aabbCenters.size() + 7)/8, );
+
+    maskInto(AabbFrustum{aabbCenters, aabbExtents, frustum}, aabbCenters.size(), mask, kernels().aabbFrustumMask);
+}
+
+std::size_t aabbFrustumIndicesInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbCenters, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbExtents, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedInt>& indices) {
+    CORRADE_ASSERT(aabbExtents.size() == aabbCenters.size(),
+        "Math::Intersection::aabbFrustumIndicesInto(): expected" << aabbCenters.size() << "extents but got" << aabbExtents.size(), {});
+    CORRADE_ASSERT(indices.size() >= aabbCenters.size(),
+        "Math::Intersection::aabbFrustumIndicesInto(): expected at least" << aabbCenters.size() << "indices but got" << indices.size(), {});
+
+    return indicesInto(AabbFrustum{aabbCenters, aabbExtents, frustum}, aabbCenters.size(), indices, kernels().aabbFrustumIndices);
+}
+
+void sphereConeInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Vector3<Float>& coneOrigin, const Vector3<Float>& coneNormal, const Float sinAngle, const Float tanAngleSqPlusOne, const Corrade::Containers::ArrayView<UnsignedByte>& mask) {
+    CORRADE_ASSERT(sphereRadii.size() == sphereCenters.size(),
+        "Math::Intersection::sphereConeInto(): expected" << sphereCenters.size() << "radii but got" << sphereRadii.size(), );
+    CORRADE_ASSERT(mask.size() == (sphereCenters.size() + 7)/8,
+        "Math::Intersection::sphereConeInto(): wrong mask size, got" << mask.size() << "but expected" << (sphereCenters.size() + 7)/8, );
+
+    maskInto(SphereCone{sphereCenters, sphereRadii, coneOrigin, coneNormal, sinAngle, tanAngleSqPlusOne}, sphereCenters.size(), mask, kernels().sphereConeMask);
+}
+
+std::size_t sphereConeIndicesInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Vector3<Float>& coneOrigin, const Vector3<Float>& coneNormal, const Float sinAngle, const Float tanAngleSqPlusOne, const Corrade::Containers::ArrayView<UnsignedInt>& indices) {
+    CORRADE_ASSERT(sphereRadii.size() == sphereCenters.size(),
+        "Math::Intersection::sphereConeIndicesInto(): expected" << sphereCenters.size() << "radii but got" << sphereRadii.size(), {});
+    CORRADE_ASSERT(indices.size() >= sphereCenters.size(),
+        "Math::Intersection::sphereConeIndicesInto(): expected at least" << sphereCenters.size() << "indices but got" << indices.size(), {});
+
+    return indicesInto(SphereCone{sphereCenters, sphereRadii, coneOrigin, coneNormal, sinAngle, tanAngleSqPlusOne}, sphereCenters.size(), indices, kernels().sphereConeIndices);
+}
+
+}}}
@@ -0,0 +1,181 @@
+#ifndef Magnum_Math_IntersectionBatch_h
+#define Magnum_Math_IntersectionBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Batch functions @ref Magnum::Math::Intersection::sphereFrustumInto(), @ref Magnum::Math::Intersection::aabbFrustumInto(), @ref Magnum::Math::Intersection::sphereConeInto() and their index list variants
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/Math/Math.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Math { namespace Intersection {
+
+/**
+@{ @name Batch intersection functions
+
+These functions test an unbounded range of primitives against a single frustum
+or cone, as opposed to the single-primitive tests in
+@ref Magnum/Math/Intersection.h. The primitive data are passed as separate
+strided views, which allows them to be taken from both interleaved and
+structure-of-arrays storage. Multiple primitives are tested at once using SIMD
+instructions --- AVX if the CPU supports it, otherwise SSE2 or AArch64 NEON if
+the library is compiled with them enabled. The results are the same as when calling the single-primitive
+variants in a loop.
+
+The results are either written into a bit mask, with bit @cpp i @ce in byte
+@cpp i/8 @ce set if primitive @cpp i @ce passes the test, or into a compacted
+list of indices of primitives that pass the test. The bit mask layout is the
+same as in @ref BoolVector.
+*/
+
+/**
+@brief Intersection of spheres and a frustum
+@param[in]  sphereCenters   Sphere centers
+@param[in]  sphereRadii     Sphere radii
+@param[in]  frustum         Frustum planes with normals pointing outwards
+@param[out] mask            Where to put a bit mask of spheres that intersect
+    the frustum
+@m_since_latest
+
+Batch variant of @ref sphereFrustum(). Expects that @p sphereCenters and
+@p sphereRadii have the same size and that @p mask has
+@cpp (sphereCenters.size() + 7)/8 @ce bytes. Unused bits in the last byte are
+set to zero.
+@see @ref sphereFrustumIndicesInto()
+*/
+MAGNUM_EXPORT void sphereFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedByte>& mask);
+
+/**
+@brief Indices of spheres intersecting a frustum
+@param[in]  sphereCenters   Sphere centers
+@param[in]  sphereRadii     Sphere radii
+@param[in]  frustum         Frustum planes with normals pointing outwards
+@param[out] indices         Where to put indices of spheres that intersect
+    the frustum
+@return Count of indices written to the prefix of @p indices
+@m_since_latest
+
+Batch variant of @ref sphereFrustum(). Expects that @p sphereCenters and
+@p sphereRadii have the same size and that @p indices is at least as large as
+@p sphereCenters. Contents of @p indices after the returned count are
+unspecified.
+@see @ref sphereFrustumInto()
+*/
+MAGNUM_EXPORT std::size_t sphereFrustumIndicesInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedInt>& indices);
+
+/**
+@brief Intersection of axis-aligned boxes and a frustum
+@param[in]  aabbCenters     Centers of the AABBs
+@param[in]  aabbExtents     (Half-)extents of the AABBs
+@param[in]  frustum         Frustum planes with normals pointing outwards
+@param[out] mask            Where to put a bit mask of boxes that intersect
+    the frustum
+@m_since_latest
+
+Batch variant of @ref aabbFrustum(). Expects that @p aabbCenters and
+@p aabbExtents have the same size and that @p mask has
+@cpp (aabbCenters.size() + 7)/8 @ce bytes. Unused bits in the last byte are set
+to zero.
+@see @ref aabbFrustumIndicesInto()
+*/
+MAGNUM_EXPORT void aabbFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbCenters, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbExtents, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedByte>& mask);
+
+/**
+@brief Indices of axis-aligned boxes intersecting a frustum
+@param[in]  aabbCenters     Centers of the AABBs
+@param[in]  aabbExtents     (Half-)extents of the AABBs
+@param[in]  frustum         Frustum planes with normals pointing outwards
+@param[out] indices         Where to put indices of boxes that intersect the
+    frustum
+@return Count of indices written to the prefix of @p indices
+@m_since_latest
+
+Batch variant of @ref aabbFrustum(). Expects that @p aabbCenters and
+@p aabbExtents have the same size and that @p indices is at least as large as
+@p aabbCenters. Contents of @p indices after the returned count are
+unspecified.
+@see @ref aabbFrustumInto()
+*/
+MAGNUM_EXPORT std::size_t aabbFrustumIndicesInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbCenters, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbExtents, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedInt>& indices);
+
+/**
+@brief Intersection of spheres and a cone using precomputed values
+@param[in]  sphereCenters   Sphere centers
+@param[in]  sphereRadii     Sphere radii
+@param[in]  coneOrigin      Cone origin
+@param[in]  coneNormal      Cone normal
+@param[in]  sinAngle        Precomputed sine of half the cone's opening angle
+@param[in]  tanAngleSqPlusOne Precomputed portion of the cone intersection
+    equation
+@param[out] mask            Where to put a bit mask of spheres that intersect
+    the cone
+@m_since_latest
+
+Batch variant of @ref sphereCone(const Vector3<T>&, T, const Vector3<T>&, const Vector3<T>&, T, T),
+see its documentation for how to calculate @p sinAngle and
+@p tanAngleSqPlusOne. Expects that @p sphereCenters and @p sphereRadii have
+the same size and that @p mask has @cpp (sphereCenters.size() + 7)/8 @ce bytes.
+Unused bits in the last byte are set to zero.
+@see @ref sphereConeIndicesInto()
+*/
+MAGNUM_EXPORT void sphereConeInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Vector3<Float>& coneOrigin, const Vector3<Float>& coneNormal, Float sinAngle, Float tanAngleSqPlusOne, const Corrade::Containers::ArrayView<UnsignedByte>& mask);
+
+/**
+@brief Indices of spheres intersecting a cone using precomputed values
+@param[in]  sphereCenters   Sphere centers
+@param[in]  sphereRadii     Sphere radii
+@param[in]  coneOrigin      Cone origin
+@param[in]  coneNormal      Cone normal
+@param[in]  sinAngle        Precomputed sine of half the cone's opening angle
+@param[in]  tanAngleSqPlusOne Precomputed portion of the cone intersection
+    equation
+@param[out] indices         Where to put indices of spheres that intersect the
+    cone
+@return Count of indices written to the prefix of @p indices
+@m_since_latest
+
+Batch variant of @ref sphereCone(const Vector3<T>&, T, const Vector3<T>&, const Vector3<T>&, T, T).
+Expects that @p sphereCenters and @p sphereRadii have the same size and that
+@p indices is at least as large as @p sphereCenters. Contents of @p indices
+after the returned count are unspecified.
+@see @ref sphereConeInto()
+*/
+MAGNUM_EXPORT std::size_t sphereConeIndicesInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Vector3<Float>& coneOrigin, const Vector3<Float>& coneNormal, Float sinAngle, Float tanAngleSqPlusOne, const Corrade::Containers::ArrayView<UnsignedInt>& indices);
+
+/* Since 1.8.17, the original short-hand group closing doesn't work anymore.
+   FFS. */
+/**
+ * @}
+ */
+
+}}}
+
+#endif
@@ -25,251 +25,548 @@
 
 #include "PackingBatch.h"
 
+#include <cstring>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Implementation/batchSimd.h"
 #include "Magnum/Math/Implementation/halfTables.hpp"
 
+/* The AVX2 intrinsics are included by batchSimd.h if enabled */
+#if defined(CORRADE_TARGET_SSE2) && !defined(MAGNUM_MATH_BATCH_SIMD_AVX)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 namespace Magnum { namespace Math {
 
 namespace {
 
-template<class T> inline void unpackUnsignedIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    CORRADE_ASSERT(src.size() == dst.size(),
-        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
-    CORRADE_ASSERT(src.template isContiguous<1>() && dst.isContiguous<1>(),
-        "Math::unpackInto(): second view dimension is not contiguous", );
+/* Signature of a SIMD kernel, returning how many elements it processed */
+template<class T, class U> using SimdKernel = std::size_t(*)(const T*, U*, std::size_t);
+
+/* SIMD kernels of one code path. Conversions between UnsignedInt and Float
+   can't go through the signed 32-bit lanes, those are done only with the
+   scalar code. */
+struct Kernels {
+    SimdKernel<UnsignedByte, Float> unpackUnsignedByte;
+    SimdKernel<UnsignedShort, Float> unpackUnsignedShort;
+    SimdKernel<Byte, Float> unpackByte;
+    SimdKernel<Short, Float> unpackShort;
+    SimdKernel<Float, UnsignedByte> packUnsignedByte;
+    SimdKernel<Float, UnsignedShort> packUnsignedShort;
+    SimdKernel<Float, Byte> packByte;
+    SimdKernel<Float, Short> packShort;
+    SimdKernel<UnsignedByte, Float> castUnsignedByteFloat;
+    SimdKernel<Byte, Float> castByteFloat;
+    SimdKernel<UnsignedShort, Float> castUnsignedShortFloat;
+    SimdKernel<Short, Float> castShortFloat;
+    SimdKernel<Int, Float> castIntFloat;
+    SimdKernel<Float, UnsignedByte> castFloatUnsignedByte;
+    SimdKernel<Float, Byte> castFloatByte;
+    SimdKernel<Float, UnsignedShort> castFloatUnsignedShort;
+    SimdKernel<Float, Short> castFloatShort;
+    SimdKernel<Float, Int> castFloatInt;
+    SimdKernel<UnsignedByte, UnsignedInt> castUnsignedByteUnsignedInt;
+    SimdKernel<Byte, Int> castByteInt;
+    SimdKernel<UnsignedShort, UnsignedInt> castUnsignedShortUnsignedInt;
+    SimdKernel<Short, Int> castShortInt;
+    SimdKernel<UnsignedInt, UnsignedByte> castUnsignedIntUnsignedByte;
+    SimdKernel<Int, Byte> castIntByte;
+    SimdKernel<UnsignedInt, UnsignedShort> castUnsignedIntUnsignedShort;
+    SimdKernel<Int, Short> castIntShort;
+};
+
+/* The scalar code path has no SIMD kernels */
+constexpr Kernels ScalarKernels{};
+
+/* SIMD backends, each processing Width elements at a time. All of them
+   produce bit-exact results compared to the scalar code -- division is used
+   instead of multiplying by a reciprocal, rounding is done half away from
+   zero like std::round() and narrowing integer casts truncate. The AVX2
+   backend is compiled with AVX2 enabled just for it and picked at runtime,
+   SSE2 and NEON only if enabled at compile time. NEON is used only on
+   AArch64 as ARMv7 lacks a vector division and round-to-nearest-away
+   conversion. */
+#ifdef MAGNUM_MATH_BATCH_SIMD_AVX
+MAGNUM_MATH_BATCH_SIMD_AVX2_BEGIN
+namespace Avx2 {
+
+struct Simd {
+    enum: std::size_t { Width = 8 };
+    typedef __m256 FloatN;
+    typedef __m256i IntN;
+
+    static FloatN splat(Float value) { return _mm256_set1_ps(value); }
+    static FloatN load(const Float* src) { return _mm256_loadu_ps(src); }
+    static void store(Float* dst, FloatN value) { _mm256_storeu_ps(dst, value); }
+    static FloatN divide(FloatN a, FloatN b) { return _mm256_div_ps(a, b); }
+    static FloatN multiply(FloatN a, FloatN b) { return _mm256_mul_ps(a, b); }
+    static FloatN max(FloatN a, FloatN b) { return _mm256_max_ps(a, b); }
+    static FloatN toFloat(IntN value) { return _mm256_cvtepi32_ps(value); }
+    static IntN truncate(FloatN value) { return _mm256_cvttps_epi32(value); }
+    static IntN round(FloatN value) {
+        const IntN truncated = _mm256_cvttps_epi32(value);
+        const FloatN fraction = _mm256_sub_ps(value, _mm256_cvtepi32_ps(truncated));
+        /* The comparison masks are -1 where true */
+        return _mm256_add_epi32(_mm256_sub_epi32(truncated,
+            _mm256_castps_si256(_mm256_cmp_ps(fraction, _mm256_set1_ps(0.5f), _CMP_GE_OQ))),
+            _mm256_castps_si256(_mm256_cmp_ps(fraction, _mm256_set1_ps(-0.5f), _CMP_LE_OQ)));
+    }
+
+    static IntN load(const UnsignedByte* src) { return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src))); }
+    static IntN load(const Byte* src) { return _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src))); }
+    static IntN load(const UnsignedShort* src) { return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src))); }
+    static IntN load(const Short* src) { return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src))); }
+    static IntN load(const UnsignedInt* src) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)); }
+    static IntN load(const Int* src) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)); }
+
+    /* Narrowing keeps just the low bits of each lane, the values are masked
+       first so the saturating packs don't saturate. The packs operate on
+       128-bit lanes, the permute puts the results back in order. */
+    static void store8(void* dst, IntN value) {
+        const __m256i packed16 = _mm256_packs_epi32(_mm256_and_si256(value, _mm256_set1_epi32(0xff)), _mm256_setzero_si256());
+        const __m256i packed8 = _mm256_packus_epi16(packed16, _mm256_setzero_si256());
+        const __m256i ordered = _mm256_permutevar8x32_epi32(packed8, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(ordered));
+    }
+    static void store16(void* dst, IntN value) {
+        const __m256i packed = _mm256_packus_epi32(_mm256_and_si256(value, _mm256_set1_epi32(0xffff)), _mm256_setzero_si256());
+        const __m256i ordered = _mm256_permute4x64_epi64(packed, 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(ordered));
+    }
+    static void store(UnsignedByte* dst, IntN value) { store8(dst, value); }
+    static void store(Byte* dst, IntN value) { store8(dst, value); }
+    static void store(UnsignedShort* dst, IntN value) { store16(dst, value); }
+    static void store(Short* dst, IntN value) { store16(dst, value); }
+    static void store(UnsignedInt* dst, IntN value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), value); }
+    static void store(Int* dst, IntN value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), value); }
+};
+
+#include "Magnum/Math/Implementation/packingBatchKernels.hpp"
+
+}
+MAGNUM_MATH_BATCH_SIMD_END
+#endif
+
+#ifdef CORRADE_TARGET_SSE2
+namespace Sse2 {
+
+struct Simd {
+    enum: std::size_t { Width = 4 };
+    typedef __m128 FloatN;
+    typedef __m128i IntN;
+
+    static FloatN splat(Float value) { return _mm_set1_ps(value); }
+    static FloatN load(const Float* src) { return _mm_loadu_ps(src); }
+    static void store(Float* dst, FloatN value) { _mm_storeu_ps(dst, value); }
+    static FloatN divide(FloatN a, FloatN b) { return _mm_div_ps(a, b); }
+    static FloatN multiply(FloatN a, FloatN b) { return _mm_mul_ps(a, b); }
+    static FloatN max(FloatN a, FloatN b) { return _mm_max_ps(a, b); }
+    static FloatN toFloat(IntN value) { return _mm_cvtepi32_ps(value); }
+    static IntN truncate(FloatN value) { return _mm_cvttps_epi32(value); }
+    static IntN round(FloatN value) {
+        const IntN truncated = _mm_cvttps_epi32(value);
+        const FloatN fraction = _mm_sub_ps(value, _mm_cvtepi32_ps(truncated));
+        /* The comparison masks are -1 where true */
+        return _mm_add_epi32(_mm_sub_epi32(truncated,
+            _mm_castps_si128(_mm_cmpge_ps(fraction, _mm_set1_ps(0.5f)))),
+            _mm_castps_si128(_mm_cmple_ps(fraction, _mm_set1_ps(-0.5f))));
+    }
+
+    static IntN load(const UnsignedByte* src) {
+        Int bits;
+        std::memcpy(&bits, src, 4);
+        const __m128i zero = _mm_setzero_si128();
+        return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bits), zero), zero);
+    }
+    static IntN load(const Byte* src) {
+        Int bits;
+        std::memcpy(&bits, src, 4);
+        /* Put each byte into the top of a 32-bit lane and shift it back with
+           sign extension */
+        const __m128i value = _mm_cvtsi32_si128(bits);
+        const __m128i value16 = _mm_unpacklo_epi8(value, value);
+        return _mm_srai_epi32(_mm_unpacklo_epi16(value16, value16), 24);
+    }
+    static IntN load(const UnsignedShort* src) {
+        return _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)), _mm_setzero_si128());
+    }
+    static IntN load(const Short* src) {
+        const __m128i value = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+        return _mm_srai_epi32(_mm_unpacklo_epi16(value, value), 16);
+    }
+    static IntN load(const UnsignedInt* src) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)); }
+    static IntN load(const Int* src) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)); }
+
+    /* Narrowing keeps just the low bits of each lane, the values are masked
+       (and for 16-bit types offset to the signed range) first so the
+       saturating packs don't saturate */
+    static void store8(void* dst, IntN value) {
+        const __m128i packed16 = _mm_packs_epi32(_mm_and_si128(value, _mm_set1_epi32(0xff)), _mm_setzero_si128());
+        const Int bits = _mm_cvtsi128_si32(_mm_packus_epi16(packed16, _mm_setzero_si128()));
+        std::memcpy(dst, &bits, 4);
+    }
+    static void store16(void* dst, IntN value) {
+        const __m128i offset = _mm_sub_epi32(_mm_and_si128(value, _mm_set1_epi32(0xffff)), _mm_set1_epi32(0x8000));
+        const __m128i packed = _mm_xor_si128(_mm_packs_epi32(offset, _mm_setzero_si128()), _mm_set1_epi16(Short(0x8000)));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), packed);
+    }
+    static void store(UnsignedByte* dst, IntN value) { store8(dst, value); }
+    static void store(Byte* dst, IntN value) { store8(dst, value); }
+    static void store(UnsignedShort* dst, IntN value) { store16(dst, value); }
+    static void store(Short* dst, IntN value) { store16(dst, value); }
+    static void store(UnsignedInt* dst, IntN value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), value); }
+    static void store(Int* dst, IntN value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), value); }
+};
+
+#include "Magnum/Math/Implementation/packingBatchKernels.hpp"
+
+}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+namespace Neon {
+
+struct Simd {
+    enum: std::size_t { Width = 4 };
+    typedef float32x4_t FloatN;
+    typedef int32x4_t IntN;
+
+    static FloatN splat(Float value) { return vdupq_n_f32(value); }
+    static FloatN load(const Float* src) { return vld1q_f32(src); }
+    static void store(Float* dst, FloatN value) { vst1q_f32(dst, value); }
+    static FloatN divide(FloatN a, FloatN b) { return vdivq_f32(a, b); }
+    static FloatN multiply(FloatN a, FloatN b) { return vmulq_f32(a, b); }
+    static FloatN max(FloatN a, FloatN b) { return vmaxq_f32(a, b); }
+    static FloatN toFloat(IntN value) { return vcvtq_f32_s32(value); }
+    static IntN truncate(FloatN value) { return vcvtq_s32_f32(value); }
+    /* Rounds half away from zero, same as std::round() */
+    static IntN round(FloatN value) { return vcvtaq_s32_f32(value); }
+
+    static IntN load(const UnsignedByte* src) {
+        UnsignedInt bits;
+        std::memcpy(&bits, src, 4);
+        return vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(bits))))));
+    }
+    static IntN load(const Byte* src) {
+        UnsignedInt bits;
+        std::memcpy(&bits, src, 4);
+        return vmovl_s16(vget_low_s16(vmovl_s8(vreinterpret_s8_u32(vdup_n_u32(bits)))));
+    }
+    static IntN load(const UnsignedShort* src) { return vreinterpretq_s32_u32(vmovl_u16(vld1_u16(src))); }
+    static IntN load(const Short* src) { return vmovl_s16(vld1_s16(src)); }
+    static IntN load(const UnsignedInt* src) { return vreinterpretq_s32_u32(vld1q_u32(src)); }
+    static IntN load(const Int* src) { return vld1q_s32(src); }
+
+    /* The non-saturating narrowing keeps just the low bits of each lane */
+    static void store8(void* dst, IntN value) {
+        const int16x4_t narrowed16 = vmovn_s32(value);
+        const int8x8_t narrowed8 = vmovn_s16(vcombine_s16(narrowed16, narrowed16));
+        const UnsignedInt bits = vget_lane_u32(vreinterpret_u32_s8(narrowed8), 0);
+        std::memcpy(dst, &bits, 4);
+    }
+    static void store(UnsignedByte* dst, IntN value) { store8(dst, value); }
+    static void store(Byte* dst, IntN value) { store8(dst, value); }
+    static void store(UnsignedShort* dst, IntN value) { vst1_u16(dst, vreinterpret_u16_s16(vmovn_s32(value))); }
+    static void store(Short* dst, IntN value) { vst1_s16(dst, vmovn_s32(value)); }
+    static void store(UnsignedInt* dst, IntN value) { vst1q_u32(dst, vreinterpretq_u32_s32(value)); }
+    static void store(Int* dst, IntN value) { vst1q_s32(dst, value); }
+};
+
+#include "Magnum/Math/Implementation/packingBatchKernels.hpp"
+
+}
+#endif
+
+const Kernels* kernelsFor(const Implementation::SimdPath path) {
+    switch(path) {
+        case Implementation::SimdPath::Scalar:
+            return &ScalarKernels;
+        #ifdef CORRADE_TARGET_SSE2
+        case Implementation::SimdPath::Sse2:
+            return &Sse2::kernels;
+        #endif
+        #ifdef MAGNUM_MATH_BATCH_SIMD_AVX
+        case Implementation::SimdPath::Avx2:
+            return Implementation::cpuHasAvx2() ? &Avx2::kernels : nullptr;
+        #endif
+        #if defined(__ARM_NEON) && defined(__aarch64__)
+        case Implementation::SimdPath::Neon:
+            return &Neon::kernels;
+        #endif
+        default:
+            return nullptr;
+    }
+}
+
+struct State {
+    Implementation::SimdPath path;
+    const Kernels* kernels;
+};
+
+State& state() {
+    /* The widest code path supported by both the compiler and the CPU is
+       picked on first use. The paths are ordered from the narrowest, so the
+       last available one wins. */
+    static State state = []{
+        const Implementation::SimdPath paths[]{
+            Implementation::SimdPath::Sse2,
+            Implementation::SimdPath::Neon,
+            Implementation::SimdPath::Avx2
+        };
+        State best{Implementation::SimdPath::Scalar, &ScalarKernels};
+        for(const Implementation::SimdPath path: paths)
+            if(const Kernels* const pathKernels = kernelsFor(path))
+                best = State{path, pathKernels};
+        return best;
+    }();
+    return state;
+}
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
+const Kernels& kernels() {
+    return *state().kernels;
+}
 
-    /* Caching values to avoid inline function calls in ebug builds */
+template<class T> void unpackUnsignedSpan(const T* src, Float* dst, const std::size_t count) {
+    /* Caching values to avoid inline function calls in debug builds */
     constexpr Float bitMax = Implementation::bitMax<T>();
+    for(std::size_t i = 0; i != count; ++i)
+        dst[i] = src[i]/bitMax;
+}
+
+template<class T> void unpackSignedSpan(const T* src, Float* dst, const std::size_t count) {
+    /* Caching values to avoid inline function calls in debug builds */
+    constexpr Float bitMax = Implementation::bitMax<T>();
+    for(std::size_t i = 0; i != count; ++i) {
+        const Float value = src[i]/bitMax;
+        /* Avoiding a max() call in Debug */
+        dst[i] = value < -1.0f ? -1.0f : value;
+    }
+}
+
+template<class T> void packSpan(const Float* src, T* dst, const std::size_t count) {
+    /* Caching values to avoid inline function calls in debug builds */
+    constexpr Float bitMax = Implementation::bitMax<T>();
+    for(std::size_t i = 0; i != count; ++i)
+        /** @todo provide a version that doesn't do rounding */
+        dst[i] = std::round(src[i]*bitMax);
+}
+
+template<class T, class U> void castSpan(const T* src, U* dst, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i)
+        dst[i] = U(src[i]);
+}
+
+/* The SIMD kernel, if any, processes as much as it can, the scalar kernel
+   does the rest */
+template<class T, class U> inline void processSpan(const T* src, U* dst, const std::size_t count, const SimdKernel<T, U> simdKernel, void(*kernel)(const T*, U*, std::size_t)) {
+    const std::size_t i = simdKernel ? simdKernel(src, dst, count) : 0;
+    kernel(src + i, dst + i, count - i);
+}
+
+/* Views contiguous in both dimensions are processed in a single kernel call,
+   which lets the SIMD loop run across row boundaries even if the second
+   dimension is just a few components. Otherwise the kernel is called for
+   each row separately. */
+template<class T, class U> inline void processRows(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<U>& dst, const SimdKernel<T, U> simdKernel, void(*kernel)(const T*, U*, std::size_t)) {
+    if(src.isContiguous() && dst.isContiguous()) {
+        processSpan(static_cast<const T*>(src.data()), static_cast<U*>(dst.data()), src.size()[0]*src.size()[1], simdKernel, kernel);
+        return;
+    }
+
+    /* Caching values to avoid inline function calls in debug builds */
     const char* srcPtr = reinterpret_cast<const char*>(src.data());
     char* dstPtr = reinterpret_cast<char*>(dst.data());
     const std::ptrdiff_t srcStride = src.stride()[0];
     const std::ptrdiff_t dstStride = dst.stride()[0];
     const std::size_t maxJ = src.size()[1];
     for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const T* srcPtrI = reinterpret_cast<const T*>(srcPtr);
-        Float* dstPtrI = reinterpret_cast<Float*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j)
-            *dstPtrI++ = *srcPtrI++/bitMax;
+        processSpan(reinterpret_cast<const T*>(srcPtr), reinterpret_cast<U*>(dstPtr), maxJ, simdKernel, kernel);
 
         srcPtr += srcStride;
         dstPtr += dstStride;
     }
 }
 
+template<class T> inline void unpackUnsignedIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst, const SimdKernel<T, Float> simdKernel) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.template isContiguous<1>() && dst.isContiguous<1>(),
+        "Math::unpackInto(): second view dimension is not contiguous", );
+
+    processRows(src, dst, simdKernel, unpackUnsignedSpan<T>);
+}
+
+}
+
+namespace Implementation {
+
+bool packingBatchHasSimdPath(const SimdPath path) {
+    return kernelsFor(path);
+}
+
+SimdPath packingBatchSimdPath() {
+    return state().path;
+}
+
+void setPackingBatchSimdPath(const SimdPath path) {
+    const Kernels* const pathKernels = kernelsFor(path);
+    CORRADE_INTERNAL_ASSERT(pathKernels);
+    state() = State{path, pathKernels};
+}
+
 }
 
 void unpackInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    unpackUnsignedIntoImplementation(src, dst);
+    unpackUnsignedIntoImplementation(src, dst, kernels().unpackUnsignedByte);
 }
 
 void unpackInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    unpackUnsignedIntoImplementation(src, dst);
+    unpackUnsignedIntoImplementation(src, dst, kernels().unpackUnsignedShort);
 }
 
 namespace {
 
-template<class T> inline void unpackSignedIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
+template<class T> inline void unpackSignedIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst, const SimdKernel<T, Float> simdKernel) {
     CORRADE_ASSERT(src.size() == dst.size(),
         "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
     CORRADE_ASSERT(src.template isContiguous<1>() && dst.isContiguous<1>(),
         "Math::unpackInto(): second view dimension is not contiguous", );
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
-
-    /* Caching values to avoid inline function calls in debug builds */
-    constexpr Float bitMax = Implementation::bitMax<T>();
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const T* srcPtrI = reinterpret_cast<const T*>(srcPtr);
-        Float* dstPtrI = reinterpret_cast<Float*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j) {
-            const Float value = *srcPtrI++/bitMax;
-            /* Avoiding a max() call in Debug */
-            *dstPtrI++ = value < -1.0f ? -1.0f : value;
-        }
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    processRows(src, dst, simdKernel, unpackSignedSpan<T>);
 }
 
 }
 
 void unpackInto(const Corrade::Containers::StridedArrayView2D<const Byte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    unpackSignedIntoImplementation(src, dst);
+    unpackSignedIntoImplementation(src, dst, kernels().unpackByte);
 }
 
 void unpackInto(const Corrade::Containers::StridedArrayView2D<const Short>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    unpackSignedIntoImplementation(src, dst);
+    unpackSignedIntoImplementation(src, dst, kernels().unpackShort);
 }
 
 namespace {
 
-template<class T> inline void packIntoImplementation(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<T>& dst) {
+template<class T> inline void packIntoImplementation(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<T>& dst, const SimdKernel<Float, T> simdKernel) {
     CORRADE_ASSERT(src.size() == dst.size(),
         "Math::packInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
     CORRADE_ASSERT(src.isContiguous<1>() && dst.template isContiguous<1>(),
         "Math::packInto(): second view dimension is not contiguous", );
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
-
-    /* Caching values to avoid inline function calls in debug builds */
-    constexpr Float bitMax = Implementation::bitMax<T>();
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const Float* srcPtrI = reinterpret_cast<const Float*>(srcPtr);
-        T* dstPtrI = reinterpret_cast<T*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j)
-            /** @todo provide a version that doesn't do rounding */
-            *dstPtrI++ = std::round(*srcPtrI++*bitMax);
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    processRows(src, dst, simdKernel, packSpan<T>);
 }
 
 }
 
 void packInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedByte>& dst) {
-    packIntoImplementation(src, dst);
+    packIntoImplementation(src, dst, kernels().packUnsignedByte);
 }
 
 void packInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedShort>& dst) {
-    packIntoImplementation(src, dst);
+    packIntoImplementation(src, dst, kernels().packUnsignedShort);
 }
 
 void packInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Byte>& dst) {
-    packIntoImplementation(src, dst);
+    packIntoImplementation(src, dst, kernels().packByte);
 }
 
 void packInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Short>& dst) {
-    packIntoImplementation(src, dst);
+    packIntoImplementation(src, dst, kernels().packShort);
 }
 
 namespace {
 
-template<class T, class U> inline void castIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<U>& dst) {
+template<class T, class U> inline void castIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<U>& dst, const SimdKernel<T, U> simdKernel) {
     CORRADE_ASSERT(src.size() == dst.size(),
         "Math::castInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
     CORRADE_ASSERT(src.template isContiguous<1>() && dst.template isContiguous<1>(),
         "Math::castInto(): second view dimension is not contiguous", );
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
-
-    /* Caching values to avoid inline function calls in debug buílds */
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const T* srcPtrI = reinterpret_cast<const T*>(srcPtr);
-        U* dstPtrI = reinterpret_cast<U*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j)
-            *dstPtrI++ = U(*srcPtrI++);
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    processRows(src, dst, simdKernel, castSpan<T, U>);
 }
 
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, kernels().castUnsignedByteFloat);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Byte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, kernels().castByteFloat);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, kernels().castUnsignedShortFloat);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Short>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, kernels().castShortFloat);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const UnsignedInt>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation<UnsignedInt, Float>(src, dst, nullptr);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Int>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, kernels().castIntFloat);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedByte>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, kernels().castFloatUnsignedByte);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Byte>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, kernels().castFloatByte);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedShort>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, kernels().castFloatUnsignedShort);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Short>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, kernels().castFloatShort);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedInt>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation<Float, UnsignedInt>(src, dst, nullptr);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Int>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, kernels().castFloatInt);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<UnsignedInt>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, kernels().castUnsignedByteUnsignedInt);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Byte>& src, const Corrade::Containers::StridedArrayView2D<Int>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, kernels().castByteInt);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<UnsignedInt>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, kernels().castUnsignedShortUnsignedInt);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Short>& src, const Corrade::Containers::StridedArrayView2D<Int>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, kernels().castShortInt);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const UnsignedInt>& src, const Corrade::Containers::StridedArrayView2D<UnsignedByte>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, kernels().castUnsignedIntUnsignedByte);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Int>& src, const Corrade::Containers::StridedArrayView2D<Byte>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, kernels().castIntByte);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const UnsignedInt>& src, const Corrade::Containers::StridedArrayView2D<UnsignedShort>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, kernels().castUnsignedIntUnsignedShort);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Int>& src, const Corrade::Containers::StridedArrayView2D<Short>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, kernels().castIntShort);
 }
 
 static_assert(sizeof(HalfMantissaTable) + sizeof(HalfOffsetTable) + sizeof(HalfExponentTable) == 8576,
@@ -0,0 +1,422 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/IntersectionBatch.h"
+#include "Magnum/Math/Implementation/batchSimd.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct IntersectionBatchTest: Corrade::TestSuite::Tester {
+    explicit IntersectionBatchTest();
+
+    void sphereFrustum();
+    void aabbFrustum();
+    void sphereCone();
+    void consistentWithScalar();
+    void resetSimdPath();
+
+    void empty();
+
+    void assertions();
+
+    private:
+        Implementation::SimdPath _defaultSimdPath;
+};
+
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Frustum<Float> Frustum;
+typedef Math::Rad<Float> Rad;
+
+using namespace Literals;
+
+const struct {
+    const char* name;
+    Implementation::SimdPath path;
+} SimdPathData[]{
+    {"scalar", Implementation::SimdPath::Scalar},
+    {"SSE2", Implementation::SimdPath::Sse2},
+    {"AVX", Implementation::SimdPath::Avx},
+    {"NEON", Implementation::SimdPath::Neon}
+};
+
+IntersectionBatchTest::IntersectionBatchTest(): _defaultSimdPath{Implementation::intersectionBatchSimdPath()} {
+    /* Each code path available on the machine is forced in turn and
+       compared against the scalar functions */
+    addInstancedTests<IntersectionBatchTest>({
+        &IntersectionBatchTest::sphereFrustum,
+        &IntersectionBatchTest::aabbFrustum,
+        &IntersectionBatchTest::sphereCone,
+        &IntersectionBatchTest::consistentWithScalar},
+        Corrade::Containers::arraySize(SimdPathData),
+        &IntersectionBatchTest::resetSimdPath,
+        &IntersectionBatchTest::resetSimdPath);
+
+    addTests({&IntersectionBatchTest::empty,
+
+              &IntersectionBatchTest::assertions});
+}
+
+void IntersectionBatchTest::resetSimdPath() {
+    Implementation::setIntersectionBatchSimdPath(_defaultSimdPath);
+}
+
+/* Eleven items in all cases, to test both the SIMD blocks and the scalar
+   remainder for both 4- and 8-wide code paths */
+
+void IntersectionBatchTest::sphereFrustum() {
+
+    auto&& data = SimdPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!Implementation::intersectionBatchHasSimdPath(data.path))
+        CORRADE_SKIP("This code path isn't available on the machine.");
+    Implementation::setIntersectionBatchSimdPath(data.path);
+
+    const Frustum frustum{
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {-1.0f, 0.0f, 0.0f, 10.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f, 10.0f},
+        {0.0f, 0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, -1.0f, 10.0f}};
+
+    /* Interleaved, to test strided input */
+    const struct {
+        Vector3 center;
+        Float radius;
+    } spheres[]{
+        {{5.5f, 5.5f, 5.5f}, 1.5f},         /* inside */
+        {{0.0f, 0.0f, 100.0f}, 0.5f},       /* outside */
+        {{0.0f, 0.0f, -1.0f}, 1.5f},        /* on edge */
+        {{9.0f, 1.0f, 2.0f}, 0.5f},         /* inside */
+        {{-20.0f, 5.0f, 5.0f}, 2.0f},       /* outside */
+        {{10.5f, 5.0f, 5.0f}, 1.0f},        /* on edge */
+        {{5.0f, 15.0f, 5.0f}, 1.0f},        /* outside */
+        {{5.0f, 5.0f, -3.0f}, 1.0f},        /* outside */
+        {{1.0f, 1.0f, 1.0f}, 0.1f},         /* inside */
+        {{5.0f, 5.0f, 5.0f}, 100.0f},       /* bigger than the frustum */
+        {{10.0f, 10.0f, 10.0f}, 0.5f}       /* corner */
+    };
+    Corrade::Containers::StridedArrayView1D<const Vector3> centers{spheres, &spheres[0].center, Corrade::Containers::arraySize(spheres), sizeof(spheres[0])};
+    Corrade::Containers::StridedArrayView1D<const Float> radii{spheres, &spheres[0].radius, Corrade::Containers::arraySize(spheres), sizeof(spheres[0])};
+
+    /* Unused bits should get cleared */
+    UnsignedByte mask[2]{0xff, 0xff};
+    Intersection::sphereFrustumInto(centers, radii, frustum, mask);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(mask),
+        Corrade::Containers::arrayView<UnsignedByte>({0x2d, 0x07}),
+        Corrade::TestSuite::Compare::Container);
+
+    UnsignedInt indices[11];
+    std::size_t count = Intersection::sphereFrustumIndicesInto(centers, radii, frustum, indices);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(indices).prefix(count),
+        Corrade::Containers::arrayView<UnsignedInt>({0, 2, 3, 5, 8, 9, 10}),
+        Corrade::TestSuite::Compare::Container);
+
+    /* Verify it's consistent with the scalar variant */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(spheres); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(bool(mask[i/8] & (1 << i%8)), Intersection::sphereFrustum(spheres[i].center, spheres[i].radius, frustum));
+    }
+}
+
+void IntersectionBatchTest::aabbFrustum() {
+
+    auto&& data = SimdPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!Implementation::intersectionBatchHasSimdPath(data.path))
+        CORRADE_SKIP("This code path isn't available on the machine.");
+    Implementation::setIntersectionBatchSimdPath(data.path);
+
+    const Frustum frustum{
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {-1.0f, 0.0f, 0.0f, 5.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f, 1.0f},
+        {0.0f, 0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, -1.0f, 10.0f}};
+
+    /* Interleaved, to test strided input */
+    const struct {
+        Vector3 center;
+        Vector3 extents;
+    } boxes[]{
+        {Vector3{0.0f}, Vector3{1.0f}},             /* fully inside */
+        {Vector3{-7.5f}, Vector3{2.5f}},            /* outside */
+        {{2.5f, 0.0f, 5.0f}, Vector3{0.1f}},        /* on one plane */
+        {{2.5f, 1.0f, 5.0f}, Vector3{0.1f}},        /* on one plane */
+        {{2.5f, 0.5f, 20.0f}, Vector3{0.1f}},       /* outside */
+        {{0.0f, 0.5f, 5.0f}, Vector3{0.1f}},        /* on one plane */
+        {{5.0f, 0.5f, 5.0f}, Vector3{0.1f}},        /* on one plane */
+        {Vector3{0.0f}, Vector3{100.0f}},           /* bigger than frustum */
+        {{2.5f, -3.0f, 5.0f}, Vector3{1.0f}},       /* outside */
+        {{2.5f, 0.5f, 0.0f}, Vector3{0.1f}},        /* on one plane */
+        {{8.0f, 0.5f, 5.0f}, {2.0f, 0.1f, 0.1f}}    /* outside */
+    };
+    Corrade::Containers::StridedArrayView1D<const Vector3> centers{boxes, &boxes[0].center, Corrade::Containers::arraySize(boxes), sizeof(boxes[0])};
+    Corrade::Containers::StridedArrayView1D<const Vector3> extents{boxes, &boxes[0].extents, Corrade::Containers::arraySize(boxes), sizeof(boxes[0])};
+
+    /* Unused bits should get cleared */
+    UnsignedByte mask[2]{0xff, 0xff};
+    Intersection::aabbFrustumInto(centers, extents, frustum, mask);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(mask),
+        Corrade::Containers::arrayView<UnsignedByte>({0xed, 0x02}),
+        Corrade::TestSuite::Compare::Container);
+
+    UnsignedInt indices[11];
+    std::size_t count = Intersection::aabbFrustumIndicesInto(centers, extents, frustum, indices);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(indices).prefix(count),
+        Corrade::Containers::arrayView<UnsignedInt>({0, 2, 3, 5, 6, 7, 9}),
+        Corrade::TestSuite::Compare::Container);
+
+    /* Verify it's consistent with the scalar variant */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(boxes); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(bool(mask[i/8] & (1 << i%8)), Intersection::aabbFrustum(boxes[i].center, boxes[i].extents, frustum));
+    }
+}
+
+void IntersectionBatchTest::sphereCone() {
+
+    auto&& data = SimdPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!Implementation::intersectionBatchHasSimdPath(data.path))
+        CORRADE_SKIP("This code path isn't available on the machine.");
+    Implementation::setIntersectionBatchSimdPath(data.path);
+
+    const Vector3 center{1.0f, -2.0f, 1.3f};
+    const Vector3 normal{Vector3{0.5f, 1.0f, 2.0f}.normalized()};
+    const Rad halfAngle = Rad{72.0_degf}*0.5f;
+    const Float sinAngle = Math::sin(halfAngle);
+    const Float tanAngleSqPlusOne = 1.0f + Math::pow(Math::tan(halfAngle), 2.0f);
+
+    /* Some vector along the surface of the cone, and a normal of it */
+    const Vector3 axis = Math::cross(Vector3::yAxis(), normal).normalized();
+    const Vector3 surface = Matrix4<Float>::rotation(halfAngle, axis).transformVector(normal);
+    const Vector3 sNormal = Matrix4<Float>::rotation(90.0_degf, axis).transformVector(surface);
+
+    /* Interleaved, to test strided input */
+    const struct {
+        Vector3 center;
+        Float radius;
+    } spheres[]{
+        /* Fully contained in the cone */
+        {center + normal*5.0f, 0.8f},
+        /* Fully contained in the double side of the cone */
+        {center + normal*-5.0f, 0.75f},
+        /* Intersecting the apex, center behind the cone plane */
+        {center - normal*0.1f, 0.55f},
+        /* Intersecting the apex, center in front of the cone plane */
+        {center + normal*0.1f, 0.55f},
+        /* Fully outside of the cone */
+        {center + surface + sNormal*5.0f, 0.75f},
+        /* Fully contained, far away */
+        {center + normal*50.0f, 2.0f},
+        /* Behind the cone, not touching the apex */
+        {center - normal*2.0f, 1.0f},
+        /* Containing the whole apex */
+        {center, 10.0f},
+        /* Intersecting the surface */
+        {center + surface*4.0f + sNormal*0.2f, 0.5f},
+        /* Outside of the surface */
+        {center + surface*4.0f + sNormal*2.0f, 0.5f},
+        /* Fully contained */
+        {center + normal*2.0f, 0.1f}
+    };
+    Corrade::Containers::StridedArrayView1D<const Vector3> centers{spheres, &spheres[0].center, Corrade::Containers::arraySize(spheres), sizeof(spheres[0])};
+    Corrade::Containers::StridedArrayView1D<const Float> radii{spheres, &spheres[0].radius, Corrade::Containers::arraySize(spheres), sizeof(spheres[0])};
+
+    /* Unused bits should get cleared */
+    UnsignedByte mask[2]{0xff, 0xff};
+    Intersection::sphereConeInto(centers, radii, center, normal, sinAngle, tanAngleSqPlusOne, mask);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(mask),
+        Corrade::Containers::arrayView<UnsignedByte>({0xad, 0x05}),
+        Corrade::TestSuite::Compare::Container);
+
+    UnsignedInt indices[11];
+    std::size_t count = Intersection::sphereConeIndicesInto(centers, radii, center, normal, sinAngle, tanAngleSqPlusOne, indices);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(indices).prefix(count),
+        Corrade::Containers::arrayView<UnsignedInt>({0, 2, 3, 5, 7, 8, 10}),
+        Corrade::TestSuite::Compare::Container);
+
+    /* Verify it's consistent with the scalar variant */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(spheres); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(bool(mask[i/8] & (1 << i%8)), Intersection::sphereCone(spheres[i].center, spheres[i].radius, center, normal, sinAngle, tanAngleSqPlusOne));
+    }
+}
+
+void IntersectionBatchTest::consistentWithScalar() {
+    auto&& data = SimdPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!Implementation::intersectionBatchHasSimdPath(data.path))
+        CORRADE_SKIP("This code path isn't available on the machine.");
+    Implementation::setIntersectionBatchSimdPath(data.path);
+
+    /* Deterministic pseudo-random primitives scattered around the frustum
+       and the cone, the count isn't divisible by any vector width to test
+       the remainder handling as well */
+    struct {
+        Vector3 center;
+        Vector3 extents;
+        Float radius;
+    } primitives[1003];
+    UnsignedInt seed = 1;
+    auto random = [&seed](Float min, Float max) {
+        seed = seed*1664525u + 1013904223u;
+        return min + (max - min)*Float(seed >> 8)/Float(1 << 24);
+    };
+    for(auto& primitive: primitives) {
+        primitive.center = {random(-5.0f, 15.0f), random(-5.0f, 15.0f), random(-5.0f, 15.0f)};
+        primitive.extents = {random(0.0f, 3.0f), random(0.0f, 3.0f), random(0.0f, 3.0f)};
+        primitive.radius = random(0.0f, 3.0f);
+    }
+    Corrade::Containers::StridedArrayView1D<const Vector3> centers{primitives, &primitives[0].center, Corrade::Containers::arraySize(primitives), sizeof(primitives[0])};
+    Corrade::Containers::StridedArrayView1D<const Vector3> extents{primitives, &primitives[0].extents, Corrade::Containers::arraySize(primitives), sizeof(primitives[0])};
+    Corrade::Containers::StridedArrayView1D<const Float> radii{primitives, &primitives[0].radius, Corrade::Containers::arraySize(primitives), sizeof(primitives[0])};
+
+    const Frustum frustum{
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {-1.0f, 0.0f, 0.0f, 10.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f, 10.0f},
+        {0.0f, 0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, -1.0f, 10.0f}};
+    const Vector3 coneOrigin{1.0f, -2.0f, 1.3f};
+    const Vector3 coneNormal{Vector3{0.5f, 1.0f, 2.0f}.normalized()};
+    const Rad halfAngle = Rad{72.0_degf}*0.5f;
+    const Float sinAngle = Math::sin(halfAngle);
+    const Float tanAngleSqPlusOne = 1.0f + Math::pow(Math::tan(halfAngle), 2.0f);
+
+    UnsignedByte sphereFrustumMask[126];
+    UnsignedByte aabbFrustumMask[126];
+    UnsignedByte sphereConeMask[126];
+    Intersection::sphereFrustumInto(centers, radii, frustum, sphereFrustumMask);
+    Intersection::aabbFrustumInto(centers, extents, frustum, aabbFrustumMask);
+    Intersection::sphereConeInto(centers, radii, coneOrigin, coneNormal, sinAngle, tanAngleSqPlusOne, sphereConeMask);
+
+    UnsignedInt sphereFrustumIndices[1003];
+    UnsignedInt aabbFrustumIndices[1003];
+    UnsignedInt sphereConeIndices[1003];
+    const std::size_t sphereFrustumCount = Intersection::sphereFrustumIndicesInto(centers, radii, frustum, sphereFrustumIndices);
+    const std::size_t aabbFrustumCount = Intersection::aabbFrustumIndicesInto(centers, extents, frustum, aabbFrustumIndices);
+    const std::size_t sphereConeCount = Intersection::sphereConeIndicesInto(centers, radii, coneOrigin, coneNormal, sinAngle, tanAngleSqPlusOne, sphereConeIndices);
+
+    std::vector<UnsignedInt> expectedSphereFrustumIndices;
+    std::vector<UnsignedInt> expectedAabbFrustumIndices;
+    std::vector<UnsignedInt> expectedSphereConeIndices;
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(primitives); ++i) {
+        CORRADE_ITERATION(i);
+
+        const bool expectedSphereFrustum = Intersection::sphereFrustum(primitives[i].center, primitives[i].radius, frustum);
+        const bool expectedAabbFrustum = Intersection::aabbFrustum(primitives[i].center, primitives[i].extents, frustum);
+        const bool expectedSphereCone = Intersection::sphereCone(primitives[i].center, primitives[i].radius, coneOrigin, coneNormal, sinAngle, tanAngleSqPlusOne);
+        CORRADE_COMPARE(bool(sphereFrustumMask[i/8] & (1 << i%8)), expectedSphereFrustum);
+        CORRADE_COMPARE(bool(aabbFrustumMask[i/8] & (1 << i%8)), expectedAabbFrustum);
+        CORRADE_COMPARE(bool(sphereConeMask[i/8] & (1 << i%8)), expectedSphereCone);
+
+        if(expectedSphereFrustum) expectedSphereFrustumIndices.push_back(UnsignedInt(i));
+        if(expectedAabbFrustum) expectedAabbFrustumIndices.push_back(UnsignedInt(i));
+        if(expectedSphereCone) expectedSphereConeIndices.push_back(UnsignedInt(i));
+    }
+
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(sphereFrustumIndices).prefix(sphereFrustumCount),
+        Corrade::Containers::arrayView(expectedSphereFrustumIndices),
+        Corrade::TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(aabbFrustumIndices).prefix(aabbFrustumCount),
+        Corrade::Containers::arrayView(expectedAabbFrustumIndices),
+        Corrade::TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(sphereConeIndices).prefix(sphereConeCount),
+        Corrade::Containers::arrayView(expectedSphereConeIndices),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void IntersectionBatchTest::empty() {
+    const Frustum frustum;
+
+    /* Shouldn't crash or assert */
+    Intersection::sphereFrustumInto(nullptr, nullptr, frustum, nullptr);
+    Intersection::aabbFrustumInto(nullptr, nullptr, frustum, nullptr);
+    Intersection::sphereConeInto(nullptr, nullptr, {}, Vector3::zAxis(), 0.5f, 2.0f, nullptr);
+    CORRADE_COMPARE(Intersection::sphereFrustumIndicesInto(nullptr, nullptr, frustum, nullptr), 0);
+    CORRADE_COMPARE(Intersection::aabbFrustumIndicesInto(nullptr, nullptr, frustum, nullptr), 0);
+    CORRADE_COMPARE(Intersection::sphereConeIndicesInto(nullptr, nullptr, {}, Vector3::zAxis(), 0.5f, 2.0f, nullptr), 0);
+}
+
+void IntersectionBatchTest::assertions() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const Frustum frustum;
+    const Vector3 centers[9]{};
+    const Float radii[9]{};
+    UnsignedByte mask[2]{};
+    UnsignedInt indices[9]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Intersection::sphereFrustumInto(centers, Corrade::Containers::arrayView(radii).prefix(8), frustum, mask);
+    Intersection::sphereFrustumInto(centers, radii, frustum, Corrade::Containers::arrayView(mask).prefix(1));
+    Intersection::sphereFrustumIndicesInto(centers, Corrade::Containers::arrayView(radii).prefix(8), frustum, indices);
+    Intersection::sphereFrustumIndicesInto(centers, radii, frustum, Corrade::Containers::arrayView(indices).prefix(8));
+    Intersection::aabbFrustumInto(centers, Corrade::Containers::arrayView(centers).prefix(8), frustum, mask);
+    Intersection::aabbFrustumInto(centers, centers, frustum, Corrade::Containers::arrayView(mask).prefix(1));
+    Intersection::aabbFrustumIndicesInto(centers, Corrade::Containers::arrayView(centers).prefix(8), frustum, indices);
+    Intersection::aabbFrustumIndicesInto(centers, centers, frustum, Corrade::Containers::arrayView(indices).prefix(8));
+    Intersection::sphereConeInto(centers, Corrade::Containers::arrayView(radii).prefix(8), {}, Vector3::zAxis(), 0.5f, 2.0f, mask);
+    Intersection::sphereConeInto(centers, radii, {}, Vector3::zAxis(), 0.5f, 2.0f, Corrade::Containers::arrayView(mask).prefix(1));
+    Intersection::sphereConeIndicesInto(centers, Corrade::Containers::arrayView(radii).prefix(8), {}, Vector3::zAxis(), 0.5f, 2.0f, indices);
+    Intersection::sphereConeIndicesInto(centers, radii, {}, Vector3::zAxis(), 0.5f, 2.0f, Corrade::Containers::arrayView(indices).prefix(8));
+    CORRADE_COMPARE(out.str(),
+        "Math::Intersection::sphereFrustumInto(): expected 9 radii but got 8\n"
+        "Math::Intersection::sphereFrustumInto(): wrong mask size, got 1 but expected 2\n"
+        "Math::Intersection::sphereFrustumIndicesInto(): expected 9 radii but got 8\n"
+        "Math::Intersection::sphereFrustumIndicesInto(): expected at least 9 indices but got 8\n"
+        "Math::Intersection::aabbFrustumInto(): expected 9 extents but got 8\n"
+        "Math::Intersection::aabbFrustumInto(): wrong mask size, got 1 but expected 2\n"
+        "Math::Intersection::aabbFrustumIndicesInto(): expected 9 extents but got 8\n"
+        "Math::Intersection::aabbFrustumIndicesInto(): expected at least 9 indices but got 8\n"
+        "Math::Intersection::sphereConeInto(): expected 9 radii but got 8\n"
+        "Math::Intersection::sphereConeInto(): wrong mask size, got 1 but expected 2\n"
+        "Math::Intersection::sphereConeIndicesInto(): expected 9 radii but got 8\n"
+        "Math::Intersection::sphereConeIndicesInto(): expected at least 9 indices but got 8\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::IntersectionBatchTest)
@@ -25,11 +25,17 @@
 */
 
 #include <random>
+#include <string>
 #include <utility>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 
 #include "Magnum/Math/Angle.h"
 #include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/IntersectionBatch.h"
+#include "Magnum/Math/Implementation/batchSimd.h"
 
 namespace Magnum { namespace Math { namespace Test { namespace {
 
@@ -111,6 +117,19 @@ struct IntersectionBenchmark: Corrade::TestSuite::Tester {
     void sphereCone();
     void sphereConeView();
 
+    void sphereFrustumBatchScalar();
+    void sphereFrustumBatchMask();
+    void sphereFrustumBatchIndices();
+    void aabbFrustumBatchScalar();
+    void aabbFrustumBatchMask();
+    void aabbFrustumBatchIndices();
+    void sphereConeBatchScalar();
+    void sphereConeBatchMask();
+    void sphereConeBatchIndices();
+    void resetSimdPath();
+
+    Implementation::SimdPath _defaultSimdPath;
+
     Frustum _frustum;
     struct {
         Vector3 origin;
@@ -121,9 +140,27 @@ struct IntersectionBenchmark: Corrade::TestSuite::Tester {
 
     std::vector<Range3D> _boxes;
     std::vector<Vector4> _spheres;
+
+    /* Structure-of-arrays data for the batch benchmarks */
+    Corrade::Containers::Array<Vector3> _batchCenters;
+    Corrade::Containers::Array<Vector3> _batchExtents;
+    Corrade::Containers::Array<Float> _batchRadii;
 };
 
-IntersectionBenchmark::IntersectionBenchmark() {
+/* Enough to not fit into L1 */
+constexpr std::size_t BatchSize = 16384;
+
+const struct {
+    const char* name;
+    Implementation::SimdPath path;
+} SimdPathData[]{
+    {"scalar", Implementation::SimdPath::Scalar},
+    {"SSE2", Implementation::SimdPath::Sse2},
+    {"AVX", Implementation::SimdPath::Avx},
+    {"NEON", Implementation::SimdPath::Neon}
+};
+
+IntersectionBenchmark::IntersectionBenchmark(): _defaultSimdPath{Implementation::intersectionBatchSimdPath()} {
     addBenchmarks({&IntersectionBenchmark::rangeFrustumNaive,
                    &IntersectionBenchmark::rangeFrustum,
 
@@ -135,6 +172,23 @@ IntersectionBenchmark::IntersectionBenchmark() {
                    &IntersectionBenchmark::sphereCone,
                    &IntersectionBenchmark::sphereConeView}, 10);
 
+    addBenchmarks({&IntersectionBenchmark::sphereFrustumBatchScalar,
+                   &IntersectionBenchmark::aabbFrustumBatchScalar,
+                   &IntersectionBenchmark::sphereConeBatchScalar}, 10);
+
+    /* Each code path available on the machine is benchmarked, the one used
+       by default is reported in the test case description */
+    addInstancedBenchmarks({
+        &IntersectionBenchmark::sphereFrustumBatchMask,
+        &IntersectionBenchmark::sphereFrustumBatchIndices,
+        &IntersectionBenchmark::aabbFrustumBatchMask,
+        &IntersectionBenchmark::aabbFrustumBatchIndices,
+        &IntersectionBenchmark::sphereConeBatchMask,
+        &IntersectionBenchmark::sphereConeBatchIndices}, 10,
+        Corrade::Containers::arraySize(SimdPathData),
+        &IntersectionBenchmark::resetSimdPath,
+        &IntersectionBenchmark::resetSimdPath);
+
     /* Generate random data for the benchmarks */
     std::random_device rnd;
     std::mt19937 g(rnd());
@@ -157,6 +211,15 @@ IntersectionBenchmark::IntersectionBenchmark() {
         _boxes.emplace_back(center - extents, center + extents);
         _spheres.emplace_back(center, extents.length());
     }
+
+    _batchCenters = Corrade::Containers::Array<Vector3>{Corrade::Containers::NoInit, BatchSize};
+    _batchExtents = Corrade::Containers::Array<Vector3>{Corrade::Containers::NoInit, BatchSize};
+    _batchRadii = Corrade::Containers::Array<Float>{Corrade::Containers::NoInit, BatchSize};
+    for(std::size_t i = 0; i != BatchSize; ++i) {
+        _batchCenters[i] = Vector3{pd(g), pd(g), pd(g)};
+        _batchExtents[i] = Math::abs(Vector3{pd(g), pd(g), pd(g)})*0.1f;
+        _batchRadii[i] = _batchExtents[i].length();
+    }
 }
 
 void IntersectionBenchmark::rangeFrustumNaive() {
@@ -221,6 +284,142 @@ void IntersectionBenchmark::sphereConeView() {
     }
 }
 
+void IntersectionBenchmark::resetSimdPath() {
+    Implementation::setIntersectionBatchSimdPath(_defaultSimdPath);
+}
+
+void IntersectionBenchmark::sphereFrustumBatchScalar() {
+    Corrade::Containers::Array<UnsignedByte> mask{Corrade::Containers::ValueInit, (BatchSize + 7)/8};
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != BatchSize; ++i)
+            if(Intersection::sphereFrustum(_batchCenters[i], _batchRadii[i], _frustum))
+                mask[i >> 3] |= 1 << (i & 7);
+    }
+
+    /* Verify the batch variant gives the same result */
+    Corrade::Containers::Array<UnsignedByte> expected{Corrade::Containers::NoInit, (BatchSize + 7)/8};
+    Intersection::sphereFrustumInto(_batchCenters, _batchRadii, _frustum, expected);
+    CORRADE_COMPARE_AS(mask, expected, Corrade::TestSuite::Compare::Container);
+}
+
+void IntersectionBenchmark::sphereFrustumBatchMask() {
+    auto&& data = SimdPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.path == _defaultSimdPath ?
+        std::string{data.name} + " (default)" : data.name);
+
+    if(!Implementation::intersectionBatchHasSimdPath(data.path))
+        CORRADE_SKIP("This code path isn't available on the machine.");
+    Implementation::setIntersectionBatchSimdPath(data.path);
+
+    Corrade::Containers::Array<UnsignedByte> mask{Corrade::Containers::NoInit, (BatchSize + 7)/8};
+    CORRADE_BENCHMARK(10)
+        Intersection::sphereFrustumInto(_batchCenters, _batchRadii, _frustum, mask);
+}
+
+void IntersectionBenchmark::sphereFrustumBatchIndices() {
+    auto&& data = SimdPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.path == _defaultSimdPath ?
+        std::string{data.name} + " (default)" : data.name);
+
+    if(!Implementation::intersectionBatchHasSimdPath(data.path))
+        CORRADE_SKIP("This code path isn't available on the machine.");
+    Implementation::setIntersectionBatchSimdPath(data.path);
+
+    Corrade::Containers::Array<UnsignedInt> indices{Corrade::Containers::NoInit, BatchSize};
+    CORRADE_BENCHMARK(10)
+        Intersection::sphereFrustumIndicesInto(_batchCenters, _batchRadii, _frustum, indices);
+}
+
+void IntersectionBenchmark::aabbFrustumBatchScalar() {
+    Corrade::Containers::Array<UnsignedByte> mask{Corrade::Containers::ValueInit, (BatchSize + 7)/8};
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != BatchSize; ++i)
+            if(Intersection::aabbFrustum(_batchCenters[i], _batchExtents[i], _frustum))
+                mask[i >> 3] |= 1 << (i & 7);
+    }
+
+    /* Verify the batch variant gives the same result */
+    Corrade::Containers::Array<UnsignedByte> expected{Corrade::Containers::NoInit, (BatchSize + 7)/8};
+    Intersection::aabbFrustumInto(_batchCenters, _batchExtents, _frustum, expected);
+    CORRADE_COMPARE_AS(mask, expected, Corrade::TestSuite::Compare::Container);
+}
+
+void IntersectionBenchmark::aabbFrustumBatchMask() {
+    auto&& data = SimdPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.path == _defaultSimdPath ?
+        std::string{data.name} + " (default)" : data.name);
+
+    if(!Implementation::intersectionBatchHasSimdPath(data.path))
+        CORRADE_SKIP("This code path isn't available on the machine.");
+    Implementation::setIntersectionBatchSimdPath(data.path);
+
+    Corrade::Containers::Array<UnsignedByte> mask{Corrade::Containers::NoInit, (BatchSize + 7)/8};
+    CORRADE_BENCHMARK(10)
+        Intersection::aabbFrustumInto(_batchCenters, _batchExtents, _frustum, mask);
+}
+
+void IntersectionBenchmark::aabbFrustumBatchIndices() {
+    auto&& data = SimdPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.path == _defaultSimdPath ?
+        std::string{data.name} + " (default)" : data.name);
+
+    if(!Implementation::intersectionBatchHasSimdPath(data.path))
+        CORRADE_SKIP("This code path isn't available on the machine.");
+    Implementation::setIntersectionBatchSimdPath(data.path);
+
+    Corrade::Containers::Array<UnsignedInt> indices{Corrade::Containers::NoInit, BatchSize};
+    CORRADE_BENCHMARK(10)
+        Intersection::aabbFrustumIndicesInto(_batchCenters, _batchExtents, _frustum, indices);
+}
+
+void IntersectionBenchmark::sphereConeBatchScalar() {
+    const Float sinAngle = Math::sin(_cone.angle*0.5f);
+    const Float tanAngleSqPlusOne = Math::pow<2>(Math::tan(_cone.angle*0.5f)) + 1.0f;
+    Corrade::Containers::Array<UnsignedByte> mask{Corrade::Containers::ValueInit, (BatchSize + 7)/8};
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != BatchSize; ++i)
+            if(Intersection::sphereCone(_batchCenters[i], _batchRadii[i], _cone.origin, _cone.normal, sinAngle, tanAngleSqPlusOne))
+                mask[i >> 3] |= 1 << (i & 7);
+    }
+
+    /* Verify the batch variant gives the same result */
+    Corrade::Containers::Array<UnsignedByte> expected{Corrade::Containers::NoInit, (BatchSize + 7)/8};
+    Intersection::sphereConeInto(_batchCenters, _batchRadii, _cone.origin, _cone.normal, sinAngle, tanAngleSqPlusOne, expected);
+    CORRADE_COMPARE_AS(mask, expected, Corrade::TestSuite::Compare::Container);
+}
+
+void IntersectionBenchmark::sphereConeBatchMask() {
+    auto&& data = SimdPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.path == _defaultSimdPath ?
+        std::string{data.name} + " (default)" : data.name);
+
+    if(!Implementation::intersectionBatchHasSimdPath(data.path))
+        CORRADE_SKIP("This code path isn't available on the machine.");
+    Implementation::setIntersectionBatchSimdPath(data.path);
+
+    const Float sinAngle = Math::sin(_cone.angle*0.5f);
+    const Float tanAngleSqPlusOne = Math::pow<2>(Math::tan(_cone.angle*0.5f)) + 1.0f;
+    Corrade::Containers::Array<UnsignedByte> mask{Corrade::Containers::NoInit, (BatchSize + 7)/8};
+    CORRADE_BENCHMARK(10)
+        Intersection::sphereConeInto(_batchCenters, _batchRadii, _cone.origin, _cone.normal, sinAngle, tanAngleSqPlusOne, mask);
+}
+
+void IntersectionBenchmark::sphereConeBatchIndices() {
+    auto&& data = SimdPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.path == _defaultSimdPath ?
+        std::string{data.name} + " (default)" : data.name);
+
+    if(!Implementation::intersectionBatchHasSimdPath(data.path))
+        CORRADE_SKIP("This code path isn't available on the machine.");
+    Implementation::setIntersectionBatchSimdPath(data.path);
+
+    const Float sinAngle = Math::sin(_cone.angle*0.5f);
+    const Float tanAngleSqPlusOne = Math::pow<2>(Math::tan(_cone.angle*0.5f)) + 1.0f;
+    Corrade::Containers::Array<UnsignedInt> indices{Corrade::Containers::NoInit, BatchSize};
+    CORRADE_BENCHMARK(10)
+        Intersection::sphereConeIndicesInto(_batchCenters, _batchRadii, _cone.origin, _cone.normal, sinAngle, tanAngleSqPlusOne, indices);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::IntersectionBenchmark)
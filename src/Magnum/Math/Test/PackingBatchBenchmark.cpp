@@ -0,0 +1,219 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/PackingBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct PackingBatchBenchmark: Corrade::TestSuite::Tester {
+    explicit PackingBatchBenchmark();
+
+    template<class T> void unpackScalar();
+    template<class T> void unpackContiguous();
+    template<class T> void unpackStrided();
+    template<class T> void packScalar();
+    template<class T> void packContiguous();
+    template<class T> void packStrided();
+    template<class T> void castScalar();
+    template<class T> void castContiguous();
+    template<class T> void castStrided();
+};
+
+PackingBatchBenchmark::PackingBatchBenchmark() {
+    addBenchmarks({
+        &PackingBatchBenchmark::unpackScalar<UnsignedByte>,
+        &PackingBatchBenchmark::unpackContiguous<UnsignedByte>,
+        &PackingBatchBenchmark::unpackStrided<UnsignedByte>,
+        &PackingBatchBenchmark::unpackScalar<Short>,
+        &PackingBatchBenchmark::unpackContiguous<Short>,
+        &PackingBatchBenchmark::unpackStrided<Short>,
+
+        &PackingBatchBenchmark::packScalar<UnsignedByte>,
+        &PackingBatchBenchmark::packContiguous<UnsignedByte>,
+        &PackingBatchBenchmark::packStrided<UnsignedByte>,
+        &PackingBatchBenchmark::packScalar<Short>,
+        &PackingBatchBenchmark::packContiguous<Short>,
+        &PackingBatchBenchmark::packStrided<Short>,
+
+        &PackingBatchBenchmark::castScalar<UnsignedShort>,
+        &PackingBatchBenchmark::castContiguous<UnsignedShort>,
+        &PackingBatchBenchmark::castStrided<UnsignedShort>,
+        &PackingBatchBenchmark::castScalar<Int>,
+        &PackingBatchBenchmark::castContiguous<Int>,
+        &PackingBatchBenchmark::castStrided<Int>}, 100);
+}
+
+/* 16k four-component items. The strided variants process every other item,
+   which makes the rows non-contiguous and forces the per-row code path, so
+   they operate on half the data. */
+enum: std::size_t { Count = 16384, Components = 4 };
+
+template<class T> Corrade::Containers::Array<T> integralData() {
+    Corrade::Containers::Array<T> data{Corrade::Containers::NoInit, Count*Components};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = T(i*37);
+    return data;
+}
+
+Corrade::Containers::Array<Float> floatData() {
+    Corrade::Containers::Array<Float> data{Corrade::Containers::NoInit, Count*Components};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = Float(i%97)/97.0f;
+    return data;
+}
+
+template<class T> void PackingBatchBenchmark::unpackScalar() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<T> src = integralData<T>();
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != src.size(); ++i)
+            dst[i] = Math::unpack<Float>(src[i]);
+    }
+
+    CORRADE_COMPARE(dst[1], Math::unpack<Float>(T(37)));
+}
+
+template<class T> void PackingBatchBenchmark::unpackContiguous() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<T> src = integralData<T>();
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        unpackInto(Corrade::Containers::StridedArrayView2D<const T>{src, {Count, Components}},
+            Corrade::Containers::StridedArrayView2D<Float>{dst, {Count, Components}});
+    }
+
+    CORRADE_COMPARE(dst[1], Math::unpack<Float>(T(37)));
+}
+
+template<class T> void PackingBatchBenchmark::unpackStrided() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<T> src = integralData<T>();
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        unpackInto(Corrade::Containers::StridedArrayView2D<const T>{src, {Count, Components}}.every({2, 1}),
+            Corrade::Containers::StridedArrayView2D<Float>{dst, {Count, Components}}.every({2, 1}));
+    }
+
+    CORRADE_COMPARE(dst[1], Math::unpack<Float>(T(37)));
+}
+
+template<class T> void PackingBatchBenchmark::packScalar() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<Float> src = floatData();
+    Corrade::Containers::Array<T> dst{Corrade::Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != src.size(); ++i)
+            dst[i] = Math::pack<T>(src[i]);
+    }
+
+    CORRADE_COMPARE(dst[1], Math::pack<T>(1.0f/97.0f));
+}
+
+template<class T> void PackingBatchBenchmark::packContiguous() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<Float> src = floatData();
+    Corrade::Containers::Array<T> dst{Corrade::Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        packInto(Corrade::Containers::StridedArrayView2D<const Float>{src, {Count, Components}},
+            Corrade::Containers::StridedArrayView2D<T>{dst, {Count, Components}});
+    }
+
+    CORRADE_COMPARE(dst[1], Math::pack<T>(1.0f/97.0f));
+}
+
+template<class T> void PackingBatchBenchmark::packStrided() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<Float> src = floatData();
+    Corrade::Containers::Array<T> dst{Corrade::Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        packInto(Corrade::Containers::StridedArrayView2D<const Float>{src, {Count, Components}}.every({2, 1}),
+            Corrade::Containers::StridedArrayView2D<T>{dst, {Count, Components}}.every({2, 1}));
+    }
+
+    CORRADE_COMPARE(dst[1], Math::pack<T>(1.0f/97.0f));
+}
+
+template<class T> void PackingBatchBenchmark::castScalar() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<T> src = integralData<T>();
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != src.size(); ++i)
+            dst[i] = Float(src[i]);
+    }
+
+    CORRADE_COMPARE(dst[1], 37.0f);
+}
+
+template<class T> void PackingBatchBenchmark::castContiguous() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<T> src = integralData<T>();
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        castInto(Corrade::Containers::StridedArrayView2D<const T>{src, {Count, Components}},
+            Corrade::Containers::StridedArrayView2D<Float>{dst, {Count, Components}});
+    }
+
+    CORRADE_COMPARE(dst[1], 37.0f);
+}
+
+template<class T> void PackingBatchBenchmark::castStrided() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<T> src = integralData<T>();
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, src.size()};
+
+    CORRADE_BENCHMARK(10) {
+        castInto(Corrade::Containers::StridedArrayView2D<const T>{src, {Count, Components}}.every({2, 1}),
+            Corrade::Containers::StridedArrayView2D<Float>{dst, {Count, Components}}.every({2, 1}));
+    }
+
+    CORRADE_COMPARE(dst[1], 37.0f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::PackingBatchBenchmark)
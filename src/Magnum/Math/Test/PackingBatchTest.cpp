@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <limits>
 #include <sstream>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
@@ -33,6 +34,7 @@
 #include "Magnum/Math/Packing.h"
 #include "Magnum/Math/PackingBatch.h"
 #include "Magnum/Math/Vector4.h"
+#include "Magnum/Math/Implementation/batchSimd.h"
 
 namespace Magnum { namespace Math { namespace Test { namespace {
 
@@ -57,12 +59,30 @@ struct PackingBatchTest: Corrade::TestSuite::Tester {
     template<class T> void castUnsignedInteger();
     template<class T> void castSignedInteger();
 
+    template<class T> void packUnpackContiguous();
+    template<class T, class U> void castIntegerContiguous();
+    template<class T> void castFloatContiguous();
+    void resetSimdPath();
+
     template<class T> void assertionsPackUnpack();
     void assertionsPackUnpackHalf();
     template<class U, class T> void assertionsCast();
+
+    private:
+        Implementation::SimdPath _defaultSimdPath;
+};
+
+const struct {
+    const char* name;
+    Implementation::SimdPath path;
+} SimdPathData[]{
+    {"scalar", Implementation::SimdPath::Scalar},
+    {"SSE2", Implementation::SimdPath::Sse2},
+    {"AVX2", Implementation::SimdPath::Avx2},
+    {"NEON", Implementation::SimdPath::Neon}
 };
 
-PackingBatchTest::PackingBatchTest() {
+PackingBatchTest::PackingBatchTest(): _defaultSimdPath{Implementation::packingBatchSimdPath()} {
     addTests({&PackingBatchTest::unpackUnsignedByte,
               &PackingBatchTest::unpackUnsignedShort,
               &PackingBatchTest::unpackSignedByte,
@@ -85,9 +105,34 @@ PackingBatchTest::PackingBatchTest() {
               &PackingBatchTest::castUnsignedInteger<UnsignedByte>,
               &PackingBatchTest::castUnsignedInteger<UnsignedShort>,
               &PackingBatchTest::castSignedInteger<Byte>,
-              &PackingBatchTest::castSignedInteger<Short>,
-
-              &PackingBatchTest::assertionsPackUnpack<UnsignedByte>,
+              &PackingBatchTest::castSignedInteger<Short>});
+
+    /* Each code path available on the machine is forced in turn and
+       compared against the scalar functions */
+    addInstancedTests<PackingBatchTest>({
+        &PackingBatchTest::packUnpackContiguous<UnsignedByte>,
+        &PackingBatchTest::packUnpackContiguous<UnsignedShort>,
+        &PackingBatchTest::packUnpackContiguous<Byte>,
+        &PackingBatchTest::packUnpackContiguous<Short>,
+        &PackingBatchTest::castIntegerContiguous<UnsignedByte, Float>,
+        &PackingBatchTest::castIntegerContiguous<Short, Float>,
+        &PackingBatchTest::castIntegerContiguous<UnsignedInt, Float>,
+        &PackingBatchTest::castIntegerContiguous<Int, Float>,
+        &PackingBatchTest::castIntegerContiguous<Byte, Int>,
+        &PackingBatchTest::castIntegerContiguous<UnsignedShort, UnsignedInt>,
+        &PackingBatchTest::castIntegerContiguous<UnsignedInt, UnsignedByte>,
+        &PackingBatchTest::castIntegerContiguous<Int, Short>,
+        &PackingBatchTest::castFloatContiguous<UnsignedByte>,
+        &PackingBatchTest::castFloatContiguous<Byte>,
+        &PackingBatchTest::castFloatContiguous<UnsignedShort>,
+        &PackingBatchTest::castFloatContiguous<Short>,
+        &PackingBatchTest::castFloatContiguous<UnsignedInt>,
+        &PackingBatchTest::castFloatContiguous<Int>},
+        Corrade::Containers::arraySize(SimdPathData),
+        &PackingBatchTest::resetSimdPath,
+        &PackingBatchTest::resetSimdPath);
+
+    addTests({&PackingBatchTest::assertionsPackUnpack<UnsignedByte>,
               &PackingBatchTest::assertionsPackUnpack<Byte>,
               &PackingBatchTest::assertionsPackUnpack<UnsignedShort>,
               &PackingBatchTest::assertionsPackUnpack<Short>,
@@ -573,6 +618,102 @@ template<class T> void PackingBatchTest::castSignedInteger() {
         Corrade::TestSuite::Compare::Container);
 }
 
+void PackingBatchTest::resetSimdPath() {
+    Implementation::setPackingBatchSimdPath(_defaultSimdPath);
+}
+
+/* Views contiguous in both dimensions are processed in one go, which goes
+   through the SIMD code paths if enabled. The sizes aren't divisible by any
+   vector width to test the remainder handling as well. */
+template<class T> T contiguousTestValue(std::size_t i) {
+    constexpr Long min = std::numeric_limits<T>::min();
+    constexpr Long range = Long(std::numeric_limits<T>::max()) - min + 1;
+    return T(min + Long(i*0x9e3779b1ull % range));
+}
+
+template<class T> void PackingBatchTest::packUnpackContiguous() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    auto&& data = SimdPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!Implementation::packingBatchHasSimdPath(data.path))
+        CORRADE_SKIP("This code path isn't available on the machine.");
+    Implementation::setPackingBatchSimdPath(data.path);
+
+    T src[37*3];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i)
+        src[i] = contiguousTestValue<T>(i);
+
+    Float unpacked[37*3];
+    unpackInto(Corrade::Containers::StridedArrayView2D<const T>{src, {37, 3}},
+        Corrade::Containers::StridedArrayView2D<Float>{unpacked, {37, 3}});
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(unpacked[i], Math::unpack<Float>(src[i]));
+    }
+
+    /* Packing back should give the original values, except for the minimal
+       signed value that gets clamped to -1 */
+    T packed[37*3];
+    packInto(Corrade::Containers::StridedArrayView2D<const Float>{unpacked, {37, 3}},
+        Corrade::Containers::StridedArrayView2D<T>{packed, {37, 3}});
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(packed[i], Math::pack<T>(unpacked[i]));
+        if(src[i] != std::numeric_limits<T>::min() || !std::is_signed<T>::value)
+            CORRADE_COMPARE(packed[i], src[i]);
+    }
+}
+
+template<class T, class U> void PackingBatchTest::castIntegerContiguous() {
+    setTestCaseTemplateName({TypeTraits<T>::name(), TypeTraits<U>::name()});
+
+    auto&& data = SimdPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!Implementation::packingBatchHasSimdPath(data.path))
+        CORRADE_SKIP("This code path isn't available on the machine.");
+    Implementation::setPackingBatchSimdPath(data.path);
+
+    T src[43*2];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i)
+        src[i] = contiguousTestValue<T>(i);
+
+    U dst[43*2];
+    castInto(Corrade::Containers::StridedArrayView2D<const T>{src, {43, 2}},
+        Corrade::Containers::StridedArrayView2D<U>{dst, {43, 2}});
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(dst[i], U(src[i]));
+    }
+}
+
+template<class T> void PackingBatchTest::castFloatContiguous() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    auto&& data = SimdPathData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!Implementation::packingBatchHasSimdPath(data.path))
+        CORRADE_SKIP("This code path isn't available on the machine.");
+    Implementation::setPackingBatchSimdPath(data.path);
+
+    /* Halving the values to stay in range after the float conversion, the
+       fractional part verifies truncation */
+    Float src[43*2];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i)
+        src[i] = Float(contiguousTestValue<T>(i))*0.5f + 0.25f;
+
+    T dst[43*2];
+    castInto(Corrade::Containers::StridedArrayView2D<const Float>{src, {43, 2}},
+        Corrade::Containers::StridedArrayView2D<T>{dst, {43, 2}});
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(dst[i], T(src[i]));
+    }
+}
+
 template<class T> void PackingBatchTest::assertionsPackUnpack() {
     #ifdef CORRADE_NO_ASSERT
     CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
@@ -275,14 +275,22 @@ Trade::MeshData generateIndices(Trade::MeshData&& data) {
         (Trade::MeshData{MeshPrimitive::Triangles, 0}));
 
     /* Transfer vertex / attribute data as-is, as those don't need any changes.
-       Release if possible. */
+       Release if possible. Externally owned data such as a memory-mapped file
+       stay valid independently of the original instance, so reference them
+       instead of copying. */
     Containers::Array<char> vertexData;
+    Containers::ArrayView<const char> vertexDataView;
     const UnsignedInt vertexCount = data.vertexCount();
-    if(data.vertexDataFlags() & Trade::DataFlag::Owned)
+    const Trade::DataFlags vertexDataFlags = data.vertexDataFlags();
+    if(vertexDataFlags & Trade::DataFlag::Owned) {
         vertexData = data.releaseVertexData();
-    else {
+        vertexDataView = vertexData;
+    } else if(vertexDataFlags & Trade::DataFlag::ExternallyOwned) {
+        vertexDataView = data.vertexData();
+    } else {
         vertexData = Containers::Array<char>{Containers::NoInit, data.vertexData().size()};
         Utility::copy(data.vertexData(), vertexData);
+        vertexDataView = vertexData;
     }
 
     /* Recreate the attribute array with views on the new vertexData */
@@ -292,7 +300,7 @@ Trade::MeshData generateIndices(Trade::MeshData&& data) {
     for(UnsignedInt i = 0, max = attributeData.size(); i != max; ++i) {
         attributeData[i] = Trade::MeshAttributeData{data.attributeName(i),
             data.attributeFormat(i),
-            Containers::StridedArrayView1D<const void>{vertexData, vertexData.data() + data.attributeOffset(i), vertexCount, data.attributeStride(i)},
+            Containers::StridedArrayView1D<const void>{vertexDataView, vertexDataView.data() + data.attributeOffset(i), vertexCount, data.attributeStride(i)},
             data.attributeArraySize(i)};
     }
 
@@ -319,6 +327,9 @@ Trade::MeshData generateIndices(Trade::MeshData&& data) {
         (Trade::MeshData{MeshPrimitive::Triangles, 0}));
 
     Trade::MeshIndexData indices{MeshIndexType::UnsignedInt, indexData};
+    if(vertexDataFlags & Trade::DataFlag::ExternallyOwned)
+        return Trade::MeshData{primitive, std::move(indexData), indices,
+            vertexDataFlags, vertexDataView, std::move(attributeData)};
     return Trade::MeshData{primitive, std::move(indexData), indices,
         std::move(vertexData), std::move(attributeData)};
 }
@@ -329,7 +340,10 @@ Trade::MeshData generateIndices(const Trade::MeshData& data) {
            the reference non-indexed also, if the mesh is indexed, it causes an
            assert inside the delegated generateIndices(). */
         {}, data.indexData(), Trade::MeshIndexData{data.indices()},
-        {}, data.vertexData(), Trade::meshAttributeDataNonOwningArray(data.attributeData()),
+        /* Externally owned vertex data get referenced, everything else is
+           copied */
+        data.vertexDataFlags() & Trade::DataFlag::ExternallyOwned,
+        data.vertexData(), Trade::meshAttributeDataNonOwningArray(data.attributeData()),
         data.vertexCount()});
 }
 
@@ -222,9 +222,12 @@ on it first.
 
 The resulting mesh always has @ref MeshIndexType::UnsignedInt, call
 @ref compressIndices(const Trade::MeshData&, MeshIndexType) on the result to
-compress it to a smaller type, if desired. This function will unconditionally
-make a copy of all vertex data, use @ref generateIndices(Trade::MeshData&&) to
-avoid that copy.
+compress it to a smaller type, if desired. This function will make a copy of
+all vertex data, use @ref generateIndices(Trade::MeshData&&) to avoid that
+copy. The only exception is vertex data marked with
+@ref Trade::DataFlag::ExternallyOwned, such as a memory-mapped file imported
+with @ref Trade::ImporterFlag::ZeroCopy, which are referenced by the returned
+instance instead.
 */
 MAGNUM_MESHTOOLS_EXPORT Trade::MeshData generateIndices(const Trade::MeshData& mesh);
 
@@ -234,8 +237,10 @@ MAGNUM_MESHTOOLS_EXPORT Trade::MeshData generateIndices(const Trade::MeshData& m
 
 Compared to @ref generateIndices(const Trade::MeshData&) this function can
 transfer ownership of @p data vertex buffer (in case it is owned) to the
-returned instance instead of making a copy of it. Attribute data is copied
-always.
+returned instance instead of making a copy of it. If the vertex buffer is
+marked with @ref Trade::DataFlag::ExternallyOwned, the returned instance
+references it with the same @ref Trade::MeshData::vertexDataFlags(). Attribute
+data is copied always.
 @see @ref Trade::MeshData::vertexDataFlags()
 */
 MAGNUM_MESHTOOLS_EXPORT Trade::MeshData generateIndices(Trade::MeshData&& data);
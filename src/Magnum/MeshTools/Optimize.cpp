@@ -0,0 +1,531 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Optimize.h"
+
+#include <algorithm>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Reference.h"
+#include "Magnum/MeshTools/Implementation/Tipsify.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+template<class T> VertexCacheStatistics analyzeVertexCacheImplementation(const Containers::StridedArrayView1D<const T>& indices, const UnsignedInt vertexCount, const UnsignedInt cacheSize) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::analyzeVertexCache(): index count" << indices.size() << "not divisible by 3", {});
+
+    /* A vertex is in the cache if it was inserted less than cacheSize
+       insertions ago, same model as in tipsifyInPlace() */
+    Containers::Array<UnsignedInt> timestamp{vertexCount};
+    UnsignedInt time = cacheSize + 1;
+    UnsignedInt transformedVertexCount = 0;
+    for(const T index: indices) {
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::analyzeVertexCache(): index" << index << "out of bounds for" << vertexCount << "vertices", {});
+        if(time - timestamp[index] > cacheSize) {
+            timestamp[index] = time++;
+            ++transformedVertexCount;
+        }
+    }
+
+    return {transformedVertexCount,
+        indices.empty() ? 0.0f : Float(transformedVertexCount)/(indices.size()/3),
+        vertexCount ? Float(transformedVertexCount)/vertexCount : 0.0f};
+}
+
+/* Size of the modelled LRU cache and precalculated vertex score components
+   from the Forsyth paper. The three most recently used vertices get a lower
+   score to discourage picking a triangle that shares an edge with the last
+   one, which would result in long strips. */
+constexpr UnsignedInt VertexCacheSize = 32;
+constexpr Float CachePositionScore[VertexCacheSize]{
+    0.75f, 0.75f, 0.75f, 1.0f, 0.9487244f, 0.8983564f, 0.8489127f, 0.8004109f,
+    0.7528698f, 0.7063090f, 0.6607498f, 0.6162145f, 0.5727274f, 0.5303144f,
+    0.4890033f, 0.4488243f, 0.4098104f, 0.3719974f, 0.3354247f, 0.3001360f,
+    0.2661797f, 0.2336103f, 0.2024897f, 0.1728888f, 0.1448899f, 0.1185905f,
+    0.0941087f, 0.0715909f, 0.0512263f, 0.0332725f, 0.0181112f, 0.0064033f
+};
+/* 2/sqrt(liveTriangleCount), boosting vertices with few triangles left so
+   they're finished off instead of leaving lone triangles behind */
+constexpr Float LiveTriangleScore[]{
+    0.0f, 2.0f, 1.4142136f, 1.1547005f, 1.0f, 0.8944272f, 0.8164966f,
+    0.7559289f, 0.7071068f, 0.6666667f, 0.6324555f, 0.6030227f, 0.5773503f,
+    0.5547002f, 0.5345225f, 0.5163978f, 0.5f, 0.4850713f, 0.4714045f,
+    0.4588315f, 0.4472136f, 0.4364358f, 0.4264014f, 0.4170288f, 0.4082483f,
+    0.4f, 0.3922323f, 0.3849002f, 0.3779645f, 0.3713907f, 0.3651484f,
+    0.3592106f, 0.3535534f
+};
+
+inline Float vertexScore(const Int cachePosition, const UnsignedInt liveTriangleCount) {
+    /* Vertices with no triangles left shouldn't be picked anymore */
+    if(!liveTriangleCount) return -1.0f;
+
+    return (cachePosition < 0 ? 0.0f : CachePositionScore[cachePosition]) +
+        (liveTriangleCount < Containers::arraySize(LiveTriangleScore) ?
+            LiveTriangleScore[liveTriangleCount] :
+            2.0f/Math::sqrt(Float(liveTriangleCount)));
+}
+
+template<class T> void optimizeVertexCacheInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const UnsignedInt vertexCount) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::optimizeVertexCacheInPlace(): index count" << indices.size() << "not divisible by 3", );
+
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::optimizeVertexCacheInPlace(): index" << index << "out of bounds for" << vertexCount << "vertices", );
+    #endif
+
+    /* Neighboring triangles for each vertex, per-vertex live triangle count.
+       The live triangles of each vertex are kept at the front of its
+       neighbor range. */
+    Containers::Array<UnsignedInt> liveTriangleCount, neighborOffset, neighbors;
+    Implementation::buildAdjacency<T>(indices, vertexCount, liveTriangleCount, neighborOffset, neighbors);
+
+    /* Initial vertex and triangle scores */
+    const std::size_t triangleCount = indices.size()/3;
+    Containers::Array<Int> cachePosition{Containers::DirectInit, vertexCount, -1};
+    Containers::Array<Float> vertexScores{Containers::NoInit, vertexCount};
+    for(UnsignedInt i = 0; i != vertexCount; ++i)
+        vertexScores[i] = vertexScore(-1, liveTriangleCount[i]);
+    Containers::Array<Float> triangleScores{Containers::NoInit, triangleCount};
+    for(std::size_t i = 0; i != triangleCount; ++i)
+        triangleScores[i] = vertexScores[indices[i*3]] + vertexScores[indices[i*3 + 1]] + vertexScores[indices[i*3 + 2]];
+
+    /** @todo Have some bitset/staticbitset class for this */
+    Containers::Array<bool> emitted{triangleCount};
+    Containers::Array<T> outputIndices{Containers::NoInit, indices.size()};
+
+    /* The cache, and space for the new state with three vertices pushed to
+       the front */
+    UnsignedInt cache[VertexCacheSize];
+    UnsignedInt cacheCount = 0;
+    UnsignedInt newCache[VertexCacheSize + 3];
+
+    /* Start with the best triangle overall */
+    std::size_t best = ~std::size_t{};
+    Float bestScore = -1.0f;
+    for(std::size_t i = 0; i != triangleCount; ++i) if(triangleScores[i] > bestScore) {
+        best = i;
+        bestScore = triangleScores[i];
+    }
+
+    std::size_t cursor = 0;
+    for(std::size_t output = 0; output != triangleCount; ++output) {
+        /* None of the cached vertices has any live triangle left, pick the
+           next not-yet-emitted triangle in the original order. Going
+           through the whole array for the best-scoring one would make the
+           algorithm quadratic. */
+        if(best == ~std::size_t{}) {
+            while(emitted[cursor]) ++cursor;
+            best = cursor;
+        }
+
+        /* Emit the triangle, remove it from the live triangles of its
+           vertices and put its vertices to the front of the cache. A
+           degenerate triangle can contain the same vertex more than once. */
+        emitted[best] = true;
+        UnsignedInt newCacheCount = 0;
+        for(std::size_t i = 0; i != 3; ++i) {
+            const UnsignedInt v = indices[best*3 + i];
+            outputIndices[output*3 + i] = v;
+
+            UnsignedInt* const liveBegin = neighbors.data() + neighborOffset[v];
+            UnsignedInt* const liveEnd = liveBegin + liveTriangleCount[v];
+            UnsignedInt* const found = std::find(liveBegin, liveEnd, UnsignedInt(best));
+            CORRADE_INTERNAL_ASSERT(found != liveEnd);
+            std::swap(*found, *(liveEnd - 1));
+            --liveTriangleCount[v];
+
+            if(std::find(newCache, newCache + newCacheCount, v) == newCache + newCacheCount)
+                newCache[newCacheCount++] = v;
+        }
+        for(std::size_t i = 0; i != cacheCount; ++i) {
+            if(std::find(newCache, newCache + newCacheCount, cache[i]) == newCache + newCacheCount)
+                newCache[newCacheCount++] = cache[i];
+        }
+
+        /* Update scores of vertices that got moved in or out of the cache
+           and propagate the difference to their live triangles */
+        for(UnsignedInt i = 0; i != newCacheCount; ++i) {
+            const UnsignedInt v = newCache[i];
+            const Int position = i < VertexCacheSize ? Int(i) : -1;
+            cachePosition[v] = position;
+            const Float score = vertexScore(position, liveTriangleCount[v]);
+            const Float delta = score - vertexScores[v];
+            vertexScores[v] = score;
+            for(UnsignedInt j = 0; j != liveTriangleCount[v]; ++j)
+                triangleScores[neighbors[neighborOffset[v] + j]] += delta;
+        }
+        cacheCount = Math::min(newCacheCount, VertexCacheSize);
+        std::copy_n(newCache, cacheCount, cache);
+
+        /* Pick the best live triangle adjacent to the cached vertices */
+        best = ~std::size_t{};
+        bestScore = -1.0f;
+        for(std::size_t i = 0; i != cacheCount; ++i) {
+            const UnsignedInt v = cache[i];
+            for(UnsignedInt j = 0; j != liveTriangleCount[v]; ++j) {
+                const UnsignedInt triangle = neighbors[neighborOffset[v] + j];
+                if(triangleScores[triangle] > bestScore) {
+                    best = triangle;
+                    bestScore = triangleScores[triangle];
+                }
+            }
+        }
+    }
+
+    Utility::copy(Containers::stridedArrayView(outputIndices), indices);
+}
+
+/* Simulates a FIFO cache for one triangle, returns the count of misses */
+template<class T> UnsignedInt simulateTriangle(const Containers::StridedArrayView1D<const T>& triangle, const Containers::ArrayView<UnsignedInt> timestamp, UnsignedInt& time, const UnsignedInt cacheSize) {
+    UnsignedInt misses = 0;
+    for(const T index: triangle) if(time - timestamp[index] > cacheSize) {
+        timestamp[index] = time++;
+        ++misses;
+    }
+    return misses;
+}
+
+template<class T> void optimizeOverdrawInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Float threshold) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::optimizeOverdrawInPlace(): index count" << indices.size() << "not divisible by 3", );
+
+    constexpr UnsignedInt CacheSize = 16;
+    const std::size_t triangleCount = indices.size()/3;
+    if(!triangleCount) return;
+
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < positions.size(),
+            "MeshTools::optimizeOverdrawInPlace(): index" << index << "out of bounds for" << positions.size() << "vertices", );
+    #endif
+
+    /* Hard cluster boundaries are at triangles where all three vertices
+       miss the cache -- the triangle order can be changed there without
+       affecting the cache efficiency at all. Advancing the time by more
+       than the cache size empties the cache. */
+    Containers::Array<UnsignedInt> timestamp{positions.size()};
+    UnsignedInt time = CacheSize + 1;
+    Containers::Array<std::size_t> hardBoundaries;
+    for(std::size_t i = 0; i != triangleCount; ++i) {
+        if(simulateTriangle<T>(indices.slice(i*3, i*3 + 3), timestamp, time, CacheSize) == 3 || !i)
+            arrayAppend(hardBoundaries, i);
+    }
+    arrayAppend(hardBoundaries, triangleCount);
+
+    /* Split the hard clusters further at points where the cache miss ratio
+       of the cluster prefix is within the threshold of the whole cluster */
+    Containers::Array<std::size_t> clusters;
+    for(std::size_t i = 0; i + 1 < hardBoundaries.size(); ++i) {
+        const std::size_t begin = hardBoundaries[i];
+        const std::size_t end = hardBoundaries[i + 1];
+
+        time += CacheSize + 1;
+        UnsignedInt misses = 0;
+        for(std::size_t j = begin; j != end; ++j)
+            misses += simulateTriangle<T>(indices.slice(j*3, j*3 + 3), timestamp, time, CacheSize);
+        const Float clusterAcmr = Float(misses)/(end - begin);
+
+        time += CacheSize + 1;
+        std::size_t prefixBegin = begin;
+        UnsignedInt prefixMisses = 0;
+        arrayAppend(clusters, begin);
+        for(std::size_t j = begin; j != end; ++j) {
+            prefixMisses += simulateTriangle<T>(indices.slice(j*3, j*3 + 3), timestamp, time, CacheSize);
+            if(j + 1 != end && prefixMisses <= threshold*clusterAcmr*(j + 1 - prefixBegin)) {
+                arrayAppend(clusters, j + 1);
+                prefixBegin = j + 1;
+                prefixMisses = 0;
+                time += CacheSize + 1;
+            }
+        }
+    }
+    arrayAppend(clusters, triangleCount);
+
+    /* Mesh centroid */
+    Vector3 meshCentroid;
+    for(const Vector3& position: positions) meshCentroid += position;
+    meshCentroid /= Float(positions.size());
+
+    /* Sort key for each cluster is the distance of its area-weighted centroid
+       from the mesh centroid along the cluster average normal */
+    const std::size_t clusterCount = clusters.size() - 1;
+    Containers::Array<std::pair<Float, UnsignedInt>> sortKeys{Containers::NoInit, clusterCount};
+    for(std::size_t i = 0; i != clusterCount; ++i) {
+        Vector3 centroid, normal;
+        Float area = 0.0f;
+        for(std::size_t j = clusters[i]; j != clusters[i + 1]; ++j) {
+            const Vector3 a = positions[indices[j*3]];
+            const Vector3 b = positions[indices[j*3 + 1]];
+            const Vector3 c = positions[indices[j*3 + 2]];
+            const Vector3 triangleNormal = Math::cross(b - a, c - a);
+            const Float triangleArea = triangleNormal.length();
+            centroid += (a + b + c)*(triangleArea/3.0f);
+            normal += triangleNormal;
+            area += triangleArea;
+        }
+
+        /* Clusters with only degenerate triangles end up with a zero key */
+        if(area > 0.0f) centroid /= area;
+        else centroid = meshCentroid;
+        const Float normalLength = normal.length();
+        if(normalLength > 0.0f) normal /= normalLength;
+
+        sortKeys[i] = {Math::dot(centroid - meshCentroid, normal), UnsignedInt(i)};
+    }
+
+    /* Clusters facing away from the centroid first, stable so the result is
+       deterministic for clusters with equal keys */
+    std::stable_sort(sortKeys.begin(), sortKeys.end(),
+        [](const std::pair<Float, UnsignedInt>& a, const std::pair<Float, UnsignedInt>& b) {
+            return a.first > b.first;
+        });
+
+    Containers::Array<T> outputIndices{Containers::NoInit, indices.size()};
+    std::size_t output = 0;
+    for(const std::pair<Float, UnsignedInt>& key: sortKeys) {
+        const std::size_t begin = clusters[key.second]*3;
+        const std::size_t end = clusters[key.second + 1]*3;
+        Utility::copy(indices.slice(begin, end), Containers::stridedArrayView(outputIndices).slice(output, output + end - begin));
+        output += end - begin;
+    }
+    CORRADE_INTERNAL_ASSERT(output == indices.size());
+
+    Utility::copy(Containers::stridedArrayView(outputIndices), indices);
+}
+
+template<class T> std::size_t optimizeVertexFetchInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView2D<char>& data) {
+    const std::size_t vertexCount = data.size()[0];
+
+    /* Assign new locations in order of first use */
+    Containers::Array<UnsignedInt> remap{Containers::DirectInit, vertexCount, ~UnsignedInt{}};
+    UnsignedInt next = 0;
+    for(T& index: indices) {
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::optimizeVertexFetchInPlace(): index" << index << "out of bounds for" << vertexCount << "vertices", {});
+        if(remap[index] == ~UnsignedInt{}) remap[index] = next++;
+        index = T(remap[index]);
+    }
+
+    /* Unreferenced vertices go after the referenced ones */
+    const std::size_t referencedCount = next;
+    for(UnsignedInt& i: remap) if(i == ~UnsignedInt{}) i = next++;
+
+    /* Copy the data aside and scatter them to the new locations */
+    Containers::Array<char> dataCopy{Containers::NoInit, data.size()[0]*data.size()[1]};
+    const Containers::StridedArrayView2D<char> copyView{dataCopy, data.size()};
+    Utility::copy(data, copyView);
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        Utility::copy(copyView[i], data[remap[i]]);
+
+    return referencedCount;
+}
+
+}
+
+VertexCacheStatistics analyzeVertexCache(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const UnsignedInt vertexCount, const UnsignedInt cacheSize) {
+    return analyzeVertexCacheImplementation(indices, vertexCount, cacheSize);
+}
+
+VertexCacheStatistics analyzeVertexCache(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const UnsignedInt vertexCount, const UnsignedInt cacheSize) {
+    return analyzeVertexCacheImplementation(indices, vertexCount, cacheSize);
+}
+
+VertexCacheStatistics analyzeVertexCache(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const UnsignedInt vertexCount, const UnsignedInt cacheSize) {
+    return analyzeVertexCacheImplementation(indices, vertexCount, cacheSize);
+}
+
+VertexCacheStatistics analyzeVertexCache(const Containers::StridedArrayView2D<const char>& indices, const UnsignedInt vertexCount, const UnsignedInt cacheSize) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::analyzeVertexCache(): second index view dimension is not contiguous", {});
+    if(indices.size()[1] == 4)
+        return analyzeVertexCache(Containers::arrayCast<1, const UnsignedInt>(indices), vertexCount, cacheSize);
+    else if(indices.size()[1] == 2)
+        return analyzeVertexCache(Containers::arrayCast<1, const UnsignedShort>(indices), vertexCount, cacheSize);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::analyzeVertexCache(): expected index type size 1, 2 or 4 but got" << indices.size()[1], {});
+        return analyzeVertexCache(Containers::arrayCast<1, const UnsignedByte>(indices), vertexCount, cacheSize);
+    }
+}
+
+VertexCacheStatistics analyzeVertexCache(const Trade::MeshData& mesh, const UnsignedInt cacheSize) {
+    CORRADE_ASSERT(mesh.isIndexed(),
+        "MeshTools::analyzeVertexCache(): the mesh is not indexed", {});
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::analyzeVertexCache(): expected a" << MeshPrimitive::Triangles << "mesh but got" << mesh.primitive(), {});
+
+    return analyzeVertexCache(mesh.indices(), mesh.vertexCount(), cacheSize);
+}
+
+void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const UnsignedInt vertexCount) {
+    optimizeVertexCacheInPlaceImplementation(indices, vertexCount);
+}
+
+void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const UnsignedInt vertexCount) {
+    optimizeVertexCacheInPlaceImplementation(indices, vertexCount);
+}
+
+void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const UnsignedInt vertexCount) {
+    optimizeVertexCacheInPlaceImplementation(indices, vertexCount);
+}
+
+void optimizeVertexCacheInPlace(const Containers::StridedArrayView2D<char>& indices, const UnsignedInt vertexCount) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::optimizeVertexCacheInPlace(): second index view dimension is not contiguous", );
+    if(indices.size()[1] == 4)
+        optimizeVertexCacheInPlace(Containers::arrayCast<1, UnsignedInt>(indices), vertexCount);
+    else if(indices.size()[1] == 2)
+        optimizeVertexCacheInPlace(Containers::arrayCast<1, UnsignedShort>(indices), vertexCount);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::optimizeVertexCacheInPlace(): expected index type size 1, 2 or 4 but got" << indices.size()[1], );
+        optimizeVertexCacheInPlace(Containers::arrayCast<1, UnsignedByte>(indices), vertexCount);
+    }
+}
+
+void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Float threshold) {
+    optimizeOverdrawInPlaceImplementation(indices, positions, threshold);
+}
+
+void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Float threshold) {
+    optimizeOverdrawInPlaceImplementation(indices, positions, threshold);
+}
+
+void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Float threshold) {
+    optimizeOverdrawInPlaceImplementation(indices, positions, threshold);
+}
+
+void optimizeOverdrawInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Float threshold) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::optimizeOverdrawInPlace(): second index view dimension is not contiguous", );
+    if(indices.size()[1] == 4)
+        optimizeOverdrawInPlace(Containers::arrayCast<1, UnsignedInt>(indices), positions, threshold);
+    else if(indices.size()[1] == 2)
+        optimizeOverdrawInPlace(Containers::arrayCast<1, UnsignedShort>(indices), positions, threshold);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::optimizeOverdrawInPlace(): expected index type size 1, 2 or 4 but got" << indices.size()[1], );
+        optimizeOverdrawInPlace(Containers::arrayCast<1, UnsignedByte>(indices), positions, threshold);
+    }
+}
+
+std::size_t optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<char>& data) {
+    return optimizeVertexFetchInPlaceImplementation(indices, data);
+}
+
+std::size_t optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<char>& data) {
+    return optimizeVertexFetchInPlaceImplementation(indices, data);
+}
+
+std::size_t optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<char>& data) {
+    return optimizeVertexFetchInPlaceImplementation(indices, data);
+}
+
+std::size_t optimizeVertexFetchInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<char>& data) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::optimizeVertexFetchInPlace(): second index view dimension is not contiguous", {});
+    if(indices.size()[1] == 4)
+        return optimizeVertexFetchInPlace(Containers::arrayCast<1, UnsignedInt>(indices), data);
+    else if(indices.size()[1] == 2)
+        return optimizeVertexFetchInPlace(Containers::arrayCast<1, UnsignedShort>(indices), data);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::optimizeVertexFetchInPlace(): expected index type size 1, 2 or 4 but got" << indices.size()[1], {});
+        return optimizeVertexFetchInPlace(Containers::arrayCast<1, UnsignedByte>(indices), data);
+    }
+}
+
+Trade::MeshData optimizeVertexCache(const Trade::MeshData& mesh) {
+    return optimizeVertexCache(reference(mesh));
+}
+
+Trade::MeshData optimizeVertexCache(Trade::MeshData&& mesh) {
+    CORRADE_ASSERT(mesh.isIndexed(),
+        "MeshTools::optimizeVertexCache(): the mesh is not indexed",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::optimizeVertexCache(): expected a" << MeshPrimitive::Triangles << "mesh but got" << mesh.primitive(),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    /* Turn the passed data into an owned mutable instance we can operate on.
+       There's a chance the original data are already like this, in which case
+       this will be just a passthrough. */
+    Trade::MeshData out = owned(std::move(mesh));
+    optimizeVertexCacheInPlace(out.mutableIndices(), out.vertexCount());
+    return out;
+}
+
+Trade::MeshData optimizeOverdraw(const Trade::MeshData& mesh, const Float threshold) {
+    return optimizeOverdraw(reference(mesh), threshold);
+}
+
+Trade::MeshData optimizeOverdraw(Trade::MeshData&& mesh, const Float threshold) {
+    CORRADE_ASSERT(mesh.isIndexed(),
+        "MeshTools::optimizeOverdraw(): the mesh is not indexed",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::optimizeOverdraw(): expected a" << MeshPrimitive::Triangles << "mesh but got" << mesh.primitive(),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::optimizeOverdraw(): the mesh has no positions",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    Trade::MeshData out = owned(std::move(mesh));
+    optimizeOverdrawInPlace(out.mutableIndices(), out.positions3DAsArray(), threshold);
+    return out;
+}
+
+Trade::MeshData optimizeVertexFetch(const Trade::MeshData& mesh) {
+    return optimizeVertexFetch(reference(mesh));
+}
+
+Trade::MeshData optimizeVertexFetch(Trade::MeshData&& mesh) {
+    CORRADE_ASSERT(mesh.isIndexed(),
+        "MeshTools::optimizeVertexFetch(): the mesh is not indexed",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    /* Turn the passed data into an interleaved owned mutable instance we can
+       operate on -- owned() alone only makes the data owned, interleave()
+       alone only makes the data interleaved (but those can stay non-owned).
+       There's a chance the original data are already like this, in which case
+       this will be just a passthrough. */
+    Trade::MeshData out = owned(interleave(std::move(mesh)));
+    optimizeVertexFetchInPlace(out.mutableIndices(), interleavedMutableData(out));
+    return out;
+}
+
+Trade::MeshData optimize(const Trade::MeshData& mesh, const Float overdrawThreshold) {
+    return optimize(reference(mesh), overdrawThreshold);
+}
+
+Trade::MeshData optimize(Trade::MeshData&& mesh, const Float overdrawThreshold) {
+    return optimizeVertexFetch(optimizeOverdraw(optimizeVertexCache(std::move(mesh)), overdrawThreshold));
+}
+
+}}
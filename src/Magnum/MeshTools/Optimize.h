@@ -0,0 +1,360 @@
+#ifndef Magnum_MeshTools_Optimize_h
+#define Magnum_MeshTools_Optimize_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::MeshTools::VertexCacheStatistics, function @ref Magnum::MeshTools::analyzeVertexCache(), @ref Magnum::MeshTools::optimizeVertexCacheInPlace(), @ref Magnum::MeshTools::optimizeOverdrawInPlace(), @ref Magnum::MeshTools::optimizeVertexFetchInPlace(), @ref Magnum::MeshTools::optimizeVertexCache(), @ref Magnum::MeshTools::optimizeOverdraw(), @ref Magnum::MeshTools::optimizeVertexFetch(), @ref Magnum::MeshTools::optimize()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Vertex cache statistics
+@m_since_latest
+
+@see @ref analyzeVertexCache()
+*/
+struct VertexCacheStatistics {
+    /** @brief Count of vertex shader invocations */
+    UnsignedInt transformedVertexCount;
+
+    /**
+     * @brief Average cache miss ratio
+     *
+     * Vertex shader invocations per triangle. Ranges from @cpp 3.0f @ce for
+     * a mesh with no vertex reuse down to roughly @cpp 0.5f @ce for an ideal
+     * order of a regular grid.
+     */
+    Float acmr;
+
+    /**
+     * @brief Average transformed vertex ratio
+     *
+     * Vertex shader invocations per vertex. @cpp 1.0f @ce is the ideal case
+     * where each vertex is transformed exactly once.
+     */
+    Float atvr;
+};
+
+/**
+@brief Analyze post-transform vertex cache efficiency
+@param indices      Triangle index array
+@param vertexCount  Vertex count
+@param cacheSize    Post-transform vertex cache size
+@m_since_latest
+
+Simulates a FIFO post-transform vertex cache of given size and counts vertex
+shader invocations. Use it to measure the effect of
+@ref optimizeVertexCacheInPlace(), @ref optimizeOverdrawInPlace() or
+@ref tipsifyInPlace(). Expects that the index count is divisible by
+@cpp 3 @ce and all indices are less than @p vertexCount.
+*/
+MAGNUM_MESHTOOLS_EXPORT VertexCacheStatistics analyzeVertexCache(const Containers::StridedArrayView1D<const UnsignedInt>& indices, UnsignedInt vertexCount, UnsignedInt cacheSize = 16);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT VertexCacheStatistics analyzeVertexCache(const Containers::StridedArrayView1D<const UnsignedShort>& indices, UnsignedInt vertexCount, UnsignedInt cacheSize = 16);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT VertexCacheStatistics analyzeVertexCache(const Containers::StridedArrayView1D<const UnsignedByte>& indices, UnsignedInt vertexCount, UnsignedInt cacheSize = 16);
+
+/**
+@brief Analyze post-transform vertex cache efficiency on a type-erased index array
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref analyzeVertexCache(const Containers::StridedArrayView1D<const UnsignedInt>&, UnsignedInt, UnsignedInt)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT VertexCacheStatistics analyzeVertexCache(const Containers::StridedArrayView2D<const char>& indices, UnsignedInt vertexCount, UnsignedInt cacheSize = 16);
+
+/**
+@brief Analyze post-transform vertex cache efficiency of a mesh
+@m_since_latest
+
+Expects that the mesh is indexed and is @ref MeshPrimitive::Triangles. Calls
+@ref analyzeVertexCache(const Containers::StridedArrayView2D<const char>&, UnsignedInt, UnsignedInt)
+with mesh indices and vertex count.
+*/
+MAGNUM_MESHTOOLS_EXPORT VertexCacheStatistics analyzeVertexCache(const Trade::MeshData& mesh, UnsignedInt cacheSize = 16);
+
+/**
+@brief Optimize a mesh for post-transform vertex cache efficiency in-place
+@param[in,out] indices  Triangle index array to operate on
+@param[in] vertexCount  Vertex count
+@m_since_latest
+
+Reorders triangles using the scoring model from *Tom Forsyth --- Linear-Speed
+Vertex Cache Optimisation, 2006, https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html*.
+Each vertex is scored based on its position in a modelled 32-entry LRU cache
+and on the count of its not-yet-emitted triangles and the next triangle is
+picked greedily among those adjacent to cached vertices. Unlike
+@ref tipsifyInPlace(), which assumes a FIFO cache of a known size, the result
+works well across a wide range of hardware cache sizes and designs. Expects
+that the index count is divisible by @cpp 3 @ce and all indices are less than
+@p vertexCount.
+
+Together with @ref optimizeOverdrawInPlace() and
+@ref optimizeVertexFetchInPlace() it forms the @ref optimize() pipeline. Use
+@ref analyzeVertexCache() to measure the gain.
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, UnsignedInt vertexCount);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, UnsignedInt vertexCount);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, UnsignedInt vertexCount);
+
+/**
+@brief Optimize a mesh for post-transform vertex cache efficiency in-place on a type-erased index array
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, UnsignedInt)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCacheInPlace(const Containers::StridedArrayView2D<char>& indices, UnsignedInt vertexCount);
+
+/**
+@brief Optimize a mesh for reduced overdraw in-place
+@param[in,out] indices  Triangle index array to operate on
+@param[in] positions    Vertex positions
+@param[in] threshold    How much can the average cache miss ratio get worse
+@m_since_latest
+
+Splits the index array into clusters at points where a simulated 16-entry
+vertex cache is empty and further where the average cache miss ratio of the
+cluster prefix doesn't exceed @p threshold times the ratio of the whole
+cluster. The clusters are then sorted so the ones facing away from the mesh
+centroid are drawn first, as those are more likely to occlude the rest. Based
+on *Pedro V. Sander, Diego Nehab, and Joshua Barczak --- Fast Triangle
+Reordering for Vertex Locality and Reduced Overdraw, SIGGRAPH 2007*.
+
+Meant to be called after @ref optimizeVertexCacheInPlace(), as the triangle
+order inside the clusters is preserved. A @p threshold of @cpp 1.0f @ce
+keeps the cache efficiency unchanged, larger values allow it to get
+worse in exchange for smaller clusters that can be sorted better. Expects that
+the index count is divisible by @cpp 3 @ce and all indices are in bounds of
+@p positions.
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, Float threshold = 1.05f);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, Float threshold = 1.05f);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, Float threshold = 1.05f);
+
+/**
+@brief Optimize a mesh for reduced overdraw in-place on a type-erased index array
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, Float)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdrawInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, Float threshold = 1.05f);
+
+/**
+@brief Optimize a mesh for vertex fetch efficiency in-place
+@param[in,out] indices  Index array to operate on
+@param[in,out] data     Vertex data to reorder
+@return Count of vertices referenced by @p indices
+@m_since_latest
+
+Reorders the vertex data so vertices are in the order in which they're first
+referenced by @p indices and updates @p indices accordingly, improving memory
+locality of vertex fetch. Vertices that aren't referenced at all are moved
+after all referenced ones with their relative order preserved, their count
+being @cpp data.size()[0] @ce minus the return value. Usable on any primitive,
+expects that all indices are in bounds of @p data.
+
+Meant to be called as the last step, after @ref optimizeVertexCacheInPlace()
+and @ref optimizeOverdrawInPlace(), as it doesn't change the order of the
+indices.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<char>& data);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT std::size_t optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<char>& data);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT std::size_t optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<char>& data);
+
+/**
+@brief Optimize a mesh for vertex fetch efficiency in-place on a type-erased index array
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView2D<char>&)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t optimizeVertexFetchInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<char>& data);
+
+/**
+@brief Optimize a mesh for post-transform vertex cache efficiency
+@m_since_latest
+
+Expects that the mesh is indexed and is @ref MeshPrimitive::Triangles. Calls
+@ref optimizeVertexCacheInPlace(const Containers::StridedArrayView2D<char>&, UnsignedInt)
+on a copy of the index data, the vertex data are passed through unchanged. The
+index type is preserved. This function unconditionally makes a copy of all
+data, use @ref optimizeVertexCache(Trade::MeshData&&) to avoid that.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeVertexCache(const Trade::MeshData& mesh);
+
+/**
+@brief Optimize a mesh for post-transform vertex cache efficiency
+@m_since_latest
+
+Compared to @ref optimizeVertexCache(const Trade::MeshData&) this function can
+operate directly on the index and vertex data, if they're owned by @p mesh,
+instead of making a copy.
+@see @ref Trade::MeshData::indexDataFlags(),
+    @ref Trade::MeshData::vertexDataFlags()
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeVertexCache(Trade::MeshData&& mesh);
+
+/**
+@brief Optimize a mesh for reduced overdraw
+@m_since_latest
+
+Expects that the mesh is indexed, is @ref MeshPrimitive::Triangles and has a
+@ref Trade::MeshAttribute::Position attribute. Calls
+@ref optimizeOverdrawInPlace(const Containers::StridedArrayView2D<char>&, const Containers::StridedArrayView1D<const Vector3>&, Float)
+on a copy of the index data with positions from
+@ref Trade::MeshData::positions3DAsArray(), the vertex data are passed
+through unchanged. The index type is preserved. This function unconditionally
+makes a copy of all data, use @ref optimizeOverdraw(Trade::MeshData&&, Float)
+to avoid that.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeOverdraw(const Trade::MeshData& mesh, Float threshold = 1.05f);
+
+/**
+@brief Optimize a mesh for reduced overdraw
+@m_since_latest
+
+Compared to @ref optimizeOverdraw(const Trade::MeshData&, Float) this function
+can operate directly on the index and vertex data, if they're owned by
+@p mesh, instead of making a copy.
+@see @ref Trade::MeshData::indexDataFlags(),
+    @ref Trade::MeshData::vertexDataFlags()
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeOverdraw(Trade::MeshData&& mesh, Float threshold = 1.05f);
+
+/**
+@brief Optimize a mesh for vertex fetch efficiency
+@m_since_latest
+
+Expects that the mesh is indexed. Makes the vertex data interleaved and owned
+and calls @ref optimizeVertexFetchInPlace(const Containers::StridedArrayView2D<char>&, const Containers::StridedArrayView2D<char>&)
+on them. The index type is preserved and the vertex count stays the same,
+unreferenced vertices end up at the end of the vertex buffer. If the input is
+already interleaved, attribute offsets and paddings are preserved. This
+function unconditionally makes a copy of all data, use
+@ref optimizeVertexFetch(Trade::MeshData&&) to avoid that.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeVertexFetch(const Trade::MeshData& mesh);
+
+/**
+@brief Optimize a mesh for vertex fetch efficiency
+@m_since_latest
+
+Compared to @ref optimizeVertexFetch(const Trade::MeshData&) this function
+can operate directly on the index and vertex data, if they're interleaved and
+owned by @p mesh, instead of making a copy.
+@see @ref Trade::MeshData::indexDataFlags(),
+    @ref Trade::MeshData::vertexDataFlags()
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeVertexFetch(Trade::MeshData&& mesh);
+
+/**
+@brief Optimize a mesh for rendering
+@m_since_latest
+
+Calls @ref optimizeVertexCache(), @ref optimizeOverdraw() with
+@p overdrawThreshold and @ref optimizeVertexFetch() on the mesh, in this order.
+Expects that the mesh is indexed, is @ref MeshPrimitive::Triangles and has a
+@ref Trade::MeshAttribute::Position attribute. Usage example, measuring the
+gain with @ref analyzeVertexCache():
+
+@snippet MagnumMeshTools.cpp optimize
+
+This function unconditionally makes a copy of all data, use
+@ref optimize(Trade::MeshData&&, Float) to avoid that.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimize(const Trade::MeshData& mesh, Float overdrawThreshold = 1.05f);
+
+/**
+@brief Optimize a mesh for rendering
+@m_since_latest
+
+Compared to @ref optimize(const Trade::MeshData&, Float) this function can
+operate directly on the index and vertex data, if they're interleaved and
+owned by @p mesh, instead of making a copy.
+@see @ref Trade::MeshData::indexDataFlags(),
+    @ref Trade::MeshData::vertexDataFlags()
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimize(Trade::MeshData&& mesh, Float overdrawThreshold = 1.05f);
+
+}}
+
+#endif
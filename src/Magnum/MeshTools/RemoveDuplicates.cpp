@@ -28,12 +28,15 @@
 #include <cstring>
 #include <limits>
 #include <numeric>
-#include <unordered_map>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Algorithms.h>
-#include <Corrade/Utility/MurmurHash2.h>
 
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "Magnum/Implementation/parallelFor.h"
 #include "Magnum/Math/FunctionsBatch.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/MeshTools/Reference.h"
@@ -43,27 +46,107 @@
 
 namespace Magnum { namespace MeshTools {
 
-struct ArrayEqual {
-    explicit ArrayEqual(std::size_t size): _size{size} {}
+namespace {
 
-    bool operator()(const void* a, const void* b) const {
-        return std::memcmp(a, b, _size) == 0;
-    }
+/* Each thread hashes at least this many items */
+constexpr std::size_t MinItemsPerThread = 16384;
 
-    private: std::size_t _size;
-};
+std::size_t actualThreadCount(const std::size_t threadCount, const std::size_t size) {
+    return Magnum::Implementation::parallelThreadCount(threadCount, size, MinItemsPerThread);
+}
 
-struct ArrayHash {
-    explicit ArrayHash(std::size_t size): _size{size} {}
+/* Hashes the key eight bytes at a time, with a final avalanche step from
+   MurmurHash3 so both the high and the low bits are well mixed */
+UnsignedInt hashKey(const char* data, std::size_t size) {
+    UnsignedLong hash = size*0x9e3779b97f4a7c15ull;
+    for(; size >= 8; data += 8, size -= 8) {
+        UnsignedLong word;
+        std::memcpy(&word, data, 8);
+        hash = (hash ^ (hash >> 32) ^ word)*0x9e3779b97f4a7c15ull;
+    }
+    if(size) {
+        UnsignedLong word = 0;
+        std::memcpy(&word, data, size);
+        hash = (hash ^ (hash >> 32) ^ word)*0x9e3779b97f4a7c15ull;
+    }
 
-    std::size_t operator()(const void* a) const {
-        return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2{}(static_cast<const char*>(a), _size).byteArray());
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return UnsignedInt(hash);
+}
+
+/* Puts index of the first occurence of each item into `first`. The hash table
+   is split into shards, each owning a range of hashes and filled by a
+   separate thread. Equal items always end up in the same shard, so each shard
+   independently finds the first occurence of every item it owns and the
+   result is the same regardless of the thread count. */
+void findFirstOccurences(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& first, const std::size_t threadCount) {
+    /* Caching values to avoid inline function calls in debug builds */
+    const std::size_t size = data.size()[0];
+    const std::size_t itemSize = data.size()[1];
+    const char* const begin = static_cast<const char*>(data.data());
+    const std::ptrdiff_t stride = data.stride()[0];
+
+    Containers::Array<UnsignedInt> hashes{Containers::NoInit, size};
+    Magnum::Implementation::parallelForRanges(threadCount, size, [&](const std::size_t rangeBegin, const std::size_t rangeEnd) {
+        for(std::size_t i = rangeBegin; i != rangeEnd; ++i)
+            hashes[i] = hashKey(begin + std::ptrdiff_t(i)*stride, itemSize);
+    });
+
+    /* The shard is picked from the high bits of the hash, the slot in the
+       open-addressing table from the low bits. Bucket the item indices by
+       shard so each thread goes only through items it owns. The scatter
+       preserves the original order, so the first item in a bucket that's
+       equal to some other is also its first occurence. */
+    Containers::Array<std::size_t> shardOffsets{Containers::ValueInit, threadCount + 1};
+    for(const UnsignedInt hash: hashes)
+        ++shardOffsets[(UnsignedLong(hash)*threadCount >> 32) + 1];
+    for(std::size_t shard = 0; shard != threadCount; ++shard)
+        shardOffsets[shard + 1] += shardOffsets[shard];
+    Containers::Array<UnsignedInt> shardItems{Containers::NoInit, size};
+    {
+        Containers::Array<std::size_t> shardPositions{Containers::NoInit, threadCount};
+        for(std::size_t shard = 0; shard != threadCount; ++shard)
+            shardPositions[shard] = shardOffsets[shard];
+        for(std::size_t i = 0; i != size; ++i)
+            shardItems[shardPositions[UnsignedLong(hashes[i])*threadCount >> 32]++] = i;
     }
 
-    private: std::size_t _size;
-};
+    Magnum::Implementation::parallelFor(threadCount, [&](const std::size_t shard) {
+        const Containers::ArrayView<const UnsignedInt> items = shardItems.slice(shardOffsets[shard], shardOffsets[shard + 1]);
+        if(items.empty()) return;
+
+        /* Keeping the load factor at most 50% */
+        std::size_t capacity = 1;
+        while(capacity < items.size()*2) capacity <<= 1;
+        const std::size_t mask = capacity - 1;
+        Containers::Array<UnsignedInt> table{Containers::DirectInit, capacity, ~UnsignedInt{}};
+
+        for(const UnsignedInt i: items) {
+            const UnsignedInt hash = hashes[i];
+            const char* const item = begin + std::ptrdiff_t(i)*stride;
+            for(std::size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+                UnsignedInt& firstOccurence = table[slot];
+                if(firstOccurence == ~UnsignedInt{}) {
+                    firstOccurence = i;
+                    first[i] = i;
+                    break;
+                }
+                if(hashes[firstOccurence] == hash && std::memcmp(begin + std::ptrdiff_t(firstOccurence)*stride, item, itemSize) == 0) {
+                    first[i] = firstOccurence;
+                    break;
+                }
+            }
+        }
+    });
+}
 
-std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+}
+
+std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const std::size_t threadCount) {
     /* Assuming the second dimension is contiguous so we can calculate the
        hashes easily */
     CORRADE_ASSERT(data.empty()[0] || data.isContiguous<1>(),
@@ -73,37 +156,23 @@ std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char
     CORRADE_ASSERT(indices.size() == dataSize,
         "MeshTools::removeDuplicatesInto(): output index array has" << indices.size() << "elements but expected" << dataSize, {});
 
-    /* Table containing index of first occurence for each unique entry.
-       Reserving more buckets than necessary (i.e. as if each entry was
-       unique). */
-    std::unordered_map<const void*, UnsignedInt, ArrayHash, ArrayEqual> table{
-        dataSize,
-        ArrayHash{data.size()[1]},
-        ArrayEqual{data.size()[1]}};
+    /* The output index array is directly the index of first occurence for
+       each item, the unique items are those that point to themselves */
+    findFirstOccurences(data, indices, actualThreadCount(threadCount, dataSize));
+    std::size_t uniqueCount = 0;
+    for(std::size_t i = 0; i != dataSize; ++i)
+        if(indices[i] == i) ++uniqueCount;
 
-    /* Go through all entries */
-    for(std::size_t i = 0; i != dataSize; ++i) {
-        /* Try to insert new entry into the table. The inserted index points
-           into the original unchanged data array. */
-        const Containers::ArrayView<const char> entry = data[i].asContiguous();
-        const auto result = table.emplace(entry, i);
-
-        /* Put the (either new or already existing) index into the output
-           index array */
-        indices[i] = result.first->second;
-    }
-
-    CORRADE_INTERNAL_ASSERT(dataSize >= table.size());
-    return table.size();
+    return uniqueCount;
 }
 
-std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicates(const Containers::StridedArrayView2D<const char>& data) {
+std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicates(const Containers::StridedArrayView2D<const char>& data, const std::size_t threadCount) {
     Containers::Array<UnsignedInt> indices{Containers::NoInit, data.size()[0]};
-    const std::size_t size = removeDuplicatesInto(data, indices);
+    const std::size_t size = removeDuplicatesInto(data, indices, threadCount);
     return {std::move(indices), size};
 }
 
-std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const std::size_t threadCount) {
     /* Assuming the second dimension is contiguous so we can calculate the
        hashes easily */
     CORRADE_ASSERT(data.empty()[0] || data.isContiguous<1>(),
@@ -113,57 +182,37 @@ std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<cha
     CORRADE_ASSERT(indices.size() == dataSize,
         "MeshTools::removeDuplicatesInPlaceInto(): output index array has" << indices.size() << "elements but expected" << dataSize, {});
 
-    /* Table containing index of first occurence for each unique entry.
-       Reserving more buckets than necessary (i.e. as if each entry was
-       unique). */
-    std::unordered_map<const void*, UnsignedInt, ArrayHash, ArrayEqual> table{
-        dataSize,
-        ArrayHash{data.size()[1]},
-        ArrayEqual{data.size()[1]}};
-
-    /* Go through all entries and insert them into the table. Because the keys
-       have runtime size, the table doesn't store a copy of the keys, only a
-       reference. The reference is to the original data that we mutate
-       in-place, so extra care needs to be taken to prevent already-inserted
-       keys from getting modified. */
+    findFirstOccurences(data, indices, actualThreadCount(threadCount, dataSize));
+
+    /* First occurences get a new ID and are moved to the front, the rest
+       takes the ID of their first occurence, which was already assigned
+       because it's earlier in the array. Data in [uniqueCount, i) are already
+       present in the [0, uniqueCount) range so we aren't overwriting anything
+       that'd be needed later. */
+    char* const begin = static_cast<char*>(data.data());
+    const std::ptrdiff_t stride = data.stride()[0];
+    const std::size_t itemSize = data.size()[1];
+    std::size_t uniqueCount = 0;
     for(std::size_t i = 0; i != dataSize; ++i) {
-        /* First copy the key data to a potentially final no-longer-mutable
-           place (except if the source and target location is the same). Data
-           in [table.size()-1, i) is already present in the [0, table.size()-1)
-           range from previous iterations so we aren't overwriting anything. If
-           insertion succeeds, this location will not be touched ever again; if
-           it fails the location isn't used as a key anywhere and so it can be
-           reused next time for a different key.
-
-           Alternatively we could first call find() and only then conditionally
-           do a copy() and emplace(), but that means the hash & search would be
-           performed twice, which is never faster than a plain memory copy. */
-        const Containers::ArrayView<char> dst = data[table.size()].asContiguous();
-        if(i != table.size())
-            Utility::copy(data[i].asContiguous(), dst);
-
-        /* Insert the new entry into the table. If it succeeds, dst is
-           guaranteed to not change anymore. */
-        const auto result = table.emplace(dst, table.size());
-
-        /* Put the (either new or already existing) index into the output index
-           array */
-        indices[i] = result.first->second;
+        if(indices[i] == i) {
+            if(i != uniqueCount)
+                std::memcpy(begin + std::ptrdiff_t(uniqueCount)*stride, begin + std::ptrdiff_t(i)*stride, itemSize);
+            indices[i] = uniqueCount++;
+        } else indices[i] = indices[indices[i]];
     }
 
-    CORRADE_INTERNAL_ASSERT(dataSize >= table.size());
-    return table.size();
+    return uniqueCount;
 }
 
-std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>& data) {
+std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>& data, const std::size_t threadCount) {
     Containers::Array<UnsignedInt> indices{Containers::NoInit, data.size()[0]};
-    const std::size_t size = removeDuplicatesInPlaceInto(data, indices);
+    const std::size_t size = removeDuplicatesInPlaceInto(data, indices, threadCount);
     return {std::move(indices), size};
 }
 
 namespace {
 
-template<class IndexType> std::size_t removeDuplicatesIndexedInPlaceImplementation(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView2D<char>& data) {
+template<class IndexType> std::size_t removeDuplicatesIndexedInPlaceImplementation(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView2D<char>& data, const std::size_t threadCount) {
     /* Somehow ~IndexType{} doesn't work for < 4byte types, as the result is
        int(-1) instead of the type I want */
     CORRADE_ASSERT(data.size()[0] <= IndexType(-1),
@@ -174,40 +223,153 @@ template<class IndexType> std::size_t removeDuplicatesIndexedInPlaceImplementati
        original order, which is an useful property. The float version has this
        inverted (having the *Indexed() variant as the main implementation)
        because the remapping there has to be done once for every dimension. */
-    std::pair<Containers::Array<UnsignedInt>, std::size_t> result = removeDuplicatesInPlace(data);
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> result = removeDuplicatesInPlace(data, threadCount);
     for(auto& i: indices) i = result.first[i];
     return result.second;
 }
 
 }
 
-std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<char>& data) {
-    return removeDuplicatesIndexedInPlaceImplementation(indices, data);
+std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<char>& data, const std::size_t threadCount) {
+    return removeDuplicatesIndexedInPlaceImplementation(indices, data, threadCount);
 }
 
-std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<char>& data) {
-    return removeDuplicatesIndexedInPlaceImplementation(indices, data);
+std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<char>& data, const std::size_t threadCount) {
+    return removeDuplicatesIndexedInPlaceImplementation(indices, data, threadCount);
 }
 
-std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<char>& data) {
-    return removeDuplicatesIndexedInPlaceImplementation(indices, data);
+std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<char>& data, const std::size_t threadCount) {
+    return removeDuplicatesIndexedInPlaceImplementation(indices, data, threadCount);
 }
 
-std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<char>& data) {
+std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<char>& data, const std::size_t threadCount) {
     CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::removeDuplicatesIndexedInPlace(): second index view dimension is not contiguous", {});
     if(indices.size()[1] == 4)
-        return removeDuplicatesIndexedInPlace(Containers::arrayCast<1, UnsignedInt>(indices), data);
+        return removeDuplicatesIndexedInPlace(Containers::arrayCast<1, UnsignedInt>(indices), data, threadCount);
     else if(indices.size()[1] == 2)
-        return removeDuplicatesIndexedInPlace(Containers::arrayCast<1, UnsignedShort>(indices), data);
+        return removeDuplicatesIndexedInPlace(Containers::arrayCast<1, UnsignedShort>(indices), data, threadCount);
     else {
         CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::removeDuplicatesIndexedInPlace(): expected index type size 1, 2 or 4 but got" << indices.size()[1], {});
-        return removeDuplicatesIndexedInPlace(Containers::arrayCast<1, UnsignedByte>(indices), data);
+        return removeDuplicatesIndexedInPlace(Containers::arrayCast<1, UnsignedByte>(indices), data, threadCount);
     }
 }
 
 namespace {
 
-template<class IndexType, class T> std::size_t removeDuplicatesFuzzyIndexedInPlaceImplementation(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView2D<T>& data, T epsilon) {
+/* Discretizes items in [begin, end) into cells of epsilon size. In iteration
+   `0` we're not moving in any dimension, in iteration `vectorSize` we're
+   moving in `vectorSize - 1` dimension. Adding a zero move to the other
+   dimensions doesn't change the resulting cell. */
+template<class T, class Cell> std::size_t discretizeComponentInto(const char*, std::ptrdiff_t, Cell*, std::size_t, T, T, T, std::size_t) {
+    return 0;
+}
+
+#ifdef CORRADE_TARGET_SSE2
+/* The cells are gathered from a strided component and scattered to
+   interleaved keys, so it's just the arithmetic that's done four at a time.
+   SSE2 has no conversion to 64-bit integers, so this is only for 32-bit
+   cells. */
+std::size_t discretizeComponentInto(const char* src, const std::ptrdiff_t srcStride, UnsignedInt* dst, const std::size_t dstStride, const Float move, const Float offset, const Float epsilon, const std::size_t count) {
+    const __m128 moveN = _mm_set1_ps(move);
+    const __m128 offsetN = _mm_set1_ps(offset);
+    const __m128 epsilonN = _mm_set1_ps(epsilon);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const __m128 value = _mm_setr_ps(
+            *reinterpret_cast<const Float*>(src),
+            *reinterpret_cast<const Float*>(src + srcStride),
+            *reinterpret_cast<const Float*>(src + 2*srcStride),
+            *reinterpret_cast<const Float*>(src + 3*srcStride));
+        const __m128i cells = _mm_cvttps_epi32(_mm_div_ps(_mm_sub_ps(_mm_add_ps(value, moveN), offsetN), epsilonN));
+
+        UnsignedInt out[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), cells);
+        dst[0] = out[0];
+        dst[dstStride] = out[1];
+        dst[2*dstStride] = out[2];
+        dst[3*dstStride] = out[3];
+
+        src += 4*srcStride;
+        dst += 4*dstStride;
+    }
+
+    return i;
+}
+#endif
+
+template<class T, class Cell> void discretizeInto(const Containers::StridedArrayView2D<const T>& data, const Containers::ArrayView<Cell> cells, const Containers::ArrayView<const T> offsets, const std::size_t moving, const T moveAmount, const T epsilon, const std::size_t begin, const std::size_t end) {
+    /* Going component by component, which allows to hoist the per-component
+       values out of the loop */
+    const std::size_t vectorSize = data.size()[1];
+    const std::ptrdiff_t srcStride = data.stride()[0];
+    for(std::size_t vi = 0; vi != vectorSize; ++vi) {
+        const T move = vi + 1 == moving ? moveAmount : T(0.0);
+        const T offset = offsets[vi];
+        const char* src = static_cast<const char*>(data.data()) + std::ptrdiff_t(begin)*srcStride + std::ptrdiff_t(vi)*data.stride()[1];
+        Cell* dst = cells.data() + begin*vectorSize + vi;
+
+        const std::size_t processed = discretizeComponentInto(src, srcStride, dst, vectorSize, move, offset, epsilon, end - begin);
+        src += std::ptrdiff_t(processed)*srcStride;
+        dst += processed*vectorSize;
+        for(std::size_t i = begin + processed; i != end; ++i, src += srcStride, dst += vectorSize)
+            *dst = Cell((*reinterpret_cast<const T*>(src) + move - offset)/epsilon);
+    }
+}
+
+template<class Cell, class IndexType, class T> std::size_t removeDuplicatesFuzzyIndexedInPlaceDiscretized(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView2D<T>& data, const Containers::ArrayView<const T> offsets, const T epsilon, const std::size_t threadCount) {
+    /* Index array that'll be filled in each pass and then used for remapping
+       the `indices`; discretized storage for all keys. */
+    const std::size_t vectorSize = data.size()[1];
+    std::size_t dataSize = data.size()[0];
+    Containers::Array<UnsignedInt> remapping{Containers::NoInit, dataSize};
+    Containers::Array<Cell> discretized{Containers::NoInit, dataSize*vectorSize};
+
+    /* First go with original coordinates, then move them by epsilon/2 in each
+       dimension. */
+    T moveAmount = T(0.0);
+    for(std::size_t moving = 0; moving <= vectorSize; ++moving) {
+        /* Take the original vectors and discretize them -- add the move
+           amount to given dimension, subtract the minimal offset and divide
+           by epsilon. */
+        const std::size_t passThreadCount = actualThreadCount(threadCount, dataSize);
+        Magnum::Implementation::parallelFor(passThreadCount, [&](const std::size_t thread) {
+            discretizeInto<T, Cell>(data, discretized, offsets, moving, moveAmount, epsilon, dataSize*thread/passThreadCount, dataSize*(thread + 1)/passThreadCount);
+        });
+
+        const Containers::ArrayView<const Cell> keys = discretized.prefix(dataSize*vectorSize);
+        findFirstOccurences(Containers::StridedArrayView2D<const char>{Containers::arrayCast<const char>(keys), {dataSize, vectorSize*sizeof(Cell)}}, remapping.prefix(dataSize), passThreadCount);
+
+        /* First occurences get a new ID and their data are copied to a new
+           (earlier) position in the array, the rest takes the ID of their
+           first occurence. This is a similar workflow to
+           removeDuplicatesInPlaceInto() with the only difference that we're
+           remapping an existing index array several times over instead of
+           creating a new one. */
+        std::size_t uniqueCount = 0;
+        for(std::size_t i = 0; i != dataSize; ++i) {
+            if(remapping[i] == i) {
+                if(i != uniqueCount)
+                    Utility::copy(data[i], data[uniqueCount]);
+                remapping[i] = uniqueCount++;
+            } else remapping[i] = remapping[remapping[i]];
+        }
+
+        /* Remap the resulting index array */
+        for(auto& i: indices) i = remapping[i];
+
+        /* Move vertex coordinates by epsilon/2 in the next dimension (which
+           is moving + 1 in the next loop iteration) */
+        moveAmount = epsilon/2;
+
+        /* Next time go only through the unique prefix */
+        dataSize = uniqueCount;
+    }
+
+    CORRADE_INTERNAL_ASSERT(data.size()[0] >= dataSize);
+    return dataSize;
+}
+
+template<class IndexType, class T> std::size_t removeDuplicatesFuzzyIndexedInPlaceImplementation(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView2D<T>& data, T epsilon, const std::size_t threadCount) {
     /* Compared to the discrete version, we don't require the second dimension
        to be contiguous, as we calculate the hash from a discretized contiguous
        copy */
@@ -238,103 +400,43 @@ template<class IndexType, class T> std::size_t removeDuplicatesFuzzyIndexedInPla
        bounds. */
     epsilon = Math::max(epsilon, range/T(~std::size_t{}));
 
-    /* Table containing original vector index for each discretized vector.
-       Reserving more buckets than necessary (i.e. as if each vector was
-       unique). */
-    std::size_t dataSize = data.size()[0];
-    std::unordered_map<const void*, UnsignedInt, ArrayHash, ArrayEqual> table{
-        dataSize,
-        ArrayHash{data.size()[1]*sizeof(std::size_t)},
-        ArrayEqual{data.size()[1]*sizeof(std::size_t)}};
-
-    /* Index array that'll be filled in each pass and then used for remapping
-       the `indices`; discretized storage for all map keys. */
-    Containers::Array<UnsignedInt> remapping{Containers::NoInit, dataSize};
-    Containers::Array<std::size_t> discretized{Containers::NoInit, dataSize*vectorSize};
-
-    /* First go with original coordinates, then move them by epsilon/2 in each
-       dimension. */
-    T moveAmount = T(0.0);
-    for(std::size_t moving = 0; moving <= vectorSize; ++moving) {
-        for(std::size_t i = 0; i != dataSize; ++i) {
-            /* Take the original vector and discretize it -- append the move
-               amount to given dimension, subtract the minmal offset and divide
-               by epsilon. */
-            const Containers::StridedArrayView1D<T> entry = data[i];
-            const Containers::ArrayView<std::size_t> discretizedEntry = discretized.slice(i*vectorSize, (i + 1)*vectorSize);
-            for(std::size_t vi = 0; vi != vectorSize; ++vi) {
-                T c = entry[vi];
-                /* In iteration `0` we're not moving in any dimension, in
-                   iteration `vectorSize` we're moving in `vectorSize - 1`
-                   dimension */
-                if(vi + 1 == moving) c += moveAmount;
-                discretizedEntry[vi] = (c - offsets[vi])/epsilon;
-            }
-
-            /* Try to insert new entry into the table. The inserted index
-               points into the new data array that has all duplicates removed.
-               This is a similar workflow to removeDuplicatesInPlaceInto() with
-               the only difference that we're remapping an existing index array
-               several times over instead of creating a new one */
-            const auto result = table.emplace(discretizedEntry, table.size());
-
-            /* Add the (either new or already existing) index into the array */
-            remapping[i] = result.first->second;
-
-            /* If this is a new combination, copy the data to new (earlier)
-               position in the array. Data in [table.size()-1, i) are already
-               present in the [0, table.size()-1) range from previous
-               iterations so we aren't overwriting anything. */
-            if(result.second && i != table.size() - 1)
-                Utility::copy(entry, data[table.size() - 1]);
-        }
-
-        /* Remap the resulting index array */
-        for(auto& i: indices) i = remapping[i];
-
-        /* Move vertex coordinates by epsilon/2 in the next dimension (which
-           is moving + 1 in the next loop iteration) */
-        moveAmount = epsilon/2;
-
-        /* Next time go only through the unique prefix; clear the table for the
-           next pass */
-        dataSize = table.size();
-        table.clear();
-    }
-
-    CORRADE_INTERNAL_ASSERT(data.size()[0] >= dataSize);
-    return dataSize;
+    /* If all cells fit into 32 bits, use those -- the keys are half the size
+       and on SSE2 the float discretization can be done four items at a time.
+       The cell values are the same in both cases, so is the result. */
+    if(range/epsilon < T(1u << 30))
+        return removeDuplicatesFuzzyIndexedInPlaceDiscretized<UnsignedInt, IndexType, T>(indices, data, offsets, epsilon, threadCount);
+    return removeDuplicatesFuzzyIndexedInPlaceDiscretized<std::size_t, IndexType, T>(indices, data, offsets, epsilon, threadCount);
 }
 
 }
 
-std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<Float>& data, const Float epsilon) {
-    return removeDuplicatesFuzzyIndexedInPlaceImplementation(indices, data, epsilon);
+std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<Float>& data, const Float epsilon, const std::size_t threadCount) {
+    return removeDuplicatesFuzzyIndexedInPlaceImplementation(indices, data, epsilon, threadCount);
 }
 
-std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<Float>& data, const Float epsilon) {
-    return removeDuplicatesFuzzyIndexedInPlaceImplementation(indices, data, epsilon);
+std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<Float>& data, const Float epsilon, const std::size_t threadCount) {
+    return removeDuplicatesFuzzyIndexedInPlaceImplementation(indices, data, epsilon, threadCount);
 }
 
-std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<Float>& data, const Float epsilon) {
-    return removeDuplicatesFuzzyIndexedInPlaceImplementation(indices, data, epsilon);
+std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<Float>& data, const Float epsilon, const std::size_t threadCount) {
+    return removeDuplicatesFuzzyIndexedInPlaceImplementation(indices, data, epsilon, threadCount);
 }
 
-std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<Double>& data, const Double epsilon) {
-    return removeDuplicatesFuzzyIndexedInPlaceImplementation(indices, data, epsilon);
+std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<Double>& data, const Double epsilon, const std::size_t threadCount) {
+    return removeDuplicatesFuzzyIndexedInPlaceImplementation(indices, data, epsilon, threadCount);
 }
 
-std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<Double>& data, const Double epsilon) {
-    return removeDuplicatesFuzzyIndexedInPlaceImplementation(indices, data, epsilon);
+std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<Double>& data, const Double epsilon, const std::size_t threadCount) {
+    return removeDuplicatesFuzzyIndexedInPlaceImplementation(indices, data, epsilon, threadCount);
 }
 
-std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<Double>& data, const Double epsilon) {
-    return removeDuplicatesFuzzyIndexedInPlaceImplementation(indices, data, epsilon);
+std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<Double>& data, const Double epsilon, const std::size_t threadCount) {
+    return removeDuplicatesFuzzyIndexedInPlaceImplementation(indices, data, epsilon, threadCount);
 }
 
 namespace {
 
-template<class T> std::size_t removeDuplicatesFuzzyInPlaceIntoImplementation(const Containers::StridedArrayView2D<T>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const T epsilon) {
+template<class T> std::size_t removeDuplicatesFuzzyInPlaceIntoImplementation(const Containers::StridedArrayView2D<T>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const T epsilon, const std::size_t threadCount) {
     CORRADE_ASSERT(indices.size() == data.size()[0],
         "MeshTools::removeDuplicatesFuzzyInPlaceInto(): output index array has" << indices.size() << "elements but expected" << data.size()[0], {});
 
@@ -344,66 +446,66 @@ template<class T> std::size_t removeDuplicatesFuzzyInPlaceIntoImplementation(con
     UnsignedInt i = 0;
     for(UnsignedInt& index: indices) index = i++;
 
-    const std::size_t size = removeDuplicatesFuzzyIndexedInPlaceImplementation(Containers::stridedArrayView(indices), data, epsilon);
+    const std::size_t size = removeDuplicatesFuzzyIndexedInPlaceImplementation(Containers::stridedArrayView(indices), data, epsilon, threadCount);
     return size;
 }
 
-template<class T> std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesFuzzyInPlaceImplementation(const Containers::StridedArrayView2D<T>& data, const T epsilon) {
+template<class T> std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesFuzzyInPlaceImplementation(const Containers::StridedArrayView2D<T>& data, const T epsilon, const std::size_t threadCount) {
     Containers::Array<UnsignedInt> indices{Containers::NoInit, data.size()[0]};
-    const std::size_t size = removeDuplicatesFuzzyInPlaceIntoImplementation(data, indices, epsilon);
+    const std::size_t size = removeDuplicatesFuzzyInPlaceIntoImplementation(data, indices, epsilon, threadCount);
     return {std::move(indices), size};
 }
 
 }
 
-std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesFuzzyInPlace(const Containers::StridedArrayView2D<Float>& data, const Float epsilon) {
-    return removeDuplicatesFuzzyInPlaceImplementation(data, epsilon);
+std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesFuzzyInPlace(const Containers::StridedArrayView2D<Float>& data, const Float epsilon, const std::size_t threadCount) {
+    return removeDuplicatesFuzzyInPlaceImplementation(data, epsilon, threadCount);
 }
 
-std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesFuzzyInPlace(const Containers::StridedArrayView2D<Double>& data, const Double epsilon) {
-    return removeDuplicatesFuzzyInPlaceImplementation(data, epsilon);
+std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesFuzzyInPlace(const Containers::StridedArrayView2D<Double>& data, const Double epsilon, const std::size_t threadCount) {
+    return removeDuplicatesFuzzyInPlaceImplementation(data, epsilon, threadCount);
 }
 
-std::size_t removeDuplicatesFuzzyInPlaceInto(const Containers::StridedArrayView2D<Float>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Float epsilon) {
-    return removeDuplicatesFuzzyInPlaceIntoImplementation(data, indices, epsilon);
+std::size_t removeDuplicatesFuzzyInPlaceInto(const Containers::StridedArrayView2D<Float>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Float epsilon, const std::size_t threadCount) {
+    return removeDuplicatesFuzzyInPlaceIntoImplementation(data, indices, epsilon, threadCount);
 }
 
-std::size_t removeDuplicatesFuzzyInPlaceInto(const Containers::StridedArrayView2D<Double>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Double epsilon) {
-    return removeDuplicatesFuzzyInPlaceIntoImplementation(data, indices, epsilon);
+std::size_t removeDuplicatesFuzzyInPlaceInto(const Containers::StridedArrayView2D<Double>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Double epsilon, const std::size_t threadCount) {
+    return removeDuplicatesFuzzyInPlaceIntoImplementation(data, indices, epsilon, threadCount);
 }
 
 namespace {
 
-template<class T> std::size_t removeDuplicatesFuzzyIndexedInPlaceImplementation(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<T>& data, const T epsilon) {
+template<class T> std::size_t removeDuplicatesFuzzyIndexedInPlaceImplementation(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<T>& data, const T epsilon, const std::size_t threadCount) {
     CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::removeDuplicatesFuzzyIndexedInPlace(): second index view dimension is not contiguous", {});
     if(indices.size()[1] == 4)
-        return removeDuplicatesFuzzyIndexedInPlaceImplementation(Containers::arrayCast<1, UnsignedInt>(indices), data, epsilon);
+        return removeDuplicatesFuzzyIndexedInPlaceImplementation(Containers::arrayCast<1, UnsignedInt>(indices), data, epsilon, threadCount);
     else if(indices.size()[1] == 2)
-        return removeDuplicatesFuzzyIndexedInPlaceImplementation(Containers::arrayCast<1, UnsignedShort>(indices), data, epsilon);
+        return removeDuplicatesFuzzyIndexedInPlaceImplementation(Containers::arrayCast<1, UnsignedShort>(indices), data, epsilon, threadCount);
     else {
         CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::removeDuplicatesFuzzyIndexedInPlace(): expected index type size 1, 2 or 4 but got" << indices.size()[1], {});
-        return removeDuplicatesFuzzyIndexedInPlaceImplementation(Containers::arrayCast<1, UnsignedByte>(indices), data, epsilon);
+        return removeDuplicatesFuzzyIndexedInPlaceImplementation(Containers::arrayCast<1, UnsignedByte>(indices), data, epsilon, threadCount);
     }
 }
 
 }
 
-std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<Float>& data, const Float epsilon) {
-    return removeDuplicatesFuzzyIndexedInPlaceImplementation(indices, data, epsilon);
+std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<Float>& data, const Float epsilon, const std::size_t threadCount) {
+    return removeDuplicatesFuzzyIndexedInPlaceImplementation(indices, data, epsilon, threadCount);
 }
 
-std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<Double>& data, const Double epsilon) {
-    return removeDuplicatesFuzzyIndexedInPlaceImplementation(indices, data, epsilon);
+std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<Double>& data, const Double epsilon, const std::size_t threadCount) {
+    return removeDuplicatesFuzzyIndexedInPlaceImplementation(indices, data, epsilon, threadCount);
 }
 
-Trade::MeshData removeDuplicates(const Trade::MeshData& data) {
+Trade::MeshData removeDuplicates(const Trade::MeshData& data, const std::size_t threadCount) {
     return removeDuplicates(Trade::MeshData{data.primitive(),
         {}, data.indexData(), Trade::MeshIndexData{data.indices()},
         {}, data.vertexData(), Trade::meshAttributeDataNonOwningArray(data.attributeData()),
-        data.vertexCount()});
+        data.vertexCount()}, threadCount);
 }
 
-Trade::MeshData removeDuplicates(Trade::MeshData&& data) {
+Trade::MeshData removeDuplicates(Trade::MeshData&& data, const std::size_t threadCount) {
     CORRADE_ASSERT(data.attributeCount(),
         "MeshTools::removeDuplicates(): can't remove duplicates in an attributeless mesh",
         (Trade::MeshData{MeshPrimitive::Points, 0}));
@@ -421,12 +523,12 @@ Trade::MeshData removeDuplicates(Trade::MeshData&& data) {
     Containers::Array<char> indexData;
     MeshIndexType indexType;
     if(ownedInterleaved.isIndexed()) {
-        uniqueVertexCount = removeDuplicatesIndexedInPlace(ownedInterleaved.mutableIndices(), vertexData);
+        uniqueVertexCount = removeDuplicatesIndexedInPlace(ownedInterleaved.mutableIndices(), vertexData, threadCount);
         indexData = ownedInterleaved.releaseIndexData();
         indexType = ownedInterleaved.indexType();
     } else {
         indexData = Containers::Array<char>{Containers::NoInit, ownedInterleaved.vertexCount()*sizeof(UnsignedInt)};
-        uniqueVertexCount = removeDuplicatesInPlaceInto(vertexData, Containers::arrayCast<UnsignedInt>(indexData));
+        uniqueVertexCount = removeDuplicatesInPlaceInto(vertexData, Containers::arrayCast<UnsignedInt>(indexData), threadCount);
         indexType = MeshIndexType::UnsignedInt;
     }
 
@@ -457,7 +559,7 @@ Trade::MeshData removeDuplicates(Trade::MeshData&& data) {
         uniqueVertexCount};
 }
 
-Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, const Float floatEpsilon, const Double doubleEpsilon) {
+Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, const Float floatEpsilon, const Double doubleEpsilon, const std::size_t threadCount) {
     CORRADE_ASSERT(data.attributeCount(),
         "MeshTools::removeDuplicatesFuzzy(): can't remove duplicates in an attributeless mesh",
         (Trade::MeshData{MeshPrimitive::Points, 0}));
@@ -538,7 +640,7 @@ Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, const Float f
                 attributeEpsilon = floatEpsilon*range;
             }
 
-            removeDuplicatesFuzzyInPlaceIntoImplementation(attribute, outputIndices, attributeEpsilon);
+            removeDuplicatesFuzzyInPlaceIntoImplementation(attribute, outputIndices, attributeEpsilon, threadCount);
 
         /* Doubles. No builtin attributes support those at the moment, so
            there's just the epsilon scaling based on attribute value range */
@@ -549,14 +651,14 @@ Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, const Float f
             for(Containers::StridedArrayView1D<const Double> component: attribute.transposed<0, 1>())
                 range = Math::max(Range1Dd{Math::minmax(component)}.size(), range);
 
-            removeDuplicatesFuzzyInPlaceIntoImplementation(attribute, outputIndices, doubleEpsilon*range);
+            removeDuplicatesFuzzyInPlaceIntoImplementation(attribute, outputIndices, doubleEpsilon*range, threadCount);
 
         /* Other attributes (integer, packed, half floats). No fuzzy
            comparison */
         } else {
             const Containers::StridedArrayView2D<char> attribute = owned.mutableAttribute(i);
 
-            removeDuplicatesInPlaceInto(attribute, outputIndices);
+            removeDuplicatesInPlaceInto(attribute, outputIndices, threadCount);
         }
     }
 
@@ -569,12 +671,12 @@ Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, const Float f
         indexData = Containers::Array<char>{combinedIndices.size()[0]*sizeof(UnsignedInt)};
         vertexCount = removeDuplicatesInPlaceInto(
             Containers::arrayCast<2, char>(combinedIndices),
-            Containers::arrayCast<UnsignedInt>(indexData));
+            Containers::arrayCast<UnsignedInt>(indexData), threadCount);
         indexType = MeshIndexType::UnsignedInt;
     } else {
         vertexCount = removeDuplicatesIndexedInPlace(
             owned.mutableIndices(),
-            Containers::arrayCast<2, char>(combinedIndices));
+            Containers::arrayCast<2, char>(combinedIndices), threadCount);
         indexData = owned.releaseIndexData();
         indexType = owned.indexType();
     }
@@ -48,6 +48,8 @@ namespace Magnum { namespace MeshTools {
 @brief Remove duplicate data from given array in-place
 @param[in,out] data Data array, duplicate items will be cut away with order
     preserved
+@param[in] threadCount Count of threads to use. @cpp 0 @ce means all hardware
+    threads.
 @return The resulting index array and size of unique prefix in the cleaned up
     @p data array
 @m_since{2020,06}
@@ -57,24 +59,34 @@ each item, the second dimension is expected to be contiguous. A plain bit-exact
 matching is used, if you need fuzzy comparison for floating-point data, use
 @ref removeDuplicatesFuzzyInPlace() instead. If you want to remove duplicate
 data from an already indexed array, use
-@ref removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView2D<char>&)
+@ref removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView2D<char>&, std::size_t)
 instead. Usage example:
 
 @snippet MagnumMeshTools.cpp removeDuplicates
 
-See @ref removeDuplicates(const Containers::StridedArrayView2D<const char>&)
+See @ref removeDuplicates(const Containers::StridedArrayView2D<const char>&, std::size_t)
 for a variant that doesn't modify the input data in any way but instead returns
 an index array pointing to original data locations.
+
+The unique items are found using an open-addressing hash table. If
+@p threadCount is larger than @cpp 1 @ce, the table is split into shards by
+key hash and each shard is filled on a separate thread, with @cpp 0 @ce
+meaning @ref std::thread::hardware_concurrency() is used. Each thread gets at
+least 16k items, so small inputs are processed on the calling thread only. The
+output is the same regardless of the thread count. On
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" the threads are not used.
 @see @ref Corrade::Containers::StridedArrayView::isContiguous(),
     @ref removeDuplicatesInPlaceInto()
 */
-MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>& data);
+MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>& data, std::size_t threadCount = 1);
 
 /**
 @brief Remove duplicate data from given array in-place into given output index array
 @param[in,out] data     Data array, duplicate items will be cut away with order
     preserved
 @param[out]    indices  Where to put the resulting index array
+@param[in]     threadCount Count of threads to use. @cpp 0 @ce means all
+    hardware threads.
 @return Size of unique prefix in the cleaned up @p data array
 @m_since{2020,06}
 
@@ -82,33 +94,37 @@ Same as above, except that the index array is not allocated but put into
 @p indices instead. Expects that @p indices has the same size as @p data.
 @see @ref removeDuplicatesInto()
 */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices);
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, std::size_t threadCount = 1);
 
 /**
 @brief Remove duplicate data from given array
 @param[in] data     Data array
+@param[in] threadCount Count of threads to use. @cpp 0 @ce means all hardware
+    threads.
 @return The resulting index array and count of unique items in the original
     @p data array
 @m_since{2020,06}
 
-Compared to @ref removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>&)
+Compared to @ref removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>&, std::size_t)
 this function doesn't modify the input data array in any way but instead
 returns an index array pointing to original data locations.
 */
-MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicates(const Containers::StridedArrayView2D<const char>& data);
+MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicates(const Containers::StridedArrayView2D<const char>& data, std::size_t threadCount = 1);
 
 /**
 @brief Remove duplicate data from given array into given output index array
 @param[in]  data    Data array
 @param[out] indices Where to put the resulting index array
+@param[in]  threadCount Count of threads to use. @cpp 0 @ce means all hardware
+    threads.
 @return Count of unique items in the original @p data array
 @m_since{2020,06}
 
-Compared to @ref removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>&, const Containers::StridedArrayView1D<UnsignedInt>&)
+Compared to @ref removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>&, const Containers::StridedArrayView1D<UnsignedInt>&, std::size_t)
 this function doesn't modify the input data array in any way but instead
 makes an index array pointing to original data locations.
 */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices);
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, std::size_t threadCount = 1);
 
 /**
 @brief Remove duplicates from indexed data in-place
@@ -116,26 +132,28 @@ MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInto(const Containers::Strid
     unique data
 @param[in,out] data     Data array, duplicate items will be cut away with order
     preserved
+@param[in]     threadCount Count of threads to use. @cpp 0 @ce means all
+    hardware threads.
 @return Size of unique prefix in the cleaned up @p data array
 @m_since{2020,06}
 
-Compared to @ref removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>&)
+Compared to @ref removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>&, std::size_t)
 this variant is more suited for data that is already indexed as it works on
 the existing index array instead of allocating a new one.
 */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<char>& data);
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<char>& data, std::size_t threadCount = 1);
 
 /**
  * @overload
  * @m_since{2020,06}
  */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<char>& data);
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<char>& data, std::size_t threadCount = 1);
 
 /**
  * @overload
  * @m_since{2020,06}
  */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<char>& data);
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<char>& data, std::size_t threadCount = 1);
 
 /**
 @brief Remove duplicates from indexed data in-place on a type-erased index array
@@ -143,10 +161,10 @@ MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Contain
 
 Expects that the second dimension of @p indices is contiguous and represents
 the actual 1/2/4-byte index type. Based on its size then calls one of the
-@ref removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView2D<char>&)
+@ref removeDuplicatesIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView2D<char>&, std::size_t)
 etc. overloads.
 */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<char>& data);
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<char>& data, std::size_t threadCount = 1);
 
 /**
 @brief Remove duplicate data from given array using fuzzy comparison in-place
@@ -154,6 +172,8 @@ MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Contain
     preserved
 @param[in] epsilon  Epsilon value, data closer than this distance will be
     melt together
+@param[in] threadCount Count of threads to use. @cpp 0 @ce means all hardware
+    threads.
 @return Size of unique prefix in the cleaned up @p data array and the resulting
     index array
 @m_since{2020,06}
@@ -162,24 +182,29 @@ Removes duplicate data from the array by collapsing them into buckets of size
 @p epsilon. First vector in given bucket is used, other ones are thrown away,
 no interpolation is done. Note that this function is meant to be used for
 floating-point data (or generally with non-zero @p epsilon), for data where
-bit-exact matching is sufficient use @ref removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>&)
+bit-exact matching is sufficient use @ref removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>&, std::size_t)
 instead.
 
 If you want to remove duplicate data from an already indexed array, use
-@ref removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView2D<Float>&, Float)
+@ref removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView2D<Float>&, Float, std::size_t)
 and friends instead.
 
 If you want to remove duplicates in multiple incidental arrays, first remove
 duplicates in each array separately and then combine the resulting index arrays
 back into a single one using @ref combineIndexedAttributes().
+
+With @p threadCount larger than @cpp 1 @ce, both the discretization and the
+hash table lookup is split across threads, the output is the same regardless
+of the thread count. See @ref removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>&, std::size_t)
+for more information.
 */
-MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesFuzzyInPlace(const Containers::StridedArrayView2D<Float>& data, Float epsilon = Math::TypeTraits<Float>::epsilon());
+MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesFuzzyInPlace(const Containers::StridedArrayView2D<Float>& data, Float epsilon = Math::TypeTraits<Float>::epsilon(), std::size_t threadCount = 1);
 
 /**
  * @overload
  * @m_since{2020,06}
  */
-MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesFuzzyInPlace(const Containers::StridedArrayView2D<Double>& data, Double epsilon = Math::TypeTraits<Double>::epsilon());
+MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesFuzzyInPlace(const Containers::StridedArrayView2D<Double>& data, Double epsilon = Math::TypeTraits<Double>::epsilon(), std::size_t threadCount = 1);
 
 /**
 @brief Remove duplicate data from given array using fuzzy comparison in-place into given output index array
@@ -188,19 +213,21 @@ MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> r
 @param[out] indices Where to put the resulting index array
 @param[in] epsilon  Epsilon value, data closer than this distance will be
     melt together
+@param[in] threadCount Count of threads to use. @cpp 0 @ce means all hardware
+    threads.
 @return Size of unique prefix in the cleaned up @p data array
 @m_since{2020,06}
 
 Same as above, except that the index array is not allocated but put into
 @p indices instead. Expects that @p indices has the same size as @p data.
 */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyInPlaceInto(const Containers::StridedArrayView2D<Float>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, Float epsilon = Math::TypeTraits<Float>::epsilon());
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyInPlaceInto(const Containers::StridedArrayView2D<Float>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, Float epsilon = Math::TypeTraits<Float>::epsilon(), std::size_t threadCount = 1);
 
 /**
  * @overload
  * @m_since{2020,06}
  */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyInPlaceInto(const Containers::StridedArrayView2D<Double>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, Double epsilon = Math::TypeTraits<Double>::epsilon());
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyInPlaceInto(const Containers::StridedArrayView2D<Double>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, Double epsilon = Math::TypeTraits<Double>::epsilon(), std::size_t threadCount = 1);
 
 #ifdef MAGNUM_BUILD_DEPRECATED
 /**
@@ -232,44 +259,46 @@ template<class Vector> CORRADE_DEPRECATED("use removeDuplicatesInPlace() instead
     preserved
 @param[in] epsilon      Epsilon value, vertices closer than this distance will
     be melt together
+@param[in] threadCount  Count of threads to use. @cpp 0 @ce means all hardware
+    threads.
 @return Size of unique prefix in the cleaned up @p data array
 @m_since{2020,06}
 
-Compared to @ref removeDuplicatesFuzzyInPlace(const Containers::StridedArrayView2D<Float>&, Float)
+Compared to @ref removeDuplicatesFuzzyInPlace(const Containers::StridedArrayView2D<Float>&, Float, std::size_t)
 this variant is more suited for data that is already indexed as it works on
 the existing index array instead of allocating a new one.
 */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<Float>& data, Float epsilon = Math::TypeTraits<Float>::epsilon());
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<Float>& data, Float epsilon = Math::TypeTraits<Float>::epsilon(), std::size_t threadCount = 1);
 
 /**
  * @overload
  * @m_since{2020,06}
  */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<Float>& data, Float epsilon = Math::TypeTraits<Float>::epsilon());
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<Float>& data, Float epsilon = Math::TypeTraits<Float>::epsilon(), std::size_t threadCount = 1);
 
 /**
  * @overload
  * @m_since{2020,06}
  */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<Float>& data, Float epsilon = Math::TypeTraits<Float>::epsilon());
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<Float>& data, Float epsilon = Math::TypeTraits<Float>::epsilon(), std::size_t threadCount = 1);
 
 /**
  * @overload
  * @m_since{2020,06}
  */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<Double>& data, Double epsilon = Math::TypeTraits<Double>::epsilon());
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<Double>& data, Double epsilon = Math::TypeTraits<Double>::epsilon(), std::size_t threadCount = 1);
 
 /**
  * @overload
  * @m_since{2020,06}
  */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<Double>& data, Double epsilon = Math::TypeTraits<Double>::epsilon());
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<Double>& data, Double epsilon = Math::TypeTraits<Double>::epsilon(), std::size_t threadCount = 1);
 
 /**
  * @overload
  * @m_since{2020,06}
  */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<Double>& data, Double epsilon = Math::TypeTraits<Double>::epsilon());
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<Double>& data, Double epsilon = Math::TypeTraits<Double>::epsilon(), std::size_t threadCount = 1);
 
 /**
 @brief Remove duplicates from indexed data using fuzzy comparison in-place on a type-erased index array
@@ -277,16 +306,16 @@ MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Co
 
 Expects that the second dimension of @p indices is contiguous and represents
 the actual 1/2/4-byte index type. Based on its size then calls
-@ref removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView2D<Float>&, Float)
+@ref removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView2D<Float>&, Float, std::size_t)
 or the other overloads.
 */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<Float>& data, Float epsilon = Math::TypeTraits<Float>::epsilon());
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<Float>& data, Float epsilon = Math::TypeTraits<Float>::epsilon(), std::size_t threadCount = 1);
 
 /**
  * @overload
  * @m_since{2020,06}
  */
-MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<Double>& data, Double epsilon = Math::TypeTraits<Double>::epsilon());
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<Double>& data, Double epsilon = Math::TypeTraits<Double>::epsilon(), std::size_t threadCount = 1);
 
 /**
 @brief Remove mesh data duplicates
@@ -304,32 +333,34 @@ and paddings are preserved.
 This function unconditionally copies and interleaves passed vertex and index
 data in order to operate on them in-place. If your data is interleaved and
 owned by the instance and you don't need the original data after the process,
-call @ref removeDuplicates(Trade::MeshData&&) instead to avoid the extra copy.
+call @ref removeDuplicates(Trade::MeshData&&, std::size_t) instead to avoid the
+extra copy. The @p threadCount is passed through to the above functions.
 */
-MAGNUM_MESHTOOLS_EXPORT Trade::MeshData removeDuplicates(const Trade::MeshData& data);
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData removeDuplicates(const Trade::MeshData& data, std::size_t threadCount = 1);
 
 /**
 @brief Remove mesh data duplicates
 @m_since{2020,06}
 
-Same as @ref removeDuplicates(const Trade::MeshData&), except that it operates
-in-place on the passed instance, avoiding an extra copy of vertex and index
-data.
+Same as @ref removeDuplicates(const Trade::MeshData&, std::size_t), except
+that it operates in-place on the passed instance, avoiding an extra copy of
+vertex and index data.
 */
-MAGNUM_MESHTOOLS_EXPORT Trade::MeshData removeDuplicates(Trade::MeshData&& data);
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData removeDuplicates(Trade::MeshData&& data, std::size_t threadCount = 1);
 
 /**
 @brief Remove mesh data duplicates with fuzzy comparison for floating-point attributes
 @m_since{2020,06}
 
-Compared to @ref removeDuplicates(const Trade::MeshData&), calls
+Compared to @ref removeDuplicates(const Trade::MeshData&, std::size_t), calls
 @ref removeDuplicatesFuzzyInPlace() or @ref removeDuplicatesFuzzyIndexedInPlace()
 on floating-point attributes. For attributes with a known range (such as
 @ref Trade::MeshAttribute::Normal being always @f$ [-1, 1] @f$ in each
 direction) the @p floatEpsilon / @p doubleEpsilon is scaled appropriately,
-otherwise it's scaled to calculated value range.
+otherwise it's scaled to calculated value range. The @p threadCount is passed
+through to the above functions.
 */
-MAGNUM_MESHTOOLS_EXPORT Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, Float floatEpsilon = Math::TypeTraits<Float>::epsilon(), Double doubleEpsilon = Math::TypeTraits<Double>::epsilon());
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, Float floatEpsilon = Math::TypeTraits<Float>::epsilon(), Double doubleEpsilon = Math::TypeTraits<Double>::epsilon(), std::size_t threadCount = 1);
 
 #ifdef MAGNUM_BUILD_DEPRECATED
 template<class Vector> std::vector<UnsignedInt> removeDuplicates(std::vector<Vector>& data, typename Vector::Type epsilon) {
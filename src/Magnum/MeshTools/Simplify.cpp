@@ -0,0 +1,538 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Simplify.h"
+
+#include <algorithm>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Optimize.h"
+#include "Magnum/MeshTools/Reference.h"
+#include "Magnum/MeshTools/RemoveDuplicates.h"
+#include "Magnum/MeshTools/Implementation/Tipsify.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Vertex classification. Manifold vertices can be collapsed onto anything,
+   border and seam vertices only along the border / seam onto a vertex of the
+   same kind, locked vertices never. */
+enum class VertexKind: UnsignedByte {
+    Manifold,
+    Border,
+    Seam,
+    Locked
+};
+
+constexpr bool CanCollapse[4][4]{
+    {true, true, true, true},
+    {false, true, false, false},
+    {false, false, true, false},
+    {false, false, false, false}
+};
+
+/* Whether the edge between given kinds has a twin half-edge in the opposite
+   direction, in which case only one of them needs to be considered */
+constexpr bool HasOpposite[4][4]{
+    {true, true, true, false},
+    {true, false, true, false},
+    {true, true, true, false},
+    {false, false, false, false}
+};
+
+/* Symmetric 4x4 quadric matrix stored as the upper 3x3 part, the vector and
+   the constant, plus total weight for normalizing the error */
+struct Quadric {
+    Float a00, a11, a22, a10, a20, a21;
+    Float b0, b1, b2;
+    Float c;
+    Float w;
+};
+
+Quadric planeQuadric(const Vector3& normal, const Float distance, const Float weight) {
+    return {
+        weight*normal.x()*normal.x(),
+        weight*normal.y()*normal.y(),
+        weight*normal.z()*normal.z(),
+        weight*normal.y()*normal.x(),
+        weight*normal.z()*normal.x(),
+        weight*normal.z()*normal.y(),
+        weight*normal.x()*distance,
+        weight*normal.y()*distance,
+        weight*normal.z()*distance,
+        weight*distance*distance,
+        weight
+    };
+}
+
+void addQuadric(Quadric& a, const Quadric& b) {
+    a.a00 += b.a00;
+    a.a11 += b.a11;
+    a.a22 += b.a22;
+    a.a10 += b.a10;
+    a.a20 += b.a20;
+    a.a21 += b.a21;
+    a.b0 += b.b0;
+    a.b1 += b.b1;
+    a.b2 += b.b2;
+    a.c += b.c;
+    a.w += b.w;
+}
+
+/* Squared distance of the point to the planes accumulated in the quadric,
+   averaged by the weight */
+Float quadricError(const Quadric& q, const Vector3& v) {
+    const Float r = q.c + 2.0f*(q.b0*v.x() + q.b1*v.y() + q.b2*v.z()) +
+        q.a00*v.x()*v.x() + q.a11*v.y()*v.y() + q.a22*v.z()*v.z() +
+        2.0f*(q.a10*v.x()*v.y() + q.a20*v.x()*v.z() + q.a21*v.y()*v.z());
+    return q.w == 0.0f ? 0.0f : Math::abs(r)/q.w;
+}
+
+/* Whether there's a half-edge from a to b, looking at triangles of a */
+template<class T> bool hasEdge(const Containers::StridedArrayView1D<const T>& indices, const Containers::ArrayView<const UnsignedInt> neighborOffset, const Containers::ArrayView<const UnsignedInt> neighbors, const UnsignedInt a, const UnsignedInt b) {
+    for(UnsignedInt i = neighborOffset[a]; i != neighborOffset[a + 1]; ++i) {
+        const UnsignedInt triangle = neighbors[i];
+        for(std::size_t j = 0; j != 3; ++j)
+            if(indices[triangle*3 + j] == a && indices[triangle*3 + (j + 1) % 3] == b)
+                return true;
+    }
+    return false;
+}
+
+struct Collapse {
+    UnsignedInt from, to;
+    bool bidirectional;
+    Float error;
+};
+
+template<class T> std::pair<std::size_t, Float> simplifyInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::simplifyInPlace(): index count" << indices.size() << "not divisible by 3", {});
+
+    const UnsignedInt vertexCount = positions.size();
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::simplifyInPlace(): index" << index << "out of bounds for" << vertexCount << "vertices", {});
+    #endif
+
+    std::size_t indexCount = indices.size();
+    if(indexCount <= targetIndexCount) return {indexCount, 0.0f};
+
+    /* Normalize positions to a unit cube so the error is independent of the
+       mesh scale */
+    const std::pair<Vector3, Vector3> bounds = Math::minmax(positions);
+    const Float extent = (bounds.second - bounds.first).max();
+    const Float scale = extent > 0.0f ? 1.0f/extent : 1.0f;
+    Containers::Array<Vector3> scaled{Containers::NoInit, vertexCount};
+    for(UnsignedInt i = 0; i != vertexCount; ++i)
+        scaled[i] = (positions[i] - bounds.first)*scale;
+
+    /* Vertices with the same position, remapped to the first occurence of
+       given position. The wedge is a circular list of all vertices sharing
+       the same position. */
+    Containers::Array<UnsignedInt> remap{Containers::NoInit, vertexCount};
+    Containers::Array<UnsignedInt> wedge{Containers::NoInit, vertexCount};
+    {
+        Containers::Array<UnsignedInt> uniqueIndices{Containers::NoInit, vertexCount};
+        const std::size_t uniqueCount = removeDuplicatesInto(Containers::arrayCast<2, const char>(positions), uniqueIndices);
+        Containers::Array<UnsignedInt> firstOccurence{Containers::DirectInit, uniqueCount, ~UnsignedInt{}};
+        for(UnsignedInt i = 0; i != vertexCount; ++i) {
+            UnsignedInt& first = firstOccurence[uniqueIndices[i]];
+            if(first == ~UnsignedInt{}) first = i;
+            remap[i] = first;
+            wedge[i] = i;
+            if(first != i) {
+                wedge[i] = wedge[first];
+                wedge[first] = i;
+            }
+        }
+    }
+
+    /* For each vertex find its open (boundary) outgoing and incoming edges.
+       If there's more than one, the vertex itself is stored as a marker. */
+    Containers::Array<UnsignedInt> liveTriangleCount, neighborOffset, neighbors;
+    Implementation::buildAdjacency<T>(indices, vertexCount, liveTriangleCount, neighborOffset, neighbors);
+    Containers::Array<UnsignedInt> loop{Containers::DirectInit, vertexCount, ~UnsignedInt{}};
+    Containers::Array<UnsignedInt> loopback{Containers::DirectInit, vertexCount, ~UnsignedInt{}};
+    for(std::size_t i = 0; i != indexCount; ++i) {
+        const UnsignedInt a = indices[i];
+        const UnsignedInt b = indices[i - i % 3 + (i + 1) % 3];
+        if(hasEdge<T>(indices, neighborOffset, neighbors, b, a)) continue;
+
+        loop[a] = loop[a] == ~UnsignedInt{} ? b : a;
+        loopback[b] = loopback[b] == ~UnsignedInt{} ? a : b;
+    }
+
+    /* Classify the vertices */
+    Containers::Array<VertexKind> kind{Containers::NoInit, vertexCount};
+    auto isSingleEdge = [](const UnsignedInt vertex, const UnsignedInt edge) {
+        return edge != ~UnsignedInt{} && edge != vertex;
+    };
+    for(UnsignedInt i = 0; i != vertexCount; ++i) {
+        if(remap[i] != i) continue;
+
+        /* A vertex without an attribute seam */
+        if(wedge[i] == i) {
+            if(loop[i] == ~UnsignedInt{} && loopback[i] == ~UnsignedInt{})
+                kind[i] = VertexKind::Manifold;
+            else if(isSingleEdge(i, loop[i]) && isSingleEdge(i, loopback[i]))
+                kind[i] = flags & SimplifyFlag::LockBorder ?
+                    VertexKind::Locked : VertexKind::Border;
+            else kind[i] = VertexKind::Locked;
+
+        /* A vertex on a seam between exactly two attribute sets, with the
+           open edges on both sides going to the same positions */
+        } else if(wedge[wedge[i]] == i) {
+            const UnsignedInt w = wedge[i];
+            if(isSingleEdge(i, loop[i]) && isSingleEdge(i, loopback[i]) &&
+               isSingleEdge(w, loop[w]) && isSingleEdge(w, loopback[w]) &&
+               remap[loopback[i]] == remap[loop[w]] &&
+               remap[loop[i]] == remap[loopback[w]])
+                kind[i] = VertexKind::Seam;
+            else kind[i] = VertexKind::Locked;
+
+        /* Anything more complex */
+        } else kind[i] = VertexKind::Locked;
+    }
+    for(UnsignedInt i = 0; i != vertexCount; ++i)
+        kind[i] = kind[remap[i]];
+
+    /* Accumulate the quadrics for unique positions from triangle planes
+       weighted by triangle area, plus planes perpendicular to border and seam
+       edges to keep them in place */
+    Containers::Array<Quadric> quadrics{Containers::ValueInit, vertexCount};
+    for(std::size_t i = 0; i != indexCount; i += 3) {
+        const Vector3& a = scaled[indices[i + 0]];
+        const Vector3& b = scaled[indices[i + 1]];
+        const Vector3& c = scaled[indices[i + 2]];
+        Vector3 normal = Math::cross(b - a, c - a);
+        const Float area = normal.length();
+        if(area > 0.0f) normal /= area;
+        const Quadric quadric = planeQuadric(normal, -Math::dot(normal, a), area);
+        for(std::size_t j = 0; j != 3; ++j)
+            addQuadric(quadrics[remap[indices[i + j]]], quadric);
+
+        for(std::size_t j = 0; j != 3; ++j) {
+            const UnsignedInt from = indices[i + j];
+            const UnsignedInt to = indices[i + (j + 1) % 3];
+            if((kind[from] != VertexKind::Border && kind[from] != VertexKind::Seam) || loop[from] != to)
+                continue;
+
+            const Vector3 edge = scaled[to] - scaled[from];
+            const Vector3 other = scaled[indices[i + (j + 2) % 3]] - scaled[from];
+            const Float edgeLengthSquared = edge.dot();
+            Vector3 perpendicular = other - edge*(edgeLengthSquared > 0.0f ? Math::dot(edge, other)/edgeLengthSquared : 0.0f);
+            const Float perpendicularLength = perpendicular.length();
+            if(perpendicularLength > 0.0f) perpendicular /= perpendicularLength;
+            /* Borders are weighted more as there's nothing else holding
+               them in place */
+            const Quadric edgeQuadric = planeQuadric(perpendicular,
+                -Math::dot(perpendicular, scaled[from]),
+                Math::sqrt(edgeLengthSquared)*(kind[from] == VertexKind::Border ? 10.0f : 1.0f));
+            addQuadric(quadrics[remap[from]], edgeQuadric);
+            addQuadric(quadrics[remap[to]], edgeQuadric);
+        }
+    }
+
+    Containers::Array<UnsignedInt> collapseRemap{Containers::NoInit, vertexCount};
+    Containers::Array<bool> collapseLocked{Containers::NoInit, vertexCount};
+    Containers::Array<Collapse> collapses;
+    Containers::Array<UnsignedInt> collapseOrder;
+    const Float errorLimit = targetError*targetError;
+    Float resultError = 0.0f;
+    while(indexCount > targetIndexCount) {
+        const Containers::StridedArrayView1D<T> current = indices.prefix(indexCount);
+        Implementation::buildAdjacency<T>(current, vertexCount, liveTriangleCount, neighborOffset, neighbors);
+
+        /* Gather all edges that can be collapsed */
+        arrayResize(collapses, 0);
+        for(std::size_t i = 0; i != indexCount; ++i) {
+            const UnsignedInt a = current[i];
+            const UnsignedInt b = current[i - i % 3 + (i + 1) % 3];
+            if(remap[a] == remap[b]) continue;
+
+            const UnsignedInt kindA = UnsignedInt(kind[a]);
+            const UnsignedInt kindB = UnsignedInt(kind[b]);
+            if(!CanCollapse[kindA][kindB] && !CanCollapse[kindB][kindA])
+                continue;
+
+            /* Border and seam vertices can be collapsed only along the
+               border or seam */
+            if(kindA == kindB && (kind[a] == VertexKind::Border || kind[a] == VertexKind::Seam) && loop[a] != b)
+                continue;
+
+            /* Consider each edge just once if there's a twin */
+            if(HasOpposite[kindA][kindB] && remap[b] > remap[a]) continue;
+
+            if(kindA == kindB)
+                arrayAppend(collapses, Collapse{a, b, true, 0.0f});
+            else if(CanCollapse[kindA][kindB])
+                arrayAppend(collapses, Collapse{a, b, false, 0.0f});
+            else
+                arrayAppend(collapses, Collapse{b, a, false, 0.0f});
+        }
+        if(collapses.empty()) break;
+
+        /* Calculate error for each collapse, pick the cheaper direction if
+           the collapse can go both ways */
+        for(Collapse& collapse: collapses) {
+            collapse.error = quadricError(quadrics[remap[collapse.from]], scaled[collapse.to]);
+            if(collapse.bidirectional) {
+                const Float reverseError = quadricError(quadrics[remap[collapse.to]], scaled[collapse.from]);
+                if(reverseError < collapse.error) {
+                    std::swap(collapse.from, collapse.to);
+                    collapse.error = reverseError;
+                }
+            }
+        }
+
+        arrayResize(collapseOrder, Containers::NoInit, collapses.size());
+        for(std::size_t i = 0; i != collapses.size(); ++i)
+            collapseOrder[i] = i;
+        std::stable_sort(collapseOrder.begin(), collapseOrder.end(), [&collapses](UnsignedInt a, UnsignedInt b) {
+            return collapses[a].error < collapses[b].error;
+        });
+
+        /* Perform the cheapest collapses, each position can be touched just
+           once per pass. Each collapse removes two triangles, or one on a
+           border. */
+        for(UnsignedInt i = 0; i != vertexCount; ++i) collapseRemap[i] = i;
+        for(bool& i: collapseLocked) i = false;
+        const std::size_t triangleCollapseGoal = (indexCount - targetIndexCount)/3;
+        std::size_t triangleCollapseCount = 0;
+        std::size_t collapseCount = 0;
+        for(const UnsignedInt collapseId: collapseOrder) {
+            const Collapse& collapse = collapses[collapseId];
+            if(collapse.error > errorLimit || triangleCollapseCount >= triangleCollapseGoal)
+                break;
+
+            const UnsignedInt from = collapse.from;
+            const UnsignedInt to = collapse.to;
+            if(collapseLocked[remap[from]] || collapseLocked[remap[to]])
+                continue;
+
+            /* For a seam the vertex on the other side has to be collapsed
+               along the seam as well */
+            UnsignedInt seamFrom = ~UnsignedInt{}, seamTo = ~UnsignedInt{};
+            if(kind[from] == VertexKind::Seam) {
+                seamFrom = wedge[from];
+                seamTo = loop[from] == to ? loopback[seamFrom] : loop[seamFrom];
+                if(seamTo == ~UnsignedInt{} || remap[seamTo] != remap[to])
+                    continue;
+            }
+
+            /* Reject the collapse if it would flip any of the remaining
+               triangles around the collapsed vertices, triangles that
+               contain the target vertex will disappear */
+            bool flipped = false;
+            for(std::size_t side = 0; side != 2 && !flipped; ++side) {
+                const UnsignedInt vertex = side ? seamFrom : from;
+                const UnsignedInt target = side ? seamTo : to;
+                if(vertex == ~UnsignedInt{}) break;
+
+                for(UnsignedInt j = neighborOffset[vertex]; j != neighborOffset[vertex + 1] && !flipped; ++j) {
+                    const UnsignedInt triangle = neighbors[j];
+                    UnsignedInt v[3];
+                    for(std::size_t k = 0; k != 3; ++k)
+                        v[k] = collapseRemap[current[triangle*3 + k]];
+                    if(remap[v[0]] == remap[to] || remap[v[1]] == remap[to] || remap[v[2]] == remap[to])
+                        continue;
+
+                    const Vector3 before = Math::cross(scaled[v[1]] - scaled[v[0]], scaled[v[2]] - scaled[v[0]]);
+                    Vector3 p[3];
+                    for(std::size_t k = 0; k != 3; ++k)
+                        p[k] = scaled[v[k] == vertex ? target : v[k]];
+                    const Vector3 after = Math::cross(p[1] - p[0], p[2] - p[0]);
+                    /* Also reject collapses that rotate the triangle too
+                       much, not just flip it */
+                    if(Math::dot(before, after) <= 0.25f*before.length()*after.length())
+                        flipped = true;
+                }
+            }
+            if(flipped) continue;
+
+            collapseRemap[from] = to;
+            if(seamFrom != ~UnsignedInt{}) collapseRemap[seamFrom] = seamTo;
+            addQuadric(quadrics[remap[to]], quadrics[remap[from]]);
+            collapseLocked[remap[from]] = true;
+            collapseLocked[remap[to]] = true;
+            triangleCollapseCount += kind[from] == VertexKind::Border ? 1 : 2;
+            ++collapseCount;
+            resultError = Math::max(resultError, collapse.error);
+        }
+        if(!collapseCount) break;
+
+        /* Update the border and seam loops to skip the collapsed vertices. If
+           a seam edge got collapsed in the direction opposite to the loop,
+           the vertex now continues where the collapsed vertex did. */
+        for(UnsignedInt i = 0; i != vertexCount; ++i) {
+            if(loop[i] != ~UnsignedInt{}) {
+                const UnsignedInt collapsed = collapseRemap[loop[i]];
+                loop[i] = collapsed == i ? loop[loop[i]] : collapsed;
+            }
+            if(loopback[i] != ~UnsignedInt{}) {
+                const UnsignedInt collapsed = collapseRemap[loopback[i]];
+                loopback[i] = collapsed == i ? loopback[loopback[i]] : collapsed;
+            }
+        }
+
+        /* Apply the collapses and remove triangles that became degenerate */
+        std::size_t output = 0;
+        for(std::size_t i = 0; i != indexCount; i += 3) {
+            const UnsignedInt a = collapseRemap[current[i + 0]];
+            const UnsignedInt b = collapseRemap[current[i + 1]];
+            const UnsignedInt c = collapseRemap[current[i + 2]];
+            if(a == b || a == c || b == c) continue;
+
+            indices[output++] = T(a);
+            indices[output++] = T(b);
+            indices[output++] = T(c);
+        }
+        indexCount = output;
+    }
+
+    return {indexCount, Math::sqrt(resultError)};
+}
+
+}
+
+std::pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    return simplifyInPlaceImplementation(indices, positions, targetIndexCount, targetError, flags);
+}
+
+std::pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    return simplifyInPlaceImplementation(indices, positions, targetIndexCount, targetError, flags);
+}
+
+std::pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    return simplifyInPlaceImplementation(indices, positions, targetIndexCount, targetError, flags);
+}
+
+std::pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::simplifyInPlace(): second index view dimension is not contiguous", {});
+    if(indices.size()[1] == 4)
+        return simplifyInPlace(Containers::arrayCast<1, UnsignedInt>(indices), positions, targetIndexCount, targetError, flags);
+    else if(indices.size()[1] == 2)
+        return simplifyInPlace(Containers::arrayCast<1, UnsignedShort>(indices), positions, targetIndexCount, targetError, flags);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::simplifyInPlace(): expected index type size 1, 2 or 4 but got" << indices.size()[1], {});
+        return simplifyInPlace(Containers::arrayCast<1, UnsignedByte>(indices), positions, targetIndexCount, targetError, flags);
+    }
+}
+
+Trade::MeshData simplify(const Trade::MeshData& mesh, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    return simplify(reference(mesh), targetIndexCount, targetError, flags);
+}
+
+Trade::MeshData simplify(Trade::MeshData&& mesh, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    CORRADE_ASSERT(mesh.isIndexed(),
+        "MeshTools::simplify(): the mesh is not indexed",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::simplify(): expected a" << MeshPrimitive::Triangles << "mesh but got" << mesh.primitive(),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::simplify(): the mesh has no positions",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    /* Turn the passed data into an interleaved owned mutable instance we can
+       operate on. There's a chance the original data are already like this,
+       in which case this will be just a passthrough. */
+    Trade::MeshData out = owned(interleave(std::move(mesh)));
+
+    /* Simplify and move the vertices that are still referenced to the
+       front */
+    const std::size_t indexCount = simplifyInPlace(out.mutableIndices(), out.positions3DAsArray(), targetIndexCount, targetError, flags).first;
+    const UnsignedInt vertexCount = optimizeVertexFetchInPlace(out.mutableIndices().prefix(indexCount), interleavedMutableData(out));
+
+    /* Make a new mesh with just the prefix of the original data. The
+       attribute views point to the original data so they can be used
+       directly. */
+    const Trade::MeshIndexData indices{out.indices().prefix(indexCount)};
+    Containers::Array<Trade::MeshAttributeData> attributes{out.attributeCount()};
+    for(UnsignedInt i = 0; i != out.attributeCount(); ++i)
+        attributes[i] = Trade::MeshAttributeData{out.attributeName(i),
+            out.attributeFormat(i), out.attribute(i).prefix(vertexCount),
+            out.attributeArraySize(i)};
+    return Trade::MeshData{out.primitive(),
+        out.releaseIndexData(), indices,
+        out.releaseVertexData(), std::move(attributes), vertexCount};
+}
+
+Containers::Array<Trade::MeshData> simplifyLodChain(const Trade::MeshData& mesh, const Containers::ArrayView<const UnsignedInt> targetIndexCounts, const Float targetError, const SimplifyFlags flags) {
+    CORRADE_ASSERT(mesh.isIndexed(),
+        "MeshTools::simplifyLodChain(): the mesh is not indexed", {});
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::simplifyLodChain(): expected a" << MeshPrimitive::Triangles << "mesh but got" << mesh.primitive(), {});
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::simplifyLodChain(): the mesh has no positions", {});
+
+    Containers::Array<Trade::MeshData> out;
+    arrayReserve(out, targetIndexCounts.size() + 1);
+    arrayAppend(out, owned(mesh));
+
+    /* Simplify a copy of the indices progressively, the positions stay the
+       same for all levels */
+    const Trade::MeshData& base = out.front();
+    const Containers::Array<Vector3> positions = base.positions3DAsArray();
+    const MeshIndexType indexType = base.indexType();
+    const UnsignedInt indexTypeSize = meshIndexTypeSize(indexType);
+    Containers::Array<char> indices{Containers::NoInit, base.indexCount()*indexTypeSize};
+    const Containers::StridedArrayView2D<char> indicesView{indices, {base.indexCount(), indexTypeSize}};
+    Utility::copy(base.indices(), indicesView);
+    std::size_t indexCount = base.indexCount();
+    for(const UnsignedInt targetIndexCount: targetIndexCounts) {
+        indexCount = simplifyInPlace(indicesView.prefix(indexCount), positions, targetIndexCount, targetError, flags).first;
+
+        Containers::Array<char> indexData{Containers::NoInit, indexCount*indexTypeSize};
+        Utility::copy(indices.prefix(indexCount*indexTypeSize), indexData);
+        const Trade::MeshIndexData lodIndices{indexType, indexData};
+
+        /* Reference the vertex data and attributes of the first level */
+        const Trade::MeshData& first = out.front();
+        Containers::Array<Trade::MeshAttributeData> attributes{first.attributeCount()};
+        Utility::copy(first.attributeData(), attributes);
+        arrayAppend(out, Trade::MeshData{first.primitive(),
+            std::move(indexData), lodIndices,
+            {}, first.vertexData(), std::move(attributes),
+            first.vertexCount()});
+    }
+
+    return out;
+}
+
+Containers::Array<Trade::MeshData> simplifyLodChain(const Trade::MeshData& mesh, const std::initializer_list<UnsignedInt> targetIndexCounts, const Float targetError, const SimplifyFlags flags) {
+    return simplifyLodChain(mesh, Containers::arrayView(targetIndexCounts), targetError, flags);
+}
+
+}}
@@ -0,0 +1,192 @@
+#ifndef Magnum_MeshTools_Simplify_h
+#define Magnum_MeshTools_Simplify_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Enum @ref Magnum::MeshTools::SimplifyFlag, enum set @ref Magnum::MeshTools::SimplifyFlags, function @ref Magnum::MeshTools::simplifyInPlace(), @ref Magnum::MeshTools::simplify(), @ref Magnum::MeshTools::simplifyLodChain()
+ * @m_since_latest
+ */
+
+#include <initializer_list>
+#include <utility>
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Mesh simplification flag
+@m_since_latest
+
+@see @ref SimplifyFlags, @ref simplifyInPlace()
+*/
+enum class SimplifyFlag: UnsignedByte {
+    /**
+     * Don't collapse any vertices on the mesh border. Useful for example for
+     * terrain chunks or other meshes that have to stay connected to their
+     * neighbors. Attribute seams in the mesh interior are preserved
+     * regardless of this flag.
+     */
+    LockBorder = 1 << 0
+};
+
+/**
+@brief Mesh simplification flags
+@m_since_latest
+
+@see @ref simplifyInPlace()
+*/
+typedef Containers::EnumSet<SimplifyFlag> SimplifyFlags;
+
+CORRADE_ENUMSET_OPERATORS(SimplifyFlags)
+
+/**
+@brief Simplify a triangle mesh in-place
+@param[in,out] indices  Triangle index array to operate on
+@param[in] positions    Vertex positions
+@param[in] targetIndexCount Index count to stop at
+@param[in] targetError  Error to stop at, relative to mesh size
+@param[in] flags        Flags
+@return New index count and the resulting error, relative to mesh size
+@m_since_latest
+
+Reduces the triangle count using iterative edge collapses ordered by a
+quadric error metric. Algorithm based on *Michael Garland and Paul S. Heckbert
+--- Surface Simplification Using Quadric Error Metrics, SIGGRAPH 1997*, with
+the vertex classification and seam handling modelled after
+[meshoptimizer](https://github.com/zeux/meshoptimizer).
+
+Vertices are only collapsed onto other existing vertices, which means the
+vertex data don't need to be modified at all and the result can share the
+vertex buffer with the original mesh. The first returned value is the new
+index count, the simplified triangles are written to its prefix and the rest
+of @p indices is left in an unspecified state. The simplification stops once
+the index count gets to or below @p targetIndexCount or when the next collapse
+would introduce an error larger than @p targetError, whichever happens first.
+The error is a distance relative to the largest extent of the mesh bounding
+box --- pass @cpp 1.0f @ce to simplify purely by the index count or
+@cpp 0 @ce as @p targetIndexCount to simplify purely by the error.
+
+Vertices sharing the same position but having different indices are treated
+as attribute seams, such as texture coordinate or normal discontinuities. The
+algorithm only collapses them along the seam and together with their
+counterparts on the other side of it, so the seams stay intact. Border
+vertices get collapsed only along the border, use @ref SimplifyFlag::LockBorder
+to keep them in place. Vertices with a more complex topology are never
+collapsed. Expects that the index count is divisible by @cpp 3 @ce and all
+indices are less than @p positions size.
+@see @ref optimizeVertexCacheInPlace(), @ref subdivide()
+*/
+MAGNUM_MESHTOOLS_EXPORT std::pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, std::size_t targetIndexCount, Float targetError, SimplifyFlags flags = {});
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT std::pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, std::size_t targetIndexCount, Float targetError, SimplifyFlags flags = {});
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT std::pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, std::size_t targetIndexCount, Float targetError, SimplifyFlags flags = {});
+
+/**
+@brief Simplify a type-erased triangle mesh in-place
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref simplifyInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, std::size_t, Float, SimplifyFlags)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, std::size_t targetIndexCount, Float targetError, SimplifyFlags flags = {});
+
+/**
+@brief Simplify a mesh
+@param mesh             Input mesh
+@param targetIndexCount Index count to stop at
+@param targetError      Error to stop at, relative to mesh size
+@param flags            Flags
+@m_since_latest
+
+Expects that the mesh is indexed, is @ref MeshPrimitive::Triangles and has a
+@ref Trade::MeshAttribute::Position attribute. The mesh is simplified using
+@ref simplifyInPlace() and vertices that are no longer referenced are then
+removed using @ref optimizeVertexFetchInPlace(). The vertex data are
+interleaved in the result, index type is preserved.
+
+This function unconditionally makes a copy of all data, use
+@ref simplify(Trade::MeshData&&, std::size_t, Float, SimplifyFlags) to avoid
+that. Use @ref simplifyLodChain() to generate multiple levels of detail sharing
+a single vertex buffer instead.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData simplify(const Trade::MeshData& mesh, std::size_t targetIndexCount, Float targetError, SimplifyFlags flags = {});
+
+/**
+@brief Simplify a mesh
+@m_since_latest
+
+Compared to @ref simplify(const Trade::MeshData&, std::size_t, Float, SimplifyFlags)
+this function can operate directly on the index and vertex data if they're
+owned and the vertex data are interleaved, avoiding a copy.
+@see @ref Trade::MeshData::indexDataFlags(),
+    @ref Trade::MeshData::vertexDataFlags()
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData simplify(Trade::MeshData&& mesh, std::size_t targetIndexCount, Float targetError, SimplifyFlags flags = {});
+
+/**
+@brief Create a chain of progressively simplified meshes sharing a vertex buffer
+@param mesh             Input mesh
+@param targetIndexCounts Index counts to stop at for each level of detail
+@param targetError      Error to stop at for each level, relative to mesh size
+@param flags            Flags
+@m_since_latest
+
+Expects that the mesh is indexed, is @ref MeshPrimitive::Triangles and has a
+@ref Trade::MeshAttribute::Position attribute. Returns an array of
+@cpp targetIndexCounts.size() + 1 @ce meshes, where the first is a copy of
+@p mesh and each subsequent one is created by calling @ref simplifyInPlace()
+on indices of the previous level with the corresponding target index count.
+Only the first mesh owns its vertex data, the remaining levels reference them
+in order to share a single vertex buffer, which means the first mesh has to
+be kept alive for as long as the other levels are used. Each level owns its
+index data, the index type is preserved.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Trade::MeshData> simplifyLodChain(const Trade::MeshData& mesh, Containers::ArrayView<const UnsignedInt> targetIndexCounts, Float targetError, SimplifyFlags flags = {});
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Trade::MeshData> simplifyLodChain(const Trade::MeshData& mesh, std::initializer_list<UnsignedInt> targetIndexCounts, Float targetError, SimplifyFlags flags = {});
+
+}}
+
+#endif
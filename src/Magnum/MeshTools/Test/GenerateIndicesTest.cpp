@@ -66,6 +66,7 @@ struct GenerateIndicesTest: TestSuite::Tester {
 
     void generateIndicesMeshData();
     void generateIndicesMeshDataMove();
+    void generateIndicesMeshDataExternallyOwned();
     void generateIndicesMeshDataIndexed();
     void generateIndicesMeshDataInvalidPrimitive();
 };
@@ -195,6 +196,7 @@ GenerateIndicesTest::GenerateIndicesTest() {
         Containers::arraySize(MeshDataData));
 
     addTests({&GenerateIndicesTest::generateIndicesMeshDataMove,
+              &GenerateIndicesTest::generateIndicesMeshDataExternallyOwned,
               &GenerateIndicesTest::generateIndicesMeshDataIndexed,
               &GenerateIndicesTest::generateIndicesMeshDataInvalidPrimitive});
 }
@@ -715,6 +717,45 @@ void GenerateIndicesTest::generateIndicesMeshDataMove() {
     CORRADE_COMPARE(out.vertexData().data(), static_cast<void*>(vertices.data()));
 }
 
+void GenerateIndicesTest::generateIndicesMeshDataExternallyOwned() {
+    /* Such as a memory-mapped file imported with ImporterFlag::ZeroCopy */
+    Vector2 positions[]{
+        {1.5f, 0.3f}, {2.5f, 1.3f}, {3.5f, 2.3f}, {4.5f, 3.3f}
+    };
+    const Trade::MeshData data{MeshPrimitive::TriangleStrip,
+        Trade::DataFlag::ExternallyOwned|Trade::DataFlag::Mutable, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }};
+
+    /* Neither of the overloads should copy the vertex data */
+    Trade::MeshData out = generateIndices(data);
+    Trade::MeshData outMove = generateIndices(Trade::MeshData{MeshPrimitive::TriangleStrip,
+        Trade::DataFlag::ExternallyOwned|Trade::DataFlag::Mutable, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }});
+    CORRADE_COMPARE_AS(out.indices<UnsignedInt>(),
+        Containers::arrayView<UnsignedInt>({
+            0, 1, 2,
+            2, 1, 3
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(outMove.indices<UnsignedInt>(),
+        Containers::arrayView<UnsignedInt>({
+            0, 1, 2,
+            2, 1, 3
+        }), TestSuite::Compare::Container);
+
+    /* The const& overload can't give out mutable access to the data */
+    CORRADE_COMPARE(out.vertexDataFlags(), Trade::DataFlag::ExternallyOwned);
+    CORRADE_COMPARE(outMove.vertexDataFlags(), Trade::DataFlag::ExternallyOwned|Trade::DataFlag::Mutable);
+    CORRADE_COMPARE(out.vertexData().data(), static_cast<void*>(positions));
+    CORRADE_COMPARE(outMove.vertexData().data(), static_cast<void*>(positions));
+    CORRADE_COMPARE_AS(outMove.attribute<Vector2>(Trade::MeshAttribute::Position),
+        Containers::arrayView(positions),
+        TestSuite::Compare::Container);
+}
+
 void GenerateIndicesTest::generateIndicesMeshDataIndexed() {
     #ifdef CORRADE_NO_ASSERT
     CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
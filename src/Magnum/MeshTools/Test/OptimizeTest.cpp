@@ -0,0 +1,508 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Optimize.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct OptimizeTest: TestSuite::Tester {
+    explicit OptimizeTest();
+
+    void analyzeVertexCache();
+    void analyzeVertexCacheEmpty();
+    void analyzeVertexCacheErased();
+    void analyzeVertexCacheOutOfBounds();
+
+    template<class T> void optimizeVertexCache();
+    void optimizeVertexCacheGrid();
+    void optimizeVertexCacheEmpty();
+    void optimizeVertexCacheErased();
+    void optimizeVertexCacheNotTriangles();
+    void optimizeVertexCacheOutOfBounds();
+
+    template<class T> void optimizeOverdraw();
+    void optimizeOverdrawKeepsCacheEfficiency();
+
+    template<class T> void optimizeVertexFetch();
+    void optimizeVertexFetchOutOfBounds();
+
+    void optimizeMeshData();
+    void optimizeMeshDataNotIndexed();
+    void optimizeMeshDataNotTriangles();
+    void optimizeMeshDataNoPositions();
+};
+
+/* Same mesh as in TipsifyTest
+
+ 0 ----- 1 ----- 2 ----- 3
+  \ 0  /  \ 7  /  \ 2  /  \
+   \  / 11 \  / 13 \  / 12 \
+    4 ----- 5 ----- 6 ----- 7
+   /  \ 3  /  \ 8  /  \ 5  /
+  / 14 \  / 9  \  / 15 \  /
+ 8 ----- 9 ---- 10 ---- 11          18 ---- 17
+  \ 4  /  \ 1  /  \ 17 /  \           \ 18  /
+   \  / 16 \  / 10 \  / 6  \           \  /
+    12 ---- 13 ---- 14 ---- 15          16
+
+*/
+
+constexpr UnsignedInt Indices[]{
+    4, 1, 0,
+    10, 9, 13,
+    6, 3, 2,
+    9, 5, 4,
+    12, 9, 8,
+    11, 7, 6,
+
+    14, 15, 11,
+    2, 1, 5,
+    10, 6, 5,
+    10, 5, 9,
+    13, 14, 10,
+    1, 4, 5,
+
+    7, 3, 6,
+    6, 2, 5,
+    9, 4, 8,
+    6, 10, 11,
+    13, 9, 12,
+    14, 11, 10,
+
+    16, 17, 18
+};
+
+constexpr std::size_t VertexCount = 19;
+
+/* A regular grid of quads with the triangle order shuffled, which is about
+   the worst case for a vertex cache */
+Containers::Array<UnsignedInt> shuffledGrid(const UnsignedInt size) {
+    Containers::Array<UnsignedInt> triangles{Containers::NoInit, (size - 1)*(size - 1)*2};
+    for(UnsignedInt i = 0; i != triangles.size(); ++i) triangles[i] = i;
+    std::shuffle(triangles.begin(), triangles.end(), std::minstd_rand{});
+
+    Containers::Array<UnsignedInt> indices{Containers::NoInit, triangles.size()*3};
+    for(std::size_t i = 0; i != triangles.size(); ++i) {
+        const UnsignedInt quad = triangles[i]/2;
+        const UnsignedInt a = (quad/(size - 1))*size + quad%(size - 1);
+        const UnsignedInt b = a + 1, c = a + size, d = a + size + 1;
+        if(triangles[i] % 2) {
+            indices[i*3 + 0] = a;
+            indices[i*3 + 1] = b;
+            indices[i*3 + 2] = d;
+        } else {
+            indices[i*3 + 0] = a;
+            indices[i*3 + 1] = d;
+            indices[i*3 + 2] = c;
+        }
+    }
+
+    return indices;
+}
+
+/* Two triangles, both facing +Z, the first one is below the mesh centroid and
+   thus facing inwards, the second is above and facing outwards. The last
+   vertex is unused. */
+constexpr UnsignedInt OverdrawIndices[]{
+    0, 1, 2,
+    3, 4, 5
+};
+
+const Vector3 OverdrawPositions[]{
+    {0.0f, 0.0f, -1.0f},
+    {1.0f, 0.0f, -1.0f},
+    {0.0f, 1.0f, -1.0f},
+    {0.0f, 0.0f, 1.0f},
+    {1.0f, 0.0f, 1.0f},
+    {0.0f, 1.0f, 1.0f},
+    {5.0f, 5.0f, 5.0f}
+};
+
+OptimizeTest::OptimizeTest() {
+    addTests({&OptimizeTest::analyzeVertexCache,
+              &OptimizeTest::analyzeVertexCacheEmpty,
+              &OptimizeTest::analyzeVertexCacheErased,
+              &OptimizeTest::analyzeVertexCacheOutOfBounds,
+
+              &OptimizeTest::optimizeVertexCache<UnsignedByte>,
+              &OptimizeTest::optimizeVertexCache<UnsignedShort>,
+              &OptimizeTest::optimizeVertexCache<UnsignedInt>,
+              &OptimizeTest::optimizeVertexCacheGrid,
+              &OptimizeTest::optimizeVertexCacheEmpty,
+              &OptimizeTest::optimizeVertexCacheErased,
+              &OptimizeTest::optimizeVertexCacheNotTriangles,
+              &OptimizeTest::optimizeVertexCacheOutOfBounds,
+
+              &OptimizeTest::optimizeOverdraw<UnsignedByte>,
+              &OptimizeTest::optimizeOverdraw<UnsignedShort>,
+              &OptimizeTest::optimizeOverdraw<UnsignedInt>,
+              &OptimizeTest::optimizeOverdrawKeepsCacheEfficiency,
+
+              &OptimizeTest::optimizeVertexFetch<UnsignedByte>,
+              &OptimizeTest::optimizeVertexFetch<UnsignedShort>,
+              &OptimizeTest::optimizeVertexFetch<UnsignedInt>,
+              &OptimizeTest::optimizeVertexFetchOutOfBounds,
+
+              &OptimizeTest::optimizeMeshData,
+              &OptimizeTest::optimizeMeshDataNotIndexed,
+              &OptimizeTest::optimizeMeshDataNotTriangles,
+              &OptimizeTest::optimizeMeshDataNoPositions});
+}
+
+void OptimizeTest::analyzeVertexCache() {
+    VertexCacheStatistics stats = MeshTools::analyzeVertexCache(Indices, VertexCount, 3);
+    CORRADE_COMPARE(stats.transformedVertexCount, 53);
+    CORRADE_COMPARE(stats.acmr, 53.0f/19.0f);
+    CORRADE_COMPARE(stats.atvr, 53.0f/19.0f);
+
+    /* With a cache large enough, each vertex is transformed just once */
+    VertexCacheStatistics large = MeshTools::analyzeVertexCache(Indices, VertexCount, 32);
+    CORRADE_COMPARE(large.transformedVertexCount, 19);
+    CORRADE_COMPARE(large.acmr, 1.0f);
+    CORRADE_COMPARE(large.atvr, 1.0f);
+}
+
+void OptimizeTest::analyzeVertexCacheEmpty() {
+    VertexCacheStatistics stats = MeshTools::analyzeVertexCache(Containers::StridedArrayView1D<const UnsignedInt>{}, 0);
+    CORRADE_COMPARE(stats.transformedVertexCount, 0);
+    CORRADE_COMPARE(stats.acmr, 0.0f);
+    CORRADE_COMPARE(stats.atvr, 0.0f);
+}
+
+void OptimizeTest::analyzeVertexCacheErased() {
+    UnsignedShort indices[Containers::arraySize(Indices)];
+    for(std::size_t i = 0; i != Containers::arraySize(Indices); ++i)
+        indices[i] = Indices[i];
+
+    VertexCacheStatistics stats = MeshTools::analyzeVertexCache(Containers::arrayCast<2, const char>(Containers::stridedArrayView(indices)), VertexCount, 3);
+    CORRADE_COMPARE(stats.transformedVertexCount, 53);
+}
+
+void OptimizeTest::analyzeVertexCacheOutOfBounds() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[]{0, 1, 3};
+    UnsignedInt indices4[]{0, 1, 2, 0};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::analyzeVertexCache(indices, 3);
+    MeshTools::analyzeVertexCache(indices4, 3);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::analyzeVertexCache(): index 3 out of bounds for 3 vertices\n"
+        "MeshTools::analyzeVertexCache(): index count 4 not divisible by 3\n");
+}
+
+template<class T> void OptimizeTest::optimizeVertexCache() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[Containers::arraySize(Indices)];
+    for(std::size_t i = 0; i != Containers::arraySize(Indices); ++i)
+        indices[i] = Indices[i];
+    MeshTools::optimizeVertexCacheInPlace(indices, VertexCount);
+
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView<T>({
+        16, 17, 18, /* the best-scoring one, as it has the least neighbors */
+        4, 1, 0, /* first not yet emitted in the original order */
+        1, 4, 5,
+        2, 1, 5,
+        9, 5, 4,
+        9, 4, 8,
+        12, 9, 8,
+        13, 9, 12,
+        10, 9, 13,
+        10, 5, 9,
+        13, 14, 10,
+        6, 2, 5,
+        10, 6, 5,
+        6, 3, 2,
+        7, 3, 6,
+        11, 7, 6,
+        6, 10, 11,
+        14, 11, 10,
+        14, 15, 11
+    }), TestSuite::Compare::Container);
+
+    /* Even though the optimizer models a larger cache, it's better than
+       tipsifyInPlace() for the tiny one as well */
+    VertexCacheStatistics stats = MeshTools::analyzeVertexCache(Containers::stridedArrayView(indices), VertexCount, 3);
+    CORRADE_COMPARE(stats.transformedVertexCount, 36);
+}
+
+void OptimizeTest::optimizeVertexCacheGrid() {
+    Containers::Array<UnsignedInt> indices = shuffledGrid(64);
+
+    VertexCacheStatistics before = MeshTools::analyzeVertexCache(Containers::stridedArrayView(indices), 64*64);
+    CORRADE_COMPARE_AS(before.acmr, 2.0f, TestSuite::Compare::Greater);
+
+    MeshTools::optimizeVertexCacheInPlace(Containers::stridedArrayView(indices), 64*64);
+
+    /* A regular grid has an ideal ACMR of 0.5, a cache of 16 can get to
+       about 0.67 */
+    VertexCacheStatistics after = MeshTools::analyzeVertexCache(Containers::stridedArrayView(indices), 64*64);
+    CORRADE_COMPARE_AS(after.acmr, 0.75f, TestSuite::Compare::Less);
+
+    /* All triangles are still there */
+    Containers::Array<UnsignedInt> original = shuffledGrid(64);
+    CORRADE_COMPARE(indices.size(), original.size());
+    auto sortedTriangles = [](const Containers::ArrayView<UnsignedInt> indices) {
+        /* Normalize the rotation of each triangle so the lowest index is
+           first and then sort the triangles */
+        Containers::Array<std::tuple<UnsignedInt, UnsignedInt, UnsignedInt>> triangles{indices.size()/3};
+        for(std::size_t i = 0; i != triangles.size(); ++i) {
+            UnsignedInt a = indices[i*3], b = indices[i*3 + 1], c = indices[i*3 + 2];
+            while(a > b || a > c) {
+                const UnsignedInt t = a;
+                a = b; b = c; c = t;
+            }
+            triangles[i] = std::make_tuple(a, b, c);
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    };
+    Containers::Array<std::tuple<UnsignedInt, UnsignedInt, UnsignedInt>> a = sortedTriangles(indices);
+    Containers::Array<std::tuple<UnsignedInt, UnsignedInt, UnsignedInt>> b = sortedTriangles(original);
+    CORRADE_VERIFY(std::equal(a.begin(), a.end(), b.begin()));
+}
+
+void OptimizeTest::optimizeVertexCacheEmpty() {
+    /* Shouldn't crash or anything */
+    MeshTools::optimizeVertexCacheInPlace(Containers::StridedArrayView1D<UnsignedInt>{}, 0);
+    CORRADE_VERIFY(true);
+}
+
+void OptimizeTest::optimizeVertexCacheErased() {
+    UnsignedShort indices[Containers::arraySize(Indices)];
+    for(std::size_t i = 0; i != Containers::arraySize(Indices); ++i)
+        indices[i] = Indices[i];
+    MeshTools::optimizeVertexCacheInPlace(Containers::arrayCast<2, char>(Containers::stridedArrayView(indices)), VertexCount);
+
+    CORRADE_COMPARE(MeshTools::analyzeVertexCache(Containers::stridedArrayView(indices), VertexCount, 3).transformedVertexCount, 36);
+}
+
+void OptimizeTest::optimizeVertexCacheNotTriangles() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[]{0, 1, 2, 0};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexCacheInPlace(indices, 3);
+    MeshTools::optimizeOverdrawInPlace(indices, OverdrawPositions);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexCacheInPlace(): index count 4 not divisible by 3\n"
+        "MeshTools::optimizeOverdrawInPlace(): index count 4 not divisible by 3\n");
+}
+
+void OptimizeTest::optimizeVertexCacheOutOfBounds() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[]{0, 1, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexCacheInPlace(indices, 3);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexCacheInPlace(): index 3 out of bounds for 3 vertices\n");
+}
+
+template<class T> void OptimizeTest::optimizeOverdraw() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[Containers::arraySize(OverdrawIndices)];
+    for(std::size_t i = 0; i != Containers::arraySize(OverdrawIndices); ++i)
+        indices[i] = OverdrawIndices[i];
+    MeshTools::optimizeOverdrawInPlace(indices, OverdrawPositions);
+
+    /* The outwards-facing triangle gets drawn first */
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView<T>({
+        3, 4, 5,
+        0, 1, 2
+    }), TestSuite::Compare::Container);
+}
+
+void OptimizeTest::optimizeOverdrawKeepsCacheEfficiency() {
+    Containers::Array<UnsignedInt> indices = shuffledGrid(64);
+    MeshTools::optimizeVertexCacheInPlace(Containers::stridedArrayView(indices), 64*64);
+    const VertexCacheStatistics before = MeshTools::analyzeVertexCache(Containers::stridedArrayView(indices), 64*64);
+
+    /* A flat grid where every cluster has the same key, so the order stays
+       the same thanks to the stable sort */
+    Containers::Array<Vector3> positions{Containers::NoInit, 64*64};
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        positions[i] = {Float(i % 64), Float(i/64), 0.0f};
+
+    MeshTools::optimizeOverdrawInPlace(Containers::stridedArrayView(indices), Containers::stridedArrayView(positions));
+    const VertexCacheStatistics after = MeshTools::analyzeVertexCache(Containers::stridedArrayView(indices), 64*64);
+    CORRADE_COMPARE_AS(after.acmr, before.acmr*1.05f, TestSuite::Compare::LessOrEqual);
+}
+
+template<class T> void OptimizeTest::optimizeVertexFetch() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[]{4, 1, 4, 1, 2, 4};
+    Int data[]{10, 11, 12, 13, 14};
+    std::size_t count = MeshTools::optimizeVertexFetchInPlace(indices,
+        Containers::arrayCast<2, char>(Containers::stridedArrayView(data)));
+
+    /* Vertices are in order of first use, unused ones at the end in the
+       original order */
+    CORRADE_COMPARE(count, 3);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView<T>({0, 1, 0, 1, 2, 0}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(data),
+        Containers::arrayView<Int>({14, 11, 12, 10, 13}),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeTest::optimizeVertexFetchOutOfBounds() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[]{0, 5, 1};
+    Int data[]{10, 11, 12, 13, 14};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexFetchInPlace(indices,
+        Containers::arrayCast<2, char>(Containers::stridedArrayView(data)));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexFetchInPlace(): index 5 out of bounds for 5 vertices\n");
+}
+
+void OptimizeTest::optimizeMeshData() {
+    const UnsignedShort indices[]{0, 1, 2, 3, 4, 5};
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, OverdrawPositions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(OverdrawPositions)}
+        }};
+
+    Trade::MeshData optimized = MeshTools::optimize(mesh);
+    CORRADE_COMPARE(optimized.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(optimized.indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE_AS(optimized.indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({0, 1, 2, 3, 4, 5}),
+        TestSuite::Compare::Container);
+
+    /* The unused vertex is kept at the end */
+    CORRADE_COMPARE(optimized.vertexCount(), 7);
+    CORRADE_COMPARE_AS(optimized.attribute<Vector3>(Trade::MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 1.0f},
+            {0.0f, 1.0f, 1.0f},
+            {0.0f, 0.0f, -1.0f},
+            {1.0f, 0.0f, -1.0f},
+            {0.0f, 1.0f, -1.0f},
+            {5.0f, 5.0f, 5.0f}
+        }), TestSuite::Compare::Container);
+
+    /* The original mesh is untouched */
+    CORRADE_COMPARE_AS(mesh.indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({0, 1, 2, 3, 4, 5}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(mesh.attribute<Vector3>(Trade::MeshAttribute::Position)[0], (Vector3{0.0f, 0.0f, -1.0f}));
+}
+
+void OptimizeTest::optimizeMeshDataNotIndexed() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::analyzeVertexCache(Trade::MeshData{MeshPrimitive::Triangles, 3});
+    MeshTools::optimizeVertexCache(Trade::MeshData{MeshPrimitive::Triangles, 3});
+    MeshTools::optimizeOverdraw(Trade::MeshData{MeshPrimitive::Triangles, 3});
+    MeshTools::optimizeVertexFetch(Trade::MeshData{MeshPrimitive::Triangles, 3});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::analyzeVertexCache(): the mesh is not indexed\n"
+        "MeshTools::optimizeVertexCache(): the mesh is not indexed\n"
+        "MeshTools::optimizeOverdraw(): the mesh is not indexed\n"
+        "MeshTools::optimizeVertexFetch(): the mesh is not indexed\n");
+}
+
+void OptimizeTest::optimizeMeshDataNotTriangles() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const UnsignedShort indices[]{0, 1, 2, 3};
+    const Trade::MeshData mesh{MeshPrimitive::Lines,
+        {}, indices, Trade::MeshIndexData{indices}, 4};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::analyzeVertexCache(mesh);
+    MeshTools::optimizeVertexCache(mesh);
+    MeshTools::optimizeOverdraw(mesh);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::analyzeVertexCache(): expected a MeshPrimitive::Triangles mesh but got MeshPrimitive::Lines\n"
+        "MeshTools::optimizeVertexCache(): expected a MeshPrimitive::Triangles mesh but got MeshPrimitive::Lines\n"
+        "MeshTools::optimizeOverdraw(): expected a MeshPrimitive::Triangles mesh but got MeshPrimitive::Lines\n");
+}
+
+void OptimizeTest::optimizeMeshDataNoPositions() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const UnsignedShort indices[]{0, 1, 2};
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices}, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeOverdraw(mesh);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeOverdraw(): the mesh has no positions\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeTest)
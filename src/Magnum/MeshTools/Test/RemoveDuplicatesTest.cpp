@@ -29,6 +29,7 @@
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/Vector3.h"
@@ -78,11 +79,25 @@ struct RemoveDuplicatesTest: TestSuite::Tester {
     void removeDuplicatesMeshDataFuzzyAttributeless();
     void removeDuplicatesMeshDataFuzzyImplementationSpecific();
 
+    void threaded();
+    void threadedFuzzy();
+
     void soakTest();
     void soakTestFuzzy();
 
     void benchmark();
     void benchmarkFuzzy();
+    void benchmarkThreaded();
+    void benchmarkFuzzyThreaded();
+};
+
+const struct {
+    const char* name;
+    std::size_t threadCount;
+} ThreadedData[] {
+    {"2 threads", 2},
+    {"7 threads", 7},
+    {"all hardware threads", 0}
 };
 
 const struct {
@@ -218,11 +233,17 @@ RemoveDuplicatesTest::RemoveDuplicatesTest() {
               &RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyAttributeless,
               &RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyImplementationSpecific});
 
+    addInstancedTests({&RemoveDuplicatesTest::threaded,
+                       &RemoveDuplicatesTest::threadedFuzzy},
+        Containers::arraySize(ThreadedData));
+
     addRepeatedTests({&RemoveDuplicatesTest::soakTest,
                       &RemoveDuplicatesTest::soakTestFuzzy}, 10);
 
     addBenchmarks({&RemoveDuplicatesTest::benchmark,
-                   &RemoveDuplicatesTest::benchmarkFuzzy}, 10);
+                   &RemoveDuplicatesTest::benchmarkFuzzy,
+                   &RemoveDuplicatesTest::benchmarkThreaded,
+                   &RemoveDuplicatesTest::benchmarkFuzzyThreaded}, 10);
 }
 
 void RemoveDuplicatesTest::removeDuplicates() {
@@ -1059,6 +1080,71 @@ void RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyImplementationSpecific()
         "MeshTools::removeDuplicatesFuzzy(): can't remove duplicates in an implementation-specific format 0x1234\n");
 }
 
+void RemoveDuplicatesTest::threaded() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Enough items for each of the 7 threads to get at least 16k of them. At
+       most three out of each eight are unique, shuffled with a fixed seed so
+       the test is reproducible. */
+    Containers::Array<Vector3i> items{Containers::NoInit, 131072};
+    for(std::size_t i = 0; i != items.size(); ++i)
+        items[i] = {Int(i/8), Int(i%3), -Int(i/8)};
+    std::shuffle(items.begin(), items.end(), std::minstd_rand{17});
+
+    /* The result should be exactly the same as with a single thread */
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> expected = MeshTools::removeDuplicates(Containers::arrayCast<2, const char>(Containers::arrayView(items)));
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> actual = MeshTools::removeDuplicates(Containers::arrayCast<2, const char>(Containers::arrayView(items)), data.threadCount);
+    CORRADE_COMPARE(actual.second, expected.second);
+    CORRADE_COMPARE_AS(actual.first, expected.first,
+        TestSuite::Compare::Container);
+
+    Containers::Array<Vector3i> expectedItems{Containers::NoInit, items.size()};
+    Containers::Array<Vector3i> actualItems{Containers::NoInit, items.size()};
+    Utility::copy(items, expectedItems);
+    Utility::copy(items, actualItems);
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> expectedInPlace = MeshTools::removeDuplicatesInPlace(Containers::arrayCast<2, char>(Containers::arrayView(expectedItems)));
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> actualInPlace = MeshTools::removeDuplicatesInPlace(Containers::arrayCast<2, char>(Containers::arrayView(actualItems)), data.threadCount);
+    CORRADE_COMPARE(actualInPlace.second, expected.second);
+    CORRADE_COMPARE(actualInPlace.second, expectedInPlace.second);
+    CORRADE_COMPARE_AS(actualInPlace.first, expectedInPlace.first,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(actualItems.prefix(actualInPlace.second),
+        expectedItems.prefix(expectedInPlace.second),
+        TestSuite::Compare::Container);
+}
+
+void RemoveDuplicatesTest::threadedFuzzy() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Similar to above, with each item additionally disturbed by a small
+       amount that fits into the epsilon */
+    Containers::Array<Vector3> items{Containers::NoInit, 131072};
+    for(std::size_t i = 0; i != items.size(); ++i)
+        items[i] = Vector3{Float(i/8), Float(i%3), -Float(i/8)} + Vector3{Float(i%5)*0.00001f};
+    std::shuffle(items.begin(), items.end(), std::minstd_rand{17});
+
+    /* Testing with both an epsilon that makes the discretized cells fit into
+       32 bits and one that doesn't */
+    for(const Float epsilon: {0.001f, Math::TypeTraits<Float>::epsilon()}) {
+        CORRADE_ITERATION(epsilon);
+
+        Containers::Array<Vector3> expectedItems{Containers::NoInit, items.size()};
+        Containers::Array<Vector3> actualItems{Containers::NoInit, items.size()};
+        Utility::copy(items, expectedItems);
+        Utility::copy(items, actualItems);
+        std::pair<Containers::Array<UnsignedInt>, std::size_t> expected = MeshTools::removeDuplicatesFuzzyInPlace(Containers::arrayCast<2, Float>(Containers::arrayView(expectedItems)), epsilon);
+        std::pair<Containers::Array<UnsignedInt>, std::size_t> actual = MeshTools::removeDuplicatesFuzzyInPlace(Containers::arrayCast<2, Float>(Containers::arrayView(actualItems)), epsilon, data.threadCount);
+        CORRADE_COMPARE(actual.second, expected.second);
+        CORRADE_COMPARE_AS(actual.first, expected.first,
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(actualItems.prefix(actual.second),
+            expectedItems.prefix(expected.second),
+            TestSuite::Compare::Container);
+    }
+}
+
 void RemoveDuplicatesTest::soakTest() {
     /* Array of 100 unique items with 10 duplicates each, randomly shuffled */
     UnsignedInt data[1000];
@@ -1118,6 +1204,40 @@ void RemoveDuplicatesTest::benchmarkFuzzy() {
     CORRADE_COMPARE(count, 100);
 }
 
+void RemoveDuplicatesTest::benchmarkThreaded() {
+    /* Array of 1000 unique items with 1000 duplicates each, shuffled */
+    Containers::Array<Vector3i> data{Containers::ValueInit, 1000000};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i].x() = i/1000;
+    std::shuffle(data.begin(), data.end(), std::minstd_rand{std::random_device{}()});
+
+    std::size_t count;
+    Containers::Array<UnsignedInt> indices{Containers::NoInit, data.size()};
+    CORRADE_BENCHMARK(1)
+        count = MeshTools::removeDuplicatesInPlaceInto(
+            Containers::arrayCast<2, char>(Containers::arrayView(data)),
+            indices, 0);
+
+    CORRADE_COMPARE(count, 1000);
+}
+
+void RemoveDuplicatesTest::benchmarkFuzzyThreaded() {
+    /* Array of 1000 unique items with 1000 duplicates each, shuffled */
+    Containers::Array<Vector3> data{Containers::ValueInit, 1000000};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i].x() = i/1000;
+    std::shuffle(data.begin(), data.end(), std::minstd_rand{std::random_device{}()});
+
+    std::size_t count;
+    Containers::Array<UnsignedInt> indices{Containers::NoInit, data.size()};
+    CORRADE_BENCHMARK(1)
+        count = MeshTools::removeDuplicatesFuzzyInPlaceInto(
+            Containers::arrayCast<2, Float>(Containers::arrayView(data)),
+            indices, Math::TypeTraits<Float>::epsilon(), 0);
+
+    CORRADE_COMPARE(count, 1000);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::RemoveDuplicatesTest)
@@ -0,0 +1,387 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <set>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Simplify.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct SimplifyTest: TestSuite::Tester {
+    explicit SimplifyTest();
+
+    template<class T> void flat();
+    void flatLockBorder();
+    void targetIndexCount();
+    void targetError();
+    void seam();
+    void erased();
+    void notTriangles();
+    void outOfBounds();
+
+    void meshData();
+    void meshDataNotIndexed();
+    void meshDataNotTriangles();
+    void meshDataNoPositions();
+
+    void lodChain();
+};
+
+/* A size×size grid of vertices on the XY plane, optionally with a bumpy Z */
+void grid(const UnsignedInt size, const bool bumpy, Containers::Array<Vector3>& positions, Containers::Array<UnsignedInt>& indices) {
+    positions = Containers::Array<Vector3>{Containers::NoInit, size*size};
+    for(UnsignedInt y = 0; y != size; ++y) for(UnsignedInt x = 0; x != size; ++x)
+        positions[y*size + x] = {Float(x), Float(y), bumpy ?
+            Math::sin(Rad(x*0.5f))*Math::cos(Rad(y*0.5f))*2.0f : 0.0f};
+
+    indices = Containers::Array<UnsignedInt>{};
+    for(UnsignedInt y = 0; y != size - 1; ++y) for(UnsignedInt x = 0; x != size - 1; ++x) {
+        const UnsignedInt a = y*size + x, b = a + 1, c = a + size, d = c + 1;
+        arrayAppend(indices, {a, b, d, a, d, c});
+    }
+}
+
+SimplifyTest::SimplifyTest() {
+    addTests({&SimplifyTest::flat<UnsignedByte>,
+              &SimplifyTest::flat<UnsignedShort>,
+              &SimplifyTest::flat<UnsignedInt>,
+              &SimplifyTest::flatLockBorder,
+              &SimplifyTest::targetIndexCount,
+              &SimplifyTest::targetError,
+              &SimplifyTest::seam,
+              &SimplifyTest::erased,
+              &SimplifyTest::notTriangles,
+              &SimplifyTest::outOfBounds,
+
+              &SimplifyTest::meshData,
+              &SimplifyTest::meshDataNotIndexed,
+              &SimplifyTest::meshDataNotTriangles,
+              &SimplifyTest::meshDataNoPositions,
+
+              &SimplifyTest::lodChain});
+}
+
+template<class T> void SimplifyTest::flat() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    Containers::Array<Vector3> positions;
+    Containers::Array<UnsignedInt> gridIndices;
+    grid(9, false, positions, gridIndices);
+    Containers::Array<T> indices{Containers::NoInit, gridIndices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices[i] = gridIndices[i];
+
+    /* A flat grid collapses into just two triangles spanning the corners
+       without introducing any error */
+    std::pair<std::size_t, Float> result = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 0, 1.0e-4f);
+    CORRADE_COMPARE(result.first, 6);
+    CORRADE_COMPARE(result.second, 0.0f);
+
+    std::set<UnsignedInt> used{indices.begin(), indices.begin() + result.first};
+    CORRADE_COMPARE(used, (std::set<UnsignedInt>{0, 8, 72, 80}));
+}
+
+void SimplifyTest::flatLockBorder() {
+    Containers::Array<Vector3> positions;
+    Containers::Array<UnsignedInt> indices;
+    grid(9, false, positions, indices);
+
+    std::pair<std::size_t, Float> result = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 0, 1.0e-4f, SimplifyFlag::LockBorder);
+
+    /* All 32 border vertices are kept, triangulating a 32-gon needs 30
+       triangles */
+    CORRADE_COMPARE(result.first, 30*3);
+    std::set<UnsignedInt> used{indices.begin(), indices.begin() + result.first};
+    CORRADE_COMPARE(used.size(), 32);
+    for(UnsignedInt i: used) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(i % 9 == 0 || i % 9 == 8 || i/9 == 0 || i/9 == 8);
+    }
+}
+
+void SimplifyTest::targetIndexCount() {
+    Containers::Array<Vector3> positions;
+    Containers::Array<UnsignedInt> indices;
+    grid(33, true, positions, indices);
+    CORRADE_COMPARE(indices.size(), 2048*3);
+
+    std::pair<std::size_t, Float> result = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 512*3, 1.0f);
+    CORRADE_COMPARE_AS(result.first, 512*3, TestSuite::Compare::LessOrEqual);
+    /* It shouldn't overshoot too much either */
+    CORRADE_COMPARE_AS(result.first, 500*3, TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(result.second, 0.0f, TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(result.second, 0.05f, TestSuite::Compare::Less);
+}
+
+void SimplifyTest::targetError() {
+    Containers::Array<Vector3> positions;
+    Containers::Array<UnsignedInt> indices;
+    grid(33, true, positions, indices);
+
+    /* A smaller error target results in more triangles being kept */
+    Containers::Array<UnsignedInt> indicesCopy{Containers::NoInit, indices.size()};
+    Utility::copy(indices, indicesCopy);
+    std::pair<std::size_t, Float> coarse = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 0, 0.02f);
+    std::pair<std::size_t, Float> fine = MeshTools::simplifyInPlace(Containers::stridedArrayView(indicesCopy), positions, 0, 0.002f);
+    CORRADE_COMPARE_AS(coarse.second, 0.02f, TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(fine.second, 0.002f, TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(fine.first, coarse.first, TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(fine.first, 2048*3, TestSuite::Compare::Less);
+}
+
+void SimplifyTest::seam() {
+    /* A UV sphere where the first and last vertex column share positions but
+       would have different texture coordinates, and all pole vertices share
+       the same position */
+    constexpr UnsignedInt Rings = 16;
+    constexpr UnsignedInt Segments = 32;
+    Containers::Array<Vector3> positions;
+    for(UnsignedInt r = 0; r <= Rings; ++r) for(UnsignedInt s = 0; s <= Segments; ++s) {
+        const Rad theta = Rad{Constants::pi()*r/Rings};
+        const Rad phi = Rad{2.0f*Constants::pi()*(s % Segments)/Segments};
+        const Float sinTheta = r == 0 || r == Rings ? 0.0f : Math::sin(theta);
+        arrayAppend(positions, Vector3{sinTheta*Math::cos(phi), sinTheta*Math::sin(phi), Math::cos(theta)});
+    }
+    Containers::Array<UnsignedInt> indices;
+    for(UnsignedInt r = 0; r != Rings; ++r) for(UnsignedInt s = 0; s != Segments; ++s) {
+        const UnsignedInt a = r*(Segments + 1) + s, b = a + 1, c = a + Segments + 1, d = c + 1;
+        if(r != 0) arrayAppend(indices, {a, c, b});
+        if(r != Rings - 1) arrayAppend(indices, {b, c, d});
+    }
+
+    const std::size_t originalCount = indices.size();
+    std::pair<std::size_t, Float> result = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, originalCount/4, 1.0f);
+    CORRADE_COMPARE_AS(result.first, originalCount/4, TestSuite::Compare::LessOrEqual);
+
+    /* No triangle should span both sides of the seam, i.e. reference both
+       vertices near the first and the last column */
+    for(std::size_t i = 0; i != result.first; i += 3) {
+        UnsignedInt min = Segments, max = 0;
+        for(std::size_t j = 0; j != 3; ++j) {
+            const UnsignedInt r = indices[i + j]/(Segments + 1);
+            const UnsignedInt s = indices[i + j]%(Segments + 1);
+            if(r == 0 || r == Rings) continue;
+            min = Math::min(min, s);
+            max = Math::max(max, s);
+        }
+        CORRADE_ITERATION(i/3);
+        CORRADE_COMPARE_AS(max, min + Segments/2, TestSuite::Compare::LessOrEqual);
+    }
+}
+
+void SimplifyTest::erased() {
+    Containers::Array<Vector3> positions;
+    Containers::Array<UnsignedInt> gridIndices;
+    grid(9, false, positions, gridIndices);
+    Containers::Array<UnsignedShort> indices{Containers::NoInit, gridIndices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices[i] = gridIndices[i];
+
+    std::pair<std::size_t, Float> result = MeshTools::simplifyInPlace(Containers::arrayCast<2, char>(Containers::stridedArrayView(indices)), positions, 0, 1.0e-4f);
+    CORRADE_COMPARE(result.first, 6);
+}
+
+void SimplifyTest::notTriangles() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[]{0, 1, 2, 0};
+    const Vector3 positions[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::simplifyInPlace(indices, positions, 0, 1.0f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplifyInPlace(): index count 4 not divisible by 3\n");
+}
+
+void SimplifyTest::outOfBounds() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[]{0, 1, 3};
+    const Vector3 positions[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::simplifyInPlace(indices, positions, 0, 1.0f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplifyInPlace(): index 3 out of bounds for 3 vertices\n");
+}
+
+void SimplifyTest::meshData() {
+    Containers::Array<Vector3> positions;
+    Containers::Array<UnsignedInt> indices;
+    grid(9, false, positions, indices);
+
+    /* Texture coordinates following the positions, so the simplified
+       mesh can be checked for consistency */
+    struct Vertex {
+        Vector3 position;
+        Vector2 textureCoordinates;
+    };
+    Containers::Array<Vertex> vertices{Containers::NoInit, positions.size()};
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        vertices[i] = {positions[i], positions[i].xy()/8.0f};
+
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, vertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::stridedArrayView(vertices, &vertices[0].position,
+                    vertices.size(), sizeof(Vertex))},
+            Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+                Containers::stridedArrayView(vertices, &vertices[0].textureCoordinates,
+                    vertices.size(), sizeof(Vertex))}
+        }};
+
+    Trade::MeshData simplified = MeshTools::simplify(mesh, 0, 1.0e-4f);
+    CORRADE_COMPARE(simplified.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(simplified.indexType(), MeshIndexType::UnsignedInt);
+    CORRADE_COMPARE(simplified.indexCount(), 6);
+
+    /* Unreferenced vertices got removed */
+    CORRADE_COMPARE(simplified.vertexCount(), 4);
+    CORRADE_COMPARE(simplified.attributeCount(), 2);
+    Containers::Array<Vector3> simplifiedPositions = simplified.positions3DAsArray();
+    Containers::Array<Vector2> simplifiedTextureCoordinates = simplified.textureCoordinates2DAsArray();
+    for(UnsignedInt i = 0; i != 4; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(simplifiedTextureCoordinates[i], simplifiedPositions[i].xy()/8.0f);
+        CORRADE_VERIFY(simplifiedPositions[i].x() == 0.0f || simplifiedPositions[i].x() == 8.0f);
+        CORRADE_VERIFY(simplifiedPositions[i].y() == 0.0f || simplifiedPositions[i].y() == 8.0f);
+    }
+    for(UnsignedInt i: simplified.indices<UnsignedInt>())
+        CORRADE_COMPARE_AS(i, 4, TestSuite::Compare::Less);
+
+    /* The original is untouched */
+    CORRADE_COMPARE(mesh.indexCount(), 128*3);
+}
+
+void SimplifyTest::meshDataNotIndexed() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::simplify(Trade::MeshData{MeshPrimitive::Triangles, 3}, 0, 1.0f);
+    MeshTools::simplifyLodChain(Trade::MeshData{MeshPrimitive::Triangles, 3}, {0}, 1.0f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplify(): the mesh is not indexed\n"
+        "MeshTools::simplifyLodChain(): the mesh is not indexed\n");
+}
+
+void SimplifyTest::meshDataNotTriangles() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const UnsignedShort indices[]{0, 1, 2, 3};
+    const Trade::MeshData mesh{MeshPrimitive::Lines,
+        {}, indices, Trade::MeshIndexData{indices}, 4};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::simplify(mesh, 0, 1.0f);
+    MeshTools::simplifyLodChain(mesh, {0}, 1.0f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplify(): expected a MeshPrimitive::Triangles mesh but got MeshPrimitive::Lines\n"
+        "MeshTools::simplifyLodChain(): expected a MeshPrimitive::Triangles mesh but got MeshPrimitive::Lines\n");
+}
+
+void SimplifyTest::meshDataNoPositions() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const UnsignedShort indices[]{0, 1, 2};
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices}, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::simplify(mesh, 0, 1.0f);
+    MeshTools::simplifyLodChain(mesh, {0}, 1.0f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplify(): the mesh has no positions\n"
+        "MeshTools::simplifyLodChain(): the mesh has no positions\n");
+}
+
+void SimplifyTest::lodChain() {
+    Containers::Array<Vector3> positions;
+    Containers::Array<UnsignedInt> indices;
+    grid(33, true, positions, indices);
+
+    Containers::Array<UnsignedShort> indices16{Containers::NoInit, indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices16[i] = indices[i];
+
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices16, Trade::MeshIndexData{indices16},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }};
+
+    Containers::Array<Trade::MeshData> lods = MeshTools::simplifyLodChain(mesh, {1024*3, 256*3, 64*3}, 1.0f);
+    CORRADE_COMPARE(lods.size(), 4);
+
+    /* The first level is a copy of the original, owning the data */
+    CORRADE_COMPARE(lods[0].indexCount(), 2048*3);
+    CORRADE_COMPARE(lods[0].vertexDataFlags(), Trade::DataFlag::Owned|Trade::DataFlag::Mutable);
+    CORRADE_VERIFY(lods[0].vertexData().data() != static_cast<const void*>(positions.data()));
+
+    const std::size_t expectedMaxIndexCount[]{2048*3, 1024*3, 256*3, 64*3};
+    for(std::size_t i = 1; i != lods.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(lods[i].indexType(), MeshIndexType::UnsignedShort);
+        CORRADE_COMPARE_AS(lods[i].indexCount(), expectedMaxIndexCount[i], TestSuite::Compare::LessOrEqual);
+        CORRADE_COMPARE_AS(lods[i].indexCount(), expectedMaxIndexCount[i]/2, TestSuite::Compare::Greater);
+
+        /* All levels share the vertex buffer of the first */
+        CORRADE_COMPARE(lods[i].vertexDataFlags(), Trade::DataFlags{});
+        CORRADE_COMPARE(lods[i].vertexData().data(), lods[0].vertexData().data());
+        CORRADE_COMPARE(lods[i].vertexCount(), 33*33);
+        CORRADE_COMPARE(lods[i].indexDataFlags(), Trade::DataFlag::Owned|Trade::DataFlag::Mutable);
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SimplifyTest)
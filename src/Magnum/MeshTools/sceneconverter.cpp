@@ -28,6 +28,8 @@
 #include <set>
 #include <sstream>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
@@ -35,10 +37,13 @@
 #include <Corrade/Utility/String.h>
 
 #include "Magnum/PixelFormat.h"
+#include "Magnum/Implementation/converterBatch.h"
 #include "Magnum/Implementation/converterUtilities.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/MeshTools/Optimize.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
+#include "Magnum/MeshTools/Simplify.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/LightData.h"
 #include "Magnum/Trade/MaterialData.h"
@@ -76,17 +81,18 @@ information.
 @code{.sh}
 magnum-sceneconverter [-h|--help] [-I|--importer IMPORTER]
     [-I|--converter CONVERTER]... [--plugin-dir DIR] [--remove-duplicates]
-    [--remove-duplicates-fuzzy EPSILON]
+    [--remove-duplicates-fuzzy EPSILON] [--simplify RATIO]
+    [--simplify-error ERROR] [--optimize]
     [-i|--importer-options key=val,key2=val2,…]
     [-c|--converter-options key=val,key2=val2,…]... [--mesh MESH]
-    [--level LEVEL] [--info] [--bounds] [-v|--verbose] [--profile]
-    [--] input output
+    [--level LEVEL] [--info] [--bounds] [--batch MANIFEST] [-j|--jobs N]
+    [--report FILE] [-v|--verbose] [--profile] [--] input output
 @endcode
 
 Arguments:
 
--   `input` --- input file
--   `output` --- output file, ignored if `--info` is present
+-   `input` --- input file, ignored if `--batch` is present
+-   `output` --- output file, ignored if `--info` or `--batch` is present
 -   `-h`, `--help` --- display this help message and exit
 -   `-I`, `--importer IMPORTER` --- scene importer plugin (default:
     @ref Trade::AnySceneImporter "AnySceneImporter")
@@ -95,10 +101,19 @@ Arguments:
 -   `--only-attributes "i j …"` --- include only attributes of given IDs in the
     output
 -   `--remove-duplicates` --- remove duplicate vertices using
-    @ref MeshTools::removeDuplicates(const Trade::MeshData&) after import
+    @ref MeshTools::removeDuplicates(const Trade::MeshData&, std::size_t)
+    after import
 -   `--remove-duplicates-fuzzy EPSILON` --- remove duplicate vertices using
-    @ref MeshTools::removeDuplicatesFuzzy(const Trade::MeshData&, Float, Double)
+    @ref MeshTools::removeDuplicatesFuzzy(const Trade::MeshData&, Float, Double, std::size_t)
+    after import
+-   `--simplify RATIO` --- simplify the mesh to given ratio of the original
+    index count using @ref MeshTools::simplify(const Trade::MeshData&, std::size_t, Float, MeshTools::SimplifyFlags)
     after import
+-   `--simplify-error ERROR` --- maximal error relative to the mesh size
+    allowed by `--simplify` (default: `0.01`)
+-   `--optimize` --- optimize the mesh for vertex cache, overdraw and vertex
+    fetch using @ref MeshTools::optimize(const Trade::MeshData&, Float) after
+    import
 -   `-i`, `--importer-options key=val,key2=val2,…` --- configuration options to
     pass to the importer
 -   `-c`, `--converter-options key=val,key2=val2,…` --- configuration options
@@ -107,6 +122,13 @@ Arguments:
 -   `--level LEVEL` --- mesh level to import (default: `0`)
 -   `--info` --- print info about the input file and exit
 -   `--bounds` --- show bounds of known attributes in `--info` output
+-   `--batch MANIFEST` --- convert all files listed in a manifest
+-   `-j`, `--jobs N` --- number of files converted in parallel by `--batch`
+    (default: `0`, which means all cores). If Corrade isn't built with
+    @ref CORRADE_BUILD_MULTITHREADED, the files are always converted on a
+    single thread.
+-   `--report FILE` --- write a tab-separated report of all files converted
+    by `--batch`
 -   `-v`, `--verbose` --- verbose output from importer and converter plugins
 -   `--profile` --- measure import and conversion time
 
@@ -130,6 +152,17 @@ doesn't support conversion to a file,
 if no `-C` / `--converter` is specified,
 @ref Trade::AnySceneConverter "AnySceneConverter" is used.
 
+If `--batch` is given, the `input` and `output` arguments are ignored and all
+files listed in the manifest are converted instead, with the same options. The
+manifest contains an input and an output filename separated by a tab on each
+line, empty lines and lines starting with `#` are ignored. The files are
+converted in parallel on `--jobs` threads, each having its own importer and
+converter plugin instances, so the plugins are loaded only once and not for
+every file. Output of each file is printed together once it finishes, followed
+by a line with its conversion time and input and output size; `--report` saves
+the same information into a tab-separated file. On Emscripten the files are
+always converted on a single thread.
+
 @section magnum-sceneconverter-example Example usage
 
 Printing info about all meshes in a glTF file:
@@ -156,6 +189,14 @@ the processing stats:
 magnum-sceneconverter chair.obj --converter MeshOptimizerSceneConverter -c simplify=true,simplifyTargetIndexCountThreshold=0.5 chair.ply -v
 @endcode
 
+Optimizing all OBJ files listed in a manifest and saving them as PLYs, using
+all available cores and saving a report with conversion times and output
+sizes:
+
+@code{.sh}
+magnum-sceneconverter --batch manifest.txt --optimize --report report.tsv
+@endcode
+
 @see @ref magnum-imageconverter
 */
 
@@ -194,30 +235,233 @@ UnsignedInt namedAttributeId(const Trade::MeshData& mesh, UnsignedInt id) {
     CORRADE_INTERNAL_ASSERT_UNREACHABLE();
 }
 
+/* Plugin managers and plugin instances. In the batch mode there's one for
+   each worker thread, so the plugins are loaded just once for all files and
+   the workers don't need to synchronize. */
+struct Worker {
+    explicit Worker(const Utility::Arguments& args):
+        importerManager{args.value("plugin-dir").empty() ? std::string{} :
+            Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractImporter::pluginSearchPaths()[0])},
+        converterManager{args.value("plugin-dir").empty() ? std::string{} :
+            Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractSceneConverter::pluginSearchPaths()[0])},
+        /* One more for the implicit AnySceneConverter at the end */
+        converters{args.arrayValueCount("converter") + 1} {}
+
+    PluginManager::Manager<Trade::AbstractImporter> importerManager;
+    PluginManager::Manager<Trade::AbstractSceneConverter> converterManager;
+    Containers::Pointer<Trade::AbstractImporter> importer;
+    /* Instantiated on first use, as it's not known upfront whether the
+       implicit AnySceneConverter will be needed */
+    Containers::Array<Containers::Pointer<Trade::AbstractSceneConverter>> converters;
+};
+
+bool loadImporter(const Utility::Arguments& args, Worker& worker) {
+    worker.importer = worker.importerManager.loadAndInstantiate(args.value("importer"));
+    if(!worker.importer) {
+        Debug{} << "Available importer plugins:" << Utility::String::join(worker.importerManager.aliasList(), ", ");
+        return false;
+    }
+
+    /* Set options, if passed */
+    if(args.isSet("verbose")) worker.importer->setFlags(Trade::ImporterFlag::Verbose);
+    Implementation::setOptions(*worker.importer, args.value("importer-options"));
+    return true;
+}
+
+bool loadConverter(const Utility::Arguments& args, Worker& worker, const std::size_t i) {
+    /* Already loaded before */
+    if(worker.converters[i]) return true;
+
+    const std::size_t converterCount = args.arrayValueCount("converter");
+    const std::string converterName = i == converterCount ?
+        "AnySceneConverter" : args.arrayValue("converter", i);
+    worker.converters[i] = worker.converterManager.loadAndInstantiate(converterName);
+    if(!worker.converters[i]) {
+        Debug{} << "Available converter plugins:" << Utility::String::join(worker.converterManager.aliasList(), ", ");
+        return false;
+    }
+
+    /* Set options, if passed */
+    if(args.isSet("verbose")) worker.converters[i]->setFlags(Trade::SceneConverterFlag::Verbose);
+    if(i < args.arrayValueCount("converter-options"))
+        Implementation::setOptions(*worker.converters[i], args.arrayValue("converter-options", i));
+    return true;
+}
+
+/* Imports a mesh from an already opened file, processes it and saves it to
+   the output. Returns an exit code on failure, zero on success. */
+int convertMesh(const Utility::Arguments& args, Worker& worker, const std::string& output, std::chrono::high_resolution_clock::duration& importTime, std::chrono::high_resolution_clock::duration& conversionTime) {
+    Containers::Optional<Trade::MeshData> mesh;
+    {
+        Duration d{importTime};
+        if(!worker.importer->meshCount() || !(mesh = worker.importer->mesh(args.value<UnsignedInt>("mesh"), args.value<UnsignedInt>("level")))) {
+            Error{} << "Cannot import the mesh";
+            return 4;
+        }
+    }
+
+    /* Filter attributes, if requested */
+    if(!args.value("only-attributes").empty()) {
+        std::set<UnsignedInt> only;
+        for(const std::string& i: Utility::String::split(args.value("only-attributes"), ' '))
+            only.insert(std::stoi(i));
+
+        Containers::Array<Trade::MeshAttributeData> attributes;
+        for(UnsignedInt i = 0; i != mesh->attributeCount(); ++i) {
+            if(only.find(i) != only.end())
+                arrayAppend(attributes, mesh->attributeData(i));
+        }
+
+        const Trade::MeshIndexData indices{mesh->indices()};
+        const UnsignedInt vertexCount = mesh->vertexCount();
+        mesh = Trade::MeshData{mesh->primitive(),
+            mesh->releaseIndexData(), indices,
+            mesh->releaseVertexData(), std::move(attributes),
+            vertexCount};
+    }
+
+    /* Remove duplicates, if requested */
+    if(args.isSet("remove-duplicates")) {
+        const UnsignedInt beforeVertexCount = mesh->vertexCount();
+        {
+            Duration d{conversionTime};
+            mesh = MeshTools::removeDuplicates(*std::move(mesh));
+        }
+        if(args.isSet("verbose"))
+            Debug{} << "Duplicate removal:" << beforeVertexCount << "->" << mesh->vertexCount() << "vertices";
+    }
+
+    /* Remove duplicates with fuzzy comparison, if requested */
+    /** @todo accept two values for float and double fuzzy comparison */
+    if(!args.value("remove-duplicates-fuzzy").empty()) {
+        const UnsignedInt beforeVertexCount = mesh->vertexCount();
+        {
+            Duration d{conversionTime};
+            mesh = MeshTools::removeDuplicatesFuzzy(*std::move(mesh), args.value<Float>("remove-duplicates-fuzzy"));
+        }
+        if(args.isSet("verbose"))
+            Debug{} << "Fuzzy duplicate removal:" << beforeVertexCount << "->" << mesh->vertexCount() << "vertices";
+    }
+
+    /* Simplify the mesh, if requested */
+    if(!args.value("simplify").empty()) {
+        if(!mesh->isIndexed() || mesh->primitive() != MeshPrimitive::Triangles || !mesh->hasAttribute(Trade::MeshAttribute::Position)) {
+            Error{} << "The --simplify option requires an indexed" << MeshPrimitive::Triangles << "mesh with positions";
+            return 1;
+        }
+
+        const UnsignedInt beforeIndexCount = mesh->indexCount();
+        const UnsignedInt beforeVertexCount = mesh->vertexCount();
+        {
+            Duration d{conversionTime};
+            mesh = MeshTools::simplify(*std::move(mesh), std::size_t(beforeIndexCount*args.value<Float>("simplify")), args.value<Float>("simplify-error"));
+        }
+        if(args.isSet("verbose"))
+            Debug{} << "Simplification:" << beforeIndexCount/3 << "->" << mesh->indexCount()/3 << "triangles," << beforeVertexCount << "->" << mesh->vertexCount() << "vertices";
+    }
+
+    /* Optimize the mesh, if requested */
+    if(args.isSet("optimize")) {
+        if(!mesh->isIndexed() || mesh->primitive() != MeshPrimitive::Triangles || !mesh->hasAttribute(Trade::MeshAttribute::Position)) {
+            Error{} << "The --optimize option requires an indexed" << MeshPrimitive::Triangles << "mesh with positions";
+            return 1;
+        }
+
+        /* The cache simulation isn't free, so do it only if it's printed */
+        MeshTools::VertexCacheStatistics before{};
+        if(args.isSet("verbose"))
+            before = MeshTools::analyzeVertexCache(*mesh);
+        {
+            Duration d{conversionTime};
+            mesh = MeshTools::optimize(*std::move(mesh));
+        }
+        if(args.isSet("verbose")) {
+            const MeshTools::VertexCacheStatistics after = MeshTools::analyzeVertexCache(*mesh);
+            Debug{} << "Mesh optimization: ACMR" << before.acmr << "->" << after.acmr << Debug::nospace << ", ATVR" << before.atvr << "->" << after.atvr;
+        }
+    }
+
+    /* Assume there's always one passed --converter option less, and the last
+       is implicitly AnySceneConverter. All converters except the last one are
+       expected to support ConvertMesh and the mesh is "piped" from one to the
+       other. If the last converter supports ConvertMeshToFile instead of
+       ConvertMesh, it's used instead of the last implicit AnySceneConverter. */
+    for(std::size_t i = 0, converterCount = args.arrayValueCount("converter"); i <= converterCount; ++i) {
+        const std::string converterName = i == converterCount ?
+            "AnySceneConverter" : args.arrayValue("converter", i);
+        if(!loadConverter(args, worker, i)) return 2;
+        Trade::AbstractSceneConverter& converter = *worker.converters[i];
+
+        /* This is the last --converter (or the implicit AnySceneConverter at
+           the end), output to a file and exit the loop */
+        if(i + 1 >= converterCount && (converter.features() & Trade::SceneConverterFeature::ConvertMeshToFile)) {
+            /* No verbose output for just one converter */
+            if(converterCount > 1 && args.isSet("verbose"))
+                Debug{} << "Saving output with" << converterName << Debug::nospace << "...";
+
+            Duration d{conversionTime};
+            if(!converter.convertToFile(output, *mesh)) {
+                Error{} << "Cannot save file" << output;
+                return 5;
+            }
+
+            break;
+
+        /* This is not the last converter, expect that it's capable of
+           ConvertMesh */
+        } else {
+            CORRADE_INTERNAL_ASSERT(i < converterCount);
+            if(converterCount > 1 && args.isSet("verbose"))
+                Debug{} << "Processing (" << Debug::nospace << (i+1) << Debug::nospace << "/" << Debug::nospace << converterCount << Debug::nospace << ") with" << converterName << Debug::nospace << "...";
+
+            if(!(converter.features() & Trade::SceneConverterFeature::ConvertMesh)) {
+                Error{} << converterName << "doesn't support mesh conversion, only" << converter.features();
+                return 6;
+            }
+
+            Duration d{conversionTime};
+            if(!(mesh = converter.convert(*mesh))) {
+                Error{} << converterName << "cannot convert the mesh";
+                return 7;
+            }
+        }
+    }
+
+    return 0;
+}
+
 }
 
 int main(int argc, char** argv) {
     Utility::Arguments args;
-    args.addArgument("input").setHelp("input", "input file")
-        .addArgument("output").setHelp("output", "output file, ignored if --info is present")
+    args.addArgument("input").setHelp("input", "input file, ignored if --batch is present")
+        .addArgument("output").setHelp("output", "output file, ignored if --info or --batch is present")
         .addOption('I', "importer", "AnySceneImporter").setHelp("importer", "scene importer plugin")
         .addArrayOption('C', "converter").setHelp("converter", "scene converter plugin(s)")
         .addOption("plugin-dir").setHelp("plugin-dir", "override base plugin dir", "DIR")
         .addOption("only-attributes").setHelp("only-attributes", "include only attributes of given IDs in the output", "\"i j …\"")
         .addBooleanOption("remove-duplicates").setHelp("remove-duplicates", "remove duplicate vertices in the mesh after import")
         .addOption("remove-duplicates-fuzzy").setHelp("remove-duplicates-fuzzy", "remove duplicate vertices with fuzzy comparison in the mesh after import", "EPSILON")
+        .addOption("simplify").setHelp("simplify", "simplify the mesh to given ratio of the original index count after import", "RATIO")
+        .addOption("simplify-error", "0.01").setHelp("simplify-error", "maximal error relative to the mesh size allowed by --simplify", "ERROR")
+        .addBooleanOption("optimize").setHelp("optimize", "optimize the mesh for vertex cache, overdraw and vertex fetch after import")
         .addOption('i', "importer-options").setHelp("importer-options", "configuration options to pass to the importer", "key=val,key2=val2,…")
         .addArrayOption('c', "converter-options").setHelp("converter-options", "configuration options to pass to the converter(s)", "key=val,key2=val2,…")
         .addOption("mesh", "0").setHelp("mesh", "mesh to import")
         .addOption("level", "0").setHelp("level", "mesh level to import")
         .addBooleanOption("info").setHelp("info", "print info about the input file and exit")
         .addBooleanOption("bounds").setHelp("bounds", "show bounds of known attributes in --info output")
+        .addOption("batch").setHelp("batch", "convert all files listed in a manifest", "MANIFEST")
+        .addOption('j', "jobs", "0").setHelp("jobs", "number of files converted in parallel by --batch, 0 means all cores", "N")
+        .addOption("report").setHelp("report", "write a tab-separated report of all files converted by --batch", "FILE")
         .addBooleanOption('v', "verbose").setHelp("verbose", "verbose output from importer and converter plugins")
         .addBooleanOption("profile").setHelp("profile", "measure import and conversion time")
         .setParseErrorCallback([](const Utility::Arguments& args, Utility::Arguments::ParseError error, const std::string& key) {
-            /* If --info is passed, we don't need the output argument */
+            /* If --info is passed, we don't need the output argument. With
+               --batch we don't need any. */
             if(error == Utility::Arguments::ParseError::MissingArgument &&
-                key == "output" && args.isSet("info")) return true;
+                ((key == "output" && args.isSet("info")) ||
+                 !args.value("batch").empty())) return true;
 
             /* Handle all other errors as usual */
             return false;
@@ -238,24 +482,75 @@ together. All converters in the chain have to support the ConvertMesh feature,
 the last converter either ConvertMesh or ConvertMeshToFile. If the last
 converter doesn't support conversion to a file, AnySceneConverter is used to
 save its output; if no -C / --converter is specified, AnySceneConverter is
-used.)")
+used.
+
+If --batch is given, the input and output arguments are ignored and all files
+listed in the manifest are converted instead, in parallel on --jobs threads,
+each having its own importer and converter instances. The manifest contains an
+input and output filename separated by a tab on each line, empty lines and
+lines starting with # are ignored. A line with timing and size is printed for
+each converted file and --report saves the same as a tab-separated file.)")
         .parse(argc, argv);
 
-    PluginManager::Manager<Trade::AbstractImporter> importerManager{
-        args.value("plugin-dir").empty() ? std::string{} :
-        Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractImporter::pluginSearchPaths()[0])};
+    /* Batch conversion, if requested */
+    if(!args.value("batch").empty()) {
+        if(args.isSet("info")) {
+            Error{} << "The --info option can't be used together with --batch";
+            return 1;
+        }
+
+        Containers::Optional<Containers::Array<Implementation::BatchJob>> jobs = Implementation::parseBatchManifest(args.value("batch"), true);
+        if(!jobs) return 1;
+
+        /* Load all plugins upfront, so failures are discovered before any
+           conversion starts. Only the implicit AnySceneConverter at the end
+           is loaded on demand, as it's not known yet whether it'll be
+           needed. */
+        const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+        Containers::Array<Containers::Pointer<Worker>> workers{Implementation::batchWorkerCount(args.value<std::size_t>("jobs"), jobs->size())};
+        for(Containers::Pointer<Worker>& worker: workers) {
+            worker = Containers::pointer<Worker>(args);
+            if(!loadImporter(args, *worker)) return 1;
+            for(std::size_t i = 0; i != args.arrayValueCount("converter"); ++i)
+                if(!loadConverter(args, *worker, i)) return 2;
+        }
+
+        const std::size_t failed = Implementation::runBatch(*jobs, workers.size(), [&](const std::size_t i, const Implementation::BatchJob& job) {
+            Worker& worker = *workers[i];
+            std::chrono::high_resolution_clock::duration importTime{}, conversionTime{};
+            {
+                Duration d{importTime};
+                if(!worker.importer->openFile(job.input)) {
+                    Error() << "Cannot open file" << job.input;
+                    return false;
+                }
+            }
+
+            const int result = convertMesh(args, worker, job.output, importTime, conversionTime);
+
+            /* Close the file so its memory can be freed before the worker
+               picks the next one */
+            worker.importer->close();
+            if(result) return false;
+
+            if(args.isSet("profile")) {
+                Debug{} << "Import took" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(importTime).count())/1.0e3f << "seconds, conversion"
+                    << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(conversionTime).count())/1.0e3f << "seconds";
+            }
 
-    Containers::Pointer<Trade::AbstractImporter> importer = importerManager.loadAndInstantiate(args.value("importer"));
-    if(!importer) {
-        Debug{} << "Available importer plugins:" << Utility::String::join(importerManager.aliasList(), ", ");
-        return 1;
+            return true;
+        });
+
+        if(!Implementation::finishBatch(*jobs, failed, std::chrono::high_resolution_clock::now() - start, args.value("report")))
+            return 1;
+        return failed ? 1 : 0;
     }
 
-    /* Set options, if passed */
-    if(args.isSet("verbose")) importer->setFlags(Trade::ImporterFlag::Verbose);
-    Implementation::setOptions(*importer, args.value("importer-options"));
+    Worker worker{args};
+    if(!loadImporter(args, worker)) return 1;
+    Containers::Pointer<Trade::AbstractImporter>& importer = worker.importer;
 
-    std::chrono::high_resolution_clock::duration importTime;
+    std::chrono::high_resolution_clock::duration importTime{};
 
     /* Open the file */
     {
@@ -683,118 +978,9 @@ used.)")
         return error ? 1 : 0;
     }
 
-    Containers::Optional<Trade::MeshData> mesh;
-    {
-        Duration d{importTime};
-        if(!importer->meshCount() || !(mesh = importer->mesh(args.value<UnsignedInt>("mesh"), args.value<UnsignedInt>("level")))) {
-            Error{} << "Cannot import the mesh";
-            return 4;
-        }
-    }
-
-    std::chrono::high_resolution_clock::duration conversionTime;
-
-    /* Filter attributes, if requested */
-    if(!args.value("only-attributes").empty()) {
-        std::set<UnsignedInt> only;
-        for(const std::string& i: Utility::String::split(args.value("only-attributes"), ' '))
-            only.insert(std::stoi(i));
-
-        Containers::Array<Trade::MeshAttributeData> attributes;
-        for(UnsignedInt i = 0; i != mesh->attributeCount(); ++i) {
-            if(only.find(i) != only.end())
-                arrayAppend(attributes, mesh->attributeData(i));
-        }
-
-        const Trade::MeshIndexData indices{mesh->indices()};
-        const UnsignedInt vertexCount = mesh->vertexCount();
-        mesh = Trade::MeshData{mesh->primitive(),
-            mesh->releaseIndexData(), indices,
-            mesh->releaseVertexData(), std::move(attributes),
-            vertexCount};
-    }
-
-    /* Remove duplicates, if requested */
-    if(args.isSet("remove-duplicates")) {
-        const UnsignedInt beforeVertexCount = mesh->vertexCount();
-        {
-            Duration d{conversionTime};
-            mesh = MeshTools::removeDuplicates(*std::move(mesh));
-        }
-        if(args.isSet("verbose"))
-            Debug{} << "Duplicate removal:" << beforeVertexCount << "->" << mesh->vertexCount() << "vertices";
-    }
-
-    /* Remove duplicates with fuzzy comparison, if requested */
-    /** @todo accept two values for float and double fuzzy comparison */
-    if(!args.value("remove-duplicates-fuzzy").empty()) {
-        const UnsignedInt beforeVertexCount = mesh->vertexCount();
-        {
-            Duration d{conversionTime};
-            mesh = MeshTools::removeDuplicatesFuzzy(*std::move(mesh), args.value<Float>("remove-duplicates-fuzzy"));
-        }
-        if(args.isSet("verbose"))
-            Debug{} << "Fuzzy duplicate removal:" << beforeVertexCount << "->" << mesh->vertexCount() << "vertices";
-    }
-
-    /* Load converter plugin */
-    PluginManager::Manager<Trade::AbstractSceneConverter> converterManager{
-        args.value("plugin-dir").empty() ? std::string{} :
-        Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractSceneConverter::pluginSearchPaths()[0])};
-
-    /* Assume there's always one passed --converter option less, and the last
-       is implicitly AnySceneConverter. All converters except the last one are
-       expected to support ConvertMesh and the mesh is "piped" from one to the
-       other. If the last converter supports ConvertMeshToFile instead of
-       ConvertMesh, it's used instead of the last implicit AnySceneConverter. */
-    for(std::size_t i = 0, converterCount = args.arrayValueCount("converter"); i <= converterCount; ++i) {
-        const std::string converterName = i == converterCount ?
-            "AnySceneConverter" : args.arrayValue("converter", i);
-        Containers::Pointer<Trade::AbstractSceneConverter> converter = converterManager.loadAndInstantiate(converterName);
-        if(!converter) {
-            Debug{} << "Available converter plugins:" << Utility::String::join(converterManager.aliasList(), ", ");
-            return 2;
-        }
-
-        /* Set options, if passed */
-        if(args.isSet("verbose")) converter->setFlags(Trade::SceneConverterFlag::Verbose);
-        if(i < args.arrayValueCount("converter-options"))
-            Implementation::setOptions(*converter, args.arrayValue("converter-options", i));
-
-        /* This is the last --converter (or the implicit AnySceneConverter at
-           the end), output to a file and exit the loop */
-        if(i + 1 >= converterCount && (converter->features() & Trade::SceneConverterFeature::ConvertMeshToFile)) {
-            /* No verbose output for just one converter */
-            if(converterCount > 1 && args.isSet("verbose"))
-                Debug{} << "Saving output with" << converterName << Debug::nospace << "...";
-
-            Duration d{conversionTime};
-            if(!converter->convertToFile(args.value("output"), *mesh)) {
-                Error{} << "Cannot save file" << args.value("output");
-                return 5;
-            }
-
-            break;
-
-        /* This is not the last converter, expect that it's capable of
-           ConvertMesh */
-        } else {
-            CORRADE_INTERNAL_ASSERT(i < converterCount);
-            if(converterCount > 1 && args.isSet("verbose"))
-                Debug{} << "Processing (" << Debug::nospace << (i+1) << Debug::nospace << "/" << Debug::nospace << converterCount << Debug::nospace << ") with" << converterName << Debug::nospace << "...";
-
-            if(!(converter->features() & Trade::SceneConverterFeature::ConvertMesh)) {
-                Error{} << converterName << "doesn't support mesh conversion, only" << converter->features();
-                return 6;
-            }
-
-            Duration d{conversionTime};
-            if(!(mesh = converter->convert(*mesh))) {
-                Error{} << converterName << "cannot convert the mesh";
-                return 7;
-            }
-        }
-    }
+    std::chrono::high_resolution_clock::duration conversionTime{};
+    if(const int result = convertMesh(args, worker, args.value("output"), importTime, conversionTime))
+        return result;
 
     if(args.isSet("profile")) {
         Debug{} << "Import took" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(importTime).count())/1.0e3f << "seconds, conversion"
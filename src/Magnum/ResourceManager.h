@@ -26,10 +26,12 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::ResourceManager, @ref Magnum::ResourceDataState, @ref Magnum::ResourcePolicy
+ * @brief Class @ref Magnum::ResourceManager, @ref Magnum::ResourceDataState, @ref Magnum::ResourcePolicy, @ref Magnum::ResourceEvictionPolicy
  */
 
+#include <algorithm>
 #include <unordered_map>
+#include <vector>
 #include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Resource.h"
@@ -89,6 +91,30 @@ enum class ResourcePolicy: UnsignedByte {
     ReferenceCounted
 };
 
+/**
+@brief Resource eviction policy
+@m_since_latest
+
+Decides which resources get unloaded first when a memory budget is exceeded.
+Only resources with @ref ResourcePolicy::Manual that are not referenced are
+considered.
+@see @ref ResourceManager::setMemoryBudget()
+*/
+enum class ResourceEvictionPolicy: UnsignedByte {
+    /**
+     * Resources that were least recently acquired with
+     * @ref ResourceManager::get() are unloaded first.
+     */
+    LeastRecentlyUsed,
+
+    /**
+     * Resources that were acquired with @ref ResourceManager::get() the least
+     * amount of times are unloaded first. Resources acquired the same amount
+     * of times are unloaded in least recently used order.
+     */
+    LeastFrequentlyUsed
+};
+
 template<class> class AbstractResourceLoader;
 
 namespace Implementation {
@@ -112,13 +138,31 @@ template<class T> class ResourceManagerData {
 
         std::size_t count() const { return _data.size(); }
 
+        std::size_t memoryUsage() const { return _memoryUsage; }
+
+        std::size_t memoryUsage(ResourceKey key) const;
+
+        std::size_t memoryBudget() const { return _memoryBudget; }
+
+        ResourceEvictionPolicy evictionPolicy() const { return _evictionPolicy; }
+
+        void setMemoryBudget(std::size_t bytes, ResourceEvictionPolicy policy);
+
+        std::size_t hitCount() const { return _hitCount; }
+
+        std::size_t missCount() const { return _missCount; }
+
+        std::size_t evictedCount() const { return _evictedCount; }
+
+        std::size_t evict();
+
         std::size_t referenceCount(ResourceKey key) const;
 
         ResourceState state(ResourceKey key) const;
 
         template<class U> Resource<T, U> get(ResourceKey key);
 
-        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy);
+        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size);
 
         T* fallback() { return _fallback; }
         const T* fallback() const { return _fallback; }
@@ -127,7 +171,10 @@ template<class T> class ResourceManagerData {
 
         void free();
 
-        void clear() { _data.clear(); }
+        void clear() {
+            _data.clear();
+            _memoryUsage = 0;
+        }
 
         AbstractResourceLoader<T>* loader() { return _loader; }
         const AbstractResourceLoader<T>* loader() const { return _loader; }
@@ -136,8 +183,12 @@ template<class T> class ResourceManagerData {
 
         void setLoader(AbstractResourceLoader<T>* loader);
 
+        std::size_t publish() {
+            return _loader ? _loader->publish() : 0;
+        }
+
     protected:
-        ResourceManagerData(): _fallback(nullptr), _loader(nullptr), _lastChange(0) {}
+        ResourceManagerData(): _fallback(nullptr), _loader(nullptr), _lastChange(0), _memoryUsage(0), _memoryBudget(0), _lastAccess(0), _hitCount(0), _missCount(0), _evictedCount(0), _evictionPolicy(ResourceEvictionPolicy::LeastRecentlyUsed) {}
 
     private:
         struct Data;
@@ -150,10 +201,19 @@ template<class T> class ResourceManagerData {
 
         void decrementReferenceCount(ResourceKey key);
 
+        void unsetLoading(ResourceKey key);
+
         std::unordered_map<ResourceKey, Data> _data;
         T* _fallback;
         AbstractResourceLoader<T>* _loader;
-        std::size_t _lastChange;
+        std::size_t _lastChange,
+            _memoryUsage,
+            _memoryBudget,
+            _lastAccess,
+            _hitCount,
+            _missCount,
+            _evictedCount;
+        ResourceEvictionPolicy _evictionPolicy;
 };
 
 /* Helper class for defining which real types are in the type pack */
@@ -191,6 +251,26 @@ Resource state and policy is configured when setting the resource data in
 @ref set() and can be changed each time the data are updated, although already
 final resources cannot obviously be set as mutable again.
 
+@section ResourceManager-budget Memory budget
+
+Each resource can have a size in bytes reported when setting it with
+@ref set() or @ref AbstractResourceLoader::set(), the total for each type is
+available through @ref memoryUsage(). After setting a budget with
+@ref setMemoryBudget(), whenever the memory usage of given type goes over
+it, resources with @ref ResourcePolicy::Manual that aren't referenced anymore
+get unloaded, in an order given by @ref ResourceEvictionPolicy, until the
+usage fits into the budget again. Resources with zero size, resident and
+reference-counted resources are never evicted. If the budget can't be met by
+evicting, the manager stays over budget until more resources become
+unreferenced.
+
+Evicted resources are removed from the manager completely, so if a loader is
+set, requesting such resource with @ref get() again loads it again.
+@ref hitCount(), @ref missCount() and @ref evictedCount() can be used to
+monitor how well the budget fits the workload:
+
+@snippet Magnum.cpp ResourceManager-budget
+
 Basic usage is:
 
 <ul>
@@ -241,6 +321,113 @@ template<class... Types> class ResourceManager: private Implementation::Resource
             return this->Implementation::ResourceManagerData<T>::count();
         }
 
+        /**
+         * @brief Memory used by resources of given type
+         * @m_since_latest
+         *
+         * Sum of sizes passed to @ref set() for all resources of given type.
+         * See @ref ResourceManager-budget for more information.
+         */
+        template<class T> std::size_t memoryUsage() const {
+            return this->Implementation::ResourceManagerData<T>::memoryUsage();
+        }
+
+        /**
+         * @brief Memory used by given resource
+         * @m_since_latest
+         *
+         * Size passed to @ref set() for given resource, or @cpp 0 @ce if
+         * the resource isn't loaded.
+         */
+        template<class T> std::size_t memoryUsage(ResourceKey key) const {
+            return this->Implementation::ResourceManagerData<T>::memoryUsage(key);
+        }
+
+        /**
+         * @brief Memory budget for resources of given type
+         * @m_since_latest
+         *
+         * If @cpp 0 @ce, there's no budget. Default is @cpp 0 @ce.
+         */
+        template<class T> std::size_t memoryBudget() const {
+            return this->Implementation::ResourceManagerData<T>::memoryBudget();
+        }
+
+        /**
+         * @brief Eviction policy for resources of given type
+         * @m_since_latest
+         *
+         * Default is @ref ResourceEvictionPolicy::LeastRecentlyUsed.
+         */
+        template<class T> ResourceEvictionPolicy evictionPolicy() const {
+            return this->Implementation::ResourceManagerData<T>::evictionPolicy();
+        }
+
+        /**
+         * @brief Set memory budget for resources of given type
+         * @param bytes     Budget in bytes. Use @cpp 0 @ce to disable the
+         *      budget.
+         * @param policy    Eviction policy
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Resources are evicted right away if the current memory usage is
+         * over the budget. See @ref ResourceManager-budget for more
+         * information.
+         */
+        template<class T> ResourceManager<Types...>& setMemoryBudget(std::size_t bytes, ResourceEvictionPolicy policy = ResourceEvictionPolicy::LeastRecentlyUsed) {
+            this->Implementation::ResourceManagerData<T>::setMemoryBudget(bytes, policy);
+            return *this;
+        }
+
+        /**
+         * @brief Evict resources of given type that are over the budget
+         * @return Count of evicted resources
+         * @m_since_latest
+         *
+         * Eviction is done automatically when setting a resource, changing
+         * the budget or removing the last reference to a resource, so this
+         * function doesn't need to be called in usual circumstances. Does
+         * nothing if there's no budget or the usage is within the budget.
+         */
+        template<class T> std::size_t evict() {
+            return this->Implementation::ResourceManagerData<T>::evict();
+        }
+
+        /**
+         * @brief Count of hits for given type
+         * @m_since_latest
+         *
+         * Count of @ref get() calls for resources that had data available.
+         * @see @ref missCount(), @ref evictedCount()
+         */
+        template<class T> std::size_t hitCount() const {
+            return this->Implementation::ResourceManagerData<T>::hitCount();
+        }
+
+        /**
+         * @brief Count of misses for given type
+         * @m_since_latest
+         *
+         * Count of @ref get() calls for resources that didn't have data
+         * available, which includes resources that are loading, weren't
+         * found or were evicted.
+         * @see @ref hitCount(), @ref evictedCount()
+         */
+        template<class T> std::size_t missCount() const {
+            return this->Implementation::ResourceManagerData<T>::missCount();
+        }
+
+        /**
+         * @brief Count of evicted resources of given type
+         * @m_since_latest
+         *
+         * @see @ref hitCount(), @ref missCount()
+         */
+        template<class T> std::size_t evictedCount() const {
+            return this->Implementation::ResourceManagerData<T>::evictedCount();
+        }
+
         /**
          * @brief Get resource reference
          *
@@ -282,12 +469,16 @@ template<class... Types> class ResourceManager: private Implementation::Resource
          * zero reference count. It means that all reference counted resources
          * which were only loaded but not used will stay loaded and you need to
          * explicitly call @ref free() to delete them.
+         *
+         * The @p size is the amount of memory used by the resource in bytes,
+         * counted into @ref memoryUsage(). See @ref ResourceManager-budget
+         * for more information.
          * @attention Subsequent updates are not possible if resource state is
          *      already @ref ResourceState::Final.
          * @see @ref referenceCount(), @ref state()
          */
-        template<class T> ResourceManager<Types...>& set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy) {
-            this->Implementation::ResourceManagerData<T>::set(key, data, state, policy);
+        template<class T> ResourceManager<Types...>& set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            this->Implementation::ResourceManagerData<T>::set(key, data, state, policy, size);
             return *this;
         }
 
@@ -295,14 +486,14 @@ template<class... Types> class ResourceManager: private Implementation::Resource
          * @overload
          * @m_since{2019,10}
          */
-        template<class T> ResourceManager<Types...>& set(ResourceKey key, Containers::Pointer<T>&& data, ResourceDataState state, ResourcePolicy policy) {
-            set(key, data.release(), state, policy);
+        template<class T> ResourceManager<Types...>& set(ResourceKey key, Containers::Pointer<T>&& data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            set(key, data.release(), state, policy, size);
             return *this;
         }
 
         /** @overload */
-        template<class U> ResourceManager<Types...>& set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy) {
-            return set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy);
+        template<class U> ResourceManager<Types...>& set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            return set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy, size);
         }
 
         /**
@@ -431,6 +622,33 @@ template<class... Types> class ResourceManager: private Implementation::Resource
             return setLoader(loader.release());
         }
 
+        /**
+         * @brief Publish asynchronously loaded resources of given type
+         * @return Count of published resources
+         * @m_since_latest
+         *
+         * If there's a loader for given type, calls
+         * @ref AbstractResourceLoader::publish(), otherwise returns
+         * @cpp 0 @ce. See @ref AbstractResourceLoader-async for more
+         * information.
+         */
+        template<class T> std::size_t publish() {
+            return this->Implementation::ResourceManagerData<T>::publish();
+        }
+
+        /**
+         * @brief Publish all asynchronously loaded resources
+         * @return Count of published resources
+         * @m_since_latest
+         *
+         * Calls @ref publish() for all types. Meant to be called at a single
+         * point in the frame, so all @ref Resource instances see the loaded
+         * data at the same time.
+         */
+        std::size_t publish() {
+            return publishInternal(Implementation::ResourceTypePack<Types...>{});
+        }
+
     private:
         template<class FirstType, class ...NextTypes> void freeInternal(Implementation::ResourceTypePack<FirstType, NextTypes...>) {
             free<FirstType>();
@@ -444,6 +662,12 @@ template<class... Types> class ResourceManager: private Implementation::Resource
         }
         void clearInternal(Implementation::ResourceTypePack<>) const {}
 
+        template<class FirstType, class ...NextTypes> std::size_t publishInternal(Implementation::ResourceTypePack<FirstType, NextTypes...>) {
+            const std::size_t count = publish<FirstType>();
+            return count + publishInternal(Implementation::ResourceTypePack<NextTypes...>{});
+        }
+        std::size_t publishInternal(Implementation::ResourceTypePack<>) const { return 0; }
+
         template<class FirstType, class ...NextTypes> void freeLoaders(Implementation::ResourceTypePack<FirstType, NextTypes...>) {
             Implementation::ResourceManagerData<FirstType>::freeLoader();
             freeLoaders(Implementation::ResourceTypePack<NextTypes...>{});
@@ -463,6 +687,52 @@ template<class T> ResourceManagerData<T>::~ResourceManagerData() {
     safeDelete(_fallback);
 }
 
+template<class T> std::size_t ResourceManagerData<T>::memoryUsage(const ResourceKey key) const {
+    auto it = _data.find(key);
+    if(it == _data.end()) return 0;
+    return it->second.size;
+}
+
+template<class T> void ResourceManagerData<T>::setMemoryBudget(const std::size_t bytes, const ResourceEvictionPolicy policy) {
+    _memoryBudget = bytes;
+    _evictionPolicy = policy;
+    evict();
+}
+
+template<class T> std::size_t ResourceManagerData<T>::evict() {
+    if(!_memoryBudget || _memoryUsage <= _memoryBudget) return 0;
+
+    /* Gather unreferenced manually managed resources that actually occupy
+       some memory */
+    typedef typename std::unordered_map<ResourceKey, Data>::iterator Iterator;
+    std::vector<Iterator> candidates;
+    for(auto it = _data.begin(); it != _data.end(); ++it)
+        if(it->second.policy == ResourcePolicy::Manual && !it->second.referenceCount && it->second.size)
+            candidates.push_back(it);
+
+    /* Order them so the ones to evict first are at the front */
+    if(_evictionPolicy == ResourceEvictionPolicy::LeastFrequentlyUsed)
+        std::sort(candidates.begin(), candidates.end(), [](const Iterator& a, const Iterator& b) {
+            return a->second.accessCount < b->second.accessCount || (a->second.accessCount == b->second.accessCount && a->second.lastAccess < b->second.lastAccess);
+        });
+    else
+        std::sort(candidates.begin(), candidates.end(), [](const Iterator& a, const Iterator& b) {
+            return a->second.lastAccess < b->second.lastAccess;
+        });
+
+    /* Erasing doesn't invalidate iterators to other elements */
+    std::size_t count = 0;
+    for(const Iterator& it: candidates) {
+        if(_memoryUsage <= _memoryBudget) break;
+        _memoryUsage -= it->second.size;
+        _data.erase(it);
+        ++count;
+    }
+
+    _evictedCount += count;
+    return count;
+}
+
 template<class T> std::size_t ResourceManagerData<T>::referenceCount(const ResourceKey key) const {
     auto it = _data.find(key);
     if(it == _data.end()) return 0;
@@ -493,14 +763,29 @@ template<class T> ResourceState ResourceManagerData<T>::state(const ResourceKey
 }
 
 template<class T> template<class U> Resource<T, U> ResourceManagerData<T>::get(ResourceKey key) {
-    /* Ask loader for the data, if they aren't there yet */
-    if(_loader && _data.find(key) == _data.end())
-        _loader->load(key);
+    auto it = _data.find(key);
+    bool load = false;
+    if(it != _data.end() && it->second.data) {
+        ++_hitCount;
+        ++it->second.accessCount;
+        it->second.lastAccess = ++_lastAccess;
 
-    return Resource<T, U>(this, key);
+    } else {
+        ++_missCount;
+
+        /* Ask loader for the data, if they aren't there yet */
+        load = _loader && it == _data.end();
+    }
+
+    /* Create the handle before asking the loader, so the reference is already
+       taken when a synchronous loader calls set() and the freshly loaded data
+       aren't immediately evicted again */
+    Resource<T, U> resource{this, key};
+    if(load) _loader->load(key);
+    return resource;
 }
 
-template<class T> void ResourceManagerData<T>::set(const ResourceKey key, T* const data, const ResourceDataState state, const ResourcePolicy policy) {
+template<class T> void ResourceManagerData<T>::set(const ResourceKey key, T* const data, const ResourceDataState state, const ResourcePolicy policy, const std::size_t size) {
     auto it = _data.find(key);
 
     /* NotFound / Loading state shouldn't have any data */
@@ -516,12 +801,22 @@ template<class T> void ResourceManagerData<T>::set(const ResourceKey key, T* con
         it = _data.emplace(key, Data()).first;
 
     /* Otherwise delete previous data */
-    else safeDelete(it->second.data);
+    else {
+        safeDelete(it->second.data);
+        _memoryUsage -= it->second.size;
+    }
 
     it->second.data = data;
     it->second.state = state;
     it->second.policy = policy;
+    it->second.size = data ? size : 0;
+    /* Setting the data counts as an use, so with the least recently used
+       policy a freshly loaded resource isn't the first to be evicted */
+    it->second.lastAccess = ++_lastAccess;
+    _memoryUsage += it->second.size;
     ++_lastChange;
+
+    evict();
 }
 
 template<class T> void ResourceManagerData<T>::setFallback(T* const data) {
@@ -535,14 +830,17 @@ template<class T> void ResourceManagerData<T>::setFallback(T* const data) {
 template<class T> void ResourceManagerData<T>::free() {
     /* Delete all non-referenced non-resident resources */
     for(auto it = _data.begin(); it != _data.end(); ) {
-        if(it->second.policy != ResourcePolicy::Resident && !it->second.referenceCount)
+        if(it->second.policy != ResourcePolicy::Resident && !it->second.referenceCount) {
+            _memoryUsage -= it->second.size;
             it = _data.erase(it);
-        else ++it;
+        } else ++it;
     }
 }
 
 template<class T> void ResourceManagerData<T>::setLoader(AbstractResourceLoader<T>* const loader) {
-    /* Delete previous loader */
+    /* Delete previous loader. Stop its asynchronous loading first, as the
+       worker threads need the subclass to be still alive. */
+    if(_loader) _loader->stopAsync();
     delete _loader;
 
     /* Add new loader */
@@ -552,6 +850,9 @@ template<class T> void ResourceManagerData<T>::setLoader(AbstractResourceLoader<
 template<class T> void ResourceManagerData<T>::freeLoader() {
     if(!_loader) return;
 
+    /* Wait for asynchronous loading and publish whatever got loaded while the
+       subclass is still alive */
+    _loader->stopAsync();
     _loader->manager = nullptr;
     delete _loader;
 }
@@ -560,17 +861,41 @@ template<class T> void ResourceManagerData<T>::decrementReferenceCount(ResourceK
     auto it = _data.find(key);
     CORRADE_INTERNAL_ASSERT(it != _data.end());
 
+    if(--it->second.referenceCount) return;
+
     /* Free the resource if it is reference counted */
-    if(--it->second.referenceCount == 0 && it->second.policy == ResourcePolicy::ReferenceCounted)
+    if(it->second.policy == ResourcePolicy::ReferenceCounted) {
+        _memoryUsage -= it->second.size;
+        _data.erase(it);
+
+    /* Or evict if it became a candidate and we're over budget */
+    } else if(it->second.policy == ResourcePolicy::Manual && _memoryBudget && _memoryUsage > _memoryBudget)
+        evict();
+}
+
+template<class T> void ResourceManagerData<T>::unsetLoading(const ResourceKey key) {
+    auto it = _data.find(key);
+    if(it == _data.end() || it->second.state != ResourceDataState::Loading)
+        return;
+
+    /* Remove the resource if nothing references it, otherwise put it back to
+       the same state as a resource that was referenced but never set */
+    if(!it->second.referenceCount) {
+        _memoryUsage -= it->second.size;
         _data.erase(it);
+    } else {
+        it->second.state = ResourceDataState::Mutable;
+        it->second.policy = ResourcePolicy::Manual;
+    }
+    ++_lastChange;
 }
 
 template<class T> struct ResourceManagerData<T>::Data {
-    Data(): data(nullptr), state(ResourceDataState::Mutable), policy(ResourcePolicy::Manual), referenceCount(0) {}
+    Data(): data(nullptr), state(ResourceDataState::Mutable), policy(ResourcePolicy::Manual), referenceCount(0), size(0), lastAccess(0), accessCount(0) {}
 
     Data(const Data&) = delete;
 
-    Data(Data&& other): data(other.data), state(other.state), policy(other.policy), referenceCount(other.referenceCount) {
+    Data(Data&& other): data(other.data), state(other.state), policy(other.policy), referenceCount(other.referenceCount), size(other.size), lastAccess(other.lastAccess), accessCount(other.accessCount) {
         other.data = nullptr;
         other.referenceCount = 0;
     }
@@ -584,6 +909,9 @@ template<class T> struct ResourceManagerData<T>::Data {
     ResourceDataState state;
     ResourcePolicy policy;
     std::size_t referenceCount;
+    std::size_t size;
+    std::size_t lastAccess;
+    std::size_t accessCount;
 };
 
 template<class T> inline ResourceManagerData<T>::Data::~Data() {
@@ -0,0 +1,50 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FlatScene.hpp"
+
+#include "Magnum/Implementation/parallelFor.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace SceneGraph { namespace Implementation {
+
+namespace {
+
+/* Each thread updates at least this many nodes */
+constexpr std::size_t MinNodesPerThread = 16384;
+
+}
+
+std::size_t flatSceneWorkerCount(const std::size_t threadCount, const std::size_t subtreeCount, const std::size_t nodeCount) {
+    return Math::max(Math::min(Magnum::Implementation::parallelThreadCount(threadCount, nodeCount, MinNodesPerThread), subtreeCount), std::size_t{1});
+}
+
+void flatSceneParallelFor(const std::size_t count, void(*const function)(void*, std::size_t), void* const state) {
+    Magnum::Implementation::parallelFor(count, [function, state](const std::size_t i) {
+        function(state, i);
+    });
+}
+
+}}}
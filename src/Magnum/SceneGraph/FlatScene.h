@@ -0,0 +1,416 @@
+#ifndef Magnum_SceneGraph_FlatScene_h
+#define Magnum_SceneGraph_FlatScene_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::FlatScene, @ref Magnum::SceneGraph::FlatObject, alias @ref Magnum::SceneGraph::BasicFlatScene2D, @ref Magnum::SceneGraph::BasicFlatScene3D, @ref Magnum::SceneGraph::BasicFlatObject2D, @ref Magnum::SceneGraph::BasicFlatObject3D, typedef @ref Magnum::SceneGraph::FlatScene2D, @ref Magnum::SceneGraph::FlatScene3D, @ref Magnum::SceneGraph::FlatObject2D, @ref Magnum::SceneGraph::FlatObject3D
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Scene with a flat node hierarchy
+@m_since_latest
+
+Alternative to @ref Scene and @ref Object suited for large amounts of dynamic
+objects. Instead of a linked tree of objects, the hierarchy is a set of nodes
+identified by an integer ID, with parents and local transformations stored in
+contiguous arrays. The arrays are ordered so each top-level subtree occupies a
+contiguous range and nodes inside it are sorted by depth. Changed nodes are
+tracked in a bitset and @ref update() calculates absolute transformations of
+all changed nodes and their children in a single linear pass, instead of
+chasing parent pointers for each object separately.
+
+@section SceneGraph-FlatScene-usage Usage
+
+Nodes are added with @ref addNode(), optionally with a parent node and an
+initial transformation. A transformation is then changed with
+@ref setNodeTransformation() and the parent with @ref setNodeParent().
+Absolute transformations are recalculated on the next call to @ref update()
+and queried with @ref nodeAbsoluteTransformation():
+
+@snippet MagnumSceneGraph.cpp FlatScene-usage
+
+Nodes can't be removed. Adding nodes or changing node parents causes the
+arrays to be reordered on the next @ref update(), which is a
+@f$ \mathcal{O}(n \log n) @f$ operation, so it's preferable to create the whole
+hierarchy upfront.
+
+@section SceneGraph-FlatScene-features Interaction with features
+
+Features such as @ref Camera or @ref Drawable can't be attached to nodes
+directly. Instead, create a @ref FlatObject for given node and attach the
+features to it. The @ref FlatScene itself is an @ref AbstractObject as well,
+acting as a root of all flat objects, so @ref Camera::draw() works the same as
+with a regular @ref Scene. The drawable transformations are taken from
+absolute transformations calculated by @ref update(), which is called
+implicitly if any node is dirty:
+
+@snippet MagnumSceneGraph.cpp FlatScene-features
+
+@section SceneGraph-FlatScene-threads Multithreaded update
+
+With @ref setThreadCount() set to a value other than @cpp 1 @ce, the
+top-level subtrees are distributed among multiple threads in @ref update().
+That's beneficial only for scenes with many independent subtrees, as a
+subtree is always processed by a single thread. On Emscripten the update is
+always single-threaded.
+
+@section SceneGraph-FlatScene-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref FlatScene.hpp implementation file to avoid linker
+errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref FlatScene2D
+-   @ref FlatScene3D
+
+@see @ref BasicFlatScene2D, @ref BasicFlatScene3D
+*/
+template<UnsignedInt dimensions, class T> class FlatScene: public AbstractObject<dimensions, T> {
+    public:
+        /** @brief Matrix type */
+        typedef MatrixTypeFor<dimensions, T> MatrixType;
+
+        /** @brief Constructor */
+        explicit FlatScene();
+
+        ~FlatScene();
+
+        /** @brief Node count */
+        std::size_t nodeCount() const { return _parents.size(); }
+
+        /**
+         * @brief Add a node
+         * @param parent            Parent node ID or @cpp -1 @ce for a
+         *      top-level node
+         * @param transformation    Node transformation relative to the
+         *      parent
+         * @return ID of the newly added node
+         *
+         * IDs are assigned sequentially, starting from @cpp 0 @ce. The node
+         * is marked as dirty.
+         */
+        UnsignedInt addNode(Int parent = -1, const MatrixType& transformation = MatrixType{});
+
+        /**
+         * @brief Node parent
+         *
+         * Returns parent node ID or @cpp -1 @ce for a top-level node.
+         * Expects that @p node is less than @ref nodeCount().
+         */
+        Int nodeParent(UnsignedInt node) const;
+
+        /**
+         * @brief Set node parent
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p node is less than @ref nodeCount() and @p parent
+         * is either @cpp -1 @ce or a node that isn't @p node or any of its
+         * children. The node is marked as dirty.
+         */
+        FlatScene<dimensions, T>& setNodeParent(UnsignedInt node, Int parent);
+
+        /**
+         * @brief Node transformation
+         *
+         * Transformation relative to the parent node. Expects that @p node
+         * is less than @ref nodeCount().
+         */
+        MatrixType nodeTransformation(UnsignedInt node) const;
+
+        /**
+         * @brief Set node transformation
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p node is less than @ref nodeCount(). The node is
+         * marked as dirty.
+         */
+        FlatScene<dimensions, T>& setNodeTransformation(UnsignedInt node, const MatrixType& transformation);
+
+        /**
+         * @brief Node absolute transformation
+         *
+         * If neither the node nor any of its parents is dirty, returns the
+         * transformation calculated by the last @ref update(). Otherwise the
+         * transformation is calculated by walking the parent chain. Expects
+         * that @p node is less than @ref nodeCount().
+         */
+        MatrixType nodeAbsoluteTransformation(UnsignedInt node) const;
+
+        /**
+         * @brief Whether node absolute transformation is dirty
+         *
+         * Returns @cpp true @ce if transformation or parent of the node or any
+         * of its parents has changed since the last @ref update(),
+         * @cpp false @ce otherwise. Expects that @p node is less than
+         * @ref nodeCount().
+         */
+        bool isNodeDirty(UnsignedInt node) const;
+
+        /**
+         * @brief Thread count
+         *
+         * Default is @cpp 1 @ce.
+         */
+        std::size_t threadCount() const { return _threadCount; }
+
+        /**
+         * @brief Set thread count
+         * @return Reference to self (for method chaining)
+         *
+         * A value of @cpp 0 @ce uses all available hardware threads. See
+         * @ref SceneGraph-FlatScene-threads for more information.
+         */
+        FlatScene<dimensions, T>& setThreadCount(std::size_t count) {
+            _threadCount = count;
+            return *this;
+        }
+
+        /**
+         * @brief Update absolute transformations
+         *
+         * Recalculates absolute transformations of all dirty nodes and their
+         * children and marks them as clean. If no node is dirty, the function
+         * does nothing.
+         */
+        void update();
+
+    private:
+        template<UnsignedInt, class> friend class FlatObject;
+
+        /* Calculates absolute transformations of all dirty nodes in given
+           range of top-level subtrees */
+        void updateSubtrees(std::size_t begin, std::size_t end);
+        void reorder();
+
+        bool isDirtyAt(std::size_t position) const {
+            return _dirty[position >> 3] & (1 << (position & 7));
+        }
+        void setDirtyAt(std::size_t position) {
+            _dirty[position >> 3] |= 1 << (position & 7);
+            _anyDirty = true;
+        }
+
+        AbstractObject<dimensions, T>* doScene() override final;
+        const AbstractObject<dimensions, T>* doScene() const override final;
+        AbstractObject<dimensions, T>* doParent() override final;
+        const AbstractObject<dimensions, T>* doParent() const override final;
+        MatrixType doTransformationMatrix() const override final;
+        MatrixType doAbsoluteTransformationMatrix() const override final;
+        std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& finalTransformationMatrix) const override final;
+        bool doIsDirty() const override final;
+        void doSetDirty() override final;
+        void doSetClean() override final;
+        void doSetClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects) override final;
+
+        /* Indexed by node ID */
+        Containers::Array<Int> _parents;
+        Containers::Array<UnsignedInt> _positions;
+
+        /* Indexed by position, sorted by top-level subtree and depth */
+        Containers::Array<UnsignedInt> _nodes;
+        Containers::Array<Int> _parentPositions;
+        Containers::Array<MatrixType> _transformations;
+        Containers::Array<MatrixType> _absoluteTransformations;
+        /* Value of _updateCount when the absolute transformation was last
+           calculated, used by FlatObject to detect changes */
+        Containers::Array<UnsignedInt> _updates;
+        Containers::Array<UnsignedByte> _dirty;
+
+        /* Offsets of top-level subtrees in the position-indexed arrays, plus
+           one more with the node count */
+        Containers::Array<UnsignedInt> _subtreeOffsets;
+
+        std::size_t _threadCount{1};
+        UnsignedInt _updateCount{};
+        bool _anyDirty{};
+        bool _reorder{};
+};
+
+/**
+@brief Object attached to a node of a flat scene
+@m_since_latest
+
+Allows attaching features such as @ref Camera or @ref Drawable to a node of a
+@ref FlatScene. Multiple objects can be attached to the same node. The object
+doesn't own the node, its transformation is accessed through the scene. See
+@ref SceneGraph-FlatScene-features for an example.
+
+The object is considered dirty if the node or any of its parents has been
+changed since the last @ref update(), or if the node absolute transformation
+was recalculated since features of this object were last cleaned.
+@ref AbstractFeature::markDirty() is called only from an explicit
+@ref setDirty(), not when the node changes.
+
+@see @ref BasicFlatObject2D, @ref BasicFlatObject3D
+*/
+template<UnsignedInt dimensions, class T> class FlatObject: public AbstractObject<dimensions, T> {
+    public:
+        /** @brief Matrix type */
+        typedef MatrixTypeFor<dimensions, T> MatrixType;
+
+        /**
+         * @brief Constructor
+         * @param scene     Scene containing the node
+         * @param node      Node ID
+         *
+         * Expects that @p node is less than @ref FlatScene::nodeCount().
+         */
+        explicit FlatObject(FlatScene<dimensions, T>& scene, UnsignedInt node);
+
+        ~FlatObject();
+
+        /** @brief Scene containing the node */
+        FlatScene<dimensions, T>& flatScene() { return _scene; }
+        const FlatScene<dimensions, T>& flatScene() const { return _scene; } /**< @overload */
+
+        /** @brief Node ID */
+        UnsignedInt node() const { return _node; }
+
+    private:
+        template<UnsignedInt, class> friend class FlatScene;
+
+        void setCleanInternal();
+
+        AbstractObject<dimensions, T>* doScene() override final;
+        const AbstractObject<dimensions, T>* doScene() const override final;
+        AbstractObject<dimensions, T>* doParent() override final;
+        const AbstractObject<dimensions, T>* doParent() const override final;
+        MatrixType doTransformationMatrix() const override final;
+        MatrixType doAbsoluteTransformationMatrix() const override final;
+        std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& finalTransformationMatrix) const override final;
+        bool doIsDirty() const override final;
+        void doSetDirty() override final;
+        void doSetClean() override final;
+        void doSetClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects) override final;
+
+        FlatScene<dimensions, T>& _scene;
+        UnsignedInt _node;
+        /* FlatScene::_updates value at the last clean, ~0 for never cleaned */
+        UnsignedInt _cleanUpdate{~UnsignedInt{}};
+        bool _forceDirty{};
+};
+
+/**
+@brief Flat scene for two-dimensional scenes
+@m_since_latest
+
+Convenience alternative to @cpp FlatScene<2, T> @ce. See @ref FlatScene for
+more information.
+@see @ref FlatScene2D, @ref BasicFlatScene3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicFlatScene2D = FlatScene<2, T>;
+#endif
+
+/**
+@brief Flat scene for two-dimensional float scenes
+@m_since_latest
+
+@see @ref FlatScene3D
+*/
+typedef BasicFlatScene2D<Float> FlatScene2D;
+
+/**
+@brief Flat scene for three-dimensional scenes
+@m_since_latest
+
+Convenience alternative to @cpp FlatScene<3, T> @ce. See @ref FlatScene for
+more information.
+@see @ref FlatScene3D, @ref BasicFlatScene2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicFlatScene3D = FlatScene<3, T>;
+#endif
+
+/**
+@brief Flat scene for three-dimensional float scenes
+@m_since_latest
+
+@see @ref FlatScene2D
+*/
+typedef BasicFlatScene3D<Float> FlatScene3D;
+
+/**
+@brief Flat object for two-dimensional scenes
+@m_since_latest
+
+Convenience alternative to @cpp FlatObject<2, T> @ce. See @ref FlatObject for
+more information.
+@see @ref FlatObject2D, @ref BasicFlatObject3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicFlatObject2D = FlatObject<2, T>;
+#endif
+
+/**
+@brief Flat object for two-dimensional float scenes
+@m_since_latest
+
+@see @ref FlatObject3D
+*/
+typedef BasicFlatObject2D<Float> FlatObject2D;
+
+/**
+@brief Flat object for three-dimensional scenes
+@m_since_latest
+
+Convenience alternative to @cpp FlatObject<3, T> @ce. See @ref FlatObject for
+more information.
+@see @ref FlatObject3D, @ref BasicFlatObject2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicFlatObject3D = FlatObject<3, T>;
+#endif
+
+/**
+@brief Flat object for three-dimensional float scenes
+@m_since_latest
+
+@see @ref FlatObject2D
+*/
+typedef BasicFlatObject3D<Float> FlatObject3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !(defined(CORRADE_TARGET_MINGW) && !defined(CORRADE_TARGET_CLANG))
+extern template class MAGNUM_SCENEGRAPH_EXPORT FlatScene<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT FlatScene<3, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT FlatObject<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT FlatObject<3, Float>;
+#endif
+
+}}
+
+#endif
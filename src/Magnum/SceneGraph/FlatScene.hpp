@@ -0,0 +1,384 @@
+#ifndef Magnum_SceneGraph_FlatScene_hpp
+#define Magnum_SceneGraph_FlatScene_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref FlatScene.h
+ * @m_since_latest
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <numeric>
+#include <vector>
+#include <Corrade/Containers/GrowableArray.h>
+
+#include "Magnum/SceneGraph/AbstractFeature.h"
+#include "Magnum/SceneGraph/FlatScene.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+/* Non-templated so the threading is contained in the library */
+MAGNUM_SCENEGRAPH_EXPORT std::size_t flatSceneWorkerCount(std::size_t threadCount, std::size_t subtreeCount, std::size_t nodeCount);
+MAGNUM_SCENEGRAPH_EXPORT void flatSceneParallelFor(std::size_t count, void(*function)(void*, std::size_t), void* state);
+
+}
+
+template<UnsignedInt dimensions, class T> FlatScene<dimensions, T>::FlatScene() = default;
+
+template<UnsignedInt dimensions, class T> FlatScene<dimensions, T>::~FlatScene() = default;
+
+template<UnsignedInt dimensions, class T> UnsignedInt FlatScene<dimensions, T>::addNode(const Int parent, const MatrixType& transformation) {
+    CORRADE_ASSERT(parent >= -1 && parent < Int(_parents.size()),
+        "SceneGraph::FlatScene::addNode(): parent" << parent << "out of range for" << _parents.size() << "nodes", {});
+
+    /* The node is put at the end, which keeps parents before children but
+       breaks the subtree ordering, so reorder on next update() */
+    const UnsignedInt node = _parents.size();
+    arrayAppend(_parents, parent);
+    arrayAppend(_positions, node);
+    arrayAppend(_nodes, node);
+    arrayAppend(_parentPositions, parent == -1 ? -1 : Int(_positions[parent]));
+    arrayAppend(_transformations, transformation);
+    arrayAppend(_absoluteTransformations, transformation);
+    arrayAppend(_updates, 0u);
+    if(node % 8 == 0) arrayAppend(_dirty, UnsignedByte{});
+    setDirtyAt(node);
+    _reorder = true;
+
+    return node;
+}
+
+template<UnsignedInt dimensions, class T> Int FlatScene<dimensions, T>::nodeParent(const UnsignedInt node) const {
+    CORRADE_ASSERT(node < _parents.size(),
+        "SceneGraph::FlatScene::nodeParent(): index" << node << "out of range for" << _parents.size() << "nodes", {});
+    return _parents[node];
+}
+
+template<UnsignedInt dimensions, class T> FlatScene<dimensions, T>& FlatScene<dimensions, T>::setNodeParent(const UnsignedInt node, const Int parent) {
+    CORRADE_ASSERT(node < _parents.size(),
+        "SceneGraph::FlatScene::setNodeParent(): index" << node << "out of range for" << _parents.size() << "nodes", *this);
+    CORRADE_ASSERT(parent >= -1 && parent < Int(_parents.size()),
+        "SceneGraph::FlatScene::setNodeParent(): parent" << parent << "out of range for" << _parents.size() << "nodes", *this);
+    #ifndef CORRADE_NO_ASSERT
+    for(Int p = parent; p != -1; p = _parents[p])
+        CORRADE_ASSERT(UnsignedInt(p) != node,
+            "SceneGraph::FlatScene::setNodeParent(): can't parent node" << node << "to itself or its child" << parent, *this);
+    #endif
+
+    _parents[node] = parent;
+    _parentPositions[_positions[node]] = parent == -1 ? -1 : Int(_positions[parent]);
+    setDirtyAt(_positions[node]);
+    /* The new parent can be after the node, reorder on next update() */
+    _reorder = true;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> auto FlatScene<dimensions, T>::nodeTransformation(const UnsignedInt node) const -> MatrixType {
+    CORRADE_ASSERT(node < _parents.size(),
+        "SceneGraph::FlatScene::nodeTransformation(): index" << node << "out of range for" << _parents.size() << "nodes", {});
+    return _transformations[_positions[node]];
+}
+
+template<UnsignedInt dimensions, class T> FlatScene<dimensions, T>& FlatScene<dimensions, T>::setNodeTransformation(const UnsignedInt node, const MatrixType& transformation) {
+    CORRADE_ASSERT(node < _parents.size(),
+        "SceneGraph::FlatScene::setNodeTransformation(): index" << node << "out of range for" << _parents.size() << "nodes", *this);
+    const UnsignedInt position = _positions[node];
+    _transformations[position] = transformation;
+    setDirtyAt(position);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> bool FlatScene<dimensions, T>::isNodeDirty(const UnsignedInt node) const {
+    CORRADE_ASSERT(node < _parents.size(),
+        "SceneGraph::FlatScene::isNodeDirty(): index" << node << "out of range for" << _parents.size() << "nodes", {});
+    if(!_anyDirty) return false;
+    for(Int p = _positions[node]; p != -1; p = _parentPositions[p])
+        if(isDirtyAt(p)) return true;
+    return false;
+}
+
+template<UnsignedInt dimensions, class T> auto FlatScene<dimensions, T>::nodeAbsoluteTransformation(const UnsignedInt node) const -> MatrixType {
+    CORRADE_ASSERT(node < _parents.size(),
+        "SceneGraph::FlatScene::nodeAbsoluteTransformation(): index" << node << "out of range for" << _parents.size() << "nodes", {});
+    const UnsignedInt position = _positions[node];
+    if(!isNodeDirty(node)) return _absoluteTransformations[position];
+
+    MatrixType transformation = _transformations[position];
+    for(Int p = _parentPositions[position]; p != -1; p = _parentPositions[p])
+        transformation = _transformations[p]*transformation;
+    return transformation;
+}
+
+template<UnsignedInt dimensions, class T> void FlatScene<dimensions, T>::reorder() {
+    const std::size_t nodeCount = _parents.size();
+
+    /* Calculate depth and top-level parent of every node. Parents can be
+       after their children, so walk up until a node with known depth is
+       found and then assign the depths going back down. */
+    constexpr UnsignedInt Unknown = ~UnsignedInt{};
+    Containers::Array<UnsignedInt> depths{Containers::DirectInit, nodeCount, Unknown};
+    Containers::Array<UnsignedInt> roots{Containers::NoInit, nodeCount};
+    std::vector<UnsignedInt> chain;
+    for(UnsignedInt node = 0; node != nodeCount; ++node) {
+        Int p = node;
+        while(p != -1 && depths[p] == Unknown) {
+            chain.push_back(p);
+            p = _parents[p];
+        }
+        UnsignedInt depth = p == -1 ? 0 : depths[p] + 1;
+        const UnsignedInt root = p == -1 ? chain.back() : roots[p];
+        for(auto it = chain.rbegin(); it != chain.rend(); ++it, ++depth) {
+            depths[*it] = depth;
+            roots[*it] = root;
+        }
+        chain.clear();
+    }
+
+    /* Sort by top-level subtree, then by depth, then by ID for a
+       deterministic order */
+    Containers::Array<UnsignedInt> nodes{Containers::NoInit, nodeCount};
+    std::iota(nodes.begin(), nodes.end(), 0);
+    std::sort(nodes.begin(), nodes.end(), [&roots, &depths](UnsignedInt a, UnsignedInt b) {
+        if(roots[a] != roots[b]) return roots[a] < roots[b];
+        if(depths[a] != depths[b]) return depths[a] < depths[b];
+        return a < b;
+    });
+
+    /* Permute the position-indexed data */
+    Containers::Array<UnsignedInt> positions{Containers::NoInit, nodeCount};
+    for(std::size_t i = 0; i != nodeCount; ++i)
+        positions[nodes[i]] = i;
+    Containers::Array<Int> parentPositions{Containers::NoInit, nodeCount};
+    Containers::Array<MatrixType> transformations{Containers::NoInit, nodeCount};
+    Containers::Array<MatrixType> absoluteTransformations{Containers::NoInit, nodeCount};
+    Containers::Array<UnsignedInt> updates{Containers::NoInit, nodeCount};
+    Containers::Array<UnsignedByte> dirty{Containers::ValueInit, _dirty.size()};
+    Containers::Array<UnsignedInt> subtreeOffsets;
+    for(std::size_t i = 0; i != nodeCount; ++i) {
+        const UnsignedInt node = nodes[i];
+        const UnsignedInt previous = _positions[node];
+        const Int parent = _parents[node];
+        parentPositions[i] = parent == -1 ? -1 : Int(positions[parent]);
+        new(&transformations[i]) MatrixType{_transformations[previous]};
+        new(&absoluteTransformations[i]) MatrixType{_absoluteTransformations[previous]};
+        updates[i] = _updates[previous];
+        if(isDirtyAt(previous)) dirty[i >> 3] |= 1 << (i & 7);
+        if(parent == -1) arrayAppend(subtreeOffsets, UnsignedInt(i));
+    }
+    arrayAppend(subtreeOffsets, UnsignedInt(nodeCount));
+
+    /* Copy the data back instead of replacing the arrays, so addNode() can
+       continue appending to them */
+    std::copy(nodes.begin(), nodes.end(), _nodes.begin());
+    std::copy(positions.begin(), positions.end(), _positions.begin());
+    std::copy(parentPositions.begin(), parentPositions.end(), _parentPositions.begin());
+    std::copy(transformations.begin(), transformations.end(), _transformations.begin());
+    std::copy(absoluteTransformations.begin(), absoluteTransformations.end(), _absoluteTransformations.begin());
+    std::copy(updates.begin(), updates.end(), _updates.begin());
+    std::copy(dirty.begin(), dirty.end(), _dirty.begin());
+    _subtreeOffsets = std::move(subtreeOffsets);
+    _reorder = false;
+}
+
+template<UnsignedInt dimensions, class T> void FlatScene<dimensions, T>::updateSubtrees(const std::size_t begin, const std::size_t end) {
+    /* Parents are always before their children and they're in the same
+       top-level subtree, so their absolute transformation is already
+       calculated */
+    for(std::size_t i = _subtreeOffsets[begin], iMax = _subtreeOffsets[end]; i != iMax; ++i) {
+        if(!isDirtyAt(i)) continue;
+        const Int parent = _parentPositions[i];
+        _absoluteTransformations[i] = parent == -1 ? _transformations[i] :
+            _absoluteTransformations[parent]*_transformations[i];
+        _updates[i] = _updateCount;
+    }
+}
+
+template<UnsignedInt dimensions, class T> void FlatScene<dimensions, T>::update() {
+    if(_reorder) reorder();
+    if(!_anyDirty) return;
+
+    ++_updateCount;
+
+    /* Propagate the dirty bits to children first, so the (possibly parallel)
+       update doesn't need to write them */
+    const std::size_t nodeCount = _parents.size();
+    for(std::size_t i = 0; i != nodeCount; ++i) {
+        const Int parent = _parentPositions[i];
+        if(parent != -1 && isDirtyAt(parent)) setDirtyAt(i);
+    }
+
+    /* Distribute the top-level subtrees among the workers so each gets
+       roughly the same count of nodes. A subtree is never split. */
+    const std::size_t subtreeCount = _subtreeOffsets.size() - 1;
+    const std::size_t workerCount = Implementation::flatSceneWorkerCount(_threadCount, subtreeCount, nodeCount);
+    if(workerCount == 1) updateSubtrees(0, subtreeCount);
+    else {
+        struct State {
+            FlatScene<dimensions, T>& scene;
+            std::size_t workerCount;
+        } state{*this, workerCount};
+        Implementation::flatSceneParallelFor(workerCount, [](void* data, const std::size_t worker) {
+            const State& state = *static_cast<const State*>(data);
+            const Containers::ArrayView<const UnsignedInt> offsets = state.scene._subtreeOffsets;
+            const std::size_t nodeCount = offsets.back();
+            const std::size_t begin = std::lower_bound(offsets.begin(), offsets.end(), nodeCount*worker/state.workerCount) - offsets.begin();
+            const std::size_t end = std::lower_bound(offsets.begin(), offsets.end(), nodeCount*(worker + 1)/state.workerCount) - offsets.begin();
+            state.scene.updateSubtrees(begin, end);
+        }, &state);
+    }
+
+    std::memset(_dirty.data(), 0, _dirty.size());
+    _anyDirty = false;
+}
+
+template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>* FlatScene<dimensions, T>::doScene() { return this; }
+template<UnsignedInt dimensions, class T> const AbstractObject<dimensions, T>* FlatScene<dimensions, T>::doScene() const { return this; }
+template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>* FlatScene<dimensions, T>::doParent() { return nullptr; }
+template<UnsignedInt dimensions, class T> const AbstractObject<dimensions, T>* FlatScene<dimensions, T>::doParent() const { return nullptr; }
+template<UnsignedInt dimensions, class T> auto FlatScene<dimensions, T>::doTransformationMatrix() const -> MatrixType { return {}; }
+template<UnsignedInt dimensions, class T> auto FlatScene<dimensions, T>::doAbsoluteTransformationMatrix() const -> MatrixType { return {}; }
+
+template<UnsignedInt dimensions, class T> auto FlatScene<dimensions, T>::doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& finalTransformationMatrix) const -> std::vector<MatrixType> {
+    /* The absolute transformations are a cache, updating them doesn't change
+       the observable state */
+    const_cast<FlatScene<dimensions, T>&>(*this).update();
+
+    std::vector<MatrixType> transformations;
+    transformations.reserve(objects.size());
+    for(AbstractObject<dimensions, T>& object: objects) {
+        if(&object == this) {
+            transformations.push_back(finalTransformationMatrix);
+            continue;
+        }
+
+        CORRADE_ASSERT(object.scene() == this,
+            "SceneGraph::FlatScene::transformationMatrices(): the objects are not part of this scene", {});
+        transformations.push_back(finalTransformationMatrix*_absoluteTransformations[_positions[static_cast<const FlatObject<dimensions, T>&>(object)._node]]);
+    }
+
+    return transformations;
+}
+
+template<UnsignedInt dimensions, class T> bool FlatScene<dimensions, T>::doIsDirty() const { return false; }
+template<UnsignedInt dimensions, class T> void FlatScene<dimensions, T>::doSetDirty() {}
+template<UnsignedInt dimensions, class T> void FlatScene<dimensions, T>::doSetClean() {}
+
+template<UnsignedInt dimensions, class T> void FlatScene<dimensions, T>::doSetClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects) {
+    update();
+
+    for(AbstractObject<dimensions, T>& object: objects) {
+        if(&object == this) continue;
+
+        CORRADE_ASSERT(object.scene() == this,
+            "SceneGraph::FlatScene::setClean(): the objects are not part of this scene", );
+        FlatObject<dimensions, T>& flatObject = static_cast<FlatObject<dimensions, T>&>(object);
+        if(flatObject.isDirty()) flatObject.setCleanInternal();
+    }
+}
+
+template<UnsignedInt dimensions, class T> FlatObject<dimensions, T>::FlatObject(FlatScene<dimensions, T>& scene, const UnsignedInt node): _scene(scene), _node{node} {
+    CORRADE_ASSERT(node < scene.nodeCount(),
+        "SceneGraph::FlatObject: index" << node << "out of range for" << scene.nodeCount() << "nodes", );
+}
+
+template<UnsignedInt dimensions, class T> FlatObject<dimensions, T>::~FlatObject() = default;
+
+template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>* FlatObject<dimensions, T>::doScene() { return &_scene; }
+template<UnsignedInt dimensions, class T> const AbstractObject<dimensions, T>* FlatObject<dimensions, T>::doScene() const { return &_scene; }
+template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>* FlatObject<dimensions, T>::doParent() { return nullptr; }
+template<UnsignedInt dimensions, class T> const AbstractObject<dimensions, T>* FlatObject<dimensions, T>::doParent() const { return nullptr; }
+
+template<UnsignedInt dimensions, class T> auto FlatObject<dimensions, T>::doTransformationMatrix() const -> MatrixType {
+    return _scene.nodeTransformation(_node);
+}
+
+template<UnsignedInt dimensions, class T> auto FlatObject<dimensions, T>::doAbsoluteTransformationMatrix() const -> MatrixType {
+    return _scene.nodeAbsoluteTransformation(_node);
+}
+
+template<UnsignedInt dimensions, class T> auto FlatObject<dimensions, T>::doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& finalTransformationMatrix) const -> std::vector<MatrixType> {
+    return _scene.transformationMatrices(objects, finalTransformationMatrix);
+}
+
+template<UnsignedInt dimensions, class T> bool FlatObject<dimensions, T>::doIsDirty() const {
+    return _forceDirty || _scene.isNodeDirty(_node) || _scene._updates[_scene._positions[_node]] != _cleanUpdate;
+}
+
+template<UnsignedInt dimensions, class T> void FlatObject<dimensions, T>::doSetDirty() {
+    if(_forceDirty) return;
+
+    for(AbstractFeature<dimensions, T>& feature: this->features())
+        feature.markDirty();
+
+    _forceDirty = true;
+}
+
+template<UnsignedInt dimensions, class T> void FlatObject<dimensions, T>::doSetClean() {
+    if(!doIsDirty()) return;
+
+    _scene.update();
+    setCleanInternal();
+}
+
+template<UnsignedInt dimensions, class T> void FlatObject<dimensions, T>::doSetClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects) {
+    /* All objects are expected to be from the same scene */
+    _scene.doSetClean(objects);
+}
+
+template<UnsignedInt dimensions, class T> void FlatObject<dimensions, T>::setCleanInternal() {
+    const UnsignedInt position = _scene._positions[_node];
+    const MatrixType& matrix = _scene._absoluteTransformations[position];
+
+    /* "Lazy storage" for inverted transformation matrix */
+    bool invertedCalculated = false;
+    MatrixType invertedMatrix;
+
+    /* Clean all features */
+    for(AbstractFeature<dimensions, T>& feature: this->features()) {
+        if(feature.cachedTransformations() & CachedTransformation::Absolute)
+            feature.clean(matrix);
+
+        if(feature.cachedTransformations() & CachedTransformation::InvertedAbsolute) {
+            if(!invertedCalculated) {
+                invertedCalculated = true;
+                invertedMatrix = matrix.inverted();
+            }
+
+            feature.cleanInverted(invertedMatrix);
+        }
+    }
+
+    _cleanUpdate = _scene._updates[position];
+    _forceDirty = false;
+}
+
+}}
+
+#endif
@@ -0,0 +1,504 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/AbstractFeature.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/FlatScene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct FlatSceneTest: TestSuite::Tester {
+    explicit FlatSceneTest();
+
+    void construct();
+    void addNode();
+    void addNodeInvalidParent();
+    void setNodeParent();
+    void setNodeParentInvalid();
+    void setNodeTransformation();
+    void nodeOutOfRange();
+
+    void update();
+    void updatePartial();
+    void updateNoChange();
+    void updateMultithreaded();
+    void absoluteTransformationDirty();
+
+    void object();
+    void objectInvalidNode();
+    void objectClean();
+    void objectCleanMultiple();
+    void cameraDraw();
+};
+
+FlatSceneTest::FlatSceneTest() {
+    addTests({&FlatSceneTest::construct,
+              &FlatSceneTest::addNode,
+              &FlatSceneTest::addNodeInvalidParent,
+              &FlatSceneTest::setNodeParent,
+              &FlatSceneTest::setNodeParentInvalid,
+              &FlatSceneTest::setNodeTransformation,
+              &FlatSceneTest::nodeOutOfRange,
+
+              &FlatSceneTest::update,
+              &FlatSceneTest::updatePartial,
+              &FlatSceneTest::updateNoChange,
+              &FlatSceneTest::updateMultithreaded,
+              &FlatSceneTest::absoluteTransformationDirty,
+
+              &FlatSceneTest::object,
+              &FlatSceneTest::objectInvalidNode,
+              &FlatSceneTest::objectClean,
+              &FlatSceneTest::objectCleanMultiple,
+              &FlatSceneTest::cameraDraw});
+}
+
+void FlatSceneTest::construct() {
+    FlatScene3D scene;
+    CORRADE_COMPARE(scene.nodeCount(), 0);
+    CORRADE_COMPARE(scene.threadCount(), 1);
+    CORRADE_VERIFY(scene.scene() == &scene);
+    CORRADE_VERIFY(!scene.parent());
+    CORRADE_VERIFY(!scene.isDirty());
+
+    /* Updating an empty scene should do nothing */
+    scene.update();
+    CORRADE_COMPARE(scene.nodeCount(), 0);
+}
+
+void FlatSceneTest::addNode() {
+    FlatScene3D scene;
+    CORRADE_COMPARE(scene.addNode(), 0);
+    CORRADE_COMPARE(scene.addNode(0, Matrix4::translation(Vector3::xAxis(2.0f))), 1);
+    CORRADE_COMPARE(scene.addNode(-1, Matrix4::scaling(Vector3{3.0f})), 2);
+    CORRADE_COMPARE(scene.nodeCount(), 3);
+
+    CORRADE_COMPARE(scene.nodeParent(0), -1);
+    CORRADE_COMPARE(scene.nodeParent(1), 0);
+    CORRADE_COMPARE(scene.nodeParent(2), -1);
+    CORRADE_COMPARE(scene.nodeTransformation(0), Matrix4{});
+    CORRADE_COMPARE(scene.nodeTransformation(1), Matrix4::translation(Vector3::xAxis(2.0f)));
+    CORRADE_COMPARE(scene.nodeTransformation(2), Matrix4::scaling(Vector3{3.0f}));
+    CORRADE_VERIFY(scene.isNodeDirty(0));
+    CORRADE_VERIFY(scene.isNodeDirty(1));
+    CORRADE_VERIFY(scene.isNodeDirty(2));
+}
+
+void FlatSceneTest::addNodeInvalidParent() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FlatScene3D scene;
+    scene.addNode();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    scene.addNode(1);
+    scene.addNode(-2);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::FlatScene::addNode(): parent 1 out of range for 1 nodes\n"
+        "SceneGraph::FlatScene::addNode(): parent -2 out of range for 1 nodes\n");
+}
+
+void FlatSceneTest::setNodeParent() {
+    FlatScene3D scene;
+    scene.addNode();
+    scene.addNode();
+    scene.addNode();
+    scene.update();
+    CORRADE_VERIFY(!scene.isNodeDirty(0));
+
+    scene.setNodeParent(0, 2)
+        .setNodeParent(2, 1);
+    CORRADE_COMPARE(scene.nodeParent(0), 2);
+    CORRADE_COMPARE(scene.nodeParent(1), -1);
+    CORRADE_COMPARE(scene.nodeParent(2), 1);
+    CORRADE_VERIFY(scene.isNodeDirty(0));
+    CORRADE_VERIFY(!scene.isNodeDirty(1));
+    CORRADE_VERIFY(scene.isNodeDirty(2));
+
+    /* Back to the top level */
+    scene.setNodeParent(2, -1);
+    CORRADE_COMPARE(scene.nodeParent(2), -1);
+}
+
+void FlatSceneTest::setNodeParentInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FlatScene3D scene;
+    scene.addNode();
+    scene.addNode(0);
+    scene.addNode(1);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    scene.setNodeParent(3, -1);
+    scene.setNodeParent(0, 3);
+    scene.setNodeParent(1, 1);
+    scene.setNodeParent(0, 2);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::FlatScene::setNodeParent(): index 3 out of range for 3 nodes\n"
+        "SceneGraph::FlatScene::setNodeParent(): parent 3 out of range for 3 nodes\n"
+        "SceneGraph::FlatScene::setNodeParent(): can't parent node 1 to itself or its child 1\n"
+        "SceneGraph::FlatScene::setNodeParent(): can't parent node 0 to itself or its child 2\n");
+}
+
+void FlatSceneTest::setNodeTransformation() {
+    FlatScene2D scene;
+    scene.addNode();
+    scene.addNode();
+    scene.update();
+
+    scene.setNodeTransformation(1, Matrix3::translation(Vector2::yAxis(3.0f)));
+    CORRADE_COMPARE(scene.nodeTransformation(1), Matrix3::translation(Vector2::yAxis(3.0f)));
+    CORRADE_VERIFY(!scene.isNodeDirty(0));
+    CORRADE_VERIFY(scene.isNodeDirty(1));
+}
+
+void FlatSceneTest::nodeOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FlatScene3D scene;
+    scene.addNode();
+    scene.addNode();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    scene.nodeParent(2);
+    scene.nodeTransformation(2);
+    scene.setNodeTransformation(2, {});
+    scene.nodeAbsoluteTransformation(2);
+    scene.isNodeDirty(2);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::FlatScene::nodeParent(): index 2 out of range for 2 nodes\n"
+        "SceneGraph::FlatScene::nodeTransformation(): index 2 out of range for 2 nodes\n"
+        "SceneGraph::FlatScene::setNodeTransformation(): index 2 out of range for 2 nodes\n"
+        "SceneGraph::FlatScene::nodeAbsoluteTransformation(): index 2 out of range for 2 nodes\n"
+        "SceneGraph::FlatScene::isNodeDirty(): index 2 out of range for 2 nodes\n");
+}
+
+void FlatSceneTest::update() {
+    FlatScene3D scene;
+
+    /* Node 0 gets parented to node 3 later, so the storage has to be
+       reordered to have parents before children */
+    scene.addNode(-1, Matrix4::translation(Vector3::xAxis(1.0f)));
+    scene.addNode(-1, Matrix4::scaling(Vector3{2.0f}));
+    scene.addNode(1, Matrix4::translation(Vector3::yAxis(3.0f)));
+    scene.addNode(2, Matrix4::rotationZ(90.0_degf));
+    scene.setNodeParent(0, 3);
+
+    scene.update();
+    for(UnsignedInt i = 0; i != scene.nodeCount(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(!scene.isNodeDirty(i));
+    }
+
+    CORRADE_COMPARE(scene.nodeAbsoluteTransformation(1),
+        Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_COMPARE(scene.nodeAbsoluteTransformation(2),
+        Matrix4::scaling(Vector3{2.0f})*
+        Matrix4::translation(Vector3::yAxis(3.0f)));
+    CORRADE_COMPARE(scene.nodeAbsoluteTransformation(3),
+        Matrix4::scaling(Vector3{2.0f})*
+        Matrix4::translation(Vector3::yAxis(3.0f))*
+        Matrix4::rotationZ(90.0_degf));
+    CORRADE_COMPARE(scene.nodeAbsoluteTransformation(0),
+        Matrix4::scaling(Vector3{2.0f})*
+        Matrix4::translation(Vector3::yAxis(3.0f))*
+        Matrix4::rotationZ(90.0_degf)*
+        Matrix4::translation(Vector3::xAxis(1.0f)));
+
+    /* The node IDs and their properties stay the same after reordering */
+    CORRADE_COMPARE(scene.nodeParent(0), 3);
+    CORRADE_COMPARE(scene.nodeTransformation(0), Matrix4::translation(Vector3::xAxis(1.0f)));
+    CORRADE_COMPARE(scene.nodeTransformation(3), Matrix4::rotationZ(90.0_degf));
+}
+
+void FlatSceneTest::updatePartial() {
+    FlatScene3D scene;
+    scene.addNode(-1, Matrix4::translation(Vector3::xAxis(1.0f)));
+    scene.addNode(0, Matrix4::translation(Vector3::yAxis(2.0f)));
+    scene.addNode(1, Matrix4::translation(Vector3::zAxis(3.0f)));
+    scene.addNode(-1, Matrix4::translation(Vector3::xAxis(4.0f)));
+    scene.update();
+
+    /* Changing a node marks its children as dirty as well, but nothing
+       else */
+    scene.setNodeTransformation(1, Matrix4::translation(Vector3::yAxis(-2.0f)));
+    CORRADE_VERIFY(!scene.isNodeDirty(0));
+    CORRADE_VERIFY(scene.isNodeDirty(1));
+    CORRADE_VERIFY(scene.isNodeDirty(2));
+    CORRADE_VERIFY(!scene.isNodeDirty(3));
+
+    scene.update();
+    CORRADE_VERIFY(!scene.isNodeDirty(2));
+    CORRADE_COMPARE(scene.nodeAbsoluteTransformation(0), Matrix4::translation({1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(scene.nodeAbsoluteTransformation(1), Matrix4::translation({1.0f, -2.0f, 0.0f}));
+    CORRADE_COMPARE(scene.nodeAbsoluteTransformation(2), Matrix4::translation({1.0f, -2.0f, 3.0f}));
+    CORRADE_COMPARE(scene.nodeAbsoluteTransformation(3), Matrix4::translation({4.0f, 0.0f, 0.0f}));
+}
+
+void FlatSceneTest::updateNoChange() {
+    FlatScene3D scene;
+    scene.addNode(-1, Matrix4::translation(Vector3::xAxis(1.0f)));
+    scene.update();
+
+    FlatObject3D object{scene, 0};
+    object.setClean();
+    CORRADE_VERIFY(!object.isDirty());
+
+    /* An update without any change shouldn't cause objects to be dirty */
+    scene.update();
+    CORRADE_VERIFY(!object.isDirty());
+}
+
+void FlatSceneTest::updateMultithreaded() {
+    /* Enough nodes and subtrees for the work to be split among more threads.
+       Each subtree is a chain of nodes. */
+    FlatScene3D single;
+    FlatScene3D multi;
+    multi.setThreadCount(4);
+    CORRADE_COMPARE(multi.threadCount(), 4);
+    for(FlatScene3D* scene: {&single, &multi}) {
+        for(UnsignedInt i = 0; i != 128; ++i) {
+            Int parent = -1;
+            for(UnsignedInt j = 0; j != 512; ++j)
+                parent = scene->addNode(parent, Matrix4::translation({j % 3 ? 0.5f : -0.25f, Float(i), 0.0f}));
+        }
+    }
+
+    single.update();
+    multi.update();
+    for(UnsignedInt i = 0; i != single.nodeCount(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(!multi.isNodeDirty(i));
+        CORRADE_COMPARE(multi.nodeAbsoluteTransformation(i), single.nodeAbsoluteTransformation(i));
+    }
+
+    /* Changing a single subtree */
+    single.setNodeTransformation(512*5, Matrix4::scaling(Vector3{2.0f}));
+    multi.setNodeTransformation(512*5, Matrix4::scaling(Vector3{2.0f}));
+    single.update();
+    multi.update();
+    for(UnsignedInt i = 512*5; i != 512*6; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(multi.nodeAbsoluteTransformation(i), single.nodeAbsoluteTransformation(i));
+    }
+}
+
+void FlatSceneTest::absoluteTransformationDirty() {
+    FlatScene3D scene;
+    scene.addNode(-1, Matrix4::translation(Vector3::xAxis(1.0f)));
+    scene.addNode(0, Matrix4::scaling(Vector3{2.0f}));
+    scene.update();
+
+    /* The result should be correct also without calling update() */
+    scene.setNodeTransformation(0, Matrix4::translation(Vector3::xAxis(-1.0f)));
+    CORRADE_VERIFY(scene.isNodeDirty(1));
+    CORRADE_COMPARE(scene.nodeAbsoluteTransformation(1),
+        Matrix4::translation(Vector3::xAxis(-1.0f))*Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_VERIFY(scene.isNodeDirty(1));
+}
+
+void FlatSceneTest::object() {
+    FlatScene3D scene;
+    scene.addNode(-1, Matrix4::translation(Vector3::xAxis(1.0f)));
+    scene.addNode(0, Matrix4::scaling(Vector3{2.0f}));
+
+    FlatObject3D object{scene, 1};
+    CORRADE_VERIFY(&object.flatScene() == &scene);
+    CORRADE_COMPARE(object.node(), 1);
+    CORRADE_VERIFY(object.scene() == &scene);
+    CORRADE_VERIFY(!object.parent());
+    CORRADE_COMPARE(object.transformationMatrix(), Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_COMPARE(object.absoluteTransformationMatrix(),
+        Matrix4::translation(Vector3::xAxis(1.0f))*Matrix4::scaling(Vector3{2.0f}));
+
+    CORRADE_COMPARE_AS(scene.transformationMatrices({object, scene}, Matrix4::translation(Vector3::zAxis(-3.0f))), (std::vector<Matrix4>{
+        Matrix4::translation({1.0f, 0.0f, -3.0f})*Matrix4::scaling(Vector3{2.0f}),
+        Matrix4::translation(Vector3::zAxis(-3.0f))
+    }), TestSuite::Compare::Container);
+}
+
+void FlatSceneTest::objectInvalidNode() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FlatScene3D scene;
+    scene.addNode();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    FlatObject3D{scene, 1};
+    CORRADE_COMPARE(out.str(), "SceneGraph::FlatObject: index 1 out of range for 1 nodes\n");
+}
+
+class CachingFeature: public AbstractFeature3D {
+    public:
+        explicit CachingFeature(AbstractObject3D& object): AbstractFeature3D{object} {
+            setCachedTransformations(CachedTransformation::Absolute|CachedTransformation::InvertedAbsolute);
+        }
+
+        Int dirtyCount{}, cleanCount{}, cleanInvertedCount{};
+        Matrix4 absolute, invertedAbsolute;
+
+    private:
+        void markDirty() override { ++dirtyCount; }
+        void clean(const Matrix4& absoluteTransformationMatrix) override {
+            ++cleanCount;
+            absolute = absoluteTransformationMatrix;
+        }
+        void cleanInverted(const Matrix4& invertedAbsoluteTransformationMatrix) override {
+            ++cleanInvertedCount;
+            invertedAbsolute = invertedAbsoluteTransformationMatrix;
+        }
+};
+
+void FlatSceneTest::objectClean() {
+    FlatScene3D scene;
+    scene.addNode(-1, Matrix4::translation(Vector3::xAxis(1.0f)));
+    scene.addNode(0, Matrix4::scaling(Vector3{2.0f}));
+
+    FlatObject3D object{scene, 1};
+    CachingFeature feature{object};
+    CORRADE_VERIFY(object.isDirty());
+
+    object.setClean();
+    CORRADE_VERIFY(!object.isDirty());
+    CORRADE_VERIFY(!scene.isNodeDirty(1));
+    CORRADE_COMPARE(feature.cleanCount, 1);
+    CORRADE_COMPARE(feature.cleanInvertedCount, 1);
+    CORRADE_COMPARE(feature.absolute, Matrix4::translation(Vector3::xAxis(1.0f))*Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_COMPARE(feature.invertedAbsolute, feature.absolute.inverted());
+
+    /* Cleaning again does nothing */
+    object.setClean();
+    CORRADE_COMPARE(feature.cleanCount, 1);
+
+    /* Changing the parent node makes the object dirty. Updating the scene
+       keeps it dirty until it's cleaned. */
+    scene.setNodeTransformation(0, Matrix4::translation(Vector3::xAxis(-1.0f)));
+    CORRADE_VERIFY(object.isDirty());
+    scene.update();
+    CORRADE_VERIFY(object.isDirty());
+    object.setClean();
+    CORRADE_VERIFY(!object.isDirty());
+    CORRADE_COMPARE(feature.cleanCount, 2);
+    CORRADE_COMPARE(feature.absolute, Matrix4::translation(Vector3::xAxis(-1.0f))*Matrix4::scaling(Vector3{2.0f}));
+
+    /* Explicit setDirty() notifies the features */
+    object.setDirty();
+    object.setDirty();
+    CORRADE_VERIFY(object.isDirty());
+    CORRADE_COMPARE(feature.dirtyCount, 1);
+    object.setClean();
+    CORRADE_VERIFY(!object.isDirty());
+    CORRADE_COMPARE(feature.cleanCount, 3);
+}
+
+void FlatSceneTest::objectCleanMultiple() {
+    FlatScene3D scene;
+    scene.addNode(-1, Matrix4::translation(Vector3::xAxis(1.0f)));
+    scene.addNode(0, Matrix4::scaling(Vector3{2.0f}));
+    scene.addNode(-1, Matrix4::translation(Vector3::yAxis(1.0f)));
+
+    FlatObject3D a{scene, 1};
+    FlatObject3D b{scene, 2};
+    CachingFeature featureA{a};
+    CachingFeature featureB{b};
+
+    AbstractObject3D::setClean({a, b});
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_COMPARE(featureA.absolute, Matrix4::translation(Vector3::xAxis(1.0f))*Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_COMPARE(featureB.absolute, Matrix4::translation(Vector3::yAxis(1.0f)));
+
+    /* Only the changed object gets cleaned again */
+    scene.setNodeTransformation(2, Matrix4::translation(Vector3::yAxis(-1.0f)));
+    AbstractObject3D::setClean({a, b});
+    CORRADE_COMPARE(featureA.cleanCount, 1);
+    CORRADE_COMPARE(featureB.cleanCount, 2);
+    CORRADE_COMPARE(featureB.absolute, Matrix4::translation(Vector3::yAxis(-1.0f)));
+}
+
+void FlatSceneTest::cameraDraw() {
+    class Drawable: public Drawable3D {
+        public:
+            explicit Drawable(AbstractObject3D& object, DrawableGroup3D& group, Matrix4& result): Drawable3D{object, &group}, _result(result) {}
+
+        private:
+            void draw(const Matrix4& transformationMatrix, Camera3D&) override {
+                _result = transformationMatrix;
+            }
+
+            Matrix4& _result;
+    };
+
+    FlatScene3D scene;
+    scene.addNode(-1, Matrix4::scaling(Vector3{5.0f}));
+    scene.addNode(-1, Matrix4::translation(Vector3::yAxis(3.0f)));
+    scene.addNode(1, Matrix4::translation(Vector3::zAxis(-1.5f)));
+
+    DrawableGroup3D group;
+    FlatObject3D first{scene, 0};
+    FlatObject3D second{scene, 1};
+    FlatObject3D third{scene, 2};
+    Matrix4 firstTransformation, secondTransformation, thirdTransformation;
+    new Drawable{first, group, firstTransformation};
+    new Drawable{second, group, secondTransformation};
+    new Drawable{third, group, thirdTransformation};
+
+    Camera3D camera{third};
+    camera.draw(group);
+    CORRADE_COMPARE(firstTransformation, Matrix4::translation({0.0f, -3.0f, 1.5f})*Matrix4::scaling(Vector3{5.0f}));
+    CORRADE_COMPARE(secondTransformation, Matrix4::translation(Vector3::zAxis(1.5f)));
+    CORRADE_COMPARE(thirdTransformation, Matrix4{});
+
+    /* Moving the camera node gets reflected on next draw */
+    scene.setNodeTransformation(2, Matrix4::translation(Vector3::zAxis(1.5f)));
+    camera.draw(group);
+    CORRADE_COMPARE(secondTransformation, Matrix4::translation(Vector3::zAxis(-1.5f)));
+    CORRADE_COMPARE(thirdTransformation, Matrix4{});
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FlatSceneTest)
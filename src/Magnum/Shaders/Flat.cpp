@@ -27,11 +27,15 @@
 
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Resource.h>
 
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Shader.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/Buffer.h"
+#endif
 #include "Magnum/GL/Texture.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
@@ -43,12 +47,62 @@ namespace Magnum { namespace Shaders {
 
 namespace {
     enum: Int { TextureUnit = 0 };
+
+    #ifndef MAGNUM_TARGET_GLES2
+    enum: Int {
+        /* Not using the zero binding to avoid conflicts with
+           ProjectionBufferBinding from other shaders which can likely stay
+           bound to the same buffer for the whole time */
+        TransformationProjectionBufferBinding = 1,
+        DrawBufferBinding = 2,
+        TextureTransformationBufferBinding = 3,
+        MaterialBufferBinding = 4
+    };
+    #endif
 }
 
-template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _flags(flags) {
+/* Classic uniform setters can't be used with uniform buffers enabled and
+   vice versa. There are no uniform buffers on ES2, so there the check
+   compiles away. */
+#ifndef MAGNUM_TARGET_GLES2
+#define ASSERT_NO_UNIFORM_BUFFERS(function)                                 \
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),                       \
+        "Shaders::Flat::" function "(): the shader was created with uniform buffers enabled", *this)
+#define ASSERT_UNIFORM_BUFFERS(function)                                    \
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,                          \
+        "Shaders::Flat::" function "(): the shader was not created with uniform buffers enabled", *this)
+#else
+#define ASSERT_NO_UNIFORM_BUFFERS(function) do {} while(false)
+#endif
+
+template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags
+    #ifndef MAGNUM_TARGET_GLES2
+    , const UnsignedInt materialCount, const UnsignedInt drawCount
+    #endif
+):
+    _flags{flags}
+    #ifndef MAGNUM_TARGET_GLES2
+    , _materialCount{materialCount},
+    _drawCount{drawCount}
+    #endif
+{
     CORRADE_ASSERT(!(flags & Flag::TextureTransformation) || (flags & Flag::Textured),
         "Shaders::Flat: texture transformation enabled but the shader is not textured", );
 
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || materialCount,
+        "Shaders::Flat: material count can't be zero", );
+    CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || drawCount,
+        "Shaders::Flat: draw count can't be zero", );
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags >= Flag::UniformBuffers)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::uniform_buffer_object);
+    if(flags >= Flag::MultiDraw)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::shader_draw_parameters);
+    #endif
+
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -73,8 +127,19 @@ template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _fla
         .addSource(flags >= Flag::InstancedObjectId ? "#define INSTANCED_OBJECT_ID\n" : "")
         #endif
         .addSource(flags & Flag::InstancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "")
-        .addSource(flags >= Flag::InstancedTextureOffset ? "#define INSTANCED_TEXTURE_OFFSET\n" : "")
-        .addSource(rs.get("generic.glsl"))
+        .addSource(flags >= Flag::InstancedTextureOffset ? "#define INSTANCED_TEXTURE_OFFSET\n" : "");
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        vert.addSource(Utility::formatString(
+            "#define UNIFORM_BUFFERS\n"
+            "#define DRAW_COUNT {}\n",
+            drawCount));
+        #ifndef MAGNUM_TARGET_GLES
+        vert.addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "");
+        #endif
+    }
+    #endif
+    vert.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Flat.vert"));
     frag.addSource(flags & Flag::Textured ? "#define TEXTURED\n" : "")
         .addSource(flags & Flag::AlphaMask ? "#define ALPHA_MASK\n" : "")
@@ -83,7 +148,21 @@ template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _fla
         .addSource(flags & Flag::ObjectId ? "#define OBJECT_ID\n" : "")
         .addSource(flags >= Flag::InstancedObjectId ? "#define INSTANCED_OBJECT_ID\n" : "")
         #endif
-        .addSource(rs.get("generic.glsl"))
+        ;
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        frag.addSource(Utility::formatString(
+            "#define UNIFORM_BUFFERS\n"
+            "#define DRAW_COUNT {}\n"
+            "#define MATERIAL_COUNT {}\n",
+            drawCount,
+            materialCount));
+        #ifndef MAGNUM_TARGET_GLES
+        frag.addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "");
+        #endif
+    }
+    #endif
+    frag.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Flat.frag"));
 
     CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
@@ -123,14 +202,21 @@ template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _fla
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
     #endif
     {
-        _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
-        if(flags & Flag::TextureTransformation)
-            _textureMatrixUniform = uniformLocation("textureMatrix");
-        _colorUniform = uniformLocation("color");
-        if(flags & Flag::AlphaMask) _alphaMaskUniform = uniformLocation("alphaMask");
         #ifndef MAGNUM_TARGET_GLES2
-        if(flags & Flag::ObjectId) _objectIdUniform = uniformLocation("objectId");
+        if(flags >= Flag::UniformBuffers) {
+            _drawOffsetUniform = uniformLocation("drawOffset");
+        } else
         #endif
+        {
+            _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+            if(flags & Flag::TextureTransformation)
+                _textureMatrixUniform = uniformLocation("textureMatrix");
+            _colorUniform = uniformLocation("color");
+            if(flags & Flag::AlphaMask) _alphaMaskUniform = uniformLocation("alphaMask");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags & Flag::ObjectId) _objectIdUniform = uniformLocation("objectId");
+            #endif
+        }
     }
 
     #ifndef MAGNUM_TARGET_GLES
@@ -140,23 +226,52 @@ template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _fla
         if(flags & Flag::Textured) setUniform(uniformLocation("textureData"), TextureUnit);
     }
 
-    /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
+    /* Uniform block bindings are set in the shader directly if 420pack is
+       available, ES3 doesn't support that */
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers
+        #ifndef MAGNUM_TARGET_GLES
+        && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>(version)
+        #endif
+    ) {
+        setUniformBlockBinding(uniformBlockIndex("TransformationProjection"), TransformationProjectionBufferBinding);
+        setUniformBlockBinding(uniformBlockIndex("Draw"), DrawBufferBinding);
+        if(flags & Flag::TextureTransformation)
+            setUniformBlockBinding(uniformBlockIndex("TextureTransformation"), TextureTransformationBufferBinding);
+        setUniformBlockBinding(uniformBlockIndex("Material"), MaterialBufferBinding);
+    }
+    #endif
+
+    /* Set defaults in OpenGL ES (for desktop they are set in shader code
+       itself). Uniform buffers have the defaults in the uniform structs and
+       the draw offset is zero by default. */
     #ifdef MAGNUM_TARGET_GLES
-    setTransformationProjectionMatrix(MatrixTypeFor<dimensions, Float>{Math::IdentityInit});
-    if(flags & Flag::TextureTransformation)
-        setTextureMatrix(Matrix3{Math::IdentityInit});
-    setColor(Magnum::Color4{1.0f});
-    if(flags & Flag::AlphaMask) setAlphaMask(0.5f);
-    /* Object ID is zero by default */
+    #ifndef MAGNUM_TARGET_GLES2
+    if(!(flags >= Flag::UniformBuffers))
+    #endif
+    {
+        setTransformationProjectionMatrix(MatrixTypeFor<dimensions, Float>{Math::IdentityInit});
+        if(flags & Flag::TextureTransformation)
+            setTextureMatrix(Matrix3{Math::IdentityInit});
+        setColor(Magnum::Color4{1.0f});
+        if(flags & Flag::AlphaMask) setAlphaMask(0.5f);
+        /* Object ID is zero by default */
+    }
     #endif
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): Flat{flags, 1, 1} {}
+#endif
+
 template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix) {
+    ASSERT_NO_UNIFORM_BUFFERS("setTransformationProjectionMatrix");
     setUniform(_transformationProjectionMatrixUniform, matrix);
     return *this;
 }
 
 template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setTextureMatrix(const Matrix3& matrix) {
+    ASSERT_NO_UNIFORM_BUFFERS("setTextureMatrix");
     CORRADE_ASSERT(_flags & Flag::TextureTransformation,
         "Shaders::Flat::setTextureMatrix(): the shader was not created with texture transformation enabled", *this);
     setUniform(_textureMatrixUniform, matrix);
@@ -164,6 +279,7 @@ template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setTextureM
 }
 
 template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setColor(const Magnum::Color4& color) {
+    ASSERT_NO_UNIFORM_BUFFERS("setColor");
     setUniform(_colorUniform, color);
     return *this;
 }
@@ -176,6 +292,7 @@ template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTexture
 }
 
 template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setAlphaMask(Float mask) {
+    ASSERT_NO_UNIFORM_BUFFERS("setAlphaMask");
     CORRADE_ASSERT(_flags & Flag::AlphaMask,
         "Shaders::Flat::setAlphaMask(): the shader was not created with alpha mask enabled", *this);
     setUniform(_alphaMaskUniform, mask);
@@ -184,16 +301,82 @@ template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setAlphaMas
 
 #ifndef MAGNUM_TARGET_GLES2
 template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setObjectId(UnsignedInt id) {
+    ASSERT_NO_UNIFORM_BUFFERS("setObjectId");
     CORRADE_ASSERT(_flags & Flag::ObjectId,
         "Shaders::Flat::setObjectId(): the shader was not created with object ID enabled", *this);
     setUniform(_objectIdUniform, id);
     return *this;
 }
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setDrawOffset(const UnsignedInt offset) {
+    ASSERT_UNIFORM_BUFFERS("setDrawOffset");
+    CORRADE_ASSERT(offset < _drawCount,
+        "Shaders::Flat::setDrawOffset(): draw offset" << offset << "is out of bounds for" << _drawCount << "draws", *this);
+    setUniform(_drawOffsetUniform, offset);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTransformationProjectionBuffer(GL::Buffer& buffer) {
+    ASSERT_UNIFORM_BUFFERS("bindTransformationProjectionBuffer");
+    buffer.bind(GL::Buffer::Target::Uniform, TransformationProjectionBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTransformationProjectionBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    ASSERT_UNIFORM_BUFFERS("bindTransformationProjectionBuffer");
+    buffer.bind(GL::Buffer::Target::Uniform, TransformationProjectionBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindDrawBuffer(GL::Buffer& buffer) {
+    ASSERT_UNIFORM_BUFFERS("bindDrawBuffer");
+    buffer.bind(GL::Buffer::Target::Uniform, DrawBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindDrawBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    ASSERT_UNIFORM_BUFFERS("bindDrawBuffer");
+    buffer.bind(GL::Buffer::Target::Uniform, DrawBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTextureTransformationBuffer(GL::Buffer& buffer) {
+    ASSERT_UNIFORM_BUFFERS("bindTextureTransformationBuffer");
+    CORRADE_ASSERT(_flags & Flag::TextureTransformation,
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureTransformationBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTextureTransformationBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    ASSERT_UNIFORM_BUFFERS("bindTextureTransformationBuffer");
+    CORRADE_ASSERT(_flags & Flag::TextureTransformation,
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureTransformationBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindMaterialBuffer(GL::Buffer& buffer) {
+    ASSERT_UNIFORM_BUFFERS("bindMaterialBuffer");
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindMaterialBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    ASSERT_UNIFORM_BUFFERS("bindMaterialBuffer");
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding, offset, size);
+    return *this;
+}
 #endif
 
 template class Flat<2>;
 template class Flat<3>;
 
+#undef ASSERT_NO_UNIFORM_BUFFERS
+#ifndef MAGNUM_TARGET_GLES2
+#undef ASSERT_UNIFORM_BUFFERS
+#endif
+
 namespace Implementation {
 
 Debug& operator<<(Debug& debug, const FlatFlag value) {
@@ -212,11 +395,17 @@ Debug& operator<<(Debug& debug, const FlatFlag value) {
         #endif
         _c(InstancedTransformation)
         _c(InstancedTextureOffset)
+        #ifndef MAGNUM_TARGET_GLES2
+        _c(UniformBuffers)
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        _c(MultiDraw)
+        #endif
         #undef _c
         /* LCOV_EXCL_STOP */
     }
 
-    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedShort(value)) << Debug::nospace << ")";
 }
 
 Debug& operator<<(Debug& debug, const FlatFlags value) {
@@ -230,7 +419,14 @@ Debug& operator<<(Debug& debug, const FlatFlags value) {
         FlatFlag::InstancedObjectId, /* Superset of ObjectId */
         FlatFlag::ObjectId,
         #endif
-        FlatFlag::InstancedTransformation});
+        FlatFlag::InstancedTransformation,
+        #ifndef MAGNUM_TARGET_GLES
+        FlatFlag::MultiDraw, /* Superset of UniformBuffers */
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        FlatFlag::UniformBuffers
+        #endif
+        });
 }
 
 }
@@ -27,6 +27,10 @@
 #extension GL_EXT_gpu_shader4: require
 #endif
 
+#if defined(UNIFORM_BUFFERS) && !defined(GL_ES) && __VERSION__ < 140
+#extension GL_ARB_uniform_buffer_object: require
+#endif
+
 #ifndef NEW_GLSL
 #define fragmentColor gl_FragColor
 #define texture texture2D
@@ -40,6 +44,7 @@ layout(binding = 0)
 uniform lowp sampler2D textureData;
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 2)
 #endif
@@ -68,6 +73,52 @@ layout(location = 4)
 uniform highp uint objectId; /* defaults to zero */
 #endif
 
+#else
+#ifndef MULTI_DRAW
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+/* mediump is just 2^10, which might not be enough, this is 2^16 */
+uniform highp uint drawOffset; /* defaults to zero */
+#define drawId drawOffset
+#else
+flat in highp uint drawId;
+#endif
+
+struct DrawUniform {
+    highp uint materialId;
+    highp uint objectId;
+    highp uint reserved1;
+    highp uint reserved2;
+};
+
+#ifdef EXPLICIT_BINDING
+layout(std140, binding = 2)
+#else
+layout(std140)
+#endif
+uniform Draw {
+    DrawUniform draws[DRAW_COUNT];
+};
+
+struct MaterialUniform {
+    lowp vec4 color;
+    lowp float alphaMask;
+    lowp float reserved1;
+    lowp float reserved2;
+    lowp float reserved3;
+};
+
+#ifdef EXPLICIT_BINDING
+layout(std140, binding = 4)
+#else
+layout(std140)
+#endif
+uniform Material {
+    MaterialUniform materials[MATERIAL_COUNT];
+};
+#endif
+
 #ifdef TEXTURED
 in mediump vec2 interpolatedTextureCoordinates;
 #endif
@@ -95,6 +146,17 @@ out highp uint fragmentObjectId;
 #endif
 
 void main() {
+    #ifdef UNIFORM_BUFFERS
+    #ifdef OBJECT_ID
+    highp uint objectId = draws[drawId].objectId;
+    #endif
+    mediump uint materialId = draws[drawId].materialId;
+    lowp vec4 color = materials[materialId].color;
+    #ifdef ALPHA_MASK
+    lowp float alphaMask = materials[materialId].alphaMask;
+    #endif
+    #endif
+
     fragmentColor =
         #ifdef TEXTURED
         texture(textureData, interpolatedTextureCoordinates)*
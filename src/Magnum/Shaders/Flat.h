@@ -26,18 +26,144 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Shaders::Flat, typedef @ref Magnum::Shaders::Flat2D, @ref Magnum::Shaders::Flat3D
+ * @brief Class @ref Magnum::Shaders::Flat, typedef @ref Magnum::Shaders::Flat2D, @ref Magnum::Shaders::Flat3D, struct @ref Magnum::Shaders::FlatDrawUniform, @ref Magnum::Shaders::FlatMaterialUniform
  */
 
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/Math/Color.h"
 #include "Magnum/Shaders/Generic.h"
 #include "Magnum/Shaders/visibility.h"
 
 namespace Magnum { namespace Shaders {
 
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Per-draw uniform for flat shaders
+@m_since_latest
+
+Together with the generic @ref TransformationProjectionUniform2D /
+@ref TransformationProjectionUniform3D contains parameters that are specific
+to each draw call. Bound to the uniform buffer binding 2, one item for each
+draw, see @ref Shaders-Flat-ubo for more information.
+@see @ref Flat::bindDrawBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct FlatDrawUniform {
+    /** @brief Construct with default parameters */
+    constexpr /*implicit*/ FlatDrawUniform() noexcept: materialId{0}, objectId{0} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit FlatDrawUniform(NoInitT) noexcept {}
+
+    /**
+     * @brief Set the @ref materialId field
+     * @return Reference to self (for method chaining)
+     */
+    FlatDrawUniform& setMaterialId(UnsignedInt id) {
+        materialId = id;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref objectId field
+     * @return Reference to self (for method chaining)
+     */
+    FlatDrawUniform& setObjectId(UnsignedInt id) {
+        objectId = id;
+        return *this;
+    }
+
+    /**
+     * @brief Material ID
+     *
+     * Index into the buffer bound with @ref Flat::bindMaterialBuffer().
+     * Expected to be less than @ref Flat::materialCount(). Default value is
+     * @cpp 0 @ce.
+     */
+    UnsignedInt materialId;
+
+    /**
+     * @brief Object ID
+     *
+     * Used only if @ref Flat::Flag::ObjectId is enabled, ignored otherwise.
+     * Default value is @cpp 0 @ce.
+     * @see @ref Flat::setObjectId()
+     */
+    UnsignedInt objectId;
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32; /* reserved */
+    Int:32; /* reserved */
+    #endif
+};
+
+/**
+@brief Material uniform for flat shaders
+@m_since_latest
+
+Bound to the uniform buffer binding 4, indexed by
+@ref FlatDrawUniform::materialId, see @ref Shaders-Flat-ubo for more
+information.
+@see @ref Flat::bindMaterialBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct FlatMaterialUniform {
+    /** @brief Construct with default parameters */
+    constexpr /*implicit*/ FlatMaterialUniform() noexcept: color{1.0f, 1.0f}, alphaMask{0.5f} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit FlatMaterialUniform(NoInitT) noexcept: color{NoInit} {}
+
+    /**
+     * @brief Set the @ref color field
+     * @return Reference to self (for method chaining)
+     */
+    FlatMaterialUniform& setColor(const Color4& color) {
+        this->color = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref alphaMask field
+     * @return Reference to self (for method chaining)
+     */
+    FlatMaterialUniform& setAlphaMask(Float mask) {
+        alphaMask = mask;
+        return *this;
+    }
+
+    /**
+     * @brief Color
+     *
+     * Default value is @cpp 0xffffffff_rgbaf @ce.
+     * @see @ref Flat::setColor()
+     */
+    Color4 color;
+
+    /**
+     * @brief Alpha mask value
+     *
+     * Default value is @cpp 0.5f @ce. Used only if
+     * @ref Flat::Flag::AlphaMask is enabled, ignored otherwise.
+     * @see @ref Flat::setAlphaMask()
+     */
+    Float alphaMask;
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32; /* reserved */
+    Int:32; /* reserved */
+    Int:32; /* reserved */
+    #endif
+};
+#endif
+
 namespace Implementation {
-    enum class FlatFlag: UnsignedByte {
+    enum class FlatFlag: UnsignedShort {
         Textured = 1 << 0,
         AlphaMask = 1 << 1,
         VertexColor = 1 << 2,
@@ -47,7 +173,13 @@ namespace Implementation {
         InstancedObjectId = (1 << 5)|ObjectId,
         #endif
         InstancedTransformation = 1 << 6,
-        InstancedTextureOffset = (1 << 7)|TextureTransformation
+        InstancedTextureOffset = (1 << 7)|TextureTransformation,
+        #ifndef MAGNUM_TARGET_GLES2
+        UniformBuffers = 1 << 8,
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        MultiDraw = UniformBuffers|(1 << 9)
+        #endif
     };
     typedef Containers::EnumSet<FlatFlag> FlatFlags;
 }
@@ -149,6 +281,34 @@ color to a mesh:
 @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays} in WebGL
     1.0.
 
+@section Shaders-Flat-ubo Uniform buffers and multi-draw
+
+If @ref Flag::UniformBuffers is enabled, the shader takes all inputs from
+uniform buffers instead of uniforms --- @ref TransformationProjectionUniform2D
+/ @ref TransformationProjectionUniform3D, @ref FlatDrawUniform,
+@ref FlatMaterialUniform and, if @ref Flag::TextureTransformation is enabled,
+@ref TextureTransformationUniform --- which are bound with
+@ref bindTransformationProjectionBuffer(), @ref bindDrawBuffer(),
+@ref bindMaterialBuffer() and @ref bindTextureTransformationBuffer(). The
+transformation, draw and texture transformation buffers contain one item for
+each draw and materials are referenced from @ref FlatDrawUniform::materialId.
+The draw to use is selected with @ref setDrawOffset(), with
+@ref Flag::MultiDraw the draw index is additionally offset by the index of the
+mesh in a @ref draw(Containers::ArrayView<const Containers::Reference<MeshView>>)
+call. The workflow is the same as with @ref Phong, see
+@ref Shaders-Phong-ubo for a detailed description and examples.
+
+@snippet MagnumShaders.cpp Flat-usage-ubo
+
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object} for
+    @ref Flag::UniformBuffers.
+@requires_gl46 Extension @gl_extension{ARB,shader_draw_parameters} for
+    @ref Flag::MultiDraw.
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+@requires_gl Multi-draw with a draw index in shaders is not available in
+    OpenGL ES or WebGL, use @ref setDrawOffset() there instead.
+
 @see @ref shaders, @ref Flat2D, @ref Flat3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::AbstractShaderProgram {
@@ -267,7 +427,7 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
          *
          * @see @ref Flags, @ref flags()
          */
-        enum class Flag: UnsignedByte {
+        enum class Flag: UnsignedShort {
             /**
              * Multiply color with a texture.
              * @see @ref setColor(), @ref bindTexture()
@@ -363,7 +523,43 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
              *      in WebGL 1.0.
              * @m_since{2020,06}
              */
-            InstancedTextureOffset = (1 << 7)|TextureTransformation
+            InstancedTextureOffset = (1 << 7)|TextureTransformation,
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * Use uniform buffers. Expects that uniform data are supplied via
+             * @ref bindTransformationProjectionBuffer(),
+             * @ref bindDrawBuffer(), @ref bindTextureTransformationBuffer()
+             * and @ref bindMaterialBuffer() instead of direct uniform setters.
+             * See @ref Shaders-Flat-ubo for more information.
+             * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Uniform buffers are not available in OpenGL ES
+             *      2.0.
+             * @requires_webgl20 Uniform buffers are not available in WebGL
+             *      1.0.
+             * @m_since_latest
+             */
+            UniformBuffers = 1 << 8,
+            #endif
+
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * Enable multidraw functionality. Implies
+             * @ref Flag::UniformBuffers and adds the value from
+             * @ref setDrawOffset() with the @glsl gl_DrawIDARB @ce builtin,
+             * which makes draws submitted via
+             * @ref GL::AbstractShaderProgram::draw(Containers::ArrayView<const Containers::Reference<MeshView>>)
+             * pick up per-draw parameters directly, without having to set
+             * the draw offset for each. See @ref Shaders-Flat-ubo for more
+             * information.
+             * @requires_gl46 Extension @gl_extension{ARB,uniform_buffer_object}
+             *      and @gl_extension{ARB,shader_draw_parameters}
+             * @requires_gl Multi-draw with a draw index in shaders is not
+             *      available in OpenGL ES or WebGL.
+             * @m_since_latest
+             */
+            MultiDraw = UniformBuffers|(1 << 9)
+            #endif
         };
 
         /**
@@ -382,9 +578,44 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
         /**
          * @brief Constructor
          * @param flags     Flags
+         *
+         * If @ref Flag::UniformBuffers is set, this is equivalent to calling
+         * @ref Flat(Flags, UnsignedInt, UnsignedInt) with @p materialCount
+         * and @p drawCount set to @cpp 1 @ce.
          */
         explicit Flat(Flags flags = {});
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Construct for a multi-draw scenario
+         * @param flags         Flags
+         * @param materialCount Size of a @ref FlatMaterialUniform buffer
+         *      bound with @ref bindMaterialBuffer()
+         * @param drawCount     Size of a @ref TransformationProjectionUniform2D
+         *      / @ref TransformationProjectionUniform3D /
+         *      @ref FlatDrawUniform / @ref TextureTransformationUniform
+         *      buffer bound with @ref bindTransformationProjectionBuffer(),
+         *      @ref bindDrawBuffer() and
+         *      @ref bindTextureTransformationBuffer()
+         * @m_since_latest
+         *
+         * If @p flags contains @ref Flag::UniformBuffers, @p materialCount
+         * and @p drawCount describe the uniform buffer sizes as these are
+         * required to have a statically defined size. The draw offset is then
+         * set via @ref setDrawOffset(). Expects that both @p materialCount
+         * and @p drawCount are non-zero in that case.
+         *
+         * If @p flags don't contain @ref Flag::UniformBuffers,
+         * @p materialCount and @p drawCount is ignored and the constructor
+         * behaves the same as @ref Flat(Flags).
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        explicit Flat(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount);
+        #endif
+
         /**
          * @brief Construct without creating the underlying OpenGL object
          *
@@ -414,11 +645,43 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
         /** @brief Flags */
         Flags flags() const { return _flags; }
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Material count
+         * @m_since_latest
+         *
+         * Statically defined size of the @ref FlatMaterialUniform uniform
+         * buffer. Has use only if @ref Flag::UniformBuffers is set.
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt materialCount() const { return _materialCount; }
+
+        /**
+         * @brief Draw count
+         * @m_since_latest
+         *
+         * Statically defined size of each of the
+         * @ref TransformationProjectionUniform2D /
+         * @ref TransformationProjectionUniform3D, @ref FlatDrawUniform and
+         * @ref TextureTransformationUniform uniform buffers. Has use only if
+         * @ref Flag::UniformBuffers is set.
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt drawCount() const { return _drawCount; }
+        #endif
+
         /**
          * @brief Set transformation and projection matrix
          * @return Reference to self (for method chaining)
          *
          * Initial value is an identity matrix.
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref TransformationProjectionUniform2D::transformationProjectionMatrix
+         * / @ref TransformationProjectionUniform3D::transformationProjectionMatrix
+         * and call @ref bindTransformationProjectionBuffer() instead.
          */
         Flat<dimensions>& setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix);
 
@@ -430,6 +693,10 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
          * Expects that the shader was created with
          * @ref Flag::TextureTransformation enabled. Initial value is an
          * identity matrix.
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref TextureTransformationUniform and call
+         * @ref bindTextureTransformationBuffer() instead.
          */
         Flat<dimensions>& setTextureMatrix(const Matrix3& matrix);
 
@@ -440,6 +707,10 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
          * If @ref Flag::Textured is set, initial value is
          * @cpp 0xffffffff_rgbaf @ce and the color will be multiplied with the
          * texture.
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref FlatMaterialUniform::color and call @ref bindMaterialBuffer()
+         * instead.
          * @see @ref bindTexture()
          */
         Flat<dimensions>& setColor(const Magnum::Color4& color);
@@ -466,6 +737,10 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
          *
          * This corresponds to @m_class{m-doc-external} [glAlphaFunc()](https://www.khronos.org/registry/OpenGL-Refpages/gl2.1/xhtml/glAlphaFunc.xml)
          * in classic OpenGL.
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref FlatMaterialUniform::alphaMask and call
+         * @ref bindMaterialBuffer() instead.
          * @m_keywords{glAlphaFunc()}
          */
         Flat<dimensions>& setAlphaMask(Float mask);
@@ -480,11 +755,126 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
          * @ref Shaders-Flat-object-id for more information. Default is
          * @cpp 0 @ce. If @ref Flag::InstancedObjectId is enabled as well, this
          * value is combined with ID coming from the @ref ObjectId attribute.
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref FlatDrawUniform::objectId and call @ref bindDrawBuffer()
+         * instead.
          * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
          * @requires_gles30 Object ID output requires integer support in
          *      shaders, which is not available in OpenGL ES 2.0 or WebGL 1.0.
          */
         Flat<dimensions>& setObjectId(UnsignedInt id);
+
+        /**
+         * @brief Set a draw offset
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Specifies which item in the
+         * @ref TransformationProjectionUniform2D /
+         * @ref TransformationProjectionUniform3D, @ref FlatDrawUniform and
+         * @ref TextureTransformationUniform buffers should be used for
+         * current draw. Expects that @ref Flag::UniformBuffers is set and
+         * @p offset is less than @ref drawCount(). Initial value is
+         * @cpp 0 @ce. If @ref Flag::MultiDraw is set, the index of the mesh
+         * in a multi-draw is added to this value.
+         * @see @ref Shaders-Flat-ubo
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& setDrawOffset(UnsignedInt offset);
+
+        /**
+         * @brief Bind a transformation and projection uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref TransformationProjectionUniform2D /
+         * @ref TransformationProjectionUniform3D.
+         * @see @ref Shaders-Flat-ubo
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& bindTransformationProjectionBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Flat<dimensions>& bindTransformationProjectionBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a draw uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref FlatDrawUniform.
+         * @see @ref Shaders-Flat-ubo
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& bindDrawBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Flat<dimensions>& bindDrawBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a texture transformation uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that both @ref Flag::UniformBuffers and
+         * @ref Flag::TextureTransformation is set. The buffer is expected to
+         * contain @ref drawCount() instances of
+         * @ref TextureTransformationUniform.
+         * @see @ref Shaders-Flat-ubo
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& bindTextureTransformationBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Flat<dimensions>& bindTextureTransformationBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a material uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref materialCount() instances of
+         * @ref FlatMaterialUniform.
+         * @see @ref Shaders-Flat-ubo
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& bindMaterialBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Flat<dimensions>& bindMaterialBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
         #endif
 
     private:
@@ -497,12 +887,18 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
         #endif
 
         Flags _flags;
+        #ifndef MAGNUM_TARGET_GLES2
+        UnsignedInt _materialCount{}, _drawCount{};
+        #endif
         Int _transformationProjectionMatrixUniform{0},
             _textureMatrixUniform{1},
             _colorUniform{2},
             _alphaMaskUniform{3};
         #ifndef MAGNUM_TARGET_GLES2
         Int _objectIdUniform{4};
+        /* Used instead of all other uniforms when Flag::UniformBuffers is
+           set, so it can alias them */
+        Int _drawOffsetUniform{0};
         #endif
 };
 
@@ -27,11 +27,20 @@
 #extension GL_EXT_gpu_shader4: require
 #endif
 
+#if defined(UNIFORM_BUFFERS) && !defined(GL_ES) && __VERSION__ < 140
+#extension GL_ARB_uniform_buffer_object: require
+#endif
+
+#ifdef MULTI_DRAW
+#extension GL_ARB_shader_draw_parameters: require
+#endif
+
 #ifndef NEW_GLSL
 #define in attribute
 #define out varying
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 0)
 #endif
@@ -62,6 +71,53 @@ uniform mediump mat3 textureMatrix
     ;
 #endif
 
+#else
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+/* mediump is just 2^10, which might not be enough, this is 2^16 */
+uniform highp uint drawOffset; /* defaults to zero */
+
+#ifdef EXPLICIT_BINDING
+layout(std140, binding = 1)
+#else
+layout(std140)
+#endif
+uniform TransformationProjection {
+    #ifdef TWO_DIMENSIONS
+    /* mat3 is padded to mat3x4 in std140 */
+    highp mat3 transformationProjectionMatrices[DRAW_COUNT];
+    #elif defined(THREE_DIMENSIONS)
+    highp mat4 transformationProjectionMatrices[DRAW_COUNT];
+    #else
+    #error
+    #endif
+};
+
+#ifdef TEXTURE_TRANSFORMATION
+struct TextureTransformationUniform {
+    highp vec4 rotationScaling;
+    highp vec2 offset;
+    highp vec2 reserved;
+};
+
+#ifdef EXPLICIT_BINDING
+layout(std140, binding = 3)
+#else
+layout(std140)
+#endif
+uniform TextureTransformation {
+    TextureTransformationUniform textureTransformations[DRAW_COUNT];
+};
+#endif
+
+#ifdef MULTI_DRAW
+flat out highp uint drawId;
+#else
+#define drawId drawOffset
+#endif
+#endif
+
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
@@ -121,6 +177,25 @@ in mediump vec2 instancedTextureOffset;
 #endif
 
 void main() {
+    #ifdef UNIFORM_BUFFERS
+    #ifdef MULTI_DRAW
+    drawId = drawOffset + uint(gl_DrawIDARB);
+    #endif
+    #ifdef TWO_DIMENSIONS
+    highp mat3 transformationProjectionMatrix = transformationProjectionMatrices[drawId];
+    #elif defined(THREE_DIMENSIONS)
+    highp mat4 transformationProjectionMatrix = transformationProjectionMatrices[drawId];
+    #else
+    #error
+    #endif
+    #ifdef TEXTURE_TRANSFORMATION
+    mediump mat3 textureMatrix = mat3(
+        textureTransformations[drawId].rotationScaling.xy, 0.0,
+        textureTransformations[drawId].rotationScaling.zw, 0.0,
+        textureTransformations[drawId].offset, 1.0);
+    #endif
+    #endif
+
     #ifdef TWO_DIMENSIONS
     gl_Position.xywz = vec4(transformationProjectionMatrix*
         #ifdef INSTANCED_TRANSFORMATION
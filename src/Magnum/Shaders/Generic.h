@@ -26,10 +26,12 @@
 */
 
 /** @file
- * @brief Struct @ref Magnum::Shaders::Generic, typedef @ref Magnum::Shaders::Generic2D, @ref Magnum::Shaders::Generic3D
+ * @brief Struct @ref Magnum::Shaders::Generic, @ref Magnum::Shaders::ProjectionUniform3D, @ref Magnum::Shaders::TransformationUniform3D, @ref Magnum::Shaders::TransformationProjectionUniform2D, @ref Magnum::Shaders::TransformationProjectionUniform3D, @ref Magnum::Shaders::TextureTransformationUniform, typedef @ref Magnum::Shaders::Generic2D, @ref Magnum::Shaders::Generic3D
  */
 
 #include "Magnum/GL/Attribute.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
 
 namespace Magnum { namespace Shaders {
 
@@ -247,6 +249,27 @@ layout(location = POSITION_ATTRIBUTE_LOCATION) in vec3 position;
 layout(location = NORMAL_ATTRIBUTE_LOCATION) in vec3 normal;
 @endcode
 
+@section Shaders-Generic-uniform-buffers Uniform buffer bindings
+
+Shaders created with a @cpp UniformBuffers @ce flag take their inputs from
+uniform buffers instead of classic uniforms. The uniform buffer binding points
+are shared among all builtin shaders so a buffer can be bound once and used by
+all of them:
+
+-   0 --- projection, @ref ProjectionUniform3D
+-   1 --- transformation, @ref TransformationUniform3D, or a combined
+    transformation and projection, @ref TransformationProjectionUniform2D /
+    @ref TransformationProjectionUniform3D
+-   2 --- per-draw parameters, shader-specific
+-   3 --- texture transformation, @ref TextureTransformationUniform
+-   4 --- material parameters, shader-specific
+-   5 --- light parameters, shader-specific
+
+The structures are laid out to match the
+@m_class{m-doc-external} [std140](https://www.khronos.org/registry/OpenGL/specs/gl/glspec45.core.pdf#page=159)
+layout in the shader code, so an array of them can be directly uploaded to a
+@ref GL::Buffer.
+
 @see @ref shaders, @ref Generic2D, @ref Generic3D
 */
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -481,6 +504,215 @@ template<> struct Generic<3>: BaseGeneric {
 };
 #endif
 
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Projection uniform for 3D shaders
+@m_since_latest
+
+Bound to the uniform buffer binding 0, see
+@ref Shaders-Generic-uniform-buffers for more information.
+@see @ref Phong::bindProjectionBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct ProjectionUniform3D {
+    /** @brief Construct with default parameters */
+    constexpr /*implicit*/ ProjectionUniform3D() noexcept: projectionMatrix{Math::IdentityInit} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit ProjectionUniform3D(NoInitT) noexcept: projectionMatrix{NoInit} {}
+
+    /**
+     * @brief Set the @ref projectionMatrix field
+     * @return Reference to self (for method chaining)
+     */
+    ProjectionUniform3D& setProjectionMatrix(const Matrix4& matrix) {
+        projectionMatrix = matrix;
+        return *this;
+    }
+
+    /**
+     * @brief Projection matrix
+     *
+     * Default value is an identity matrix.
+     */
+    Matrix4 projectionMatrix;
+};
+
+/**
+@brief Transformation uniform for 3D shaders
+@m_since_latest
+
+Bound to the uniform buffer binding 1, one item for each draw, see
+@ref Shaders-Generic-uniform-buffers for more information.
+@see @ref Phong::bindTransformationBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct TransformationUniform3D {
+    /** @brief Construct with default parameters */
+    constexpr /*implicit*/ TransformationUniform3D() noexcept: transformationMatrix{Math::IdentityInit} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit TransformationUniform3D(NoInitT) noexcept: transformationMatrix{NoInit} {}
+
+    /**
+     * @brief Set the @ref transformationMatrix field
+     * @return Reference to self (for method chaining)
+     */
+    TransformationUniform3D& setTransformationMatrix(const Matrix4& matrix) {
+        transformationMatrix = matrix;
+        return *this;
+    }
+
+    /**
+     * @brief Transformation matrix
+     *
+     * Default value is an identity matrix.
+     */
+    Matrix4 transformationMatrix;
+};
+
+/**
+@brief Combined transformation and projection uniform for 2D shaders
+@m_since_latest
+
+Bound to the uniform buffer binding 1, one item for each draw, see
+@ref Shaders-Generic-uniform-buffers for more information.
+@see @ref Flat::bindTransformationProjectionBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct TransformationProjectionUniform2D {
+    /** @brief Construct with default parameters */
+    constexpr /*implicit*/ TransformationProjectionUniform2D() noexcept: transformationProjectionMatrix{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit TransformationProjectionUniform2D(NoInitT) noexcept: transformationProjectionMatrix{NoInit} {}
+
+    /**
+     * @brief Set the @ref transformationProjectionMatrix field
+     * @return Reference to self (for method chaining)
+     *
+     * The matrix is expanded to @ref Matrix3x4, with the bottom row being
+     * zero.
+     */
+    TransformationProjectionUniform2D& setTransformationProjectionMatrix(const Matrix3& matrix) {
+        transformationProjectionMatrix = Matrix3x4{
+            Vector4{matrix[0], 0.0f},
+            Vector4{matrix[1], 0.0f},
+            Vector4{matrix[2], 0.0f}};
+        return *this;
+    }
+
+    /**
+     * @brief Transformation and projection matrix
+     *
+     * Default value is an identity matrix. The bottom row is unused and
+     * acts only as a padding to match uniform buffer packing rules.
+     */
+    Matrix3x4 transformationProjectionMatrix;
+};
+
+/**
+@brief Combined transformation and projection uniform for 3D shaders
+@m_since_latest
+
+Bound to the uniform buffer binding 1, one item for each draw, see
+@ref Shaders-Generic-uniform-buffers for more information.
+@see @ref Flat::bindTransformationProjectionBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct TransformationProjectionUniform3D {
+    /** @brief Construct with default parameters */
+    constexpr /*implicit*/ TransformationProjectionUniform3D() noexcept: transformationProjectionMatrix{Math::IdentityInit} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit TransformationProjectionUniform3D(NoInitT) noexcept: transformationProjectionMatrix{NoInit} {}
+
+    /**
+     * @brief Set the @ref transformationProjectionMatrix field
+     * @return Reference to self (for method chaining)
+     */
+    TransformationProjectionUniform3D& setTransformationProjectionMatrix(const Matrix4& matrix) {
+        transformationProjectionMatrix = matrix;
+        return *this;
+    }
+
+    /**
+     * @brief Transformation and projection matrix
+     *
+     * Default value is an identity matrix.
+     */
+    Matrix4 transformationProjectionMatrix;
+};
+
+/**
+@brief Texture transformation uniform
+@m_since_latest
+
+Bound to the uniform buffer binding 3, one item for each draw, see
+@ref Shaders-Generic-uniform-buffers for more information. Used only if the
+shader was created with a @cpp TextureTransformation @ce flag.
+@see @ref Phong::bindTextureTransformationBuffer(),
+    @ref Flat::bindTextureTransformationBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct TextureTransformationUniform {
+    /** @brief Construct with default parameters */
+    constexpr /*implicit*/ TextureTransformationUniform() noexcept: rotationScaling{1.0f, 0.0f, 0.0f, 1.0f}, offset{0.0f, 0.0f} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit TextureTransformationUniform(NoInitT) noexcept: rotationScaling{NoInit}, offset{NoInit} {}
+
+    /**
+     * @brief Set the @ref rotationScaling and @ref offset fields
+     * @return Reference to self (for method chaining)
+     *
+     * The rotation and scaling part is taken from the upper left 2x2 part
+     * of the matrix and the offset from the translation part of the matrix,
+     * the bottom row is ignored.
+     */
+    TextureTransformationUniform& setTextureMatrix(const Matrix3& matrix) {
+        rotationScaling = {matrix[0][0], matrix[0][1], matrix[1][0], matrix[1][1]};
+        offset = matrix.translation();
+        return *this;
+    }
+
+    /**
+     * @brief Rotation and scaling
+     *
+     * The top left part of a 3x3 texture transformation matrix, with the
+     * first column in the first two components and the second column in the
+     * last two. Default value is an identity.
+     */
+    Vector4 rotationScaling;
+
+    /**
+     * @brief Offset
+     *
+     * The translation part of a 3x3 texture transformation matrix. Default
+     * value is a zero vector.
+     */
+    Vector2 offset;
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32; /* reserved */
+    Int:32; /* reserved */
+    #endif
+};
+#endif
+
 }}
 
 #endif
@@ -37,6 +37,9 @@
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Shader.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/Buffer.h"
+#endif
 #include "Magnum/GL/Texture.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
@@ -53,12 +56,65 @@ namespace {
         SpecularTextureUnit = 2,
         NormalTextureUnit = 3
     };
+
+    #ifndef MAGNUM_TARGET_GLES2
+    enum: Int {
+        ProjectionBufferBinding = 0,
+        TransformationBufferBinding = 1,
+        DrawBufferBinding = 2,
+        TextureTransformationBufferBinding = 3,
+        MaterialBufferBinding = 4,
+        LightBufferBinding = 5
+    };
+    #endif
 }
 
-Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _lightCount{lightCount}, _lightColorsUniform{_lightPositionsUniform + Int(lightCount)}, _lightSpecularColorsUniform{_lightPositionsUniform + 2*Int(lightCount)}, _lightRangesUniform{_lightPositionsUniform + 3*Int(lightCount)} {
+/* Classic uniform setters can't be used with uniform buffers enabled and
+   vice versa. There are no uniform buffers on ES2, so there the check
+   compiles away. */
+#ifndef MAGNUM_TARGET_GLES2
+#define ASSERT_NO_UNIFORM_BUFFERS(function)                                 \
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),                       \
+        "Shaders::Phong::" function "(): the shader was created with uniform buffers enabled", *this)
+#define ASSERT_UNIFORM_BUFFERS(function)                                    \
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,                          \
+        "Shaders::Phong::" function "(): the shader was not created with uniform buffers enabled", *this)
+#else
+#define ASSERT_NO_UNIFORM_BUFFERS(function) do {} while(false)
+#endif
+
+Phong::Phong(const Flags flags, const UnsignedInt lightCount
+    #ifndef MAGNUM_TARGET_GLES2
+    , const UnsignedInt materialCount, const UnsignedInt drawCount
+    #endif
+):
+    _flags{flags},
+    _lightCount{lightCount},
+    #ifndef MAGNUM_TARGET_GLES2
+    _materialCount{materialCount},
+    _drawCount{drawCount},
+    #endif
+    _lightColorsUniform{_lightPositionsUniform + Int(lightCount)},
+    _lightSpecularColorsUniform{_lightPositionsUniform + 2*Int(lightCount)},
+    _lightRangesUniform{_lightPositionsUniform + 3*Int(lightCount)}
+{
     CORRADE_ASSERT(!(flags & Flag::TextureTransformation) || (flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture|Flag::NormalTexture)),
         "Shaders::Phong: texture transformation enabled but the shader is not textured", );
 
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || materialCount,
+        "Shaders::Phong: material count can't be zero", );
+    CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || drawCount,
+        "Shaders::Phong: draw count can't be zero", );
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags >= Flag::UniformBuffers)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::uniform_buffer_object);
+    if(flags >= Flag::MultiDraw)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::shader_draw_parameters);
+    #endif
+
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -77,7 +133,7 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
 
     #ifndef MAGNUM_TARGET_GLES
     std::string lightInitializerVertex, lightInitializerFragment;
-    if(lightCount) {
+    if(lightCount && !(flags >= Flag::UniformBuffers)) {
         using namespace Containers::Literals;
 
         /* Initializer for the light color / position / range arrays -- we need
@@ -137,8 +193,20 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
         #endif
         .addSource(flags & Flag::InstancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "")
         .addSource(flags >= Flag::InstancedTextureOffset ? "#define INSTANCED_TEXTURE_OFFSET\n" : "");
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        vert.addSource(Utility::formatString(
+            "#define UNIFORM_BUFFERS\n"
+            "#define DRAW_COUNT {}\n",
+            drawCount));
+        #ifndef MAGNUM_TARGET_GLES
+        vert.addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "");
+        #endif
+    }
+    #endif
     #ifndef MAGNUM_TARGET_GLES
-    if(lightCount) vert.addSource(std::move(lightInitializerVertex));
+    if(lightCount && !(flags >= Flag::UniformBuffers))
+        vert.addSource(std::move(lightInitializerVertex));
     #endif
     vert.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Phong.vert"));
@@ -162,8 +230,22 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
             _lightPositionsUniform + lightCount,
             _lightPositionsUniform + 2*lightCount,
             _lightPositionsUniform + 3*lightCount));
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        frag.addSource(Utility::formatString(
+            "#define UNIFORM_BUFFERS\n"
+            "#define DRAW_COUNT {}\n"
+            "#define MATERIAL_COUNT {}\n",
+            drawCount,
+            materialCount));
+        #ifndef MAGNUM_TARGET_GLES
+        frag.addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "");
+        #endif
+    }
+    #endif
     #ifndef MAGNUM_TARGET_GLES
-    if(lightCount) frag.addSource(std::move(lightInitializerFragment));
+    if(lightCount && !(flags >= Flag::UniformBuffers))
+        frag.addSource(std::move(lightInitializerFragment));
     #endif
     frag.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Phong.frag"));
@@ -212,27 +294,34 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
     #endif
     {
-        _transformationMatrixUniform = uniformLocation("transformationMatrix");
-        if(flags & Flag::TextureTransformation)
-            _textureMatrixUniform = uniformLocation("textureMatrix");
-        _projectionMatrixUniform = uniformLocation("projectionMatrix");
-        _ambientColorUniform = uniformLocation("ambientColor");
-        if(lightCount) {
-            _normalMatrixUniform = uniformLocation("normalMatrix");
-            _diffuseColorUniform = uniformLocation("diffuseColor");
-            _specularColorUniform = uniformLocation("specularColor");
-            _shininessUniform = uniformLocation("shininess");
-            if(flags & Flag::NormalTexture)
-                _normalTextureScaleUniform = uniformLocation("normalTextureScale");
-            _lightPositionsUniform = uniformLocation("lightPositions");
-            _lightColorsUniform = uniformLocation("lightColors");
-            _lightSpecularColorsUniform = uniformLocation("lightSpecularColors");
-            _lightRangesUniform = uniformLocation("lightRanges");
-        }
-        if(flags & Flag::AlphaMask) _alphaMaskUniform = uniformLocation("alphaMask");
         #ifndef MAGNUM_TARGET_GLES2
-        if(flags & Flag::ObjectId) _objectIdUniform = uniformLocation("objectId");
+        if(flags >= Flag::UniformBuffers) {
+            _drawOffsetUniform = uniformLocation("drawOffset");
+        } else
         #endif
+        {
+            _transformationMatrixUniform = uniformLocation("transformationMatrix");
+            if(flags & Flag::TextureTransformation)
+                _textureMatrixUniform = uniformLocation("textureMatrix");
+            _projectionMatrixUniform = uniformLocation("projectionMatrix");
+            _ambientColorUniform = uniformLocation("ambientColor");
+            if(lightCount) {
+                _normalMatrixUniform = uniformLocation("normalMatrix");
+                _diffuseColorUniform = uniformLocation("diffuseColor");
+                _specularColorUniform = uniformLocation("specularColor");
+                _shininessUniform = uniformLocation("shininess");
+                if(flags & Flag::NormalTexture)
+                    _normalTextureScaleUniform = uniformLocation("normalTextureScale");
+                _lightPositionsUniform = uniformLocation("lightPositions");
+                _lightColorsUniform = uniformLocation("lightColors");
+                _lightSpecularColorsUniform = uniformLocation("lightSpecularColors");
+                _lightRangesUniform = uniformLocation("lightRanges");
+            }
+            if(flags & Flag::AlphaMask) _alphaMaskUniform = uniformLocation("alphaMask");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags & Flag::ObjectId) _objectIdUniform = uniformLocation("objectId");
+            #endif
+        }
     }
 
     #ifndef MAGNUM_TARGET_GLES
@@ -247,35 +336,66 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
         }
     }
 
-    /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
+    /* Uniform block bindings are set in the shader directly if 420pack is
+       available, ES3 doesn't support that */
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers
+        #ifndef MAGNUM_TARGET_GLES
+        && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>(version)
+        #endif
+    ) {
+        setUniformBlockBinding(uniformBlockIndex("Projection"), ProjectionBufferBinding);
+        setUniformBlockBinding(uniformBlockIndex("Transformation"), TransformationBufferBinding);
+        setUniformBlockBinding(uniformBlockIndex("Draw"), DrawBufferBinding);
+        if(flags & Flag::TextureTransformation)
+            setUniformBlockBinding(uniformBlockIndex("TextureTransformation"), TextureTransformationBufferBinding);
+        setUniformBlockBinding(uniformBlockIndex("Material"), MaterialBufferBinding);
+        if(lightCount)
+            setUniformBlockBinding(uniformBlockIndex("Light"), LightBufferBinding);
+    }
+    #endif
+
+    /* Set defaults in OpenGL ES (for desktop they are set in shader code
+       itself). Uniform buffers have the defaults in the uniform structs and
+       the draw offset is zero by default. */
     #ifdef MAGNUM_TARGET_GLES
-    /* Default to fully opaque white so we can see the textures */
-    if(flags & Flag::AmbientTexture) setAmbientColor(Magnum::Color4{1.0f});
-    else setAmbientColor(Magnum::Color4{0.0f});
-    setTransformationMatrix(Matrix4{Math::IdentityInit});
-    setProjectionMatrix(Matrix4{Math::IdentityInit});
-    if(lightCount) {
-        setDiffuseColor(Magnum::Color4{1.0f});
-        setSpecularColor(Magnum::Color4{1.0f, 0.0f});
-        setShininess(80.0f);
-        if(flags & Flag::NormalTexture)
-            setNormalTextureScale(1.0f);
-        setLightPositions(Containers::Array<Vector4>{Containers::DirectInit, lightCount, Vector4{0.0f, 0.0f, 1.0f, 0.0f}});
-        Containers::Array<Magnum::Color3> colors{Containers::DirectInit, lightCount, Magnum::Color3{1.0f}};
-        setLightColors(colors);
-        setLightSpecularColors(colors);
-        setLightRanges(Containers::Array<Float>{Containers::DirectInit, lightCount, Constants::inf()});
-        /* Light position is zero by default */
-        setNormalMatrix(Matrix3x3{Math::IdentityInit});
+    #ifndef MAGNUM_TARGET_GLES2
+    if(!(flags >= Flag::UniformBuffers))
+    #endif
+    {
+        /* Default to fully opaque white so we can see the textures */
+        if(flags & Flag::AmbientTexture) setAmbientColor(Magnum::Color4{1.0f});
+        else setAmbientColor(Magnum::Color4{0.0f});
+        setTransformationMatrix(Matrix4{Math::IdentityInit});
+        setProjectionMatrix(Matrix4{Math::IdentityInit});
+        if(lightCount) {
+            setDiffuseColor(Magnum::Color4{1.0f});
+            setSpecularColor(Magnum::Color4{1.0f, 0.0f});
+            setShininess(80.0f);
+            if(flags & Flag::NormalTexture)
+                setNormalTextureScale(1.0f);
+            setLightPositions(Containers::Array<Vector4>{Containers::DirectInit, lightCount, Vector4{0.0f, 0.0f, 1.0f, 0.0f}});
+            Containers::Array<Magnum::Color3> colors{Containers::DirectInit, lightCount, Magnum::Color3{1.0f}};
+            setLightColors(colors);
+            setLightSpecularColors(colors);
+            setLightRanges(Containers::Array<Float>{Containers::DirectInit, lightCount, Constants::inf()});
+            /* Light position is zero by default */
+            setNormalMatrix(Matrix3x3{Math::IdentityInit});
+        }
+        if(flags & Flag::TextureTransformation)
+            setTextureMatrix(Matrix3{Math::IdentityInit});
+        if(flags & Flag::AlphaMask) setAlphaMask(0.5f);
+        /* Object ID is zero by default */
     }
-    if(flags & Flag::TextureTransformation)
-        setTextureMatrix(Matrix3{Math::IdentityInit});
-    if(flags & Flag::AlphaMask) setAlphaMask(0.5f);
-    /* Object ID is zero by default */
     #endif
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+Phong::Phong(const Flags flags, const UnsignedInt lightCount): Phong{flags, lightCount, 1, 1} {}
+#endif
+
 Phong& Phong::setAmbientColor(const Magnum::Color4& color) {
+    ASSERT_NO_UNIFORM_BUFFERS("setAmbientColor");
     setUniform(_ambientColorUniform, color);
     return *this;
 }
@@ -288,6 +408,7 @@ Phong& Phong::bindAmbientTexture(GL::Texture2D& texture) {
 }
 
 Phong& Phong::setDiffuseColor(const Magnum::Color4& color) {
+    ASSERT_NO_UNIFORM_BUFFERS("setDiffuseColor");
     if(_lightCount) setUniform(_diffuseColorUniform, color);
     return *this;
 }
@@ -300,6 +421,7 @@ Phong& Phong::bindDiffuseTexture(GL::Texture2D& texture) {
 }
 
 Phong& Phong::setSpecularColor(const Magnum::Color4& color) {
+    ASSERT_NO_UNIFORM_BUFFERS("setSpecularColor");
     if(_lightCount) setUniform(_specularColorUniform, color);
     return *this;
 }
@@ -326,11 +448,13 @@ Phong& Phong::bindTextures(GL::Texture2D* ambient, GL::Texture2D* diffuse, GL::T
 }
 
 Phong& Phong::setShininess(Float shininess) {
+    ASSERT_NO_UNIFORM_BUFFERS("setShininess");
     if(_lightCount) setUniform(_shininessUniform, shininess);
     return *this;
 }
 
 Phong& Phong::setNormalTextureScale(const Float scale) {
+    ASSERT_NO_UNIFORM_BUFFERS("setNormalTextureScale");
     CORRADE_ASSERT(_flags & Flag::NormalTexture,
         "Shaders::Phong::setNormalTextureScale(): the shader was not created with normal texture enabled", *this);
     if(_lightCount) setUniform(_normalTextureScaleUniform, scale);
@@ -338,6 +462,7 @@ Phong& Phong::setNormalTextureScale(const Float scale) {
 }
 
 Phong& Phong::setAlphaMask(Float mask) {
+    ASSERT_NO_UNIFORM_BUFFERS("setAlphaMask");
     CORRADE_ASSERT(_flags & Flag::AlphaMask,
         "Shaders::Phong::setAlphaMask(): the shader was not created with alpha mask enabled", *this);
     setUniform(_alphaMaskUniform, mask);
@@ -346,6 +471,7 @@ Phong& Phong::setAlphaMask(Float mask) {
 
 #ifndef MAGNUM_TARGET_GLES2
 Phong& Phong::setObjectId(UnsignedInt id) {
+    ASSERT_NO_UNIFORM_BUFFERS("setObjectId");
     CORRADE_ASSERT(_flags & Flag::ObjectId,
         "Shaders::Phong::setObjectId(): the shader was not created with object ID enabled", *this);
     setUniform(_objectIdUniform, id);
@@ -354,21 +480,25 @@ Phong& Phong::setObjectId(UnsignedInt id) {
 #endif
 
 Phong& Phong::setTransformationMatrix(const Matrix4& matrix) {
+    ASSERT_NO_UNIFORM_BUFFERS("setTransformationMatrix");
     setUniform(_transformationMatrixUniform, matrix);
     return *this;
 }
 
 Phong& Phong::setNormalMatrix(const Matrix3x3& matrix) {
+    ASSERT_NO_UNIFORM_BUFFERS("setNormalMatrix");
     if(_lightCount) setUniform(_normalMatrixUniform, matrix);
     return *this;
 }
 
 Phong& Phong::setProjectionMatrix(const Matrix4& matrix) {
+    ASSERT_NO_UNIFORM_BUFFERS("setProjectionMatrix");
     setUniform(_projectionMatrixUniform, matrix);
     return *this;
 }
 
 Phong& Phong::setTextureMatrix(const Matrix3& matrix) {
+    ASSERT_NO_UNIFORM_BUFFERS("setTextureMatrix");
     CORRADE_ASSERT(_flags & Flag::TextureTransformation,
         "Shaders::Phong::setTextureMatrix(): the shader was not created with texture transformation enabled", *this);
     setUniform(_textureMatrixUniform, matrix);
@@ -376,6 +506,7 @@ Phong& Phong::setTextureMatrix(const Matrix3& matrix) {
 }
 
 Phong& Phong::setLightPositions(const Containers::ArrayView<const Vector4> positions) {
+    ASSERT_NO_UNIFORM_BUFFERS("setLightPositions");
     CORRADE_ASSERT(_lightCount == positions.size(),
         "Shaders::Phong::setLightPositions(): expected" << _lightCount << "items but got" << positions.size(), *this);
     if(_lightCount) setUniform(_lightPositionsUniform, positions);
@@ -405,6 +536,7 @@ Phong& Phong::setLightPositions(const std::initializer_list<Vector3> positions)
 #endif
 
 Phong& Phong::setLightPosition(const UnsignedInt id, const Vector4& position) {
+    ASSERT_NO_UNIFORM_BUFFERS("setLightPosition");
     CORRADE_ASSERT(id < _lightCount,
         "Shaders::Phong::setLightPosition(): light ID" << id << "is out of bounds for" << _lightCount << "lights", *this);
     setUniform(_lightPositionsUniform + id, position);
@@ -423,6 +555,7 @@ Phong& Phong::setLightPosition(const Vector3& position) {
 #endif
 
 Phong& Phong::setLightColors(const Containers::ArrayView<const Magnum::Color3> colors) {
+    ASSERT_NO_UNIFORM_BUFFERS("setLightColors");
     CORRADE_ASSERT(_lightCount == colors.size(),
         "Shaders::Phong::setLightColors(): expected" << _lightCount << "items but got" << colors.size(), *this);
     if(_lightCount) setUniform(_lightColorsUniform, colors);
@@ -450,6 +583,7 @@ Phong& Phong::setLightColors(const std::initializer_list<Magnum::Color3> colors)
 }
 
 Phong& Phong::setLightColor(const UnsignedInt id, const Magnum::Color3& color) {
+    ASSERT_NO_UNIFORM_BUFFERS("setLightColor");
     CORRADE_ASSERT(id < _lightCount,
         "Shaders::Phong::setLightColor(): light ID" << id << "is out of bounds for" << _lightCount << "lights", *this);
     setUniform(_lightColorsUniform + id, color);
@@ -468,6 +602,7 @@ Phong& Phong::setLightColor(const Magnum::Color4& color) {
 #endif
 
 Phong& Phong::setLightSpecularColors(const Containers::ArrayView<const Magnum::Color3> colors) {
+    ASSERT_NO_UNIFORM_BUFFERS("setLightSpecularColors");
     CORRADE_ASSERT(_lightCount == colors.size(),
         "Shaders::Phong::setLightSpecularColors(): expected" << _lightCount << "items but got" << colors.size(), *this);
     if(_lightCount) setUniform(_lightSpecularColorsUniform, colors);
@@ -479,6 +614,7 @@ Phong& Phong::setLightSpecularColors(const std::initializer_list<Magnum::Color3>
 }
 
 Phong& Phong::setLightSpecularColor(const UnsignedInt id, const Magnum::Color3& color) {
+    ASSERT_NO_UNIFORM_BUFFERS("setLightSpecularColor");
     CORRADE_ASSERT(id < _lightCount,
         "Shaders::Phong::setLightSpecularColor(): light ID" << id << "is out of bounds for" << _lightCount << "lights", *this);
     setUniform(_lightSpecularColorsUniform + id, color);
@@ -486,6 +622,7 @@ Phong& Phong::setLightSpecularColor(const UnsignedInt id, const Magnum::Color3&
 }
 
 Phong& Phong::setLightRanges(const Containers::ArrayView<const Float> ranges) {
+    ASSERT_NO_UNIFORM_BUFFERS("setLightRanges");
     CORRADE_ASSERT(_lightCount == ranges.size(),
         "Shaders::Phong::setLightRanges(): expected" << _lightCount << "items but got" << ranges.size(), *this);
     if(_lightCount) setUniform(_lightRangesUniform, ranges);
@@ -497,12 +634,104 @@ Phong& Phong::setLightRanges(const std::initializer_list<Float> ranges) {
 }
 
 Phong& Phong::setLightRange(const UnsignedInt id, const Float range) {
+    ASSERT_NO_UNIFORM_BUFFERS("setLightRange");
     CORRADE_ASSERT(id < _lightCount,
         "Shaders::Phong::setLightRange(): light ID" << id << "is out of bounds for" << _lightCount << "lights", *this);
     setUniform(_lightRangesUniform + id, range);
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+Phong& Phong::setDrawOffset(const UnsignedInt offset) {
+    ASSERT_UNIFORM_BUFFERS("setDrawOffset");
+    CORRADE_ASSERT(offset < _drawCount,
+        "Shaders::Phong::setDrawOffset(): draw offset" << offset << "is out of bounds for" << _drawCount << "draws", *this);
+    setUniform(_drawOffsetUniform, offset);
+    return *this;
+}
+
+Phong& Phong::bindProjectionBuffer(GL::Buffer& buffer) {
+    ASSERT_UNIFORM_BUFFERS("bindProjectionBuffer");
+    buffer.bind(GL::Buffer::Target::Uniform, ProjectionBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindProjectionBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    ASSERT_UNIFORM_BUFFERS("bindProjectionBuffer");
+    buffer.bind(GL::Buffer::Target::Uniform, ProjectionBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindTransformationBuffer(GL::Buffer& buffer) {
+    ASSERT_UNIFORM_BUFFERS("bindTransformationBuffer");
+    buffer.bind(GL::Buffer::Target::Uniform, TransformationBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindTransformationBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    ASSERT_UNIFORM_BUFFERS("bindTransformationBuffer");
+    buffer.bind(GL::Buffer::Target::Uniform, TransformationBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindDrawBuffer(GL::Buffer& buffer) {
+    ASSERT_UNIFORM_BUFFERS("bindDrawBuffer");
+    buffer.bind(GL::Buffer::Target::Uniform, DrawBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindDrawBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    ASSERT_UNIFORM_BUFFERS("bindDrawBuffer");
+    buffer.bind(GL::Buffer::Target::Uniform, DrawBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindTextureTransformationBuffer(GL::Buffer& buffer) {
+    ASSERT_UNIFORM_BUFFERS("bindTextureTransformationBuffer");
+    CORRADE_ASSERT(_flags & Flag::TextureTransformation,
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureTransformationBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindTextureTransformationBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    ASSERT_UNIFORM_BUFFERS("bindTextureTransformationBuffer");
+    CORRADE_ASSERT(_flags & Flag::TextureTransformation,
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureTransformationBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindMaterialBuffer(GL::Buffer& buffer) {
+    ASSERT_UNIFORM_BUFFERS("bindMaterialBuffer");
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindMaterialBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    ASSERT_UNIFORM_BUFFERS("bindMaterialBuffer");
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindLightBuffer(GL::Buffer& buffer) {
+    ASSERT_UNIFORM_BUFFERS("bindLightBuffer");
+    if(_lightCount) buffer.bind(GL::Buffer::Target::Uniform, LightBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindLightBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    ASSERT_UNIFORM_BUFFERS("bindLightBuffer");
+    if(_lightCount) buffer.bind(GL::Buffer::Target::Uniform, LightBufferBinding, offset, size);
+    return *this;
+}
+#endif
+
+#undef ASSERT_NO_UNIFORM_BUFFERS
+#ifndef MAGNUM_TARGET_GLES2
+#undef ASSERT_UNIFORM_BUFFERS
+#endif
+
 Debug& operator<<(Debug& debug, const Phong::Flag value) {
     debug << "Shaders::Phong::Flag" << Debug::nospace;
 
@@ -523,11 +752,17 @@ Debug& operator<<(Debug& debug, const Phong::Flag value) {
         #endif
         _c(InstancedTransformation)
         _c(InstancedTextureOffset)
+        #ifndef MAGNUM_TARGET_GLES2
+        _c(UniformBuffers)
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        _c(MultiDraw)
+        #endif
         #undef _c
         /* LCOV_EXCL_STOP */
     }
 
-    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedShort(value)) << Debug::nospace << ")";
 }
 
 Debug& operator<<(Debug& debug, const Phong::Flags value) {
@@ -545,7 +780,14 @@ Debug& operator<<(Debug& debug, const Phong::Flags value) {
         Phong::Flag::InstancedObjectId, /* Superset of ObjectId */
         Phong::Flag::ObjectId,
         #endif
-        Phong::Flag::InstancedTransformation});
+        Phong::Flag::InstancedTransformation,
+        #ifndef MAGNUM_TARGET_GLES
+        Phong::Flag::MultiDraw, /* Superset of UniformBuffers */
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        Phong::Flag::UniformBuffers
+        #endif
+        });
 }
 
 }}
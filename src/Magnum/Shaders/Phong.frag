@@ -27,6 +27,10 @@
 #extension GL_EXT_gpu_shader4: require
 #endif
 
+#if defined(UNIFORM_BUFFERS) && !defined(GL_ES) && __VERSION__ < 140
+#extension GL_ARB_uniform_buffer_object: require
+#endif
+
 #ifndef NEW_GLSL
 #define in varying
 #define fragmentColor gl_FragColor
@@ -44,6 +48,30 @@ layout(binding = 0)
 uniform lowp sampler2D ambientTexture;
 #endif
 
+#if LIGHT_COUNT
+#ifdef DIFFUSE_TEXTURE
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 1)
+#endif
+uniform lowp sampler2D diffuseTexture;
+#endif
+
+#ifdef SPECULAR_TEXTURE
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 2)
+#endif
+uniform lowp sampler2D specularTexture;
+#endif
+
+#ifdef NORMAL_TEXTURE
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 3)
+#endif
+uniform lowp sampler2D normalTexture;
+#endif
+#endif
+
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 4)
 #endif
@@ -58,13 +86,6 @@ uniform lowp vec4 ambientColor
     ;
 
 #if LIGHT_COUNT
-#ifdef DIFFUSE_TEXTURE
-#ifdef EXPLICIT_TEXTURE_LAYER
-layout(binding = 1)
-#endif
-uniform lowp sampler2D diffuseTexture;
-#endif
-
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 5)
 #endif
@@ -74,20 +95,6 @@ uniform lowp vec4 diffuseColor
     #endif
     ;
 
-#ifdef SPECULAR_TEXTURE
-#ifdef EXPLICIT_TEXTURE_LAYER
-layout(binding = 2)
-#endif
-uniform lowp sampler2D specularTexture;
-#endif
-
-#ifdef NORMAL_TEXTURE
-#ifdef EXPLICIT_TEXTURE_LAYER
-layout(binding = 3)
-#endif
-uniform lowp sampler2D normalTexture;
-#endif
-
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 6)
 #endif
@@ -170,6 +177,76 @@ uniform lowp float lightRanges[LIGHT_COUNT]
     ;
 #endif
 
+#else
+#ifndef MULTI_DRAW
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+/* mediump is just 2^10, which might not be enough, this is 2^16 */
+uniform highp uint drawOffset; /* defaults to zero */
+#define drawId drawOffset
+#else
+flat in highp uint drawId;
+#endif
+
+/* Has to match the definition in Phong.vert */
+struct DrawUniform {
+    mediump mat3 normalMatrix; /* actually mat3x4 */
+    highp uint materialId;
+    highp uint objectId;
+    highp uint reserved1;
+    highp uint reserved2;
+};
+
+#ifdef EXPLICIT_BINDING
+layout(std140, binding = 2)
+#else
+layout(std140)
+#endif
+uniform Draw {
+    DrawUniform draws[DRAW_COUNT];
+};
+
+struct MaterialUniform {
+    lowp vec4 ambientColor;
+    lowp vec4 diffuseColor;
+    lowp vec4 specularColor;
+    mediump float normalTextureScale;
+    mediump float shininess;
+    lowp float alphaMask;
+    lowp float reserved;
+};
+
+#ifdef EXPLICIT_BINDING
+layout(std140, binding = 4)
+#else
+layout(std140)
+#endif
+uniform Material {
+    MaterialUniform materials[MATERIAL_COUNT];
+};
+
+#if LIGHT_COUNT
+/* Has to match the definition in Phong.vert */
+struct LightUniform {
+    highp vec4 position;
+    lowp vec3 color;
+    highp float range;
+    lowp vec3 specularColor;
+    lowp float reserved;
+};
+
+#ifdef EXPLICIT_BINDING
+layout(std140, binding = 5)
+#else
+layout(std140)
+#endif
+uniform Light {
+    LightUniform lights[LIGHT_COUNT];
+};
+#endif
+#endif
+
 #if LIGHT_COUNT
 in mediump vec3 transformedNormal;
 #ifdef NORMAL_TEXTURE
@@ -211,6 +288,25 @@ out highp uint fragmentObjectId;
 #endif
 
 void main() {
+    #ifdef UNIFORM_BUFFERS
+    #ifdef OBJECT_ID
+    highp const uint objectId = draws[drawId].objectId;
+    #endif
+    mediump const uint materialId = draws[drawId].materialId;
+    lowp const vec4 ambientColor = materials[materialId].ambientColor;
+    #if LIGHT_COUNT
+    lowp const vec4 diffuseColor = materials[materialId].diffuseColor;
+    lowp const vec4 specularColor = materials[materialId].specularColor;
+    mediump const float shininess = materials[materialId].shininess;
+    #endif
+    #ifdef NORMAL_TEXTURE
+    mediump const float normalTextureScale = materials[materialId].normalTextureScale;
+    #endif
+    #ifdef ALPHA_MASK
+    lowp const float alphaMask = materials[materialId].alphaMask;
+    #endif
+    #endif
+
     lowp const vec4 finalAmbientColor =
         #ifdef AMBIENT_TEXTURE
         texture(ambientTexture, interpolatedTextureCoordinates)*
@@ -263,6 +359,16 @@ void main() {
 
     /* Add diffuse color for each light */
     for(int i = 0; i < LIGHT_COUNT; ++i) {
+        #ifndef UNIFORM_BUFFERS
+        lowp const vec3 lightColor = lightColors[i];
+        lowp const vec3 lightSpecularColor = lightSpecularColors[i];
+        lowp const float lightRange = lightRanges[i];
+        #else
+        lowp const vec3 lightColor = lights[i].color;
+        lowp const vec3 lightSpecularColor = lights[i].specularColor;
+        lowp const float lightRange = lights[i].range;
+        #endif
+
         /* Attenuation. Directional lights have the .w component set to 0, use
            that to make the distance zero -- which will then ensure the
            attenuation is always 1.0 */
@@ -270,19 +376,19 @@ void main() {
         /* If range is 0 for whatever reason, clamp it to a small value to
            avoid a NaN when dist is 0 as well (which is the case for
            directional lights). */
-        highp float attenuation = clamp(1.0 - pow(dist/max(lightRanges[i], 0.0001), 4.0), 0.0, 1.0);
+        highp float attenuation = clamp(1.0 - pow(dist/max(lightRange, 0.0001), 4.0), 0.0, 1.0);
         attenuation = attenuation*attenuation/(1.0 + dist*dist);
 
         highp vec3 normalizedLightDirection = normalize(lightDirections[i].xyz);
         lowp float intensity = max(0.0, dot(normalizedTransformedNormal, normalizedLightDirection))*attenuation;
-        fragmentColor += vec4(finalDiffuseColor.rgb*lightColors[i]*intensity, finalDiffuseColor.a/float(LIGHT_COUNT));
+        fragmentColor += vec4(finalDiffuseColor.rgb*lightColor*intensity, finalDiffuseColor.a/float(LIGHT_COUNT));
 
         /* Add specular color, if needed */
         if(intensity > 0.001) {
             highp vec3 reflection = reflect(-normalizedLightDirection, normalizedTransformedNormal);
             /* Use attenuation for the specularity as well */
             mediump float specularity = clamp(pow(max(0.0, dot(normalize(cameraDirection), reflection)), shininess), 0.0, 1.0)*attenuation;
-            fragmentColor += vec4(finalSpecularColor.rgb*lightSpecularColors[i].rgb*specularity, finalSpecularColor.a);
+            fragmentColor += vec4(finalSpecularColor.rgb*lightSpecularColor*specularity, finalSpecularColor.a);
         }
     }
     #endif
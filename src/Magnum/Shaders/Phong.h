@@ -26,15 +26,330 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Shaders::Phong
+ * @brief Class @ref Magnum::Shaders::Phong, struct @ref Magnum::Shaders::PhongDrawUniform, @ref Magnum::Shaders::PhongMaterialUniform, @ref Magnum::Shaders::PhongLightUniform
  */
 
 #include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Constants.h"
 #include "Magnum/Shaders/Generic.h"
 #include "Magnum/Shaders/visibility.h"
 
 namespace Magnum { namespace Shaders {
 
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Per-draw uniform for Phong shaders
+@m_since_latest
+
+Bound to the uniform buffer binding 2, one item for each draw, see
+@ref Shaders-Phong-ubo for more information.
+@see @ref Phong::bindDrawBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct PhongDrawUniform {
+    /** @brief Construct with default parameters */
+    constexpr /*implicit*/ PhongDrawUniform() noexcept: normalMatrix{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}}, materialId{0}, objectId{0} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit PhongDrawUniform(NoInitT) noexcept: normalMatrix{NoInit} {}
+
+    /**
+     * @brief Set the @ref normalMatrix field
+     * @return Reference to self (for method chaining)
+     *
+     * The matrix is expanded to @ref Matrix3x4, with the bottom row being
+     * zero.
+     */
+    PhongDrawUniform& setNormalMatrix(const Matrix3x3& matrix) {
+        normalMatrix = Matrix3x4{
+            Vector4{matrix[0], 0.0f},
+            Vector4{matrix[1], 0.0f},
+            Vector4{matrix[2], 0.0f}};
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref materialId field
+     * @return Reference to self (for method chaining)
+     */
+    PhongDrawUniform& setMaterialId(UnsignedInt id) {
+        materialId = id;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref objectId field
+     * @return Reference to self (for method chaining)
+     */
+    PhongDrawUniform& setObjectId(UnsignedInt id) {
+        objectId = id;
+        return *this;
+    }
+
+    /**
+     * @brief Normal matrix
+     *
+     * Default value is an identity matrix. The bottom row is unused and
+     * acts only as a padding to match uniform buffer packing rules. Used
+     * only if the shader has a non-zero light count.
+     * @see @ref Phong::setNormalMatrix()
+     */
+    Matrix3x4 normalMatrix;
+
+    /**
+     * @brief Material ID
+     *
+     * Index into the buffer bound with @ref Phong::bindMaterialBuffer().
+     * Expected to be less than @ref Phong::materialCount(). Default value
+     * is @cpp 0 @ce.
+     */
+    UnsignedInt materialId;
+
+    /**
+     * @brief Object ID
+     *
+     * Used only if @ref Phong::Flag::ObjectId is enabled, ignored
+     * otherwise. Default value is @cpp 0 @ce.
+     * @see @ref Phong::setObjectId()
+     */
+    UnsignedInt objectId;
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32; /* reserved */
+    Int:32; /* reserved */
+    #endif
+};
+
+/**
+@brief Material uniform for Phong shaders
+@m_since_latest
+
+Bound to the uniform buffer binding 4, indexed by
+@ref PhongDrawUniform::materialId, see @ref Shaders-Phong-ubo for more
+information.
+@see @ref Phong::bindMaterialBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct PhongMaterialUniform {
+    /** @brief Construct with default parameters */
+    constexpr /*implicit*/ PhongMaterialUniform() noexcept: ambientColor{0.0f, 0.0f}, diffuseColor{1.0f, 1.0f}, specularColor{1.0f, 0.0f}, normalTextureScale{1.0f}, shininess{80.0f}, alphaMask{0.5f} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit PhongMaterialUniform(NoInitT) noexcept: ambientColor{NoInit}, diffuseColor{NoInit}, specularColor{NoInit} {}
+
+    /**
+     * @brief Set the @ref ambientColor field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialUniform& setAmbientColor(const Color4& color) {
+        ambientColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref diffuseColor field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialUniform& setDiffuseColor(const Color4& color) {
+        diffuseColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref specularColor field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialUniform& setSpecularColor(const Color4& color) {
+        specularColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref normalTextureScale field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialUniform& setNormalTextureScale(Float scale) {
+        normalTextureScale = scale;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref shininess field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialUniform& setShininess(Float shininess) {
+        this->shininess = shininess;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref alphaMask field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialUniform& setAlphaMask(Float mask) {
+        alphaMask = mask;
+        return *this;
+    }
+
+    /**
+     * @brief Ambient color
+     *
+     * Default value is @cpp 0x00000000_rgbaf @ce. Unlike with
+     * @ref Phong::setAmbientColor(), the default doesn't change to
+     * @cpp 0xffffffff_rgbaf @ce if @ref Phong::Flag::AmbientTexture is
+     * enabled.
+     */
+    Color4 ambientColor;
+
+    /**
+     * @brief Diffuse color
+     *
+     * Default value is @cpp 0xffffffff_rgbaf @ce.
+     * @see @ref Phong::setDiffuseColor()
+     */
+    Color4 diffuseColor;
+
+    /**
+     * @brief Specular color
+     *
+     * Default value is @cpp 0xffffff00_rgbaf @ce.
+     * @see @ref Phong::setSpecularColor()
+     */
+    Color4 specularColor;
+
+    /**
+     * @brief Normal texture scale
+     *
+     * Default value is @cpp 1.0f @ce. Used only if
+     * @ref Phong::Flag::NormalTexture is enabled, ignored otherwise.
+     * @see @ref Phong::setNormalTextureScale()
+     */
+    Float normalTextureScale;
+
+    /**
+     * @brief Shininess
+     *
+     * Default value is @cpp 80.0f @ce.
+     * @see @ref Phong::setShininess()
+     */
+    Float shininess;
+
+    /**
+     * @brief Alpha mask value
+     *
+     * Default value is @cpp 0.5f @ce. Used only if
+     * @ref Phong::Flag::AlphaMask is enabled, ignored otherwise.
+     * @see @ref Phong::setAlphaMask()
+     */
+    Float alphaMask;
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32; /* reserved */
+    #endif
+};
+
+/**
+@brief Light uniform for Phong shaders
+@m_since_latest
+
+Bound to the uniform buffer binding 5, with @ref Phong::lightCount() items
+that are applied to all draws, see @ref Shaders-Phong-ubo for more
+information.
+@see @ref Phong::bindLightBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct PhongLightUniform {
+    /** @brief Construct with default parameters */
+    constexpr /*implicit*/ PhongLightUniform() noexcept: position{0.0f, 0.0f, 1.0f, 0.0f}, color{1.0f}, range{Constants::inf()}, specularColor{1.0f} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit PhongLightUniform(NoInitT) noexcept: position{NoInit}, color{NoInit}, specularColor{NoInit} {}
+
+    /**
+     * @brief Set the @ref position field
+     * @return Reference to self (for method chaining)
+     */
+    PhongLightUniform& setPosition(const Vector4& position) {
+        this->position = position;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref color field
+     * @return Reference to self (for method chaining)
+     */
+    PhongLightUniform& setColor(const Color3& color) {
+        this->color = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref specularColor field
+     * @return Reference to self (for method chaining)
+     */
+    PhongLightUniform& setSpecularColor(const Color3& color) {
+        specularColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref range field
+     * @return Reference to self (for method chaining)
+     */
+    PhongLightUniform& setRange(Float range) {
+        this->range = range;
+        return *this;
+    }
+
+    /**
+     * @brief Position
+     *
+     * Default value is @cpp {0.0f, 0.0f, 1.0f, 0.0f} @ce --- a directional
+     * "fill" light coming from the camera.
+     * @see @ref Phong::setLightPositions(), @ref Shaders-Phong-lights
+     */
+    Vector4 position;
+
+    /**
+     * @brief Color
+     *
+     * Default value is @cpp 0xffffff_rgbf @ce.
+     * @see @ref Phong::setLightColors()
+     */
+    Color3 color;
+
+    /**
+     * @brief Attenuation range
+     *
+     * Default value is @ref Constants::inf().
+     * @see @ref Phong::setLightRanges()
+     */
+    Float range;
+
+    /**
+     * @brief Specular color
+     *
+     * Default value is @cpp 0xffffff_rgbf @ce.
+     * @see @ref Phong::setLightSpecularColors()
+     */
+    Color3 specularColor;
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32; /* reserved */
+    #endif
+};
+#endif
+
 /**
 @brief Phong shader
 
@@ -246,6 +561,47 @@ well to ensure lighting works:
 @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays} in WebGL
     1.0.
 
+@section Shaders-Phong-ubo Uniform buffers and multi-draw
+
+Setting uniforms for each drawn object one by one results in several GL calls
+per draw. If @ref Flag::UniformBuffers is enabled, the shader instead takes all
+inputs from uniform buffers --- @ref ProjectionUniform3D,
+@ref TransformationUniform3D, @ref PhongDrawUniform, @ref PhongMaterialUniform,
+@ref PhongLightUniform and, if @ref Flag::TextureTransformation is enabled,
+@ref TextureTransformationUniform --- which are bound with
+@ref bindProjectionBuffer(), @ref bindTransformationBuffer(),
+@ref bindDrawBuffer(), @ref bindMaterialBuffer(), @ref bindLightBuffer() and
+@ref bindTextureTransformationBuffer(). The transformation, draw and texture
+transformation buffers contain one item for each draw, materials are
+referenced from @ref PhongDrawUniform::materialId and the lights are applied
+to all draws. The count of draws and materials is specified in the
+constructor and it's limited by @ref GL::AbstractShaderProgram::maxUniformBlockSize(),
+with the guaranteed minimum of 16 kB being enough for 256 draws. Larger
+batches can be split into multiple buffer ranges.
+
+The draw to use is then selected with @ref setDrawOffset() before each
+@ref draw(), which costs a single uniform update. The classic uniform setters
+such as @ref setTransformationMatrix() can't be used in this case.
+
+@snippet MagnumShaders.cpp Phong-usage-ubo
+
+With @ref Flag::MultiDraw enabled additionally, the draw index is offset by
+the index of the mesh in a @ref draw(Containers::ArrayView<const Containers::Reference<MeshView>>)
+call. All meshes sharing the same vertex layout can then be submitted at once
+as a multi-draw, with each of them having a different transformation and
+material:
+
+@snippet MagnumShaders.cpp Phong-usage-multidraw
+
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object} for
+    @ref Flag::UniformBuffers.
+@requires_gl46 Extension @gl_extension{ARB,shader_draw_parameters} for
+    @ref Flag::MultiDraw.
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+@requires_gl Multi-draw with a draw index in shaders is not available in
+    OpenGL ES or WebGL, use @ref setDrawOffset() there instead.
+
 @see @ref shaders
 */
 class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
@@ -553,7 +909,44 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
              *      in WebGL 1.0.
              * @m_since{2020,06}
              */
-            InstancedTextureOffset = (1 << 10)|TextureTransformation
+            InstancedTextureOffset = (1 << 10)|TextureTransformation,
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * Use uniform buffers. Expects that uniform data are supplied via
+             * @ref bindProjectionBuffer(), @ref bindTransformationBuffer(),
+             * @ref bindDrawBuffer(), @ref bindTextureTransformationBuffer(),
+             * @ref bindMaterialBuffer() and @ref bindLightBuffer() instead of
+             * direct uniform setters. See @ref Shaders-Phong-ubo for more
+             * information.
+             * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Uniform buffers are not available in OpenGL ES
+             *      2.0.
+             * @requires_webgl20 Uniform buffers are not available in WebGL
+             *      1.0.
+             * @m_since_latest
+             */
+            UniformBuffers = 1 << 12,
+            #endif
+
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * Enable multidraw functionality. Implies
+             * @ref Flag::UniformBuffers and adds the value from
+             * @ref setDrawOffset() with the @glsl gl_DrawIDARB @ce builtin,
+             * which makes draws submitted via
+             * @ref GL::AbstractShaderProgram::draw(Containers::ArrayView<const Containers::Reference<MeshView>>)
+             * pick up per-draw parameters directly, without having to set
+             * the draw offset for each. See @ref Shaders-Phong-ubo for more
+             * information.
+             * @requires_gl46 Extension @gl_extension{ARB,uniform_buffer_object}
+             *      and @gl_extension{ARB,shader_draw_parameters}
+             * @requires_gl Multi-draw with a draw index in shaders is not
+             *      available in OpenGL ES or WebGL.
+             * @m_since_latest
+             */
+            MultiDraw = UniformBuffers|(1 << 13)
+            #endif
         };
 
         /**
@@ -567,9 +960,44 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * @brief Constructor
          * @param flags         Flags
          * @param lightCount    Count of light sources
+         *
+         * If @ref Flag::UniformBuffers is set, this is equivalent to calling
+         * @ref Phong(Flags, UnsignedInt, UnsignedInt, UnsignedInt) with
+         * @p materialCount and @p drawCount set to @cpp 1 @ce.
          */
         explicit Phong(Flags flags = {}, UnsignedInt lightCount = 1);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Construct for a multi-draw scenario
+         * @param flags         Flags
+         * @param lightCount    Count of light sources
+         * @param materialCount Size of a @ref PhongMaterialUniform buffer
+         *      bound with @ref bindMaterialBuffer()
+         * @param drawCount     Size of a @ref TransformationUniform3D /
+         *      @ref PhongDrawUniform / @ref TextureTransformationUniform
+         *      buffer bound with @ref bindTransformationBuffer(),
+         *      @ref bindDrawBuffer() and
+         *      @ref bindTextureTransformationBuffer()
+         * @m_since_latest
+         *
+         * If @p flags contains @ref Flag::UniformBuffers, @p materialCount
+         * and @p drawCount describe the uniform buffer sizes as these are
+         * required to have a statically defined size. The draw offset is then
+         * set via @ref setDrawOffset(). Expects that both @p materialCount
+         * and @p drawCount are non-zero in that case.
+         *
+         * If @p flags don't contain @ref Flag::UniformBuffers,
+         * @p materialCount and @p drawCount is ignored and the constructor
+         * behaves the same as @ref Phong(Flags, UnsignedInt).
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        explicit Phong(Flags flags, UnsignedInt lightCount, UnsignedInt materialCount, UnsignedInt drawCount);
+        #endif
+
         /**
          * @brief Construct without creating the underlying OpenGL object
          *
@@ -602,6 +1030,32 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
         /** @brief Light count */
         UnsignedInt lightCount() const { return _lightCount; }
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Material count
+         * @m_since_latest
+         *
+         * Statically defined size of the @ref PhongMaterialUniform uniform
+         * buffer. Has use only if @ref Flag::UniformBuffers is set.
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt materialCount() const { return _materialCount; }
+
+        /**
+         * @brief Draw count
+         * @m_since_latest
+         *
+         * Statically defined size of each of the
+         * @ref TransformationUniform3D, @ref PhongDrawUniform and
+         * @ref TextureTransformationUniform uniform buffers. Has use only if
+         * @ref Flag::UniformBuffers is set.
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt drawCount() const { return _drawCount; }
+        #endif
+
         /**
          * @brief Set ambient color
          * @return Reference to self (for method chaining)
@@ -609,6 +1063,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * If @ref Flag::AmbientTexture is set, default value is
          * @cpp 0xffffffff_rgbaf @ce and the color will be multiplied with
          * ambient texture, otherwise default value is @cpp 0x00000000_rgbaf @ce.
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref PhongMaterialUniform::ambientColor and call
+         * @ref bindMaterialBuffer() instead.
          * @see @ref bindAmbientTexture(), @ref Shaders-Phong-lights-ambient
          */
         Phong& setAmbientColor(const Magnum::Color4& color);
@@ -631,6 +1089,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * Initial value is @cpp 0xffffffff_rgbaf @ce. If @ref lightCount() is
          * zero, this function is a no-op, as diffuse color doesn't contribute
          * to the output in that case.
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref PhongMaterialUniform::diffuseColor and call
+         * @ref bindMaterialBuffer() instead.
          * @see @ref bindDiffuseTexture()
          */
         Phong& setDiffuseColor(const Magnum::Color4& color);
@@ -659,6 +1121,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * Expects that the shader was created with @ref Flag::NormalTexture
          * enabled. If @ref lightCount() is zero, this function is a no-op, as
          * normals don't contribute to the output in that case.
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref PhongMaterialUniform::normalTextureScale and call
+         * @ref bindMaterialBuffer() instead.
          * @see @ref Shaders-Phong-normal-mapping, @ref bindNormalTexture(),
          *      @ref Trade::MaterialAttribute::NormalTextureScale
          */
@@ -688,6 +1154,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * @cpp 0x00000000_rgbaf @ce. If @ref lightCount() is zero, this
          * function is a no-op, as specular color doesn't contribute to the
          * output in that case.
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref PhongMaterialUniform::specularColor and call
+         * @ref bindMaterialBuffer() instead.
          * @see @ref bindSpecularTexture()
          */
         Phong& setSpecularColor(const Magnum::Color4& color);
@@ -730,6 +1200,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * Initial value is @cpp 80.0f @ce. If @ref lightCount() is zero, this
          * function is a no-op, as specular color doesn't contribute to the
          * output in that case.
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref PhongMaterialUniform::shininess and call
+         * @ref bindMaterialBuffer() instead.
          */
         Phong& setShininess(Float shininess);
 
@@ -744,6 +1218,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          *
          * This corresponds to @m_class{m-doc-external} [glAlphaFunc()](https://www.khronos.org/registry/OpenGL-Refpages/gl2.1/xhtml/glAlphaFunc.xml)
          * in classic OpenGL.
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref PhongMaterialUniform::alphaMask and call
+         * @ref bindMaterialBuffer() instead.
          * @m_keywords{glAlphaFunc()}
          */
         Phong& setAlphaMask(Float mask);
@@ -757,6 +1235,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * enabled. Value set here is written to the @ref ObjectIdOutput, see
          * @ref Shaders-Phong-object-id for more information. Default is
          * @cpp 0 @ce.
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref PhongDrawUniform::objectId and call @ref bindDrawBuffer()
+         * instead.
          * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
          * @requires_gles30 Object ID output requires integer support in
          *      shaders, which is not available in OpenGL ES 2.0 or WebGL 1.0.
@@ -770,6 +1252,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          *
          * You need to set also @ref setNormalMatrix() with a corresponding
          * value. Initial value is an identity matrix.
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref TransformationUniform3D::transformationMatrix and call
+         * @ref bindTransformationBuffer() instead.
          */
         Phong& setTransformationMatrix(const Matrix4& matrix);
 
@@ -783,6 +1269,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * value is an identity matrix. If @ref lightCount() is zero, this
          * function is a no-op, as normals don't contribute to the output in
          * that case.
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref PhongDrawUniform::normalMatrix and call @ref bindDrawBuffer()
+         * instead.
          * @see @ref Math::Matrix4::normalMatrix()
          */
         Phong& setNormalMatrix(const Matrix3x3& matrix);
@@ -794,6 +1284,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * Initial value is an identity matrix (i.e., an orthographic
          * projection of the default @f$ [ -\boldsymbol{1} ; \boldsymbol{1} ] @f$
          * cube).
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref ProjectionUniform3D::projectionMatrix and call
+         * @ref bindProjectionBuffer() instead.
          */
         Phong& setProjectionMatrix(const Matrix4& matrix);
 
@@ -805,6 +1299,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * Expects that the shader was created with
          * @ref Flag::TextureTransformation enabled. Initial value is an
          * identity matrix.
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref TextureTransformationUniform and call
+         * @ref bindTextureTransformationBuffer() instead.
          */
         Phong& setTextureMatrix(const Matrix3& matrix);
 
@@ -820,6 +1318,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * @p positions array is the same as @ref lightCount(). Initial values
          * are @cpp {0.0f, 0.0f, 1.0f, 0.0f} @ce --- a directional "fill" light
          * coming from the camera.
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref PhongLightUniform::position and call @ref bindLightBuffer()
+         * instead.
          * @see @ref Shaders-Phong-lights, @ref setLightPosition()
          */
         Phong& setLightPositions(Containers::ArrayView<const Vector4> positions);
@@ -859,6 +1361,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * position. If updating more than one light, prefer the batch function
          * instead to reduce the count of GL API calls. Expects that @p id is
          * less than @ref lightCount().
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref PhongLightUniform::position and call @ref bindLightBuffer()
+         * instead.
          */
         Phong& setLightPosition(UnsignedInt id, const Vector4& position);
 
@@ -890,6 +1396,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          *
          * Initial values are @cpp 0xffffff_rgbf @ce. Expects that the size
          * of the @p colors array is the same as @ref lightCount().
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref PhongLightUniform::color and call @ref bindLightBuffer()
+         * instead.
          * @see @ref Shaders-Phong-lights, @ref setLightColor()
          */
         Phong& setLightColors(Containers::ArrayView<const Magnum::Color3> colors);
@@ -925,6 +1435,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * updating more than one light, prefer the batch function instead to
          * reduce the count of GL API calls. Expects that @p id is less than
          * @ref lightCount().
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref PhongLightUniform::color and call @ref bindLightBuffer()
+         * instead.
          */
         Phong& setLightColor(UnsignedInt id, const Magnum::Color3& color);
 
@@ -956,6 +1470,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * highlights on certain lights. Initial values are
          * @cpp 0xffffff_rgbf @ce. Expects that the size of the @p colors array
          * is the same as @ref lightCount().
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref PhongLightUniform::specularColor and call
+         * @ref bindLightBuffer() instead.
          * @see @ref Shaders-Phong-lights, @ref setLightColor()
          */
         Phong& setLightSpecularColors(Containers::ArrayView<const Magnum::Color3> colors);
@@ -975,6 +1493,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * color. If updating more than one light, prefer the batch function
          * instead to reduce the count of GL API calls. Expects that @p id is
          * less than @ref lightCount().
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref PhongLightUniform::specularColor and call
+         * @ref bindLightBuffer() instead.
          */
         Phong& setLightSpecularColor(UnsignedInt id, const Magnum::Color3& color);
 
@@ -985,6 +1507,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          *
          * Initial values are @ref Constants::inf(). Expects that the size of
          * the @p ranges array is the same as @ref lightCount().
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref PhongLightUniform::range and call @ref bindLightBuffer()
+         * instead.
          * @see @ref Shaders-Phong-lights, @ref setLightRange()
          */
         Phong& setLightRanges(Containers::ArrayView<const Float> ranges);
@@ -1004,9 +1530,169 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * updating more than one light, prefer the batch function instead to
          * reduce the count of GL API calls. Expects that @p id is less than
          * @ref lightCount().
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref PhongLightUniform::range and call @ref bindLightBuffer()
+         * instead.
          */
         Phong& setLightRange(UnsignedInt id, Float range);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set a draw offset
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Specifies which item in the @ref TransformationUniform3D,
+         * @ref PhongDrawUniform and @ref TextureTransformationUniform buffers
+         * should be used for current draw. Expects that
+         * @ref Flag::UniformBuffers is set and @p offset is less than
+         * @ref drawCount(). Initial value is @cpp 0 @ce. If
+         * @ref Flag::MultiDraw is set, the index of the mesh in a multi-draw
+         * is added to this value.
+         * @see @ref Shaders-Phong-ubo
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& setDrawOffset(UnsignedInt offset);
+
+        /**
+         * @brief Bind a projection uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain a single @ref ProjectionUniform3D.
+         * @see @ref Shaders-Phong-ubo
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindProjectionBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindProjectionBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a transformation uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref TransformationUniform3D.
+         * @see @ref Shaders-Phong-ubo
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindTransformationBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindTransformationBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a draw uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref PhongDrawUniform.
+         * @see @ref Shaders-Phong-ubo
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindDrawBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindDrawBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a texture transformation uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that both @ref Flag::UniformBuffers and
+         * @ref Flag::TextureTransformation is set. The buffer is expected to
+         * contain @ref drawCount() instances of
+         * @ref TextureTransformationUniform.
+         * @see @ref Shaders-Phong-ubo
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindTextureTransformationBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindTextureTransformationBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a material uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref materialCount() instances of
+         * @ref PhongMaterialUniform.
+         * @see @ref Shaders-Phong-ubo
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindMaterialBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindMaterialBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a light uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref lightCount() instances of
+         * @ref PhongLightUniform. If @ref lightCount() is zero, this function
+         * is a no-op, as lights don't contribute to the output in that
+         * case.
+         * @see @ref Shaders-Phong-ubo
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindLightBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindLightBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
+
     private:
         /* Prevent accidentally calling irrelevant functions */
         #ifndef MAGNUM_TARGET_GLES
@@ -1018,6 +1704,9 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
 
         Flags _flags;
         UnsignedInt _lightCount{};
+        #ifndef MAGNUM_TARGET_GLES2
+        UnsignedInt _materialCount{}, _drawCount{};
+        #endif
         Int _transformationMatrixUniform{0},
             _projectionMatrixUniform{1},
             _normalMatrixUniform{2},
@@ -1035,6 +1724,11 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
             _lightColorsUniform, /* 11 + lightCount, set in the constructor */
             _lightSpecularColorsUniform, /* 11 + 2*lightCount */
             _lightRangesUniform; /* 11 + 3*lightCount */
+        #ifndef MAGNUM_TARGET_GLES2
+        /* Used instead of all other uniforms when Flag::UniformBuffers is
+           set, so it can alias them */
+        Int _drawOffsetUniform{0};
+        #endif
 };
 
 /** @debugoperatorclassenum{Phong,Phong::Flag} */
@@ -27,11 +27,24 @@
 #extension GL_EXT_gpu_shader4: require
 #endif
 
+#if defined(UNIFORM_BUFFERS) && !defined(GL_ES) && __VERSION__ < 140
+#extension GL_ARB_uniform_buffer_object: require
+#endif
+
+#ifdef MULTI_DRAW
+#extension GL_ARB_shader_draw_parameters: require
+#endif
+
 #ifndef NEW_GLSL
 #define in attribute
 #define out varying
 #endif
 
+#ifndef RUNTIME_CONST
+#define const
+#endif
+
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 0)
 #endif
@@ -84,6 +97,92 @@ uniform highp vec4 lightPositions[LIGHT_COUNT]
     ;
 #endif
 
+#else
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+/* mediump is just 2^10, which might not be enough, this is 2^16 */
+uniform highp uint drawOffset; /* defaults to zero */
+
+#ifdef EXPLICIT_BINDING
+layout(std140, binding = 0)
+#else
+layout(std140)
+#endif
+uniform Projection {
+    highp mat4 projectionMatrix;
+};
+
+#ifdef EXPLICIT_BINDING
+layout(std140, binding = 1)
+#else
+layout(std140)
+#endif
+uniform Transformation {
+    highp mat4 transformationMatrices[DRAW_COUNT];
+};
+
+struct DrawUniform {
+    mediump mat3 normalMatrix; /* actually mat3x4 */
+    highp uint materialId;
+    highp uint objectId;
+    highp uint reserved1;
+    highp uint reserved2;
+};
+
+#ifdef EXPLICIT_BINDING
+layout(std140, binding = 2)
+#else
+layout(std140)
+#endif
+uniform Draw {
+    DrawUniform draws[DRAW_COUNT];
+};
+
+#ifdef TEXTURE_TRANSFORMATION
+struct TextureTransformationUniform {
+    highp vec4 rotationScaling;
+    highp vec2 offset;
+    highp vec2 reserved;
+};
+
+#ifdef EXPLICIT_BINDING
+layout(std140, binding = 3)
+#else
+layout(std140)
+#endif
+uniform TextureTransformation {
+    TextureTransformationUniform textureTransformations[DRAW_COUNT];
+};
+#endif
+
+#if LIGHT_COUNT
+/* Has to match the definition in Phong.frag */
+struct LightUniform {
+    highp vec4 position;
+    lowp vec3 color;
+    highp float range;
+    lowp vec3 specularColor;
+    lowp float reserved;
+};
+
+#ifdef EXPLICIT_BINDING
+layout(std140, binding = 5)
+#else
+layout(std140)
+#endif
+uniform Light {
+    LightUniform lights[LIGHT_COUNT];
+};
+#endif
+
+#ifdef MULTI_DRAW
+flat out highp uint drawId;
+#else
+#define drawId drawOffset
+#endif
+#endif
+
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
@@ -177,6 +276,22 @@ out highp vec3 cameraDirection;
 #endif
 
 void main() {
+    #ifdef UNIFORM_BUFFERS
+    #ifdef MULTI_DRAW
+    drawId = drawOffset + uint(gl_DrawIDARB);
+    #endif
+    highp const mat4 transformationMatrix = transformationMatrices[drawId];
+    #if LIGHT_COUNT
+    mediump const mat3 normalMatrix = draws[drawId].normalMatrix;
+    #endif
+    #ifdef TEXTURE_TRANSFORMATION
+    mediump const mat3 textureMatrix = mat3(
+        textureTransformations[drawId].rotationScaling.xy, 0.0,
+        textureTransformations[drawId].rotationScaling.zw, 0.0,
+        textureTransformations[drawId].offset, 1.0);
+    #endif
+    #endif
+
     /* Transformed vertex position */
     highp vec4 transformedPosition4 = transformationMatrix*
         #ifdef INSTANCED_TRANSFORMATION
@@ -215,8 +330,16 @@ void main() {
 
     /* Direction to the light. Directional lights have the last component set
        to 0, which gets used to ignore the transformed position. */
-    for(int i = 0; i < LIGHT_COUNT; ++i)
-        lightDirections[i] = vec4(lightPositions[i].xyz - transformedPosition*lightPositions[i].w, lightPositions[i].w);
+    for(int i = 0; i < LIGHT_COUNT; ++i) {
+        highp const vec4 lightPosition =
+            #ifndef UNIFORM_BUFFERS
+            lightPositions[i]
+            #else
+            lights[i].position
+            #endif
+            ;
+        lightDirections[i] = vec4(lightPosition.xyz - transformedPosition*lightPosition.w, lightPosition.w);
+    }
 
     /* Direction to the camera */
     cameraDirection = -transformedPosition;
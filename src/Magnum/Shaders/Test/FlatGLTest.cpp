@@ -35,9 +35,11 @@
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/DebugTools/CompareImage.h"
+#include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
 #include "Magnum/GL/Framebuffer.h"
 #include "Magnum/GL/Renderer.h"
 #include "Magnum/GL/Renderbuffer.h"
@@ -64,16 +66,27 @@ struct FlatGLTest: GL::OpenGLTester {
     explicit FlatGLTest();
 
     template<UnsignedInt dimensions> void construct();
+    #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void constructUniformBuffers();
+    #endif
 
     template<UnsignedInt dimensions> void constructMove();
 
     template<UnsignedInt dimensions> void constructTextureTransformationNotTextured();
+    #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void constructUniformBuffersZeroMaterials();
+    template<UnsignedInt dimensions> void constructUniformBuffersZeroDraws();
+    #endif
 
     template<UnsignedInt dimensions> void bindTextureNotEnabled();
     template<UnsignedInt dimensions> void setAlphaMaskNotEnabled();
     template<UnsignedInt dimensions> void setTextureMatrixNotEnabled();
     #ifndef MAGNUM_TARGET_GLES2
     template<UnsignedInt dimensions> void setObjectIdNotEnabled();
+    template<UnsignedInt dimensions> void setUniformUniformBuffersEnabled();
+    template<UnsignedInt dimensions> void bindBufferUniformBuffersNotEnabled();
+    template<UnsignedInt dimensions> void bindTextureTransformationBufferNotEnabled();
+    template<UnsignedInt dimensions> void setWrongDrawOffset();
     #endif
 
     void renderSetup();
@@ -81,6 +94,14 @@ struct FlatGLTest: GL::OpenGLTester {
 
     void renderDefaults2D();
     void renderDefaults3D();
+    #ifndef MAGNUM_TARGET_GLES2
+    void renderDefaultsUniformBuffers2D();
+    void renderDefaultsUniformBuffers3D();
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    void renderDefaultsMultiDraw2D();
+    void renderDefaultsMultiDraw3D();
+    #endif
     void renderColored2D();
     void renderColored3D();
     void renderSinglePixelTextured2D();
@@ -156,6 +177,34 @@ constexpr struct {
     {"instanced texture offset", Flat2D::Flag::Textured|Flat2D::Flag::InstancedTextureOffset}
 };
 
+#ifndef MAGNUM_TARGET_GLES2
+constexpr struct {
+    const char* name;
+    Flat2D::Flags flags;
+    UnsignedInt materialCount, drawCount;
+} ConstructUniformBuffersData[]{
+    {"", Flat2D::Flag::UniformBuffers, 1, 1},
+    /* Each block has to fit into the guaranteed minimum of 16 kB for
+       GL_MAX_UNIFORM_BLOCK_SIZE, which is plenty for these */
+    {"multiple materials, draws", Flat2D::Flag::UniformBuffers, 16, 48},
+    {"textured + texture transformation", Flat2D::Flag::UniformBuffers|Flat2D::Flag::Textured|Flat2D::Flag::TextureTransformation, 1, 1},
+    {"alpha mask", Flat2D::Flag::UniformBuffers|Flat2D::Flag::AlphaMask, 1, 1},
+    {"object ID", Flat2D::Flag::UniformBuffers|Flat2D::Flag::ObjectId, 1, 1},
+    {"instanced transformation + object ID", Flat2D::Flag::UniformBuffers|Flat2D::Flag::InstancedTransformation|Flat2D::Flag::InstancedObjectId, 1, 1},
+    #ifndef MAGNUM_TARGET_GLES
+    {"multidraw with all the things", Flat2D::Flag::MultiDraw|Flat2D::Flag::Textured|Flat2D::Flag::TextureTransformation|Flat2D::Flag::AlphaMask|Flat2D::Flag::ObjectId, 16, 48}
+    #endif
+};
+
+constexpr struct {
+    const char* name;
+    UnsignedInt drawCount, drawOffset;
+} RenderDefaultsUniformBuffersData[]{
+    {"", 1, 0},
+    {"draw offset", 2, 1}
+};
+#endif
+
 const struct {
     const char* name;
     Flat2D::Flags flags;
@@ -214,12 +263,25 @@ FlatGLTest::FlatGLTest() {
         &FlatGLTest::construct<3>},
         Containers::arraySize(ConstructData));
 
+    #ifndef MAGNUM_TARGET_GLES2
+    addInstancedTests<FlatGLTest>({
+        &FlatGLTest::constructUniformBuffers<2>,
+        &FlatGLTest::constructUniformBuffers<3>},
+        Containers::arraySize(ConstructUniformBuffersData));
+    #endif
+
     addTests<FlatGLTest>({
         &FlatGLTest::constructMove<2>,
         &FlatGLTest::constructMove<3>,
 
         &FlatGLTest::constructTextureTransformationNotTextured<2>,
         &FlatGLTest::constructTextureTransformationNotTextured<3>,
+        #ifndef MAGNUM_TARGET_GLES2
+        &FlatGLTest::constructUniformBuffersZeroMaterials<2>,
+        &FlatGLTest::constructUniformBuffersZeroMaterials<3>,
+        &FlatGLTest::constructUniformBuffersZeroDraws<2>,
+        &FlatGLTest::constructUniformBuffersZeroDraws<3>,
+        #endif
 
         &FlatGLTest::bindTextureNotEnabled<2>,
         &FlatGLTest::bindTextureNotEnabled<3>,
@@ -229,7 +291,15 @@ FlatGLTest::FlatGLTest() {
         &FlatGLTest::setTextureMatrixNotEnabled<3>,
         #ifndef MAGNUM_TARGET_GLES2
         &FlatGLTest::setObjectIdNotEnabled<2>,
-        &FlatGLTest::setObjectIdNotEnabled<3>
+        &FlatGLTest::setObjectIdNotEnabled<3>,
+        &FlatGLTest::setUniformUniformBuffersEnabled<2>,
+        &FlatGLTest::setUniformUniformBuffersEnabled<3>,
+        &FlatGLTest::bindBufferUniformBuffersNotEnabled<2>,
+        &FlatGLTest::bindBufferUniformBuffersNotEnabled<3>,
+        &FlatGLTest::bindTextureTransformationBufferNotEnabled<2>,
+        &FlatGLTest::bindTextureTransformationBufferNotEnabled<3>,
+        &FlatGLTest::setWrongDrawOffset<2>,
+        &FlatGLTest::setWrongDrawOffset<3>
         #endif
         });
 
@@ -242,6 +312,21 @@ FlatGLTest::FlatGLTest() {
         &FlatGLTest::renderSetup,
         &FlatGLTest::renderTeardown);
 
+    #ifndef MAGNUM_TARGET_GLES2
+    addInstancedTests({&FlatGLTest::renderDefaultsUniformBuffers2D,
+                       &FlatGLTest::renderDefaultsUniformBuffers3D},
+        Containers::arraySize(RenderDefaultsUniformBuffersData),
+        &FlatGLTest::renderSetup,
+        &FlatGLTest::renderTeardown);
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    addTests({&FlatGLTest::renderDefaultsMultiDraw2D,
+              &FlatGLTest::renderDefaultsMultiDraw3D},
+        &FlatGLTest::renderSetup,
+        &FlatGLTest::renderTeardown);
+    #endif
+
     addInstancedTests({&FlatGLTest::renderTextured2D,
                        &FlatGLTest::renderTextured3D},
         Containers::arraySize(RenderTexturedData),
@@ -322,6 +407,38 @@ template<UnsignedInt dimensions> void FlatGLTest::construct() {
     MAGNUM_VERIFY_NO_GL_ERROR();
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void FlatGLTest::constructUniformBuffers() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    auto&& data = ConstructUniformBuffersData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    if((data.flags & Flat2D::Flag::ObjectId) && !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() + std::string(" is not supported"));
+    if(data.flags >= Flat2D::Flag::MultiDraw && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shader_draw_parameters>())
+        CORRADE_SKIP(GL::Extensions::ARB::shader_draw_parameters::string() + std::string(" is not supported"));
+    #endif
+
+    Flat<dimensions> shader{data.flags, data.materialCount, data.drawCount};
+    CORRADE_COMPARE(shader.flags(), data.flags);
+    CORRADE_COMPARE(shader.materialCount(), data.materialCount);
+    CORRADE_COMPARE(shader.drawCount(), data.drawCount);
+    CORRADE_VERIFY(shader.id());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
 template<UnsignedInt dimensions> void FlatGLTest::constructMove() {
     setTestCaseTemplateName(std::to_string(dimensions));
 
@@ -357,6 +474,46 @@ template<UnsignedInt dimensions> void FlatGLTest::constructTextureTransformation
         "Shaders::Flat: texture transformation enabled but the shader is not textured\n");
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void FlatGLTest::constructUniformBuffersZeroMaterials() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Flat<dimensions>{Flat<dimensions>::Flag::UniformBuffers, 0, 1};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat: material count can't be zero\n");
+}
+
+template<UnsignedInt dimensions> void FlatGLTest::constructUniformBuffersZeroDraws() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Flat<dimensions>{Flat<dimensions>::Flag::UniformBuffers, 1, 0};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat: draw count can't be zero\n");
+}
+#endif
+
 template<UnsignedInt dimensions> void FlatGLTest::bindTextureNotEnabled() {
     setTestCaseTemplateName(std::to_string(dimensions));
 
@@ -429,6 +586,114 @@ template<UnsignedInt dimensions> void FlatGLTest::setObjectIdNotEnabled() {
 
 constexpr Vector2i RenderSize{80, 80};
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void FlatGLTest::setUniformUniformBuffersEnabled() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Flat<dimensions> shader{Flat<dimensions>::Flag::UniformBuffers};
+    shader.setTransformationProjectionMatrix({})
+        .setTextureMatrix({})
+        .setColor({})
+        .setAlphaMask({})
+        .setObjectId({});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat::setTransformationProjectionMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Flat::setTextureMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Flat::setColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Flat::setAlphaMask(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Flat::setObjectId(): the shader was created with uniform buffers enabled\n");
+}
+
+template<UnsignedInt dimensions> void FlatGLTest::bindBufferUniformBuffersNotEnabled() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer;
+    Flat<dimensions> shader;
+    shader.bindTransformationProjectionBuffer(buffer)
+          .bindTransformationProjectionBuffer(buffer, 0, 16)
+          .bindDrawBuffer(buffer)
+          .bindDrawBuffer(buffer, 0, 16)
+          .bindTextureTransformationBuffer(buffer)
+          .bindTextureTransformationBuffer(buffer, 0, 16)
+          .bindMaterialBuffer(buffer)
+          .bindMaterialBuffer(buffer, 0, 16)
+          .setDrawOffset(0);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindDrawBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindDrawBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::setDrawOffset(): the shader was not created with uniform buffers enabled\n");
+}
+
+template<UnsignedInt dimensions> void FlatGLTest::bindTextureTransformationBufferNotEnabled() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer{GL::Buffer::TargetHint::Uniform};
+    Flat<dimensions> shader{Flat<dimensions>::Flag::UniformBuffers};
+    shader.bindTextureTransformationBuffer(buffer)
+          .bindTextureTransformationBuffer(buffer, 0, 16);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled\n"
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled\n");
+}
+
+template<UnsignedInt dimensions> void FlatGLTest::setWrongDrawOffset() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Flat<dimensions>{Flat<dimensions>::Flag::UniformBuffers, 2, 5}
+        .setDrawOffset(5);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat::setDrawOffset(): draw offset 5 is out of bounds for 5 draws\n");
+}
+#endif
+
 void FlatGLTest::renderSetup() {
     /* Pick a color that's directly representable on RGBA4 as well to reduce
        artifacts */
@@ -494,6 +759,215 @@ void FlatGLTest::renderDefaults3D() {
         (DebugTools::CompareImageToFile{_manager, 238.0f, 0.2975f}));
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void FlatGLTest::renderDefaultsUniformBuffers2D() {
+    auto&& data = RenderDefaultsUniformBuffersData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    GL::Mesh circle = MeshTools::compile(Primitives::circle2DSolid(32));
+
+    /* Draws before the offset move the mesh out of the view, so if the offset
+       isn't taken into account, the output will be empty */
+    TransformationProjectionUniform2D transformationProjections[2];
+    for(UnsignedInt i = 0; i != data.drawOffset; ++i)
+        transformationProjections[i].setTransformationProjectionMatrix(Matrix3::translation(Vector2::xAxis(10.0f)));
+    FlatDrawUniform draws[2];
+
+    GL::Buffer transformationProjectionUniform{GL::Buffer::TargetHint::Uniform,
+        Containers::arrayView(transformationProjections, data.drawCount)};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform,
+        Containers::arrayView(draws, data.drawCount)};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        FlatMaterialUniform{}
+    }};
+
+    Flat2D{Flat2D::Flag::UniformBuffers, 1, data.drawCount}
+        .bindTransformationProjectionBuffer(transformationProjectionUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .setDrawOffset(data.drawOffset)
+        .draw(circle);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Directory::join(_testDir, "FlatTestFiles/defaults.tga"),
+        /* SwiftShader has 8 different pixels on the edges */
+        (DebugTools::CompareImageToFile{_manager, 238.0f, 0.2975f}));
+}
+
+void FlatGLTest::renderDefaultsUniformBuffers3D() {
+    auto&& data = RenderDefaultsUniformBuffersData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    GL::Mesh sphere = MeshTools::compile(Primitives::uvSphereSolid(16, 32));
+
+    /* Draws before the offset move the mesh out of the view, so if the offset
+       isn't taken into account, the output will be empty */
+    TransformationProjectionUniform3D transformationProjections[2];
+    for(UnsignedInt i = 0; i != data.drawOffset; ++i)
+        transformationProjections[i].setTransformationProjectionMatrix(Matrix4::translation(Vector3::xAxis(10.0f)));
+    FlatDrawUniform draws[2];
+
+    GL::Buffer transformationProjectionUniform{GL::Buffer::TargetHint::Uniform,
+        Containers::arrayView(transformationProjections, data.drawCount)};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform,
+        Containers::arrayView(draws, data.drawCount)};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        FlatMaterialUniform{}
+    }};
+
+    Flat3D{Flat3D::Flag::UniformBuffers, 1, data.drawCount}
+        .bindTransformationProjectionBuffer(transformationProjectionUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .setDrawOffset(data.drawOffset)
+        .draw(sphere);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Directory::join(_testDir, "FlatTestFiles/defaults.tga"),
+        /* SwiftShader has 8 different pixels on the edges */
+        (DebugTools::CompareImageToFile{_manager, 238.0f, 0.2975f}));
+}
+
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+void FlatGLTest::renderDefaultsMultiDraw2D() {
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shader_draw_parameters>())
+        CORRADE_SKIP(GL::Extensions::ARB::shader_draw_parameters::string() + std::string(" is not supported"));
+
+    GL::Mesh circle = MeshTools::compile(Primitives::circle2DSolid(32));
+
+    /* Two views of the same mesh submitted in a single multi-draw call. The
+       first one is moved out of the view by its per-draw transformation, so
+       if gl_DrawID isn't taken into account, the output will be empty. The
+       second one references the last material slot, which differs from both
+       the draw index and the default ID, so the output is only correct if
+       the material is looked up through the per-draw material ID. */
+    GL::MeshView first{circle};
+    first.setCount(circle.count());
+    GL::MeshView second{circle};
+    second.setCount(circle.count());
+
+    GL::Buffer transformationProjectionUniform{GL::Buffer::TargetHint::Uniform, {
+        TransformationProjectionUniform2D{}
+            .setTransformationProjectionMatrix(Matrix3::translation(Vector2::xAxis(10.0f))),
+        TransformationProjectionUniform2D{}
+    }};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+        FlatDrawUniform{},
+        FlatDrawUniform{}
+            .setMaterialId(2)
+    }};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        FlatMaterialUniform{}
+            .setColor(0xff0000_rgbf),
+        FlatMaterialUniform{}
+            .setColor(0x00ff00_rgbf),
+        FlatMaterialUniform{}
+    }};
+
+    Flat2D{Flat2D::Flag::MultiDraw, 3, 2}
+        .bindTransformationProjectionBuffer(transformationProjectionUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .draw({first, second});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Directory::join(_testDir, "FlatTestFiles/defaults.tga"),
+        /* SwiftShader has 8 different pixels on the edges */
+        (DebugTools::CompareImageToFile{_manager, 238.0f, 0.2975f}));
+}
+
+void FlatGLTest::renderDefaultsMultiDraw3D() {
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shader_draw_parameters>())
+        CORRADE_SKIP(GL::Extensions::ARB::shader_draw_parameters::string() + std::string(" is not supported"));
+
+    GL::Mesh sphere = MeshTools::compile(Primitives::uvSphereSolid(16, 32));
+
+    /* See renderDefaultsMultiDraw2D() for details */
+    GL::MeshView first{sphere};
+    first.setCount(sphere.count());
+    GL::MeshView second{sphere};
+    second.setCount(sphere.count());
+
+    GL::Buffer transformationProjectionUniform{GL::Buffer::TargetHint::Uniform, {
+        TransformationProjectionUniform3D{}
+            .setTransformationProjectionMatrix(Matrix4::translation(Vector3::xAxis(10.0f))),
+        TransformationProjectionUniform3D{}
+    }};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+        FlatDrawUniform{},
+        FlatDrawUniform{}
+            .setMaterialId(2)
+    }};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        FlatMaterialUniform{}
+            .setColor(0xff0000_rgbf),
+        FlatMaterialUniform{}
+            .setColor(0x00ff00_rgbf),
+        FlatMaterialUniform{}
+    }};
+
+    Flat3D{Flat3D::Flag::MultiDraw, 3, 2}
+        .bindTransformationProjectionBuffer(transformationProjectionUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .draw({first, second});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Directory::join(_testDir, "FlatTestFiles/defaults.tga"),
+        /* SwiftShader has 8 different pixels on the edges */
+        (DebugTools::CompareImageToFile{_manager, 238.0f, 0.2975f}));
+}
+
+#endif
+
 void FlatGLTest::renderColored2D() {
     GL::Mesh circle = MeshTools::compile(Primitives::circle2DSolid(32));
 
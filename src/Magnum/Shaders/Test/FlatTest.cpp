@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <new>
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -31,9 +32,22 @@
 
 namespace Magnum { namespace Shaders { namespace Test { namespace {
 
+using namespace Math::Literals;
+
 struct FlatTest: TestSuite::Tester {
     explicit FlatTest();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    template<class T> void uniformSizeAlignment();
+
+    void drawUniformConstructDefault();
+    void drawUniformConstructNoInit();
+    void drawUniformSetters();
+    void materialUniformConstructDefault();
+    void materialUniformConstructNoInit();
+    void materialUniformSetters();
+    #endif
+
     template<UnsignedInt dimensions> void constructNoCreate();
     template<UnsignedInt dimensions> void constructCopy();
 
@@ -43,17 +57,128 @@ struct FlatTest: TestSuite::Tester {
 };
 
 FlatTest::FlatTest() {
-    addTests({&FlatTest::constructNoCreate<2>,
-              &FlatTest::constructNoCreate<3>,
+    addTests({
+        #ifndef MAGNUM_TARGET_GLES2
+        &FlatTest::uniformSizeAlignment<FlatDrawUniform>,
+        &FlatTest::uniformSizeAlignment<FlatMaterialUniform>,
+
+        &FlatTest::drawUniformConstructDefault,
+        &FlatTest::drawUniformConstructNoInit,
+        &FlatTest::drawUniformSetters,
+        &FlatTest::materialUniformConstructDefault,
+        &FlatTest::materialUniformConstructNoInit,
+        &FlatTest::materialUniformSetters,
+        #endif
+
+        &FlatTest::constructNoCreate<2>,
+        &FlatTest::constructNoCreate<3>,
+
+        &FlatTest::constructCopy<2>,
+        &FlatTest::constructCopy<3>,
+
+        &FlatTest::debugFlag,
+        &FlatTest::debugFlags,
+        &FlatTest::debugFlagsSupersets});
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+template<class> struct UniformTraits;
+template<> struct UniformTraits<FlatDrawUniform> {
+    static const char* name() { return "FlatDrawUniform"; }
+};
+template<> struct UniformTraits<FlatMaterialUniform> {
+    static const char* name() { return "FlatMaterialUniform"; }
+};
+
+template<class T> void FlatTest::uniformSizeAlignment() {
+    setTestCaseTemplateName(UniformTraits<T>::name());
+
+    /* The structures are put into arrays in the uniform buffers, which in
+       the std140 layout means each item has to be a multiple of 16 bytes */
+    CORRADE_COMPARE(sizeof(T) % sizeof(Vector4), 0);
+}
+
+void FlatTest::drawUniformConstructDefault() {
+    FlatDrawUniform a;
+    CORRADE_COMPARE(a.materialId, 0);
+    CORRADE_COMPARE(a.objectId, 0);
+
+    constexpr FlatDrawUniform ca;
+    CORRADE_COMPARE(ca.materialId, 0);
+    CORRADE_COMPARE(ca.objectId, 0);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<FlatDrawUniform>::value);
+}
+
+void FlatTest::drawUniformConstructNoInit() {
+    FlatDrawUniform a;
+    a.materialId = 5;
+    a.objectId = 7;
+
+    new(&a) FlatDrawUniform{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.materialId, 5);
+        CORRADE_COMPARE(a.objectId, 7);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<FlatDrawUniform, NoInitT>::value);
 
-              &FlatTest::constructCopy<2>,
-              &FlatTest::constructCopy<3>,
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, FlatDrawUniform>::value);
+}
+
+void FlatTest::drawUniformSetters() {
+    FlatDrawUniform a;
+    a.setMaterialId(5)
+        .setObjectId(7);
+    CORRADE_COMPARE(a.materialId, 5);
+    CORRADE_COMPARE(a.objectId, 7);
+}
+
+void FlatTest::materialUniformConstructDefault() {
+    FlatMaterialUniform a;
+    CORRADE_COMPARE(a.color, 0xffffffff_rgbaf);
+    CORRADE_COMPARE(a.alphaMask, 0.5f);
+
+    constexpr FlatMaterialUniform ca;
+    CORRADE_COMPARE(ca.color, 0xffffffff_rgbaf);
+    CORRADE_COMPARE(ca.alphaMask, 0.5f);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<FlatMaterialUniform>::value);
+}
+
+void FlatTest::materialUniformConstructNoInit() {
+    FlatMaterialUniform a;
+    a.color = 0x354565fc_rgbaf;
+    a.alphaMask = 0.7f;
+
+    new(&a) FlatMaterialUniform{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.color, 0x354565fc_rgbaf);
+        CORRADE_COMPARE(a.alphaMask, 0.7f);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<FlatMaterialUniform, NoInitT>::value);
 
-              &FlatTest::debugFlag,
-              &FlatTest::debugFlags,
-              &FlatTest::debugFlagsSupersets});
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, FlatMaterialUniform>::value);
 }
 
+void FlatTest::materialUniformSetters() {
+    FlatMaterialUniform a;
+    a.setColor(0x354565fc_rgbaf)
+        .setAlphaMask(0.7f);
+    CORRADE_COMPARE(a.color, 0x354565fc_rgbaf);
+    CORRADE_COMPARE(a.alphaMask, 0.7f);
+}
+#endif
+
 template<UnsignedInt dimensions> void FlatTest::constructNoCreate() {
     setTestCaseTemplateName(std::to_string(dimensions));
 
@@ -98,6 +223,16 @@ void FlatTest::debugFlagsSupersets() {
     }
     #endif
 
+    #ifndef MAGNUM_TARGET_GLES
+    /* MultiDraw is a superset of UniformBuffers so only one should be
+       printed */
+    {
+        std::ostringstream out;
+        Debug{&out} << (Flat3D::Flag::MultiDraw|Flat3D::Flag::UniformBuffers);
+        CORRADE_COMPARE(out.str(), "Shaders::Flat::Flag::MultiDraw\n");
+    }
+    #endif
+
     /* InstancedTextureOffset is a superset of TextureTransformation so only
        one should be printed */
     std::ostringstream out;
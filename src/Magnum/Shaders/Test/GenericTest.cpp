@@ -23,14 +23,18 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <new>
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/Math/Angle.h"
 #include "Magnum/Shaders/Generic.h"
 /* Yes, really */
 #include "Magnum/Shaders/generic.glsl"
 
 namespace Magnum { namespace Shaders { namespace Test { namespace {
 
+using namespace Math::Literals;
+
 struct GenericTest: TestSuite::Tester {
     explicit GenericTest();
 
@@ -40,6 +44,30 @@ struct GenericTest: TestSuite::Tester {
     void tbnContiguous();
     void tbnBothNormalAndQuaternion();
     void textureTransformContiguous();
+
+    #ifndef MAGNUM_TARGET_GLES2
+    void uniformSizeAlignment();
+
+    void projectionUniform3DConstructDefault();
+    void projectionUniform3DConstructNoInit();
+    void projectionUniform3DSetters();
+
+    void transformationUniform3DConstructDefault();
+    void transformationUniform3DConstructNoInit();
+    void transformationUniform3DSetters();
+
+    void transformationProjectionUniform2DConstructDefault();
+    void transformationProjectionUniform2DConstructNoInit();
+    void transformationProjectionUniform2DSetters();
+
+    void transformationProjectionUniform3DConstructDefault();
+    void transformationProjectionUniform3DConstructNoInit();
+    void transformationProjectionUniform3DSetters();
+
+    void textureTransformationUniformConstructDefault();
+    void textureTransformationUniformConstructNoInit();
+    void textureTransformationUniformSetters();
+    #endif
 };
 
 GenericTest::GenericTest() {
@@ -48,7 +76,32 @@ GenericTest::GenericTest() {
 
               &GenericTest::tbnContiguous,
               &GenericTest::tbnBothNormalAndQuaternion,
-              &GenericTest::textureTransformContiguous});
+              &GenericTest::textureTransformContiguous,
+
+              #ifndef MAGNUM_TARGET_GLES2
+              &GenericTest::uniformSizeAlignment,
+
+              &GenericTest::projectionUniform3DConstructDefault,
+              &GenericTest::projectionUniform3DConstructNoInit,
+              &GenericTest::projectionUniform3DSetters,
+
+              &GenericTest::transformationUniform3DConstructDefault,
+              &GenericTest::transformationUniform3DConstructNoInit,
+              &GenericTest::transformationUniform3DSetters,
+
+              &GenericTest::transformationProjectionUniform2DConstructDefault,
+              &GenericTest::transformationProjectionUniform2DConstructNoInit,
+              &GenericTest::transformationProjectionUniform2DSetters,
+
+              &GenericTest::transformationProjectionUniform3DConstructDefault,
+              &GenericTest::transformationProjectionUniform3DConstructNoInit,
+              &GenericTest::transformationProjectionUniform3DSetters,
+
+              &GenericTest::textureTransformationUniformConstructDefault,
+              &GenericTest::textureTransformationUniformConstructNoInit,
+              &GenericTest::textureTransformationUniformSetters
+              #endif
+              });
 }
 
 void GenericTest::glslMatch() {
@@ -111,6 +164,212 @@ void GenericTest::textureTransformContiguous() {
     //CORRADE_COMPARE(Generic3D::TextureOffset::Location, Generic3D::TextureMatrix::Location + 2);
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void GenericTest::uniformSizeAlignment() {
+    /* The structures are put into arrays in the uniform buffers, which in
+       the std140 layout means each item has to be aligned to 16 bytes */
+    CORRADE_COMPARE(sizeof(ProjectionUniform3D), 64);
+    CORRADE_COMPARE(sizeof(TransformationUniform3D), 64);
+    CORRADE_COMPARE(sizeof(TransformationProjectionUniform2D), 48);
+    CORRADE_COMPARE(sizeof(TransformationProjectionUniform3D), 64);
+    CORRADE_COMPARE(sizeof(TextureTransformationUniform), 32);
+
+    CORRADE_COMPARE(alignof(ProjectionUniform3D), 4);
+    CORRADE_COMPARE(alignof(TransformationUniform3D), 4);
+    CORRADE_COMPARE(alignof(TransformationProjectionUniform2D), 4);
+    CORRADE_COMPARE(alignof(TransformationProjectionUniform3D), 4);
+    CORRADE_COMPARE(alignof(TextureTransformationUniform), 4);
+}
+
+void GenericTest::projectionUniform3DConstructDefault() {
+    ProjectionUniform3D a;
+    CORRADE_COMPARE(a.projectionMatrix, Matrix4{Math::IdentityInit});
+
+    constexpr ProjectionUniform3D ca;
+    CORRADE_COMPARE(ca.projectionMatrix, Matrix4{Math::IdentityInit});
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<ProjectionUniform3D>::value);
+}
+
+void GenericTest::projectionUniform3DConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    ProjectionUniform3D a;
+    a.projectionMatrix[2] = {1.5f, 0.3f, 3.1f, 0.5f};
+
+    new(&a) ProjectionUniform3D{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.projectionMatrix[2], (Vector4{1.5f, 0.3f, 3.1f, 0.5f}));
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<ProjectionUniform3D, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, ProjectionUniform3D>::value);
+}
+
+void GenericTest::projectionUniform3DSetters() {
+    ProjectionUniform3D a;
+    a.setProjectionMatrix(Matrix4::perspectiveProjection(35.0_degf, 1.5f, 0.1f, 100.0f));
+    CORRADE_COMPARE(a.projectionMatrix, Matrix4::perspectiveProjection(35.0_degf, 1.5f, 0.1f, 100.0f));
+}
+
+void GenericTest::transformationUniform3DConstructDefault() {
+    TransformationUniform3D a;
+    CORRADE_COMPARE(a.transformationMatrix, Matrix4{Math::IdentityInit});
+
+    constexpr TransformationUniform3D ca;
+    CORRADE_COMPARE(ca.transformationMatrix, Matrix4{Math::IdentityInit});
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<TransformationUniform3D>::value);
+}
+
+void GenericTest::transformationUniform3DConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    TransformationUniform3D a;
+    a.transformationMatrix[2] = {1.5f, 0.3f, 3.1f, 0.5f};
+
+    new(&a) TransformationUniform3D{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.transformationMatrix[2], (Vector4{1.5f, 0.3f, 3.1f, 0.5f}));
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<TransformationUniform3D, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, TransformationUniform3D>::value);
+}
+
+void GenericTest::transformationUniform3DSetters() {
+    TransformationUniform3D a;
+    a.setTransformationMatrix(Matrix4::translation({1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(a.transformationMatrix, Matrix4::translation({1.0f, 2.0f, 3.0f}));
+}
+
+void GenericTest::transformationProjectionUniform2DConstructDefault() {
+    TransformationProjectionUniform2D a;
+    CORRADE_COMPARE(a.transformationProjectionMatrix, (Matrix3x4{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}}));
+
+    constexpr TransformationProjectionUniform2D ca;
+    CORRADE_COMPARE(ca.transformationProjectionMatrix, (Matrix3x4{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}}));
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<TransformationProjectionUniform2D>::value);
+}
+
+void GenericTest::transformationProjectionUniform2DConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    TransformationProjectionUniform2D a;
+    a.transformationProjectionMatrix[2] = {1.5f, 0.3f, 3.1f, 0.5f};
+
+    new(&a) TransformationProjectionUniform2D{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.transformationProjectionMatrix[2], (Vector4{1.5f, 0.3f, 3.1f, 0.5f}));
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<TransformationProjectionUniform2D, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, TransformationProjectionUniform2D>::value);
+}
+
+void GenericTest::transformationProjectionUniform2DSetters() {
+    TransformationProjectionUniform2D a;
+    a.setTransformationProjectionMatrix(Matrix3::translation({1.0f, 2.0f})*Matrix3::scaling({3.0f, 4.0f}));
+    /* The bottom row is padding */
+    CORRADE_COMPARE(a.transformationProjectionMatrix, (Matrix3x4{
+        Vector4{3.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 4.0f, 0.0f, 0.0f},
+        Vector4{1.0f, 2.0f, 1.0f, 0.0f}}));
+}
+
+void GenericTest::transformationProjectionUniform3DConstructDefault() {
+    TransformationProjectionUniform3D a;
+    CORRADE_COMPARE(a.transformationProjectionMatrix, Matrix4{Math::IdentityInit});
+
+    constexpr TransformationProjectionUniform3D ca;
+    CORRADE_COMPARE(ca.transformationProjectionMatrix, Matrix4{Math::IdentityInit});
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<TransformationProjectionUniform3D>::value);
+}
+
+void GenericTest::transformationProjectionUniform3DConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    TransformationProjectionUniform3D a;
+    a.transformationProjectionMatrix[2] = {1.5f, 0.3f, 3.1f, 0.5f};
+
+    new(&a) TransformationProjectionUniform3D{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.transformationProjectionMatrix[2], (Vector4{1.5f, 0.3f, 3.1f, 0.5f}));
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<TransformationProjectionUniform3D, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, TransformationProjectionUniform3D>::value);
+}
+
+void GenericTest::transformationProjectionUniform3DSetters() {
+    TransformationProjectionUniform3D a;
+    a.setTransformationProjectionMatrix(Matrix4::translation({1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(a.transformationProjectionMatrix, Matrix4::translation({1.0f, 2.0f, 3.0f}));
+}
+
+void GenericTest::textureTransformationUniformConstructDefault() {
+    TextureTransformationUniform a;
+    CORRADE_COMPARE(a.rotationScaling, (Vector4{1.0f, 0.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(a.offset, (Vector2{0.0f, 0.0f}));
+
+    constexpr TextureTransformationUniform ca;
+    CORRADE_COMPARE(ca.rotationScaling, (Vector4{1.0f, 0.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(ca.offset, (Vector2{0.0f, 0.0f}));
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<TextureTransformationUniform>::value);
+}
+
+void GenericTest::textureTransformationUniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    TextureTransformationUniform a;
+    a.offset = {1.5f, 0.3f};
+
+    new(&a) TextureTransformationUniform{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.offset, (Vector2{1.5f, 0.3f}));
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<TextureTransformationUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, TextureTransformationUniform>::value);
+}
+
+void GenericTest::textureTransformationUniformSetters() {
+    TextureTransformationUniform a;
+    a.setTextureMatrix(Matrix3::translation({1.5f, -0.5f})*Matrix3::scaling({2.0f, 3.0f}));
+    CORRADE_COMPARE(a.rotationScaling, (Vector4{2.0f, 0.0f, 0.0f, 3.0f}));
+    CORRADE_COMPARE(a.offset, (Vector2{1.5f, -0.5f}));
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::GenericTest)
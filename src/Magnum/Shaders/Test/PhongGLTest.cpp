@@ -35,10 +35,12 @@
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/DebugTools/CompareImage.h"
+#include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Framebuffer.h"
 #include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
 #include "Magnum/GL/OpenGLTester.h"
 #include "Magnum/GL/Renderer.h"
 #include "Magnum/GL/Renderbuffer.h"
@@ -64,10 +66,17 @@ struct PhongGLTest: GL::OpenGLTester {
     explicit PhongGLTest();
 
     void construct();
+    #ifndef MAGNUM_TARGET_GLES2
+    void constructUniformBuffers();
+    #endif
 
     void constructMove();
 
     void constructTextureTransformationNotTextured();
+    #ifndef MAGNUM_TARGET_GLES2
+    void constructUniformBuffersZeroMaterials();
+    void constructUniformBuffersZeroDraws();
+    #endif
 
     void bindTexturesNotEnabled();
     void setAlphaMaskNotEnabled();
@@ -77,34 +86,46 @@ struct PhongGLTest: GL::OpenGLTester {
     #endif
     void setWrongLightCount();
     void setWrongLightId();
+    #ifndef MAGNUM_TARGET_GLES2
+    void setUniformUniformBuffersEnabled();
+    void bindBufferUniformBuffersNotEnabled();
+    void bindTextureTransformationBufferNotEnabled();
+    void setWrongDrawOffset();
+    #endif
 
     void renderSetup();
     void renderTeardown();
 
     void renderDefaults();
-    void renderColored();
+    #ifndef MAGNUM_TARGET_GLES2
+    void renderDefaultsUniformBuffers();
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    void renderDefaultsMultiDraw();
+    #endif
+    template<Phong::Flag flag = Phong::Flag{}> void renderColored();
     void renderSinglePixelTextured();
 
-    void renderTextured();
+    template<Phong::Flag flag = Phong::Flag{}> void renderTextured();
     void renderTexturedNormal();
 
     template<class T> void renderVertexColor();
 
-    void renderShininess();
+    template<Phong::Flag flag = Phong::Flag{}> void renderShininess();
 
     void renderAlphaSetup();
     void renderAlphaTeardown();
 
-    void renderAlpha();
+    template<Phong::Flag flag = Phong::Flag{}> void renderAlpha();
 
     #ifndef MAGNUM_TARGET_GLES2
     void renderObjectIdSetup();
     void renderObjectIdTeardown();
 
-    void renderObjectId();
+    template<Phong::Flag flag = Phong::Flag{}> void renderObjectId();
     #endif
 
-    void renderLights();
+    template<Phong::Flag flag = Phong::Flag{}> void renderLights();
     void renderLightsSetOneByOne();
     void renderLowLightAngle();
     void renderZeroLights();
@@ -171,6 +192,35 @@ constexpr struct {
     {"instanced normal texture offset", Phong::Flag::NormalTexture|Phong::Flag::InstancedTextureOffset, 3}
 };
 
+#ifndef MAGNUM_TARGET_GLES2
+constexpr struct {
+    const char* name;
+    Phong::Flags flags;
+    UnsignedInt lightCount, materialCount, drawCount;
+} ConstructUniformBuffersData[]{
+    {"", Phong::Flag::UniformBuffers, 1, 1, 1},
+    /* Each block has to fit into the guaranteed minimum of 16 kB for
+       GL_MAX_UNIFORM_BLOCK_SIZE, which is plenty for these */
+    {"multiple lights, materials, draws", Phong::Flag::UniformBuffers, 8, 8, 24},
+    {"zero lights", Phong::Flag::UniformBuffers, 0, 16, 24},
+    {"ambient + diffuse + specular + normal texture + texture transformation", Phong::Flag::UniformBuffers|Phong::Flag::AmbientTexture|Phong::Flag::DiffuseTexture|Phong::Flag::SpecularTexture|Phong::Flag::NormalTexture|Phong::Flag::TextureTransformation, 1, 1, 1},
+    {"alpha mask", Phong::Flag::UniformBuffers|Phong::Flag::AlphaMask, 1, 1, 1},
+    {"object ID", Phong::Flag::UniformBuffers|Phong::Flag::ObjectId, 1, 1, 1},
+    {"instanced transformation + object ID", Phong::Flag::UniformBuffers|Phong::Flag::InstancedTransformation|Phong::Flag::InstancedObjectId, 1, 1, 1},
+    #ifndef MAGNUM_TARGET_GLES
+    {"multidraw with all the things", Phong::Flag::MultiDraw|Phong::Flag::DiffuseTexture|Phong::Flag::NormalTexture|Phong::Flag::TextureTransformation|Phong::Flag::AlphaMask|Phong::Flag::ObjectId, 8, 8, 24}
+    #endif
+};
+
+constexpr struct {
+    const char* name;
+    UnsignedInt drawCount, drawOffset;
+} RenderDefaultsUniformBuffersData[]{
+    {"", 1, 0},
+    {"draw offset", 2, 1}
+};
+#endif
+
 using namespace Math::Literals;
 
 const struct {
@@ -485,9 +535,17 @@ constexpr struct {
 PhongGLTest::PhongGLTest() {
     addInstancedTests({&PhongGLTest::construct}, Containers::arraySize(ConstructData));
 
+    #ifndef MAGNUM_TARGET_GLES2
+    addInstancedTests({&PhongGLTest::constructUniformBuffers}, Containers::arraySize(ConstructUniformBuffersData));
+    #endif
+
     addTests({&PhongGLTest::constructMove,
 
               &PhongGLTest::constructTextureTransformationNotTextured,
+              #ifndef MAGNUM_TARGET_GLES2
+              &PhongGLTest::constructUniformBuffersZeroMaterials,
+              &PhongGLTest::constructUniformBuffersZeroDraws,
+              #endif
 
               &PhongGLTest::bindTexturesNotEnabled,
               &PhongGLTest::setAlphaMaskNotEnabled,
@@ -496,13 +554,38 @@ PhongGLTest::PhongGLTest() {
               &PhongGLTest::setObjectIdNotEnabled,
               #endif
               &PhongGLTest::setWrongLightCount,
-              &PhongGLTest::setWrongLightId});
+              &PhongGLTest::setWrongLightId,
+              #ifndef MAGNUM_TARGET_GLES2
+              &PhongGLTest::setUniformUniformBuffersEnabled,
+              &PhongGLTest::bindBufferUniformBuffersNotEnabled,
+              &PhongGLTest::bindTextureTransformationBufferNotEnabled,
+              &PhongGLTest::setWrongDrawOffset
+              #endif
+              });
 
     addTests({&PhongGLTest::renderDefaults},
         &PhongGLTest::renderSetup,
         &PhongGLTest::renderTeardown);
 
-    addInstancedTests({&PhongGLTest::renderColored},
+    #ifndef MAGNUM_TARGET_GLES2
+    addInstancedTests({&PhongGLTest::renderDefaultsUniformBuffers},
+        Containers::arraySize(RenderDefaultsUniformBuffersData),
+        &PhongGLTest::renderSetup,
+        &PhongGLTest::renderTeardown);
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    addTests({&PhongGLTest::renderDefaultsMultiDraw},
+        &PhongGLTest::renderSetup,
+        &PhongGLTest::renderTeardown);
+    #endif
+
+    addInstancedTests<PhongGLTest>({
+        &PhongGLTest::renderColored,
+        #ifndef MAGNUM_TARGET_GLES2
+        &PhongGLTest::renderColored<Phong::Flag::UniformBuffers>
+        #endif
+        },
         Containers::arraySize(RenderColoredData),
         &PhongGLTest::renderSetup,
         &PhongGLTest::renderTeardown);
@@ -512,7 +595,12 @@ PhongGLTest::PhongGLTest() {
         &PhongGLTest::renderSetup,
         &PhongGLTest::renderTeardown);
 
-    addInstancedTests({&PhongGLTest::renderTextured},
+    addInstancedTests<PhongGLTest>({
+        &PhongGLTest::renderTextured,
+        #ifndef MAGNUM_TARGET_GLES2
+        &PhongGLTest::renderTextured<Phong::Flag::UniformBuffers>
+        #endif
+        },
         Containers::arraySize(RenderTexturedData),
         &PhongGLTest::renderSetup,
         &PhongGLTest::renderTeardown);
@@ -527,24 +615,41 @@ PhongGLTest::PhongGLTest() {
         &PhongGLTest::renderSetup,
         &PhongGLTest::renderTeardown);
 
-    addInstancedTests({&PhongGLTest::renderShininess},
+    addInstancedTests<PhongGLTest>({
+        &PhongGLTest::renderShininess,
+        #ifndef MAGNUM_TARGET_GLES2
+        &PhongGLTest::renderShininess<Phong::Flag::UniformBuffers>
+        #endif
+        },
         Containers::arraySize(RenderShininessData),
         &PhongGLTest::renderSetup,
         &PhongGLTest::renderTeardown);
 
-    addInstancedTests({&PhongGLTest::renderAlpha},
+    addInstancedTests<PhongGLTest>({
+        &PhongGLTest::renderAlpha,
+        #ifndef MAGNUM_TARGET_GLES2
+        &PhongGLTest::renderAlpha<Phong::Flag::UniformBuffers>
+        #endif
+        },
         Containers::arraySize(RenderAlphaData),
         &PhongGLTest::renderAlphaSetup,
         &PhongGLTest::renderAlphaTeardown);
 
     #ifndef MAGNUM_TARGET_GLES2
-    addInstancedTests({&PhongGLTest::renderObjectId},
+    addInstancedTests<PhongGLTest>({
+        &PhongGLTest::renderObjectId,
+        &PhongGLTest::renderObjectId<Phong::Flag::UniformBuffers>},
         Containers::arraySize(RenderObjectIdData),
         &PhongGLTest::renderObjectIdSetup,
         &PhongGLTest::renderObjectIdTeardown);
     #endif
 
-    addInstancedTests({&PhongGLTest::renderLights},
+    addInstancedTests<PhongGLTest>({
+        &PhongGLTest::renderLights,
+        #ifndef MAGNUM_TARGET_GLES2
+        &PhongGLTest::renderLights<Phong::Flag::UniformBuffers>
+        #endif
+        },
         Containers::arraySize(RenderLightsData),
         &PhongGLTest::renderSetup,
         &PhongGLTest::renderTeardown);
@@ -616,6 +721,37 @@ void PhongGLTest::construct() {
     MAGNUM_VERIFY_NO_GL_ERROR();
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::constructUniformBuffers() {
+    auto&& data = ConstructUniformBuffersData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    if((data.flags & Phong::Flag::ObjectId) && !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() + std::string(" is not supported"));
+    if(data.flags >= Phong::Flag::MultiDraw && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shader_draw_parameters>())
+        CORRADE_SKIP(GL::Extensions::ARB::shader_draw_parameters::string() + std::string(" is not supported"));
+    #endif
+
+    Phong shader{data.flags, data.lightCount, data.materialCount, data.drawCount};
+    CORRADE_COMPARE(shader.flags(), data.flags);
+    CORRADE_COMPARE(shader.lightCount(), data.lightCount);
+    CORRADE_COMPARE(shader.materialCount(), data.materialCount);
+    CORRADE_COMPARE(shader.drawCount(), data.drawCount);
+    CORRADE_VERIFY(shader.id());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
 void PhongGLTest::constructMove() {
     Phong a{Phong::Flag::AlphaMask, 3};
     const GLuint id = a.id();
@@ -649,6 +785,42 @@ void PhongGLTest::constructTextureTransformationNotTextured() {
         "Shaders::Phong: texture transformation enabled but the shader is not textured\n");
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::constructUniformBuffersZeroMaterials() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Phong{Phong::Flag::UniformBuffers, 1, 0, 1};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong: material count can't be zero\n");
+}
+
+void PhongGLTest::constructUniformBuffersZeroDraws() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Phong{Phong::Flag::UniformBuffers, 1, 1, 0};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong: draw count can't be zero\n");
+}
+#endif
+
 void PhongGLTest::bindTexturesNotEnabled() {
     #ifdef CORRADE_NO_ASSERT
     CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
@@ -756,6 +928,142 @@ void PhongGLTest::setWrongLightId() {
         "Shaders::Phong::setLightRange(): light ID 3 is out of bounds for 3 lights\n");
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::setUniformUniformBuffersEnabled() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Phong shader{Phong::Flag::UniformBuffers};
+    shader.setAmbientColor({})
+        .setDiffuseColor({})
+        .setSpecularColor({})
+        .setShininess({})
+        .setNormalTextureScale({})
+        .setAlphaMask({})
+        .setObjectId({})
+        .setTransformationMatrix({})
+        .setNormalMatrix({})
+        .setProjectionMatrix({})
+        .setTextureMatrix({})
+        .setLightPositions({Vector4{}})
+        .setLightPosition(0, Vector4{})
+        .setLightColors({Color3{}})
+        .setLightColor(0, Color3{})
+        .setLightSpecularColors({Color3{}})
+        .setLightSpecularColor(0, Color3{})
+        .setLightRanges({0.0f})
+        .setLightRange(0, 0.0f);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong::setAmbientColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setDiffuseColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setSpecularColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setShininess(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setNormalTextureScale(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setAlphaMask(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setObjectId(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setTransformationMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setNormalMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setProjectionMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setTextureMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightPositions(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightPosition(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightColors(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightSpecularColors(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightSpecularColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightRanges(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightRange(): the shader was created with uniform buffers enabled\n");
+}
+
+void PhongGLTest::bindBufferUniformBuffersNotEnabled() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer;
+    Phong shader;
+    shader.bindProjectionBuffer(buffer)
+          .bindProjectionBuffer(buffer, 0, 16)
+          .bindTransformationBuffer(buffer)
+          .bindTransformationBuffer(buffer, 0, 16)
+          .bindDrawBuffer(buffer)
+          .bindDrawBuffer(buffer, 0, 16)
+          .bindTextureTransformationBuffer(buffer)
+          .bindTextureTransformationBuffer(buffer, 0, 16)
+          .bindMaterialBuffer(buffer)
+          .bindMaterialBuffer(buffer, 0, 16)
+          .bindLightBuffer(buffer)
+          .bindLightBuffer(buffer, 0, 16)
+          .setDrawOffset(0);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong::bindProjectionBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindProjectionBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindDrawBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindDrawBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindLightBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindLightBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::setDrawOffset(): the shader was not created with uniform buffers enabled\n");
+}
+
+void PhongGLTest::bindTextureTransformationBufferNotEnabled() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer{GL::Buffer::TargetHint::Uniform};
+    Phong shader{Phong::Flag::UniformBuffers};
+    shader.bindTextureTransformationBuffer(buffer)
+          .bindTextureTransformationBuffer(buffer, 0, 16);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled\n"
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled\n");
+}
+
+void PhongGLTest::setWrongDrawOffset() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Phong{Phong::Flag::UniformBuffers, 1, 2, 5}
+        .setDrawOffset(5);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong::setDrawOffset(): draw offset 5 is out of bounds for 5 draws\n");
+}
+#endif
+
 constexpr Vector2i RenderSize{80, 80};
 
 void PhongGLTest::renderSetup() {
@@ -811,27 +1119,206 @@ void PhongGLTest::renderDefaults() {
         (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
 }
 
-void PhongGLTest::renderColored() {
-    auto&& data = RenderColoredData[testCaseInstanceId()];
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::renderDefaultsUniformBuffers() {
+    auto&& data = RenderDefaultsUniformBuffersData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
 
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
     GL::Mesh sphere = MeshTools::compile(Primitives::uvSphereSolid(16, 32));
 
-    Phong{{}, 2}
-        .setLightColors({data.lightColor1, data.lightColor2})
-        .setLightPositions({{data.lightPosition1, -3.0f, 2.0f, 0.0f},
-                            {data.lightPosition2, -3.0f, 2.0f, 0.0f}})
-        .setAmbientColor(0x330033_rgbf)
-        .setDiffuseColor(0xccffcc_rgbf)
-        .setSpecularColor(0x6666ff_rgbf)
-        .setTransformationMatrix(Matrix4::translation(Vector3::zAxis(-2.15f))*
-                                 Matrix4::rotationY(data.rotation))
-        .setNormalMatrix(Matrix4::rotationY(data.rotation).normalMatrix())
-        .setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f))
+    /* Draws before the offset move the sphere out of the view, so if the
+       offset isn't taken into account, the output will be empty */
+    TransformationUniform3D transformations[2];
+    for(UnsignedInt i = 0; i != data.drawOffset; ++i)
+        transformations[i].setTransformationMatrix(Matrix4::translation(Vector3::xAxis(10.0f)));
+    PhongDrawUniform draws[2];
+
+    GL::Buffer projectionUniform{GL::Buffer::TargetHint::Uniform, {
+        ProjectionUniform3D{}
+    }};
+    GL::Buffer transformationUniform{GL::Buffer::TargetHint::Uniform,
+        Containers::arrayView(transformations, data.drawCount)};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform,
+        Containers::arrayView(draws, data.drawCount)};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongMaterialUniform{}
+    }};
+    GL::Buffer lightUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongLightUniform{}
+    }};
+
+    Phong{Phong::Flag::UniformBuffers, 1, 1, data.drawCount}
+        .bindProjectionBuffer(projectionUniform)
+        .bindTransformationBuffer(transformationUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .bindLightBuffer(lightUniform)
+        .setDrawOffset(data.drawOffset)
         .draw(sphere);
 
     MAGNUM_VERIFY_NO_GL_ERROR();
 
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    /* Same thresholds as in renderDefaults() */
+    const Float maxThreshold = 31.0f, meanThreshold = 0.122f;
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Directory::join(_testDir, "PhongTestFiles/defaults.tga"),
+        (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+void PhongGLTest::renderDefaultsMultiDraw() {
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shader_draw_parameters>())
+        CORRADE_SKIP(GL::Extensions::ARB::shader_draw_parameters::string() + std::string(" is not supported"));
+
+    GL::Mesh sphere = MeshTools::compile(Primitives::uvSphereSolid(16, 32));
+
+    /* Two views of the same mesh submitted in a single multi-draw call. The
+       first one is moved out of the view by its per-draw transformation, so
+       if gl_DrawID isn't taken into account, the output will be empty. The
+       second one references the last material slot, which differs from both
+       the draw index and the default ID, so the output is only correct if
+       the material is looked up through the per-draw material ID. */
+    GL::MeshView first{sphere};
+    first.setCount(sphere.count());
+    GL::MeshView second{sphere};
+    second.setCount(sphere.count());
+
+    GL::Buffer projectionUniform{GL::Buffer::TargetHint::Uniform, {
+        ProjectionUniform3D{}
+    }};
+    GL::Buffer transformationUniform{GL::Buffer::TargetHint::Uniform, {
+        TransformationUniform3D{}
+            .setTransformationMatrix(Matrix4::translation(Vector3::xAxis(10.0f))),
+        TransformationUniform3D{}
+    }};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongDrawUniform{},
+        PhongDrawUniform{}
+            .setMaterialId(2)
+    }};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongMaterialUniform{}
+            .setDiffuseColor(0xff0000_rgbf),
+        PhongMaterialUniform{}
+            .setDiffuseColor(0x00ff00_rgbf),
+        PhongMaterialUniform{}
+    }};
+    GL::Buffer lightUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongLightUniform{}
+    }};
+
+    Phong{Phong::Flag::MultiDraw, 1, 3, 2}
+        .bindProjectionBuffer(projectionUniform)
+        .bindTransformationBuffer(transformationUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .bindLightBuffer(lightUniform)
+        .draw({first, second});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    /* Same thresholds as in renderDefaults() */
+    const Float maxThreshold = 31.0f, meanThreshold = 0.122f;
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Directory::join(_testDir, "PhongTestFiles/defaults.tga"),
+        (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
+}
+#endif
+
+template<Phong::Flag flag> void PhongGLTest::renderColored() {
+    auto&& data = RenderColoredData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flag == Phong::Flag::UniformBuffers) {
+        setTestCaseTemplateName("Flag::UniformBuffers");
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+            CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+        #endif
+    }
+    #endif
+
+    GL::Mesh sphere = MeshTools::compile(Primitives::uvSphereSolid(16, 32));
+
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flag == Phong::Flag::UniformBuffers) {
+        GL::Buffer projectionUniform{GL::Buffer::TargetHint::Uniform, {
+            ProjectionUniform3D{}.setProjectionMatrix(
+                Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f)
+            )
+        }};
+        GL::Buffer transformationUniform{GL::Buffer::TargetHint::Uniform, {
+            TransformationUniform3D{}.setTransformationMatrix(
+                Matrix4::translation(Vector3::zAxis(-2.15f))*
+                Matrix4::rotationY(data.rotation)
+            )
+        }};
+        GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+            PhongDrawUniform{}
+                .setNormalMatrix(Matrix4::rotationY(data.rotation).normalMatrix())
+        }};
+        GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+            PhongMaterialUniform{}
+                .setAmbientColor(0x330033_rgbf)
+                .setDiffuseColor(0xccffcc_rgbf)
+                .setSpecularColor(0x6666ff_rgbf)
+        }};
+        GL::Buffer lightUniform{GL::Buffer::TargetHint::Uniform, {
+            PhongLightUniform{}
+                .setPosition({data.lightPosition1, -3.0f, 2.0f, 0.0f})
+                .setColor(data.lightColor1),
+            PhongLightUniform{}
+                .setPosition({data.lightPosition2, -3.0f, 2.0f, 0.0f})
+                .setColor(data.lightColor2)
+        }};
+        Phong{Phong::Flag::UniformBuffers, 2, 1, 1}
+            .bindProjectionBuffer(projectionUniform)
+            .bindTransformationBuffer(transformationUniform)
+            .bindDrawBuffer(drawUniform)
+            .bindMaterialBuffer(materialUniform)
+            .bindLightBuffer(lightUniform)
+            .draw(sphere);
+    } else
+    #endif
+    {
+        Phong{{}, 2}
+            .setLightColors({data.lightColor1, data.lightColor2})
+            .setLightPositions({{data.lightPosition1, -3.0f, 2.0f, 0.0f},
+                                {data.lightPosition2, -3.0f, 2.0f, 0.0f}})
+            .setAmbientColor(0x330033_rgbf)
+            .setDiffuseColor(0xccffcc_rgbf)
+            .setSpecularColor(0x6666ff_rgbf)
+            .setTransformationMatrix(Matrix4::translation(Vector3::zAxis(-2.15f))*
+                                     Matrix4::rotationY(data.rotation))
+            .setNormalMatrix(Matrix4::rotationY(data.rotation).normalMatrix())
+            .setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f))
+            .draw(sphere);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
     if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
        !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
         CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
@@ -937,10 +1424,21 @@ void PhongGLTest::renderSinglePixelTextured() {
         (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
 }
 
-void PhongGLTest::renderTextured() {
+template<Phong::Flag flag> void PhongGLTest::renderTextured() {
     auto&& data = RenderTexturedData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
 
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flag == Phong::Flag::UniformBuffers) {
+        setTestCaseTemplateName("Flag::UniformBuffers");
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+            CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+        #endif
+    }
+    #endif
+
     if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
        !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
         CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
@@ -948,9 +1446,9 @@ void PhongGLTest::renderTextured() {
     GL::Mesh sphere = MeshTools::compile(Primitives::uvSphereSolid(16, 32,
         Primitives::UVSphereFlag::TextureCoordinates));
 
-    Phong shader{data.flags, 2};
+    Phong shader{data.flags|flag, 2};
 
-    if(data.textureTransformation != Matrix3{})
+    if(flag == Phong::Flag{} && data.textureTransformation != Matrix3{})
         shader.setTextureMatrix(data.textureTransformation);
 
     Containers::Pointer<Trade::AbstractImporter> importer = _manager.loadAndInstantiate("AnyImageImporter");
@@ -965,11 +1463,12 @@ void PhongGLTest::renderTextured() {
             .setWrapping(GL::SamplerWrapping::ClampToEdge)
             .setStorage(1, TextureFormatRGB, image->size())
             .setSubImage(0, {}, *image);
-        shader
-            .bindAmbientTexture(ambient)
-            /* Colorized. Case without a color (where it should be white) is
-               tested in renderSinglePixelTextured() */
-            .setAmbientColor(0xff9999_rgbf);
+        shader.bindAmbientTexture(ambient);
+        /* Colorized. Case without a color (where it should be white) is
+           tested in renderSinglePixelTextured(). The uniform buffer variant
+           has the colors set below. */
+        if(flag == Phong::Flag{})
+            shader.setAmbientColor(0xff9999_rgbf);
     }
 
     /* If no diffuse texture is present, dial down the default diffuse color
@@ -983,12 +1482,13 @@ void PhongGLTest::renderTextured() {
             .setWrapping(GL::SamplerWrapping::ClampToEdge)
             .setStorage(1, TextureFormatRGB, image->size())
             .setSubImage(0, {}, *image);
-        shader
-            .bindDiffuseTexture(diffuse)
-            /* Colorized. Case without a color (where it should be white) is
-               tested in renderSinglePixelTextured() */
-            .setDiffuseColor(0x9999ff_rgbf);
-    } else shader.setDiffuseColor(0x333333_rgbf);
+        shader.bindDiffuseTexture(diffuse);
+        /* Colorized. Case without a color (where it should be white) is
+           tested in renderSinglePixelTextured() */
+        if(flag == Phong::Flag{})
+            shader.setDiffuseColor(0x9999ff_rgbf);
+    } else if(flag == Phong::Flag{})
+        shader.setDiffuseColor(0x333333_rgbf);
 
     GL::Texture2D specular;
     if(data.flags & Phong::Flag::SpecularTexture) {
@@ -999,25 +1499,80 @@ void PhongGLTest::renderTextured() {
             .setWrapping(GL::SamplerWrapping::ClampToEdge)
             .setStorage(1, TextureFormatRGB, image->size())
             .setSubImage(0, {}, *image);
-        shader
-            .bindSpecularTexture(specular)
-            /* Colorized. Case without a color (where it should be white) is
-               tested in renderSinglePixelTextured() */
-            .setSpecularColor(0x99ff99_rgbf);
+        shader.bindSpecularTexture(specular);
+        /* Colorized. Case without a color (where it should be white) is
+           tested in renderSinglePixelTextured() */
+        if(flag == Phong::Flag{})
+            shader.setSpecularColor(0x99ff99_rgbf);
     }
 
     /* Using default (white) light colors to have the texture data visible
        better */
-    shader.setLightPositions({{-3.0f, -3.0f, 2.0f, 0.0f},
-                              { 3.0f, -3.0f, 2.0f, 0.0f}})
-        .setTransformationMatrix(
-            Matrix4::translation(Vector3::zAxis(-2.15f))*
-            Matrix4::rotationY(-15.0_degf)*
-            Matrix4::rotationX(15.0_degf))
-        .setNormalMatrix((Matrix4::rotationY(-15.0_degf)*
-            Matrix4::rotationX(15.0_degf)).normalMatrix())
-        .setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f))
-        .draw(sphere);
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flag == Phong::Flag::UniformBuffers) {
+        PhongMaterialUniform material;
+        if(data.flags & Phong::Flag::AmbientTexture)
+            material.setAmbientColor(0xff9999_rgbf);
+        if(data.flags & Phong::Flag::DiffuseTexture)
+            material.setDiffuseColor(0x9999ff_rgbf);
+        else
+            material.setDiffuseColor(0x333333_rgbf);
+        if(data.flags & Phong::Flag::SpecularTexture)
+            material.setSpecularColor(0x99ff99_rgbf);
+
+        GL::Buffer projectionUniform{GL::Buffer::TargetHint::Uniform, {
+            ProjectionUniform3D{}.setProjectionMatrix(
+                Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f)
+            )
+        }};
+        GL::Buffer transformationUniform{GL::Buffer::TargetHint::Uniform, {
+            TransformationUniform3D{}.setTransformationMatrix(
+                Matrix4::translation(Vector3::zAxis(-2.15f))*
+                Matrix4::rotationY(-15.0_degf)*
+                Matrix4::rotationX(15.0_degf)
+            )
+        }};
+        GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+            PhongDrawUniform{}
+                .setNormalMatrix((Matrix4::rotationY(-15.0_degf)*
+                    Matrix4::rotationX(15.0_degf)).normalMatrix())
+        }};
+        GL::Buffer textureTransformationUniform{GL::Buffer::TargetHint::Uniform, {
+            TextureTransformationUniform{}
+                .setTextureMatrix(data.textureTransformation)
+        }};
+        GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+            material
+        }};
+        GL::Buffer lightUniform{GL::Buffer::TargetHint::Uniform, {
+            PhongLightUniform{}
+                .setPosition({-3.0f, -3.0f, 2.0f, 0.0f}),
+            PhongLightUniform{}
+                .setPosition({3.0f, -3.0f, 2.0f, 0.0f})
+        }};
+        if(data.flags & Phong::Flag::TextureTransformation)
+            shader.bindTextureTransformationBuffer(textureTransformationUniform);
+        shader
+            .bindProjectionBuffer(projectionUniform)
+            .bindTransformationBuffer(transformationUniform)
+            .bindDrawBuffer(drawUniform)
+            .bindMaterialBuffer(materialUniform)
+            .bindLightBuffer(lightUniform)
+            .draw(sphere);
+    } else
+    #endif
+    {
+        shader.setLightPositions({{-3.0f, -3.0f, 2.0f, 0.0f},
+                                  { 3.0f, -3.0f, 2.0f, 0.0f}})
+            .setTransformationMatrix(
+                Matrix4::translation(Vector3::zAxis(-2.15f))*
+                Matrix4::rotationY(-15.0_degf)*
+                Matrix4::rotationX(15.0_degf))
+            .setNormalMatrix((Matrix4::rotationY(-15.0_degf)*
+                Matrix4::rotationX(15.0_degf)).normalMatrix())
+            .setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f))
+            .draw(sphere);
+    }
 
     MAGNUM_VERIFY_NO_GL_ERROR();
 
@@ -1202,20 +1757,67 @@ template<class T> void PhongGLTest::renderVertexColor() {
         (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
 }
 
-void PhongGLTest::renderShininess() {
+template<Phong::Flag flag> void PhongGLTest::renderShininess() {
     auto&& data = RenderShininessData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
 
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flag == Phong::Flag::UniformBuffers) {
+        setTestCaseTemplateName("Flag::UniformBuffers");
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+            CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+        #endif
+    }
+    #endif
+
     GL::Mesh sphere = MeshTools::compile(Primitives::uvSphereSolid(16, 32));
 
-    Phong{}
-        .setLightPositions({{-3.0f, -3.0f, 2.0f, 0.0f}})
-        .setDiffuseColor(0xff3333_rgbf)
-        .setSpecularColor(data.specular)
-        .setShininess(data.shininess)
-        .setTransformationMatrix(Matrix4::translation(Vector3::zAxis(-2.15f)))
-        .setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f))
-        .draw(sphere);
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flag == Phong::Flag::UniformBuffers) {
+        GL::Buffer projectionUniform{GL::Buffer::TargetHint::Uniform, {
+            ProjectionUniform3D{}.setProjectionMatrix(
+                Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f)
+            )
+        }};
+        GL::Buffer transformationUniform{GL::Buffer::TargetHint::Uniform, {
+            TransformationUniform3D{}.setTransformationMatrix(
+                Matrix4::translation(Vector3::zAxis(-2.15f))
+            )
+        }};
+        GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+            PhongDrawUniform{}
+        }};
+        GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+            PhongMaterialUniform{}
+                .setDiffuseColor(0xff3333_rgbf)
+                .setSpecularColor(data.specular)
+                .setShininess(data.shininess)
+        }};
+        GL::Buffer lightUniform{GL::Buffer::TargetHint::Uniform, {
+            PhongLightUniform{}
+                .setPosition({-3.0f, -3.0f, 2.0f, 0.0f})
+        }};
+        Phong{Phong::Flag::UniformBuffers, 1, 1, 1}
+            .bindProjectionBuffer(projectionUniform)
+            .bindTransformationBuffer(transformationUniform)
+            .bindDrawBuffer(drawUniform)
+            .bindMaterialBuffer(materialUniform)
+            .bindLightBuffer(lightUniform)
+            .draw(sphere);
+    } else
+    #endif
+    {
+        Phong{}
+            .setLightPositions({{-3.0f, -3.0f, 2.0f, 0.0f}})
+            .setDiffuseColor(0xff3333_rgbf)
+            .setSpecularColor(data.specular)
+            .setShininess(data.shininess)
+            .setTransformationMatrix(Matrix4::translation(Vector3::zAxis(-2.15f)))
+            .setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f))
+            .draw(sphere);
+    }
 
     MAGNUM_VERIFY_NO_GL_ERROR();
 
@@ -1301,10 +1903,21 @@ void PhongGLTest::renderAlphaTeardown() {
     renderTeardown();
 }
 
-void PhongGLTest::renderAlpha() {
+template<Phong::Flag flag> void PhongGLTest::renderAlpha() {
     auto&& data = RenderAlphaData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
 
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flag == Phong::Flag::UniformBuffers) {
+        setTestCaseTemplateName("Flag::UniformBuffers");
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+            CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+        #endif
+    }
+    #endif
+
     if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
        !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
         CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
@@ -1342,25 +1955,78 @@ void PhongGLTest::renderAlpha() {
     GL::Mesh sphere = MeshTools::compile(Primitives::uvSphereSolid(16, 32,
         Primitives::UVSphereFlag::TextureCoordinates));
 
-    Phong shader{data.flags, 2};
-    shader.setLightPositions({{-3.0f, -3.0f, 2.0f, 0.0f},
-                              { 3.0f, -3.0f, 2.0f, 0.0f}})
-        .setTransformationMatrix(
-            Matrix4::translation(Vector3::zAxis(-2.15f))*
-            Matrix4::rotationY(-15.0_degf)*
-            Matrix4::rotationX(15.0_degf))
-        .setNormalMatrix((Matrix4::rotationY(-15.0_degf)*
-            Matrix4::rotationX(15.0_degf)).normalMatrix())
-        .setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f))
-        .setAmbientColor(data.ambientColor)
-        .setDiffuseColor(data.diffuseColor)
-        .setSpecularColor(0xffffff00_rgbaf)
-        .bindTextures(&ambient, &diffuse, nullptr, nullptr);
+    Phong shader{data.flags|flag, 2};
+    shader.bindTextures(&ambient, &diffuse, nullptr, nullptr);
 
-    /* Test that the default is correct by not setting the threshold if it's
-       equal to the default */
-    if(data.flags & Phong::Flag::AlphaMask && data.threshold != 0.5f)
-        shader.setAlphaMask(data.threshold);
+    #ifndef MAGNUM_TARGET_GLES2
+    /* The buffers have to stay alive until the draws below */
+    GL::Buffer projectionUniform{NoCreate}, transformationUniform{NoCreate},
+        drawUniform{NoCreate}, materialUniform{NoCreate},
+        lightUniform{NoCreate};
+    if(flag == Phong::Flag::UniformBuffers) {
+        PhongMaterialUniform material;
+        material
+            .setAmbientColor(data.ambientColor)
+            .setDiffuseColor(data.diffuseColor)
+            .setSpecularColor(0xffffff00_rgbaf);
+        /* Test that the default is correct by not setting the threshold if
+           it's equal to the default */
+        if(data.flags & Phong::Flag::AlphaMask && data.threshold != 0.5f)
+            material.setAlphaMask(data.threshold);
+
+        projectionUniform = GL::Buffer{GL::Buffer::TargetHint::Uniform, {
+            ProjectionUniform3D{}.setProjectionMatrix(
+                Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f)
+            )
+        }};
+        transformationUniform = GL::Buffer{GL::Buffer::TargetHint::Uniform, {
+            TransformationUniform3D{}.setTransformationMatrix(
+                Matrix4::translation(Vector3::zAxis(-2.15f))*
+                Matrix4::rotationY(-15.0_degf)*
+                Matrix4::rotationX(15.0_degf)
+            )
+        }};
+        drawUniform = GL::Buffer{GL::Buffer::TargetHint::Uniform, {
+            PhongDrawUniform{}
+                .setNormalMatrix((Matrix4::rotationY(-15.0_degf)*
+                    Matrix4::rotationX(15.0_degf)).normalMatrix())
+        }};
+        materialUniform = GL::Buffer{GL::Buffer::TargetHint::Uniform, {
+            material
+        }};
+        lightUniform = GL::Buffer{GL::Buffer::TargetHint::Uniform, {
+            PhongLightUniform{}
+                .setPosition({-3.0f, -3.0f, 2.0f, 0.0f}),
+            PhongLightUniform{}
+                .setPosition({3.0f, -3.0f, 2.0f, 0.0f})
+        }};
+        shader
+            .bindProjectionBuffer(projectionUniform)
+            .bindTransformationBuffer(transformationUniform)
+            .bindDrawBuffer(drawUniform)
+            .bindMaterialBuffer(materialUniform)
+            .bindLightBuffer(lightUniform);
+    } else
+    #endif
+    {
+        shader.setLightPositions({{-3.0f, -3.0f, 2.0f, 0.0f},
+                                  { 3.0f, -3.0f, 2.0f, 0.0f}})
+            .setTransformationMatrix(
+                Matrix4::translation(Vector3::zAxis(-2.15f))*
+                Matrix4::rotationY(-15.0_degf)*
+                Matrix4::rotationX(15.0_degf))
+            .setNormalMatrix((Matrix4::rotationY(-15.0_degf)*
+                Matrix4::rotationX(15.0_degf)).normalMatrix())
+            .setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f))
+            .setAmbientColor(data.ambientColor)
+            .setDiffuseColor(data.diffuseColor)
+            .setSpecularColor(0xffffff00_rgbaf);
+
+        /* Test that the default is correct by not setting the threshold if
+           it's equal to the default */
+        if(data.flags & Phong::Flag::AlphaMask && data.threshold != 0.5f)
+            shader.setAlphaMask(data.threshold);
+    }
 
     /* For proper Z order draw back faces first and then front faces */
     GL::Renderer::setFaceCullingMode(GL::Renderer::PolygonFacing::Front);
@@ -1425,10 +2091,19 @@ void PhongGLTest::renderObjectIdTeardown() {
     _framebuffer = GL::Framebuffer{NoCreate};
 }
 
-void PhongGLTest::renderObjectId() {
+template<Phong::Flag flag> void PhongGLTest::renderObjectId() {
     auto&& data = RenderObjectIdData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
 
+    if(flag == Phong::Flag::UniformBuffers) {
+        setTestCaseTemplateName("Flag::UniformBuffers");
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+            CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+        #endif
+    }
+
     #ifndef MAGNUM_TARGET_GLES
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
         CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() + std::string(" is not supported"));
@@ -1444,17 +2119,55 @@ void PhongGLTest::renderObjectId() {
             GL::Buffer{Containers::arrayView({11002u, 48823u})},
             1, 0, Phong::ObjectId{});
 
-    Phong{data.flags, 2}
-        .setLightColors({0x993366_rgbf, 0x669933_rgbf})
-        .setLightPositions({{-3.0f, -3.0f, 2.0f, 0.0f},
-                            { 3.0f, -3.0f, 2.0f, 0.0f}})
-        .setAmbientColor(0x330033_rgbf)
-        .setDiffuseColor(0xccffcc_rgbf)
-        .setSpecularColor(0x6666ff_rgbf)
-        .setTransformationMatrix(Matrix4::translation(Vector3::zAxis(-2.15f)))
-        .setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f))
-        .setObjectId(data.uniformId)
-        .draw(sphere);
+    if(flag == Phong::Flag::UniformBuffers) {
+        GL::Buffer projectionUniform{GL::Buffer::TargetHint::Uniform, {
+            ProjectionUniform3D{}.setProjectionMatrix(
+                Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f)
+            )
+        }};
+        GL::Buffer transformationUniform{GL::Buffer::TargetHint::Uniform, {
+            TransformationUniform3D{}.setTransformationMatrix(
+                Matrix4::translation(Vector3::zAxis(-2.15f))
+            )
+        }};
+        GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+            PhongDrawUniform{}
+                .setObjectId(data.uniformId)
+        }};
+        GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+            PhongMaterialUniform{}
+                .setAmbientColor(0x330033_rgbf)
+                .setDiffuseColor(0xccffcc_rgbf)
+                .setSpecularColor(0x6666ff_rgbf)
+        }};
+        GL::Buffer lightUniform{GL::Buffer::TargetHint::Uniform, {
+            PhongLightUniform{}
+                .setPosition({-3.0f, -3.0f, 2.0f, 0.0f})
+                .setColor(0x993366_rgbf),
+            PhongLightUniform{}
+                .setPosition({3.0f, -3.0f, 2.0f, 0.0f})
+                .setColor(0x669933_rgbf)
+        }};
+        Phong{data.flags|Phong::Flag::UniformBuffers, 2, 1, 1}
+            .bindProjectionBuffer(projectionUniform)
+            .bindTransformationBuffer(transformationUniform)
+            .bindDrawBuffer(drawUniform)
+            .bindMaterialBuffer(materialUniform)
+            .bindLightBuffer(lightUniform)
+            .draw(sphere);
+    } else {
+        Phong{data.flags, 2}
+            .setLightColors({0x993366_rgbf, 0x669933_rgbf})
+            .setLightPositions({{-3.0f, -3.0f, 2.0f, 0.0f},
+                                { 3.0f, -3.0f, 2.0f, 0.0f}})
+            .setAmbientColor(0x330033_rgbf)
+            .setDiffuseColor(0xccffcc_rgbf)
+            .setSpecularColor(0x6666ff_rgbf)
+            .setTransformationMatrix(Matrix4::translation(Vector3::zAxis(-2.15f)))
+            .setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f))
+            .setObjectId(data.uniformId)
+            .draw(sphere);
+    }
 
     MAGNUM_VERIFY_NO_GL_ERROR();
 
@@ -1492,29 +2205,80 @@ void PhongGLTest::renderObjectId() {
 }
 #endif
 
-void PhongGLTest::renderLights() {
+template<Phong::Flag flag> void PhongGLTest::renderLights() {
     auto&& data = RenderLightsData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
 
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flag == Phong::Flag::UniformBuffers) {
+        setTestCaseTemplateName("Flag::UniformBuffers");
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+            CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+        #endif
+    }
+    #endif
+
     GL::Mesh plane = MeshTools::compile(Primitives::planeSolid());
 
     Matrix4 transformation =
         Matrix4::translation({0.0f, 0.0f, -1.5f});
 
-    Phong{{}, 1}
-        /* Set non-black ambient to catch accidental NaNs -- the render should
-           never be fully black */
-        .setAmbientColor(0x222222_rgbf)
-        .setSpecularColor(data.specularColor)
-        .setLightPositions({data.position})
-        .setLightColors({0xff8080_rgbf*data.intensity})
-        .setLightSpecularColors({data.lightSpecularColor})
-        .setLightRanges({data.range})
-        .setShininess(60.0f)
-        .setTransformationMatrix(transformation)
-        .setNormalMatrix(transformation.normalMatrix())
-        .setProjectionMatrix(Matrix4::perspectiveProjection(80.0_degf, 1.0f, 0.1f, 20.0f))
-        .draw(plane);
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flag == Phong::Flag::UniformBuffers) {
+        GL::Buffer projectionUniform{GL::Buffer::TargetHint::Uniform, {
+            ProjectionUniform3D{}.setProjectionMatrix(
+                Matrix4::perspectiveProjection(80.0_degf, 1.0f, 0.1f, 20.0f)
+            )
+        }};
+        GL::Buffer transformationUniform{GL::Buffer::TargetHint::Uniform, {
+            TransformationUniform3D{}.setTransformationMatrix(transformation)
+        }};
+        GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+            PhongDrawUniform{}
+                .setNormalMatrix(transformation.normalMatrix())
+        }};
+        GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+            PhongMaterialUniform{}
+                /* Set non-black ambient to catch accidental NaNs -- the
+                   render should never be fully black */
+                .setAmbientColor(0x222222_rgbf)
+                .setSpecularColor(data.specularColor)
+                .setShininess(60.0f)
+        }};
+        GL::Buffer lightUniform{GL::Buffer::TargetHint::Uniform, {
+            PhongLightUniform{}
+                .setPosition(data.position)
+                .setColor(0xff8080_rgbf*data.intensity)
+                .setSpecularColor(data.lightSpecularColor)
+                .setRange(data.range)
+        }};
+        Phong{Phong::Flag::UniformBuffers, 1, 1, 1}
+            .bindProjectionBuffer(projectionUniform)
+            .bindTransformationBuffer(transformationUniform)
+            .bindDrawBuffer(drawUniform)
+            .bindMaterialBuffer(materialUniform)
+            .bindLightBuffer(lightUniform)
+            .draw(plane);
+    } else
+    #endif
+    {
+        Phong{{}, 1}
+            /* Set non-black ambient to catch accidental NaNs -- the render
+               should never be fully black */
+            .setAmbientColor(0x222222_rgbf)
+            .setSpecularColor(data.specularColor)
+            .setLightPositions({data.position})
+            .setLightColors({0xff8080_rgbf*data.intensity})
+            .setLightSpecularColors({data.lightSpecularColor})
+            .setLightRanges({data.range})
+            .setShininess(60.0f)
+            .setTransformationMatrix(transformation)
+            .setNormalMatrix(transformation.normalMatrix())
+            .setProjectionMatrix(Matrix4::perspectiveProjection(80.0_degf, 1.0f, 0.1f, 20.0f))
+            .draw(plane);
+    }
 
     MAGNUM_VERIFY_NO_GL_ERROR();
 
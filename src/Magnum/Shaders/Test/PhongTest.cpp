@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <new>
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -31,9 +32,25 @@
 
 namespace Magnum { namespace Shaders { namespace Test { namespace {
 
+using namespace Math::Literals;
+
 struct PhongTest: TestSuite::Tester {
     explicit PhongTest();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    template<class T> void uniformSizeAlignment();
+
+    void drawUniformConstructDefault();
+    void drawUniformConstructNoInit();
+    void drawUniformSetters();
+    void materialUniformConstructDefault();
+    void materialUniformConstructNoInit();
+    void materialUniformSetters();
+    void lightUniformConstructDefault();
+    void lightUniformConstructNoInit();
+    void lightUniformSetters();
+    #endif
+
     void constructNoCreate();
     void constructCopy();
 
@@ -43,14 +60,213 @@ struct PhongTest: TestSuite::Tester {
 };
 
 PhongTest::PhongTest() {
-    addTests({&PhongTest::constructNoCreate,
-              &PhongTest::constructCopy,
+    addTests({
+        #ifndef MAGNUM_TARGET_GLES2
+        &PhongTest::uniformSizeAlignment<PhongDrawUniform>,
+        &PhongTest::uniformSizeAlignment<PhongMaterialUniform>,
+        &PhongTest::uniformSizeAlignment<PhongLightUniform>,
+
+        &PhongTest::drawUniformConstructDefault,
+        &PhongTest::drawUniformConstructNoInit,
+        &PhongTest::drawUniformSetters,
+        &PhongTest::materialUniformConstructDefault,
+        &PhongTest::materialUniformConstructNoInit,
+        &PhongTest::materialUniformSetters,
+        &PhongTest::lightUniformConstructDefault,
+        &PhongTest::lightUniformConstructNoInit,
+        &PhongTest::lightUniformSetters,
+        #endif
+
+        &PhongTest::constructNoCreate,
+        &PhongTest::constructCopy,
+
+        &PhongTest::debugFlag,
+        &PhongTest::debugFlags,
+        &PhongTest::debugFlagsSupersets});
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+template<class> struct UniformTraits;
+template<> struct UniformTraits<PhongDrawUniform> {
+    static const char* name() { return "PhongDrawUniform"; }
+};
+template<> struct UniformTraits<PhongMaterialUniform> {
+    static const char* name() { return "PhongMaterialUniform"; }
+};
+template<> struct UniformTraits<PhongLightUniform> {
+    static const char* name() { return "PhongLightUniform"; }
+};
+
+template<class T> void PhongTest::uniformSizeAlignment() {
+    setTestCaseTemplateName(UniformTraits<T>::name());
+
+    /* The structures are put into arrays in the uniform buffers, which in
+       the std140 layout means each item has to be a multiple of 16 bytes */
+    CORRADE_COMPARE(sizeof(T) % sizeof(Vector4), 0);
+}
+
+void PhongTest::drawUniformConstructDefault() {
+    PhongDrawUniform a;
+    CORRADE_COMPARE(a.normalMatrix, (Matrix3x4{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}}));
+    CORRADE_COMPARE(a.materialId, 0);
+    CORRADE_COMPARE(a.objectId, 0);
 
-              &PhongTest::debugFlag,
-              &PhongTest::debugFlags,
-              &PhongTest::debugFlagsSupersets});
+    constexpr PhongDrawUniform ca;
+    CORRADE_COMPARE(ca.normalMatrix, (Matrix3x4{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}}));
+    CORRADE_COMPARE(ca.materialId, 0);
+    CORRADE_COMPARE(ca.objectId, 0);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<PhongDrawUniform>::value);
 }
 
+void PhongTest::drawUniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    PhongDrawUniform a;
+    a.normalMatrix[2] = {1.5f, 0.3f, 3.1f, 0.5f};
+    a.objectId = 7;
+
+    new(&a) PhongDrawUniform{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.normalMatrix[2], (Vector4{1.5f, 0.3f, 3.1f, 0.5f}));
+        CORRADE_COMPARE(a.objectId, 7);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<PhongDrawUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, PhongDrawUniform>::value);
+}
+
+void PhongTest::drawUniformSetters() {
+    PhongDrawUniform a;
+    a.setNormalMatrix(Matrix4::rotationX(90.0_degf).normalMatrix())
+        .setMaterialId(5)
+        .setObjectId(7);
+    /* The bottom row is padding */
+    CORRADE_COMPARE(a.normalMatrix, (Matrix3x4{
+        Vector4{Matrix4::rotationX(90.0_degf).normalMatrix()[0], 0.0f},
+        Vector4{Matrix4::rotationX(90.0_degf).normalMatrix()[1], 0.0f},
+        Vector4{Matrix4::rotationX(90.0_degf).normalMatrix()[2], 0.0f}}));
+    CORRADE_COMPARE(a.materialId, 5);
+    CORRADE_COMPARE(a.objectId, 7);
+}
+
+void PhongTest::materialUniformConstructDefault() {
+    PhongMaterialUniform a;
+    CORRADE_COMPARE(a.ambientColor, 0x00000000_rgbaf);
+    CORRADE_COMPARE(a.diffuseColor, 0xffffffff_rgbaf);
+    CORRADE_COMPARE(a.specularColor, 0xffffff00_rgbaf);
+    CORRADE_COMPARE(a.normalTextureScale, 1.0f);
+    CORRADE_COMPARE(a.shininess, 80.0f);
+    CORRADE_COMPARE(a.alphaMask, 0.5f);
+
+    constexpr PhongMaterialUniform ca;
+    CORRADE_COMPARE(ca.ambientColor, 0x00000000_rgbaf);
+    CORRADE_COMPARE(ca.diffuseColor, 0xffffffff_rgbaf);
+    CORRADE_COMPARE(ca.specularColor, 0xffffff00_rgbaf);
+    CORRADE_COMPARE(ca.normalTextureScale, 1.0f);
+    CORRADE_COMPARE(ca.shininess, 80.0f);
+    CORRADE_COMPARE(ca.alphaMask, 0.5f);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<PhongMaterialUniform>::value);
+}
+
+void PhongTest::materialUniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    PhongMaterialUniform a;
+    a.diffuseColor = 0x354565fc_rgbaf;
+    a.shininess = 0.7f;
+
+    new(&a) PhongMaterialUniform{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.diffuseColor, 0x354565fc_rgbaf);
+        CORRADE_COMPARE(a.shininess, 0.7f);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<PhongMaterialUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, PhongMaterialUniform>::value);
+}
+
+void PhongTest::materialUniformSetters() {
+    PhongMaterialUniform a;
+    a.setAmbientColor(0x112233cc_rgbaf)
+        .setDiffuseColor(0x354565fc_rgbaf)
+        .setSpecularColor(0xabcdef00_rgbaf)
+        .setNormalTextureScale(0.5f)
+        .setShininess(10.0f)
+        .setAlphaMask(0.7f);
+    CORRADE_COMPARE(a.ambientColor, 0x112233cc_rgbaf);
+    CORRADE_COMPARE(a.diffuseColor, 0x354565fc_rgbaf);
+    CORRADE_COMPARE(a.specularColor, 0xabcdef00_rgbaf);
+    CORRADE_COMPARE(a.normalTextureScale, 0.5f);
+    CORRADE_COMPARE(a.shininess, 10.0f);
+    CORRADE_COMPARE(a.alphaMask, 0.7f);
+}
+
+void PhongTest::lightUniformConstructDefault() {
+    PhongLightUniform a;
+    CORRADE_COMPARE(a.position, (Vector4{0.0f, 0.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(a.color, 0xffffff_rgbf);
+    CORRADE_COMPARE(a.range, Constants::inf());
+    CORRADE_COMPARE(a.specularColor, 0xffffff_rgbf);
+
+    constexpr PhongLightUniform ca;
+    CORRADE_COMPARE(ca.position, (Vector4{0.0f, 0.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(ca.color, 0xffffff_rgbf);
+    CORRADE_COMPARE(ca.range, Constants::inf());
+    CORRADE_COMPARE(ca.specularColor, 0xffffff_rgbf);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<PhongLightUniform>::value);
+}
+
+void PhongTest::lightUniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    PhongLightUniform a;
+    a.position = {1.5f, 0.3f, 3.1f, 1.0f};
+    a.range = 17.0f;
+
+    new(&a) PhongLightUniform{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.position, (Vector4{1.5f, 0.3f, 3.1f, 1.0f}));
+        CORRADE_COMPARE(a.range, 17.0f);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<PhongLightUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, PhongLightUniform>::value);
+}
+
+void PhongTest::lightUniformSetters() {
+    PhongLightUniform a;
+    a.setPosition({1.5f, 0.3f, 3.1f, 1.0f})
+        .setColor(0x354565_rgbf)
+        .setSpecularColor(0xabcdef_rgbf)
+        .setRange(17.0f);
+    CORRADE_COMPARE(a.position, (Vector4{1.5f, 0.3f, 3.1f, 1.0f}));
+    CORRADE_COMPARE(a.color, 0x354565_rgbf);
+    CORRADE_COMPARE(a.specularColor, 0xabcdef_rgbf);
+    CORRADE_COMPARE(a.range, 17.0f);
+}
+#endif
+
 void PhongTest::constructNoCreate() {
     {
         Phong shader{NoCreate};
@@ -92,6 +308,16 @@ void PhongTest::debugFlagsSupersets() {
     }
     #endif
 
+    #ifndef MAGNUM_TARGET_GLES
+    /* MultiDraw is a superset of UniformBuffers so only one should be
+       printed */
+    {
+        std::ostringstream out;
+        Debug{&out} << (Phong::Flag::MultiDraw|Phong::Flag::UniformBuffers);
+        CORRADE_COMPARE(out.str(), "Shaders::Phong::Flag::MultiDraw\n");
+    }
+    #endif
+
     /* InstancedTextureOffset is a superset of TextureTransformation so only
        one should be printed */
     std::ostringstream out;
@@ -24,8 +24,12 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <mutex>
 #include <sstream>
+#include <vector>
+#include <Corrade/Containers/ArrayViewStl.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/FormatStl.h>
 
 #include "Magnum/AbstractResourceLoader.h"
@@ -53,9 +57,21 @@ struct ResourceManagerTest: TestSuite::Tester {
     void defaults();
     void clear();
     void clearWhileReferenced();
+    void memoryUsage();
+    void budgetLeastRecentlyUsed();
+    void budgetLeastFrequentlyUsed();
+    void budgetReferenced();
+    void budgetReload();
+    void budgetLoadOverBudget();
+    void hitMissCount();
 
     void loader();
     void loaderSetNullptr();
+    void loaderAsync();
+    void loaderAsyncPriority();
+    void loaderAsyncCancel();
+    void loaderAsyncDestruction();
+    void loaderAsyncAlreadyStarted();
 
     void debugResourceState();
     void debugResourceKey();
@@ -90,9 +106,21 @@ ResourceManagerTest::ResourceManagerTest() {
               &ResourceManagerTest::defaults,
               &ResourceManagerTest::clear,
               &ResourceManagerTest::clearWhileReferenced,
+              &ResourceManagerTest::memoryUsage,
+              &ResourceManagerTest::budgetLeastRecentlyUsed,
+              &ResourceManagerTest::budgetLeastFrequentlyUsed,
+              &ResourceManagerTest::budgetReferenced,
+              &ResourceManagerTest::budgetReload,
+              &ResourceManagerTest::budgetLoadOverBudget,
+              &ResourceManagerTest::hitMissCount,
 
               &ResourceManagerTest::loader,
               &ResourceManagerTest::loaderSetNullptr,
+              &ResourceManagerTest::loaderAsync,
+              &ResourceManagerTest::loaderAsyncPriority,
+              &ResourceManagerTest::loaderAsyncCancel,
+              &ResourceManagerTest::loaderAsyncDestruction,
+              &ResourceManagerTest::loaderAsyncAlreadyStarted,
 
               &ResourceManagerTest::debugResourceState,
               &ResourceManagerTest::debugResourceKey});
@@ -432,6 +460,193 @@ void ResourceManagerTest::clearWhileReferenced() {
     CORRADE_COMPARE(out.str(), "ResourceManager: cleared/destroyed while data are still referenced\n");
 }
 
+void ResourceManagerTest::memoryUsage() {
+    ResourceManager rm;
+    rm.set("a", 1, ResourceDataState::Final, ResourcePolicy::Manual, 100);
+    rm.set("b", 2, ResourceDataState::Mutable, ResourcePolicy::Manual, 50);
+    rm.set("c", 3);
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 150);
+    CORRADE_COMPARE(rm.memoryUsage<Int>("b"), 50);
+    CORRADE_COMPARE(rm.memoryUsage<Int>("c"), 0);
+    CORRADE_COMPARE(rm.memoryUsage<Int>("nonexistent"), 0);
+    CORRADE_COMPARE(rm.memoryUsage<Data>(), 0);
+
+    /* Updating the data updates the usage */
+    rm.set("b", 4, ResourceDataState::Mutable, ResourcePolicy::Manual, 20);
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 120);
+
+    /* No budget, so nothing gets evicted */
+    CORRADE_COMPARE(rm.memoryBudget<Int>(), 0);
+    CORRADE_COMPARE(rm.evict<Int>(), 0);
+    CORRADE_COMPARE(rm.evictedCount<Int>(), 0);
+
+    /* Freeing removes the usage as well */
+    rm.free();
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 0);
+    CORRADE_COMPARE(rm.count<Int>(), 1);
+}
+
+void ResourceManagerTest::budgetLeastRecentlyUsed() {
+    ResourceManager rm;
+    rm.set("a", 1, ResourceDataState::Final, ResourcePolicy::Manual, 40);
+    rm.set("b", 2, ResourceDataState::Final, ResourcePolicy::Manual, 40);
+    rm.set("c", 3, ResourceDataState::Final, ResourcePolicy::Manual, 40);
+
+    /* Use "a" so "b" is the least recently used */
+    rm.get<Int>("a");
+
+    rm.setMemoryBudget<Int>(100);
+    CORRADE_COMPARE(rm.memoryBudget<Int>(), 100);
+    CORRADE_VERIFY(rm.evictionPolicy<Int>() == ResourceEvictionPolicy::LeastRecentlyUsed);
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 80);
+    CORRADE_COMPARE(rm.evictedCount<Int>(), 1);
+    CORRADE_COMPARE(rm.state<Int>("a"), ResourceState::Final);
+    CORRADE_COMPARE(rm.state<Int>("b"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.state<Int>("c"), ResourceState::Final);
+
+    /* Adding another evicts what's now the least recently used */
+    rm.set("d", 4, ResourceDataState::Final, ResourcePolicy::Manual, 40);
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 80);
+    CORRADE_COMPARE(rm.evictedCount<Int>(), 2);
+    CORRADE_COMPARE(rm.state<Int>("a"), ResourceState::Final);
+    CORRADE_COMPARE(rm.state<Int>("c"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.state<Int>("d"), ResourceState::Final);
+}
+
+void ResourceManagerTest::budgetLeastFrequentlyUsed() {
+    ResourceManager rm;
+    rm.setMemoryBudget<Int>(100, ResourceEvictionPolicy::LeastFrequentlyUsed);
+    CORRADE_VERIFY(rm.evictionPolicy<Int>() == ResourceEvictionPolicy::LeastFrequentlyUsed);
+
+    rm.set("a", 1, ResourceDataState::Final, ResourcePolicy::Manual, 40);
+    rm.set("b", 2, ResourceDataState::Final, ResourcePolicy::Manual, 40);
+    rm.get<Int>("b");
+    rm.get<Int>("a");
+    rm.get<Int>("a");
+
+    /* "b" is more recently used than "a" but less frequently */
+    Resource<Int> c = rm.get<Int>("c");
+    rm.set("c", 3, ResourceDataState::Final, ResourcePolicy::Manual, 40);
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 80);
+    CORRADE_COMPARE(rm.evictedCount<Int>(), 1);
+    CORRADE_COMPARE(rm.state<Int>("a"), ResourceState::Final);
+    CORRADE_COMPARE(rm.state<Int>("b"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(*c, 3);
+}
+
+void ResourceManagerTest::budgetReferenced() {
+    ResourceManager rm;
+    rm.setMemoryBudget<Int>(50);
+    rm.set("resident", 1, ResourceDataState::Final, ResourcePolicy::Resident, 40);
+
+    {
+        Resource<Int> manual = rm.get<Int>("manual");
+        rm.set("manual", 2, ResourceDataState::Final, ResourcePolicy::Manual, 40);
+
+        /* Nothing can be evicted, so the manager stays over budget */
+        CORRADE_COMPARE(rm.memoryUsage<Int>(), 80);
+        CORRADE_COMPARE(rm.evictedCount<Int>(), 0);
+        CORRADE_COMPARE(*manual, 2);
+    }
+
+    /* Last reference is gone, so it's evicted */
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 40);
+    CORRADE_COMPARE(rm.evictedCount<Int>(), 1);
+    CORRADE_COMPARE(rm.state<Int>("manual"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.state<Int>("resident"), ResourceState::Final);
+}
+
+void ResourceManagerTest::budgetReload() {
+    class IntResourceLoader: public AbstractResourceLoader<Int> {
+        void doLoad(ResourceKey key) override {
+            set(key, 42, ResourceDataState::Final, ResourcePolicy::Manual, 30);
+        }
+    };
+
+    ResourceManager rm;
+    Containers::Pointer<IntResourceLoader> loaderPtr{Containers::InPlaceInit};
+    IntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+    rm.setMemoryBudget<Int>(50);
+
+    {
+        Resource<Int> a = rm.get<Int>("a");
+        CORRADE_COMPARE(*a, 42);
+    } {
+        Resource<Int> b = rm.get<Int>("b");
+        CORRADE_COMPARE(*b, 42);
+    }
+
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 30);
+    CORRADE_COMPARE(rm.evictedCount<Int>(), 1);
+    CORRADE_COMPARE(rm.state<Int>("a"), ResourceState::NotLoaded);
+
+    /* Requesting the evicted resource loads it again, evicting the other */
+    Resource<Int> a = rm.get<Int>("a");
+    CORRADE_COMPARE(a.state(), ResourceState::Final);
+    CORRADE_COMPARE(*a, 42);
+    CORRADE_COMPARE(loader.requestedCount(), 3);
+    CORRADE_COMPARE(rm.evictedCount<Int>(), 2);
+    CORRADE_COMPARE(rm.state<Int>("b"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.hitCount<Int>(), 0);
+    CORRADE_COMPARE(rm.missCount<Int>(), 3);
+}
+
+void ResourceManagerTest::budgetLoadOverBudget() {
+    class IntResourceLoader: public AbstractResourceLoader<Int> {
+        void doLoad(ResourceKey key) override {
+            set(key, 42, ResourceDataState::Final, ResourcePolicy::Manual, 100);
+        }
+    };
+
+    for(ResourceEvictionPolicy policy: {ResourceEvictionPolicy::LeastRecentlyUsed, ResourceEvictionPolicy::LeastFrequentlyUsed}) {
+        CORRADE_ITERATION(policy == ResourceEvictionPolicy::LeastRecentlyUsed ? "LeastRecentlyUsed" : "LeastFrequentlyUsed");
+
+        ResourceManager rm;
+        Containers::Pointer<IntResourceLoader> loaderPtr{Containers::InPlaceInit};
+        IntResourceLoader& loader = *loaderPtr;
+        rm.setLoader<Int>(std::move(loaderPtr));
+        /* The resource alone exceeds the budget and, having no accesses yet,
+           would be the first candidate for the LFU policy */
+        rm.setMemoryBudget<Int>(50, policy);
+
+        {
+            /* The data shouldn't get evicted while being loaded */
+            Resource<Int> a = rm.get<Int>("a");
+            CORRADE_COMPARE(a.state(), ResourceState::Final);
+            CORRADE_COMPARE(*a, 42);
+            CORRADE_COMPARE(rm.memoryUsage<Int>(), 100);
+            CORRADE_COMPARE(rm.evictedCount<Int>(), 0);
+        }
+
+        /* Only after the last reference is gone */
+        CORRADE_COMPARE(rm.memoryUsage<Int>(), 0);
+        CORRADE_COMPARE(rm.evictedCount<Int>(), 1);
+        CORRADE_COMPARE(rm.state<Int>("a"), ResourceState::NotLoaded);
+
+        /* Requesting it again calls the loader again */
+        Resource<Int> a = rm.get<Int>("a");
+        CORRADE_COMPARE(a.state(), ResourceState::Final);
+        CORRADE_COMPARE(*a, 42);
+        CORRADE_COMPARE(loader.requestedCount(), 2);
+    }
+}
+
+void ResourceManagerTest::hitMissCount() {
+    ResourceManager rm;
+    rm.set("a", 1);
+    rm.set<Int>("loading", nullptr, ResourceDataState::Loading, ResourcePolicy::Manual);
+
+    rm.get<Int>("a");
+    rm.get<Int>("a");
+    rm.get<Int>("loading");
+    rm.get<Int>("nonexistent");
+    CORRADE_COMPARE(rm.hitCount<Int>(), 2);
+    CORRADE_COMPARE(rm.missCount<Int>(), 2);
+    CORRADE_COMPARE(rm.hitCount<Data>(), 0);
+    CORRADE_COMPARE(rm.missCount<Data>(), 0);
+}
+
 void ResourceManagerTest::loader() {
     class IntResourceLoader: public AbstractResourceLoader<Int> {
         public:
@@ -536,6 +751,184 @@ void ResourceManagerTest::loaderSetNullptr() {
     CORRADE_COMPARE(*world, 42);
 }
 
+/* Loads "world" as not found and everything else as a value equal to the
+   order in which it was loaded. Loading is blocked while the gate is locked. */
+class AsyncIntResourceLoader: public AbstractResourceLoader<Int> {
+    public:
+        ~AsyncIntResourceLoader() { stopAsync(); }
+
+        std::mutex gate;
+        std::vector<ResourceKey> order;
+
+    private:
+        void doLoad(ResourceKey key) override {
+            std::lock_guard<std::mutex> lock{gate};
+            order.push_back(key);
+            if(key == ResourceKey("world")) setNotFound(key);
+            else set(key, Int(order.size()));
+        }
+};
+
+void ResourceManagerTest::loaderAsync() {
+    ResourceManager rm;
+    Containers::Pointer<AsyncIntResourceLoader> loaderPtr{Containers::InPlaceInit};
+    AsyncIntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    CORRADE_VERIFY(!loader.isAsync());
+    loader.startAsync(2);
+    CORRADE_VERIFY(loader.isAsync());
+
+    Resource<Int> hello = rm.get<Int>("hello");
+    Resource<Int> world = rm.get<Int>("world");
+    CORRADE_COMPARE(loader.requestedCount(), 2);
+
+    /* Everything is loaded now, but not visible until published */
+    loader.wait();
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+    CORRADE_COMPARE(hello.state(), ResourceState::Loading);
+    CORRADE_COMPARE(world.state(), ResourceState::Loading);
+    CORRADE_COMPARE(loader.loadedCount(), 0);
+    CORRADE_COMPARE(loader.notFoundCount(), 0);
+
+    CORRADE_COMPARE(rm.publish(), 2);
+    CORRADE_COMPARE(hello.state(), ResourceState::Final);
+    CORRADE_VERIFY(*hello == 1 || *hello == 2);
+    CORRADE_COMPARE(world.state(), ResourceState::NotFound);
+    CORRADE_COMPARE(loader.requestedCount(), 2);
+    CORRADE_COMPARE(loader.loadedCount(), 1);
+    CORRADE_COMPARE(loader.notFoundCount(), 1);
+
+    /* Nothing more to publish */
+    CORRADE_COMPARE(rm.publish(), 0);
+
+    loader.stopAsync();
+    CORRADE_VERIFY(!loader.isAsync());
+}
+
+void ResourceManagerTest::loaderAsyncPriority() {
+    ResourceManager rm;
+    Containers::Pointer<AsyncIntResourceLoader> loaderPtr{Containers::InPlaceInit};
+    AsyncIntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+    loader.startAsync(1);
+
+    {
+        /* The worker takes the first request and then waits, so all other
+           requests get ordered by priority before being loaded */
+        std::unique_lock<std::mutex> lock{loader.gate};
+        loader.load("first", 10);
+        loader.load("low", -1);
+        loader.load("default", 0);
+        loader.load("high", 5);
+        loader.load("high2", 5);
+
+        /* Requesting a queued resource again only updates its priority */
+        loader.load("low", 3);
+        CORRADE_COMPARE(loader.requestedCount(), 6);
+        CORRADE_COMPARE(loader.pendingCount(), 5);
+    }
+
+    loader.wait();
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+    CORRADE_COMPARE_AS(Containers::arrayView(loader.order),
+        Containers::arrayView<ResourceKey>({"first", "high", "high2", "low", "default"}),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(rm.publish<Int>(), 5);
+    CORRADE_COMPARE(rm.state<Int>("default"), ResourceState::Final);
+    CORRADE_COMPARE(*rm.get<Int>("default"), 5);
+}
+
+void ResourceManagerTest::loaderAsyncCancel() {
+    ResourceManager rm;
+    Containers::Pointer<AsyncIntResourceLoader> loaderPtr{Containers::InPlaceInit};
+    AsyncIntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    /* Not possible to cancel anything without async loading */
+    CORRADE_VERIFY(!loader.cancel("hello"));
+
+    loader.startAsync(1);
+
+    Resource<Int> hello = rm.get<Int>("hello");
+    {
+        /* The "first" request is either queued or being loaded, both get
+           canceled */
+        std::unique_lock<std::mutex> lock{loader.gate};
+        loader.load("first", 10);
+        CORRADE_VERIFY(loader.cancel("first"));
+        CORRADE_VERIFY(loader.cancel("hello"));
+        CORRADE_VERIFY(!loader.cancel("nonexistent"));
+        CORRADE_COMPARE(rm.state<Int>("first"), ResourceState::NotLoaded);
+        CORRADE_COMPARE(hello.state(), ResourceState::NotLoaded);
+    }
+
+    loader.load("world");
+    loader.wait();
+
+    /* Data that finished but weren't published can be canceled as well */
+    CORRADE_VERIFY(loader.cancel("world"));
+    CORRADE_COMPARE(rm.state<Int>("world"), ResourceState::NotLoaded);
+
+    CORRADE_COMPARE(rm.publish(), 0);
+    CORRADE_COMPARE(hello.state(), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.state<Int>("first"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(loader.requestedCount(), 3);
+    CORRADE_COMPARE(loader.loadedCount(), 0);
+    CORRADE_COMPARE(loader.notFoundCount(), 0);
+}
+
+void ResourceManagerTest::loaderAsyncDestruction() {
+    class DataResourceLoader: public AbstractResourceLoader<Data> {
+        public:
+            std::mutex gate;
+
+        private:
+            void doLoad(ResourceKey key) override {
+                std::lock_guard<std::mutex> lock{gate};
+                set(key, Containers::pointer<Data>());
+            }
+    };
+
+    {
+        ResourceManager rm;
+        Containers::Pointer<DataResourceLoader> loaderPtr{Containers::InPlaceInit};
+        DataResourceLoader& loader = *loaderPtr;
+        rm.setLoader<Data>(std::move(loaderPtr));
+        loader.startAsync(1);
+
+        {
+            std::unique_lock<std::mutex> lock{loader.gate};
+            loader.load("first", 1);
+            loader.load("second");
+            loader.load("third");
+        }
+
+        /* The manager stops the loader while it still exists, publishing
+           what got loaded and dropping what was still queued */
+    }
+
+    CORRADE_COMPARE(Data::count, 0);
+}
+
+void ResourceManagerTest::loaderAsyncAlreadyStarted() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    ResourceManager rm;
+    Containers::Pointer<AsyncIntResourceLoader> loaderPtr{Containers::InPlaceInit};
+    AsyncIntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+    loader.startAsync(1);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    loader.startAsync(1);
+    CORRADE_COMPARE(out.str(), "AbstractResourceLoader::startAsync(): asynchronous loading already started\n");
+}
+
 void ResourceManagerTest::debugResourceState() {
     std::ostringstream out;
     Debug{&out} << ResourceState::Loading << ResourceState(0xbe);
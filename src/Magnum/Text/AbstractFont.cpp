@@ -28,6 +28,7 @@
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Unicode.h>
@@ -45,7 +46,7 @@ namespace Magnum { namespace Text {
 std::string AbstractFont::pluginInterface() {
     return
 /* [interface] */
-"cz.mosra.magnum.Text.AbstractFont/0.3"
+"cz.mosra.magnum.Text.AbstractFont/0.3.1"
 /* [interface] */
     ;
 }
@@ -321,4 +322,29 @@ std::pair<Range2D, Range2D> AbstractLayouter::renderGlyph(const UnsignedInt i, V
     return {quadPosition, textureCoordinates};
 }
 
+void AbstractLayouter::renderGlyphs(Vector2& cursorPosition, Range2D& rectangle, const Containers::StridedArrayView1D<Range2D>& quadPositions, const Containers::StridedArrayView1D<Range2D>& textureCoordinates) {
+    CORRADE_ASSERT(quadPositions.size() == _glyphCount && textureCoordinates.size() == _glyphCount,
+        "Text::AbstractLayouter::renderGlyphs(): expected" << _glyphCount << "items but got" << quadPositions.size() << "quad positions and" << textureCoordinates.size() << "texture coordinates", );
+
+    doRenderGlyphs(cursorPosition, quadPositions, textureCoordinates);
+
+    /* Extend rectangle with all quad bounds, same as in renderGlyph() */
+    for(const Range2D& quadPosition: quadPositions) {
+        if(!rectangle.size().isZero()) {
+            rectangle.bottomLeft() = Math::min(rectangle.bottomLeft(), quadPosition.bottomLeft());
+            rectangle.topRight() = Math::max(rectangle.topRight(), quadPosition.topRight());
+        } else rectangle = quadPosition;
+    }
+}
+
+void AbstractLayouter::doRenderGlyphs(Vector2& cursorPosition, const Containers::StridedArrayView1D<Range2D>& quadPositions, const Containers::StridedArrayView1D<Range2D>& textureCoordinates) {
+    for(std::size_t i = 0; i != quadPositions.size(); ++i) {
+        Range2D quadPosition;
+        Vector2 advance;
+        std::tie(quadPosition, textureCoordinates[i], advance) = doRenderGlyph(i);
+        quadPositions[i] = quadPosition.translated(cursorPosition);
+        cursorPosition += advance;
+    }
+}
+
 }}
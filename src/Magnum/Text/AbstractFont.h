@@ -569,7 +569,9 @@ Returned by @ref AbstractFont::layout().
 
 Plugin creates private subclass (no need to expose it to end users) and
 implements @ref doRenderGlyph(). Bounds checking on @p i is done automatically
-in the wrapping @ref renderGlyph() function.
+in the wrapping @ref renderGlyph() function. The plugin can additionally
+implement @ref doRenderGlyphs() to render all glyphs in a single virtual
+call, by default it calls @ref doRenderGlyph() for each glyph.
 */
 class MAGNUM_TEXT_EXPORT AbstractLayouter {
     public:
@@ -602,6 +604,21 @@ class MAGNUM_TEXT_EXPORT AbstractLayouter {
          */
         std::pair<Range2D, Range2D> renderGlyph(UnsignedInt i, Vector2& cursorPosition, Range2D& rectangle);
 
+        /**
+         * @brief Render all glyphs
+         * @param[in,out] cursorPosition    Cursor position
+         * @param[in,out] rectangle         Bounding rectangle
+         * @param[out] quadPositions        Where to put quad positions
+         * @param[out] textureCoordinates   Where to put texture coordinates
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref renderGlyph() for all glyphs in a
+         * sequence, but without a virtual call for each glyph. Expects that
+         * both @p quadPositions and @p textureCoordinates have
+         * @ref glyphCount() items.
+         */
+        void renderGlyphs(Vector2& cursorPosition, Range2D& rectangle, const Containers::StridedArrayView1D<Range2D>& quadPositions, const Containers::StridedArrayView1D<Range2D>& textureCoordinates);
+
     protected:
         /**
          * @brief Constructor
@@ -623,6 +640,21 @@ class MAGNUM_TEXT_EXPORT AbstractLayouter {
          */
         virtual std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) = 0;
 
+        /**
+         * @brief Implementation for @ref renderGlyphs()
+         * @param[in,out] cursorPosition    Cursor position
+         * @param[out] quadPositions        Where to put quad positions
+         * @param[out] textureCoordinates   Where to put texture coordinates
+         * @m_since_latest
+         *
+         * Put quad positions, moved to the cursor position, and texture
+         * coordinates of all glyphs to the output views and advance
+         * @p cursorPosition past the last glyph. The views are guaranteed to
+         * have @ref glyphCount() items. Default implementation calls
+         * @ref doRenderGlyph() for each glyph.
+         */
+        virtual void doRenderGlyphs(Vector2& cursorPosition, const Containers::StridedArrayView1D<Range2D>& quadPositions, const Containers::StridedArrayView1D<Range2D>& textureCoordinates);
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     private:
     #endif
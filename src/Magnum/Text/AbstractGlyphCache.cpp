@@ -25,36 +25,123 @@
 
 #include "AbstractGlyphCache.h"
 
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
-#include "Magnum/TextureTools/Atlas.h"
 
 namespace Magnum { namespace Text {
 
-AbstractGlyphCache::AbstractGlyphCache(const Vector2i& size, const Vector2i& padding): _size{size}, _padding{padding} {
-    /* Default "Not Found" glyph. Can't do just `.insert({0, {}})` because
-       that's ambiguous in C++17, due to a new insert(node_type&&) overload. */
-    glyphs.insert({0, std::pair<Vector2i, Range2Di>{}});
+namespace {
+
+/* Fibonacci hashing, taking the upper half of the product so also glyph IDs
+   with a power-of-two stride get spread over the whole table */
+inline std::size_t glyphHash(const UnsignedInt glyph, const std::size_t mask) {
+    return std::size_t((UnsignedLong(glyph)*11400714819323198485ull) >> 32) & mask;
+}
+
+/* Returns an index into the glyph array or -1 if not found */
+std::ptrdiff_t findGlyph(const Containers::ArrayView<const UnsignedInt> index, const std::vector<std::pair<const UnsignedInt, std::pair<Vector2i, Range2Di>>>& glyphs, const UnsignedInt glyph) {
+    const std::size_t mask = index.size() - 1;
+    for(std::size_t i = glyphHash(glyph, mask); index[i]; i = (i + 1) & mask)
+        if(glyphs[index[i] - 1].first == glyph) return index[i] - 1;
+    return -1;
 }
 
+}
+
+AbstractGlyphCache::AbstractGlyphCache(const Vector2i& size, const Vector2i& padding): _size{size}, _padding{padding}, _packer{size, padding} {
+    /* Default "Not Found" glyph */
+    insertInternal(0, {});
+}
+
+AbstractGlyphCache::AbstractGlyphCache(AbstractGlyphCache&&) noexcept = default;
+
 AbstractGlyphCache::~AbstractGlyphCache() = default;
 
+AbstractGlyphCache& AbstractGlyphCache::operator=(AbstractGlyphCache&&) noexcept = default;
+
+std::pair<Vector2i, Range2Di> AbstractGlyphCache::operator[](const UnsignedInt glyph) const {
+    /* Glyph 0 is always the first */
+    const std::ptrdiff_t found = findGlyph(_glyphIndex, _glyphs, glyph);
+    return _glyphs[found == -1 ? 0 : found].second;
+}
+
+void AbstractGlyphCache::insertInternal(const UnsignedInt glyph, const std::pair<Vector2i, Range2Di>& data) {
+    /* Overwriting "Not Found" glyph */
+    const std::ptrdiff_t found = _glyphIndex.isEmpty() ? -1 : findGlyph(_glyphIndex, _glyphs, glyph);
+    if(found != -1) {
+        CORRADE_INTERNAL_ASSERT(glyph == 0);
+        _glyphs[found].second = data;
+        return;
+    }
+
+    /* Grow the index to keep the load factor at most 0.5. Only the indices
+       need to be reinserted, the glyph data stay where they are. */
+    if(2*(_glyphs.size() + 1) > _glyphIndex.size()) {
+        _glyphIndex = Containers::Array<UnsignedInt>{Containers::ValueInit, _glyphIndex.isEmpty() ? 16 : 2*_glyphIndex.size()};
+        const std::size_t mask = _glyphIndex.size() - 1;
+        for(std::size_t i = 0; i != _glyphs.size(); ++i) {
+            std::size_t slot = glyphHash(_glyphs[i].first, mask);
+            while(_glyphIndex[slot]) slot = (slot + 1) & mask;
+            _glyphIndex[slot] = i + 1;
+        }
+    }
+
+    /* Inserting new glyph */
+    const std::size_t mask = _glyphIndex.size() - 1;
+    std::size_t slot = glyphHash(glyph, mask);
+    while(_glyphIndex[slot]) slot = (slot + 1) & mask;
+    _glyphs.emplace_back(glyph, data);
+    _glyphIndex[slot] = _glyphs.size();
+}
+
 std::vector<Range2Di> AbstractGlyphCache::reserve(const std::vector<Vector2i>& sizes) {
-    CORRADE_ASSERT((glyphs.size() == 1 && glyphs.at(0) == std::pair<Vector2i, Range2Di>()),
-        "Text::AbstractGlyphCache::reserve(): reserving space in non-empty cache is not yet implemented", {});
-    glyphs.reserve(glyphs.size() + sizes.size());
-    return TextureTools::atlas(_size, sizes, _padding);
+    std::vector<Range2Di> ranges(sizes.size());
+    if(!_packer.add(Containers::arrayView(sizes), Containers::arrayView(ranges)))
+        return {};
+
+    _glyphs.reserve(_glyphs.size() + sizes.size());
+    for(const Range2Di& range: ranges)
+        _dirtyRange = Math::join(_dirtyRange, range.padded(_padding));
+    return ranges;
+}
+
+Containers::Optional<Range2Di> AbstractGlyphCache::add(const UnsignedInt glyph, const Vector2i& position, const Vector2i& size) {
+    CORRADE_ASSERT(!glyph || findGlyph(_glyphIndex, _glyphs, glyph) == -1,
+        "Text::AbstractGlyphCache::add(): glyph" << glyph << "is already in the cache", {});
+
+    const Containers::Optional<Range2Di> range = _packer.add(size);
+    if(!range) return {};
+
+    insert(glyph, position, *range);
+    _dirtyRange = Math::join(_dirtyRange, range->padded(_padding));
+    return range;
 }
 
 void AbstractGlyphCache::insert(const UnsignedInt glyph, const Vector2i& position, const Range2Di& rectangle) {
-    const std::pair<Vector2i, Range2Di> glyphData = {position-_padding, rectangle.padded(_padding)};
+    insertInternal(glyph, {position-_padding, rectangle.padded(_padding)});
+}
 
-    /* Overwriting "Not Found" glyph */
-    if(glyph == 0) glyphs[0] = glyphData;
+void AbstractGlyphCache::flushImage(const ImageView2D& image) {
+    CORRADE_ASSERT(image.size() == _size,
+        "Text::AbstractGlyphCache::flushImage(): expected image size" << _size << "but got" << image.size(), );
 
-    /* Inserting new glyph */
-    else CORRADE_INTERNAL_ASSERT_OUTPUT(glyphs.insert({glyph, glyphData}).second);
+    if(_dirtyRange.size().product() == 0) {
+        _dirtyRange = {};
+        return;
+    }
+
+    /* Upload just the dirty part, with the original row length so the
+       skipped pixels get correctly stepped over */
+    PixelStorage storage = image.storage();
+    if(!storage.rowLength()) storage.setRowLength(image.size().x());
+    storage.setSkip(storage.skip() + Vector3i{_dirtyRange.min(), 0});
+    setImage(_dirtyRange.min(), ImageView2D{storage, image.format(), image.formatExtra(), image.pixelSize(), _dirtyRange.size(), image.data()});
+
+    _dirtyRange = {};
 }
 
 void AbstractGlyphCache::setImage(const Vector2i& offset, const ImageView2D& image) {
@@ -31,11 +31,13 @@
  */
 
 #include <vector>
-#include <unordered_map>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/Text/visibility.h"
+#include "Magnum/TextureTools/Atlas.h"
 
 namespace Magnum { namespace Text {
 
@@ -72,6 +74,26 @@ CORRADE_ENUMSET_OPERATORS(GlyphCacheFeatures)
 An API-agnostic base for glyph caches. See @ref GlyphCache and
 @ref DistanceFieldGlyphCache for concrete implementations.
 
+@section Text-AbstractGlyphCache-incremental Incremental filling
+
+Space for glyphs is allocated using a @ref TextureTools::AtlasPacker that
+keeps track of the remaining free space, so @ref reserve() or @ref add() can
+be called repeatedly to put more glyphs into an already filled cache, for
+example when a text needs glyphs that weren't rendered yet. Rectangles
+passed to @ref insert() are expected to come from @ref reserve(), otherwise
+the packer doesn't know about them and may place other glyphs over them.
+
+Ranges allocated by @ref reserve() and @ref add() are accumulated in
+@ref dirtyRange(). After rendering the new glyphs into a CPU-side copy of the
+whole cache image, @ref flushImage() uploads just the part that changed:
+
+@snippet MagnumText.cpp AbstractGlyphCache-incremental
+
+Glyph lookup in @ref operator[]() is done through a flat open-addressing hash
+table pointing into a contiguous glyph array, which is also what
+@ref begin() and @ref end() iterate over, in the order the glyphs were
+inserted.
+
 @section Text-AbstractGlyphCache-subclassing Subclassing
 
 The subclass needs to implement the @ref doSetImage() function and manage the
@@ -88,8 +110,26 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
          */
         explicit AbstractGlyphCache(const Vector2i& size, const Vector2i& padding = {});
 
+        /** @brief Copying is not allowed */
+        AbstractGlyphCache(const AbstractGlyphCache&) = delete;
+
+        /**
+         * @brief Move constructor
+         * @m_since_latest
+         */
+        AbstractGlyphCache(AbstractGlyphCache&&) noexcept;
+
         virtual ~AbstractGlyphCache();
 
+        /** @brief Copying is not allowed */
+        AbstractGlyphCache& operator=(const AbstractGlyphCache&) = delete;
+
+        /**
+         * @brief Move assignment
+         * @m_since_latest
+         */
+        AbstractGlyphCache& operator=(AbstractGlyphCache&&) noexcept;
+
         /** @brief Features supported by this glyph cache implementation */
         GlyphCacheFeatures features() const { return doFeatures(); }
 
@@ -100,7 +140,7 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
         Vector2i padding() const { return _padding; }
 
         /** @brief Count of glyphs in the cache */
-        std::size_t glyphCount() const { return glyphs.size(); }
+        std::size_t glyphCount() const { return _glyphs.size(); }
 
         /**
          * @brief Parameters of given glyph
@@ -116,36 +156,81 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
          * can reset it to some meaningful value in @ref insert().
          * @see @ref padding()
          */
-        std::pair<Vector2i, Range2Di> operator[](UnsignedInt glyph) const {
-            auto it = glyphs.find(glyph);
-            return it == glyphs.end() ? glyphs.at(0) : it->second;
-        }
+        std::pair<Vector2i, Range2Di> operator[](UnsignedInt glyph) const;
 
-        /** @brief Iterator access to cache data */
-        std::unordered_map<UnsignedInt, std::pair<Vector2i, Range2Di>>::const_iterator begin() const {
-            return glyphs.begin();
+        /**
+         * @brief Iterator access to cache data
+         *
+         * The glyphs are iterated in the order in which they were inserted,
+         * with glyph @cpp 0 @ce always being first.
+         */
+        std::vector<std::pair<const UnsignedInt, std::pair<Vector2i, Range2Di>>>::const_iterator begin() const {
+            return _glyphs.begin();
         }
 
         /** @brief Iterator access to cache data */
-        std::unordered_map<UnsignedInt, std::pair<Vector2i, Range2Di>>::const_iterator end() const {
-            return glyphs.end();
+        std::vector<std::pair<const UnsignedInt, std::pair<Vector2i, Range2Di>>>::const_iterator end() const {
+            return _glyphs.end();
         }
 
         /**
          * @brief Layout glyphs with given sizes to the cache
          *
-         * Returns non-overlapping regions in cache texture to store glyphs.
-         * The reserved space is reused on next call to @ref reserve() if no
-         * glyph was stored there, use @ref insert() to store actual glyph on
-         * given position and @ref setImage() to upload glyph image.
+         * Returns non-overlapping regions in cache texture to store glyphs,
+         * placed into the space that's still free. Use @ref insert() to
+         * store actual glyph on given position and @ref setImage() or
+         * @ref flushImage() to upload glyph image. The reserved space stays
+         * occupied even if no glyph is inserted there. The returned regions
+         * are added to @ref dirtyRange().
          *
-         * Glyph @p sizes are expected to be without padding.
+         * Glyph @p sizes are expected to be without padding. If the glyphs
+         * don't fit into the remaining space, a message is printed to
+         * @relativeref{Magnum,Error}, an empty vector is returned and the
+         * cache state is not changed.
+         * @see @ref padding(), @ref add()
+         */
+        std::vector<Range2Di> reserve(const std::vector<Vector2i>& sizes);
+
+        /**
+         * @brief Add a glyph to the cache
+         * @param glyph         Glyph ID
+         * @param position      Position relative to point on baseline
+         * @param size          Glyph size
+         * @return Region of the glyph in texture atlas or
+         *      @ref Containers::NullOpt if it doesn't fit
+         * @m_since_latest
          *
-         * @attention Cache size must be large enough to contain all rendered
-         *      glyphs.
+         * Combines @ref reserve() and @ref insert() for a single glyph,
+         * without any allocation for the reserved region. The region is
+         * added to @ref dirtyRange(). Glyph @p position and @p size, as well
+         * as the returned region, are without padding. Expects that the
+         * glyph isn't in the cache yet, except for glyph @cpp 0 @ce which can
+         * be overwritten.
          * @see @ref padding()
          */
-        std::vector<Range2Di> reserve(const std::vector<Vector2i>& sizes);
+        Containers::Optional<Range2Di> add(UnsignedInt glyph, const Vector2i& position, const Vector2i& size);
+
+        /**
+         * @brief Range that needs to be uploaded
+         * @m_since_latest
+         *
+         * Union of all regions, including padding, returned from
+         * @ref reserve() and @ref add() since the last call to
+         * @ref flushImage(). A zero range if nothing was reserved.
+         */
+        Range2Di dirtyRange() const { return _dirtyRange; }
+
+        /**
+         * @brief Upload the dirty part of cache image
+         * @m_since_latest
+         *
+         * Expects that @p image has the same size as @ref textureSize().
+         * Calls @ref setImage() with a view on just the @ref dirtyRange() of
+         * @p image, using @ref PixelStorage::setSkip() and
+         * @ref PixelStorage::setRowLength(), and resets the dirty range. If
+         * the dirty range is empty, does nothing.
+         */
+        void flushImage(const ImageView2D& image);
 
         /**
          * @brief Insert glyph to cache
@@ -153,9 +238,10 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
          * @param position      Position relative to point on baseline
          * @param rectangle     Region in texture atlas
          *
-         * You can obtain unused non-overlapping regions with @ref reserve().
-         * You can't overwrite already inserted glyph, however you can reset
-         * glyph @cpp 0 @ce to some meaningful value.
+         * You can obtain unused non-overlapping regions with @ref reserve()
+         * or use @ref add() to do both in one step. You can't overwrite
+         * already inserted glyph, however you can reset glyph @cpp 0 @ce to
+         * some meaningful value.
          *
          * Glyph parameters are expected to be without padding.
          *
@@ -198,8 +284,16 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
         /** @brief Implementation for @ref image() */
         virtual Image2D doImage();
 
+        MAGNUM_TEXT_LOCAL void insertInternal(UnsignedInt glyph, const std::pair<Vector2i, Range2Di>& data);
+
         Vector2i _size, _padding;
-        std::unordered_map<UnsignedInt, std::pair<Vector2i, Range2Di>> glyphs;
+        TextureTools::AtlasPacker _packer;
+        Range2Di _dirtyRange;
+        std::vector<std::pair<const UnsignedInt, std::pair<Vector2i, Range2Di>>> _glyphs;
+        /* Open-addressing hash table with linear probing and a power-of-two
+           size, each item is an index into _glyphs plus one, zero marks an
+           empty slot */
+        Containers::Array<UnsignedInt> _glyphIndex;
 };
 
 }}
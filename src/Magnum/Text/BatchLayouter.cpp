@@ -0,0 +1,253 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BatchLayouter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/StringView.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Text/AbstractFont.h"
+
+namespace Magnum { namespace Text {
+
+namespace {
+
+/* 32-bit FNV-1a */
+std::size_t hashText(const Containers::StringView text) {
+    UnsignedInt hash = 2166136261u;
+    for(std::size_t i = 0; i != text.size(); ++i) {
+        hash ^= UnsignedByte(text[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+}
+
+BatchLayouter::BatchLayouter(AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const Alignment alignment): _font{&font}, _cache{&cache}, _size{size}, _alignment{alignment} {}
+
+BatchLayouter::BatchLayouter(BatchLayouter&&) noexcept = default;
+
+BatchLayouter::~BatchLayouter() = default;
+
+BatchLayouter& BatchLayouter::operator=(BatchLayouter&&) noexcept = default;
+
+BatchLayouter& BatchLayouter::clearCache() {
+    arrayResize(_entries, 0);
+    arrayResize(_textData, 0);
+    arrayResize(_positions, 0);
+    arrayResize(_textureCoordinates, 0);
+    for(UnsignedInt& i: _entryIndex) i = 0;
+    return *this;
+}
+
+auto BatchLayouter::layout(const Containers::StringView text) -> const Entry& {
+    const std::size_t hash = hashText(text);
+
+    /* Find the text in the cache */
+    if(!_entryIndex.isEmpty()) {
+        const std::size_t mask = _entryIndex.size() - 1;
+        for(std::size_t i = hash & mask; _entryIndex[i]; i = (i + 1) & mask) {
+            const Entry& entry = _entries[_entryIndex[i] - 1];
+            if(entry.hash == hash && entry.textSize == text.size() && (!text.size() || std::memcmp(_textData + entry.textOffset, text.data(), text.size()) == 0))
+                return entry;
+        }
+    }
+
+    /* Not found, lay it out at the end of the vertex arrays. Total rendered
+       bounds, initial line position, line increment */
+    const std::size_t vertexOffset = _positions.size();
+    Range2D rectangle;
+    Vector2 linePosition;
+    const Vector2 lineAdvance = Vector2::yAxis(_font->lineHeight()*_size/_font->size());
+
+    /* Render each line separately and align it horizontally */
+    const char* const end = text.data() + text.size();
+    for(const char* lineBegin = text.data(); ; lineBegin += 1, linePosition -= lineAdvance) {
+        const char* lineEnd = lineBegin == end ? nullptr :
+            static_cast<const char*>(std::memchr(lineBegin, '\n', end - lineBegin));
+        if(!lineEnd) lineEnd = end;
+
+        /* Empty line, nothing to do */
+        if(lineEnd != lineBegin) {
+            /* Layout the line, reusing the temporary allocations */
+            _line.assign(lineBegin, lineEnd);
+            Containers::Pointer<AbstractLayouter> layouter = _font->layout(*_cache, _size, _line);
+            const std::size_t glyphCount = layouter->glyphCount();
+            if(_quadPositions.size() < glyphCount) {
+                arrayResize(_quadPositions, Containers::NoInit, glyphCount);
+                arrayResize(_quadTextureCoordinates, Containers::NoInit, glyphCount);
+            }
+
+            /* Render all glyphs */
+            Range2D lineRectangle;
+            Vector2 cursorPosition = linePosition;
+            layouter->renderGlyphs(cursorPosition, lineRectangle,
+                _quadPositions.prefix(glyphCount),
+                _quadTextureCoordinates.prefix(glyphCount));
+
+            /* Horizontally align the rendered line, same as in Renderer */
+            Float alignmentOffsetX = 0.0f;
+            if((UnsignedByte(_alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentCenter)
+                alignmentOffsetX = -lineRectangle.centerX();
+            else if((UnsignedByte(_alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentRight)
+                alignmentOffsetX = -lineRectangle.right();
+
+            /* Integer alignment */
+            if(UnsignedByte(_alignment) & Implementation::AlignmentIntegral)
+                alignmentOffsetX = Math::round(alignmentOffsetX);
+
+            /* Put aligned quads to the vertex arrays
+               0---2
+               |   |
+               |   |
+               |   |
+               1---3 */
+            const Vector2 alignmentOffset = Vector2::xAxis(alignmentOffsetX);
+            Containers::ArrayView<Vector2> positions = arrayAppend(_positions, Containers::NoInit, glyphCount*4);
+            Containers::ArrayView<Vector2> textureCoordinates = arrayAppend(_textureCoordinates, Containers::NoInit, glyphCount*4);
+            for(std::size_t i = 0; i != glyphCount; ++i) {
+                const Range2D quadPosition = _quadPositions[i].translated(alignmentOffset);
+                const Range2D& quadTextureCoordinates = _quadTextureCoordinates[i];
+                positions[i*4 + 0] = quadPosition.topLeft();
+                positions[i*4 + 1] = quadPosition.bottomLeft();
+                positions[i*4 + 2] = quadPosition.topRight();
+                positions[i*4 + 3] = quadPosition.bottomRight();
+                textureCoordinates[i*4 + 0] = quadTextureCoordinates.topLeft();
+                textureCoordinates[i*4 + 1] = quadTextureCoordinates.bottomLeft();
+                textureCoordinates[i*4 + 2] = quadTextureCoordinates.topRight();
+                textureCoordinates[i*4 + 3] = quadTextureCoordinates.bottomRight();
+            }
+
+            /* Add final line bounds to total bounds */
+            lineRectangle = lineRectangle.translated(alignmentOffset);
+            if(!rectangle.size().isZero()) {
+                rectangle.bottomLeft() = Math::min(rectangle.bottomLeft(), lineRectangle.bottomLeft());
+                rectangle.topRight() = Math::max(rectangle.topRight(), lineRectangle.topRight());
+            } else rectangle = lineRectangle;
+        }
+
+        if(lineEnd == end) break;
+        lineBegin = lineEnd;
+    }
+
+    /* Vertically align the rendered text */
+    Float alignmentOffsetY = 0.0f;
+    if((UnsignedByte(_alignment) & Implementation::AlignmentVertical) == Implementation::AlignmentMiddle)
+        alignmentOffsetY = -rectangle.centerY();
+    else if((UnsignedByte(_alignment) & Implementation::AlignmentVertical) == Implementation::AlignmentTop)
+        alignmentOffsetY = -rectangle.top();
+
+    /* Integer alignment */
+    if(UnsignedByte(_alignment) & Implementation::AlignmentIntegral)
+        alignmentOffsetY = Math::round(alignmentOffsetY);
+
+    /* Align positions and bounds */
+    rectangle = rectangle.translated(Vector2::yAxis(alignmentOffsetY));
+    for(Vector2& position: _positions.suffix(vertexOffset))
+        position.y() += alignmentOffsetY;
+
+    /* If the cache would be over capacity, clear it and move the newly laid
+       out text to the front. Reusing the memory so this doesn't allocate. */
+    std::size_t glyphOffset = vertexOffset/4;
+    if(_cacheCapacity && vertexOffset && _positions.size()/4 > _cacheCapacity) {
+        const std::size_t vertexCount = _positions.size() - vertexOffset;
+        std::copy(_positions + vertexOffset, _positions.end(), _positions.begin());
+        std::copy(_textureCoordinates + vertexOffset, _textureCoordinates.end(), _textureCoordinates.begin());
+        arrayResize(_positions, vertexCount);
+        arrayResize(_textureCoordinates, vertexCount);
+        arrayResize(_entries, 0);
+        arrayResize(_textData, 0);
+        for(UnsignedInt& i: _entryIndex) i = 0;
+        glyphOffset = 0;
+    }
+
+    /* Grow the index to keep the load factor at most 0.5 */
+    if(2*(_entries.size() + 1) > _entryIndex.size()) {
+        _entryIndex = Containers::Array<UnsignedInt>{Containers::ValueInit, _entryIndex.isEmpty() ? 16 : 2*_entryIndex.size()};
+        const std::size_t mask = _entryIndex.size() - 1;
+        for(std::size_t i = 0; i != _entries.size(); ++i) {
+            std::size_t slot = _entries[i].hash & mask;
+            while(_entryIndex[slot]) slot = (slot + 1) & mask;
+            _entryIndex[slot] = i + 1;
+        }
+    }
+
+    /* Remember the text */
+    const std::size_t mask = _entryIndex.size() - 1;
+    std::size_t slot = hash & mask;
+    while(_entryIndex[slot]) slot = (slot + 1) & mask;
+    const std::size_t textOffset = _textData.size();
+    arrayAppend(_textData, Containers::arrayView(text.data(), text.size()));
+    arrayAppend(_entries, Entry{textOffset, text.size(), glyphOffset, _positions.size()/4 - glyphOffset, hash, rectangle});
+    _entryIndex[slot] = _entries.size();
+    return _entries.back();
+}
+
+std::size_t BatchLayouter::glyphCount(const Containers::ArrayView<const Containers::StringView> texts) {
+    std::size_t count = 0;
+    for(const Containers::StringView text: texts)
+        count += layout(text).glyphCount;
+    return count;
+}
+
+std::size_t BatchLayouter::render(const Containers::ArrayView<const Containers::StringView> texts, const Containers::StridedArrayView1D<const Vector2>& origins, const Containers::StridedArrayView1D<Vector2>& positions, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, const Containers::StridedArrayView1D<UnsignedInt>& glyphOffsets, const Containers::StridedArrayView1D<Range2D>& rectangles) {
+    CORRADE_ASSERT(origins.size() == texts.size(),
+        "Text::BatchLayouter::render(): expected" << texts.size() << "origins but got" << origins.size(), {});
+    CORRADE_ASSERT(positions.size() == textureCoordinates.size(),
+        "Text::BatchLayouter::render(): expected position and texture coordinate views to have the same size but got" << positions.size() << "and" << textureCoordinates.size(), {});
+    CORRADE_ASSERT(glyphOffsets.isEmpty() || glyphOffsets.size() == texts.size(),
+        "Text::BatchLayouter::render(): expected either no or" << texts.size() << "glyph offsets but got" << glyphOffsets.size(), {});
+    CORRADE_ASSERT(rectangles.isEmpty() || rectangles.size() == texts.size(),
+        "Text::BatchLayouter::render(): expected either no or" << texts.size() << "rectangles but got" << rectangles.size(), {});
+
+    std::size_t glyphOffset = 0;
+    for(std::size_t i = 0; i != texts.size(); ++i) {
+        const Entry& entry = layout(texts[i]);
+        CORRADE_ASSERT((glyphOffset + entry.glyphCount)*4 <= positions.size(),
+            "Text::BatchLayouter::render(): expected at least" << (glyphOffset + entry.glyphCount)*4 << "vertices for text" << i << "but got" << positions.size(), {});
+
+        /* Copy the cached vertices, translated to the text origin */
+        const Vector2 origin = origins[i];
+        const std::size_t inputOffset = entry.glyphOffset*4;
+        const std::size_t outputOffset = glyphOffset*4;
+        for(std::size_t j = 0, jMax = entry.glyphCount*4; j != jMax; ++j) {
+            positions[outputOffset + j] = _positions[inputOffset + j] + origin;
+            textureCoordinates[outputOffset + j] = _textureCoordinates[inputOffset + j];
+        }
+
+        if(!glyphOffsets.isEmpty()) glyphOffsets[i] = glyphOffset;
+        if(!rectangles.isEmpty()) rectangles[i] = entry.rectangle.translated(origin);
+        glyphOffset += entry.glyphCount;
+    }
+
+    return glyphOffset;
+}
+
+}}
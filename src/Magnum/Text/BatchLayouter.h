@@ -0,0 +1,219 @@
+#ifndef Magnum_Text_BatchLayouter_h
+#define Magnum_Text_BatchLayouter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Text::BatchLayouter
+ * @m_since_latest
+ */
+
+#include <string>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/Alignment.h"
+#include "Magnum/Text/Text.h"
+#include "Magnum/Text/visibility.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Batched text layouter
+@m_since_latest
+
+Lays out many strings at once into caller-provided vertex position and
+texture coordinate views, caching the layout of each string so unchanged
+texts are only copied to the output on subsequent calls. Unlike
+@ref Renderer, it isn't tied to any GPU API and the output can be put into
+an arbitrary vertex buffer layout.
+
+@section Text-BatchLayouter-usage Usage
+
+Query the glyph count of all texts with @ref glyphCount() to size the output,
+and then @ref render() them, each to its own origin. Each glyph is a quad of
+four vertices in the same order as with @ref Renderer, the index buffer thus
+depends only on the total glyph count and can be generated just once:
+
+@snippet MagnumText.cpp BatchLayouter-usage
+
+@section Text-BatchLayouter-cache Layout cache
+
+The first time a text is encountered, it's laid out with
+@ref AbstractFont::layout(), aligned according to @ref alignment() and its
+vertices are stored in a cache. Subsequent occurences of the same text are
+found through a hash table and only copied to the output, translated by the
+text origin. Once all texts are cached, @ref render() and @ref glyphCount()
+don't do any allocations and don't call into the font plugin at all.
+
+The cache grows without bounds by default. If the texts change often, for
+example when displaying frame counters, set a limit with
+@ref setCacheCapacity() --- when the cached glyph count would exceed it, the
+whole cache is cleared before laying out a new text. The cache memory stays
+allocated so the next fill doesn't allocate again. The capacity should be at
+least the glyph count of a single batch, otherwise texts get laid out again
+on every call.
+
+The cache stores glyph positions and texture coordinates, so it has to be
+cleared with @ref clearCache() when the glyph cache contents change.
+*/
+class MAGNUM_TEXT_EXPORT BatchLayouter {
+    public:
+        /**
+         * @brief Constructor
+         * @param font          Font
+         * @param cache         Glyph cache
+         * @param size          Font size
+         * @param alignment     Text alignment
+         *
+         * The font and the glyph cache are expected to stay in scope for the
+         * whole layouter lifetime.
+         */
+        explicit BatchLayouter(AbstractFont& font, const AbstractGlyphCache& cache, Float size, Alignment alignment = Alignment::LineLeft);
+
+        /** @brief Copying is not allowed */
+        BatchLayouter(const BatchLayouter&) = delete;
+
+        /** @brief Move constructor */
+        BatchLayouter(BatchLayouter&&) noexcept;
+
+        ~BatchLayouter();
+
+        /** @brief Copying is not allowed */
+        BatchLayouter& operator=(const BatchLayouter&) = delete;
+
+        /** @brief Move assignment */
+        BatchLayouter& operator=(BatchLayouter&&) noexcept;
+
+        /** @brief Font */
+        AbstractFont& font() const { return *_font; }
+
+        /** @brief Glyph cache */
+        const AbstractGlyphCache& glyphCache() const { return *_cache; }
+
+        /** @brief Font size */
+        Float size() const { return _size; }
+
+        /** @brief Text alignment */
+        Alignment alignment() const { return _alignment; }
+
+        /**
+         * @brief Cache capacity
+         *
+         * Maximum count of cached glyphs, @cpp 0 @ce means unlimited. Default
+         * is @cpp 0 @ce.
+         */
+        std::size_t cacheCapacity() const { return _cacheCapacity; }
+
+        /**
+         * @brief Set cache capacity
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref Text-BatchLayouter-cache for more information.
+         */
+        BatchLayouter& setCacheCapacity(std::size_t glyphs) {
+            _cacheCapacity = glyphs;
+            return *this;
+        }
+
+        /** @brief Count of cached texts */
+        std::size_t cachedTextCount() const { return _entries.size(); }
+
+        /** @brief Count of cached glyphs */
+        std::size_t cachedGlyphCount() const { return _positions.size()/4; }
+
+        /**
+         * @brief Clear the layout cache
+         * @return Reference to self (for method chaining)
+         *
+         * The memory is kept allocated for the next fill.
+         */
+        BatchLayouter& clearCache();
+
+        /**
+         * @brief Glyph count for given texts
+         *
+         * Texts that aren't in the cache yet are laid out and cached. Use to
+         * calculate the size of outputs passed to @ref render().
+         */
+        std::size_t glyphCount(Containers::ArrayView<const Containers::StringView> texts);
+
+        /**
+         * @brief Lay out a batch of texts
+         * @param[in] texts                 Texts to lay out
+         * @param[in] origins               Origin of each text
+         * @param[out] positions            Where to put vertex positions
+         * @param[out] textureCoordinates   Where to put texture coordinates
+         * @param[out] glyphOffsets         Where to put offset of the first
+         *      glyph of each text. Can be empty.
+         * @param[out] rectangles           Where to put bounding rectangle of
+         *      each text. Can be empty.
+         * @return Total count of rendered glyphs
+         *
+         * Expects that @p origins has the same size as @p texts and
+         * @p positions and @p textureCoordinates have at least four items for
+         * each glyph of all texts, see @ref glyphCount(). If not empty,
+         * @p glyphOffsets and @p rectangles are expected to have the same
+         * size as @p texts. Positions and rectangles are aligned according
+         * to @ref alignment() and translated by the text origin.
+         */
+        std::size_t render(Containers::ArrayView<const Containers::StringView> texts, const Containers::StridedArrayView1D<const Vector2>& origins, const Containers::StridedArrayView1D<Vector2>& positions, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, const Containers::StridedArrayView1D<UnsignedInt>& glyphOffsets = {}, const Containers::StridedArrayView1D<Range2D>& rectangles = {});
+
+    private:
+        struct Entry {
+            std::size_t textOffset, textSize;
+            std::size_t glyphOffset, glyphCount;
+            std::size_t hash;
+            Range2D rectangle;
+        };
+
+        MAGNUM_TEXT_LOCAL const Entry& layout(Containers::StringView text);
+
+        AbstractFont* _font;
+        const AbstractGlyphCache* _cache;
+        Float _size;
+        Alignment _alignment;
+        std::size_t _cacheCapacity{};
+
+        /* Cached texts, their concatenated characters and four vertices for
+           each glyph */
+        Containers::Array<Entry> _entries;
+        Containers::Array<char> _textData;
+        Containers::Array<Vector2> _positions, _textureCoordinates;
+        /* Open-addressing hash table with linear probing and a power-of-two
+           size, each item is an index into _entries plus one, zero marks an
+           empty slot */
+        Containers::Array<UnsignedInt> _entryIndex;
+
+        /* Temporaries reused for laying out each line */
+        std::string _line;
+        Containers::Array<Range2D> _quadPositions, _quadTextureCoordinates;
+};
+
+}}
+
+#endif
@@ -25,6 +25,8 @@
 
 #include <sstream>
 #include <tuple>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
 
@@ -40,7 +42,17 @@ struct AbstractGlyphCacheTest: TestSuite::Tester {
 
     void initialize();
     void access();
+    void accessMany();
     void reserve();
+    void reserveIncremental();
+    void reserveNoFit();
+    void add();
+    void addNoFit();
+    void addAlreadyPresent();
+
+    void flushImage();
+    void flushImageNothingDirty();
+    void flushImageWrongSize();
 
     void setImage();
     void setImageOutOfBounds();
@@ -53,7 +65,17 @@ struct AbstractGlyphCacheTest: TestSuite::Tester {
 AbstractGlyphCacheTest::AbstractGlyphCacheTest() {
     addTests({&AbstractGlyphCacheTest::initialize,
               &AbstractGlyphCacheTest::access,
+              &AbstractGlyphCacheTest::accessMany,
               &AbstractGlyphCacheTest::reserve,
+              &AbstractGlyphCacheTest::reserveIncremental,
+              &AbstractGlyphCacheTest::reserveNoFit,
+              &AbstractGlyphCacheTest::add,
+              &AbstractGlyphCacheTest::addNoFit,
+              &AbstractGlyphCacheTest::addAlreadyPresent,
+
+              &AbstractGlyphCacheTest::flushImage,
+              &AbstractGlyphCacheTest::flushImageNothingDirty,
+              &AbstractGlyphCacheTest::flushImageWrongSize,
 
               &AbstractGlyphCacheTest::setImage,
               &AbstractGlyphCacheTest::setImageOutOfBounds,
@@ -107,6 +129,33 @@ void AbstractGlyphCacheTest::access() {
     CORRADE_COMPARE(rectangle, Range2Di({10, 10}, {23, 45}));
 }
 
+void AbstractGlyphCacheTest::accessMany() {
+    DummyGlyphCache cache(Vector2i(236));
+
+    /* Enough glyphs to make the lookup table grow several times, with IDs
+       both consecutive and with a power-of-two stride */
+    for(UnsignedInt i = 1; i != 300; ++i)
+        cache.insert(i*(i % 2 ? 1 : 256), {Int(i), 0}, {});
+    CORRADE_COMPARE(cache.glyphCount(), 300);
+
+    for(UnsignedInt i = 1; i != 300; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(cache[i*(i % 2 ? 1 : 256)].first, (Vector2i{Int(i), 0}));
+    }
+
+    /* Not found glyph still falls back to glyph 0 */
+    CORRADE_COMPARE(cache[2].first, Vector2i{});
+
+    /* Iteration is in insertion order, with glyph 0 first */
+    UnsignedInt i = 0;
+    for(const std::pair<const UnsignedInt, std::pair<Vector2i, Range2Di>>& glyph: cache) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(glyph.first, i*(i % 2 ? 1 : 256));
+        ++i;
+    }
+    CORRADE_COMPARE(i, 300);
+}
+
 void AbstractGlyphCacheTest::reserve() {
     DummyGlyphCache cache(Vector2i(236));
 
@@ -114,6 +163,151 @@ void AbstractGlyphCacheTest::reserve() {
     CORRADE_VERIFY(!cache.reserve({{5, 3}}).empty());
 }
 
+void AbstractGlyphCacheTest::reserveIncremental() {
+    DummyGlyphCache cache{{64, 32}, {1, 1}};
+    CORRADE_COMPARE(cache.dirtyRange(), Range2Di{});
+
+    std::vector<Range2Di> first = cache.reserve({{30, 30}});
+    CORRADE_COMPARE(first.size(), 1);
+    CORRADE_COMPARE(first[0].size(), (Vector2i{30, 30}));
+    cache.insert(1, {}, first[0]);
+
+    /* Reserving again in a non-empty cache uses the remaining space */
+    std::vector<Range2Di> second = cache.reserve({{30, 30}});
+    CORRADE_COMPARE(second.size(), 1);
+    CORRADE_COMPARE(second[0].size(), (Vector2i{30, 30}));
+    CORRADE_VERIFY(!Math::intersects(first[0].padded({1, 1}), second[0].padded({1, 1})));
+
+    /* The dirty range covers both, including padding */
+    CORRADE_COMPARE(cache.dirtyRange(), Math::join(first[0].padded({1, 1}), second[0].padded({1, 1})));
+}
+
+void AbstractGlyphCacheTest::reserveNoFit() {
+    DummyGlyphCache cache{{16, 16}};
+    CORRADE_COMPARE(cache.reserve({{16, 16}}).size(), 1);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(cache.reserve({{1, 1}}).empty());
+    CORRADE_COMPARE(out.str(), "TextureTools::AtlasPacker::add(): cannot fit item 0 of size Vector(1, 1) into a Vector(16, 16) atlas with 0 items placed out of 1\n");
+
+    /* The dirty range isn't affected by the failed call */
+    CORRADE_COMPARE(cache.dirtyRange(), (Range2Di{{}, {16, 16}}));
+}
+
+void AbstractGlyphCacheTest::add() {
+    DummyGlyphCache cache{{64, 32}, {2, 1}};
+
+    Containers::Optional<Range2Di> range = cache.add(17, {3, -4}, {10, 20});
+    CORRADE_VERIFY(range);
+    CORRADE_COMPARE(range->size(), (Vector2i{10, 20}));
+    CORRADE_COMPARE(cache.glyphCount(), 2);
+
+    /* Same as with insert(), the padding is included in the stored data */
+    Vector2i position;
+    Range2Di rectangle;
+    std::tie(position, rectangle) = cache[17];
+    CORRADE_COMPARE(position, (Vector2i{1, -5}));
+    CORRADE_COMPARE(rectangle, range->padded({2, 1}));
+    CORRADE_COMPARE(cache.dirtyRange(), range->padded({2, 1}));
+
+    /* Overwriting the "Not Found" glyph is allowed */
+    Containers::Optional<Range2Di> notFound = cache.add(0, {}, {5, 5});
+    CORRADE_VERIFY(notFound);
+    CORRADE_COMPARE(cache.glyphCount(), 2);
+    CORRADE_COMPARE(cache[0].second, notFound->padded({2, 1}));
+    CORRADE_COMPARE(cache.dirtyRange(), Math::join(range->padded({2, 1}), notFound->padded({2, 1})));
+}
+
+void AbstractGlyphCacheTest::addNoFit() {
+    DummyGlyphCache cache{{16, 16}};
+
+    CORRADE_VERIFY(!cache.add(1, {}, {17, 1}));
+    CORRADE_COMPARE(cache.glyphCount(), 1);
+    CORRADE_COMPARE(cache.dirtyRange(), Range2Di{});
+}
+
+void AbstractGlyphCacheTest::addAlreadyPresent() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DummyGlyphCache cache{{16, 16}};
+    cache.insert(3, {}, {});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.add(3, {}, {1, 1});
+    CORRADE_COMPARE(out.str(), "Text::AbstractGlyphCache::add(): glyph 3 is already in the cache\n");
+}
+
+void AbstractGlyphCacheTest::flushImage() {
+    struct MyGlyphCache: AbstractGlyphCache {
+        using AbstractGlyphCache::AbstractGlyphCache;
+
+        GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i& offset, const ImageView2D& image) override {
+            ++called;
+            imageOffset = offset;
+            imageSize = image.size();
+            imageFirst = image.pixels<UnsignedByte>()[0][0];
+            imageLast = image.pixels<UnsignedByte>()[image.size().y() - 1][image.size().x() - 1];
+        }
+
+        Int called = 0;
+        Vector2i imageOffset, imageSize;
+        UnsignedByte imageFirst, imageLast;
+    } cache{{8, 4}};
+
+    UnsignedByte data[8*4];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        data[i] = i;
+
+    Containers::Optional<Range2Di> range = cache.add(1, {}, {3, 2});
+    CORRADE_VERIFY(range);
+    cache.flushImage(ImageView2D{PixelFormat::R8Unorm, {8, 4}, data});
+    CORRADE_COMPARE(cache.called, 1);
+    CORRADE_COMPARE(cache.imageOffset, range->min());
+    CORRADE_COMPARE(cache.imageSize, (Vector2i{3, 2}));
+    CORRADE_COMPARE(cache.imageFirst, UnsignedByte(range->min().y()*8 + range->min().x()));
+    CORRADE_COMPARE(cache.imageLast, UnsignedByte((range->max().y() - 1)*8 + range->max().x() - 1));
+    CORRADE_COMPARE(cache.dirtyRange(), Range2Di{});
+}
+
+void AbstractGlyphCacheTest::flushImageNothingDirty() {
+    struct MyGlyphCache: AbstractGlyphCache {
+        using AbstractGlyphCache::AbstractGlyphCache;
+
+        GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {
+            ++called;
+        }
+
+        Int called = 0;
+    } cache{{8, 4}};
+
+    /* Inserting with a rectangle from elsewhere doesn't mark anything as
+       dirty */
+    cache.insert(1, {}, {{}, {2, 2}});
+
+    UnsignedByte data[8*4]{};
+    cache.flushImage(ImageView2D{PixelFormat::R8Unorm, {8, 4}, data});
+    CORRADE_COMPARE(cache.called, 0);
+}
+
+void AbstractGlyphCacheTest::flushImageWrongSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DummyGlyphCache cache{{8, 4}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.flushImage(ImageView2D{PixelFormat::R8Unorm, {8, 3}});
+    CORRADE_COMPARE(out.str(), "Text::AbstractGlyphCache::flushImage(): expected image size Vector(8, 4) but got Vector(8, 3)\n");
+}
+
 void AbstractGlyphCacheTest::setImage() {
     struct MyGlyphCache: AbstractGlyphCache {
         using AbstractGlyphCache::AbstractGlyphCache;
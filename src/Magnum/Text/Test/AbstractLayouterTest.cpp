@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Range.h"
@@ -34,10 +35,12 @@ struct AbstractLayouterTest: TestSuite::Tester {
     explicit AbstractLayouterTest();
 
     void renderGlyph();
+    void renderGlyphs();
 };
 
 AbstractLayouterTest::AbstractLayouterTest() {
-    addTests({&AbstractLayouterTest::renderGlyph});
+    addTests({&AbstractLayouterTest::renderGlyph,
+              &AbstractLayouterTest::renderGlyphs});
 }
 
 void AbstractLayouterTest::renderGlyph() {
@@ -80,6 +83,37 @@ void AbstractLayouterTest::renderGlyph() {
     CORRADE_COMPARE(rectangle, Range2D({2.0f, 0.5f}, {6.1f, 3.0f}));
 }
 
+void AbstractLayouterTest::renderGlyphs() {
+    class Layouter: public AbstractLayouter {
+        public:
+            explicit Layouter(): AbstractLayouter(3) {}
+
+        private:
+            std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
+                return std::make_tuple(Range2D({1.0f, 0.5f}, {1.1f, 1.0f}),
+                                       Range2D({0.3f, 1.1f + i}, {-0.5f, 0.7f + i}),
+                                       Vector2(2.0f, -1.0f));
+            }
+    };
+
+    /* Same as renderGlyph(), just all at once through the default
+       doRenderGlyphs() implementation */
+    Range2D rectangle({-1.0f, -1.0f}, {-1.0f, -1.0f});
+    Vector2 cursorPosition(1.0f, 2.0f);
+
+    Layouter l;
+    Range2D quadPositions[3];
+    Range2D textureCoordinates[3];
+    l.renderGlyphs(cursorPosition, rectangle, quadPositions, textureCoordinates);
+    CORRADE_COMPARE(quadPositions[0], Range2D({2.0f, 2.5f}, {2.1f, 3.0f}));
+    CORRADE_COMPARE(quadPositions[1], Range2D({4.0f, 1.5f}, {4.1f, 2.0f}));
+    CORRADE_COMPARE(quadPositions[2], Range2D({6.0f, 0.5f}, {6.1f, 1.0f}));
+    CORRADE_COMPARE(textureCoordinates[0], Range2D({0.3f, 1.1f}, {-0.5f, 0.7f}));
+    CORRADE_COMPARE(textureCoordinates[2], Range2D({0.3f, 3.1f}, {-0.5f, 2.7f}));
+    CORRADE_COMPARE(cursorPosition, Vector2(7.0f, -1.0f));
+    CORRADE_COMPARE(rectangle, Range2D({2.0f, 0.5f}, {6.1f, 3.0f}));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::AbstractLayouterTest)
@@ -0,0 +1,424 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringStl.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/AbstractGlyphCache.h"
+#include "Magnum/Text/BatchLayouter.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct BatchLayouterTest: TestSuite::Tester {
+    explicit BatchLayouterTest();
+
+    void construct();
+    void constructMove();
+
+    void render();
+    void renderMultiline();
+    void renderEmpty();
+    void renderCached();
+    void renderCacheCapacity();
+    void renderInvalidViews();
+    void renderOutputTooSmall();
+
+    void glyphCount();
+    void clearCache();
+};
+
+BatchLayouterTest::BatchLayouterTest() {
+    addTests({&BatchLayouterTest::construct,
+              &BatchLayouterTest::constructMove,
+
+              &BatchLayouterTest::render,
+              &BatchLayouterTest::renderMultiline,
+              &BatchLayouterTest::renderEmpty,
+              &BatchLayouterTest::renderCached,
+              &BatchLayouterTest::renderCacheCapacity,
+              &BatchLayouterTest::renderInvalidViews,
+              &BatchLayouterTest::renderOutputTooSmall,
+
+              &BatchLayouterTest::glyphCount,
+              &BatchLayouterTest::clearCache});
+}
+
+using namespace Containers::Literals;
+
+/* Each glyph is an unit square scaled by the size, advancing by two units.
+   The texture coordinates are an unit square offset by the character
+   value. */
+class Layouter: public AbstractLayouter {
+    public:
+        explicit Layouter(Float size, const std::string& text): AbstractLayouter(text.size()), _size{size}, _text{text} {}
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
+            return std::make_tuple(
+                Range2D{{}, Vector2{_size}},
+                Range2D::fromSize({Float(_text[i] - 'a'), 0.0f}, Vector2{1.0f}),
+                Vector2::xAxis(2.0f*_size));
+        }
+
+        Float _size;
+        std::string _text;
+};
+
+class Font: public AbstractFont {
+    public:
+        Int layoutCalls = 0;
+
+    private:
+        FontFeatures doFeatures() const override { return {}; }
+
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        Metrics doOpenFile(const std::string&, Float) override {
+            _opened = true;
+            return {0.5f, 0.45f, -0.25f, 0.75f};
+        }
+
+        UnsignedInt doGlyphId(char32_t) override { return 0; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float size, const std::string& text) override {
+            ++layoutCalls;
+            return Containers::Pointer<AbstractLayouter>{new Layouter{size, text}};
+        }
+
+        bool _opened = false;
+};
+
+struct DummyGlyphCache: AbstractGlyphCache {
+    using AbstractGlyphCache::AbstractGlyphCache;
+
+    GlyphCacheFeatures doFeatures() const override { return {}; }
+    void doSetImage(const Vector2i&, const ImageView2D&) override {}
+};
+
+void BatchLayouterTest::construct() {
+    Font font;
+    DummyGlyphCache cache{Vector2i{16}};
+    BatchLayouter layouter{font, cache, 2.5f, Alignment::TopRight};
+
+    CORRADE_COMPARE(&layouter.font(), &font);
+    CORRADE_COMPARE(&layouter.glyphCache(), &cache);
+    CORRADE_COMPARE(layouter.size(), 2.5f);
+    CORRADE_COMPARE(layouter.alignment(), Alignment::TopRight);
+    CORRADE_COMPARE(layouter.cacheCapacity(), 0);
+    CORRADE_COMPARE(layouter.cachedTextCount(), 0);
+    CORRADE_COMPARE(layouter.cachedGlyphCount(), 0);
+}
+
+void BatchLayouterTest::constructMove() {
+    Font font;
+    font.openFile({}, 0.0f);
+    DummyGlyphCache cache{Vector2i{16}};
+    BatchLayouter a{font, cache, 2.5f};
+    a.setCacheCapacity(37);
+    const Containers::StringView texts[]{"abc"_s};
+    CORRADE_COMPARE(a.glyphCount(texts), 3);
+
+    BatchLayouter b{std::move(a)};
+    CORRADE_COMPARE(&b.font(), &font);
+    CORRADE_COMPARE(b.cacheCapacity(), 37);
+    CORRADE_COMPARE(b.cachedTextCount(), 1);
+    CORRADE_COMPARE(b.cachedGlyphCount(), 3);
+
+    Font font2;
+    BatchLayouter c{font2, cache, 1.0f};
+    c = std::move(b);
+    CORRADE_COMPARE(&c.font(), &font);
+    CORRADE_COMPARE(c.cachedTextCount(), 1);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<BatchLayouter>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<BatchLayouter>::value);
+}
+
+void BatchLayouterTest::render() {
+    Font font;
+    font.openFile({}, 0.0f);
+    DummyGlyphCache cache{Vector2i{16}};
+    BatchLayouter layouter{font, cache, 0.5f};
+
+    const Containers::StringView texts[]{"ab"_s, "c"_s};
+    const Vector2 origins[]{{10.0f, 20.0f}, {-1.0f, 0.0f}};
+    Vector2 positions[12];
+    Vector2 textureCoordinates[12];
+    UnsignedInt glyphOffsets[2];
+    Range2D rectangles[2];
+    CORRADE_COMPARE(layouter.render(texts, origins, positions, textureCoordinates, glyphOffsets, rectangles), 3);
+
+    /* 0---2
+       |   |
+       |   |
+       |   |
+       1---3 */
+    CORRADE_COMPARE_AS(Containers::arrayView(positions), Containers::arrayView<Vector2>({
+        {10.0f, 20.5f}, {10.0f, 20.0f}, {10.5f, 20.5f}, {10.5f, 20.0f},
+        {11.0f, 20.5f}, {11.0f, 20.0f}, {11.5f, 20.5f}, {11.5f, 20.0f},
+        {-1.0f,  0.5f}, {-1.0f,  0.0f}, {-0.5f,  0.5f}, {-0.5f,  0.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(textureCoordinates), Containers::arrayView<Vector2>({
+        {0.0f, 1.0f}, {0.0f, 0.0f}, {1.0f, 1.0f}, {1.0f, 0.0f},
+        {1.0f, 1.0f}, {1.0f, 0.0f}, {2.0f, 1.0f}, {2.0f, 0.0f},
+        {2.0f, 1.0f}, {2.0f, 0.0f}, {3.0f, 1.0f}, {3.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(glyphOffsets), Containers::arrayView<UnsignedInt>({
+        0, 2
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(rectangles[0], (Range2D{{10.0f, 20.0f}, {11.5f, 20.5f}}));
+    CORRADE_COMPARE(rectangles[1], (Range2D{{-1.0f, 0.0f}, {-0.5f, 0.5f}}));
+}
+
+void BatchLayouterTest::renderMultiline() {
+    Font font;
+    font.openFile({}, 0.0f);
+    DummyGlyphCache cache{Vector2i{16}};
+    BatchLayouter layouter{font, cache, 1.0f, Alignment::MiddleCenter};
+
+    const Containers::StringView texts[]{"abcd\nef\n\nghi"_s};
+    const Vector2 origins[]{{}};
+    Vector2 positions[9*4];
+    Vector2 textureCoordinates[9*4];
+    Range2D rectangles[1];
+    CORRADE_COMPARE(layouter.render(texts, origins, positions, textureCoordinates, nullptr, rectangles), 9);
+
+    /* The font is scaled to 0.5f, so the line advance should be
+       0.75f*1.0f/0.5f = 1.5f. Glyphs are 1x1 with an advance of 2.
+
+       [a] [b] [c] [d]
+           [e] [f]
+
+         [g] [h] [i]   */
+    CORRADE_COMPARE(rectangles[0], (Range2D{{-3.5f, -2.75f}, {3.5f, 2.75f}}));
+    /* a */
+    CORRADE_COMPARE(positions[0], (Vector2{-3.5f, 2.75f}));
+    CORRADE_COMPARE(positions[3], (Vector2{-2.5f, 1.75f}));
+    /* e */
+    CORRADE_COMPARE(positions[16], (Vector2{-1.5f, 1.25f}));
+    CORRADE_COMPARE(positions[19], (Vector2{-0.5f, 0.25f}));
+    /* i */
+    CORRADE_COMPARE(positions[32], (Vector2{1.5f, -1.75f}));
+    CORRADE_COMPARE(positions[35], (Vector2{2.5f, -2.75f}));
+    CORRADE_COMPARE(textureCoordinates[32], (Vector2{8.0f, 1.0f}));
+
+    /* Empty lines are skipped, so only three layout() calls */
+    CORRADE_COMPARE(font.layoutCalls, 3);
+}
+
+void BatchLayouterTest::renderEmpty() {
+    Font font;
+    font.openFile({}, 0.0f);
+    DummyGlyphCache cache{Vector2i{16}};
+    BatchLayouter layouter{font, cache, 1.0f};
+
+    const Containers::StringView texts[]{""_s, "\n"_s, "a"_s};
+    const Vector2 origins[3]{};
+    Vector2 positions[4];
+    Vector2 textureCoordinates[4];
+    UnsignedInt glyphOffsets[3];
+    CORRADE_COMPARE(layouter.render(texts, origins, positions, textureCoordinates, glyphOffsets), 1);
+    CORRADE_COMPARE_AS(Containers::arrayView(glyphOffsets), Containers::arrayView<UnsignedInt>({
+        0, 0, 0
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(layouter.cachedTextCount(), 3);
+    CORRADE_COMPARE(font.layoutCalls, 1);
+}
+
+void BatchLayouterTest::renderCached() {
+    Font font;
+    font.openFile({}, 0.0f);
+    DummyGlyphCache cache{Vector2i{16}};
+    BatchLayouter layouter{font, cache, 1.0f};
+
+    /* A few hundred texts so the hash table grows several times */
+    std::vector<std::string> strings;
+    for(char a = 'a'; a <= 'z'; ++a)
+        for(char b = 'a'; b <= 'j'; ++b)
+            strings.push_back(std::string{a, b});
+    std::vector<Containers::StringView> texts{strings.begin(), strings.end()};
+    std::vector<Vector2> origins(texts.size());
+    std::vector<Vector2> positions(texts.size()*2*4);
+    std::vector<Vector2> textureCoordinates(texts.size()*2*4);
+
+    CORRADE_COMPARE(layouter.render(texts, Containers::arrayView(origins), Containers::arrayView(positions), Containers::arrayView(textureCoordinates)), texts.size()*2);
+    CORRADE_COMPARE(font.layoutCalls, Int(texts.size()));
+    CORRADE_COMPARE(layouter.cachedTextCount(), texts.size());
+    CORRADE_COMPARE(layouter.cachedGlyphCount(), texts.size()*2);
+
+    /* Rendering again in a different order doesn't lay out anything again */
+    std::reverse(texts.begin(), texts.end());
+    std::vector<Vector2> textureCoordinatesReversed(texts.size()*2*4);
+    CORRADE_COMPARE(layouter.render(texts, Containers::arrayView(origins), Containers::arrayView(positions), Containers::arrayView(textureCoordinatesReversed)), texts.size()*2);
+    CORRADE_COMPARE(font.layoutCalls, Int(texts.size()));
+    CORRADE_COMPARE(layouter.cachedTextCount(), texts.size());
+    for(std::size_t i = 0; i != texts.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(textureCoordinatesReversed[i*8], textureCoordinates[(texts.size() - i - 1)*8]);
+        CORRADE_COMPARE(textureCoordinatesReversed[i*8 + 4], textureCoordinates[(texts.size() - i - 1)*8 + 4]);
+    }
+}
+
+void BatchLayouterTest::renderCacheCapacity() {
+    Font font;
+    font.openFile({}, 0.0f);
+    DummyGlyphCache cache{Vector2i{16}};
+    BatchLayouter layouter{font, cache, 1.0f};
+    layouter.setCacheCapacity(4);
+
+    const Vector2 origins[1]{};
+    Vector2 positions[12];
+    Vector2 textureCoordinates[12];
+
+    const Containers::StringView ab[]{"ab"_s};
+    const Containers::StringView cd[]{"cd"_s};
+    const Containers::StringView efg[]{"efg"_s};
+    layouter.render(ab, origins, positions, textureCoordinates);
+    layouter.render(cd, origins, positions, textureCoordinates);
+    CORRADE_COMPARE(layouter.cachedTextCount(), 2);
+    CORRADE_COMPARE(layouter.cachedGlyphCount(), 4);
+    CORRADE_COMPARE(font.layoutCalls, 2);
+
+    /* Going over capacity clears the cache, the new text is kept */
+    layouter.render(efg, origins, positions, textureCoordinates);
+    CORRADE_COMPARE(layouter.cachedTextCount(), 1);
+    CORRADE_COMPARE(layouter.cachedGlyphCount(), 3);
+    CORRADE_COMPARE(font.layoutCalls, 3);
+    CORRADE_COMPARE(textureCoordinates[0], (Vector2{4.0f, 1.0f}));
+    CORRADE_COMPARE(textureCoordinates[8], (Vector2{6.0f, 1.0f}));
+
+    /* It's found in the cache after the move to the front */
+    layouter.render(efg, origins, positions, textureCoordinates);
+    CORRADE_COMPARE(font.layoutCalls, 3);
+    CORRADE_COMPARE(textureCoordinates[8], (Vector2{6.0f, 1.0f}));
+
+    /* But the old ones not */
+    layouter.render(ab, origins, positions, textureCoordinates);
+    CORRADE_COMPARE(font.layoutCalls, 4);
+    CORRADE_COMPARE(layouter.cachedTextCount(), 1);
+    CORRADE_COMPARE(layouter.cachedGlyphCount(), 2);
+}
+
+void BatchLayouterTest::renderInvalidViews() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Font font;
+    font.openFile({}, 0.0f);
+    DummyGlyphCache cache{Vector2i{16}};
+    BatchLayouter layouter{font, cache, 1.0f};
+
+    const Containers::StringView texts[2]{};
+    const Vector2 origins[2]{};
+    Vector2 positions[4];
+    Vector2 textureCoordinates[4];
+    UnsignedInt glyphOffsets[3];
+    Range2D rectangles[1];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    layouter.render(texts, Containers::arrayView(origins).prefix(1), positions, textureCoordinates);
+    layouter.render(texts, origins, positions, Containers::arrayView(textureCoordinates).prefix(3));
+    layouter.render(texts, origins, positions, textureCoordinates, glyphOffsets);
+    layouter.render(texts, origins, positions, textureCoordinates, nullptr, rectangles);
+    CORRADE_COMPARE(out.str(),
+        "Text::BatchLayouter::render(): expected 2 origins but got 1\n"
+        "Text::BatchLayouter::render(): expected position and texture coordinate views to have the same size but got 4 and 3\n"
+        "Text::BatchLayouter::render(): expected either no or 2 glyph offsets but got 3\n"
+        "Text::BatchLayouter::render(): expected either no or 2 rectangles but got 1\n");
+}
+
+void BatchLayouterTest::renderOutputTooSmall() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Font font;
+    font.openFile({}, 0.0f);
+    DummyGlyphCache cache{Vector2i{16}};
+    BatchLayouter layouter{font, cache, 1.0f};
+
+    const Containers::StringView texts[]{"ab"_s, "cde"_s};
+    const Vector2 origins[2]{};
+    Vector2 positions[19];
+    Vector2 textureCoordinates[19];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    layouter.render(texts, origins, positions, textureCoordinates);
+    CORRADE_COMPARE(out.str(), "Text::BatchLayouter::render(): expected at least 20 vertices for text 1 but got 19\n");
+}
+
+void BatchLayouterTest::glyphCount() {
+    Font font;
+    font.openFile({}, 0.0f);
+    DummyGlyphCache cache{Vector2i{16}};
+    BatchLayouter layouter{font, cache, 1.0f};
+
+    const Containers::StringView texts[]{"ab"_s, "c\nde"_s, "ab"_s};
+    CORRADE_COMPARE(layouter.glyphCount(texts), 7);
+    CORRADE_COMPARE(layouter.cachedTextCount(), 2);
+    CORRADE_COMPARE(font.layoutCalls, 3);
+
+    /* The texts are cached for render() */
+    const Vector2 origins[3]{};
+    Vector2 positions[7*4];
+    Vector2 textureCoordinates[7*4];
+    CORRADE_COMPARE(layouter.render(texts, origins, positions, textureCoordinates), 7);
+    CORRADE_COMPARE(font.layoutCalls, 3);
+}
+
+void BatchLayouterTest::clearCache() {
+    Font font;
+    font.openFile({}, 0.0f);
+    DummyGlyphCache cache{Vector2i{16}};
+    BatchLayouter layouter{font, cache, 1.0f};
+
+    const Containers::StringView texts[]{"ab"_s, "cde"_s};
+    CORRADE_COMPARE(layouter.glyphCount(texts), 5);
+    CORRADE_COMPARE(font.layoutCalls, 2);
+
+    layouter.clearCache();
+    CORRADE_COMPARE(layouter.cachedTextCount(), 0);
+    CORRADE_COMPARE(layouter.cachedGlyphCount(), 0);
+
+    CORRADE_COMPARE(layouter.glyphCount(texts), 5);
+    CORRADE_COMPARE(font.layoutCalls, 4);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::BatchLayouterTest)
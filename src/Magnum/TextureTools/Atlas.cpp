@@ -25,8 +25,15 @@
 
 #include "Atlas.h"
 
+#include <algorithm>
+#include <utility>
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
 #include "Magnum/Math/Functions.h"
-#include "Magnum/Math/Range.h"
 
 namespace Magnum { namespace TextureTools {
 
@@ -50,8 +57,6 @@ std::vector<Range2Di> atlas(const Vector2i& atlasSize, const std::vector<Vector2
         return atlas;
     }
 
-    /** @todo actual magic implementation, not this joke */
-
     atlas.reserve(sizes.size());
     for(std::size_t i = 0; i != sizes.size(); ++i)
         atlas.push_back(Range2Di::fromSize(Vector2i(i%gridSize.x(), i/gridSize.x())*paddedSize+padding, sizes[i]));
@@ -59,4 +64,270 @@ std::vector<Range2Di> atlas(const Vector2i& atlasSize, const std::vector<Vector2
     return atlas;
 }
 
+AtlasPacker::AtlasPacker(const Vector2i& size, const Vector2i& padding, const Flags flags): _size{size}, _padding{padding}, _flags{flags}, _heuristic{Heuristic::BestShortSideFit}, _sortOrder{SortOrder::Area} {
+    CORRADE_ASSERT((size >= Vector2i{}).all() && (padding >= Vector2i{}).all(),
+        "TextureTools::AtlasPacker: expected non-negative size and padding, got" << size << "and" << padding, );
+    clear();
+}
+
+AtlasPacker::AtlasPacker(AtlasPacker&&) noexcept = default;
+
+AtlasPacker::~AtlasPacker() = default;
+
+AtlasPacker& AtlasPacker::operator=(AtlasPacker&&) noexcept = default;
+
+AtlasPacker& AtlasPacker::setHeuristic(const Heuristic heuristic) {
+    _heuristic = heuristic;
+    return *this;
+}
+
+AtlasPacker& AtlasPacker::setSortOrder(const SortOrder order) {
+    _sortOrder = order;
+    return *this;
+}
+
+Float AtlasPacker::occupancy() const {
+    const UnsignedLong area = UnsignedLong(_size.x())*UnsignedLong(_size.y());
+    return area ? Float(Double(_usedArea)/Double(area)) : 0.0f;
+}
+
+AtlasPacker& AtlasPacker::clear() {
+    _count = 0;
+    _usedArea = 0;
+    _free = {};
+    if(_size.product())
+        arrayAppend(_free, Containers::InPlaceInit, Vector2i{}, _size);
+    return *this;
+}
+
+namespace {
+
+/* Scores a placement of given size into a free rectangle, lower is better.
+   The secondary score is used to break ties. Expects that the size fits. */
+std::pair<Long, Long> score(const AtlasPacker::Heuristic heuristic, const Range2Di& free, const Vector2i& size) {
+    const Vector2i leftover = free.size() - size;
+    switch(heuristic) {
+        case AtlasPacker::Heuristic::BestShortSideFit:
+            return {Math::min(leftover.x(), leftover.y()),
+                    Math::max(leftover.x(), leftover.y())};
+        case AtlasPacker::Heuristic::BestLongSideFit:
+            return {Math::max(leftover.x(), leftover.y()),
+                    Math::min(leftover.x(), leftover.y())};
+        case AtlasPacker::Heuristic::BestAreaFit:
+            return {Long(free.sizeX())*free.sizeY() - Long(size.x())*size.y(),
+                    Math::min(leftover.x(), leftover.y())};
+        case AtlasPacker::Heuristic::BottomLeft:
+            return {Long(free.min().y()) + size.y(), free.min().x()};
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}
+
+Containers::Optional<Range2Di> AtlasPacker::addInternal(const Vector2i& size) {
+    /* Items with zero area don't occupy anything */
+    const Vector2i paddedSize = size + 2*_padding;
+    if(!paddedSize.product()) return Range2Di::fromSize(_padding, size);
+
+    /* Find the best free rectangle, optionally trying also the rotated
+       variant */
+    const bool allowRotation = (_flags & Flag::AllowRotation) && size.x() != size.y();
+    const Vector2i rotatedPaddedSize = size.flipped() + 2*_padding;
+    std::size_t best = ~std::size_t{};
+    bool bestRotated = false;
+    std::pair<Long, Long> bestScore;
+    for(std::size_t i = 0; i != _free.size(); ++i) {
+        const Vector2i freeSize = _free[i].size();
+        if((paddedSize <= freeSize).all()) {
+            const std::pair<Long, Long> s = score(_heuristic, _free[i], paddedSize);
+            if(best == ~std::size_t{} || s < bestScore) {
+                best = i;
+                bestRotated = false;
+                bestScore = s;
+            }
+        }
+        if(allowRotation && (rotatedPaddedSize <= freeSize).all()) {
+            const std::pair<Long, Long> s = score(_heuristic, _free[i], rotatedPaddedSize);
+            if(best == ~std::size_t{} || s < bestScore) {
+                best = i;
+                bestRotated = true;
+                bestScore = s;
+            }
+        }
+    }
+
+    if(best == ~std::size_t{}) return {};
+
+    const Range2Di placed = Range2Di::fromSize(_free[best].min(),
+        bestRotated ? rotatedPaddedSize : paddedSize);
+
+    /* Split all free rectangles that overlap the placed item into up to four
+       maximal rectangles around it */
+    Containers::Array<Range2Di> nextFree;
+    arrayReserve(nextFree, _free.size() + 4);
+    for(const Range2Di& f: _free) {
+        if(!Math::intersects(f, placed)) {
+            arrayAppend(nextFree, f);
+            continue;
+        }
+
+        if(placed.left() > f.left())
+            arrayAppend(nextFree, Containers::InPlaceInit, f.min(), Vector2i{placed.left(), f.top()});
+        if(placed.right() < f.right())
+            arrayAppend(nextFree, Containers::InPlaceInit, Vector2i{placed.right(), f.bottom()}, f.max());
+        if(placed.bottom() > f.bottom())
+            arrayAppend(nextFree, Containers::InPlaceInit, f.min(), Vector2i{f.right(), placed.bottom()});
+        if(placed.top() < f.top())
+            arrayAppend(nextFree, Containers::InPlaceInit, Vector2i{f.left(), placed.top()}, f.max());
+    }
+
+    /* Prune rectangles that are fully contained in other ones. If two are
+       the same, only the first one is kept. */
+    Containers::Array<bool> removed{Containers::ValueInit, nextFree.size()};
+    for(std::size_t i = 0; i != nextFree.size(); ++i) {
+        if(removed[i]) continue;
+        for(std::size_t j = i + 1; j != nextFree.size(); ++j) {
+            if(removed[j]) continue;
+            if(nextFree[i].contains(nextFree[j])) {
+                removed[j] = true;
+            } else if(nextFree[j].contains(nextFree[i])) {
+                removed[i] = true;
+                break;
+            }
+        }
+    }
+
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != nextFree.size(); ++i)
+        if(!removed[i]) nextFree[count++] = nextFree[i];
+    arrayResize(nextFree, count);
+
+    _free = std::move(nextFree);
+    ++_count;
+    _usedArea += UnsignedLong(placed.sizeX())*UnsignedLong(placed.sizeY());
+    return Range2Di::fromSize(placed.min() + _padding,
+        bestRotated ? size.flipped() : size);
+}
+
+Containers::Optional<Range2Di> AtlasPacker::add(const Vector2i& size) {
+    CORRADE_ASSERT((size >= Vector2i{}).all(),
+        "TextureTools::AtlasPacker::add(): expected a non-negative size, got" << size, {});
+    return addInternal(size);
+}
+
+bool AtlasPacker::add(const Containers::StridedArrayView1D<const Vector2i>& sizes, const Containers::StridedArrayView1D<Range2Di>& ranges) {
+    CORRADE_ASSERT(sizes.size() == ranges.size(),
+        "TextureTools::AtlasPacker::add(): expected sizes and ranges views to have the same size, got" << sizes.size() << "and" << ranges.size(), {});
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != sizes.size(); ++i)
+        CORRADE_ASSERT((sizes[i] >= Vector2i{}).all(),
+            "TextureTools::AtlasPacker::add(): expected a non-negative size, got" << sizes[i] << "at index" << i, {});
+    #endif
+
+    /* Sort the items. Stable sort so the result is the same across
+       platforms. */
+    Containers::Array<UnsignedInt> order{Containers::NoInit, sizes.size()};
+    for(UnsignedInt i = 0; i != order.size(); ++i) order[i] = i;
+    const auto sortBy = [&](Long(*key)(const Vector2i&)) {
+        std::stable_sort(order.begin(), order.end(), [&](UnsignedInt a, UnsignedInt b) {
+            return key(sizes[a]) > key(sizes[b]);
+        });
+    };
+    switch(_sortOrder) {
+        case SortOrder::None: break;
+        case SortOrder::Area:
+            sortBy([](const Vector2i& size) { return Long(size.x())*size.y(); });
+            break;
+        case SortOrder::MaxSide:
+            sortBy([](const Vector2i& size) {
+                return (Long(Math::max(size.x(), size.y())) << 32)|Math::min(size.x(), size.y());
+            });
+            break;
+        case SortOrder::Perimeter:
+            sortBy([](const Vector2i& size) { return Long(size.x()) + size.y(); });
+            break;
+        case SortOrder::Height:
+            sortBy([](const Vector2i& size) {
+                return (Long(size.y()) << 32)|size.x();
+            });
+            break;
+    }
+
+    /* Remember the state so we can revert if something doesn't fit */
+    Containers::Array<Range2Di> previousFree{Containers::NoInit, _free.size()};
+    Utility::copy(_free, previousFree);
+    const std::size_t previousCount = _count;
+    const UnsignedLong previousUsedArea = _usedArea;
+
+    for(const UnsignedInt i: order) {
+        Containers::Optional<Range2Di> range = addInternal(sizes[i]);
+        if(!range) {
+            Error{} << "TextureTools::AtlasPacker::add(): cannot fit item" << i << "of size" << sizes[i] << "into a" << _size << "atlas with" << _count - previousCount << "items placed out of" << sizes.size();
+            _free = std::move(previousFree);
+            _count = previousCount;
+            _usedArea = previousUsedArea;
+            return false;
+        }
+
+        ranges[i] = *range;
+    }
+
+    return true;
+}
+
+Debug& operator<<(Debug& debug, const AtlasPacker::Heuristic value) {
+    debug << "TextureTools::AtlasPacker::Heuristic" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case AtlasPacker::Heuristic::v: return debug << "::" #v;
+        _c(BestShortSideFit)
+        _c(BestLongSideFit)
+        _c(BestAreaFit)
+        _c(BottomLeft)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const AtlasPacker::SortOrder value) {
+    debug << "TextureTools::AtlasPacker::SortOrder" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case AtlasPacker::SortOrder::v: return debug << "::" #v;
+        _c(None)
+        _c(Area)
+        _c(MaxSide)
+        _c(Perimeter)
+        _c(Height)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const AtlasPacker::Flag value) {
+    debug << "TextureTools::AtlasPacker::Flag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case AtlasPacker::Flag::v: return debug << "::" #v;
+        _c(AllowRotation)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const AtlasPacker::Flags value) {
+    return Containers::enumSetDebugOutput(debug, value, "TextureTools::AtlasPacker::Flags{}", {
+        AtlasPacker::Flag::AllowRotation});
+}
+
 }}
@@ -26,13 +26,15 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::TextureTools::atlas()
+ * @brief Class @ref Magnum::TextureTools::AtlasPacker, function @ref Magnum::TextureTools::atlas()
  */
 
 #include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/EnumSet.h>
 
 #include "Magnum/Magnum.h"
-#include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/TextureTools/visibility.h"
 
 namespace Magnum { namespace TextureTools {
@@ -49,9 +51,274 @@ into required size, empty vector is returned.
 Padding is added twice to each size and the atlas is laid out so the padding
 don't overlap. Returned sizes are the same as original sizes, i.e. without the
 padding.
+
+The textures are laid out on a uniform grid with cell size equal to the largest
+texture, which is simple and predictable but wastes a lot of space if the
+input sizes differ. Use @ref AtlasPacker for a tight packing.
 */
 std::vector<Range2Di> MAGNUM_TEXTURETOOLS_EXPORT atlas(const Vector2i& atlasSize, const std::vector<Vector2i>& sizes, const Vector2i& padding = Vector2i());
 
+/**
+@brief Texture atlas packer
+@m_since_latest
+
+Packs rectangles of varying sizes into a fixed-size atlas using the MaxRects
+algorithm --- the packer keeps a list of maximal free rectangles, places each
+new item into the free rectangle chosen by a @ref Heuristic and then splits
+and prunes the free list. Compared to the grid layout of @ref atlas() it
+typically needs a fraction of the area for inputs of mixed sizes.
+
+@section TextureTools-AtlasPacker-usage Usage
+
+Items can be either added all at once using
+@ref add(const Containers::StridedArrayView1D<const Vector2i>&, const Containers::StridedArrayView1D<Range2Di>&),
+in which case they're first sorted according to @ref sortOrder() for a better
+fit, or one by one using @ref add(const Vector2i&). The packer keeps its state
+between calls, so it's possible to add more items later without having to
+repack the already placed ones.
+
+@snippet MagnumTextureTools.cpp AtlasPacker
+
+@section TextureTools-AtlasPacker-padding Padding and rotation
+
+Padding is added twice to each size, the same as with @ref atlas(), and
+returned ranges don't include it. If @ref Flag::AllowRotation is set, items
+can be rotated by 90° if it results in a better fit. A rotated item is returned
+with its size swapped, so for non-square items the rotation can be detected by
+comparing the returned size with the input size.
+*/
+class MAGNUM_TEXTURETOOLS_EXPORT AtlasPacker {
+    public:
+        /**
+         * @brief Placement heuristic
+         *
+         * @see @ref setHeuristic()
+         */
+        enum class Heuristic: UnsignedByte {
+            /**
+             * Place the item into a free rectangle where the shorter leftover
+             * side is minimal. Works best for most inputs. Default.
+             */
+            BestShortSideFit,
+
+            /**
+             * Place the item into a free rectangle where the longer leftover
+             * side is minimal.
+             */
+            BestLongSideFit,
+
+            /**
+             * Place the item into the smallest free rectangle it fits in.
+             */
+            BestAreaFit,
+
+            /**
+             * Place the item as close to the bottom and then to the left as
+             * possible. Fills the atlas row by row, which makes the occupied
+             * area grow in a predictable way.
+             */
+            BottomLeft
+        };
+
+        /**
+         * @brief Sort order for batch insertion
+         *
+         * All orders except @ref SortOrder::None sort the items in a
+         * descending order, with original order preserved for items that
+         * compare equal.
+         * @see @ref setSortOrder()
+         */
+        enum class SortOrder: UnsignedByte {
+            /** Don't sort, place the items in the order they were passed */
+            None,
+
+            /** Sort by area. Default. */
+            Area,
+
+            /** Sort by the longer side, then by the shorter side */
+            MaxSide,
+
+            /** Sort by perimeter */
+            Perimeter,
+
+            /** Sort by height, then by width */
+            Height
+        };
+
+        /**
+         * @brief Packer flag
+         *
+         * @see @ref Flags, @ref AtlasPacker(const Vector2i&, const Vector2i&, Flags)
+         */
+        enum class Flag: UnsignedByte {
+            /** Allow rotating items by 90° for a better fit */
+            AllowRotation = 1 << 0
+        };
+
+        /**
+         * @brief Packer flags
+         *
+         * @see @ref AtlasPacker(const Vector2i&, const Vector2i&, Flags)
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Constructor
+         * @param size      Atlas size
+         * @param padding   Padding around each item
+         * @param flags     Flags
+         *
+         * The whole atlas is initially free.
+         */
+        explicit AtlasPacker(const Vector2i& size, const Vector2i& padding = {}, Flags flags = {});
+
+        /** @brief Copying is not allowed */
+        AtlasPacker(const AtlasPacker&) = delete;
+
+        /** @brief Move constructor */
+        AtlasPacker(AtlasPacker&&) noexcept;
+
+        ~AtlasPacker();
+
+        /** @brief Copying is not allowed */
+        AtlasPacker& operator=(const AtlasPacker&) = delete;
+
+        /** @brief Move assignment */
+        AtlasPacker& operator=(AtlasPacker&&) noexcept;
+
+        /** @brief Atlas size */
+        Vector2i size() const { return _size; }
+
+        /** @brief Padding around each item */
+        Vector2i padding() const { return _padding; }
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
+        /** @brief Placement heuristic */
+        Heuristic heuristic() const { return _heuristic; }
+
+        /**
+         * @brief Set placement heuristic
+         * @return Reference to self (for method chaining)
+         *
+         * Affects only items added after this call. Default is
+         * @ref Heuristic::BestShortSideFit.
+         */
+        AtlasPacker& setHeuristic(Heuristic heuristic);
+
+        /** @brief Sort order for batch insertion */
+        SortOrder sortOrder() const { return _sortOrder; }
+
+        /**
+         * @brief Set sort order for batch insertion
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref SortOrder::Area.
+         */
+        AtlasPacker& setSortOrder(SortOrder order);
+
+        /** @brief Count of items placed so far */
+        std::size_t count() const { return _count; }
+
+        /**
+         * @brief Area used by items placed so far
+         *
+         * Includes the padding around each item.
+         * @see @ref occupancy()
+         */
+        UnsignedLong usedArea() const { return _usedArea; }
+
+        /**
+         * @brief Atlas occupancy
+         *
+         * Ratio of @ref usedArea() and the total atlas area, in range
+         * @f$ [0, 1] @f$. Returns @cpp 0.0f @ce for an empty atlas.
+         */
+        Float occupancy() const;
+
+        /**
+         * @brief Free rectangles
+         *
+         * Maximal free rectangles, possibly overlapping each other. Mainly
+         * for debugging and visualization purposes.
+         */
+        Containers::ArrayView<const Range2Di> freeRectangles() const {
+            return _free;
+        }
+
+        /**
+         * @brief Add an item
+         *
+         * Returns the placed range without padding, or
+         * @ref Containers::NullOpt if the item doesn't fit into any free
+         * space, in which case the packer state is left unchanged. Items
+         * with zero area including padding don't occupy any space and are
+         * always placed at @ref padding(). Expects that the size is
+         * non-negative.
+         */
+        Containers::Optional<Range2Di> add(const Vector2i& size);
+
+        /**
+         * @brief Add a batch of items
+         * @param[in] sizes     Item sizes
+         * @param[out] ranges   Where to put placed ranges, without padding
+         *
+         * The items are sorted according to @ref sortOrder() and placed one
+         * after another, the output is in the original order. If some item
+         * doesn't fit, a message is printed to @relativeref{Magnum,Error},
+         * the packer is reset to the state before this call and
+         * @cpp false @ce is returned. Expects that @p sizes and @p ranges
+         * have the same size and all sizes are non-negative.
+         */
+        bool add(const Containers::StridedArrayView1D<const Vector2i>& sizes, const Containers::StridedArrayView1D<Range2Di>& ranges);
+
+        /**
+         * @brief Clear the atlas
+         * @return Reference to self (for method chaining)
+         *
+         * Removes all items, making the whole atlas free again.
+         */
+        AtlasPacker& clear();
+
+    private:
+        Containers::Optional<Range2Di> addInternal(const Vector2i& size);
+
+        Vector2i _size, _padding;
+        Flags _flags;
+        Heuristic _heuristic;
+        SortOrder _sortOrder;
+        std::size_t _count;
+        UnsignedLong _usedArea;
+        Containers::Array<Range2Di> _free;
+};
+
+CORRADE_ENUMSET_OPERATORS(AtlasPacker::Flags)
+
+/**
+@debugoperatorclassenum{AtlasPacker,AtlasPacker::Heuristic}
+@m_since_latest
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, AtlasPacker::Heuristic value);
+
+/**
+@debugoperatorclassenum{AtlasPacker,AtlasPacker::SortOrder}
+@m_since_latest
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, AtlasPacker::SortOrder value);
+
+/**
+@debugoperatorclassenum{AtlasPacker,AtlasPacker::Flag}
+@m_since_latest
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, AtlasPacker::Flag value);
+
+/**
+@debugoperatorclassenum{AtlasPacker,AtlasPacker::Flags}
+@m_since_latest
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, AtlasPacker::Flags value);
+
 }}
 
 #endif
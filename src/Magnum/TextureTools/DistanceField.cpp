@@ -25,6 +25,17 @@
 
 #include "DistanceField.h"
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Implementation/parallelFor.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Packing.h"
+
+#ifdef MAGNUM_TARGET_GL
 #include <Corrade/Containers/Reference.h>
 #include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Resource.h>
@@ -45,11 +56,146 @@ static void importTextureToolResources() {
     CORRADE_RESOURCE_INITIALIZE(MagnumTextureTools_RCS)
 }
 #endif
+#endif
 
 namespace Magnum { namespace TextureTools {
 
 namespace {
 
+/* Each thread processes at least this many input pixels */
+constexpr std::size_t MinPixelsPerThread = 65536;
+
+}
+
+void distanceFieldInto(const ImageView2D& input, const MutableImageView2D& output, const UnsignedInt radius, const std::size_t threadCount) {
+    CORRADE_ASSERT(input.format() == PixelFormat::R8Unorm ||
+                   input.format() == PixelFormat::RGB8Unorm ||
+                   input.format() == PixelFormat::RGBA8Unorm,
+        "TextureTools::distanceFieldInto(): expected input format to be R8Unorm, RGB8Unorm or RGBA8Unorm but got" << input.format(), );
+    CORRADE_ASSERT(output.format() == PixelFormat::R8Unorm,
+        "TextureTools::distanceFieldInto(): expected output format to be R8Unorm but got" << output.format(), );
+
+    const Vector2i outputSize = output.size();
+    if(!outputSize.product()) return;
+
+    const Vector2i inputSize = input.size();
+    CORRADE_ASSERT(inputSize.product(),
+        "TextureTools::distanceFieldInto(): input image is empty", );
+
+    /* Only the first byte of each input pixel (i.e., the red channel) is
+       used */
+    const Containers::StridedArrayView2D<const UnsignedByte> in =
+        Containers::arrayCast<2, const UnsignedByte>(input.pixels().prefix({std::size_t(inputSize.y()), std::size_t(inputSize.x()), 1}));
+    const Containers::StridedArrayView2D<UnsignedByte> out = output.pixels<UnsignedByte>();
+
+    /* Input pixel corresponding to each output row and column, same as
+       calculated in the shader */
+    const Vector2 scaling = Vector2(inputSize)/Vector2(outputSize);
+    Containers::Array<Int> inputRows{Containers::NoInit, std::size_t(outputSize.y())};
+    Containers::Array<Int> inputColumns{Containers::NoInit, std::size_t(outputSize.x())};
+    for(std::size_t i = 0; i != inputRows.size(); ++i)
+        inputRows[i] = Math::min(Int(Float(i)*scaling.y()), inputSize.y() - 1);
+    for(std::size_t i = 0; i != inputColumns.size(); ++i)
+        inputColumns[i] = Math::min(Int(Float(i)*scaling.x()), inputSize.x() - 1);
+
+    /* Distances larger than radius + 1 are clamped in the shader, so it's
+       enough to propagate them only up to that value. */
+    const UnsignedInt maxDistance = radius + 1;
+    const UnsignedInt maxDistanceSquared = maxDistance*maxDistance;
+
+    const std::size_t actualThreads = Implementation::parallelThreadCount(threadCount, std::size_t(inputSize.product()), MinPixelsPerThread);
+
+    /* First pass: for every input column calculate the vertical distance to
+       the nearest inside and outside pixel, but save it only for the rows
+       that are sampled by the output. Stored as interleaved inside/outside
+       pairs for each sampled row and input column. */
+    Containers::Array<UnsignedInt> columnDistances{Containers::NoInit, std::size_t(outputSize.y())*inputSize.x()*2};
+    Implementation::parallelForRanges(actualThreads, inputSize.x(), [&](const std::size_t begin, const std::size_t end) {
+        Containers::Array<UnsignedInt> column{Containers::NoInit, std::size_t(inputSize.y())*2};
+        for(std::size_t x = begin; x != end; ++x) {
+            UnsignedInt toInside = maxDistance, toOutside = maxDistance;
+            for(std::size_t y = 0; y != std::size_t(inputSize.y()); ++y) {
+                const bool inside = in[y][x] >= 128;
+                toInside = inside ? 0 : Math::min(toInside + 1, maxDistance);
+                toOutside = inside ? Math::min(toOutside + 1, maxDistance) : 0;
+                column[y*2 + 0] = toInside;
+                column[y*2 + 1] = toOutside;
+            }
+
+            toInside = toOutside = maxDistance;
+            for(std::size_t y = inputSize.y(); y-- != 0; ) {
+                const bool inside = in[y][x] >= 128;
+                toInside = inside ? 0 : Math::min(toInside + 1, maxDistance);
+                toOutside = inside ? Math::min(toOutside + 1, maxDistance) : 0;
+                column[y*2 + 0] = Math::min(column[y*2 + 0], toInside);
+                column[y*2 + 1] = Math::min(column[y*2 + 1], toOutside);
+            }
+
+            for(std::size_t i = 0; i != inputRows.size(); ++i) {
+                UnsignedInt* const distances = columnDistances.data() + (i*inputSize.x() + x)*2;
+                distances[0] = column[inputRows[i]*2 + 0];
+                distances[1] = column[inputRows[i]*2 + 1];
+            }
+        }
+    });
+
+    /* Second pass: for every output row calculate a lower envelope of
+       parabolas rooted at each input column, separately for the inside and
+       outside distances, and evaluate it at the sampled columns */
+    Implementation::parallelForRanges(actualThreads, outputSize.y(), [&](const std::size_t begin, const std::size_t end) {
+        Containers::Array<Int> vertices{Containers::NoInit, std::size_t(inputSize.x())};
+        Containers::Array<Float> boundaries{Containers::NoInit, std::size_t(inputSize.x()) + 1};
+        Containers::Array<UnsignedInt> distancesSquared{Containers::NoInit, std::size_t(outputSize.x())*2};
+        for(std::size_t i = begin; i != end; ++i) {
+            const UnsignedInt* const row = columnDistances.data() + i*inputSize.x()*2;
+
+            for(std::size_t side = 0; side != 2; ++side) {
+                const auto parabola = [&](const Int q) {
+                    const Float d = Float(row[q*2 + side]);
+                    return d*d + Float(q)*Float(q);
+                };
+
+                std::size_t k = 0;
+                vertices[0] = 0;
+                boundaries[0] = -Constants::inf();
+                boundaries[1] = Constants::inf();
+                for(Int q = 1; q != inputSize.x(); ++q) {
+                    Float s;
+                    for(;;) {
+                        s = (parabola(q) - parabola(vertices[k]))/Float(2*(q - vertices[k]));
+                        if(s > boundaries[k]) break;
+                        --k;
+                    }
+                    ++k;
+                    vertices[k] = q;
+                    boundaries[k] = s;
+                    boundaries[k + 1] = Constants::inf();
+                }
+
+                k = 0;
+                for(std::size_t j = 0; j != inputColumns.size(); ++j) {
+                    const Int x = inputColumns[j];
+                    while(boundaries[k + 1] < Float(x)) ++k;
+                    const UnsignedInt dx = Math::min(UnsignedInt(Math::abs(x - vertices[k])), maxDistance);
+                    const UnsignedInt dy = row[vertices[k]*2 + side];
+                    distancesSquared[j*2 + side] = Math::min(dx*dx + dy*dy, maxDistanceSquared);
+                }
+            }
+
+            /* Final signed distance, normalized from [-radius-1, radius+1] to
+               [0, 1], same as in the shader */
+            for(std::size_t j = 0; j != inputColumns.size(); ++j) {
+                const bool inside = in[inputRows[i]][inputColumns[j]] >= 128;
+                const Float distance = std::sqrt(Float(distancesSquared[j*2 + (inside ? 1 : 0)]));
+                out[i][j] = Math::pack<UnsignedByte>((inside ? 0.5f : -0.5f)*distance/Float(maxDistance) + 0.5f);
+            }
+        }
+    });
+}
+
+#ifdef MAGNUM_TARGET_GL
+namespace {
+
 class DistanceFieldShader: public GL::AbstractShaderProgram {
     public:
         typedef GL::Attribute<0, Vector2> Position;
@@ -218,5 +364,6 @@ void DistanceField::operator()(GL::Texture2D& input, GL::Texture2D& output, cons
     /* Draw the mesh */
     _state->shader.draw(_state->mesh);
 }
+#endif
 
 }}
@@ -26,23 +26,62 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::TextureTools::DistanceField
+ * @brief Class @ref Magnum::TextureTools::DistanceField, function @ref Magnum::TextureTools::distanceFieldInto()
  */
 
-#include "Magnum/configure.h"
+#include <cstddef>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
 
 #ifdef MAGNUM_TARGET_GL
 #include <Corrade/Containers/Pointer.h>
 
-#include "Magnum/Magnum.h"
 #include "Magnum/GL/GL.h"
 #ifndef MAGNUM_TARGET_GLES
 #include "Magnum/Math/Vector2.h"
 #endif
-#include "Magnum/TextureTools/visibility.h"
+#endif
 
 namespace Magnum { namespace TextureTools {
 
+/**
+@brief Create a signed distance field on the CPU
+@param input        Input image
+@param output       Output image
+@param radius       Max lookup radius in the input image
+@param threadCount  Count of threads to use. @cpp 0 @ce means all hardware
+    threads.
+@m_since_latest
+
+CPU counterpart to @ref DistanceField, usable without a GL context. Converts
+a binary black/white image (stored in the red channel of @p input) to a signed
+distance field written to @p output. The @p input is expected to be
+@ref PixelFormat::R8Unorm, @ref PixelFormat::RGB8Unorm or
+@ref PixelFormat::RGBA8Unorm, a pixel is considered to be inside if its red
+channel is larger than @cpp 0.5 @ce. The @p output is expected to be
+@ref PixelFormat::R8Unorm and its size defines the resolution of the
+resulting distance field, each output pixel corresponding to the same input
+pixel as in the GPU implementation. Pixels outside of the @p input are
+ignored.
+
+The output values are the same as produced by @ref DistanceField, see
+@ref TextureTools-DistanceField-algorithm for details. Instead of searching
+the neighborhood of each pixel, the distances are calculated using an exact
+separable Euclidean distance transform, first along input columns and then
+along output rows, so the cost doesn't depend on @p radius. If
+@p threadCount is larger than @cpp 1 @ce, both passes are split across the
+threads. On Emscripten the threads are not used.
+
+Based on: *Pedro F. Felzenszwalb, Daniel P. Huttenlocher - Distance Transforms
+of Sampled Functions, Theory of Computing 8, 2012,
+http://cs.brown.edu/people/pfelzens/papers/dt-final.pdf*
+
+@see @ref magnum-distancefieldconverter
+*/
+MAGNUM_TEXTURETOOLS_EXPORT void distanceFieldInto(const ImageView2D& input, const MutableImageView2D& output, UnsignedInt radius, std::size_t threadCount = 1);
+
+#ifdef MAGNUM_TARGET_GL
 /**
 @brief Create a signed distance field
 
@@ -78,8 +117,9 @@ Based on: *Chris Green - Improved Alpha-Tested Magnification for Vector Textures
 and Special Effects, SIGGRAPH 2007,
 http://www.valvesoftware.com/publications/2007/SIGGRAPH2007_AlphaTestedMagnification.pdf*
 
-@attention This is a GPU-only implementation, so it expects an active GL
-    context.
+@attention This is a GPU implementation, so it expects an active GL context.
+    Use @ref distanceFieldInto() for a CPU implementation producing the same
+    output.
 
 @note If internal format of @p output texture is not renderable, this function
     prints a message to error output and does nothing. On desktop OpenGL and
@@ -144,10 +184,8 @@ inline CORRADE_DEPRECATED("use the DistanceField class instead") void distanceFi
     DistanceField{UnsignedInt(radius)}(input, output, rectangle, imageSize);
 }
 #endif
+#endif
 
 }}
-#else
-#error this header is available only in the OpenGL build
-#endif
 
 #endif
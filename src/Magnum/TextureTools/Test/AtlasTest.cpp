@@ -24,7 +24,11 @@
 */
 
 #include <sstream>
+#include <type_traits>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/Range.h"
@@ -39,13 +43,88 @@ struct AtlasTest: TestSuite::Tester {
     void createPadding();
     void createEmpty();
     void createTooSmall();
+
+    void packer();
+    void packerPadding();
+    void packerEmpty();
+    void packerZeroSize();
+    void packerHeuristic();
+    void packerSortOrder();
+    void packerRotation();
+    void packerIncremental();
+    void packerFull();
+    void packerBatchDoesNotFit();
+    void packerClear();
+    void packerMove();
+
+    void debugHeuristic();
+    void debugSortOrder();
+    void debugFlag();
+    void debugFlags();
+};
+
+const struct {
+    const char* name;
+    AtlasPacker::Heuristic heuristic;
+    AtlasPacker::SortOrder sortOrder;
+    Range2Di expected[3];
+} PackerHeuristicData[]{
+    {"best short side fit, no sorting", AtlasPacker::Heuristic::BestShortSideFit, AtlasPacker::SortOrder::None, {
+        Range2Di::fromSize({0, 0}, {12, 18}),
+        Range2Di::fromSize({12, 0}, {32, 15}),
+        Range2Di::fromSize({12, 15}, {23, 25})}},
+    {"best short side fit, sorted by max side", AtlasPacker::Heuristic::BestShortSideFit, AtlasPacker::SortOrder::MaxSide, {
+        Range2Di::fromSize({0, 15}, {12, 18}),
+        Range2Di::fromSize({0, 0}, {32, 15}),
+        Range2Di::fromSize({32, 0}, {23, 25})}},
+    {"best short side fit, sorted by perimeter", AtlasPacker::Heuristic::BestShortSideFit, AtlasPacker::SortOrder::Perimeter, {
+        Range2Di::fromSize({0, 25}, {12, 18}),
+        Range2Di::fromSize({23, 0}, {32, 15}),
+        Range2Di::fromSize({0, 0}, {23, 25})}},
+    {"best long side fit, sorted by area", AtlasPacker::Heuristic::BestLongSideFit, AtlasPacker::SortOrder::Area, {
+        Range2Di::fromSize({23, 0}, {12, 18}),
+        Range2Di::fromSize({0, 25}, {32, 15}),
+        Range2Di::fromSize({0, 0}, {23, 25})}},
+    {"best area fit, sorted by area", AtlasPacker::Heuristic::BestAreaFit, AtlasPacker::SortOrder::Area, {
+        Range2Di::fromSize({23, 0}, {12, 18}),
+        Range2Di::fromSize({0, 25}, {32, 15}),
+        Range2Di::fromSize({0, 0}, {23, 25})}},
+    {"bottom left, no sorting", AtlasPacker::Heuristic::BottomLeft, AtlasPacker::SortOrder::None, {
+        Range2Di::fromSize({0, 0}, {12, 18}),
+        Range2Di::fromSize({12, 0}, {32, 15}),
+        Range2Di::fromSize({12, 15}, {23, 25})}},
+    {"bottom left, sorted by height", AtlasPacker::Heuristic::BottomLeft, AtlasPacker::SortOrder::Height, {
+        Range2Di::fromSize({23, 0}, {12, 18}),
+        Range2Di::fromSize({23, 18}, {32, 15}),
+        Range2Di::fromSize({0, 0}, {23, 25})}},
 };
 
 AtlasTest::AtlasTest() {
     addTests({&AtlasTest::create,
               &AtlasTest::createPadding,
               &AtlasTest::createEmpty,
-              &AtlasTest::createTooSmall});
+              &AtlasTest::createTooSmall,
+
+              &AtlasTest::packer,
+              &AtlasTest::packerPadding,
+              &AtlasTest::packerEmpty,
+              &AtlasTest::packerZeroSize});
+
+    addInstancedTests({&AtlasTest::packerHeuristic},
+        Containers::arraySize(PackerHeuristicData));
+
+    addTests({&AtlasTest::packerSortOrder,
+              &AtlasTest::packerRotation,
+              &AtlasTest::packerIncremental,
+              &AtlasTest::packerFull,
+              &AtlasTest::packerBatchDoesNotFit,
+              &AtlasTest::packerClear,
+              &AtlasTest::packerMove,
+
+              &AtlasTest::debugHeuristic,
+              &AtlasTest::debugSortOrder,
+              &AtlasTest::debugFlag,
+              &AtlasTest::debugFlags});
 }
 
 void AtlasTest::create() {
@@ -94,6 +173,296 @@ void AtlasTest::createTooSmall() {
     CORRADE_COMPARE(o.str(), "TextureTools::atlas(): requested atlas size Vector(64, 32) is too small to fit 3 Vector(25, 31) textures. Generated atlas will be empty.\n");
 }
 
+void AtlasTest::packer() {
+    AtlasPacker packer{{64, 64}};
+    CORRADE_COMPARE(packer.size(), (Vector2i{64, 64}));
+    CORRADE_COMPARE(packer.padding(), Vector2i{});
+    CORRADE_COMPARE(packer.flags(), AtlasPacker::Flags{});
+    CORRADE_COMPARE(packer.heuristic(), AtlasPacker::Heuristic::BestShortSideFit);
+    CORRADE_COMPARE(packer.sortOrder(), AtlasPacker::SortOrder::Area);
+    CORRADE_COMPARE(packer.count(), 0);
+    CORRADE_COMPARE(packer.usedArea(), 0);
+    CORRADE_COMPARE(packer.occupancy(), 0.0f);
+    CORRADE_COMPARE_AS(packer.freeRectangles(), Containers::arrayView<Range2Di>({
+        {{}, {64, 64}}
+    }), TestSuite::Compare::Container);
+
+    const Vector2i sizes[]{
+        {12, 18},
+        {32, 15},
+        {23, 25}
+    };
+    Range2Di ranges[3];
+    CORRADE_VERIFY(packer.add(sizes, ranges));
+
+    /* The largest item goes first */
+    CORRADE_COMPARE_AS(Containers::arrayView(ranges), Containers::arrayView<Range2Di>({
+        Range2Di::fromSize({0, 25}, {12, 18}),
+        Range2Di::fromSize({23, 0}, {32, 15}),
+        Range2Di::fromSize({0, 0}, {23, 25})
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(packer.count(), 3);
+    CORRADE_COMPARE(packer.usedArea(), 12*18 + 32*15 + 23*25);
+    CORRADE_COMPARE(packer.occupancy(), 1271.0f/4096.0f);
+    CORRADE_COMPARE_AS(packer.freeRectangles(), Containers::arrayView<Range2Di>({
+        {{55, 0}, {64, 64}},
+        {{23, 15}, {64, 64}},
+        {{12, 25}, {64, 64}},
+        {{0, 43}, {64, 64}}
+    }), TestSuite::Compare::Container);
+}
+
+void AtlasTest::packerPadding() {
+    AtlasPacker packer{{64, 64}, {2, 1}};
+    CORRADE_COMPARE(packer.padding(), (Vector2i{2, 1}));
+
+    const Vector2i sizes[]{
+        {8, 16},
+        {28, 13},
+        {19, 23}
+    };
+    Range2Di ranges[3];
+    CORRADE_VERIFY(packer.add(sizes, ranges));
+    CORRADE_COMPARE_AS(Containers::arrayView(ranges), Containers::arrayView<Range2Di>({
+        Range2Di::fromSize({2, 26}, {8, 16}),
+        Range2Di::fromSize({25, 1}, {28, 13}),
+        Range2Di::fromSize({2, 1}, {19, 23})
+    }), TestSuite::Compare::Container);
+
+    /* Padding is included in the used area */
+    CORRADE_COMPARE(packer.usedArea(), 12*18 + 32*15 + 23*25);
+}
+
+void AtlasTest::packerEmpty() {
+    AtlasPacker packer{Vector2i{}};
+    CORRADE_VERIFY(packer.freeRectangles().empty());
+    CORRADE_COMPARE(packer.occupancy(), 0.0f);
+    CORRADE_VERIFY(packer.add(nullptr, nullptr));
+    CORRADE_VERIFY(!packer.add({1, 1}));
+}
+
+void AtlasTest::packerZeroSize() {
+    AtlasPacker packer{{16, 16}, {1, 0}};
+
+    /* Zero area even with padding, doesn't occupy anything */
+    CORRADE_COMPARE(packer.add({5, 0}), Range2Di::fromSize({1, 0}, {5, 0}));
+    CORRADE_COMPARE(packer.count(), 0);
+    CORRADE_COMPARE(packer.usedArea(), 0);
+
+    /* Zero size but non-zero area with padding, occupies the padding */
+    CORRADE_COMPARE(packer.add({0, 5}), Range2Di::fromSize({1, 0}, {0, 5}));
+    CORRADE_COMPARE(packer.count(), 1);
+    CORRADE_COMPARE(packer.usedArea(), 2*5);
+}
+
+void AtlasTest::packerHeuristic() {
+    auto&& data = PackerHeuristicData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    AtlasPacker packer{{64, 64}};
+    packer.setHeuristic(data.heuristic)
+        .setSortOrder(data.sortOrder);
+    CORRADE_COMPARE(packer.heuristic(), data.heuristic);
+    CORRADE_COMPARE(packer.sortOrder(), data.sortOrder);
+
+    const Vector2i sizes[]{
+        {12, 18},
+        {32, 15},
+        {23, 25}
+    };
+    Range2Di ranges[3];
+    CORRADE_VERIFY(packer.add(sizes, ranges));
+    CORRADE_COMPARE_AS(Containers::arrayView(ranges),
+        Containers::arrayView(data.expected),
+        TestSuite::Compare::Container);
+}
+
+void AtlasTest::packerSortOrder() {
+    const Vector2i sizes[]{
+        {4, 16},
+        {32, 4},
+        {8, 24}
+    };
+    Range2Di ranges[3];
+
+    /* Without sorting the small item gets in the way of the others */
+    {
+        AtlasPacker packer{{32, 32}};
+        packer.setSortOrder(AtlasPacker::SortOrder::None);
+
+        std::ostringstream out;
+        Error redirectError{&out};
+        CORRADE_VERIFY(!packer.add(sizes, ranges));
+        CORRADE_COMPARE(packer.count(), 0);
+    }
+
+    /* Placing the largest items first makes everything fit */
+    {
+        AtlasPacker packer{{32, 32}};
+        CORRADE_VERIFY(packer.add(sizes, ranges));
+        CORRADE_COMPARE_AS(Containers::arrayView(ranges), Containers::arrayView<Range2Di>({
+            Range2Di::fromSize({8, 0}, {4, 16}),
+            Range2Di::fromSize({0, 24}, {32, 4}),
+            Range2Di::fromSize({0, 0}, {8, 24})
+        }), TestSuite::Compare::Container);
+    }
+}
+
+void AtlasTest::packerRotation() {
+    {
+        AtlasPacker packer{{16, 32}};
+        CORRADE_VERIFY(!packer.add({32, 16}));
+    } {
+        AtlasPacker packer{{16, 32}, {}, AtlasPacker::Flag::AllowRotation};
+        CORRADE_COMPARE(packer.flags(), AtlasPacker::Flag::AllowRotation);
+
+        /* The returned size is flipped */
+        CORRADE_COMPARE(packer.add({32, 16}), Range2Di::fromSize({}, {16, 32}));
+        CORRADE_COMPARE(packer.occupancy(), 1.0f);
+    } {
+        /* Padding is applied after the rotation */
+        AtlasPacker packer{{18, 36}, {1, 2}, AtlasPacker::Flag::AllowRotation};
+        CORRADE_COMPARE(packer.add({32, 16}), Range2Di::fromSize({1, 2}, {16, 32}));
+        CORRADE_COMPARE(packer.occupancy(), 1.0f);
+    }
+}
+
+void AtlasTest::packerIncremental() {
+    AtlasPacker packer{{32, 32}};
+
+    CORRADE_COMPARE(packer.add({16, 16}), Range2Di::fromSize({0, 0}, {16, 16}));
+    CORRADE_COMPARE(packer.add({16, 16}), Range2Di::fromSize({16, 0}, {16, 16}));
+    CORRADE_COMPARE(packer.count(), 2);
+    CORRADE_COMPARE(packer.occupancy(), 0.5f);
+
+    /* Adding a batch later places around existing items */
+    const Vector2i sizes[]{{16, 16}, {16, 16}};
+    Range2Di ranges[2];
+    CORRADE_VERIFY(packer.add(sizes, ranges));
+    CORRADE_COMPARE_AS(Containers::arrayView(ranges), Containers::arrayView<Range2Di>({
+        Range2Di::fromSize({0, 16}, {16, 16}),
+        Range2Di::fromSize({16, 16}, {16, 16})
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(packer.count(), 4);
+    CORRADE_COMPARE(packer.occupancy(), 1.0f);
+    CORRADE_VERIFY(packer.freeRectangles().empty());
+}
+
+void AtlasTest::packerFull() {
+    AtlasPacker packer{{32, 32}};
+    CORRADE_VERIFY(packer.add({32, 30}));
+
+    /* Doesn't fit, state stays unchanged */
+    CORRADE_VERIFY(!packer.add({3, 3}));
+    CORRADE_COMPARE(packer.count(), 1);
+    CORRADE_COMPARE(packer.usedArea(), 32*30);
+    CORRADE_COMPARE_AS(packer.freeRectangles(), Containers::arrayView<Range2Di>({
+        {{0, 30}, {32, 32}}
+    }), TestSuite::Compare::Container);
+
+    /* This fits */
+    CORRADE_COMPARE(packer.add({32, 2}), Range2Di::fromSize({0, 30}, {32, 2}));
+}
+
+void AtlasTest::packerBatchDoesNotFit() {
+    /* Same as createTooSmall(), which fits here */
+    {
+        AtlasPacker packer{{64, 32}, {2, 1}};
+        const Vector2i sizes[]{
+            {8, 16},
+            {21, 13},
+            {19, 29}
+        };
+        Range2Di ranges[3];
+        CORRADE_VERIFY(packer.add(sizes, ranges));
+        CORRADE_COMPARE_AS(Containers::arrayView(ranges), Containers::arrayView<Range2Di>({
+            Range2Di::fromSize({50, 1}, {8, 16}),
+            Range2Di::fromSize({25, 1}, {21, 13}),
+            Range2Di::fromSize({2, 1}, {19, 29})
+        }), TestSuite::Compare::Container);
+    }
+
+    AtlasPacker packer{{32, 32}};
+    CORRADE_VERIFY(packer.add({16, 32}));
+
+    const Vector2i sizes[]{
+        {16, 16},
+        {16, 17}
+    };
+    Range2Di ranges[2];
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!packer.add(sizes, ranges));
+    }
+    CORRADE_COMPARE(out.str(), "TextureTools::AtlasPacker::add(): cannot fit item 0 of size Vector(16, 16) into a Vector(32, 32) atlas with 1 items placed out of 2\n");
+
+    /* The state is reverted */
+    CORRADE_COMPARE(packer.count(), 1);
+    CORRADE_COMPARE(packer.usedArea(), 16*32);
+    CORRADE_COMPARE_AS(packer.freeRectangles(), Containers::arrayView<Range2Di>({
+        {{16, 0}, {32, 32}}
+    }), TestSuite::Compare::Container);
+}
+
+void AtlasTest::packerClear() {
+    AtlasPacker packer{{32, 32}};
+    CORRADE_VERIFY(packer.add({16, 32}));
+    CORRADE_COMPARE(packer.count(), 1);
+
+    packer.clear();
+    CORRADE_COMPARE(packer.count(), 0);
+    CORRADE_COMPARE(packer.usedArea(), 0);
+    CORRADE_COMPARE_AS(packer.freeRectangles(), Containers::arrayView<Range2Di>({
+        {{}, {32, 32}}
+    }), TestSuite::Compare::Container);
+}
+
+void AtlasTest::packerMove() {
+    AtlasPacker a{{32, 32}, {1, 2}};
+    CORRADE_VERIFY(a.add({16, 16}));
+
+    AtlasPacker b{std::move(a)};
+    CORRADE_COMPARE(b.size(), (Vector2i{32, 32}));
+    CORRADE_COMPARE(b.padding(), (Vector2i{1, 2}));
+    CORRADE_COMPARE(b.count(), 1);
+    CORRADE_COMPARE(b.freeRectangles().size(), 2);
+
+    AtlasPacker c{{16, 16}};
+    c = std::move(b);
+    CORRADE_COMPARE(c.size(), (Vector2i{32, 32}));
+    CORRADE_COMPARE(c.count(), 1);
+    CORRADE_COMPARE(c.freeRectangles().size(), 2);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<AtlasPacker>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<AtlasPacker>::value);
+}
+
+void AtlasTest::debugHeuristic() {
+    std::ostringstream out;
+    Debug{&out} << AtlasPacker::Heuristic::BestAreaFit << AtlasPacker::Heuristic(0xde);
+    CORRADE_COMPARE(out.str(), "TextureTools::AtlasPacker::Heuristic::BestAreaFit TextureTools::AtlasPacker::Heuristic(0xde)\n");
+}
+
+void AtlasTest::debugSortOrder() {
+    std::ostringstream out;
+    Debug{&out} << AtlasPacker::SortOrder::Perimeter << AtlasPacker::SortOrder(0xde);
+    CORRADE_COMPARE(out.str(), "TextureTools::AtlasPacker::SortOrder::Perimeter TextureTools::AtlasPacker::SortOrder(0xde)\n");
+}
+
+void AtlasTest::debugFlag() {
+    std::ostringstream out;
+    Debug{&out} << AtlasPacker::Flag::AllowRotation << AtlasPacker::Flag(0xf0);
+    CORRADE_COMPARE(out.str(), "TextureTools::AtlasPacker::Flag::AllowRotation TextureTools::AtlasPacker::Flag(0xf0)\n");
+}
+
+void AtlasTest::debugFlags() {
+    std::ostringstream out;
+    Debug{&out} << (AtlasPacker::Flag::AllowRotation|AtlasPacker::Flag(0xf0)) << AtlasPacker::Flags{};
+    CORRADE_COMPARE(out.str(), "TextureTools::AtlasPacker::Flag::AllowRotation|TextureTools::AtlasPacker::Flag(0xf0) TextureTools::AtlasPacker::Flags{}\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::TextureTools::Test::AtlasTest)
@@ -0,0 +1,223 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/DebugTools/CompareImage.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/TextureTools/DistanceField.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct DistanceFieldTest: TestSuite::Tester {
+    explicit DistanceFieldTest();
+
+    void test();
+    void rgba();
+    void scaled();
+    void emptyOutput();
+    void threads();
+    void file();
+
+    void benchmark();
+
+    private:
+        PluginManager::Manager<Trade::AbstractImporter> _manager{"nonexistent"};
+        std::string _testDir;
+};
+
+constexpr UnsignedByte InputData[]{
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0, 255, 255,   0,   0,   0,   0,   0,
+      0, 255, 255, 255,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0
+};
+
+/* Same values as the GL implementation would produce */
+constexpr UnsignedByte OutputData[]{
+     67,  85,  85,  67,  32,   7,   0,   0,
+     85, 170, 170,  85,  67,  32,   0,   0,
+     85, 170, 170, 170,  85,  42,   0,   0,
+     67,  85,  85,  85,  67,  32,   0,   0
+};
+
+DistanceFieldTest::DistanceFieldTest() {
+    addTests({&DistanceFieldTest::test,
+              &DistanceFieldTest::rgba,
+              &DistanceFieldTest::scaled,
+              &DistanceFieldTest::emptyOutput,
+              &DistanceFieldTest::threads,
+              &DistanceFieldTest::file});
+
+    addBenchmarks({&DistanceFieldTest::benchmark}, 5);
+
+    /* Load the plugin directly from the build tree. Otherwise it's either
+       static and already loaded or not present in the build tree */
+    #ifdef ANYIMAGEIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(ANYIMAGEIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    #ifdef TGAIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(TGAIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    #ifdef CORRADE_TARGET_APPLE
+    if(Utility::Directory::isSandboxed()
+        #if defined(CORRADE_TARGET_IOS) && defined(CORRADE_TESTSUITE_TARGET_XCTEST)
+        /** @todo Fix this once I persuade CMake to run XCTest tests properly */
+        && std::getenv("SIMULATOR_UDID")
+        #endif
+    ) {
+        _testDir = Utility::Directory::join(Utility::Directory::path(Utility::Directory::executableLocation()), "DistanceFieldGLTestFiles");
+    } else
+    #endif
+    {
+        _testDir = DISTANCEFIELDGLTEST_FILES_DIR;
+    }
+}
+
+void DistanceFieldTest::test() {
+    UnsignedByte outputData[8*4]{};
+    distanceFieldInto(ImageView2D{PixelFormat::R8Unorm, {8, 4}, InputData},
+        MutableImageView2D{PixelFormat::R8Unorm, {8, 4}, outputData}, 2);
+
+    CORRADE_COMPARE_AS(Containers::arrayView(outputData),
+        Containers::arrayView(OutputData),
+        TestSuite::Compare::Container);
+}
+
+void DistanceFieldTest::rgba() {
+    /* Only the red channel should be taken into account */
+    Color4ub inputData[8*4];
+    for(std::size_t i = 0; i != Containers::arraySize(inputData); ++i)
+        inputData[i] = {InputData[i], UnsignedByte(255 - InputData[i]), 0x33, 0xff};
+
+    UnsignedByte outputData[8*4]{};
+    distanceFieldInto(ImageView2D{PixelFormat::RGBA8Unorm, {8, 4}, inputData},
+        MutableImageView2D{PixelFormat::R8Unorm, {8, 4}, outputData}, 2);
+
+    CORRADE_COMPARE_AS(Containers::arrayView(outputData),
+        Containers::arrayView(OutputData),
+        TestSuite::Compare::Container);
+}
+
+void DistanceFieldTest::scaled() {
+    /* A 12x12 disc downsampled to 4x3, the output pixels sampling every third
+       column and every fourth row */
+    UnsignedByte inputData[12*12];
+    for(Int y = 0; y != 12; ++y) for(Int x = 0; x != 12; ++x)
+        inputData[y*12 + x] = (Vector2{Float(x), Float(y)} - Vector2{5.5f}).dot() < 16.0f ? 255 : 0;
+
+    UnsignedByte outputData[4*3]{};
+    distanceFieldInto(ImageView2D{PixelFormat::R8Unorm, {12, 12}, inputData},
+        MutableImageView2D{PixelFormat::R8Unorm, {4, 3}, outputData}, 4);
+
+    CORRADE_COMPARE_AS(Containers::arrayView(outputData),
+        Containers::arrayView<UnsignedByte>({
+             19,  70,  77,  55,
+             77, 164, 200, 153,
+             70, 153, 179, 102
+        }), TestSuite::Compare::Container);
+}
+
+void DistanceFieldTest::emptyOutput() {
+    /* Shouldn't crash or do anything */
+    distanceFieldInto(ImageView2D{PixelFormat::R8Unorm, {8, 4}, InputData},
+        MutableImageView2D{PixelFormat::R8Unorm, {}, nullptr}, 2);
+    CORRADE_VERIFY(true);
+}
+
+void DistanceFieldTest::threads() {
+    /* Has to be large enough for the threads to be actually used */
+    Containers::Array<UnsignedByte> inputData{Containers::NoInit, 512*512};
+    for(Int y = 0; y != 512; ++y) for(Int x = 0; x != 512; ++x)
+        inputData[y*512 + x] = ((x/37 + y/23) % 3) ? 255 : 0;
+
+    const ImageView2D input{PixelFormat::R8Unorm, {512, 512}, inputData};
+
+    UnsignedByte expected[128*128];
+    distanceFieldInto(input, MutableImageView2D{PixelFormat::R8Unorm, {128, 128}, expected}, 16);
+
+    UnsignedByte actual[128*128];
+    distanceFieldInto(input, MutableImageView2D{PixelFormat::R8Unorm, {128, 128}, actual}, 16, 4);
+
+    CORRADE_COMPARE_AS(Containers::arrayView(actual),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void DistanceFieldTest::file() {
+    Containers::Pointer<Trade::AbstractImporter> importer;
+    if(!(importer = _manager.loadAndInstantiate("TgaImporter")))
+        CORRADE_SKIP("TgaImporter plugin not found.");
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(_testDir, "input.tga")));
+    CORRADE_COMPARE(importer->image2DCount(), 1);
+    Containers::Optional<Trade::ImageData2D> inputImage = importer->image2D(0);
+    CORRADE_VERIFY(inputImage);
+    CORRADE_COMPARE(inputImage->format(), PixelFormat::R8Unorm);
+
+    Image2D actual{PixelFormat::R8Unorm, Vector2i{64}, Containers::Array<char>{64*64}};
+    distanceFieldInto(*inputImage, actual, 32);
+
+    if(_manager.loadState("AnyImageImporter") == PluginManager::LoadState::NotFound)
+        CORRADE_SKIP("AnyImageImporter plugin not found.");
+
+    /* Unlike with the GL implementation, there are no rounding differences
+       compared to the ground truth */
+    CORRADE_COMPARE_WITH(actual,
+        Utility::Directory::join(_testDir, "output.tga"),
+        DebugTools::CompareImageToFile{_manager});
+}
+
+void DistanceFieldTest::benchmark() {
+    Containers::Pointer<Trade::AbstractImporter> importer;
+    if(!(importer = _manager.loadAndInstantiate("TgaImporter")))
+        CORRADE_SKIP("TgaImporter plugin not found.");
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(_testDir, "input.tga")));
+    Containers::Optional<Trade::ImageData2D> inputImage = importer->image2D(0);
+    CORRADE_VERIFY(inputImage);
+
+    Image2D output{PixelFormat::R8Unorm, Vector2i{64}, Containers::Array<char>{64*64}};
+    CORRADE_BENCHMARK(5)
+        distanceFieldInto(*inputImage, output, 32);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::DistanceFieldTest)
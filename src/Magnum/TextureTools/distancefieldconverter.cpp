@@ -91,8 +91,8 @@ information.
 
 @code{.sh}
 magnum-distancefieldconverter [--magnum-...] [-h|--help] [--importer IMPORTER]
-    [--converter CONVERTER] [--plugin-dir DIR] --output-size "X Y" --radius N
-    [--] input output
+    [--converter CONVERTER] [--plugin-dir DIR] [--cpu] [--threads N]
+    --output-size "X Y" --radius N [--] input output
 @endcode
 
 Arguments:
@@ -105,6 +105,11 @@ Arguments:
 -   `--converter CONVERTER` --- image converter plugin (default:
     @ref Trade::AnyImageConverter "AnyImageConverter")
 -   `--plugin-dir DIR` --- override base plugin dir
+-   `--cpu` --- calculate the distance field on the CPU using
+    @ref TextureTools::distanceFieldInto() instead of the GPU. No GL context
+    is created in that case.
+-   `--threads N` --- count of threads to use for the CPU calculation,
+    @cpp 0 @ce means all hardware threads (default: @cpp 0 @ce)
 -   `--output-size "X Y"` --- size of output image
 -   `--radius N` --- distance field computation radius
 -   `--magnum-...` --- engine-specific options (see
@@ -127,6 +132,13 @@ This will open monochrome `logo-src.png` image using any plugin that can open
 PNG files and converts it to 256x256 distance field `logo.png` using any plugin
 that can write PNG files.
 
+On machines without a GPU, pass `--cpu` to do the same calculation on all CPU
+cores without creating a GL context:
+
+@code{.sh}
+magnum-distancefieldconverter --cpu --output-size "256 256" --radius 24 logo-src.png logo.png
+@endcode
+
 @note This executable is available only if Magnum is compiled with
     @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
     for more information.
@@ -150,13 +162,15 @@ DistanceFieldConverter::DistanceFieldConverter(const Arguments& arguments): Plat
         .addOption("importer", "AnyImageImporter").setHelp("importer", "image importer plugin")
         .addOption("converter", "AnyImageConverter").setHelp("converter", "image converter plugin")
         .addOption("plugin-dir").setHelp("plugin-dir", "override base plugin dir", "DIR")
+        .addBooleanOption("cpu").setHelp("cpu", "calculate the distance field on the CPU, without creating a GL context")
+        .addOption("threads", "0").setHelp("threads", "count of threads to use for the CPU calculation, 0 means all hardware threads", "N")
         .addNamedArgument("output-size").setHelp("output-size", "size of output image", "\"X Y\"")
         .addNamedArgument("radius").setHelp("radius", "distance field computation radius", "N")
         .addSkippedPrefix("magnum", "engine-specific options")
         .setGlobalHelp("Converts red channel of an image to distance field representation.")
         .parse(arguments.argc, arguments.argv);
 
-    createContext();
+    if(!args.isSet("cpu")) createContext();
 }
 
 int DistanceFieldConverter::exec() {
@@ -181,6 +195,31 @@ int DistanceFieldConverter::exec() {
         return 3;
     }
 
+    const Vector2i outputSize = args.value<Vector2i>("output-size");
+    const UnsignedInt radius = args.value<UnsignedInt>("radius");
+
+    /* Calculate on the CPU, if requested */
+    if(args.isSet("cpu")) {
+        if(image->format() != PixelFormat::R8Unorm &&
+           image->format() != PixelFormat::RGB8Unorm &&
+           image->format() != PixelFormat::RGBA8Unorm) {
+            Error() << "Unsupported image format" << image->format();
+            return 4;
+        }
+
+        Image2D result{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, outputSize, Containers::Array<char>{std::size_t(outputSize.product())}};
+
+        Debug() << "Converting image of size" << image->size() << "to distance field on the CPU...";
+        TextureTools::distanceFieldInto(*image, result, radius, args.value<UnsignedInt>("threads"));
+
+        if(!converter->exportToFile(result, args.value("output"))) {
+            Error() << "Cannot save file" << args.value("output");
+            return 5;
+        }
+
+        return 0;
+    }
+
     /* Decide about internal format */
     GL::TextureFormat internalFormat;
     if(image->format() == PixelFormat::R8Unorm)
@@ -204,13 +243,13 @@ int DistanceFieldConverter::exec() {
 
     /* Output texture */
     GL::Texture2D output;
-    output.setStorage(1, GL::TextureFormat::R8, args.value<Vector2i>("output-size"));
+    output.setStorage(1, GL::TextureFormat::R8, outputSize);
 
     CORRADE_INTERNAL_ASSERT(GL::Renderer::error() == GL::Renderer::Error::NoError);
 
     /* Do it */
     Debug() << "Converting image of size" << image->size() << "to distance field...";
-    TextureTools::DistanceField{args.value<UnsignedInt>("radius")}(input, output, {{}, args.value<Vector2i>("output-size")}, image->size());
+    TextureTools::DistanceField{radius}(input, output, {{}, outputSize}, image->size());
 
     /* Save image */
     Image2D result{PixelFormat::R8Unorm};
@@ -57,12 +57,97 @@
 #include "Magnum/Trade/configure.h"
 #endif
 
+/* Same condition as for Utility::Directory::mapRead() */
+#if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+#define _MAGNUM_TRADE_USE_MAPPING
+#ifdef CORRADE_TARGET_UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define WIN32_LEAN_AND_MEAN 1
+#define VC_EXTRALEAN
+#include <windows.h>
+#include <Corrade/Utility/Unicode.h>
+#endif
+#endif
+
 namespace Magnum { namespace Trade {
 
+#ifdef _MAGNUM_TRADE_USE_MAPPING
+namespace {
+
+/* Defined here and not in a plugin so the deleter doesn't dangle when the
+   array outlives the plugin module, same as ArrayAllocator<char>::deleter */
+void unmapDeleter(char* const data, const std::size_t size) {
+    #ifdef CORRADE_TARGET_UNIX
+    munmap(data, size);
+    #else
+    static_cast<void>(size);
+    UnmapViewOfFile(data);
+    #endif
+}
+
+/* Unlike Utility::Directory::map() the mapping is private, so the memory is
+   writable but the changes never reach the file. Empty files can't be mapped,
+   for those an empty array is returned. */
+Containers::Optional<Containers::Array<char>> mapFileCopyOnWrite(const std::string& filename) {
+    #ifdef CORRADE_TARGET_UNIX
+    const int fd = ::open(filename.data(), O_RDONLY);
+    if(fd == -1) return {};
+
+    struct stat st;
+    if(fstat(fd, &st) == -1 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return {};
+    }
+
+    const std::size_t size = st.st_size;
+    if(!size) {
+        ::close(fd);
+        return Containers::Array<char>{};
+    }
+
+    /* The mapping stays valid after the descriptor is closed */
+    void* const data = mmap(nullptr, size, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(data == MAP_FAILED) return {};
+    #else
+    HANDLE file = CreateFileW(Utility::Unicode::widen(filename).data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE) return {};
+
+    LARGE_INTEGER largeSize;
+    if(!GetFileSizeEx(file, &largeSize)) {
+        CloseHandle(file);
+        return {};
+    }
+
+    const std::size_t size = largeSize.QuadPart;
+    if(!size) {
+        CloseHandle(file);
+        return Containers::Array<char>{};
+    }
+
+    /* The view keeps both the mapping and the file open */
+    HANDLE map = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    CloseHandle(file);
+    if(!map) return {};
+    void* const data = MapViewOfFile(map, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(map);
+    if(!data) return {};
+    #endif
+
+    return Containers::Array<char>{static_cast<char*>(data), size, unmapDeleter};
+}
+
+}
+#endif
+
 std::string AbstractImporter::pluginInterface() {
     return
 /* [interface] */
-"cz.mosra.magnum.Trade.AbstractImporter/0.3.3"
+"cz.mosra.magnum.Trade.AbstractImporter/0.3.4"
 /* [interface] */
     ;
 }
@@ -194,17 +279,36 @@ void AbstractImporter::doOpenFile(const std::string& filename) {
         doOpenData(*data);
         _fileCallback(filename, InputFileCallbackPolicy::Close, _fileCallbackUserData);
 
-    /* Otherwise open the file directly */
+    /* Otherwise open the file directly, memory-mapping it if requested */
     } else {
-        if(!Utility::Directory::exists(filename)) {
-            Error() << "Trade::AbstractImporter::openFile(): cannot open file" << filename;
-            return;
+        Containers::Array<char> data;
+        #ifdef _MAGNUM_TRADE_USE_MAPPING
+        if(_flags & ImporterFlag::ZeroCopy) {
+            Containers::Optional<Containers::Array<char>> mapped = mapFileCopyOnWrite(filename);
+            if(!mapped) {
+                Error() << "Trade::AbstractImporter::openFile(): cannot open file" << filename;
+                return;
+            }
+            data = std::move(*mapped);
+        } else
+        #endif
+        {
+            if(!Utility::Directory::exists(filename)) {
+                Error() << "Trade::AbstractImporter::openFile(): cannot open file" << filename;
+                return;
+            }
+
+            data = Utility::Directory::read(filename);
         }
 
-        doOpenData(Utility::Directory::read(filename));
+        doOpenFileData(std::move(data));
     }
 }
 
+void AbstractImporter::doOpenFileData(Containers::Array<char>&& data) {
+    doOpenData(data);
+}
+
 void AbstractImporter::close() {
     if(isOpened()) {
         doClose();
@@ -1092,6 +1196,7 @@ Debug& operator<<(Debug& debug, const ImporterFlag value) {
         /* LCOV_EXCL_START */
         #define _c(v) case ImporterFlag::v: return debug << "::" #v;
         _c(Verbose)
+        _c(ZeroCopy)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -1101,7 +1206,8 @@ Debug& operator<<(Debug& debug, const ImporterFlag value) {
 
 Debug& operator<<(Debug& debug, const ImporterFlags value) {
     return Containers::enumSetDebugOutput(debug, value, "Trade::ImporterFlags{}", {
-        ImporterFlag::Verbose});
+        ImporterFlag::Verbose,
+        ImporterFlag::ZeroCopy});
 }
 
 }}
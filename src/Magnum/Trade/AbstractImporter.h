@@ -104,7 +104,25 @@ enum class ImporterFlag: UnsignedByte {
      */
     Verbose = 1 << 0,
 
-    /** @todo Y flip for images, "I want to import just once, don't copy" ... */
+    /**
+     * Reference the file contents instead of copying them, where possible.
+     * With this flag set, @ref AbstractImporter::openFile() memory-maps the
+     * file copy-on-write on platforms that support it instead of reading it
+     * into memory, and plugins that support this flag return for example
+     * @ref MeshData or @ref ImageData pointing directly into the file
+     * contents, marked with @ref DataFlag::ExternallyOwned and
+     * @ref DataFlag::Mutable. See
+     * @ref Trade-AbstractImporter-data-dependency for lifetime implications.
+     *
+     * Modifying such data never changes the file on disk, but the changes
+     * are visible in subsequent imports from the same file. Plugins that
+     * don't support this flag ignore it and return copies as usual, see
+     * documentation of a particular plugin for more information.
+     * @m_since_latest
+     */
+    ZeroCopy = 1 << 1,
+
+    /** @todo Y flip for images, ... */
 };
 
 /**
@@ -259,7 +277,10 @@ instances created from @ref Corrade::Containers::ArrayView) --- this is to
 avoid potential dangling function pointer calls when destructing such instances
 after the plugin module has been unloaded.
 
-The only exception are various `importerState()` functions
+The only exception are `*Data` instances imported with
+@ref ImporterFlag::ZeroCopy and marked with @ref DataFlag::ExternallyOwned,
+which reference the opened file and are valid only as long as the file is kept
+open, and various `importerState()` functions
 @ref Trade-AbstractImporter-usage-state "described above", but in that case the
 relation is *weak* --- these are valid only as long as the currently opened
 file is kept open. If the file gets closed or the importer instance deleted,
@@ -281,6 +302,12 @@ base file path to pass correct paths to subsequent file callbacks. The
 @ref doSetFileCallback() can be overriden in case it's desired to respond to
 file loading callback setup, but doesn't have to be.
 
+Importers that can reference the file contents directly instead of copying
+them can implement @ref doOpenFileData(), which receives ownership of the
+loaded or memory-mapped file from the default @ref doOpenFile()
+implementation. If @ref ImporterFlag::ZeroCopy is set, the returned data can
+then point into it, marked with @ref DataFlag::ExternallyOwned.
+
 For multi-data formats the file opening shouldn't take long and all parsing
 should be done in the data parsing functions instead, because the user might
 want to import only some data. This is obviously not the case for single-data
@@ -1424,8 +1451,9 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          * @brief Implementation for @ref openFile()
          *
          * If @ref ImporterFeature::OpenData is supported, default
-         * implementation opens the file and calls @ref doOpenData() with its
-         * contents. It is allowed to call this function from your
+         * implementation opens the file and calls @ref doOpenFileData() with
+         * its contents, or @ref doOpenData() if the file was loaded through
+         * file callbacks. It is allowed to call this function from your
          * @ref doOpenFile() implementation --- in particular, this
          * implementation will also correctly handle callbacks set through
          * @ref setFileCallback().
@@ -1473,6 +1501,20 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Implementation for @ref openData() */
         virtual void doOpenData(Containers::ArrayView<const char> data);
 
+        /**
+         * @brief Implementation for opening already loaded file contents
+         * @m_since_latest
+         *
+         * Called from the default @ref doOpenFile() implementation if no
+         * file callbacks are set. If @ref ImporterFlag::ZeroCopy is set, the
+         * file is memory-mapped copy-on-write on platforms that support it,
+         * otherwise it's read into memory. In both cases the memory is
+         * mutable, its deleter is defined in the @ref Trade library and the
+         * implementation can take over the array instead of copying its
+         * contents. Default implementation calls @ref doOpenData().
+         */
+        virtual void doOpenFileData(Containers::Array<char>&& data);
+
         /** @brief Implementation for @ref openState() */
         virtual void doOpenState(const void* state, const std::string& filePath);
 
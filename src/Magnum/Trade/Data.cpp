@@ -37,6 +37,7 @@ Debug& operator<<(Debug& debug, const DataFlag value) {
         #define _c(v) case DataFlag::v: return debug << "::" #v;
         _c(Owned)
         _c(Mutable)
+        _c(ExternallyOwned)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -47,7 +48,8 @@ Debug& operator<<(Debug& debug, const DataFlag value) {
 Debug& operator<<(Debug& debug, const DataFlags value) {
     return Containers::enumSetDebugOutput(debug, value, "Trade::DataFlags{}", {
         DataFlag::Owned,
-        DataFlag::Mutable});
+        DataFlag::Mutable,
+        DataFlag::ExternallyOwned});
 }
 
 namespace Implementation {
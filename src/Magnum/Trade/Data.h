@@ -57,9 +57,21 @@ enum class DataFlag: UnsignedByte {
      * Data is mutable. If this flag is not set, the instance might be for
      * example referencing a readonly memory-mapped file or a constant memory.
      */
-    Mutable = 2 << 0
+    Mutable = 2 << 0,
 
-    /** @todo owned by importer, owned by the GPU, ... */
+    /**
+     * Data is not owned by the instance and valid only as long as the
+     * originating importer keeps the file opened. Used for example by
+     * importers with @ref ImporterFlag::ZeroCopy set to reference a
+     * memory-mapped file, so any views on the data shouldn't be kept past
+     * @ref AbstractImporter::close(). Functions that would otherwise have to
+     * copy non-owned data can reference such data directly instead.
+     * Can't be set together with @ref DataFlag::Owned.
+     * @m_since_latest
+     */
+    ExternallyOwned = 1 << 2
+
+    /** @todo owned by the GPU, ... */
 };
 
 /**
@@ -27,6 +27,7 @@
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
@@ -71,6 +72,9 @@ struct AbstractImporterTest: TestSuite::Tester {
     void openData();
     void openFileAsData();
     void openFileAsDataNotFound();
+    void openFileAsDataTakeOwnership();
+    void openFileAsDataZeroCopy();
+    void openFileAsDataZeroCopyNotFound();
 
     void openFileNotImplemented();
     void openDataNotSupported();
@@ -294,6 +298,9 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::openData,
               &AbstractImporterTest::openFileAsData,
               &AbstractImporterTest::openFileAsDataNotFound,
+              &AbstractImporterTest::openFileAsDataTakeOwnership,
+              &AbstractImporterTest::openFileAsDataZeroCopy,
+              &AbstractImporterTest::openFileAsDataZeroCopyNotFound,
 
               &AbstractImporterTest::openFileNotImplemented,
               &AbstractImporterTest::openDataNotSupported,
@@ -643,6 +650,98 @@ void AbstractImporterTest::openFileAsDataNotFound() {
     CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::openFile(): cannot open file nonexistent.bin\n");
 }
 
+void AbstractImporterTest::openFileAsDataTakeOwnership() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return !!_data; }
+        void doClose() override { _data = nullptr; }
+
+        /* doOpenData() not implemented, as it shouldn't get called */
+        void doOpenFileData(Containers::Array<char>&& data) override {
+            _data = std::move(data);
+        }
+
+        Containers::Array<char> _data;
+    } importer;
+
+    /* doOpenFile() should call doOpenFileData() with the file contents */
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(TRADE_TEST_DIR, "file.bin")));
+    CORRADE_VERIFY(importer.isOpened());
+    CORRADE_COMPARE(importer._data.size(), 1);
+    CORRADE_COMPARE(importer._data[0], '\xa5');
+
+    importer.close();
+    CORRADE_VERIFY(!importer.isOpened());
+}
+
+void AbstractImporterTest::openFileAsDataZeroCopy() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return !!_data; }
+        void doClose() override { _data = nullptr; }
+
+        void doOpenFileData(Containers::Array<char>&& data) override {
+            _data = std::move(data);
+        }
+
+        UnsignedInt doMeshCount() const override { return 1; }
+        Containers::Optional<MeshData> doMesh(UnsignedInt, UnsignedInt) override {
+            return MeshData{MeshPrimitive::Points,
+                DataFlag::ExternallyOwned|DataFlag::Mutable, _data, nullptr, 1};
+        }
+
+        Containers::Array<char> _data;
+    } importer;
+
+    importer.setFlags(ImporterFlag::ZeroCopy);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(TRADE_TEST_DIR, "file.bin")));
+    CORRADE_COMPARE(importer._data.size(), 1);
+    CORRADE_COMPARE(importer._data[0], '\xa5');
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    /* The file should be mapped, i.e. not using the default deleter */
+    CORRADE_VERIFY(importer._data.deleter());
+    #endif
+
+    /* The mesh should reference the file contents and be mutable */
+    Containers::Optional<MeshData> mesh = importer.mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlag::ExternallyOwned|DataFlag::Mutable);
+    CORRADE_COMPARE(mesh->vertexData().data(), importer._data.data());
+    mesh->mutableVertexData()[0] = '\x5a';
+    CORRADE_COMPARE(importer._data[0], '\x5a');
+
+    /* But the change shouldn't get to the file */
+    CORRADE_COMPARE_AS(Utility::Directory::read(Utility::Directory::join(TRADE_TEST_DIR, "file.bin")),
+        Containers::arrayView({'\xa5'}),
+        TestSuite::Compare::Container);
+
+    importer.close();
+    CORRADE_VERIFY(!importer.isOpened());
+}
+
+void AbstractImporterTest::openFileAsDataZeroCopyNotFound() {
+    struct Importer: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        void doOpenFileData(Containers::Array<char>&&) override {
+            _opened = true;
+        }
+
+        bool _opened = false;
+    } importer;
+
+    importer.setFlags(ImporterFlag::ZeroCopy);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    CORRADE_VERIFY(!importer.openFile("nonexistent.bin"));
+    CORRADE_VERIFY(!importer.isOpened());
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::openFile(): cannot open file nonexistent.bin\n");
+}
+
 void AbstractImporterTest::openFileNotImplemented() {
     #ifdef CORRADE_NO_ASSERT
     CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
@@ -4639,8 +4738,8 @@ void AbstractImporterTest::debugFlag() {
 void AbstractImporterTest::debugFlags() {
     std::ostringstream out;
 
-    Debug{&out} << (ImporterFlag::Verbose|ImporterFlag(0xf0)) << ImporterFlags{};
-    CORRADE_COMPARE(out.str(), "Trade::ImporterFlag::Verbose|Trade::ImporterFlag(0xf0) Trade::ImporterFlags{}\n");
+    Debug{&out} << (ImporterFlag::Verbose|ImporterFlag(0xf0)) << (ImporterFlag::Verbose|ImporterFlag::ZeroCopy) << ImporterFlags{};
+    CORRADE_COMPARE(out.str(), "Trade::ImporterFlag::Verbose|Trade::ImporterFlag(0xf0) Trade::ImporterFlag::Verbose|Trade::ImporterFlag::ZeroCopy Trade::ImporterFlags{}\n");
 }
 
 }}}}
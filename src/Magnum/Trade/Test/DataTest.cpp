@@ -53,8 +53,8 @@ void DataTest::debugDataFlag() {
 void DataTest::debugDataFlags() {
     std::ostringstream out;
 
-    Debug{&out} << (DataFlag::Owned|DataFlag::Mutable) << DataFlags{};
-    CORRADE_COMPARE(out.str(), "Trade::DataFlag::Owned|Trade::DataFlag::Mutable Trade::DataFlags{}\n");
+    Debug{&out} << (DataFlag::Owned|DataFlag::Mutable) << (DataFlag::ExternallyOwned|DataFlag::Mutable) << DataFlags{};
+    CORRADE_COMPARE(out.str(), "Trade::DataFlag::Owned|Trade::DataFlag::Mutable Trade::DataFlag::Mutable|Trade::DataFlag::ExternallyOwned Trade::DataFlags{}\n");
 }
 
 }}}}
@@ -23,8 +23,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <chrono>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/Containers/StaticArray.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Arguments.h>
@@ -34,6 +36,7 @@
 #include <Corrade/Utility/String.h>
 
 #include "Magnum/PixelFormat.h"
+#include "Magnum/Implementation/converterBatch.h"
 #include "Magnum/Implementation/converterUtilities.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
@@ -69,13 +72,15 @@ magnum-imageconverter [-h|--help] [-I|--importer IMPORTER]
     [-C|--converter CONVERTER] [--plugin-dir DIR]
     [-i|--importer-options key=val,key2=val2,…]
     [-c|--converter-options key=val,key2=val2,…] [--image IMAGE]
-    [--level LEVEL] [--in-place] [--info] [-v|--verbose] [--] input output
+    [--level LEVEL] [--in-place] [--info] [--batch MANIFEST] [-j|--jobs N]
+    [--report FILE] [-v|--verbose] [--] input output
 @endcode
 
 Arguments:
 
--   `input` --- input image
--   `output` --- output image, ignored if `--in-place` or `--info` is present
+-   `input` --- input image, ignored if `--batch` is present
+-   `output` --- output image, ignored if `--in-place`, `--info` or `--batch`
+    is present
 -   `-h`, `--help` --- display this help message and exit
 -   `-I`, `--importer IMPORTER` --- image importer plugin (default:
     @ref Trade::AnyImageImporter "AnyImageImporter")
@@ -90,6 +95,13 @@ Arguments:
 -   `--level LEVEL` --- image level to import (default: `0`)
 -   `--in-place` --- overwrite the input image with the output
 -   `--info` --- print info about the input file and exit
+-   `--batch MANIFEST` --- convert all files listed in a manifest
+-   `-j`, `--jobs N` --- number of files converted in parallel by `--batch`
+    (default: `0`, which means all cores). If Corrade isn't built with
+    @ref CORRADE_BUILD_MULTITHREADED, the files are always converted on a
+    single thread.
+-   `--report FILE` --- write a tab-separated report of all files converted
+    by `--batch`
 -   `-v`, `--verbose` --- verbose output from importer and converter plugins
 
 Specifying `--importer raw:&lt;format&gt;` will treat the input as a raw
@@ -107,6 +119,18 @@ converter plugin configuration. If the `=` character is omitted, it's
 equivalent to saying `key=true`; configuration subgroups are delimited with
 `/`.
 
+If `--batch` is given, the `input` and `output` arguments are ignored and all
+files listed in the manifest are converted instead. The manifest contains an
+input and an output filename separated by a tab on each line, or just the
+input filename if `--in-place` is specified. Empty lines and lines starting
+with `#` are ignored. The files are converted in parallel on `--jobs` threads,
+each having its own importer and converter plugin instance, so the plugins are
+loaded only once and not for every file. Output of each file is printed
+together once it finishes, followed by a line with its conversion time and
+input and output size; `--report` saves the same information into a
+tab-separated file. On Emscripten the files are always converted on a single
+thread.
+
 @section magnum-imageconverter-example Example usage
 
 Converting a JPEG file to a PNG:
@@ -135,6 +159,16 @@ inspection:
 magnum-imageconverter image.dds --converter raw data.dat
 @endcode
 
+Converting all PNG files in a directory to Basis Universal on eight threads,
+saving a report with conversion times and output sizes:
+
+@m_class{m-console-wrap}
+
+@code{.sh}
+for i in *.png; do printf '%s\t%s\n' "$i" "${i%.png}.basis"; done > manifest.txt
+magnum-imageconverter --batch manifest.txt -j 8 --report report.tsv
+@endcode
+
 @see @ref magnum-sceneconverter
 */
 
@@ -142,10 +176,136 @@ magnum-imageconverter image.dds --converter raw data.dat
 
 using namespace Magnum;
 
+namespace {
+
+/* Plugin managers and plugin instances. In the batch mode there's one for
+   each worker thread, so the plugins are loaded just once for all files and
+   the workers don't need to synchronize. */
+struct Worker {
+    explicit Worker(const std::string& pluginDir):
+        importerManager{pluginDir.empty() ? std::string{} :
+            Utility::Directory::join(pluginDir, Trade::AbstractImporter::pluginSearchPaths()[0])},
+        converterManager{pluginDir.empty() ? std::string{} :
+            Utility::Directory::join(pluginDir, Trade::AbstractImageConverter::pluginSearchPaths()[0])} {}
+
+    PluginManager::Manager<Trade::AbstractImporter> importerManager;
+    PluginManager::Manager<Trade::AbstractImageConverter> converterManager;
+    Containers::Pointer<Trade::AbstractImporter> importer;
+    Containers::Pointer<Trade::AbstractImageConverter> converter;
+};
+
+bool loadImporter(const Utility::Arguments& args, Worker& worker) {
+    /* Raw input doesn't need any plugin */
+    if(Utility::String::beginsWith(args.value("importer"), "raw:"))
+        return true;
+
+    worker.importer = worker.importerManager.loadAndInstantiate(args.value("importer"));
+    if(!worker.importer) {
+        Debug{} << "Available importer plugins:" << Utility::String::join(worker.importerManager.aliasList(), ", ");
+        return false;
+    }
+
+    /* Set options, if passed */
+    if(args.isSet("verbose")) worker.importer->setFlags(Trade::ImporterFlag::Verbose);
+    Implementation::setOptions(*worker.importer, args.value("importer-options"));
+    return true;
+}
+
+bool loadConverter(const Utility::Arguments& args, Worker& worker) {
+    /* Raw output doesn't need any plugin */
+    if(args.value("converter") == "raw")
+        return true;
+
+    worker.converter = worker.converterManager.loadAndInstantiate(args.value("converter"));
+    if(!worker.converter) {
+        Debug{} << "Available converter plugins:" << Utility::String::join(worker.converterManager.aliasList(), ", ");
+        return false;
+    }
+
+    /* Set options, if passed */
+    if(args.isSet("verbose")) worker.converter->setFlags(Trade::ImageConverterFlag::Verbose);
+    Implementation::setOptions(*worker.converter, args.value("converter-options"));
+    return true;
+}
+
+/* Returns an exit code on failure, zero on success */
+int importImage(const Utility::Arguments& args, Worker& worker, const std::string& input, Containers::Optional<Trade::ImageData2D>& image) {
+    /* Load raw data, if requested; assume it's a tightly-packed square of
+       given format */
+    /** @todo implement image slicing and then use `--slice "0 0 w h"` to
+        specify non-rectangular size (and +x +y to specify padding?) */
+    if(!worker.importer) {
+        /** @todo Any chance to do this without using internal APIs? */
+        const PixelFormat format = Utility::ConfigurationValue<PixelFormat>::fromString(args.value("importer").substr(4), {});
+        if(format == PixelFormat{}) {
+            Error{} << "Invalid raw pixel format" << args.value("importer");
+            return 4;
+        }
+        const UnsignedInt pixelSize = Magnum::pixelSize(format);
+
+        /** @todo simplify once read() reliably returns an Optional */
+        if(!Utility::Directory::exists(input)) {
+            Error{} << "Cannot open file" << input;
+            return 3;
+        }
+        Containers::Array<char> data = Utility::Directory::read(input);
+        auto side = Int(std::sqrt(data.size()/pixelSize));
+        if(data.size() % pixelSize || side*side*pixelSize != data.size()) {
+            Error{} << "File of size" << data.size() << "is not a tightly-packed square of" << format;
+            return 5;
+        }
+
+        image = Trade::ImageData2D(format, Vector2i{side}, std::move(data));
+        return 0;
+    }
+
+    /* Otherwise load it using an importer plugin. Open input file and the
+       desired image. */
+    if(!worker.importer->openFile(input)) {
+        Error() << "Cannot open file" << input;
+        return 3;
+    }
+
+    image = worker.importer->image2D(args.value<UnsignedInt>("image"), args.value<UnsignedInt>("level"));
+
+    /* The image is a copy, so the file doesn't need to stay opened. Closing
+       it frees the memory early in the batch mode. */
+    worker.importer->close();
+
+    if(!image) {
+        Error() << "Cannot import the image";
+        return 4;
+    }
+
+    return 0;
+}
+
+/* Returns an exit code on failure, zero on success */
+int convertImage(Worker& worker, const Trade::ImageData2D& image, const std::string& output) {
+    /* Save raw data, if requested */
+    if(!worker.converter) {
+        if(!Utility::Directory::write(output, image.data())) {
+            Error() << "Cannot save file" << output;
+            return 5;
+        }
+        return 0;
+    }
+
+    /* Save output file */
+    if(!worker.converter->exportToFile(image, output)) {
+        Error() << "Cannot save file" << output;
+        return 5;
+    }
+
+    return 0;
+}
+
+}
+
 int main(int argc, char** argv) {
     Utility::Arguments args;
-    args.addArgument("input").setHelp("input", "input image")
-        .addArgument("output").setHelp("output", "output image, ignored if --in-place or --info is present")
+    args.addArgument("input").setHelp("input", "input image, ignored if --batch is present")
+        .addArgument("output").setHelp("output", "output image, ignored if --in-place, --info or --batch is present")
         .addOption('I', "importer", "AnyImageImporter").setHelp("importer", "image importer plugin")
         .addOption('C', "converter", "AnyImageConverter").setHelp("converter", "image converter plugin")
         .addOption("plugin-dir").setHelp("plugin-dir", "override base plugin dir", "DIR")
@@ -155,12 +315,16 @@ int main(int argc, char** argv) {
         .addOption("level", "0").setHelp("level", "image level to import")
         .addBooleanOption("in-place").setHelp("in-place", "overwrite the input image with the output")
         .addBooleanOption("info").setHelp("info", "print info about the input file and exit")
+        .addOption("batch").setHelp("batch", "convert all files listed in a manifest", "MANIFEST")
+        .addOption('j', "jobs", "0").setHelp("jobs", "number of files converted in parallel by --batch, 0 means all cores", "N")
+        .addOption("report").setHelp("report", "write a tab-separated report of all files converted by --batch", "FILE")
         .addBooleanOption('v', "verbose").setHelp("verbose", "verbose output from importer and converter plugins")
         .setParseErrorCallback([](const Utility::Arguments& args, Utility::Arguments::ParseError error, const std::string& key) {
             /* If --in-place or --info is passed, we don't need the output
-               argument */
+               argument. With --batch we don't need any. */
             if(error == Utility::Arguments::ParseError::MissingArgument &&
-               key == "output" && (args.isSet("in-place") || args.isSet("info")))
+               ((key == "output" && (args.isSet("in-place") || args.isSet("info"))) ||
+                !args.value("batch").empty()))
                 return true;
 
             /* Handle all other errors as usual */
@@ -179,109 +343,105 @@ be specified.
 The -i / --importer-options and -c / --converter-options arguments accept a
 comma-separated list of key/value pairs to set in the importer / converter
 plugin configuration. If the = character is omitted, it's equivalent to saying
-key=true; configuration subgroups are delimited with /.)")
+key=true; configuration subgroups are delimited with /.
+
+If --batch is given, the input and output arguments are ignored and all files
+listed in the manifest are converted instead, in parallel on --jobs threads,
+each having its own importer and converter instance. The manifest contains an
+input and output filename separated by a tab on each line, with --in-place just
+the input filename. Empty lines and lines starting with # are ignored. A line
+with timing and size is printed for each converted file and --report saves the
+same as a tab-separated file.)")
         .parse(argc, argv);
 
-    PluginManager::Manager<Trade::AbstractImporter> importerManager{
-        args.value("plugin-dir").empty() ? std::string{} :
-        Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractImporter::pluginSearchPaths()[0])};
-
-    /* Load raw data, if requested; assume it's a tightly-packed square of
-       given format */
-    /** @todo implement image slicing and then use `--slice "0 0 w h"` to
-        specify non-rectangular size (and +x +y to specify padding?) */
-    Containers::Optional<Trade::ImageData2D> image;
-    if(Utility::String::beginsWith(args.value("importer"), "raw:")) {
-        /** @todo Any chance to do this without using internal APIs? */
-        const PixelFormat format = Utility::ConfigurationValue<PixelFormat>::fromString(args.value("importer").substr(4), {});
-        const UnsignedInt pixelSize = Magnum::pixelSize(format);
-        if(format == PixelFormat{}) {
-            Error{} << "Invalid raw pixel format" << args.value("importer");
-            return 4;
-        }
-
-        /** @todo simplify once read() reliably returns an Optional */
-        if(!Utility::Directory::exists(args.value("input"))) {
-            Error{} << "Cannot open file" << args.value("input");
-            return 3;
-        }
-        Containers::Array<char> data = Utility::Directory::read(args.value("input"));
-        auto side = Int(std::sqrt(data.size()/pixelSize));
-        if(data.size() % pixelSize || side*side*pixelSize != data.size()) {
-            Error{} << "File of size" << data.size() << "is not a tightly-packed square of" << format;
-            return 5;
-        }
-
-        /* Print image info, if requested */
+    /* Batch conversion, if requested */
+    if(!args.value("batch").empty()) {
         if(args.isSet("info")) {
-            Debug{} << "Image 0:\n  Mip 0:" << format << Vector2i{side};
-            return 0;
+            Error{} << "The --info option can't be used together with --batch";
+            return 1;
         }
 
-        image = Trade::ImageData2D(format, Vector2i{side}, std::move(data));
-
-    /* Otherwise load it using an importer plugin */
-    } else {
-        Containers::Pointer<Trade::AbstractImporter> importer = importerManager.loadAndInstantiate(args.value("importer"));
-        if(!importer) {
-            Debug{} << "Available importer plugins:" << Utility::String::join(importerManager.aliasList(), ", ");
-            return 1;
+        Containers::Optional<Containers::Array<Implementation::BatchJob>> jobs = Implementation::parseBatchManifest(args.value("batch"), !args.isSet("in-place"));
+        if(!jobs) return 1;
+        if(args.isSet("in-place")) for(Implementation::BatchJob& job: *jobs)
+            job.output = job.input;
+
+        /* Load all plugins upfront, so failures are discovered before any
+           conversion starts */
+        const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+        Containers::Array<Containers::Pointer<Worker>> workers{Implementation::batchWorkerCount(args.value<std::size_t>("jobs"), jobs->size())};
+        for(Containers::Pointer<Worker>& worker: workers) {
+            worker = Containers::pointer<Worker>(args.value("plugin-dir"));
+            if(!loadImporter(args, *worker)) return 1;
+            if(!loadConverter(args, *worker)) return 2;
         }
 
-        /* Set options, if passed */
-        if(args.isSet("verbose")) importer->setFlags(Trade::ImporterFlag::Verbose);
-        Implementation::setOptions(*importer, args.value("importer-options"));
+        const std::size_t failed = Implementation::runBatch(*jobs, workers.size(), [&](const std::size_t worker, const Implementation::BatchJob& job) {
+            Containers::Optional<Trade::ImageData2D> image;
+            return !importImage(args, *workers[worker], job.input, image) &&
+                   !convertImage(*workers[worker], *image, job.output);
+        });
 
-        /* Print image info, if requested */
-        if(args.isSet("info")) {
-            /* Open the file, but don't fail when an image can't be opened */
-            if(!importer->openFile(args.value("input"))) {
-                Error() << "Cannot open file" << args.value("input");
-                return 3;
-            }
+        if(!Implementation::finishBatch(*jobs, failed, std::chrono::high_resolution_clock::now() - start, args.value("report")))
+            return 1;
+        return failed ? 1 : 0;
+    }
 
-            if(!importer->image1DCount() && !importer->image2DCount() && !importer->image2DCount()) {
-                Debug{} << "No images found.";
-                return 0;
-            }
+    Worker worker{args.value("plugin-dir")};
+    if(!loadImporter(args, worker)) return 1;
 
-            /* Parse everything first to avoid errors interleaved with output.
-               In case the images have all just a single level and no names,
-               write them in a compact way without listing levels. */
-            bool error = false, compact = true;
-            Containers::Array<Trade::Implementation::ImageInfo> infos =
-                Trade::Implementation::imageInfo(*importer, error, compact);
-
-            for(const Trade::Implementation::ImageInfo& info: infos) {
-                Debug d;
-                if(info.level == 0) {
-                    d << "Image" << info.image << Debug::nospace << ":";
-                    if(!info.name.empty()) d << info.name;
-                    if(!compact) d << Debug::newline;
-                }
-                if(!compact) d << "  Level" << info.level << Debug::nospace << ":";
-                if(info.compressed) d << info.compressedFormat;
-                else d << info.format;
-                if(info.size.z()) d << info.size;
-                else if(info.size.y()) d << info.size.xy();
-                else d << Math::Vector<1, Int>(info.size.x());
-            }
+    /* Print image info, if requested */
+    if(args.isSet("info")) {
+        /* Raw data are a single image with a single level */
+        if(!worker.importer) {
+            Containers::Optional<Trade::ImageData2D> image;
+            if(const int result = importImage(args, worker, args.value("input"), image))
+                return result;
 
-            return error ? 1 : 0;
+            Debug{} << "Image 0:\n  Mip 0:" << image->format() << image->size();
+            return 0;
         }
 
-        /* Open input file and the desired image */
-        if(!importer->openFile(args.value("input"))) {
+        /* Open the file, but don't fail when an image can't be opened */
+        if(!worker.importer->openFile(args.value("input"))) {
             Error() << "Cannot open file" << args.value("input");
             return 3;
         }
 
-         if(!(image = importer->image2D(args.value<UnsignedInt>("image"), args.value<UnsignedInt>("level")))) {
-            Error() << "Cannot import the image";
-            return 4;
+        if(!worker.importer->image1DCount() && !worker.importer->image2DCount() && !worker.importer->image2DCount()) {
+            Debug{} << "No images found.";
+            return 0;
+        }
+
+        /* Parse everything first to avoid errors interleaved with output.
+           In case the images have all just a single level and no names,
+           write them in a compact way without listing levels. */
+        bool error = false, compact = true;
+        Containers::Array<Trade::Implementation::ImageInfo> infos =
+            Trade::Implementation::imageInfo(*worker.importer, error, compact);
+
+        for(const Trade::Implementation::ImageInfo& info: infos) {
+            Debug d;
+            if(info.level == 0) {
+                d << "Image" << info.image << Debug::nospace << ":";
+                if(!info.name.empty()) d << info.name;
+                if(!compact) d << Debug::newline;
+            }
+            if(!compact) d << "  Level" << info.level << Debug::nospace << ":";
+            if(info.compressed) d << info.compressedFormat;
+            else d << info.format;
+            if(info.size.z()) d << info.size;
+            else if(info.size.y()) d << info.size.xy();
+            else d << Math::Vector<1, Int>(info.size.x());
         }
+
+        return error ? 1 : 0;
     }
 
+    Containers::Optional<Trade::ImageData2D> image;
+    if(const int result = importImage(args, worker, args.value("input"), image))
+        return result;
+
     const std::string output = args.value(args.isSet("in-place") ? "input" : "output");
 
     {
@@ -296,29 +456,8 @@ key=true; configuration subgroups are delimited with /.)")
         d << "to" << output;
     }
 
-    /* Save raw data, if requested */
-    if(args.value("converter") == "raw") {
-        Utility::Directory::write(output, image->data());
-        return 0;
-    }
-
     /* Load converter plugin */
-    PluginManager::Manager<Trade::AbstractImageConverter> converterManager{
-        args.value("plugin-dir").empty() ? std::string{} :
-        Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractImageConverter::pluginSearchPaths()[0])};
-    Containers::Pointer<Trade::AbstractImageConverter> converter = converterManager.loadAndInstantiate(args.value("converter"));
-    if(!converter) {
-        Debug{} << "Available converter plugins:" << Utility::String::join(converterManager.aliasList(), ", ");
-        return 2;
-    }
-
-    /* Set options, if passed */
-    if(args.isSet("verbose")) converter->setFlags(Trade::ImageConverterFlag::Verbose);
-    Implementation::setOptions(*converter, args.value("converter-options"));
+    if(!loadConverter(args, worker)) return 2;
 
-    /* Save output file */
-    if(!converter->exportToFile(*image, output)) {
-        Error() << "Cannot save file" << output;
-        return 5;
-    }
+    return convertImage(worker, *image, output);
 }
@@ -53,7 +53,9 @@ bool AnySceneConverter::doConvertToFile(const std::string& filename, const MeshD
 
     /* Detect the plugin from extension */
     std::string plugin;
-    if(Utility::String::endsWith(normalized, ".ply"))
+    if(Utility::String::endsWith(normalized, ".blob"))
+        plugin = "MeshBlobSceneConverter";
+    else if(Utility::String::endsWith(normalized, ".ply"))
         plugin = "StanfordSceneConverter";
     else {
         Error{} << "Trade::AnySceneConverter::convertToFile(): cannot determine the format of" << filename;
@@ -109,6 +109,8 @@ void AnySceneImporter::doOpenFile(const std::string& filename) {
         plugin = "ModoImporter";
     else if(Utility::String::endsWith(normalized, ".ms3d"))
         plugin = "MilkshapeImporter";
+    else if(Utility::String::endsWith(normalized, ".blob"))
+        plugin = "MeshBlobImporter";
     else if(Utility::String::endsWith(normalized, ".obj"))
         plugin = "ObjImporter";
     else if(Utility::String::endsWith(normalized, ".xml"))
@@ -256,4 +258,4 @@ Containers::Optional<ImageData3D> AnySceneImporter::doImage3D(const UnsignedInt
 }}
 
 CORRADE_PLUGIN_REGISTER(AnySceneImporter, Magnum::Trade::AnySceneImporter,
-    "cz.mosra.magnum.Trade.AbstractImporter/0.3.3")
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.4")
@@ -79,6 +79,8 @@ tries to open the file with it. Supported formats:
 -   Modo (`*.lxo`), loaded with any plugin that provides `ModoImporter`
 -   Milkshape 3D (`*.ms3d`), loaded with any plugin that provides
     `MilkshapeImporter`
+-   Magnum mesh blob (`*.blob`), loaded with @ref MeshBlobImporter or any
+    other plugin that provides it
 -   Wavefront OBJ (`*.obj`), loaded with @ref ObjImporter or any other plugin
     that provides it
 -   Ogre XML (`*.xml`), loaded with any plugin that provides `OgreImporter`
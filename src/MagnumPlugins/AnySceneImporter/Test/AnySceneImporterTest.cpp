@@ -78,6 +78,7 @@ constexpr struct {
     {"COLLADA", "xml.dae", "ColladaImporter"},
     {"FBX", "autodesk.fbx", "FbxImporter"},
     {"glTF", "khronos.gltf", "GltfImporter"},
+    {"Magnum mesh blob", "mesh.blob", "MeshBlobImporter"},
     {"OpenGEX", "eric.ogex", "OpenGexImporter"},
     {"Stanford PLY", "bunny.ply", "StanfordImporter"},
     {"Stanford PLY uppercase", "ARMADI~1.PLY", "StanfordImporter"},
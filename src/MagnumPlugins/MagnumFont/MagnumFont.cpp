@@ -26,8 +26,10 @@
 #include "MagnumFont.h"
 
 #include <sstream>
+#include <unordered_map>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Configuration.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Unicode.h>
@@ -60,6 +62,7 @@ namespace {
 
         private:
             std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override;
+            void doRenderGlyphs(Vector2& cursorPosition, const Containers::StridedArrayView1D<Range2D>& quadPositions, const Containers::StridedArrayView1D<Range2D>& textureCoordinates) override;
 
             const std::vector<Vector2>& glyphAdvance;
             const AbstractGlyphCache& cache;
@@ -204,9 +207,25 @@ std::tuple<Range2D, Range2D, Vector2> MagnumFontLayouter::doRenderGlyph(const Un
     return std::make_tuple(quadRectangle, textureCoordinates, advance);
 }
 
+void MagnumFontLayouter::doRenderGlyphs(Vector2& cursorPosition, const Containers::StridedArrayView1D<Range2D>& quadPositions, const Containers::StridedArrayView1D<Range2D>& textureCoordinates) {
+    /* Same as doRenderGlyph(), just with the scale factors calculated only
+       once */
+    const Vector2 textureScale = 1.0f/Vector2(cache.textureSize());
+    const Float scale = textSize/fontSize;
+    for(std::size_t i = 0; i != glyphs.size(); ++i) {
+        Vector2i position;
+        Range2Di rectangle;
+        std::tie(position, rectangle) = cache[glyphs[i]];
+
+        textureCoordinates[i] = Range2D(rectangle).scaled(textureScale);
+        quadPositions[i] = Range2D(Range2Di::fromSize(position, rectangle.size())).scaled(Vector2(scale)).translated(cursorPosition);
+        cursorPosition += glyphAdvance[glyphs[i]]*scale;
+    }
+}
+
 }
 
 }}
 
 CORRADE_PLUGIN_REGISTER(MagnumFont, Magnum::Text::MagnumFont,
-    "cz.mosra.magnum.Text.AbstractFont/0.3")
+    "cz.mosra.magnum.Text.AbstractFont/0.3.1")
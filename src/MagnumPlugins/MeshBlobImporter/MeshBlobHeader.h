@@ -0,0 +1,86 @@
+#ifndef Magnum_Trade_MeshBlobHeader_h
+#define Magnum_Trade_MeshBlobHeader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Types.h"
+
+/* Used by both MeshBlobImporter and MeshBlobSceneConverter, which is why it
+   isn't directly inside MeshBlobImporter.cpp. OTOH it doesn't need to be
+   exposed publicly, which is why it has no docblocks. */
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+/* File layout:
+
+    MeshBlobHeader
+    MeshBlobAttribute[attributeCount]
+    padding to 16 bytes
+    index data
+    padding to 16 bytes
+    vertex data
+
+   All values are in the endianness given by the header. Everything is
+   naturally aligned, so the data can be referenced directly in a
+   memory-mapped file. */
+
+enum: UnsignedByte { MeshBlobVersion = 0 };
+enum: std::size_t { MeshBlobDataAlignment = 16 };
+
+struct MeshBlobHeader {
+    char magic[4];              /* MBLB */
+    UnsignedByte version;       /* MeshBlobVersion */
+    char endianness;            /* 'L' for little, 'B' for big endian */
+    UnsignedShort reserved;     /* 0 */
+    UnsignedInt primitive;      /* MeshPrimitive, possibly wrapped */
+    UnsignedInt indexType;      /* MeshIndexType, 0 if not indexed */
+    UnsignedInt indexCount;
+    UnsignedInt vertexCount;
+    UnsignedInt attributeCount;
+    UnsignedInt reserved2;      /* 0 */
+    UnsignedLong indexOffset;   /* Index view offset from index data start */
+    UnsignedLong indexDataOffset; /* From file start, MeshBlobDataAlignment */
+    UnsignedLong indexDataSize;
+    UnsignedLong vertexDataOffset; /* From file start, MeshBlobDataAlignment */
+    UnsignedLong vertexDataSize;
+};
+
+static_assert(sizeof(MeshBlobHeader) == 72, "MeshBlobHeader size is not 72 bytes");
+
+struct MeshBlobAttribute {
+    UnsignedInt format;         /* VertexFormat, possibly wrapped */
+    UnsignedShort name;         /* MeshAttribute, possibly custom */
+    UnsignedShort arraySize;
+    UnsignedLong offset;        /* From vertex data start */
+    Short stride;
+    UnsignedShort reserved;     /* 0 */
+    UnsignedInt reserved2;      /* 0 */
+};
+
+static_assert(sizeof(MeshBlobAttribute) == 24, "MeshBlobAttribute size is not 24 bytes");
+
+}}}
+
+#endif
@@ -0,0 +1,243 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshBlobImporter.h"
+
+#include <cstring>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MeshBlobImporter/MeshBlobHeader.h"
+
+namespace Magnum { namespace Trade {
+
+MeshBlobImporter::MeshBlobImporter() = default;
+
+MeshBlobImporter::MeshBlobImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+
+MeshBlobImporter::~MeshBlobImporter() = default;
+
+ImporterFeatures MeshBlobImporter::doFeatures() const { return ImporterFeature::OpenData; }
+
+bool MeshBlobImporter::doIsOpened() const { return _in; }
+
+void MeshBlobImporter::doClose() { _in = nullptr; }
+
+void MeshBlobImporter::doOpenData(const Containers::ArrayView<const char> data) {
+    /* The data aren't guaranteed to stay in scope, make a copy */
+    Containers::Array<char> copy{Containers::NoInit, data.size()};
+    Utility::copy(data, copy);
+    openInternal(std::move(copy));
+}
+
+void MeshBlobImporter::doOpenFileData(Containers::Array<char>&& data) {
+    /* The file was loaded or memory-mapped for us, take it over */
+    openInternal(std::move(data));
+}
+
+namespace {
+
+bool checkDataRange(const char* const what, const UnsignedLong offset, const UnsignedLong size, const std::size_t fileSize) {
+    if(offset % Implementation::MeshBlobDataAlignment) {
+        Error{} << "Trade::MeshBlobImporter::openData():" << what << "offset" << offset << "is not aligned to" << Implementation::MeshBlobDataAlignment << "bytes";
+        return false;
+    }
+
+    if(offset > fileSize || size > fileSize - offset) {
+        Error{} << "Trade::MeshBlobImporter::openData():" << what << "of" << size << "bytes at offset" << offset << "is out of range for a file of" << fileSize << "bytes";
+        return false;
+    }
+
+    return true;
+}
+
+}
+
+void MeshBlobImporter::openInternal(Containers::Array<char>&& data) {
+    using namespace Implementation;
+
+    if(data.size() < sizeof(MeshBlobHeader)) {
+        Error{} << "Trade::MeshBlobImporter::openData(): file too short, expected at least" << sizeof(MeshBlobHeader) << "bytes but got" << data.size();
+        return;
+    }
+
+    /* Both the copied and the loaded / mapped data are aligned enough for
+       this cast */
+    const MeshBlobHeader& header = *reinterpret_cast<const MeshBlobHeader*>(data.data());
+    if(std::memcmp(header.magic, "MBLB", 4) != 0) {
+        Error{} << "Trade::MeshBlobImporter::openData(): invalid file signature";
+        return;
+    }
+
+    if(header.version != MeshBlobVersion) {
+        Error{} << "Trade::MeshBlobImporter::openData(): unsupported file version" << header.version << Debug::nospace << ", expected" << MeshBlobVersion;
+        return;
+    }
+
+    #ifndef CORRADE_TARGET_BIG_ENDIAN
+    if(header.endianness != 'L')
+    #else
+    if(header.endianness != 'B')
+    #endif
+    {
+        if(header.endianness == 'L' || header.endianness == 'B')
+            Error{} << "Trade::MeshBlobImporter::openData(): can't import a" << (header.endianness == 'B' ? "big-endian" : "little-endian") << "file on a platform with different endianness";
+        else
+            Error{} << "Trade::MeshBlobImporter::openData(): invalid endianness tag";
+        return;
+    }
+
+    if(header.attributeCount > (data.size() - sizeof(MeshBlobHeader))/sizeof(MeshBlobAttribute)) {
+        Error{} << "Trade::MeshBlobImporter::openData(): file too short for" << header.attributeCount << "attributes";
+        return;
+    }
+
+    if(!checkDataRange("index data", header.indexDataOffset, header.indexDataSize, data.size()) ||
+       !checkDataRange("vertex data", header.vertexDataOffset, header.vertexDataSize, data.size()))
+        return;
+
+    /* Check that the index view is in bounds and aligned, so creating
+       MeshIndexData doesn't assert */
+    if(header.indexType) {
+        if(header.indexType > UnsignedInt(MeshIndexType::UnsignedInt)) {
+            Error{} << "Trade::MeshBlobImporter::openData(): invalid index type" << header.indexType;
+            return;
+        }
+
+        const UnsignedLong indexTypeSize = meshIndexTypeSize(MeshIndexType(header.indexType));
+        if(header.indexOffset % indexTypeSize ||
+           header.indexOffset > header.indexDataSize ||
+           header.indexCount*indexTypeSize > header.indexDataSize - header.indexOffset) {
+            Error{} << "Trade::MeshBlobImporter::openData():" << header.indexCount << MeshIndexType(header.indexType) << "indices at offset" << header.indexOffset << "are out of range or misaligned for" << header.indexDataSize << "bytes of index data";
+            return;
+        }
+    }
+
+    /* Check the attributes so creating MeshAttributeData and MeshData
+       doesn't assert */
+    const MeshBlobAttribute* const attributes = reinterpret_cast<const MeshBlobAttribute*>(data.data() + sizeof(MeshBlobHeader));
+    for(UnsignedInt i = 0; i != header.attributeCount; ++i) {
+        const MeshBlobAttribute& attribute = attributes[i];
+        const MeshAttribute name = MeshAttribute(attribute.name);
+        const VertexFormat format = VertexFormat(attribute.format);
+
+        if(!isVertexFormatImplementationSpecific(format) && (format == VertexFormat{} || UnsignedInt(format) > UnsignedInt(VertexFormat::Matrix4x3sNormalizedAligned))) {
+            Error{} << "Trade::MeshBlobImporter::openData(): invalid format" << attribute.format << "of attribute" << i;
+            return;
+        }
+
+        if(!Implementation::isVertexFormatCompatibleWithAttribute(name, format)) {
+            Error{} << "Trade::MeshBlobImporter::openData():" << format << "is not a valid format for" << name;
+            return;
+        }
+
+        if(attribute.arraySize && (isVertexFormatImplementationSpecific(format) || !Implementation::isAttributeArrayAllowed(name))) {
+            Error{} << "Trade::MeshBlobImporter::openData(): attribute" << i << "can't be an array";
+            return;
+        }
+
+        if(attribute.stride < 0) {
+            Error{} << "Trade::MeshBlobImporter::openData(): expected attribute" << i << "stride to be positive, got" << attribute.stride;
+            return;
+        }
+
+        /* Size of implementation-specific formats is unknown, so they can't
+           be checked */
+        if(!header.vertexCount || isVertexFormatImplementationSpecific(format))
+            continue;
+
+        const UnsignedLong size = vertexFormatSize(format)*Math::max(attribute.arraySize, UnsignedShort(1));
+        if(attribute.offset > header.vertexDataSize ||
+           UnsignedLong(header.vertexCount - 1)*attribute.stride + size > header.vertexDataSize - attribute.offset) {
+            Error{} << "Trade::MeshBlobImporter::openData(): attribute" << i << "is out of range for" << header.vertexDataSize << "bytes of vertex data";
+            return;
+        }
+    }
+
+    _in = std::move(data);
+}
+
+UnsignedInt MeshBlobImporter::doMeshCount() const { return 1; }
+
+Containers::Optional<MeshData> MeshBlobImporter::doMesh(UnsignedInt, UnsignedInt) {
+    using namespace Implementation;
+
+    /* Everything was checked in openInternal() already */
+    const MeshBlobHeader& header = *reinterpret_cast<const MeshBlobHeader*>(_in.data());
+    const MeshBlobAttribute* const blobAttributes = reinterpret_cast<const MeshBlobAttribute*>(_in.data() + sizeof(MeshBlobHeader));
+
+    /* The attribute array is small and has to be in a different format
+       anyway, so it's always created. Offset-only attributes make it
+       independent of where the vertex data end up. */
+    Containers::Array<MeshAttributeData> attributes{header.attributeCount};
+    for(UnsignedInt i = 0; i != header.attributeCount; ++i) {
+        const MeshBlobAttribute& attribute = blobAttributes[i];
+        attributes[i] = MeshAttributeData{MeshAttribute(attribute.name),
+            VertexFormat(attribute.format), std::size_t(attribute.offset),
+            header.vertexCount, attribute.stride, attribute.arraySize};
+    }
+
+    /* Index data are passed only for indexed meshes, as MeshData requires */
+    Containers::ArrayView<char> indexData;
+    if(header.indexType)
+        indexData = _in.slice(header.indexDataOffset, header.indexDataOffset + header.indexDataSize);
+    const Containers::ArrayView<char> vertexData = _in.slice(header.vertexDataOffset, header.vertexDataOffset + header.vertexDataSize);
+
+    /* Reference the file directly if requested. It's owned by us and stays
+       valid until the file is closed. */
+    if(flags() & ImporterFlag::ZeroCopy) {
+        MeshIndexData indices;
+        if(header.indexType)
+            indices = MeshIndexData{MeshIndexType(header.indexType), indexData.slice(header.indexOffset, header.indexOffset + std::size_t(header.indexCount)*meshIndexTypeSize(MeshIndexType(header.indexType)))};
+
+        return MeshData{MeshPrimitive(header.primitive),
+            DataFlag::ExternallyOwned|DataFlag::Mutable, indexData, indices,
+            DataFlag::ExternallyOwned|DataFlag::Mutable, vertexData,
+            std::move(attributes), header.vertexCount};
+    }
+
+    /* Otherwise make a copy, so the data don't depend on the importer */
+    Containers::Array<char> indexDataCopy{Containers::NoInit, indexData.size()};
+    Utility::copy(indexData, indexDataCopy);
+    Containers::Array<char> vertexDataCopy{Containers::NoInit, vertexData.size()};
+    Utility::copy(vertexData, vertexDataCopy);
+
+    MeshIndexData indices;
+    if(header.indexType)
+        indices = MeshIndexData{MeshIndexType(header.indexType), indexDataCopy.slice(header.indexOffset, header.indexOffset + std::size_t(header.indexCount)*meshIndexTypeSize(MeshIndexType(header.indexType)))};
+
+    return MeshData{MeshPrimitive(header.primitive),
+        std::move(indexDataCopy), indices,
+        std::move(vertexDataCopy), std::move(attributes), header.vertexCount};
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MeshBlobImporter, Magnum::Trade::MeshBlobImporter,
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.4")
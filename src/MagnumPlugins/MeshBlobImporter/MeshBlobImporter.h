@@ -0,0 +1,148 @@
+#ifndef Magnum_Trade_MeshBlobImporter_h
+#define Magnum_Trade_MeshBlobImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MeshBlobImporter
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/VisibilityMacros.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+
+#include "MagnumPlugins/MeshBlobImporter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MESHBLOBIMPORTER_BUILD_STATIC
+    #ifdef MeshBlobImporter_EXPORTS
+        #define MAGNUM_MESHBLOBIMPORTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MESHBLOBIMPORTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MESHBLOBIMPORTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MESHBLOBIMPORTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_MESHBLOBIMPORTER_EXPORT
+#define MAGNUM_MESHBLOBIMPORTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Mesh blob importer plugin
+@m_since_latest
+
+Imports meshes from a Magnum-specific binary format (`*.blob`) produced by
+@ref MeshBlobSceneConverter, which stores @ref MeshData index data, vertex
+data and attribute layout as-is, without any processing.
+
+@section Trade-MeshBlobImporter-usage Usage
+
+This plugin depends on the @ref Trade library and is built if
+`WITH_MESHBLOBIMPORTER` is enabled when building Magnum. To use as a dynamic
+plugin, load @cpp "MeshBlobImporter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(WITH_MESHBLOBIMPORTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::MeshBlobImporter)
+@endcode
+
+To use as a static plugin or use this as a dependency of another plugin with
+CMake, you need to request the `MeshBlobImporter` component of the `Magnum`
+package and link to the `Magnum::MeshBlobImporter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED MeshBlobImporter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::MeshBlobImporter)
+@endcode
+
+See @ref building, @ref cmake, @ref plugins and @ref file-formats for more
+information.
+
+@section Trade-MeshBlobImporter-behavior Behavior and limitations
+
+The file contains exactly one mesh, which is imported with the same primitive,
+index type, vertex format and attribute layout as it was written. Custom
+attributes and implementation-specific primitives and formats are preserved as
+well. The file header and attribute layout are validated when opening, so any
+failure is reported from @ref openData() or @ref openFile() already. Bounds of
+attributes with implementation-specific vertex formats can't be checked.
+
+The file is stored in the endianness of the platform it was written on.
+Opening a file with a different endianness fails, as the data would need to be
+converted and thus couldn't be referenced directly.
+
+@section Trade-MeshBlobImporter-zero-copy Zero-copy import
+
+By default, index and vertex data are copied into the returned @ref MeshData.
+If @ref ImporterFlag::ZeroCopy is set, the file opened with @ref openFile() is
+memory-mapped and @ref mesh() returns a @ref MeshData referencing it directly,
+without any parsing or copying, with both @ref MeshData::indexDataFlags() and
+@ref MeshData::vertexDataFlags() being @ref DataFlag::ExternallyOwned and
+@ref DataFlag::Mutable. The data are valid only until the file is closed.
+Files opened with @ref openData() are always copied, the flag then affects
+only whether @ref mesh() references the importer-owned copy.
+*/
+class MAGNUM_MESHBLOBIMPORTER_EXPORT MeshBlobImporter: public AbstractImporter {
+    public:
+        /** @brief Default constructor */
+        explicit MeshBlobImporter();
+
+        /** @brief Plugin manager constructor */
+        explicit MeshBlobImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
+
+        ~MeshBlobImporter();
+
+    private:
+        MAGNUM_MESHBLOBIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
+        MAGNUM_MESHBLOBIMPORTER_LOCAL bool doIsOpened() const override;
+        MAGNUM_MESHBLOBIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
+        MAGNUM_MESHBLOBIMPORTER_LOCAL void doOpenFileData(Containers::Array<char>&& data) override;
+        MAGNUM_MESHBLOBIMPORTER_LOCAL void doClose() override;
+
+        MAGNUM_MESHBLOBIMPORTER_LOCAL UnsignedInt doMeshCount() const override;
+        MAGNUM_MESHBLOBIMPORTER_LOCAL Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt level) override;
+
+        MAGNUM_MESHBLOBIMPORTER_LOCAL void openInternal(Containers::Array<char>&& data);
+
+        Containers::Array<char> _in;
+};
+
+}}
+
+#endif
@@ -0,0 +1,305 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MeshBlobImporter/MeshBlobHeader.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MeshBlobImporterTest: TestSuite::Tester {
+    explicit MeshBlobImporterTest();
+
+    void openShort();
+    void invalid();
+
+    void mesh();
+    void meshZeroCopy();
+    void meshNonIndexedImplementationSpecific();
+
+    void openTwice();
+    void importTwice();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+using Implementation::MeshBlobHeader;
+using Implementation::MeshBlobAttribute;
+
+const struct {
+    const char* name;
+    void(*modify)(MeshBlobHeader&, MeshBlobAttribute*);
+    const char* message;
+} InvalidData[] {
+    {"invalid signature",
+        [](MeshBlobHeader& header, MeshBlobAttribute*) { header.magic[3] = 'X'; },
+        "invalid file signature"},
+    {"unsupported version",
+        [](MeshBlobHeader& header, MeshBlobAttribute*) { header.version = 1; },
+        "unsupported file version 1, expected 0"},
+    {"different endianness",
+        [](MeshBlobHeader& header, MeshBlobAttribute*) {
+            #ifndef CORRADE_TARGET_BIG_ENDIAN
+            header.endianness = 'B';
+            #else
+            header.endianness = 'L';
+            #endif
+        },
+        #ifndef CORRADE_TARGET_BIG_ENDIAN
+        "can't import a big-endian file on a platform with different endianness"
+        #else
+        "can't import a little-endian file on a platform with different endianness"
+        #endif
+        },
+    {"invalid endianness",
+        [](MeshBlobHeader& header, MeshBlobAttribute*) { header.endianness = '?'; },
+        "invalid endianness tag"},
+    {"too many attributes",
+        [](MeshBlobHeader& header, MeshBlobAttribute*) { header.attributeCount = 6; },
+        "file too short for 6 attributes"},
+    {"index data out of range",
+        [](MeshBlobHeader& header, MeshBlobAttribute*) { header.indexDataSize = 77; },
+        "index data of 77 bytes at offset 128 is out of range for a file of 204 bytes"},
+    {"vertex data misaligned",
+        [](MeshBlobHeader& header, MeshBlobAttribute*) { header.vertexDataOffset = 148; },
+        "vertex data offset 148 is not aligned to 16 bytes"},
+    {"invalid index type",
+        [](MeshBlobHeader& header, MeshBlobAttribute*) { header.indexType = 4; },
+        "invalid index type 4"},
+    {"indices out of range",
+        [](MeshBlobHeader& header, MeshBlobAttribute*) { header.indexCount = 5; },
+        "5 MeshIndexType::UnsignedShort indices at offset 2 are out of range or misaligned for 10 bytes of index data"},
+    {"indices misaligned",
+        [](MeshBlobHeader& header, MeshBlobAttribute*) { header.indexOffset = 1; },
+        "3 MeshIndexType::UnsignedShort indices at offset 1 are out of range or misaligned for 10 bytes of index data"},
+    {"invalid vertex format",
+        [](MeshBlobHeader&, MeshBlobAttribute* attributes) { attributes[1].format = 0; },
+        "invalid format 0 of attribute 1"},
+    {"format not valid for attribute",
+        [](MeshBlobHeader&, MeshBlobAttribute* attributes) { attributes[1].format = UnsignedInt(VertexFormat::Vector3d); },
+        "VertexFormat::Vector3d is not a valid format for Trade::MeshAttribute::TextureCoordinates"},
+    {"array builtin attribute",
+        [](MeshBlobHeader&, MeshBlobAttribute* attributes) { attributes[0].arraySize = 2; },
+        "attribute 0 can't be an array"},
+    {"negative stride",
+        [](MeshBlobHeader&, MeshBlobAttribute* attributes) { attributes[1].stride = -20; },
+        "expected attribute 1 stride to be positive, got -20"},
+    {"attribute out of range",
+        [](MeshBlobHeader&, MeshBlobAttribute* attributes) { attributes[1].offset = 44; },
+        "attribute 1 is out of range for 60 bytes of vertex data"}
+};
+
+MeshBlobImporterTest::MeshBlobImporterTest() {
+    addTests({&MeshBlobImporterTest::openShort});
+
+    addInstancedTests({&MeshBlobImporterTest::invalid},
+        Containers::arraySize(InvalidData));
+
+    addTests({&MeshBlobImporterTest::mesh,
+              &MeshBlobImporterTest::meshZeroCopy,
+              &MeshBlobImporterTest::meshNonIndexedImplementationSpecific,
+
+              &MeshBlobImporterTest::openTwice,
+              &MeshBlobImporterTest::importTwice});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef MESHBLOBIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(MESHBLOBIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void MeshBlobImporterTest::openShort() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshBlobImporter");
+    Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "mesh.blob"));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data.prefix(71)));
+    CORRADE_COMPARE(out.str(), "Trade::MeshBlobImporter::openData(): file too short, expected at least 72 bytes but got 71\n");
+}
+
+void MeshBlobImporterTest::invalid() {
+    auto&& data = InvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshBlobImporter");
+    Containers::Array<char> file = Utility::Directory::read(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "mesh.blob"));
+    CORRADE_COMPARE(file.size(), 204);
+    data.modify(*reinterpret_cast<MeshBlobHeader*>(file.data()),
+        reinterpret_cast<MeshBlobAttribute*>(file.data() + sizeof(MeshBlobHeader)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(file));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::MeshBlobImporter::openData(): {}\n", data.message));
+}
+
+void MeshBlobImporterTest::mesh() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshBlobImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "mesh.blob")));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(mesh->indexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+
+    CORRADE_VERIFY(mesh->isIndexed());
+    CORRADE_COMPARE(mesh->indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(mesh->indexData().size(), 10);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({0, 2, 1}),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+    CORRADE_COMPARE(mesh->attributeCount(), 2);
+    CORRADE_COMPARE(mesh->attributeName(0), MeshAttribute::Position);
+    CORRADE_COMPARE(mesh->attributeFormat(0), VertexFormat::Vector3);
+    CORRADE_COMPARE(mesh->attributeOffset(0), 0);
+    CORRADE_COMPARE(mesh->attributeStride(0), 20);
+    CORRADE_COMPARE(mesh->attributeName(1), MeshAttribute::TextureCoordinates);
+    CORRADE_COMPARE(mesh->attributeFormat(1), VertexFormat::Vector2);
+    CORRADE_COMPARE(mesh->attributeOffset(1), 12);
+    CORRADE_COMPARE(mesh->attributeStride(1), 20);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {-1.0f, -1.0f, 0.0f},
+            { 1.0f, -1.0f, 0.0f},
+            { 0.0f,  1.0f, 0.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        Containers::arrayView<Vector2>({
+            {0.0f, 0.0f},
+            {1.0f, 0.0f},
+            {0.5f, 1.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void MeshBlobImporterTest::meshZeroCopy() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshBlobImporter");
+    importer->setFlags(ImporterFlag::ZeroCopy);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "mesh.blob")));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    Containers::Optional<MeshData> mesh2 = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_VERIFY(mesh2);
+    CORRADE_COMPARE(mesh->indexDataFlags(), DataFlag::ExternallyOwned|DataFlag::Mutable);
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlag::ExternallyOwned|DataFlag::Mutable);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({0, 2, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        Containers::arrayView<Vector2>({
+            {0.0f, 0.0f},
+            {1.0f, 0.0f},
+            {0.5f, 1.0f}
+        }), TestSuite::Compare::Container);
+
+    /* Both meshes reference the same memory owned by the importer, so a
+       change in one is visible in the other */
+    CORRADE_COMPARE(mesh->indexData().data(), mesh2->indexData().data());
+    CORRADE_COMPARE(mesh->vertexData().data(), mesh2->vertexData().data());
+    mesh->mutableAttribute<Vector3>(MeshAttribute::Position)[1] = {2.0f, 3.0f, 4.0f};
+    CORRADE_COMPARE(mesh2->attribute<Vector3>(MeshAttribute::Position)[1], (Vector3{2.0f, 3.0f, 4.0f}));
+
+    /* But not in the file */
+    importer->close();
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "mesh.blob")));
+    Containers::Optional<MeshData> mesh3 = importer->mesh(0);
+    CORRADE_VERIFY(mesh3);
+    CORRADE_COMPARE(mesh3->attribute<Vector3>(MeshAttribute::Position)[1], (Vector3{1.0f, -1.0f, 0.0f}));
+}
+
+void MeshBlobImporterTest::meshNonIndexedImplementationSpecific() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshBlobImporter");
+    Containers::Array<char> file = Utility::Directory::read(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "mesh.blob"));
+    CORRADE_COMPARE(file.size(), 204);
+
+    /* Turn the mesh into a non-indexed one with an implementation-specific
+       primitive and format */
+    MeshBlobHeader& header = *reinterpret_cast<MeshBlobHeader*>(file.data());
+    MeshBlobAttribute* attributes = reinterpret_cast<MeshBlobAttribute*>(file.data() + sizeof(MeshBlobHeader));
+    header.primitive = UnsignedInt(meshPrimitiveWrap(0xdead));
+    header.indexType = 0;
+    header.indexCount = 0;
+    attributes[1].format = UnsignedInt(vertexFormatWrap(0xcafe));
+
+    CORRADE_VERIFY(importer->openData(file));
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), meshPrimitiveWrap(0xdead));
+    CORRADE_VERIFY(!mesh->isIndexed());
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+    CORRADE_COMPARE(mesh->attributeFormat(1), vertexFormatWrap(0xcafe));
+    CORRADE_COMPARE(mesh->attributeOffset(1), 12);
+    CORRADE_COMPARE(mesh->attributeStride(1), 20);
+}
+
+void MeshBlobImporterTest::openTwice() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshBlobImporter");
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "mesh.blob")));
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "mesh.blob")));
+
+    /* Shouldn't crash, leak or anything */
+}
+
+void MeshBlobImporterTest::importTwice() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshBlobImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "mesh.blob")));
+
+    /* Verify that everything is working the same way on second use */
+    {
+        Containers::Optional<MeshData> mesh = importer->mesh(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->vertexCount(), 3);
+    } {
+        Containers::Optional<MeshData> mesh = importer->mesh(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->vertexCount(), 3);
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MeshBlobImporterTest)
@@ -0,0 +1,109 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshBlobSceneConverter.h"
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MeshBlobImporter/MeshBlobHeader.h"
+
+namespace Magnum { namespace Trade {
+
+MeshBlobSceneConverter::MeshBlobSceneConverter() = default;
+
+MeshBlobSceneConverter::MeshBlobSceneConverter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractSceneConverter{manager, plugin} {}
+
+MeshBlobSceneConverter::~MeshBlobSceneConverter() = default;
+
+SceneConverterFeatures MeshBlobSceneConverter::doFeatures() const {
+    return SceneConverterFeature::ConvertMeshToData;
+}
+
+namespace {
+
+std::size_t alignData(const std::size_t offset) {
+    return (offset + Implementation::MeshBlobDataAlignment - 1)/Implementation::MeshBlobDataAlignment*Implementation::MeshBlobDataAlignment;
+}
+
+}
+
+Containers::Array<char> MeshBlobSceneConverter::doConvertToData(const MeshData& mesh) {
+    using namespace Implementation;
+
+    /* Calculate the layout. Index data of non-indexed meshes are always
+       empty, so no special-casing is needed for those. */
+    const Containers::ArrayView<const char> indexData = mesh.indexData();
+    const Containers::ArrayView<const char> vertexData = mesh.vertexData();
+    const std::size_t indexDataOffset = alignData(sizeof(MeshBlobHeader) + mesh.attributeCount()*sizeof(MeshBlobAttribute));
+    const std::size_t vertexDataOffset = alignData(indexDataOffset + indexData.size());
+
+    /* Zero-initialized so the padding and reserved fields are zero */
+    Containers::Array<char> out{Containers::ValueInit, vertexDataOffset + vertexData.size()};
+
+    MeshBlobHeader& header = *reinterpret_cast<MeshBlobHeader*>(out.data());
+    std::memcpy(header.magic, "MBLB", 4);
+    header.version = MeshBlobVersion;
+    #ifndef CORRADE_TARGET_BIG_ENDIAN
+    header.endianness = 'L';
+    #else
+    header.endianness = 'B';
+    #endif
+    header.primitive = UnsignedInt(mesh.primitive());
+    if(mesh.isIndexed()) {
+        header.indexType = UnsignedInt(mesh.indexType());
+        header.indexCount = mesh.indexCount();
+        header.indexOffset = static_cast<const char*>(mesh.indices().data()) - indexData.data();
+    }
+    header.vertexCount = mesh.vertexCount();
+    header.attributeCount = mesh.attributeCount();
+    header.indexDataOffset = indexDataOffset;
+    header.indexDataSize = indexData.size();
+    header.vertexDataOffset = vertexDataOffset;
+    header.vertexDataSize = vertexData.size();
+
+    MeshBlobAttribute* const attributes = reinterpret_cast<MeshBlobAttribute*>(out.data() + sizeof(MeshBlobHeader));
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        attributes[i].format = UnsignedInt(mesh.attributeFormat(i));
+        attributes[i].name = UnsignedShort(mesh.attributeName(i));
+        attributes[i].arraySize = mesh.attributeArraySize(i);
+        attributes[i].offset = mesh.attributeOffset(i);
+        attributes[i].stride = mesh.attributeStride(i);
+    }
+
+    Utility::copy(indexData, out.slice(indexDataOffset, indexDataOffset + indexData.size()));
+    Utility::copy(vertexData, out.suffix(vertexDataOffset));
+
+    return out;
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MeshBlobSceneConverter, Magnum::Trade::MeshBlobSceneConverter,
+    "cz.mosra.magnum.Trade.AbstractSceneConverter/0.1")
@@ -0,0 +1,120 @@
+#ifndef Magnum_Trade_MeshBlobSceneConverter_h
+#define Magnum_Trade_MeshBlobSceneConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MeshBlobSceneConverter
+ * @m_since_latest
+ */
+
+#include "Magnum/Trade/AbstractSceneConverter.h"
+#include "MagnumPlugins/MeshBlobSceneConverter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MESHBLOBSCENECONVERTER_BUILD_STATIC
+    #ifdef MeshBlobSceneConverter_EXPORTS
+        #define MAGNUM_MESHBLOBSCENECONVERTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MESHBLOBSCENECONVERTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MESHBLOBSCENECONVERTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MESHBLOBSCENECONVERTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_MESHBLOBSCENECONVERTER_EXPORT
+#define MAGNUM_MESHBLOBSCENECONVERTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Mesh blob converter plugin
+@m_since_latest
+
+Writes a @ref MeshData into a Magnum-specific binary format (`*.blob`) that
+can be imported back with @ref MeshBlobImporter, without any parsing and
+optionally without any copying.
+
+@section Trade-MeshBlobSceneConverter-usage Usage
+
+This plugin depends on the @ref Trade library and is built if
+`WITH_MESHBLOBSCENECONVERTER` is enabled when building Magnum. To use as a
+dynamic plugin, load @cpp "MeshBlobSceneConverter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(WITH_MESHBLOBSCENECONVERTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::MeshBlobSceneConverter)
+@endcode
+
+To use as a static plugin or as a dependency of another plugin with CMake, you
+need to request the `MeshBlobSceneConverter` component of the `Magnum` package
+and link to the `Magnum::MeshBlobSceneConverter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED MeshBlobSceneConverter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::MeshBlobSceneConverter)
+@endcode
+
+See @ref building, @ref cmake, @ref plugins and @ref file-formats for more
+information.
+
+@section Trade-MeshBlobSceneConverter-behavior Behavior and limitations
+
+The whole index and vertex data of the mesh are written as-is, together with
+the primitive, index type and attribute layout, including custom attributes
+and implementation-specific primitives and vertex formats. The output starts
+with a versioned header tagged with the platform endianness and the index and
+vertex data are aligned to 16 bytes, so the importer can reference them
+directly from a memory-mapped file. Attributes are stored as offsets relative
+to the vertex data.
+*/
+class MAGNUM_MESHBLOBSCENECONVERTER_EXPORT MeshBlobSceneConverter: public AbstractSceneConverter {
+    public:
+        /** @brief Default constructor */
+        explicit MeshBlobSceneConverter();
+
+        /** @brief Plugin manager constructor */
+        explicit MeshBlobSceneConverter(PluginManager::AbstractManager& manager, const std::string& plugin);
+
+        ~MeshBlobSceneConverter();
+
+    private:
+        MAGNUM_MESHBLOBSCENECONVERTER_LOCAL SceneConverterFeatures doFeatures() const override;
+        MAGNUM_MESHBLOBSCENECONVERTER_LOCAL Containers::Array<char> doConvertToData(const MeshData& mesh) override;
+};
+
+}}
+
+#endif
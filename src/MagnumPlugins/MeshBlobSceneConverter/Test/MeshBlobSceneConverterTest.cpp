@@ -0,0 +1,247 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AbstractSceneConverter.h"
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MeshBlobImporter/MeshBlobHeader.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MeshBlobSceneConverterTest: TestSuite::Tester {
+    explicit MeshBlobSceneConverterTest();
+
+    void indexed();
+    void nonIndexed();
+    void customArrayAttribute();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractSceneConverter> _converterManager{"nonexistent"};
+    PluginManager::Manager<AbstractImporter> _importerManager{"nonexistent"};
+};
+
+using Implementation::MeshBlobHeader;
+using Implementation::MeshBlobAttribute;
+
+MeshBlobSceneConverterTest::MeshBlobSceneConverterTest() {
+    addTests({&MeshBlobSceneConverterTest::indexed,
+              &MeshBlobSceneConverterTest::nonIndexed,
+              &MeshBlobSceneConverterTest::customArrayAttribute});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef MESHBLOBSCENECONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_converterManager.load(MESHBLOBSCENECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    /* Optional plugins that don't have to be here */
+    #ifdef MESHBLOBIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_importerManager.load(MESHBLOBIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void MeshBlobSceneConverterTest::indexed() {
+    const UnsignedShort indexData[]{0xffff, 0, 2, 1, 0xffff};
+    const struct Vertex {
+        Vector3 position;
+        Vector2 textureCoordinates;
+    } vertexData[]{
+        {{-1.0f, -1.0f, 0.0f}, {0.0f, 0.0f}},
+        {{ 1.0f, -1.0f, 0.0f}, {1.0f, 0.0f}},
+        {{ 0.0f,  1.0f, 0.0f}, {0.5f, 1.0f}}
+    };
+    const Containers::StridedArrayView1D<const Vector3> positions{vertexData, &vertexData[0].position, 3, sizeof(Vertex)};
+    const Containers::StridedArrayView1D<const Vector2> textureCoordinates{vertexData, &vertexData[0].textureCoordinates, 3, sizeof(Vertex)};
+
+    const MeshData mesh{MeshPrimitive::Triangles,
+        {}, indexData, MeshIndexData{Containers::arrayView(indexData).slice(1, 4)},
+        {}, vertexData, {
+            MeshAttributeData{MeshAttribute::Position, positions},
+            MeshAttributeData{MeshAttribute::TextureCoordinates, textureCoordinates}
+        }};
+
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MeshBlobSceneConverter");
+    Containers::Array<char> data = converter->convertToData(mesh);
+    CORRADE_VERIFY(data);
+
+    /* The layout is the same as of the MeshBlobImporter test file, so
+       compare the header contents against it */
+    CORRADE_COMPARE(data.size(), 204);
+    const MeshBlobHeader& header = *reinterpret_cast<const MeshBlobHeader*>(data.data());
+    CORRADE_COMPARE(std::string(header.magic, 4), "MBLB");
+    CORRADE_COMPARE(header.version, 0);
+    #ifndef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_COMPARE(header.endianness, 'L');
+    #else
+    CORRADE_COMPARE(header.endianness, 'B');
+    #endif
+    CORRADE_COMPARE(header.primitive, UnsignedInt(MeshPrimitive::Triangles));
+    CORRADE_COMPARE(header.indexType, UnsignedInt(MeshIndexType::UnsignedShort));
+    CORRADE_COMPARE(header.indexCount, 3);
+    CORRADE_COMPARE(header.vertexCount, 3);
+    CORRADE_COMPARE(header.attributeCount, 2);
+    CORRADE_COMPARE(header.indexOffset, 2);
+    CORRADE_COMPARE(header.indexDataOffset, 128);
+    CORRADE_COMPARE(header.indexDataSize, 10);
+    CORRADE_COMPARE(header.vertexDataOffset, 144);
+    CORRADE_COMPARE(header.vertexDataSize, 60);
+
+    const MeshBlobAttribute* attributes = reinterpret_cast<const MeshBlobAttribute*>(data.data() + sizeof(MeshBlobHeader));
+    CORRADE_COMPARE(attributes[0].name, UnsignedShort(MeshAttribute::Position));
+    CORRADE_COMPARE(attributes[0].format, UnsignedInt(VertexFormat::Vector3));
+    CORRADE_COMPARE(attributes[0].offset, 0);
+    CORRADE_COMPARE(attributes[0].stride, 20);
+    CORRADE_COMPARE(attributes[1].name, UnsignedShort(MeshAttribute::TextureCoordinates));
+    CORRADE_COMPARE(attributes[1].format, UnsignedInt(VertexFormat::Vector2));
+    CORRADE_COMPARE(attributes[1].offset, 12);
+    CORRADE_COMPARE(attributes[1].stride, 20);
+
+    CORRADE_COMPARE_AS(data.slice(128, 138),
+        Containers::arrayCast<const char>(Containers::arrayView(indexData)),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.suffix(144),
+        Containers::arrayCast<const char>(Containers::arrayView(vertexData)),
+        TestSuite::Compare::Container);
+
+    if(!(_importerManager.loadState("MeshBlobImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MeshBlobImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MeshBlobImporter");
+    CORRADE_VERIFY(importer->openData(data));
+    Containers::Optional<MeshData> imported = importer->mesh(0);
+    CORRADE_VERIFY(imported);
+    CORRADE_COMPARE(imported->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(imported->indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE_AS(imported->indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({0, 2, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(imported->attribute<Vector3>(MeshAttribute::Position),
+        positions,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(imported->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        textureCoordinates,
+        TestSuite::Compare::Container);
+}
+
+void MeshBlobSceneConverterTest::nonIndexed() {
+    const Vector2 positions[]{
+        {-1.0f, -1.0f},
+        { 1.0f, -1.0f},
+        { 0.0f,  1.0f},
+        { 1.0f,  1.0f}
+    };
+
+    const MeshData mesh{MeshPrimitive::LineStrip,
+        {}, positions, {
+            MeshAttributeData{MeshAttribute::Position, Containers::arrayView(positions)}
+        }};
+
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MeshBlobSceneConverter");
+    Containers::Array<char> data = converter->convertToData(mesh);
+    CORRADE_VERIFY(data);
+
+    /* Index data are empty, vertex data start right after the attributes */
+    const MeshBlobHeader& header = *reinterpret_cast<const MeshBlobHeader*>(data.data());
+    CORRADE_COMPARE(header.primitive, UnsignedInt(MeshPrimitive::LineStrip));
+    CORRADE_COMPARE(header.indexType, 0);
+    CORRADE_COMPARE(header.indexCount, 0);
+    CORRADE_COMPARE(header.indexDataOffset, 96);
+    CORRADE_COMPARE(header.indexDataSize, 0);
+    CORRADE_COMPARE(header.vertexDataOffset, 96);
+    CORRADE_COMPARE(header.vertexDataSize, 32);
+    CORRADE_COMPARE(data.size(), 128);
+
+    if(!(_importerManager.loadState("MeshBlobImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MeshBlobImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MeshBlobImporter");
+    CORRADE_VERIFY(importer->openData(data));
+    Containers::Optional<MeshData> imported = importer->mesh(0);
+    CORRADE_VERIFY(imported);
+    CORRADE_COMPARE(imported->primitive(), MeshPrimitive::LineStrip);
+    CORRADE_VERIFY(!imported->isIndexed());
+    CORRADE_COMPARE_AS(imported->attribute<Vector2>(MeshAttribute::Position),
+        Containers::arrayView(positions),
+        TestSuite::Compare::Container);
+}
+
+void MeshBlobSceneConverterTest::customArrayAttribute() {
+    const UnsignedByte indexData[]{2, 0, 1};
+    const Float weights[]{
+        0.25f, 0.75f,
+        0.5f, 0.5f,
+        1.0f, 0.0f
+    };
+
+    const MeshData mesh{MeshPrimitive::Points,
+        {}, indexData, MeshIndexData{indexData},
+        {}, weights, {
+            MeshAttributeData{meshAttributeCustom(42), VertexFormat::Float, 0, 3, 8, 2}
+        }};
+
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MeshBlobSceneConverter");
+    Containers::Array<char> data = converter->convertToData(mesh);
+    CORRADE_VERIFY(data);
+
+    const MeshBlobAttribute& attribute = *reinterpret_cast<const MeshBlobAttribute*>(data.data() + sizeof(MeshBlobHeader));
+    CORRADE_COMPARE(attribute.name, UnsignedShort(meshAttributeCustom(42)));
+    CORRADE_COMPARE(attribute.format, UnsignedInt(VertexFormat::Float));
+    CORRADE_COMPARE(attribute.arraySize, 2);
+    CORRADE_COMPARE(attribute.offset, 0);
+    CORRADE_COMPARE(attribute.stride, 8);
+
+    if(!(_importerManager.loadState("MeshBlobImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MeshBlobImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MeshBlobImporter");
+    CORRADE_VERIFY(importer->openData(data));
+    Containers::Optional<MeshData> imported = importer->mesh(0);
+    CORRADE_VERIFY(imported);
+    CORRADE_COMPARE(imported->indexType(), MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE_AS(imported->indices<UnsignedByte>(),
+        Containers::arrayView(indexData),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(imported->attributeName(0), meshAttributeCustom(42));
+    CORRADE_COMPARE(imported->attributeArraySize(0), 2);
+    Containers::StridedArrayView2D<const Float> importedWeights = imported->attribute<Float[]>(0);
+    CORRADE_COMPARE(importedWeights[0][1], 0.75f);
+    CORRADE_COMPARE(importedWeights[1][0], 0.5f);
+    CORRADE_COMPARE(importedWeights[2][0], 1.0f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MeshBlobSceneConverterTest)
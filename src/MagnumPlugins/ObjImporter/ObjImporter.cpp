@@ -25,59 +25,230 @@
 
 #include "ObjImporter.h"
 
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
-#include <limits>
-#include <sstream>
+#include <string>
 #include <unordered_map>
-#include <Corrade/Containers/GrowableArray.h>
+#include <vector>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Configuration.h>
 #include <Corrade/Utility/DebugStl.h>
-#include <Corrade/Utility/String.h>
+#include <Corrade/Utility/Directory.h>
 
+#include "Magnum/FileCallback.h"
 #include "Magnum/Mesh.h"
-#include "Magnum/MeshTools/CompressIndices.h"
+#include "Magnum/Implementation/parallelFor.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Duplicate.h"
-#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
 #include "Magnum/Trade/MeshData.h"
 
+/* Same condition as for Utility::Directory::mapRead() */
+#if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+#define _MAGNUM_OBJIMPORTER_USE_MAPPING
+#endif
+
 namespace Magnum { namespace Trade {
 
+namespace {
+
+struct ObjMesh {
+    /* Byte range in the file */
+    std::size_t begin, end;
+
+    /* Offsets of the first position, texture coordinate and normal in the
+       mesh, indices in the file are relative to the whole file */
+    UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
+
+    /* Counts of positions, texture coordinates, normals and index tuples
+       in the mesh, used to allocate everything upfront in doMesh() */
+    UnsignedInt positionCount, textureCoordinateCount, normalCount;
+    std::size_t indexCount;
+};
+
+}
+
 struct ObjImporter::File {
     std::unordered_map<std::string, UnsignedInt> meshesForName;
     std::vector<std::string> meshNames;
-    std::vector<std::tuple<std::streampos, std::streampos, UnsignedInt, UnsignedInt, UnsignedInt>> meshes;
-    Containers::Pointer<std::istream> in;
+    std::vector<ObjMesh> meshes;
+
+    /* File contents. Points either into the owned copy, the memory-mapped
+       file or to memory owned by the file callback. */
+    Containers::ArrayView<const char> in;
+    Containers::Array<char> data;
+    #ifdef _MAGNUM_OBJIMPORTER_USE_MAPPING
+    Containers::Array<const char, Utility::Directory::MapDeleter> mappedData;
+    #endif
+
+    /* If non-empty, the file callback has to be notified with this filename
+       on close */
+    std::string callbackFilename;
 };
 
 namespace {
 
-void ignoreLine(std::istream& in) {
-    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+inline bool isWhitespace(const char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/* Returns the next whitespace-delimited token before the line end and
+   advances past it. The returned view is empty if there are no more tokens
+   on the line. */
+Containers::ArrayView<const char> nextToken(const char*& it, const char* const lineEnd) {
+    while(it != lineEnd && isWhitespace(*it)) ++it;
+    const char* const begin = it;
+    while(it != lineEnd && !isWhitespace(*it)) ++it;
+    return {begin, std::size_t(it - begin)};
+}
+
+/* Returns the rest of the line with whitespace trimmed from both sides */
+Containers::ArrayView<const char> restOfLine(const char* it, const char* lineEnd) {
+    while(it != lineEnd && isWhitespace(*it)) ++it;
+    while(lineEnd != it && isWhitespace(*(lineEnd - 1))) --lineEnd;
+    return {it, std::size_t(lineEnd - it)};
+}
+
+/* Returns the end of the line starting at it, pointing either to the '\n' or
+   to the end of the data */
+inline const char* lineEnd(const char* const it, const char* const end) {
+    const char* const found = static_cast<const char*>(std::memchr(it, '\n', end - it));
+    return found ? found : end;
+}
+
+template<std::size_t size> inline bool is(const Containers::ArrayView<const char> token, const char(&keyword)[size]) {
+    return token.size() == size - 1 && std::memcmp(token.data(), keyword, size - 1) == 0;
 }
 
-template<std::size_t size> Math::Vector<size, Float> extractFloatData(const std::string& str, Float* extra = nullptr) {
-    std::vector<std::string> data = Utility::String::splitWithoutEmptyParts(str, ' ');
-    if(data.size() < size || data.size() > size + (extra ? 1 : 0)) {
-        Error() << "Trade::ObjImporter::mesh(): invalid float array size";
-        throw 0;
+/* Parses a float. Plain decimal numbers with a mantissa that fits into 24
+   bits and an exponent of at most 10 are converted with a single float
+   multiplication or division, which is correctly rounded as both operands
+   are exact. That's done without touching the locale or the heap.
+   Everything else (long mantissas, large exponents, infinities, NaNs,
+   hexadecimal floats) goes through std::strtof() on a null-terminated copy
+   --- going through a double intermediate instead could round differently
+   than strtof() for values that end up exactly halfway between two floats.
+   Returns false if the whole token isn't a valid number. */
+bool parseFloat(const Containers::ArrayView<const char> token, Float& out) {
+    /* Powers of ten that are exactly representable in a float */
+    constexpr Float Powers[]{
+        1.0e0f, 1.0e1f, 1.0e2f, 1.0e3f, 1.0e4f, 1.0e5f, 1.0e6f, 1.0e7f,
+        1.0e8f, 1.0e9f, 1.0e10f
+    };
+
+    const char* it = token.begin();
+    const char* const end = token.end();
+
+    bool negative = false;
+    if(it != end && (*it == '-' || *it == '+')) {
+        negative = *it == '-';
+        ++it;
     }
 
-    Math::Vector<size, Float> output;
+    UnsignedLong mantissa = 0;
+    Int digits = 0, exponent = 0;
+    bool anyDigits = false, fast = true;
+    for(; it != end && *it >= '0' && *it <= '9'; ++it) {
+        anyDigits = true;
+        if(mantissa || *it != '0') ++digits;
+        mantissa = mantissa*10 + (*it - '0');
+    }
+    if(it != end && *it == '.') {
+        ++it;
+        for(; it != end && *it >= '0' && *it <= '9'; ++it) {
+            anyDigits = true;
+            if(mantissa || *it != '0') ++digits;
+            mantissa = mantissa*10 + (*it - '0');
+            --exponent;
+        }
+    }
+    if(anyDigits && it != end && (*it == 'e' || *it == 'E')) {
+        ++it;
+        bool negativeExponent = false;
+        if(it != end && (*it == '-' || *it == '+')) {
+            negativeExponent = *it == '-';
+            ++it;
+        }
+        if(it == end || *it < '0' || *it > '9') return false;
+        Int e = 0;
+        for(; it != end && *it >= '0' && *it <= '9'; ++it)
+            if(e < 10000) e = e*10 + (*it - '0');
+        exponent += negativeExponent ? -e : e;
+    }
 
-    for(std::size_t i = 0; i != size; ++i)
-        output[i] = std::stof(data[i]);
+    /* Too many digits for the mantissa (which thus also might have
+       overflown), a mantissa that isn't exactly representable in a float or
+       an exponent that can't be applied exactly */
+    if(digits > 19 || mantissa > (1ull << 24) || exponent < -10 || exponent > 10)
+        fast = false;
+
+    if(anyDigits && it == end && fast) {
+        Float value = Float(mantissa);
+        value = exponent < 0 ? value/Powers[-exponent] : value*Powers[exponent];
+        out = negative ? -value : value;
+        return true;
+    }
+
+    /* Not a number at all, bail early before doing the expensive stuff */
+    if(!anyDigits && token.size() < 3) return false;
 
-    if(data.size() == size+1) {
-        /* This should be obvious from the first if, but add this just to make
-           Clang Analyzer happy */
-        CORRADE_INTERNAL_ASSERT(extra);
+    /* Slow path. Numbers that long are rare, so just allocate. */
+    const std::string copy{token.data(), token.size()};
+    char* parsedEnd;
+    out = std::strtof(copy.data(), &parsedEnd);
+    return parsedEnd == copy.data() + copy.size();
+}
 
-        *extra = std::stof(data.back());
+/* Parses an unsigned integer, returns false if the whole token isn't a valid
+   number or if it doesn't fit into 32 bits */
+bool parseIndex(const Containers::ArrayView<const char> token, UnsignedInt& out) {
+    if(token.empty()) return false;
+    UnsignedLong value = 0;
+    for(const char c: token) {
+        if(c < '0' || c > '9') return false;
+        value = value*10 + (c - '0');
+        if(value > 0xffffffffull) return false;
     }
+    out = UnsignedInt(value);
+    return true;
+}
+
+/* Errors are recorded instead of printed directly in doMesh() so chunks
+   parsed in parallel can report the error that comes first in the file */
+enum class ParseError: UnsignedByte {
+    None,
+    InvalidFloatArraySize,
+    InvalidNumber,
+    HomogeneousCoordinates,
+    TextureCoordinates3D,
+    MixedPrimitive,
+    WrongPointIndexCount,
+    WrongLineIndexCount,
+    WrongTriangleIndexCount,
+    Polygons,
+    InvalidIndexData,
+    UnknownKeyword
+};
+
+/* Parses between `size` and `size + extra` floats until the end of the
+   line */
+template<std::size_t size> ParseError parseFloatData(const char* it, const char* const lineEnd, Math::Vector<size, Float>& out, Float* extra = nullptr) {
+    std::size_t count = 0;
+    for(Containers::ArrayView<const char> token; !(token = nextToken(it, lineEnd)).empty(); ++count) {
+        if(count >= size + (extra ? 1 : 0))
+            return ParseError::InvalidFloatArraySize;
 
-    return output;
+        if(!parseFloat(token, count < size ? out[count] : *extra))
+            return ParseError::InvalidNumber;
+    }
+
+    if(count < size) return ParseError::InvalidFloatArraySize;
+
+    return ParseError::None;
 }
 
 }
@@ -86,29 +257,82 @@ ObjImporter::ObjImporter() = default;
 
 ObjImporter::ObjImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
-ObjImporter::~ObjImporter() = default;
+ObjImporter::~ObjImporter() {
+    /* Notify the file callback that we no longer need the data, if any */
+    if(_file) doClose();
+}
 
-ImporterFeatures ObjImporter::doFeatures() const { return ImporterFeature::OpenData; }
+ImporterFeatures ObjImporter::doFeatures() const { return ImporterFeature::OpenData|ImporterFeature::FileCallback; }
 
-void ObjImporter::doClose() { _file.reset(); }
+void ObjImporter::doClose() {
+    if(_file && !_file->callbackFilename.empty())
+        fileCallback()(_file->callbackFilename, InputFileCallbackPolicy::Close, fileCallbackUserData());
+    _file.reset();
+}
 
 bool ObjImporter::doIsOpened() const { return !!_file; }
 
 void ObjImporter::doOpenFile(const std::string& filename) {
-    Containers::Pointer<std::istream> in{new std::ifstream{filename, std::ios::binary}};
-    if(!in->good()) {
+    /* If file callbacks are set, ask for the data to be kept around until
+       the file is closed so we don't need to copy it */
+    if(fileCallback()) {
+        const Containers::Optional<Containers::ArrayView<const char>> data = fileCallback()(filename, InputFileCallbackPolicy::LoadPermanent, fileCallbackUserData());
+        if(!data) {
+            Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
+            return;
+        }
+
+        _file.reset(new File);
+        _file->in = *data;
+        _file->callbackFilename = filename;
+        parseMeshNames();
+        return;
+    }
+
+    #ifdef _MAGNUM_OBJIMPORTER_USE_MAPPING
+    /* Otherwise map the file. Empty files can't be mapped, so check the size
+       first. */
+    std::size_t size;
+    {
+        std::ifstream in{filename, std::ios::binary|std::ios::ate};
+        if(!in.good()) {
+            Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
+            return;
+        }
+        size = std::size_t(in.tellg());
+    }
+
+    _file.reset(new File);
+    if(size) {
+        _file->mappedData = Utility::Directory::mapRead(filename);
+        if(!_file->mappedData.data()) {
+            Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
+            _file.reset();
+            return;
+        }
+        _file->in = _file->mappedData;
+    }
+    #else
+    /* Or read it into memory where mapping isn't available */
+    if(!Utility::Directory::exists(filename)) {
         Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
         return;
     }
 
     _file.reset(new File);
-    _file->in = std::move(in);
+    _file->data = Utility::Directory::read(filename);
+    _file->in = _file->data;
+    #endif
+
     parseMeshNames();
 }
 
 void ObjImporter::doOpenData(Containers::ArrayView<const char> data) {
+    /* The data are not guaranteed to stay in scope, so copy them */
     _file.reset(new File);
-    _file->in.reset(new std::istringstream{{data.begin(), data.size()}});
+    _file->data = Containers::Array<char>{Containers::NoInit, data.size()};
+    Utility::copy(data, _file->data);
+    _file->in = _file->data;
 
     parseMeshNames();
 }
@@ -119,32 +343,33 @@ void ObjImporter::parseMeshNames() {
     UnsignedInt positionIndexOffset = 1;
     UnsignedInt normalIndexOffset = 1;
     UnsignedInt textureCoordinateIndexOffset = 1;
-    _file->meshes.emplace_back(0, 0, positionIndexOffset, normalIndexOffset, textureCoordinateIndexOffset);
+    _file->meshes.push_back({0, 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, 0, 0, 0, 0});
 
     /* The first mesh doesn't have name by default but we might find it later,
        so we need to track whether there are any data before first name */
     bool thisIsFirstMeshAndItHasNoData = true;
     _file->meshNames.emplace_back();
 
-    while(_file->in->good()) {
+    const char* const begin = _file->in.begin();
+    const char* const end = _file->in.end();
+    for(const char* it = begin; it != end; ) {
         /* The previous object might end at the beginning of this line */
-        const std::streampos end = _file->in->tellg();
+        const char* const lineBegin = it;
+        const char* const currentLineEnd = lineEnd(it, end);
+        const char* const nextLine = currentLineEnd == end ? end : currentLineEnd + 1;
+        it = nextLine;
 
-        /* Comment line */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
-        }
+        /* Parse the keyword, skip empty and comment lines */
+        const char* lineIt = lineBegin;
+        const Containers::ArrayView<const char> keyword = nextToken(lineIt, currentLineEnd);
+        if(keyword.empty() || keyword[0] == '#') continue;
 
-        /* Parse the keyword */
-        std::string keyword;
-        *_file->in >> keyword;
+        ObjMesh& mesh = _file->meshes.back();
 
         /* Mesh name */
-        if(keyword == "o") {
-            std::string name;
-            std::getline(*_file->in, name);
-            name = Utility::String::trim(name);
+        if(is(keyword, "o")) {
+            const Containers::ArrayView<const char> nameView = restOfLine(lineIt, currentLineEnd);
+            std::string name{nameView.data(), nameView.size()};
 
             /* This is the name of first mesh */
             if(thisIsFirstMeshAndItHasNoData) {
@@ -156,54 +381,49 @@ void ObjImporter::parseMeshNames() {
                 _file->meshNames.back() = std::move(name);
 
                 /* Update its begin offset to be more precise */
-                std::get<0>(_file->meshes.back()) = _file->in->tellg();
+                mesh.begin = nextLine - begin;
 
             /* Otherwise this is a name of new mesh */
             } else {
                 /* Set end of the previous one */
-                std::get<1>(_file->meshes.back()) = end;
+                mesh.end = lineBegin - begin;
 
                 /* Save name and offset of the new one. The end offset will be
                    updated later. */
                 if(!name.empty())
                     _file->meshesForName.emplace(name, _file->meshes.size());
                 _file->meshNames.emplace_back(std::move(name));
-                _file->meshes.emplace_back(_file->in->tellg(), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
+                _file->meshes.push_back({std::size_t(nextLine - begin), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, 0, 0, 0, 0});
             }
 
-            continue;
-
         /* If there are any data/indices before the first name, it means that
            the first object is unnamed. We need to check for them. */
 
         /* Vertex data, update index offset for the following meshes */
-        } else if(keyword == "v") {
+        } else if(is(keyword, "v")) {
             ++positionIndexOffset;
+            ++mesh.positionCount;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vt") {
+        } else if(is(keyword, "vt")) {
             ++textureCoordinateIndexOffset;
+            ++mesh.textureCoordinateCount;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vn") {
+        } else if(is(keyword, "vn")) {
             ++normalIndexOffset;
+            ++mesh.normalCount;
             thisIsFirstMeshAndItHasNoData = false;
 
-        /* Index data, just mark that we found something for first unnamed
-           object */
-        } else if(thisIsFirstMeshAndItHasNoData) for(const std::string& data: {"p", "l", "f"}) {
-            if(keyword == data) {
-                thisIsFirstMeshAndItHasNoData = false;
-                break;
-            }
+        /* Index data, count the index tuples and mark that we found
+           something for first unnamed object */
+        } else if(is(keyword, "p") || is(keyword, "l") || is(keyword, "f")) {
+            while(!nextToken(lineIt, currentLineEnd).empty())
+                ++mesh.indexCount;
+            thisIsFirstMeshAndItHasNoData = false;
         }
-
-        /* Ignore the rest of the line */
-        ignoreLine(*_file->in);
     }
 
     /* Set end of the last object */
-    _file->in->clear();
-    _file->in->seekg(0, std::ios::end);
-    std::get<1>(_file->meshes.back()) = _file->in->tellg();
+    _file->meshes.back().end = _file->in.size();
 }
 
 UnsignedInt ObjImporter::doMeshCount() const { return _file->meshes.size(); }
@@ -219,186 +439,360 @@ std::string ObjImporter::doMeshName(UnsignedInt id) {
 
 namespace {
 
-template<class T> bool checkAndDuplicateInto(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::Array<T>& data, const Containers::StridedArrayView1D<T>& out, UnsignedInt offset) {
-    /* Check that indices are in range. Add back the original index offset for
-       easier data debugging. */
-    for(UnsignedInt i: indices) if(i >= data.size()) {
-        Error{} << "Trade::ObjImporter::mesh(): index" << (i + offset) << "out of range for" << data.size() << "vertices";
-        return false;
-    }
+/* Chunks smaller than this aren't worth a thread */
+constexpr std::size_t MinChunkSize = 64*1024;
 
-    MeshTools::duplicateInto(indices, stridedArrayView(data), out);
-    return true;
-}
+/* A line-aligned part of the mesh byte range, parsed by a single thread */
+struct Chunk {
+    const char* begin;
+    const char* end;
 
-}
+    /* Where data of this chunk start in the output arrays */
+    std::size_t positionOffset, textureCoordinateOffset, normalOffset, indexOffset;
 
-Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt) {
-    /* Seek the file, set mesh parsing parameters */
-    std::streampos begin, end;
-    UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
-    std::tie(begin, end, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset) = _file->meshes[id];
-    _file->in->seekg(begin);
+    /* Counts of data parsed in this chunk */
+    std::size_t positionCount, textureCoordinateCount, normalCount, indexCount;
+    std::size_t textureCoordinateIndexCount, normalIndexCount;
 
+    /* First primitive in the chunk and the line where it was found, used for
+       checking that primitives aren't mixed across chunks */
     Containers::Optional<MeshPrimitive> primitive;
-    Containers::Array<Vector3> positions;
-    Containers::Array<Vector3> normals;
-    Containers::Array<Vector2> textureCoordinates;
-    /* Taking a shortcut as there's fortunately nothing else than just 3 types
-       of data. First positions, then normals, then texture coordinates. */
-    Containers::Array<Vector3ui> indices;
-    std::size_t textureCoordinateIndexCount = 0, normalIndexCount = 0;
+    const char* primitiveLine;
+
+    /* First error in the chunk, the line where it happened and additional
+       info for the message */
+    ParseError error;
+    const char* errorLine;
+    MeshPrimitive errorPrimitive;
+    Containers::ArrayView<const char> errorKeyword;
+};
 
-    try { while(_file->in->good() && _file->in->tellg() < end) {
-        /* Ignore comments */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
+/* Counts data in given chunk the same way as parseMeshNames() does for whole
+   meshes, in order to know where each chunk should write its output */
+void countChunk(Chunk& chunk) {
+    for(const char* it = chunk.begin; it != chunk.end; ) {
+        const char* const currentLineEnd = lineEnd(it, chunk.end);
+        const char* lineIt = it;
+        it = currentLineEnd == chunk.end ? chunk.end : currentLineEnd + 1;
+
+        const Containers::ArrayView<const char> keyword = nextToken(lineIt, currentLineEnd);
+        if(keyword.empty() || keyword[0] == '#') continue;
+
+        if(is(keyword, "v")) ++chunk.positionCount;
+        else if(is(keyword, "vt")) ++chunk.textureCoordinateCount;
+        else if(is(keyword, "vn")) ++chunk.normalCount;
+        else if(is(keyword, "p") || is(keyword, "l") || is(keyword, "f")) {
+            while(!nextToken(lineIt, currentLineEnd).empty())
+                ++chunk.indexCount;
         }
+    }
+}
 
-        /* Get the line */
-        std::string line;
-        std::getline(*_file->in, line);
-        line = Utility::String::trim(line);
+/* Parses given chunk into the output arrays, starting at the chunk offsets.
+   Stops at the first error. */
+void parseChunk(Chunk& chunk, const ObjMesh& mesh, const Containers::ArrayView<Vector3> positions, const Containers::ArrayView<Vector3> normals, const Containers::ArrayView<Vector2> textureCoordinates, const Containers::ArrayView<Vector3ui> indices) {
+    for(const char* it = chunk.begin; it != chunk.end; ) {
+        const char* const lineBegin = it;
+        const char* const currentLineEnd = lineEnd(it, chunk.end);
+        const char* lineIt = it;
+        it = currentLineEnd == chunk.end ? chunk.end : currentLineEnd + 1;
 
-        /* Ignore empty lines */
-        if(line.empty()) continue;
+        /* Ignore empty lines and comments */
+        const Containers::ArrayView<const char> keyword = nextToken(lineIt, currentLineEnd);
+        if(keyword.empty() || keyword[0] == '#') continue;
 
-        /* Split the line into keyword and contents */
-        const std::size_t keywordEnd = line.find(' ');
-        const std::string keyword = line.substr(0, keywordEnd);
-        const std::string contents = keywordEnd != std::string::npos ?
-            Utility::String::ltrim(line.substr(keywordEnd+1)) : "";
+        ParseError error = ParseError::None;
 
         /* Vertex position */
-        if(keyword == "v") {
+        if(is(keyword, "v")) {
             Float extra{1.0f};
-            const Vector3 data = extractFloatData<3>(contents, &extra);
-            if(!Math::TypeTraits<Float>::equals(extra, 1.0f)) {
-                Error() << "Trade::ObjImporter::mesh(): homogeneous coordinates are not supported";
-                return Containers::NullOpt;
+            Vector3 data;
+            if((error = parseFloatData(lineIt, currentLineEnd, data, &extra)) == ParseError::None) {
+                if(!Math::TypeTraits<Float>::equals(extra, 1.0f))
+                    error = ParseError::HomogeneousCoordinates;
+                else positions[chunk.positionOffset + chunk.positionCount++] = data;
             }
 
-            arrayAppend(positions, data);
-
         /* Texture coordinate */
-        } else if(keyword == "vt") {
+        } else if(is(keyword, "vt")) {
             Float extra{0.0f};
-            const Vector2 data = extractFloatData<2>(contents, &extra);
-            if(!Math::TypeTraits<Float>::equals(extra, 0.0f)) {
-                Error() << "Trade::ObjImporter::mesh(): 3D texture coordinates are not supported";
-                return Containers::NullOpt;
+            Vector2 data;
+            if((error = parseFloatData(lineIt, currentLineEnd, data, &extra)) == ParseError::None) {
+                if(!Math::TypeTraits<Float>::equals(extra, 0.0f))
+                    error = ParseError::TextureCoordinates3D;
+                else textureCoordinates[chunk.textureCoordinateOffset + chunk.textureCoordinateCount++] = data;
             }
 
-            arrayAppend(textureCoordinates, data);
-
         /* Normal */
-        } else if(keyword == "vn") {
-            arrayAppend(normals, Vector3{extractFloatData<3>(contents)});
+        } else if(is(keyword, "vn")) {
+            Vector3 data;
+            if((error = parseFloatData(lineIt, currentLineEnd, data)) == ParseError::None)
+                normals[chunk.normalOffset + chunk.normalCount++] = data;
 
         /* Indices */
-        } else if(keyword == "p" || keyword == "l" || keyword == "f") {
-            const std::vector<std::string> indexTuples = Utility::String::splitWithoutEmptyParts(contents, ' ');
-
-            /* Points */
-            if(keyword == "p") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Points) {
-                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << MeshPrimitive::Points;
-                    return Containers::NullOpt;
-                }
-
-                /* Check vertex count per primitive */
-                if(indexTuples.size() != 1) {
-                    Error() << "Trade::ObjImporter::mesh(): wrong index count for point";
-                    return Containers::NullOpt;
-                }
-
+        } else if(is(keyword, "p") || is(keyword, "l") || is(keyword, "f")) {
+            /* Count the tuples first to check them against the primitive */
+            std::size_t tupleCount = 0;
+            for(const char* countIt = lineIt; !nextToken(countIt, currentLineEnd).empty(); )
+                ++tupleCount;
+
+            MeshPrimitive primitive{};
+            if(is(keyword, "p")) {
                 primitive = MeshPrimitive::Points;
-
-            /* Lines */
-            } else if(keyword == "l") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Lines) {
-                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << MeshPrimitive::Lines;
-                    return Containers::NullOpt;
-                }
-
-                /* Check vertex count per primitive */
-                if(indexTuples.size() != 2) {
-                    Error() << "Trade::ObjImporter::mesh(): wrong index count for line";
-                    return Containers::NullOpt;
-                }
-
+                if(tupleCount != 1)
+                    error = ParseError::WrongPointIndexCount;
+            } else if(is(keyword, "l")) {
                 primitive = MeshPrimitive::Lines;
-
-            /* Faces */
-            } else if(keyword == "f") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Triangles) {
-                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << MeshPrimitive::Triangles;
-                    return Containers::NullOpt;
-                }
-
-                /* Check vertex count per primitive */
-                if(indexTuples.size() < 3) {
-                    Error() << "Trade::ObjImporter::mesh(): wrong index count for triangle";
-                    return Containers::NullOpt;
-                } else if(indexTuples.size() != 3) {
-                    Error() << "Trade::ObjImporter::mesh(): polygons are not supported";
-                    return Containers::NullOpt;
-                }
-
+                if(tupleCount != 2)
+                    error = ParseError::WrongLineIndexCount;
+            } else if(is(keyword, "f")) {
                 primitive = MeshPrimitive::Triangles;
-
+                if(tupleCount < 3)
+                    error = ParseError::WrongTriangleIndexCount;
+                else if(tupleCount != 3)
+                    error = ParseError::Polygons;
             } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 
-            for(const std::string& indexTuple: indexTuples) {
-                std::vector<std::string> indexStrings = Utility::String::split(indexTuple, '/');
-                if(indexStrings.size() > 3) {
-                    Error() << "Trade::ObjImporter::mesh(): invalid index data";
-                    return Containers::NullOpt;
+            /* Check that we don't mix the primitives in one mesh, which takes
+               precedence over the index count check. The first primitive is
+               remembered together with its line even if the line is invalid
+               so mixing across chunks gets detected at the same place as
+               when parsing serially. */
+            if(!chunk.primitive) {
+                chunk.primitive = primitive;
+                chunk.primitiveLine = lineBegin;
+            } else if(*chunk.primitive != primitive) {
+                error = ParseError::MixedPrimitive;
+                chunk.errorPrimitive = primitive;
+            }
+
+            for(Containers::ArrayView<const char> indexTuple; error == ParseError::None && !(indexTuple = nextToken(lineIt, currentLineEnd)).empty(); ) {
+                /* Split the tuple on slashes */
+                Containers::ArrayView<const char> indexStrings[3];
+                std::size_t indexStringCount = 0;
+                const char* tupleIt = indexTuple.begin();
+                for(;;) {
+                    if(indexStringCount == 3) {
+                        error = ParseError::InvalidIndexData;
+                        break;
+                    }
+
+                    const char* const slash = static_cast<const char*>(std::memchr(tupleIt, '/', indexTuple.end() - tupleIt));
+                    const char* const stringEnd = slash ? slash : indexTuple.end();
+                    indexStrings[indexStringCount++] = {tupleIt, std::size_t(stringEnd - tupleIt)};
+                    if(!slash) break;
+                    tupleIt = slash + 1;
                 }
+                if(error != ParseError::None) break;
 
                 Vector3ui index;
 
                 /* Position indices */
-                index[0] = std::stoul(indexStrings[0]) - positionIndexOffset;
+                if(!parseIndex(indexStrings[0], index[0])) {
+                    error = ParseError::InvalidNumber;
+                    break;
+                }
+                index[0] -= mesh.positionIndexOffset;
 
                 /* Texture coordinates */
-                if(indexStrings.size() == 2 || (indexStrings.size() == 3 && !indexStrings[1].empty())) {
-                    index[2] = std::stoul(indexStrings[1]) - textureCoordinateIndexOffset;
-                    ++textureCoordinateIndexCount;
+                if(indexStringCount == 2 || (indexStringCount == 3 && !indexStrings[1].empty())) {
+                    if(!parseIndex(indexStrings[1], index[2])) {
+                        error = ParseError::InvalidNumber;
+                        break;
+                    }
+                    index[2] -= mesh.textureCoordinateIndexOffset;
+                    ++chunk.textureCoordinateIndexCount;
                 }
 
                 /* Normal indices */
-                if(indexStrings.size() == 3) {
-                    index[1] = std::stoul(indexStrings[2]) - normalIndexOffset;
-                    ++normalIndexCount;
+                if(indexStringCount == 3) {
+                    if(!parseIndex(indexStrings[2], index[1])) {
+                        error = ParseError::InvalidNumber;
+                        break;
+                    }
+                    index[1] -= mesh.normalIndexOffset;
+                    ++chunk.normalIndexCount;
                 }
 
-                arrayAppend(indices, index);
+                indices[chunk.indexOffset + chunk.indexCount++] = index;
             }
 
         /* Ignore unsupported keywords, error out on unknown keywords */
-        } else if(![&keyword](){
-            /* Using lambda to emulate for-else construct like in Python */
-            for(const std::string expected: {"mtllib", "usemtl", "g", "s"})
-                if(keyword == expected) return true;
-            return false;
-        }()) {
-            Error() << "Trade::ObjImporter::mesh(): unknown keyword" << keyword;
+        } else if(!is(keyword, "mtllib") && !is(keyword, "usemtl") && !is(keyword, "g") && !is(keyword, "s")) {
+            error = ParseError::UnknownKeyword;
+            chunk.errorKeyword = keyword;
+        }
+
+        if(error != ParseError::None) {
+            chunk.error = error;
+            chunk.errorLine = lineBegin;
+            return;
+        }
+    }
+}
+
+void printError(const Chunk& chunk) {
+    Error e;
+    e << "Trade::ObjImporter::mesh():";
+    switch(chunk.error) {
+        case ParseError::InvalidFloatArraySize:
+            e << "invalid float array size";
+            return;
+        case ParseError::InvalidNumber:
+            e << "error while converting numeric data";
+            return;
+        case ParseError::HomogeneousCoordinates:
+            e << "homogeneous coordinates are not supported";
+            return;
+        case ParseError::TextureCoordinates3D:
+            e << "3D texture coordinates are not supported";
+            return;
+        case ParseError::MixedPrimitive:
+            e << "mixed primitive" << *chunk.primitive << "and" << chunk.errorPrimitive;
+            return;
+        case ParseError::WrongPointIndexCount:
+            e << "wrong index count for point";
+            return;
+        case ParseError::WrongLineIndexCount:
+            e << "wrong index count for line";
+            return;
+        case ParseError::WrongTriangleIndexCount:
+            e << "wrong index count for triangle";
+            return;
+        case ParseError::Polygons:
+            e << "polygons are not supported";
+            return;
+        case ParseError::InvalidIndexData:
+            e << "invalid index data";
+            return;
+        case ParseError::UnknownKeyword:
+            e << "unknown keyword" << std::string{chunk.errorKeyword.data(), chunk.errorKeyword.size()};
+            return;
+        case ParseError::None: break;
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+template<class T> bool checkAndDuplicateInto(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::Array<T>& data, const Containers::StridedArrayView1D<T>& out, UnsignedInt offset) {
+    /* Check that indices are in range. Add back the original index offset for
+       easier data debugging. */
+    for(UnsignedInt i: indices) if(i >= data.size()) {
+        Error{} << "Trade::ObjImporter::mesh(): index" << (i + offset) << "out of range for" << data.size() << "vertices";
+        return false;
+    }
+
+    MeshTools::duplicateInto(indices, stridedArrayView(data), out);
+    return true;
+}
+
+}
+
+Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt) {
+    const ObjMesh& mesh = _file->meshes[id];
+    const UnsignedInt positionIndexOffset = mesh.positionIndexOffset;
+    const UnsignedInt textureCoordinateIndexOffset = mesh.textureCoordinateIndexOffset;
+    const UnsignedInt normalIndexOffset = mesh.normalIndexOffset;
+    const char* const begin = _file->in.begin() + mesh.begin;
+    const char* const end = _file->in.begin() + mesh.end;
+
+    /* Decide on the thread count. A plugin instantiated without a plugin
+       manager has no configuration, in which case it's single-threaded. */
+    const std::size_t threadCount = Magnum::Implementation::parallelThreadCount(
+        configuration().hasValue("threadCount") ? configuration().value<UnsignedInt>("threadCount") : 1,
+        std::size_t(end - begin), MinChunkSize);
+
+    /* Split the mesh into chunks at line boundaries. Each chunk extends to
+       the end of the line it would otherwise split; if that makes it
+       overlap the next one, the next one is empty. */
+    Containers::Array<Chunk> chunks{Containers::ValueInit, threadCount};
+    {
+        const char* it = begin;
+        for(std::size_t i = 0; i != threadCount; ++i) {
+            chunks[i].begin = it;
+            if(i + 1 == threadCount) it = end;
+            else {
+                const char* const split = begin + std::size_t(end - begin)*(i + 1)/threadCount;
+                if(split > it) {
+                    it = lineEnd(split, end);
+                    if(it != end) ++it;
+                }
+            }
+            chunks[i].end = it;
+        }
+    }
+
+    /* Everything was counted when opening the file, so allocate the arrays
+       upfront instead of growing them */
+    Containers::Array<Vector3> positions{Containers::NoInit, mesh.positionCount};
+    Containers::Array<Vector3> normals{Containers::NoInit, mesh.normalCount};
+    Containers::Array<Vector2> textureCoordinates{Containers::NoInit, mesh.textureCoordinateCount};
+    /* Taking a shortcut as there's fortunately nothing else than just 3 types
+       of data. First positions, then normals, then texture coordinates. */
+    Containers::Array<Vector3ui> indices{Containers::NoInit, mesh.indexCount};
+
+    /* With more than one chunk count the data in each to know where it should
+       write its output. A single chunk starts at zero offsets. */
+    if(threadCount > 1) {
+        Magnum::Implementation::parallelFor(threadCount, [&](const std::size_t i) {
+            countChunk(chunks[i]);
+        });
+
+        std::size_t positionOffset = 0, textureCoordinateOffset = 0, normalOffset = 0, indexOffset = 0;
+        for(Chunk& chunk: chunks) {
+            chunk.positionOffset = positionOffset;
+            chunk.textureCoordinateOffset = textureCoordinateOffset;
+            chunk.normalOffset = normalOffset;
+            chunk.indexOffset = indexOffset;
+            positionOffset += chunk.positionCount;
+            textureCoordinateOffset += chunk.textureCoordinateCount;
+            normalOffset += chunk.normalCount;
+            indexOffset += chunk.indexCount;
+            chunk.positionCount = chunk.textureCoordinateCount = chunk.normalCount = chunk.indexCount = 0;
+        }
+        CORRADE_INTERNAL_ASSERT(positionOffset == positions.size() &&
+            normalOffset == normals.size() &&
+            textureCoordinateOffset == textureCoordinates.size() &&
+            indexOffset == indices.size());
+    }
+
+    Magnum::Implementation::parallelFor(threadCount, [&](const std::size_t i) {
+        parseChunk(chunks[i], mesh, positions, normals, textureCoordinates, indices);
+    });
+
+    /* Go through the chunks in order and report the first error, which is
+       the same that a serial parse would stop at. A primitive that differs
+       from the one in previous chunks is an error as well, unless the chunk
+       has another error before. */
+    Containers::Optional<MeshPrimitive> primitive;
+    std::size_t positionCount = 0, normalCount = 0, textureCoordinateCount = 0, indexCount = 0;
+    std::size_t textureCoordinateIndexCount = 0, normalIndexCount = 0;
+    for(const Chunk& chunk: chunks) {
+        if(primitive && chunk.primitive && *primitive != *chunk.primitive && (chunk.error == ParseError::None || chunk.primitiveLine <= chunk.errorLine)) {
+            Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << *chunk.primitive;
             return Containers::NullOpt;
         }
 
-    }} catch(const std::exception&) {
-        Error() << "Trade::ObjImporter::mesh(): error while converting numeric data";
-        return Containers::NullOpt;
-    } catch(...) {
-        /* Error message already printed */
-        return Containers::NullOpt;
+        if(chunk.error != ParseError::None) {
+            printError(chunk);
+            return Containers::NullOpt;
+        }
+
+        if(!primitive) primitive = chunk.primitive;
+        positionCount += chunk.positionCount;
+        normalCount += chunk.normalCount;
+        textureCoordinateCount += chunk.textureCoordinateCount;
+        indexCount += chunk.indexCount;
+        textureCoordinateIndexCount += chunk.textureCoordinateIndexCount;
+        normalIndexCount += chunk.normalIndexCount;
     }
 
+    /* Everything should be filled exactly as counted when opening */
+    CORRADE_INTERNAL_ASSERT(positionCount == positions.size() &&
+        normalCount == normals.size() &&
+        textureCoordinateCount == textureCoordinates.size() &&
+        indexCount == indices.size());
+
     /* There should be at least indexed position data */
     if(positions.empty() || indices.empty()) {
         Error() << "Trade::ObjImporter::mesh(): incomplete position data";
@@ -432,7 +826,8 @@ Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt)
     Containers::Array<char> indexData{Containers::NoInit, indices.size()*sizeof(UnsignedInt)};
     const auto indexDataI = Containers::arrayCast<UnsignedInt>(indexData);
     const std::size_t vertexCount = MeshTools::removeDuplicatesInPlaceInto(
-        Containers::arrayCast<2, char>(arrayView(indices)), indexDataI);
+        Containers::arrayCast<2, char>(arrayView(indices)), indexDataI,
+        threadCount);
 
     /* Allocate attribute and vertex data */
     std::size_t attributeCount = 1;
@@ -486,4 +881,4 @@ Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt)
 }}
 
 CORRADE_PLUGIN_REGISTER(ObjImporter, Magnum::Trade::ObjImporter,
-    "cz.mosra.magnum.Trade.AbstractImporter/0.3.3")
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.4")
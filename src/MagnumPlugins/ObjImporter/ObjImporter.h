@@ -98,6 +98,31 @@ positions with optional @ref VertexFormat::Vector3 normals and
 @ref VertexFormat::Vector2 texture coordinates, if present in the source file.
 
 Polygons (quads etc.) and material properties are currently not supported.
+
+The file is parsed in place without any per-line or per-number allocations.
+When opening a file, it's memory-mapped on platforms that support it instead
+of being read into memory. If file callbacks are set, the file is requested
+with @ref InputFileCallbackPolicy::LoadPermanent and the returned memory is
+expected to stay valid until the file is closed, at which point the callback is
+called with @ref InputFileCallbackPolicy::Close. Data passed to
+@ref openData() are copied. Counts of all vertex data are gathered when
+opening the file, so @ref mesh() doesn't need to grow any arrays during
+import.
+
+@section Trade-ObjImporter-configuration Plugin-specific configuration
+
+It's possible to tune various import options through @ref configuration(). See
+below for all options and their default values:
+
+@snippet MagnumPlugins/ObjImporter/ObjImporter.conf configuration_
+
+With @cb{.ini} threadCount @ce set to a value other than @cpp 1 @ce, the byte
+range of each mesh is split into chunks at line boundaries, the chunks are
+parsed in parallel and the resulting index tuples are deduplicated using
+@ref MeshTools::removeDuplicatesInPlaceInto() with the same thread count. The
+output is the same as with a single
+thread, including the reported errors. On Emscripten the option is ignored and
+the import is always single-threaded.
 */
 class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
     public:
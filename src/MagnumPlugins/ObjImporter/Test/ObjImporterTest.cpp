@@ -27,9 +27,13 @@
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/Configuration.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/FormatStl.h>
 
+#include "Magnum/FileCallback.h"
 #include "Magnum/Mesh.h"
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/Trade/AbstractImporter.h"
@@ -92,10 +96,71 @@ struct ObjImporterTest: TestSuite::Tester {
     void unsupportedKeyword();
     void unknownKeyword();
 
+    void openData();
+    void openFileNonexistent();
+    void fileCallback();
+    void whitespace();
+    void numberFormats();
+    void numberRounding();
+
+    void threaded();
+    void threadedError();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
 
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadedData[]{
+    {"2 threads", 2},
+    {"5 threads", 5},
+    {"all hardware threads", 0}
+};
+
+const struct {
+    const char* name;
+    const char* prefix;
+    const char* suffix;
+    const char* message;
+} ThreadedErrorData[]{
+    {"unknown keyword in the last chunk", "", "bleh\n",
+        "unknown keyword bleh"},
+    {"mixed primitive across chunks", "", "l 1 2\n",
+        "mixed primitive MeshPrimitive::Triangles and MeshPrimitive::Lines"},
+    {"mixed primitive across chunks with wrong index count", "", "p 1 2\n",
+        "mixed primitive MeshPrimitive::Triangles and MeshPrimitive::Points"},
+    {"error before a mixed primitive in the same chunk", "", "v 1 2\nl 1 2\n",
+        "invalid float array size"},
+    {"errors in the first and the last chunk", "vt 1 2 3\n", "bleh\n",
+        "3D texture coordinates are not supported"}
+};
+
+/* A grid large enough to be split into several chunks, vertices of each row
+   interleaved with faces of the previous row. All faces reference the same
+   normal so the index tuples don't map 1:1 to the output vertices. */
+std::string threadedGrid() {
+    constexpr Int Size = 64;
+    std::string out;
+    for(Int y = 0; y <= Size; ++y) {
+        for(Int x = 0; x <= Size; ++x)
+            out += Utility::formatString("v {} {} {}\nvt {} {}\nvn 0 0 1\n",
+                x*0.5f, y*0.25f, (x ^ y)*0.125f, x/Float(Size), y/Float(Size));
+        if(!y) continue;
+        for(Int x = 0; x != Size; ++x) {
+            const Int a = (y - 1)*(Size + 1) + x + 1;
+            const Int b = a + 1;
+            const Int c = a + Size + 1;
+            const Int d = c + 1;
+            out += Utility::formatString(
+                "f {0}/{0}/1 {1}/{1}/1 {3}/{3}/1\n"
+                "f {0}/{0}/1 {3}/{3}/1 {2}/{2}/1\n", a, b, c, d);
+        }
+    }
+    return out;
+}
+
 ObjImporterTest::ObjImporterTest() {
     addTests({&ObjImporterTest::pointMesh,
               &ObjImporterTest::lineMesh,
@@ -145,7 +210,20 @@ ObjImporterTest::ObjImporterTest() {
               &ObjImporterTest::wrongNormalIndexCount,
 
               &ObjImporterTest::unsupportedKeyword,
-              &ObjImporterTest::unknownKeyword});
+              &ObjImporterTest::unknownKeyword,
+
+              &ObjImporterTest::openData,
+              &ObjImporterTest::openFileNonexistent,
+              &ObjImporterTest::fileCallback,
+              &ObjImporterTest::whitespace,
+              &ObjImporterTest::numberFormats,
+              &ObjImporterTest::numberRounding});
+
+    addInstancedTests({&ObjImporterTest::threaded},
+        Containers::arraySize(ThreadedData));
+
+    addInstancedTests({&ObjImporterTest::threadedError},
+        Containers::arraySize(ThreadedErrorData));
 
     #ifdef OBJIMPORTER_PLUGIN_FILENAME
     CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(OBJIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
@@ -797,6 +875,215 @@ void ObjImporterTest::unknownKeyword() {
     CORRADE_COMPARE(out.str(), "Trade::ObjImporter::mesh(): unknown keyword bleh\n");
 }
 
+void ObjImporterTest::openData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    /* The data are copied, so they can go out of scope after opening */
+    {
+        Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "moreMeshes.obj"));
+        CORRADE_VERIFY(importer->openData(data));
+    }
+
+    CORRADE_COMPARE(importer->meshCount(), 3);
+    CORRADE_COMPARE(importer->meshName(2), "TriangleMesh");
+
+    const Containers::Optional<MeshData> data = importer->mesh(2);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE_AS(data->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {0.5f, 2.0f, 3.0f},
+            {0.0f, 1.5f, 1.0f},
+            {2.0f, 3.0f, 5.5f}
+        }), TestSuite::Compare::Container);
+}
+
+void ObjImporterTest::openFileNonexistent() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openFile("nonexistent.obj"));
+    CORRADE_COMPARE(out.str(), "Trade::ObjImporter::openFile(): cannot open file nonexistent.obj\n");
+}
+
+void ObjImporterTest::fileCallback() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_VERIFY(importer->features() & ImporterFeature::FileCallback);
+
+    struct Data {
+        Containers::Array<char> file;
+        std::string calls;
+    } data;
+    data.file = Utility::Directory::read(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "pointMesh.obj"));
+
+    importer->setFileCallback([](const std::string& filename, InputFileCallbackPolicy policy, Data& data) -> Containers::Optional<Containers::ArrayView<const char>> {
+        data.calls += Utility::formatString("{}:{} ", filename, UnsignedInt(policy));
+        if(policy == InputFileCallbackPolicy::Close) return {};
+        return Containers::arrayView(data.file);
+    }, data);
+
+    /* The data are requested to be kept in memory for the whole time the
+       file is opened, the callback gets notified on close */
+    CORRADE_VERIFY(importer->openFile("mesh.obj"));
+    CORRADE_COMPARE(data.calls, Utility::formatString("mesh.obj:{} ", UnsignedInt(InputFileCallbackPolicy::LoadPermanent)));
+
+    const Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedInt>(),
+        Containers::arrayView<UnsignedInt>({0, 1, 2, 0}),
+        TestSuite::Compare::Container);
+
+    importer->close();
+    CORRADE_COMPARE(data.calls, Utility::formatString("mesh.obj:{} mesh.obj:{} ",
+        UnsignedInt(InputFileCallbackPolicy::LoadPermanent),
+        UnsignedInt(InputFileCallbackPolicy::Close)));
+}
+
+void ObjImporterTest::whitespace() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    /* CRLF line endings, tabs, trailing and leading whitespace, no newline
+       at the end */
+    const char data[] =
+        "# comment\r\n"
+        "o  Mesh\t \r\n"
+        "\tv 1 2\t3\r\n"
+        "  v   4 5 6  \r\n"
+        "\r\n"
+        "l 1\t2 ";
+    CORRADE_VERIFY(importer->openData({data, sizeof(data) - 1}));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+    CORRADE_COMPARE(importer->meshName(0), "Mesh");
+
+    const Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void ObjImporterTest::numberFormats() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    const char data[] =
+        "v -1.5e2 +.25 7.\n"
+        "v 0.000125 1E-2 12345678901234567890\n"
+        "v 0x1p3 -0 1e-30\n"
+        "p 1\n"
+        "p 2\n"
+        "p 3\n";
+    CORRADE_VERIFY(importer->openData({data, sizeof(data) - 1}));
+
+    const Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {-150.0f, 0.25f, 7.0f},
+            {0.000125f, 0.01f, 12345678901234567890.0f},
+            {8.0f, 0.0f, 1.0e-30f}
+        }), TestSuite::Compare::Container);
+
+    /* Trailing garbage is not allowed */
+    const char garbage[] =
+        "v 1.5x 2 3\n"
+        "p 1\n";
+    CORRADE_VERIFY(importer->openData({garbage, sizeof(garbage) - 1}));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), "Trade::ObjImporter::mesh(): error while converting numeric data\n");
+}
+
+void ObjImporterTest::numberRounding() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    /* The first number is just above a value halfway between two floats,
+       but closest to the halfway value in a double, so going through a
+       double would round it down instead of up. The rest goes through the
+       fast path. */
+    const char data[] =
+        "v 5.085076093673706 0.1 -1.5\n"
+        "p 1\n";
+    CORRADE_VERIFY(importer->openData({data, sizeof(data) - 1}));
+
+    const Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+
+    /* Comparing the bits, as a fuzzy compare would hide the difference */
+    CORRADE_COMPARE(Containers::arrayCast<const Vector3ui>(mesh->attribute<Vector3>(MeshAttribute::Position))[0],
+        (Vector3ui{0x40a2b8f1u, 0x3dcccccdu, 0xbfc00000u}));
+}
+
+void ObjImporterTest::threaded() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Has to be large enough for the mesh to get split into chunks of at
+       least 64 kB */
+    const std::string grid = threadedGrid();
+    CORRADE_COMPARE_AS(grid.size(), std::size_t{5*64*1024},
+        TestSuite::Compare::Greater);
+
+    Containers::Pointer<AbstractImporter> serialImporter = _manager.instantiate("ObjImporter");
+    CORRADE_COMPARE(serialImporter->configuration().value<UnsignedInt>("threadCount"), 1);
+    CORRADE_VERIFY(serialImporter->openData({grid.data(), grid.size()}));
+    const Containers::Optional<MeshData> expected = serialImporter->mesh(0);
+    CORRADE_VERIFY(expected);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    importer->configuration().setValue("threadCount", data.threadCount);
+    CORRADE_VERIFY(importer->openData({grid.data(), grid.size()}));
+
+    const Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(mesh->attributeCount(), 3);
+    CORRADE_COMPARE(mesh->vertexCount(), 65*65);
+    CORRADE_COMPARE(mesh->indexCount(), 64*64*6);
+
+    /* The output should be exactly the same as with a single thread */
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedInt>(),
+        expected->indices<UnsignedInt>(),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        expected->attribute<Vector3>(MeshAttribute::Position),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Normal),
+        expected->attribute<Vector3>(MeshAttribute::Normal),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        expected->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        TestSuite::Compare::Container);
+}
+
+void ObjImporterTest::threadedError() {
+    auto&& data = ThreadedErrorData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::string grid = data.prefix + threadedGrid() + data.suffix;
+
+    /* The first error in the file should be reported regardless of the
+       thread count */
+    for(const UnsignedInt threadCount: {1, 4}) {
+        CORRADE_ITERATION(threadCount);
+
+        Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+        importer->configuration().setValue("threadCount", threadCount);
+        CORRADE_VERIFY(importer->openData({grid.data(), grid.size()}));
+
+        std::ostringstream out;
+        Error redirectError{&out};
+        CORRADE_VERIFY(!importer->mesh(0));
+        CORRADE_COMPARE(out.str(), Utility::formatString("Trade::ObjImporter::mesh(): {}\n", data.message));
+    }
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::ObjImporterTest)
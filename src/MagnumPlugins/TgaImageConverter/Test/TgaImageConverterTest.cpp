@@ -29,6 +29,7 @@
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Configuration.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 
@@ -50,6 +51,13 @@ struct TgaImageConverterTest: TestSuite::Tester {
     void rgb();
     void rgba();
 
+    void rleGrayscale();
+    void rleRgb();
+    void rleThreaded();
+
+    void exportToFile();
+    void exportToFileWrongFormat();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImageConverter> _converterManager{"nonexistent"};
     PluginManager::Manager<AbstractImporter> _importerManager{"nonexistent"};
@@ -92,6 +100,37 @@ constexpr char OriginalDataRGBA[] = {
 };
 const ImageView2D OriginalRGBA{PixelFormat::RGBA8Unorm, {2, 3}, OriginalDataRGBA};
 
+constexpr struct {
+    const char* name;
+    bool rle;
+    UnsignedInt threadCount;
+} ExportData[] {
+    {"", false, 1},
+    {"RLE", true, 1},
+    {"4 threads", false, 4},
+    {"RLE, 4 threads", true, 4}
+};
+
+constexpr struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadedData[] {
+    {"2 threads", 2},
+    {"5 threads", 5},
+    {"all threads", 0}
+};
+
+/* Large enough to get split among more threads and, when exported to a file,
+   into more than one batch. Contains both long runs and noise. */
+Containers::Array<char> largeImageData(const Vector2i& size, const std::size_t pixelSize) {
+    Containers::Array<char> data{Containers::NoInit, std::size_t(size.product())*pixelSize};
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        const std::size_t pixel = i/pixelSize;
+        data[i] = char(pixel % 777 < 300 ? pixel/1024 : (pixel*7 + i)*13);
+    }
+    return data;
+}
+
 TgaImageConverterTest::TgaImageConverterTest() {
     addTests({&TgaImageConverterTest::wrongFormat});
 
@@ -100,6 +139,17 @@ TgaImageConverterTest::TgaImageConverterTest() {
         &TgaImageConverterTest::rgba},
         Containers::arraySize(VerboseData));
 
+    addTests({&TgaImageConverterTest::rleGrayscale,
+              &TgaImageConverterTest::rleRgb});
+
+    addInstancedTests({&TgaImageConverterTest::rleThreaded},
+        Containers::arraySize(ThreadedData));
+
+    addInstancedTests({&TgaImageConverterTest::exportToFile},
+        Containers::arraySize(ExportData));
+
+    addTests({&TgaImageConverterTest::exportToFileWrongFormat});
+
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
     #ifdef TGAIMAGECONVERTER_PLUGIN_FILENAME
@@ -109,6 +159,9 @@ TgaImageConverterTest::TgaImageConverterTest() {
     #ifdef TGAIMPORTER_PLUGIN_FILENAME
     CORRADE_INTERNAL_ASSERT_OUTPUT(_importerManager.load(TGAIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
     #endif
+
+    /* Create the output directory if it doesn't exist yet */
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::mkpath(TGAIMAGECONVERTER_TEST_OUTPUT_DIR));
 }
 
 void TgaImageConverterTest::wrongFormat() {
@@ -185,6 +238,122 @@ void TgaImageConverterTest::rgba() {
     CORRADE_COMPARE(out.str(), data.message32);
 }
 
+void TgaImageConverterTest::rleGrayscale() {
+    const char pixels[] = {
+        1, 1, 1, 1, 2, 3, 4, 4,
+        5, 5, 5, 5, 5, 5, 5, 5
+    };
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", true);
+    Containers::Array<char> array = converter->exportToData(ImageView2D{PixelFormat::R8Unorm, {8, 2}, pixels});
+    CORRADE_COMPARE_AS(array, Containers::arrayView<char>({
+        0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 8, 0, 2, 0, 8, 0,
+        /* Runs of at least three pixels are encoded as RLE packets, short
+           runs are put into a raw packet */
+        '\x83', 1,
+        '\x03', 2, 3, 4, 4,
+        /* Packets don't cross rows */
+        '\x87', 5
+    }), TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::rleRgb() {
+    /* Padded to four byte alignment (the resulting file is *not* padded) */
+    const char pixels[] = {
+        1, 2, 3, 1, 2, 3, 1, 2, 3, 0, 0, 0,
+        4, 5, 6, 7, 8, 9, 7, 8, 9, 0, 0, 0
+    };
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", true);
+    Containers::Array<char> array = converter->exportToData(ImageView2D{PixelFormat::RGB8Unorm, {3, 2}, pixels});
+    CORRADE_COMPARE_AS(array, Containers::arrayView<char>({
+        0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 2, 0, 24, 0,
+        '\x82', 3, 2, 1,
+        /* Two same multi-byte pixels are already worth a RLE packet */
+        '\x00', 6, 5, 4,
+        '\x81', 9, 8, 7
+    }), TestSuite::Compare::Container);
+
+    if(!(_importerManager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(array));
+    Containers::Optional<Trade::ImageData2D> converted = importer->image2D(0);
+    CORRADE_VERIFY(converted);
+    CORRADE_COMPARE(converted->size(), Vector2i(3, 2));
+    CORRADE_COMPARE(converted->format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE_AS(converted->data(), Containers::arrayView<char>({
+        1, 2, 3, 1, 2, 3, 1, 2, 3,
+        4, 5, 6, 7, 8, 9, 7, 8, 9
+    }), TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::rleThreaded() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Containers::Array<char> pixels = largeImageData({509, 1031}, 4);
+    const ImageView2D image{PixelFormat::RGBA8Unorm, {509, 1031}, pixels};
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", true);
+    Containers::Array<char> expected = converter->exportToData(image);
+    CORRADE_VERIFY(expected);
+
+    /* The output should be the same regardless of the thread count */
+    converter->configuration().setValue("threadCount", data.threadCount);
+    Containers::Array<char> array = converter->exportToData(image);
+    CORRADE_COMPARE_AS(array, expected, TestSuite::Compare::Container);
+
+    if(!(_importerManager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(array));
+    Containers::Optional<Trade::ImageData2D> converted = importer->image2D(0);
+    CORRADE_VERIFY(converted);
+    CORRADE_COMPARE(converted->size(), (Vector2i{509, 1031}));
+    CORRADE_COMPARE_AS(converted->data(), pixels,
+        TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::exportToFile() {
+    auto&& data = ExportData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* 1031x1031 pixels is above a single batch even with four threads */
+    const Containers::Array<char> pixels = largeImageData({1031, 1031}, 3);
+    const ImageView2D image{PixelStorage{}.setAlignment(1),
+        PixelFormat::RGB8Unorm, {1031, 1031}, pixels};
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", data.rle);
+    converter->configuration().setValue("threadCount", data.threadCount);
+
+    /* The streamed file should be the same as the in-memory output */
+    const std::string filename = Utility::Directory::join(TGAIMAGECONVERTER_TEST_OUTPUT_DIR, "output.tga");
+    if(Utility::Directory::exists(filename))
+        CORRADE_VERIFY(Utility::Directory::rm(filename));
+    CORRADE_VERIFY(converter->exportToFile(image, filename));
+    CORRADE_COMPARE_AS(Utility::Directory::read(filename),
+        converter->exportToData(image),
+        TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::exportToFileWrongFormat() {
+    ImageView2D image{PixelFormat::RG8Unorm, {}, nullptr};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    CORRADE_VERIFY(!converter->exportToFile(image, Utility::Directory::join(TGAIMAGECONVERTER_TEST_OUTPUT_DIR, "output.tga")));
+    CORRADE_COMPARE(out.str(), "Trade::TgaImageConverter::exportToFile(): unsupported pixel format PixelFormat::RG8Unorm\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImageConverterTest)
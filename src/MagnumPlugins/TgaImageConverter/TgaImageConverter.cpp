@@ -25,14 +25,19 @@
 
 #include "TgaImageConverter.h"
 
+#include <cstring>
 #include <fstream>
-#include <tuple>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Configuration.h>
+#include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Endianness.h>
 
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
+#include "Magnum/Implementation/parallelFor.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Swizzle.h"
 #include "Magnum/Math/Vector4.h"
 #include "MagnumPlugins/TgaImporter/TgaHeader.h"
@@ -45,49 +50,248 @@ TgaImageConverter::TgaImageConverter(PluginManager::AbstractManager& manager, co
 
 ImageConverterFeatures TgaImageConverter::doFeatures() const { return ImageConverterFeature::ConvertData; }
 
-Containers::Array<char> TgaImageConverter::doExportToData(const ImageView2D& image) {
-    /* Initialize data buffer */
-    const auto pixelSize = UnsignedByte(image.pixelSize());
-    Containers::Array<char> data{Containers::ValueInit, sizeof(Implementation::TgaHeader) + pixelSize*image.size().product()};
+namespace {
+
+/* Images with less pixels than this per thread are encoded with fewer
+   threads */
+constexpr std::size_t MinPixelsPerThread = 65536;
+
+/* How many pixels each thread encodes at once when streaming to a file. The
+   encoded rows are written to the file before the next batch is started, so
+   this bounds the memory used for the output. */
+constexpr std::size_t StreamPixelsPerThread = 262144;
+
+/* Upper bound on the size of an encoded row. Each packet has a one-byte
+   header and covers at least one pixel, which makes the worst case for RLE
+   one extra byte per pixel. */
+std::size_t maxEncodedRowSize(const std::size_t width, const std::size_t pixelSize, const bool rle) {
+    return width*(rle ? pixelSize + 1 : pixelSize);
+}
+
+/* Length of a run of identical pixels starting at given position, at most
+   128 which is the most a single RLE packet can hold */
+std::size_t runLength(const char* const pixels, const std::size_t count, const std::size_t pixelSize, const std::size_t position) {
+    const char* const pixel = pixels + position*pixelSize;
+    std::size_t length = 1;
+    while(position + length < count && length < 128 && std::memcmp(pixel, pixel + length*pixelSize, pixelSize) == 0)
+        ++length;
+    return length;
+}
+
+/* RLE-encodes a row of pixels into the output, returns the encoded size.
+   Packets never cross rows, as recommended by the TGA 2.0 specification. */
+std::size_t encodeRle(const char* const pixels, const std::size_t count, const std::size_t pixelSize, char* const output) {
+    /* A run of two single-byte pixels is encoded in two bytes either way, but
+       interrupts a raw packet, which costs a header byte more */
+    const std::size_t minRunLength = pixelSize == 1 ? 3 : 2;
+
+    char* out = output;
+    for(std::size_t i = 0; i < count; ) {
+        /* Long enough run, encode as a RLE packet */
+        const std::size_t length = runLength(pixels, count, pixelSize, i);
+        if(length >= minRunLength) {
+            *out++ = char(0x80|(length - 1));
+            std::memcpy(out, pixels + i*pixelSize, pixelSize);
+            out += pixelSize;
+            i += length;
+            continue;
+        }
+
+        /* Otherwise gather raw pixels until a long enough run starts */
+        std::size_t end = i + length;
+        while(end < count && end - i < 128) {
+            const std::size_t nextLength = runLength(pixels, count, pixelSize, end);
+            if(nextLength >= minRunLength) break;
+            end += nextLength;
+        }
+        end = Math::min(end, i + 128);
+
+        *out++ = char(end - i - 1);
+        std::memcpy(out, pixels + i*pixelSize, (end - i)*pixelSize);
+        out += (end - i)*pixelSize;
+        i = end;
+    }
+
+    return out - output;
+}
+
+/* Encodes rows in given range into the output, returns the encoded size.
+   The output is expected to have at least maxEncodedRowSize() bytes for each
+   row and, if RLE is enabled, the scratch has to have space for one row. */
+std::size_t encodeRows(const ImageView2D& image, const std::size_t rowBegin, const std::size_t rowEnd, const bool rle, const Containers::ArrayView<char> scratch, char* const output) {
+    const Containers::StridedArrayView3D<const char> pixels = image.pixels();
+    const std::size_t width = pixels.size()[1];
+    const std::size_t pixelSize = pixels.size()[2];
+    const std::size_t rowSize = width*pixelSize;
+
+    char* out = output;
+    for(std::size_t y = rowBegin; y != rowEnd; ++y) {
+        /* Uncompressed rows go directly into the output, RLE rows get
+           encoded from the scratch */
+        const Containers::ArrayView<char> row{rle ? scratch.data() : out, rowSize};
+
+        /* Copy the row, dropping padding (if any), and convert it from RGB(A)
+           to BGR(A) while it's still in cache */
+        Utility::copy(pixels[y], Containers::StridedArrayView2D<char>{row, {width, pixelSize}});
+        if(image.format() == PixelFormat::RGB8Unorm) {
+            for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(row))
+                pixel = Math::gather<'b', 'g', 'r'>(pixel);
+        } else if(image.format() == PixelFormat::RGBA8Unorm) {
+            for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(row))
+                pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
+        }
+
+        out += rle ? encodeRle(row.data(), width, pixelSize, out) : rowSize;
+    }
+
+    return out - output;
+}
+
+struct Chunk {
+    Containers::Array<char> scratch;
+    Containers::Array<char> data;
+    std::size_t size;
+};
+
+/* Encodes rows in given range with given number of threads into the chunks,
+   each thread taking a contiguous range of rows. Chunk buffers are
+   reallocated only if they're too small, so they can be reused for
+   subsequent batches. */
+void encodeBatch(const ImageView2D& image, const std::size_t rowBegin, const std::size_t rowEnd, const bool rle, const Containers::ArrayView<Chunk> chunks) {
+    const std::size_t width = image.size().x();
+    const std::size_t pixelSize = image.pixelSize();
+    const std::size_t rowCount = rowEnd - rowBegin;
+
+    Magnum::Implementation::parallelFor(chunks.size(), [&](const std::size_t i) {
+        const std::size_t begin = rowBegin + rowCount*i/chunks.size();
+        const std::size_t end = rowBegin + rowCount*(i + 1)/chunks.size();
+
+        Chunk& chunk = chunks[i];
+        const std::size_t maxSize = (end - begin)*maxEncodedRowSize(width, pixelSize, rle);
+        if(chunk.data.size() < maxSize)
+            chunk.data = Containers::Array<char>{Containers::NoInit, maxSize};
+        if(rle && chunk.scratch.size() < width*pixelSize)
+            chunk.scratch = Containers::Array<char>{Containers::NoInit, width*pixelSize};
+
+        chunk.size = encodeRows(image, begin, end, rle, chunk.scratch, chunk.data.data());
+    });
+}
 
-    /* Fill header */
-    auto header = reinterpret_cast<Implementation::TgaHeader*>(data.begin());
+bool fillHeader(Implementation::TgaHeader& header, const ImageView2D& image, const bool rle, const ImageConverterFlags flags, const char* const prefix) {
     switch(image.format()) {
         case PixelFormat::RGB8Unorm:
         case PixelFormat::RGBA8Unorm:
-            header->imageType = 2;
+            header.imageType = rle ? 10 : 2;
             break;
         case PixelFormat::R8Unorm:
-            header->imageType = 3;
+            header.imageType = rle ? 11 : 3;
             break;
         default:
-            Error() << "Trade::TgaImageConverter::exportToData(): unsupported pixel format" << image.format();
-            return nullptr;
+            Error() << "Trade::TgaImageConverter::" << Debug::nospace << prefix << Debug::nospace << "(): unsupported pixel format" << image.format();
+            return false;
+    }
+    header.bpp = UnsignedByte(image.pixelSize()*8);
+    header.width = UnsignedShort(Utility::Endianness::littleEndian(image.size().x()));
+    header.height = UnsignedShort(Utility::Endianness::littleEndian(image.size().y()));
+
+    if(flags & ImageConverterFlag::Verbose) {
+        if(image.format() == PixelFormat::RGB8Unorm)
+            Debug{} << "Trade::TgaImageConverter::" << Debug::nospace << prefix << Debug::nospace << "(): converting from RGB to BGR";
+        else if(image.format() == PixelFormat::RGBA8Unorm)
+            Debug{} << "Trade::TgaImageConverter::" << Debug::nospace << prefix << Debug::nospace << "(): converting from RGBA to BGRA";
+    }
+
+    return true;
+}
+
+std::size_t actualThreadCount(const Utility::ConfigurationGroup& configuration, const std::size_t pixelCount) {
+    /* A plugin instantiated without a plugin manager has no configuration, in
+       which case it's single-threaded */
+    return Magnum::Implementation::parallelThreadCount(
+        configuration.hasValue("threadCount") ? configuration.value<UnsignedInt>("threadCount") : 1,
+        pixelCount, MinPixelsPerThread);
+}
+
+}
+
+Containers::Array<char> TgaImageConverter::doExportToData(const ImageView2D& image) {
+    const bool rle = configuration().value<bool>("rle");
+    Implementation::TgaHeader header{};
+    if(!fillHeader(header, image, rle, flags(), "exportToData"))
+        return nullptr;
+
+    const std::size_t height = image.size().y();
+    const std::size_t rowSize = image.pixelSize()*image.size().x();
+    const std::size_t threadCount = actualThreadCount(configuration(), image.size().product());
+
+    /* Uncompressed size is known upfront, encode the rows directly into the
+       output */
+    if(!rle) {
+        Containers::Array<char> data{Containers::NoInit, sizeof(Implementation::TgaHeader) + height*rowSize};
+        std::memcpy(data.data(), &header, sizeof(Implementation::TgaHeader));
+        char* const pixels = data.data() + sizeof(Implementation::TgaHeader);
+        Magnum::Implementation::parallelForRanges(threadCount, height, [&](const std::size_t begin, const std::size_t end) {
+            encodeRows(image, begin, end, false, nullptr, pixels + begin*rowSize);
+        });
+        return data;
     }
-    header->bpp = pixelSize*8;
-    header->width = UnsignedShort(Utility::Endianness::littleEndian(image.size().x()));
-    header->height = UnsignedShort(Utility::Endianness::littleEndian(image.size().y()));
-
-    /* Copy the pixels into output, dropping padding (if any) */
-    const Containers::ArrayView<char> pixels = data.suffix(sizeof(Implementation::TgaHeader));
-    Utility::copy(image.pixels(), Containers::StridedArrayView3D<char>{pixels,
-        {std::size_t(image.size().y()), std::size_t(image.size().x()), pixelSize}});
-
-    if(image.format() == PixelFormat::RGB8Unorm) {
-        if(flags() & ImageConverterFlag::Verbose)
-            Debug{} << "Trade::TgaImageConverter::exportToData(): converting from RGB to BGR";
-        for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(pixels))
-            pixel = Math::gather<'b', 'g', 'r'>(pixel);
-    } else if(image.format() == PixelFormat::RGBA8Unorm) {
-        if(flags() & ImageConverterFlag::Verbose)
-            Debug{} << "Trade::TgaImageConverter::exportToData(): converting from RGBA to BGRA";
-        for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(pixels))
-            pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
+
+    /* Otherwise encode into a buffer for each thread and then concatenate */
+    Containers::Array<Chunk> chunks{Containers::ValueInit, threadCount};
+    encodeBatch(image, 0, height, true, chunks);
+    std::size_t size = sizeof(Implementation::TgaHeader);
+    for(const Chunk& chunk: chunks) size += chunk.size;
+
+    Containers::Array<char> data{Containers::NoInit, size};
+    std::memcpy(data.data(), &header, sizeof(Implementation::TgaHeader));
+    char* out = data.data() + sizeof(Implementation::TgaHeader);
+    for(const Chunk& chunk: chunks) {
+        std::memcpy(out, chunk.data.data(), chunk.size);
+        out += chunk.size;
     }
 
     return data;
 }
 
+bool TgaImageConverter::doExportToFile(const ImageView2D& image, const std::string& filename) {
+    const bool rle = configuration().value<bool>("rle");
+    Implementation::TgaHeader header{};
+    if(!fillHeader(header, image, rle, flags(), "exportToFile"))
+        return false;
+
+    std::ofstream out{filename, std::ofstream::binary};
+    if(!out.good()) {
+        Error{} << "Trade::TgaImageConverter::exportToFile(): cannot write to file" << filename;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(Implementation::TgaHeader));
+
+    /* Encode the rows in batches and write each batch before starting the
+       next one, so the whole output never needs to be in memory */
+    const std::size_t width = image.size().x();
+    const std::size_t height = image.size().y();
+    const std::size_t batchRowsPerThread = Math::max(StreamPixelsPerThread/Math::max(width, std::size_t{1}), std::size_t{1});
+    const std::size_t threadCount = actualThreadCount(configuration(), image.size().product());
+    Containers::Array<Chunk> chunks{Containers::ValueInit, threadCount};
+    for(std::size_t rowBegin = 0; rowBegin < height; ) {
+        const std::size_t rowEnd = Math::min(rowBegin + batchRowsPerThread*threadCount, height);
+        const std::size_t batchThreadCount = Math::max(Math::min(threadCount, (rowEnd - rowBegin)*width/MinPixelsPerThread), std::size_t{1});
+        const Containers::ArrayView<Chunk> batchChunks = chunks.prefix(batchThreadCount);
+        encodeBatch(image, rowBegin, rowEnd, rle, batchChunks);
+
+        for(const Chunk& chunk: batchChunks)
+            out.write(chunk.data.data(), chunk.size);
+        rowBegin = rowEnd;
+    }
+
+    if(!out.good()) {
+        Error{} << "Trade::TgaImageConverter::exportToFile(): cannot write to file" << filename;
+        return false;
+    }
+
+    return true;
+}
+
 }}
 
 CORRADE_PLUGIN_REGISTER(TgaImageConverter, Magnum::Trade::TgaImageConverter,
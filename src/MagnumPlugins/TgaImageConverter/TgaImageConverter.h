@@ -91,8 +91,30 @@ information.
 
 @section Trade-TgaImageConverter-behavior Behavior and limitations
 
-The output is always uncompressed. If you want to make use of RLE compression
-and have the files smaller, use the @ref StbImageConverter plugin instead.
+The output is uncompressed by default, RLE compression can be enabled with
+the @cb{.ini} rle @ce @ref Trade-TgaImageConverter-configuration "configuration option".
+Each scanline is compressed separately, as recommended by the TGA 2.0
+specification. Runs of two or more identical pixels (three or more for
+grayscale images) are encoded as a RLE packet, everything else as raw
+packets.
+
+With @ref exportToFile(), the rows are encoded in batches of a bounded size
+and each batch is written to the file before the next one is started, so the
+whole encoded image is never assembled in memory. @ref exportToData() encodes
+uncompressed images directly into the output; RLE-compressed images are
+encoded into a buffer for each thread first and then concatenated.
+
+@section Trade-TgaImageConverter-configuration Plugin-specific configuration
+
+It's possible to tune various output options through @ref configuration(). See
+below for all options and their default values:
+
+@snippet MagnumPlugins/TgaImageConverter/TgaImageConverter.conf configuration_
+
+With @cb{.ini} threadCount @ce set to a value other than @cpp 1 @ce, ranges
+of rows are converted and encoded on separate threads. The output is the same
+as with a single thread. On Emscripten the option is ignored and the
+conversion is always single-threaded.
 */
 class MAGNUM_TGAIMAGECONVERTER_EXPORT TgaImageConverter: public AbstractImageConverter {
     public:
@@ -105,6 +127,7 @@ class MAGNUM_TGAIMAGECONVERTER_EXPORT TgaImageConverter: public AbstractImageCon
     private:
         ImageConverterFeatures MAGNUM_TGAIMAGECONVERTER_LOCAL doFeatures() const override;
         Containers::Array<char> MAGNUM_TGAIMAGECONVERTER_LOCAL doExportToData(const ImageView2D& image) override;
+        bool MAGNUM_TGAIMAGECONVERTER_LOCAL doExportToFile(const ImageView2D& image, const std::string& filename) override;
 };
 
 }}
@@ -59,8 +59,13 @@ struct TgaImporterTest: TestSuite::Tester {
 
     void rleTooLarge();
 
+    void zeroCopy();
+    void zeroCopyFile();
+    void zeroCopyRle();
+
     void openTwice();
     void importTwice();
+    void importTwiceConverted();
 
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
@@ -146,10 +151,15 @@ TgaImporterTest::TgaImporterTest() {
     addTests({&TgaImporterTest::grayscale8,
               &TgaImporterTest::grayscale8Rle,
 
-              &TgaImporterTest::rleTooLarge});
+              &TgaImporterTest::rleTooLarge,
+
+              &TgaImporterTest::zeroCopy,
+              &TgaImporterTest::zeroCopyFile,
+              &TgaImporterTest::zeroCopyRle});
 
     addTests({&TgaImporterTest::openTwice,
-              &TgaImporterTest::importTwice});
+              &TgaImporterTest::importTwice,
+              &TgaImporterTest::importTwiceConverted});
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
@@ -421,6 +431,60 @@ void TgaImporterTest::rleTooLarge() {
     CORRADE_COMPARE(out.str(), "Trade::TgaImporter::image2D(): RLE data larger than advertised Vector(2, 3) pixels at byte 28\n");
 }
 
+void TgaImporterTest::zeroCopy() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    importer->setFlags(ImporterFlag::ZeroCopy);
+    CORRADE_VERIFY(importer->openData(Color24));
+
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    Containers::Optional<Trade::ImageData2D> image2 = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(image2);
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::ExternallyOwned|DataFlag::Mutable);
+    CORRADE_COMPARE(image->storage().alignment(), 1);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+
+    /* Both reference the same memory, converted only once */
+    CORRADE_COMPARE(image2->data().data(), image->data().data());
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView<char>({
+        3, 2, 1, 4, 3, 2,
+        5, 4, 3, 6, 5, 4,
+        7, 6, 5, 8, 7, 6
+    }), TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::zeroCopyFile() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    importer->setFlags(ImporterFlag::ZeroCopy);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TGAIMPORTER_TEST_DIR, "file.tga")));
+
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::ExternallyOwned|DataFlag::Mutable);
+    CORRADE_COMPARE(image->format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView<char>({
+        1, 2, 3, 4, 5, 6
+    }), TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::zeroCopyRle() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    importer->setFlags(ImporterFlag::ZeroCopy);
+    CORRADE_VERIFY(importer->openData(Color24Rle));
+
+    /* RLE data have to be decoded, so they're always owned */
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView<char>({
+        3, 2, 1, 4, 3, 2,
+        5, 4, 3, 6, 5, 4,
+        6, 5, 4, 6, 5, 4
+    }), TestSuite::Compare::Container);
+}
+
 void TgaImporterTest::openTwice() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
 
@@ -446,6 +510,27 @@ void TgaImporterTest::importTwice() {
     }
 }
 
+void TgaImporterTest::importTwiceConverted() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(Color24));
+
+    /* The BGR conversion is done in place in the opened data, verify it
+       doesn't get done again on second use */
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    Containers::Optional<Trade::ImageData2D> image2 = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(image2);
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_VERIFY(image2->data().data() != image->data().data());
+    CORRADE_COMPARE_AS(image2->data(), image->data(),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(image2->data(), Containers::arrayView<char>({
+        3, 2, 1, 4, 3, 2,
+        5, 4, 3, 6, 5, 4,
+        7, 6, 5, 8, 7, 6
+    }), TestSuite::Compare::Container);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImporterTest)
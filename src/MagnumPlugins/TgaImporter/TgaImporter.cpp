@@ -53,20 +53,45 @@ bool TgaImporter::doIsOpened() const { return _in; }
 void TgaImporter::doClose() { _in = nullptr; }
 
 void TgaImporter::doOpenData(const Containers::ArrayView<const char> data) {
-    /* Because here we're copying the data and using the _in to check if file
-       is opened, having them nullptr would mean openData() would fail without
-       any error message. It's not possible to do this check on the importer
-       side, because empty file is valid in some formats (OBJ or glTF). We also
-       can't do the full import here because then doImage2D() would need to
-       copy the imported data instead anyway. This way it'll also work nicely
-       with a future openMemory(). */
+    /* The data aren't guaranteed to stay in scope, make a copy */
+    Containers::Array<char> copy{Containers::NoInit, data.size()};
+    Utility::copy(data, copy);
+    openInternal(std::move(copy));
+}
+
+void TgaImporter::doOpenFileData(Containers::Array<char>&& data) {
+    /* The file was loaded or memory-mapped for us, take it over */
+    openInternal(std::move(data));
+}
+
+void TgaImporter::openInternal(Containers::Array<char>&& data) {
+    /* Because we're using the _in to check if file is opened, having it
+       nullptr would mean openData() would fail without any error message.
+       It's not possible to do this check on the importer side, because empty
+       file is valid in some formats (OBJ or glTF). We also can't do the full
+       import here because then doImage2D() would need to copy the imported
+       data instead anyway. */
     if(data.empty()) {
         Error{} << "Trade::TgaImporter::openData(): the file is empty";
         return;
     }
 
-    _in = Containers::Array<char>{data.size()};
-    std::copy(data.begin(), data.end(), _in.begin());
+    _in = std::move(data);
+    _inConverted = false;
+}
+
+namespace {
+
+void convertFromBgr(const PixelFormat format, const Containers::ArrayView<char> pixels) {
+    if(format == PixelFormat::RGB8Unorm) {
+        for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(pixels))
+            pixel = Math::gather<'b', 'g', 'r'>(pixel);
+    } else if(format == PixelFormat::RGBA8Unorm) {
+        for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(pixels))
+            pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
+    }
+}
+
 }
 
 UnsignedInt TgaImporter::doImage2DCount() const { return 1; }
@@ -129,8 +154,20 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
     const std::size_t pixelSize = header.bpp/8;
     const std::size_t outputSize = std::size_t(size.product())*pixelSize;
 
-    /* Copy data directly if not RLE */
-    Containers::Array<char> data{outputSize};
+    /* Adjust pixel storage if row size is not four byte aligned */
+    PixelStorage storage;
+    if((size.x()*header.bpp/8)%4 != 0)
+        storage.setAlignment(1);
+
+    if(flags() & ImporterFlag::Verbose) {
+        if(format == PixelFormat::RGB8Unorm)
+            Debug{} << "Trade::TgaImporter::image2D(): converting from BGR to RGB";
+        else if(format == PixelFormat::RGBA8Unorm)
+            Debug{} << "Trade::TgaImporter::image2D(): converting from BGRA to RGBA";
+    }
+
+    /* Uncompressed data are converted from BGR(A) in place in the opened
+       file, only once, and then either referenced or copied */
     Containers::ArrayView<const char> srcPixels = _in.suffix(sizeof(Implementation::TgaHeader));
     if(!rle) {
         /* Files that are larger are allowed in this case (but not for RLE) */
@@ -139,10 +176,27 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
             return Containers::NullOpt;
         }
 
-        Utility::copy(srcPixels.prefix(data.size()), data);
+        const Containers::ArrayView<char> pixels = _in.slice(sizeof(Implementation::TgaHeader), sizeof(Implementation::TgaHeader) + outputSize);
+        if(!_inConverted) {
+            convertFromBgr(format, pixels);
+            _inConverted = true;
+        }
 
-    /* Otherwise decode */
-    } else {
+        /* Reference the file directly if requested. It's owned by us and
+           stays valid until the file is closed. */
+        if(flags() & ImporterFlag::ZeroCopy)
+            return ImageData2D{storage, format, size,
+                DataFlag::ExternallyOwned|DataFlag::Mutable, pixels};
+
+        Containers::Array<char> data{Containers::NoInit, outputSize};
+        Utility::copy(pixels, data);
+        return ImageData2D{storage, format, size, std::move(data)};
+    }
+
+    /* Otherwise decode straight into the output, converting from BGR(A)
+       while the decoded run is still in cache */
+    Containers::Array<char> data{Containers::NoInit, outputSize};
+    {
         Containers::ArrayView<char> dstPixels = data;
         while(!srcPixels.empty()) {
             /* Reference: http://www.paulbourke.net/dataformats/tga/ */
@@ -176,6 +230,7 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
                 dstPixels.prefix(count*pixelSize),
                 {count, pixelSize}};
             Utility::copy(src, dst);
+            convertFromBgr(format, dstPixels.prefix(count*pixelSize));
 
             /* Update views for the next round */
             srcPixels = srcPixels.suffix(1 + dataSize);
@@ -183,27 +238,10 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
         }
     }
 
-    /* Adjust pixel storage if row size is not four byte aligned */
-    PixelStorage storage;
-    if((size.x()*header.bpp/8)%4 != 0)
-        storage.setAlignment(1);
-
-    if(format == PixelFormat::RGB8Unorm) {
-        if(flags() & ImporterFlag::Verbose)
-            Debug{} << "Trade::TgaImporter::image2D(): converting from BGR to RGB";
-        for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(data))
-            pixel = Math::gather<'b', 'g', 'r'>(pixel);
-    } else if(format == PixelFormat::RGBA8Unorm) {
-        if(flags() & ImporterFlag::Verbose)
-            Debug{} << "Trade::TgaImporter::image2D(): converting from BGRA to RGBA";
-        for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(data))
-            pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
-    }
-
     return ImageData2D{storage, format, size, std::move(data)};
 }
 
 }}
 
 CORRADE_PLUGIN_REGISTER(TgaImporter, Magnum::Trade::TgaImporter,
-    "cz.mosra.magnum.Trade.AbstractImporter/0.3.3")
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.4")
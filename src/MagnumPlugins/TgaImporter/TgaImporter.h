@@ -98,6 +98,30 @@ are imported with default @ref PixelStorage parameters except for alignment,
 which may be changed to `1` if the data require it.
 
 RLE compression is supported, paletted images are not.
+
+@section Trade-TgaImporter-zero-copy Zero-copy import
+
+Files opened with @ref openFile() are taken over by the importer without an
+extra copy. Uncompressed BGR and BGRA data are converted to RGB and RGBA in
+place in the opened file on the first @ref image2D() call. If
+@ref ImporterFlag::ZeroCopy is set, the file is memory-mapped and
+@ref image2D() returns an @ref ImageData2D referencing the pixel data
+directly, with @ref ImageData::dataFlags() being @ref DataFlag::ExternallyOwned
+and @ref DataFlag::Mutable. The data are valid only until the file is closed.
+
+The import is truly zero-copy only for uncompressed 8-bit grayscale images.
+The mapping is copy-on-write, and since the in-place BGR(A) to RGB(A)
+conversion writes to all pixel pages, uncompressed color images cost one
+copy of the pixel data done by the operating system. That's still one copy
+less than without the flag, but the memory use is the same as if the file
+was read into memory.
+
+Files opened with @ref openData() are always copied, the flag then affects
+only whether @ref image2D() references the importer-owned copy. Files loaded
+through file callbacks are copied as well, as the callbacks are asked for
+@ref InputFileCallbackPolicy::LoadTemporary data. RLE-compressed images are
+always decoded into a newly allocated array, with the BGR(A) conversion done
+directly as each run is decoded.
 */
 class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
     public:
@@ -113,11 +137,16 @@ class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
         ImporterFeatures MAGNUM_TGAIMPORTER_LOCAL doFeatures() const override;
         bool MAGNUM_TGAIMPORTER_LOCAL doIsOpened() const override;
         void MAGNUM_TGAIMPORTER_LOCAL doOpenData(Containers::ArrayView<const char> data) override;
+        void MAGNUM_TGAIMPORTER_LOCAL doOpenFileData(Containers::Array<char>&& data) override;
         void MAGNUM_TGAIMPORTER_LOCAL doClose() override;
         UnsignedInt MAGNUM_TGAIMPORTER_LOCAL doImage2DCount() const override;
         Containers::Optional<ImageData2D> MAGNUM_TGAIMPORTER_LOCAL doImage2D(UnsignedInt id, UnsignedInt level) override;
 
+        void MAGNUM_TGAIMPORTER_LOCAL openInternal(Containers::Array<char>&& data);
+
         Containers::Array<char> _in;
+        /* Whether uncompressed pixels in _in were converted from BGR(A) */
+        bool _inConverted{};
 };
 
 }}
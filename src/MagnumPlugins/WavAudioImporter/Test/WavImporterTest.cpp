@@ -26,6 +26,7 @@
 
 #include <sstream>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -78,10 +79,23 @@ struct WavImporterTest: TestSuite::Tester {
     void surround51Channel16();
     void surround71Channel24();
 
+    void streaming();
+    void streamingFileCallback();
+    void streamingFileCallbackNotFound();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
 
+constexpr struct {
+    const char* name;
+    bool openData;
+} StreamingData[]{
+    {"openData()", true},
+    /* Memory-mapped on platforms that support it */
+    {"openFile()", false}
+};
+
 WavImporterTest::WavImporterTest() {
     addTests({&WavImporterTest::empty,
               &WavImporterTest::wrongSignature,
@@ -121,6 +135,12 @@ WavImporterTest::WavImporterTest() {
               &WavImporterTest::surround51Channel16,
               &WavImporterTest::surround71Channel24});
 
+    addInstancedTests({&WavImporterTest::streaming},
+        Containers::arraySize(StreamingData));
+
+    addTests({&WavImporterTest::streamingFileCallback,
+              &WavImporterTest::streamingFileCallbackNotFound});
+
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
     #ifdef WAVAUDIOIMPORTER_PLUGIN_FILENAME
@@ -469,6 +489,103 @@ void WavImporterTest::surround71Channel24() {
     CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported format Audio::WavAudioFormat::Extensible\n");
 }
 
+void WavImporterTest::streaming() {
+    auto&& data = StreamingData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->features() & ImporterFeature::Streaming);
+
+    /* Big-endian file to verify the data are converted on the fly */
+    const std::string filename = Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono32fbe.wav");
+    if(data.openData)
+        CORRADE_VERIFY(importer->openData(Utility::Directory::read(filename)));
+    else
+        CORRADE_VERIFY(importer->openFile(filename));
+
+    CORRADE_COMPARE(importer->format(), BufferFormat::MonoFloat);
+    CORRADE_COMPARE(importer->sampleCount(), 4);
+    CORRADE_COMPARE(importer->sampleOffset(), 0);
+
+    /* Leftover bytes that don't make up a whole sample are left untouched */
+    Float out[3];
+    Containers::ArrayView<char> outBytes = Containers::arrayCast<char>(Containers::arrayView(out));
+    CORRADE_COMPARE(importer->read(outBytes.prefix(11)), 2);
+    CORRADE_COMPARE(importer->sampleOffset(), 2);
+    CORRADE_COMPARE_AS(Containers::arrayView(out).prefix(2),
+        Containers::arrayView<Float>({0.0f, 0.00467603f}),
+        TestSuite::Compare::Container);
+
+    /* Reading past the end returns only what's left */
+    CORRADE_COMPARE(importer->read(outBytes), 2);
+    CORRADE_COMPARE(importer->sampleOffset(), 4);
+    CORRADE_COMPARE_AS(Containers::arrayView(out).prefix(2),
+        Containers::arrayView<Float>({0.010391f, 0.0166854f}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(importer->read(outBytes), 0);
+
+    /* Seeking back gives the same data as data() */
+    importer->seek(1);
+    CORRADE_COMPARE(importer->read(outBytes), 3);
+    CORRADE_COMPARE_AS(Containers::arrayView(out),
+        Containers::arrayCast<const Float>(importer->data()).suffix(1),
+        TestSuite::Compare::Container);
+}
+
+void WavImporterTest::streamingFileCallback() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->features() & ImporterFeature::FileCallback);
+
+    struct State {
+        Containers::Array<char> data;
+        Int loaded{}, closed{};
+    } state;
+    importer->setFileCallback([](const std::string& filename, InputFileCallbackPolicy policy, void* userData) -> Containers::Optional<Containers::ArrayView<const char>> {
+        State& state = *static_cast<State*>(userData);
+        if(policy == InputFileCallbackPolicy::LoadPermanent) {
+            ++state.loaded;
+            state.data = Utility::Directory::read(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, filename));
+            return Containers::ArrayView<const char>{state.data};
+        }
+        if(policy == InputFileCallbackPolicy::Close) {
+            ++state.closed;
+            state.data = nullptr;
+        }
+        return {};
+    }, &state);
+
+    CORRADE_VERIFY(importer->openFile("stereo64fbe.wav"));
+    CORRADE_COMPARE(state.loaded, 1);
+    CORRADE_COMPARE(state.closed, 0);
+    CORRADE_COMPARE(importer->format(), BufferFormat::StereoDouble);
+    CORRADE_COMPARE(importer->sampleCount(), 4);
+
+    /* The data are read directly from the memory returned by the callback */
+    importer->seek(2);
+    Double out[4];
+    CORRADE_COMPARE(importer->read(Containers::arrayCast<char>(Containers::arrayView(out))), 2);
+    CORRADE_COMPARE_AS(Containers::arrayView(out),
+        Containers::arrayView<Double>({3.0517578125e-05, 6.103515625e-05, -9.1552734375e-05, 0.0}),
+        TestSuite::Compare::Container);
+
+    /* The memory is released only on close */
+    importer->close();
+    CORRADE_COMPARE(state.loaded, 1);
+    CORRADE_COMPARE(state.closed, 1);
+}
+
+void WavImporterTest::streamingFileCallbackNotFound() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    importer->setFileCallback([](const std::string&, InputFileCallbackPolicy, void*) -> Containers::Optional<Containers::ArrayView<const char>> {
+        return {};
+    });
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openFile("nonexistent.wav"));
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openFile(): cannot open file nonexistent.wav\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::WavImporterTest)
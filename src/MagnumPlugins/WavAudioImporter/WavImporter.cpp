@@ -26,12 +26,23 @@
 
 #include "WavImporter.h"
 
+#include <fstream>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
-#include <Corrade/Utility/EndiannessBatch.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Endianness.h>
 
+#include "Magnum/Math/Functions.h"
 #include "MagnumPlugins/WavAudioImporter/WavHeader.h"
 
+/* Same condition as for Utility::Directory::mapRead() */
+#if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+#define _MAGNUM_WAVAUDIOIMPORTER_USE_MAPPING
+#endif
+
 namespace Magnum { namespace Audio {
 
 using Implementation::RiffChunk;
@@ -39,19 +50,34 @@ using Implementation::WavAudioFormat;
 using Implementation::WavFormatChunk;
 using Implementation::WavHeaderChunk;
 
-WavImporter::WavImporter() = default;
-
-WavImporter::WavImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
-
-ImporterFeatures WavImporter::doFeatures() const { return ImporterFeature::OpenData; }
+namespace {
+
+struct WavData {
+    BufferFormat format;
+    UnsignedInt frequency;
+    /* Size of a sample including all channels */
+    UnsignedInt sampleSize;
+    /* Size of a single channel value if the data need to be converted to
+       machine endian, 0 otherwise */
+    UnsignedInt endianSwapSize;
+    /* Contents of the data chunk, in file endian */
+    Containers::ArrayView<const char> samples;
+};
+
+/* Byte-wise so it works on unaligned output views as well */
+void swapEndianness(const Containers::ArrayView<char> data, const UnsignedInt size) {
+    for(std::size_t i = 0; i + size <= data.size(); i += size)
+        for(std::size_t j = 0; j != size/2; ++j)
+            std::swap(data[i + j], data[i + size - j - 1]);
+}
 
-bool WavImporter::doIsOpened() const { return !!_data; }
+Containers::Optional<WavData> parseWav(const Containers::ArrayView<const char> data) {
+    WavData out;
 
-void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
     /* Check file size */
     if(data.size() < sizeof(WavHeaderChunk) + sizeof(WavFormatChunk) + sizeof(RiffChunk)) {
         Error() << "Audio::WavImporter::openData(): the file is too short:" << data.size() << "bytes";
-        return;
+        return {};
     }
 
     /* Get the RIFF/WAV header */
@@ -61,7 +87,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
     if((std::strncmp(header.chunk.chunkId, "RIFF", 4) != 0 && std::strncmp(header.chunk.chunkId, "RIFX", 4) != 0) ||
        std::strncmp(header.format, "WAVE", 4) != 0) {
         Error() << "Audio::WavImporter::openData(): the file signature is invalid";
-        return;
+        return {};
     }
 
     /* Check if the file is Big-Endian. While RIFX files are extremely rare,
@@ -76,7 +102,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
     if(header.chunk.chunkSize < 36 || header.chunk.chunkSize + 8 != data.size()) {
         Error() << "Audio::WavImporter::openData(): the file has improper size, expected"
                 << header.chunk.chunkSize + 8 << "but got" << data.size();
-        return;
+        return {};
     }
 
     const RiffChunk* dataChunk = nullptr;
@@ -100,7 +126,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
         if(std::strncmp(currChunk->chunkId, "fmt ", 4) == 0) {
             if(formatChunk) {
                 Error() << "Audio::WavImporter::openData(): the file contains too many format chunks";
-                return;
+                return {};
             }
 
             formatChunk = WavFormatChunk{*reinterpret_cast<const WavFormatChunk*>(currChunk)};
@@ -108,7 +134,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
         } else if(std::strncmp(currChunk->chunkId, "data", 4) == 0) {
             if(dataChunk != nullptr) {
                 Error() << "Audio::WavImporter::openData(): the file contains too many data chunks";
-                return;
+                return {};
             }
 
             dataChunk = currChunk;
@@ -120,13 +146,13 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
     /* Make sure we actually got a format chunk */
     if(!formatChunk) {
         Error() << "Audio::WavImporter::openData(): the file contains no format chunk";
-        return;
+        return {};
     }
 
     /* Make sure we actually got a data chunk */
     if(dataChunk == nullptr) {
         Error() << "Audio::WavImporter::openData(): the file contains no data chunk";
-        return;
+        return {};
     }
 
     /* Fix endianness on Format chunk */
@@ -141,115 +167,248 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
     if(formatChunk->audioFormat == WavAudioFormat::Pcm) {
         /* Decide about format */
         if(formatChunk->numChannels == 1 && formatChunk->bitsPerSample == 8)
-            _format = BufferFormat::Mono8;
+            out.format = BufferFormat::Mono8;
         else if(formatChunk->numChannels == 1 && formatChunk->bitsPerSample == 16)
-            _format = BufferFormat::Mono16;
+            out.format = BufferFormat::Mono16;
         else if(formatChunk->numChannels == 2 && formatChunk->bitsPerSample == 8)
-            _format = BufferFormat::Stereo8;
+            out.format = BufferFormat::Stereo8;
         else if(formatChunk->numChannels == 2 && formatChunk->bitsPerSample == 16)
-             _format = BufferFormat::Stereo16;
+             out.format = BufferFormat::Stereo16;
         else {
             Error() << "Audio::WavImporter::openData(): PCM with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return {};
         }
 
     /* Check IEEE Float format */
     } else if(formatChunk->audioFormat == WavAudioFormat::IeeeFloat) {
         if(formatChunk->numChannels == 1 && formatChunk->bitsPerSample == 32)
-            _format = BufferFormat::MonoFloat;
+            out.format = BufferFormat::MonoFloat;
         else if(formatChunk->numChannels == 2 && formatChunk->bitsPerSample == 32)
-            _format = BufferFormat::StereoFloat;
+            out.format = BufferFormat::StereoFloat;
         else if(formatChunk->numChannels == 1 && formatChunk->bitsPerSample == 64)
-            _format = BufferFormat::MonoDouble;
+            out.format = BufferFormat::MonoDouble;
         else if(formatChunk->numChannels == 2 && formatChunk->bitsPerSample == 64)
-            _format = BufferFormat::StereoDouble;
+            out.format = BufferFormat::StereoDouble;
         else {
             Error() << "Audio::WavImporter::openData(): IEEE with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return {};
         }
 
     /* Check A-Law format */
     } else if(formatChunk->audioFormat == WavAudioFormat::ALaw) {
         if(formatChunk->numChannels == 1)
-            _format = BufferFormat::MonoALaw;
+            out.format = BufferFormat::MonoALaw;
         else if(formatChunk->numChannels == 2)
-            _format = BufferFormat::StereoALaw;
+            out.format = BufferFormat::StereoALaw;
         else {
             Error() << "Audio::WavImporter::openData(): ALaw with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return {};
         }
 
     /* Check μ-Law format */
     } else if(formatChunk->audioFormat == WavAudioFormat::MuLaw) {
         if(formatChunk->numChannels == 1)
-            _format = BufferFormat::MonoMuLaw;
+            out.format = BufferFormat::MonoMuLaw;
         else if(formatChunk->numChannels == 2)
-            _format = BufferFormat::StereoMuLaw;
+            out.format = BufferFormat::StereoMuLaw;
         else {
             Error() << "Audio::WavImporter::openData(): MuLaw with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return {};
         }
 
     /* Unknown/unimplemented format */
     } else {
         Error() << "Audio::WavImporter::openData(): unsupported format" << formatChunk->audioFormat;
-        return;
+        return {};
     }
 
     /* Size sanity checks */
     if(headerSize + offset > data.size()) {
         Error() << "Audio::WavImporter::openData(): file size doesn't match computed size";
-        return;
+        return {};
     }
 
     /* Format sanity checks */
     if(formatChunk->blockAlign != formatChunk->numChannels * formatChunk->bitsPerSample / 8 ||
        formatChunk->byteRate != formatChunk->sampleRate * formatChunk->blockAlign) {
         Error() << "Audio::WavImporter::openData(): the file is corrupted";
+        return {};
+    }
+
+    out.frequency = formatChunk->sampleRate;
+    out.sampleSize = formatChunk->blockAlign;
+
+    /* The data are referenced in place and converted to machine endian only
+       when copied out, so they can be streamed from a read-only memory */
+    out.endianSwapSize = hasBigEndianData != Utility::Endianness::isBigEndian() && formatChunk->bitsPerSample > 8 ? formatChunk->bitsPerSample/8 : 0;
+    out.samples = {reinterpret_cast<const char*>(dataChunk + 1), dataChunkSize};
+
+    return out;
+}
+
+}
+
+struct WavImporter::State {
+    WavData wav;
+
+    /* Owned copy of the data chunk for openData() or the whole file contents
+       if mapping isn't available; mapped file; or the filename to close
+       through the file callback */
+    Containers::Array<char> data;
+    #ifdef _MAGNUM_WAVAUDIOIMPORTER_USE_MAPPING
+    Containers::Array<const char, Utility::Directory::MapDeleter> mappedData;
+    #endif
+    Containers::Optional<std::string> callbackFilename;
+
+    std::size_t sampleOffset{};
+};
+
+WavImporter::WavImporter() = default;
+
+WavImporter::WavImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+
+WavImporter::~WavImporter() { close(); }
+
+ImporterFeatures WavImporter::doFeatures() const { return ImporterFeature::OpenData|ImporterFeature::FileCallback|ImporterFeature::Streaming; }
+
+bool WavImporter::doIsOpened() const { return !!_state; }
+
+void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
+    Containers::Optional<WavData> wav = parseWav(data);
+    if(!wav) return;
+
+    /* The data are not guaranteed to stay in scope, so copy the samples */
+    Containers::Pointer<State> state{new State};
+    state->data = Containers::Array<char>{Containers::NoInit, wav->samples.size()};
+    Utility::copy(wav->samples, state->data);
+    wav->samples = state->data;
+    state->wav = *wav;
+    _state = std::move(state);
+}
+
+void WavImporter::doOpenFile(const std::string& filename) {
+    /* If callbacks are set, ask for the data to stay in memory for as long as
+       the file is opened so they can be streamed from directly */
+    if(fileCallback()) {
+        const Containers::Optional<Containers::ArrayView<const char>> data = fileCallback()(filename, InputFileCallbackPolicy::LoadPermanent, fileCallbackUserData());
+        if(!data) {
+            Error() << "Audio::WavImporter::openFile(): cannot open file" << filename;
+            return;
+        }
+
+        Containers::Optional<WavData> wav = parseWav(*data);
+        if(!wav) {
+            fileCallback()(filename, InputFileCallbackPolicy::Close, fileCallbackUserData());
+            return;
+        }
+
+        _state.reset(new State);
+        _state->wav = *wav;
+        _state->callbackFilename = filename;
+        return;
+    }
+
+    #ifdef _MAGNUM_WAVAUDIOIMPORTER_USE_MAPPING
+    /* Otherwise map the file so only the pages that are actually read are
+       resident. Empty files can't be mapped, so check the size first. */
+    std::size_t size;
+    {
+        std::ifstream in{filename, std::ios::binary|std::ios::ate};
+        if(!in.good()) {
+            Error() << "Audio::WavImporter::openFile(): cannot open file" << filename;
+            return;
+        }
+        size = std::size_t(in.tellg());
+    }
+
+    /* Let the parser produce the error for empty files */
+    if(!size) {
+        parseWav(nullptr);
         return;
     }
 
-    /* Save frequency */
-    _frequency = formatChunk->sampleRate;
-
-    /* Copy the data */
-    const char* dataChunkPtr = reinterpret_cast<const char*>(dataChunk + 1);
-    _data = Containers::Array<char>(dataChunkSize);
-    std::copy(dataChunkPtr, dataChunkPtr+dataChunkSize, _data->begin());
-
-    /* Fix the data endianness */
-    if(hasBigEndianData != Utility::Endianness::isBigEndian()) {
-        if(formatChunk->bitsPerSample == 16)
-            Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint16_t>(*_data));
-        else if(formatChunk->bitsPerSample == 32)
-            Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint32_t>(*_data));
-        else if(formatChunk->bitsPerSample == 64)
-            Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint64_t>(*_data));
-        else CORRADE_INTERNAL_ASSERT(formatChunk->bitsPerSample == 8);
+    Containers::Array<const char, Utility::Directory::MapDeleter> mappedData = Utility::Directory::mapRead(filename);
+    if(!mappedData.data()) {
+        Error() << "Audio::WavImporter::openFile(): cannot open file" << filename;
+        return;
     }
+
+    Containers::Optional<WavData> wav = parseWav(mappedData);
+    if(!wav) return;
+
+    _state.reset(new State);
+    _state->wav = *wav;
+    _state->mappedData = std::move(mappedData);
+    #else
+    /* Or read it into memory where mapping isn't available, keeping the
+       whole file so the samples don't need to be copied again */
+    if(!Utility::Directory::exists(filename)) {
+        Error() << "Audio::WavImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+
+    Containers::Array<char> data = Utility::Directory::read(filename);
+    Containers::Optional<WavData> wav = parseWav(data);
+    if(!wav) return;
+
+    _state.reset(new State);
+    _state->wav = *wav;
+    _state->data = std::move(data);
+    #endif
 }
 
-void WavImporter::doClose() { _data = Containers::NullOpt; }
+void WavImporter::doClose() {
+    if(_state->callbackFilename)
+        fileCallback()(*_state->callbackFilename, InputFileCallbackPolicy::Close, fileCallbackUserData());
+    _state = nullptr;
+}
 
-BufferFormat WavImporter::doFormat() const { return _format; }
+BufferFormat WavImporter::doFormat() const { return _state->wav.format; }
 
-UnsignedInt WavImporter::doFrequency() const { return _frequency; }
+UnsignedInt WavImporter::doFrequency() const { return _state->wav.frequency; }
 
 Containers::Array<char> WavImporter::doData() {
-    Containers::Array<char> copy(_data->size());
-    std::copy(_data->begin(), _data->end(), copy.begin());
-    return copy;
+    Containers::Array<char> out{Containers::NoInit, _state->wav.samples.size()};
+    Utility::copy(_state->wav.samples, out);
+    if(_state->wav.endianSwapSize)
+        swapEndianness(out, _state->wav.endianSwapSize);
+    return out;
+}
+
+std::size_t WavImporter::doSampleCount() const {
+    return _state->wav.samples.size()/_state->wav.sampleSize;
+}
+
+std::size_t WavImporter::doSampleOffset() const {
+    return _state->sampleOffset;
+}
+
+void WavImporter::doSeek(const std::size_t offset) {
+    _state->sampleOffset = offset;
+}
+
+std::size_t WavImporter::doRead(const Containers::ArrayView<char> data) {
+    const std::size_t sampleSize = _state->wav.sampleSize;
+    const std::size_t count = Math::min(data.size()/sampleSize, doSampleCount() - _state->sampleOffset);
+
+    const Containers::ArrayView<char> out = data.prefix(count*sampleSize);
+    Utility::copy(_state->wav.samples.slice(_state->sampleOffset*sampleSize, (_state->sampleOffset + count)*sampleSize), out);
+    if(_state->wav.endianSwapSize)
+        swapEndianness(out, _state->wav.endianSwapSize);
+
+    _state->sampleOffset += count;
+    return count;
 }
 
 }}
 
 CORRADE_PLUGIN_REGISTER(WavAudioImporter, Magnum::Audio::WavImporter,
-    "cz.mosra.magnum.Audio.AbstractImporter/0.1")
+    "cz.mosra.magnum.Audio.AbstractImporter/0.2")
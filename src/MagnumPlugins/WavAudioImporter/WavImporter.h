@@ -30,8 +30,7 @@
  * @brief Class @ref Magnum::Audio::WavImporter
  */
 
-#include <Corrade/Containers/Array.h>
-#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Audio/AbstractImporter.h"
 
@@ -76,6 +75,9 @@ Supports mono and stereo files of the following formats:
 Both Little-Endian files (with a `RIFF` header) and Big-Endian files (with
 a `RIFX` header) are supported, data is converted to machine endian on import.
 
+The plugin supports @ref ImporterFeature::OpenData,
+@ref ImporterFeature::FileCallback and @ref ImporterFeature::Streaming.
+
 @section Audio-WavImporter-usage Usage
 
 This plugin is built if `WITH_WAVAUDIOIMPORTER` is enabled when building
@@ -108,6 +110,20 @@ See @ref building, @ref cmake and @ref plugins for more information.
 @section Audio-WavImporter-limitations Behavior and limitations
 
 Multi-channel formats are not supported.
+
+@subsection Audio-WavImporter-limitations-streaming Streaming and file callbacks
+
+The plugin implements @ref read() and @ref seek() by copying directly out of
+the `data` chunk of the file, converting the endianness on the fly if needed.
+With @ref openData() the `data` chunk is copied on open, as the input isn't
+guaranteed to stay in scope. With @ref openFile() the file is memory-mapped
+on platforms that support it, so only the parts that are actually read get
+paged in; elsewhere it's read into memory as a whole.
+
+If a file callback is set, @ref openFile() requests the file with
+@ref InputFileCallbackPolicy::LoadPermanent and streams from the returned
+memory until the file is closed, at which point the callback is called with
+@ref InputFileCallbackPolicy::Close.
 */
 class MAGNUM_WAVAUDIOIMPORTER_EXPORT WavImporter: public AbstractImporter {
     public:
@@ -117,19 +133,27 @@ class MAGNUM_WAVAUDIOIMPORTER_EXPORT WavImporter: public AbstractImporter {
         /** @brief Plugin manager constructor */
         explicit WavImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
 
+        ~WavImporter();
+
     private:
+        struct State;
+
         MAGNUM_WAVAUDIOIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL void doClose() override;
 
         MAGNUM_WAVAUDIOIMPORTER_LOCAL BufferFormat doFormat() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL UnsignedInt doFrequency() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL Containers::Array<char> doData() override;
 
-        Containers::Optional<Containers::Array<char>> _data;
-        BufferFormat _format;
-        UnsignedInt _frequency;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL std::size_t doSampleCount() const override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL std::size_t doSampleOffset() const override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void doSeek(std::size_t offset) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL std::size_t doRead(Containers::ArrayView<char> data) override;
+
+        Containers::Pointer<State> _state;
 };
 
 }}